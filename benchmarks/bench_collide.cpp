@@ -0,0 +1,215 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: bench_collide.cpp                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Times testing a rectangle against many with GS_OGLCollide::TestRectOnRects() and    |
+ |        with a loop calling IsRectOnRect() for each, and checks both find the same          |
+ |        overlaps. TestRectOnRects() uses the SIMD path the program was built for, which is  |
+ |        why the benchmark is built once for each path (see CMakeLists.txt).                 |
+ |                                                                                            |
+ |        Usage: bench_collide                                                                |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include standard C library header files.
+// ---------------------------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_ogl_collide.h"
+#include "gs_timer.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Benchmark defines.
+// ---------------------------------------------------------------------------------------------
+#define BENCH_MAX_RECTS      4096     // Most rectangles tested per call.
+#define BENCH_RECTS_PER_CASE 20000000 // Rectangles tested per case, spread over the calls.
+//==============================================================================================
+
+
+//==============================================================================================
+// The rectangles tested against, kept apart by edge as TestRectOnRects() takes them.
+// ---------------------------------------------------------------------------------------------
+static int   g_nLeft[BENCH_MAX_RECTS];
+static int   g_nTop[BENCH_MAX_RECTS];
+static int   g_nRight[BENCH_MAX_RECTS];
+static int   g_nBottom[BENCH_MAX_RECTS];
+static DWORD g_dwMask[(BENCH_MAX_RECTS + 31) / 32];
+static DWORD g_dwLoopMask[(BENCH_MAX_RECTS + 31) / 32];
+
+static volatile int g_nSink = 0; // Keeps the compiler from optimizing the tests away.
+//==============================================================================================
+
+
+//==============================================================================================
+// GetRandom():
+// ---------------------------------------------------------------------------------------------
+// Purpose: A small random number generator, so every run tests the same rectangles.
+// ---------------------------------------------------------------------------------------------
+// Returns: A number from 0 to nRange - 1.
+//==============================================================================================
+
+static int GetRandom(int nRange)
+{
+
+    static unsigned int nSeed = 12345;
+
+    nSeed = (nSeed * 1103515245u) + 12345u;
+
+    return (int) ((nSeed >> 8) % (unsigned int) nRange);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// TestLoop():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Tests the rectangles one at a time with IsRectOnRect(), as TestRectOnRects() is
+//          meant to replace.
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of rectangles the source overlaps.
+//==============================================================================================
+
+static int TestLoop(GS_OGLCollide* pgsCollide, RECT rcSource, int nNumRects, DWORD* pdwMask)
+{
+
+    int nNumOverlaps = 0;
+
+    memset(pdwMask, 0, ((nNumRects + 31) / 32) * sizeof(DWORD));
+
+    for (int nRect = 0; nRect < nNumRects; nRect++)
+    {
+        RECT rcDest;
+
+        rcDest.left   = g_nLeft[nRect];
+        rcDest.top    = g_nTop[nRect];
+        rcDest.right  = g_nRight[nRect];
+        rcDest.bottom = g_nBottom[nRect];
+
+        if (pgsCollide->IsRectOnRect(rcSource, rcDest))
+        {
+            pdwMask[nRect / 32] |= (DWORD) 1 << (nRect % 32);
+            nNumOverlaps++;
+        }
+    }
+
+    return nNumOverlaps;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+int main()
+{
+
+#if defined(GS_SIMD_AVX2) && defined(__GNUC__)
+    if (!__builtin_cpu_supports("avx2"))
+    {
+        printf("This processor has no AVX2, run the benchmark built without it instead.\n");
+        return 1;
+    }
+#endif
+
+#if defined(GS_SIMD_AVX2)
+    const char* pszPath = "AVX2 + SSE2";
+#elif defined(GS_SIMD_SSE2)
+    const char* pszPath = "SSE2";
+#else
+    const char* pszPath = "scalar";
+#endif
+
+    // Rectangles of 8 to 71 pixels on a 1024 x 1024 area, y grows upwards (top > bottom).
+    for (int nRect = 0; nRect < BENCH_MAX_RECTS; nRect++)
+    {
+        g_nLeft[nRect]   = GetRandom(1024);
+        g_nBottom[nRect] = GetRandom(1024);
+        g_nRight[nRect]  = g_nLeft[nRect] + 8 + GetRandom(64);
+        g_nTop[nRect]    = g_nBottom[nRect] + 8 + GetRandom(64);
+    }
+
+    GS_OGLCollide gsCollide;
+
+    printf("TestRectOnRects() path: %s\n\n", pszPath);
+    printf("%8s %16s %16s %10s %12s\n", "Rects", "Loop ns/call", "Batch ns/call", "Speedup",
+           "Mismatches");
+
+    int nCounts[] = { 7, 33, 128, 512, BENCH_MAX_RECTS };
+
+    for (int nCase = 0; nCase < (int) (sizeof(nCounts) / sizeof(nCounts[0])); nCase++)
+    {
+        int nNumRects = nCounts[nCase];
+        int nNumCalls = BENCH_RECTS_PER_CASE / nNumRects;
+
+        // A source rectangle that overlaps some of the rectangles.
+        RECT rcSource;
+        rcSource.left   = 400;
+        rcSource.bottom = 400;
+        rcSource.right  = 600;
+        rcSource.top    = 600;
+
+        // Check the results match for a few source rectangles first.
+        int nNumMismatches = 0;
+
+        for (int nCheck = 0; nCheck < 64; nCheck++)
+        {
+            RECT rcCheck;
+            rcCheck.left   = GetRandom(1024) - 64;
+            rcCheck.bottom = GetRandom(1024) - 64;
+            rcCheck.right  = rcCheck.left + GetRandom(256);
+            rcCheck.top    = rcCheck.bottom + GetRandom(256);
+
+            int nLoopCount  = TestLoop(&gsCollide, rcCheck, nNumRects, g_dwLoopMask);
+            int nBatchCount = gsCollide.TestRectOnRects(rcCheck, g_nLeft, g_nTop, g_nRight,
+                                                        g_nBottom, nNumRects, g_dwMask);
+
+            if ((nLoopCount != nBatchCount) ||
+                (memcmp(g_dwLoopMask, g_dwMask, ((nNumRects + 31) / 32) * sizeof(DWORD)) != 0))
+            {
+                nNumMismatches++;
+            }
+        }
+
+        GS_Ticks nStart = GS_Timer::GetTicks();
+
+        for (int nCall = 0; nCall < nNumCalls; nCall++)
+        {
+            g_nSink += TestLoop(&gsCollide, rcSource, nNumRects, g_dwLoopMask);
+        }
+
+        double dLoopNs = GS_Timer::TicksToMs(GS_Timer::GetTicks() - nStart) * 1000000.0 /
+                         nNumCalls;
+
+        nStart = GS_Timer::GetTicks();
+
+        for (int nCall = 0; nCall < nNumCalls; nCall++)
+        {
+            g_nSink += gsCollide.TestRectOnRects(rcSource, g_nLeft, g_nTop, g_nRight, g_nBottom,
+                                                 nNumRects, g_dwMask);
+        }
+
+        double dBatchNs = GS_Timer::TicksToMs(GS_Timer::GetTicks() - nStart) * 1000000.0 /
+                          nNumCalls;
+
+        printf("%8d %16.1f %16.1f %9.1fx %12d\n", nNumRects, dLoopNs, dBatchNs,
+               (dBatchNs > 0.0) ? (dLoopNs / dBatchNs) : 0.0, nNumMismatches);
+    }
+
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,568 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: bench_image.cpp                                                                     |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Times loading the images in data/ with a private copy of the original               |
+ |        GS_OGLImage decoders (stdio reads per chunk, pixel or byte and a per-pixel          |
+ |        BGR -> RGB swap) next to the current GS_OGLImage loaders, and prints the            |
+ |        speedup. The current loaders are also timed decoding from memory only.              |
+ |                                                                                            |
+ |        Usage: bench_image [data directory] [runs per image]                                |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include standard C library header files.
+// ---------------------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_file_map.h"
+#include "gs_ogl_image.h"
+#include "gs_timer.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// The images the demo loads.
+// ---------------------------------------------------------------------------------------------
+static const char* g_pszImages[] =
+{
+    "asteroid_l.tga", "asteroid_s.tga", "backgrnd.tga",  "clouds.tga",
+    "crate.tga",      "font_l.tga",     "font_s.tga",    "ground.tga",
+    "map.tga",        "menu.tga",       "menu_font.tga", "particle.tga",
+    "player.tga",     "portrait.tga"
+};
+//==============================================================================================
+
+
+//==============================================================================================
+// The image produced by the baseline decoders.
+// ---------------------------------------------------------------------------------------------
+struct BaselineImage
+{
+    BYTE* pImage;
+    int   nImageWidth;
+    int   nImageHeight;
+    int   nColorBytes;
+    int   nImageSize;
+};
+//==============================================================================================
+
+
+//==============================================================================================
+// BaselineDestroy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Frees the image data of a baseline image and clears its attributes.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+static void BaselineDestroy(BaselineImage* pImage)
+{
+
+    delete [] pImage->pImage;
+    memset(pImage, 0, sizeof(BaselineImage));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// BaselineFail():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Clears a partly loaded baseline image and closes its file.
+// ---------------------------------------------------------------------------------------------
+// Returns: FALSE, always.
+//==============================================================================================
+
+static BOOL BaselineFail(BaselineImage* pImage, FILE* pFile)
+{
+
+    BaselineDestroy(pImage);
+    fclose(pFile);
+
+    return FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// BaselineLoadTGA():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The original TGA loader. Uncompressed images are read in one go and then swapped
+//          from BGR to RGB a pixel at a time, RLE images are read with an fread() per chunk
+//          header and per color value.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if failed.
+//==============================================================================================
+
+static BOOL BaselineLoadTGA(BaselineImage* pImage, const char* pszFilename)
+{
+
+    FILE* pFile = fopen(pszFilename, "rb");
+
+    if (pFile == NULL)
+    {
+        return FALSE;
+    }
+
+    BYTE TGAHeader[12];
+    BYTE TGAInfo[6];
+
+    if ((fread(TGAHeader, sizeof(TGAHeader), 1, pFile) == 0) ||
+            (fread(TGAInfo, sizeof(TGAInfo), 1, pFile) == 0))
+    {
+        return BaselineFail(pImage, pFile);
+    }
+
+    BYTE UncompressedTGA[12] = { 0,0,2, 0,0,0,0,0,0,0,0,0 };
+    BYTE CompressedTGA[12]   = { 0,0,10,0,0,0,0,0,0,0,0,0 };
+
+    BOOL bIsCompressed = (memcmp(CompressedTGA, TGAHeader, sizeof(TGAHeader)) == 0);
+
+    if ((!bIsCompressed) && (memcmp(UncompressedTGA, TGAHeader, sizeof(TGAHeader)) != 0))
+    {
+        return BaselineFail(pImage, pFile);
+    }
+
+    pImage->nImageWidth  = TGAInfo[1] * 256 + TGAInfo[0];
+    pImage->nImageHeight = TGAInfo[3] * 256 + TGAInfo[2];
+    pImage->nColorBytes  = TGAInfo[4] / 8;
+
+    if ((pImage->nImageWidth <= 0) || (pImage->nImageHeight <= 0) ||
+            ((pImage->nColorBytes != 3) && (pImage->nColorBytes != 4)))
+    {
+        return BaselineFail(pImage, pFile);
+    }
+
+    int nColorBytes = pImage->nColorBytes;
+
+    pImage->nImageSize = nColorBytes * pImage->nImageWidth * pImage->nImageHeight;
+    pImage->pImage     = new BYTE [pImage->nImageSize];
+
+    BYTE* pData = pImage->pImage;
+
+    if (!bIsCompressed)
+    {
+        if (fread(pData, 1, pImage->nImageSize, pFile) != (unsigned) pImage->nImageSize)
+        {
+            return BaselineFail(pImage, pFile);
+        }
+
+        // Swap bytes to the correct color format (BGR -> RGB).
+        for (int nSwap = 0; nSwap < pImage->nImageSize; nSwap += nColorBytes)
+        {
+            pData[nSwap] ^= pData[nSwap+2] ^= pData[nSwap] ^= pData[nSwap+2];
+        }
+
+        fclose(pFile);
+
+        return TRUE;
+    }
+
+    unsigned int nPixelCount   = pImage->nImageWidth * pImage->nImageHeight;
+    unsigned int nCurrentPixel = 0;
+    unsigned int nCurrentByte  = 0;
+
+    BYTE ColorBuffer[4];
+
+    do
+    {
+        BYTE ucChunkHeader = 0;
+
+        if (fread(&ucChunkHeader, sizeof(BYTE), 1, pFile) == 0)
+        {
+            return BaselineFail(pImage, pFile);
+        }
+
+        // Raw packet, read each of the following color values.
+        BOOL bIsRaw = (ucChunkHeader < 128);
+
+        short sCount = bIsRaw ? (ucChunkHeader + 1) : (ucChunkHeader - 127);
+
+        for (short sLoop = 0; sLoop < sCount; sLoop++)
+        {
+            if ((bIsRaw || (sLoop == 0)) &&
+                    (fread(ColorBuffer, 1, nColorBytes, pFile) != (unsigned) nColorBytes))
+            {
+                return BaselineFail(pImage, pFile);
+            }
+
+            // Make sure we don't write past the end of the image.
+            if (nCurrentPixel >= nPixelCount)
+            {
+                return BaselineFail(pImage, pFile);
+            }
+
+            // Write to memory and flip the R and B color values around in the process.
+            pData[nCurrentByte]   = ColorBuffer[2];
+            pData[nCurrentByte+1] = ColorBuffer[1];
+            pData[nCurrentByte+2] = ColorBuffer[0];
+
+            if (nColorBytes == 4)
+            {
+                pData[nCurrentByte+3] = ColorBuffer[3];
+            }
+
+            nCurrentByte += nColorBytes;
+            nCurrentPixel++;
+        }
+    }
+    while (nCurrentPixel < nPixelCount);
+
+    fclose(pFile);
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// BaselineLoadPCX():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The original PCX loader, reading the RLE stream with an fgetc() per byte.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if failed.
+//==============================================================================================
+
+static BOOL BaselineLoadPCX(BaselineImage* pImage, const char* pszFilename)
+{
+
+    FILE* pFile = fopen(pszFilename, "rb");
+
+    if (!pFile)
+    {
+        return FALSE;
+    }
+
+    BYTE Palette[768];
+
+    // The palette is stored at the end of the file, after a marker byte of 12.
+    if ((fseek(pFile, -769, SEEK_END) != 0) || (fgetc(pFile) != 12) ||
+            (fread(Palette, 1, 768, pFile) != 768))
+    {
+        return BaselineFail(pImage, pFile);
+    }
+
+    fseek(pFile, 0, SEEK_SET);
+
+    GS_PCXHeader gsPCXHeader;
+
+    if ((!fread(&gsPCXHeader, sizeof(GS_PCXHeader), 1, pFile)) ||
+            (gsPCXHeader.cManufacturer != 10) || (gsPCXHeader.cVersion != 5) ||
+            (gsPCXHeader.cEncoding != 1))
+    {
+        return BaselineFail(pImage, pFile);
+    }
+
+    pImage->nImageWidth  = gsPCXHeader.wMaxX - gsPCXHeader.wMinX + 1;
+    pImage->nImageHeight = gsPCXHeader.wMaxY - gsPCXHeader.wMinY + 1;
+    pImage->nColorBytes  = 3;
+    pImage->nImageSize   = pImage->nImageWidth * pImage->nImageHeight * 3;
+    pImage->pImage       = new BYTE [pImage->nImageSize];
+
+    BYTE* pData  = pImage->pImage;
+    long  nWidth = pImage->nImageWidth;
+
+    // Run through the image from bottom to top, flipping it vertically.
+    for (long y = pImage->nImageHeight-1; y >= 0; y--)
+    {
+        for (long x = 0; x < nWidth; x++)
+        {
+            int nCurrentValue = fgetc(pFile);
+            int nRepeatLength = 1;
+
+            // Is it a status byte (i.e. RLE encoded)?
+            if (nCurrentValue >= 0xc0)
+            {
+                nRepeatLength = 0x3f & nCurrentValue;
+                nCurrentValue = fgetc(pFile);
+            }
+
+            if (nCurrentValue == EOF)
+            {
+                return BaselineFail(pImage, pFile);
+            }
+
+            for (int nLoop = 0; nLoop < nRepeatLength; nLoop++)
+            {
+                // Runs may cross into the next row.
+                if (x >= nWidth)
+                {
+                    x = 0;
+                    y--;
+                }
+
+                if (y < 0)
+                {
+                    break;
+                }
+
+                int nPosition = ((nWidth * y) + x) * 3;
+
+                pData[nPosition]   = Palette[nCurrentValue*3];
+                pData[nPosition+1] = Palette[nCurrentValue*3+1];
+                pData[nPosition+2] = Palette[nCurrentValue*3+2];
+
+                x++;
+            }
+
+            x--;
+        }
+    }
+
+    fclose(pFile);
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// BaselineLoadBMP():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The original BMP loader, reading a scan line at a time and then swapping the image
+//          from BGR to RGB a pixel at a time.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if failed.
+//==============================================================================================
+
+static BOOL BaselineLoadBMP(BaselineImage* pImage, const char* pszFilename)
+{
+
+    FILE* pFile = fopen(pszFilename, "rb");
+
+    if (!pFile)
+    {
+        return FALSE;
+    }
+
+    BITMAPFILEHEADER BitmapHeader;
+    BITMAPINFOHEADER HeaderInfo;
+
+    if ((!fread(&BitmapHeader, sizeof(BITMAPFILEHEADER), 1, pFile)) ||
+            (memcmp(&BitmapHeader.bfType, "BM", 2) != 0) ||
+            (!fread(&HeaderInfo, sizeof(BITMAPINFOHEADER), 1, pFile)) ||
+            ((HeaderInfo.biBitCount != 24) && (HeaderInfo.biBitCount != 32)))
+    {
+        return BaselineFail(pImage, pFile);
+    }
+
+    pImage->nImageWidth  = HeaderInfo.biWidth;
+    pImage->nImageHeight = HeaderInfo.biHeight;
+    pImage->nColorBytes  = HeaderInfo.biBitCount / 8;
+    pImage->nImageSize   = pImage->nImageWidth * pImage->nImageHeight * pImage->nColorBytes;
+    pImage->pImage       = new BYTE [pImage->nImageSize];
+
+    // Scan lines are padded to a multiple of 4 bytes in the file, but not in memory.
+    unsigned int nBytesPerLine = pImage->nImageWidth * pImage->nColorBytes;
+    unsigned int nPaddingBytes = (4 - (nBytesPerLine % 4)) % 4;
+
+    if (fseek(pFile, BitmapHeader.bfOffBits, SEEK_SET))
+    {
+        return BaselineFail(pImage, pFile);
+    }
+
+    for (int y = 0; y < pImage->nImageHeight; y++)
+    {
+        if ((!fread(pImage->pImage + (nBytesPerLine * y), nBytesPerLine, 1, pFile)) ||
+                (fseek(pFile, nPaddingBytes, SEEK_CUR)))
+        {
+            return BaselineFail(pImage, pFile);
+        }
+    }
+
+    fclose(pFile);
+
+    // Convert image data from BGR to RGB color format.
+    for (int i = 0; i < pImage->nImageSize; i += pImage->nColorBytes)
+    {
+        BYTE temp = pImage->pImage[i+0];
+        pImage->pImage[i+0] = pImage->pImage[i+2];
+        pImage->pImage[i+2] = temp;
+    }
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// BaselineLoad():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Loads an image file with the baseline decoder for its extension.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the image was loaded, FALSE if not.
+//==============================================================================================
+
+static BOOL BaselineLoad(BaselineImage* pImage, const char* pszFilename)
+{
+
+    const char* pszExtension = strrchr(pszFilename, '.');
+
+    if (pszExtension && (strcmp(pszExtension, ".bmp") == 0))
+    {
+        return BaselineLoadBMP(pImage, pszFilename);
+    }
+
+    if (pszExtension && (strcmp(pszExtension, ".pcx") == 0))
+    {
+        return BaselineLoadPCX(pImage, pszFilename);
+    }
+
+    return BaselineLoadTGA(pImage, pszFilename);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// DecodeImage():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Decodes an image already in memory with the decoder for its extension.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the image was decoded, FALSE if not.
+//==============================================================================================
+
+static BOOL DecodeImage(GS_OGLImage* pgsImage, const char* pszFilename, const BYTE* pData,
+                        unsigned long lLength)
+{
+
+    const char* pszExtension = strrchr(pszFilename, '.');
+
+    if (pszExtension && (strcmp(pszExtension, ".bmp") == 0))
+    {
+        return pgsImage->LoadBMP(pData, lLength);
+    }
+
+    if (pszExtension && (strcmp(pszExtension, ".pcx") == 0))
+    {
+        return pgsImage->LoadPCX(pData, lLength);
+    }
+
+    return pgsImage->LoadTGA(pData, lLength);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+int main(int argc, char* argv[])
+{
+
+    const char* pszDirectory = (argc > 1) ? argv[1] : "data/";
+    int nNumRuns = (argc > 2) ? atoi(argv[2]) : 50;
+
+    if (nNumRuns <= 0)
+    {
+        nNumRuns = 1;
+    }
+
+    printf("%-16s %8s %10s %10s %8s %10s %8s\n", "Image", "KB", "Old ms", "New ms", "Speedup",
+           "Decode ms", "MB/s");
+
+    double dTotalOldMs    = 0.0;
+    double dTotalNewMs    = 0.0;
+    double dTotalDecodeMs = 0.0;
+
+    for (unsigned int nLoop = 0; nLoop < sizeof(g_pszImages) / sizeof(g_pszImages[0]); nLoop++)
+    {
+        char szFilename[_MAX_PATH];
+        snprintf(szFilename, sizeof(szFilename), "%s%s", pszDirectory, g_pszImages[nLoop]);
+
+        GS_FileMap    gsFile;
+        GS_OGLImage   gsImage;
+        BaselineImage Baseline;
+
+        memset(&Baseline, 0, sizeof(BaselineImage));
+
+        // Skip images that are missing or don't decode, rather than timing failures.
+        if ((!gsFile.Open(szFilename)) || (!gsImage.Load(szFilename)) ||
+                (!BaselineLoad(&Baseline, szFilename)))
+        {
+            printf("%-16s %8s\n", g_pszImages[nLoop], "skipped");
+            BaselineDestroy(&Baseline);
+            continue;
+        }
+
+        // Both decoders must produce the same pixels for the comparison to mean anything.
+        if ((Baseline.nImageSize != gsImage.GetWidth() * gsImage.GetHeight() *
+                gsImage.GetColorBytes()) ||
+                (memcmp(Baseline.pImage, gsImage.GetData(), Baseline.nImageSize) != 0))
+        {
+            printf("%-16s %8s\n", g_pszImages[nLoop], "mismatch");
+        }
+
+        BaselineDestroy(&Baseline);
+        gsImage.Destroy();
+
+        GS_Ticks nStart = GS_Timer::GetTicks();
+
+        for (int nRun = 0; nRun < nNumRuns; nRun++)
+        {
+            BaselineLoad(&Baseline, szFilename);
+            BaselineDestroy(&Baseline);
+        }
+
+        double dOldMs = GS_Timer::TicksToMs(GS_Timer::GetTicks() - nStart) / nNumRuns;
+
+        nStart = GS_Timer::GetTicks();
+
+        for (int nRun = 0; nRun < nNumRuns; nRun++)
+        {
+            gsImage.Load(szFilename);
+            gsImage.Destroy();
+        }
+
+        double dNewMs = GS_Timer::TicksToMs(GS_Timer::GetTicks() - nStart) / nNumRuns;
+
+        nStart = GS_Timer::GetTicks();
+
+        for (int nRun = 0; nRun < nNumRuns; nRun++)
+        {
+            DecodeImage(&gsImage, szFilename, gsFile.GetData(), gsFile.GetLength());
+            gsImage.Destroy();
+        }
+
+        double dDecodeMs = GS_Timer::TicksToMs(GS_Timer::GetTicks() - nStart) / nNumRuns;
+
+        double dMegaBytes = gsFile.GetLength() / (1024.0 * 1024.0);
+
+        printf("%-16s %8.1f %10.3f %10.3f %7.2fx %10.3f %8.1f\n", g_pszImages[nLoop],
+               gsFile.GetLength() / 1024.0, dOldMs, dNewMs,
+               (dNewMs > 0.0) ? (dOldMs / dNewMs) : 0.0, dDecodeMs,
+               (dDecodeMs > 0.0) ? (dMegaBytes * 1000.0 / dDecodeMs) : 0.0);
+
+        dTotalOldMs    += dOldMs;
+        dTotalNewMs    += dNewMs;
+        dTotalDecodeMs += dDecodeMs;
+    }
+
+    printf("%-16s %8s %10.3f %10.3f %7.2fx %10.3f\n", "Total", "", dTotalOldMs, dTotalNewMs,
+           (dTotalNewMs > 0.0) ? (dTotalOldMs / dTotalNewMs) : 0.0, dTotalDecodeMs);
+
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
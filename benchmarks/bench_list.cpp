@@ -0,0 +1,350 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: bench_list.cpp                                                                      |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Times building lists of pointers and strings with GS_List, next to std::vector and  |
+ |        an array that grows by one item at a time (how GS_List used to grow). Growing by    |
+ |        one is quadratic, so it is only timed for the smaller lists.                        |
+ |                                                                                            |
+ |        Usage: bench_list                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include standard C++ library header files.
+// ---------------------------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_list.h"
+#include "gs_timer.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Benchmark defines.
+// ---------------------------------------------------------------------------------------------
+#define BENCH_ITEMS_PER_CASE 2000000 // Items added per case, spread over as many lists.
+#define BENCH_MAX_GROW_BY_ONE 10000  // Largest list grown one item at a time.
+//==============================================================================================
+
+
+//==============================================================================================
+// Keeps the compiler from optimizing the lists away.
+// ---------------------------------------------------------------------------------------------
+static volatile size_t g_nSink = 0;
+//==============================================================================================
+
+
+//==============================================================================================
+// AddGrowByOne():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Adds an item the way GS_List used to, copying the array into one an item larger.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+static void AddGrowByOne(void*** pppArray, int* pnNumItems, void* pItem)
+{
+
+    void** ppArray = new void*[*pnNumItems + 1];
+
+    if (*pnNumItems > 0)
+    {
+        memcpy(ppArray, *pppArray, *pnNumItems * sizeof(void*));
+    }
+
+    delete [] *pppArray;
+
+    ppArray[*pnNumItems] = pItem;
+
+    *pppArray = ppArray;
+    (*pnNumItems)++;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// TimePointers():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Prints how long adding nNumItems pointers to a list takes, in every way.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+static void TimePointers(int nNumItems)
+{
+
+    int nNumRuns = BENCH_ITEMS_PER_CASE / nNumItems;
+
+    if (nNumRuns < 1)
+    {
+        nNumRuns = 1;
+    }
+
+    // Grow by one.
+    double dGrowByOneUs = -1.0;
+
+    if (nNumItems <= BENCH_MAX_GROW_BY_ONE)
+    {
+        int nGrowRuns = (nNumRuns < 10) ? nNumRuns : 10;
+
+        GS_Ticks nStart = GS_Timer::GetTicks();
+
+        for (int nRun = 0; nRun < nGrowRuns; nRun++)
+        {
+            void** ppArray  = NULL;
+            int nArrayItems = 0;
+
+            for (int nLoop = 0; nLoop < nNumItems; nLoop++)
+            {
+                AddGrowByOne(&ppArray, &nArrayItems, (void*) (size_t) nLoop);
+            }
+
+            g_nSink += nArrayItems;
+            delete [] ppArray;
+        }
+
+        dGrowByOneUs = GS_Timer::TicksToMs(GS_Timer::GetTicks() - nStart) * 1000.0 / nGrowRuns;
+    }
+
+    // GS_List.
+    GS_Ticks nStart = GS_Timer::GetTicks();
+
+    for (int nRun = 0; nRun < nNumRuns; nRun++)
+    {
+        GS_List<void*> gsList;
+
+        for (int nLoop = 0; nLoop < nNumItems; nLoop++)
+        {
+            gsList.AddItem((void*) (size_t) nLoop);
+        }
+
+        g_nSink += gsList.GetNumItems();
+    }
+
+    double dListUs = GS_Timer::TicksToMs(GS_Timer::GetTicks() - nStart) * 1000.0 / nNumRuns;
+
+    // GS_List with the space reserved up front.
+    nStart = GS_Timer::GetTicks();
+
+    for (int nRun = 0; nRun < nNumRuns; nRun++)
+    {
+        GS_List<void*> gsList;
+        gsList.Reserve(nNumItems);
+
+        for (int nLoop = 0; nLoop < nNumItems; nLoop++)
+        {
+            gsList.AddItem((void*) (size_t) nLoop);
+        }
+
+        g_nSink += gsList.GetNumItems();
+    }
+
+    double dReservedUs = GS_Timer::TicksToMs(GS_Timer::GetTicks() - nStart) * 1000.0 / nNumRuns;
+
+    // std::vector.
+    nStart = GS_Timer::GetTicks();
+
+    for (int nRun = 0; nRun < nNumRuns; nRun++)
+    {
+        std::vector<void*> Vector;
+
+        for (int nLoop = 0; nLoop < nNumItems; nLoop++)
+        {
+            Vector.push_back((void*) (size_t) nLoop);
+        }
+
+        g_nSink += Vector.size();
+    }
+
+    double dVectorUs = GS_Timer::TicksToMs(GS_Timer::GetTicks() - nStart) * 1000.0 / nNumRuns;
+
+    if (dGrowByOneUs >= 0.0)
+    {
+        printf("%-10s %8d %14.1f", "void*", nNumItems, dGrowByOneUs);
+    }
+    else
+    {
+        printf("%-10s %8d %14s", "void*", nNumItems, "-");
+    }
+
+    printf(" %12.1f %12.1f %12.1f\n", dListUs, dReservedUs, dVectorUs);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// TimeStrings():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Prints how long adding nNumItems strings to a list takes, which moves them rather
+//          than copying their bytes when the list grows.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+static void TimeStrings(int nNumItems)
+{
+
+    int nNumRuns = BENCH_ITEMS_PER_CASE / 10 / nNumItems;
+
+    if (nNumRuns < 1)
+    {
+        nNumRuns = 1;
+    }
+
+    std::string strItem("a string too long to be stored inside std::string itself");
+
+    GS_Ticks nStart = GS_Timer::GetTicks();
+
+    for (int nRun = 0; nRun < nNumRuns; nRun++)
+    {
+        GS_List<std::string> gsList;
+
+        for (int nLoop = 0; nLoop < nNumItems; nLoop++)
+        {
+            gsList.AddItem(strItem);
+        }
+
+        g_nSink += gsList.GetNumItems();
+    }
+
+    double dListUs = GS_Timer::TicksToMs(GS_Timer::GetTicks() - nStart) * 1000.0 / nNumRuns;
+
+    nStart = GS_Timer::GetTicks();
+
+    for (int nRun = 0; nRun < nNumRuns; nRun++)
+    {
+        GS_List<std::string> gsList;
+        gsList.Reserve(nNumItems);
+
+        for (int nLoop = 0; nLoop < nNumItems; nLoop++)
+        {
+            gsList.AddItem(strItem);
+        }
+
+        g_nSink += gsList.GetNumItems();
+    }
+
+    double dReservedUs = GS_Timer::TicksToMs(GS_Timer::GetTicks() - nStart) * 1000.0 / nNumRuns;
+
+    nStart = GS_Timer::GetTicks();
+
+    for (int nRun = 0; nRun < nNumRuns; nRun++)
+    {
+        std::vector<std::string> Vector;
+
+        for (int nLoop = 0; nLoop < nNumItems; nLoop++)
+        {
+            Vector.push_back(strItem);
+        }
+
+        g_nSink += Vector.size();
+    }
+
+    double dVectorUs = GS_Timer::TicksToMs(GS_Timer::GetTicks() - nStart) * 1000.0 / nNumRuns;
+
+    printf("%-10s %8d %14s %12.1f %12.1f %12.1f\n", "string", nNumItems, "-", dListUs,
+           dReservedUs, dVectorUs);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// TimeSmallLists():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Prints how long building many short lists takes, with and without inline space
+//          for their items.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+static void TimeSmallLists()
+{
+
+    const int nNumItems = 8;
+    const int nNumRuns  = BENCH_ITEMS_PER_CASE / nNumItems;
+
+    GS_Ticks nStart = GS_Timer::GetTicks();
+
+    for (int nRun = 0; nRun < nNumRuns; nRun++)
+    {
+        GS_List<void*> gsList;
+
+        for (int nLoop = 0; nLoop < nNumItems; nLoop++)
+        {
+            gsList.AddItem((void*) (size_t) nLoop);
+        }
+
+        g_nSink += gsList.GetNumItems();
+    }
+
+    double dHeapNs = GS_Timer::TicksToMs(GS_Timer::GetTicks() - nStart) * 1000000.0 / nNumRuns;
+
+    nStart = GS_Timer::GetTicks();
+
+    for (int nRun = 0; nRun < nNumRuns; nRun++)
+    {
+        GS_List<void*, nNumItems> gsList;
+
+        for (int nLoop = 0; nLoop < nNumItems; nLoop++)
+        {
+            gsList.AddItem((void*) (size_t) nLoop);
+        }
+
+        g_nSink += gsList.GetNumItems();
+    }
+
+    double dInlineNs = GS_Timer::TicksToMs(GS_Timer::GetTicks() - nStart) * 1000000.0 /
+                       nNumRuns;
+
+    printf("\n%d item lists: %.1f ns on the heap, %.1f ns inline\n", nNumItems, dHeapNs,
+           dInlineNs);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+int main()
+{
+
+    printf("Microseconds to add all items to an empty list:\n\n");
+    printf("%-10s %8s %14s %12s %12s %12s\n", "Item", "Items", "Grow by one", "GS_List",
+           "Reserved", "std::vector");
+
+    int nSizes[] = { 1000, 10000, 100000 };
+
+    for (int nLoop = 0; nLoop < 3; nLoop++)
+    {
+        TimePointers(nSizes[nLoop]);
+    }
+
+    for (int nLoop = 0; nLoop < 3; nLoop++)
+    {
+        TimeStrings(nSizes[nLoop]);
+    }
+
+    TimeSmallLists();
+
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
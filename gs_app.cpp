@@ -99,6 +99,10 @@ GS_Application::GS_Application()
     m_fFrameRate = GS_DEFAULT_FPS;
     m_fFrameTime = 0.0f;
     m_fWaitTime  = 0.0f;
+
+    m_fUpdateRate    = GS_DEFAULT_UPDATE_RATE;
+    m_dAccumulator   = 0.0;
+    m_fInterpolation = 1.0f;
 }
 
 
@@ -600,6 +604,16 @@ INT GS_Application::Run()
         m_fWaitTime = 0.0f;
     }
 
+    m_gsFramePacer.SetFrameRate(m_fFrameRate);
+
+    // Vertical sync is set by the game, read it back so the frame pacer doesn't wait on top of
+    // a swap that already waits for the vertical blank.
+    typedef int (APIENTRY* PFNWGLGETSWAPINTERVALEXTPROC)(void);
+    PFNWGLGETSWAPINTERVALEXTPROC wglGetSwapIntervalEXT;
+
+    wglGetSwapIntervalEXT =
+        (PFNWGLGETSWAPINTERVALEXTPROC) wglGetProcAddress("wglGetSwapIntervalEXT");
+
     // Recieve and process windows messages.
     while (WM_QUIT != msg.message)
     {
@@ -631,18 +645,36 @@ INT GS_Application::Run()
             // Render a frame during idle time.
             if (m_bIsActive && m_bIsReady)
             {
-                // Wait for the minimum time required by frame-rate.
-                if ((m_fFrameTime = m_gsFrameTimer.GetFrameTime()) >= m_fWaitTime)
+                // A refresh rate of 0 or 1 means the hardware default.
+                int nRefreshRate = GetDeviceCaps(m_hDC, VREFRESH);
+
+                m_gsFramePacer.SetVSync(wglGetSwapIntervalEXT && wglGetSwapIntervalEXT() != 0,
+                                        nRefreshRate > 1 ? (float) nRefreshRate : 0.0f);
+
+                // Record the frame if the profiler has been created.
+                m_gsProfiler.BeginFrame();
+
+                // Sleep until the frame-rate says the next frame is due.
+                {
+                    GS_PROFILE_SCOPE("WaitForFrame");
+                    m_gsFramePacer.WaitForFrame();
+                }
+
+                m_fFrameTime = m_gsFrameTimer.GetFrameTime();
+                // Mark the next frame to be measured.
+                m_gsFrameTimer.MarkFrame();
+                // Run game loop once each frame, check if successfull.
                 {
-                    // Mark the next frame to be measured.
-                    m_gsFrameTimer.MarkFrame();
-                    // Run game loop once each frame, check if successfull.
+                    GS_PROFILE_SCOPE("GameLoop");
+
                     if (TRUE != GameLoop())
                     {
                         GS_Error::Report("GS_APP.CPP", 557, "Error running main game loop!");
                         PostQuitMessage(0);
                     }
                 }
+
+                m_gsProfiler.EndFrame();
             }
             else if (!m_bIsActive)
             {
@@ -746,6 +778,8 @@ LRESULT GS_Application::MsgProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lPar
             }
             // Mark the beginning of a new frame.
             m_gsFrameTimer.MarkFrame();
+            // Don't try to catch up on the frames missed while inactive.
+            m_gsFramePacer.Reset();
             // Set flag to indicate window IS active.
             m_bIsActive = TRUE;
         }
@@ -844,6 +878,8 @@ void GS_Application::SetFrameRate(float fFrameRate)
     {
         m_fWaitTime = 0.0f;
     }
+
+    m_gsFramePacer.SetFrameRate(m_fFrameRate);
 }
 
 
@@ -862,11 +898,19 @@ void GS_Application::SetFrameRate(float fFrameRate)
 void GS_Application::ShowFrameRate()
 {
 
-    char outputString[128] = { 0 };
+    char outputString[320] = { 0 };
+
+    GS_FrameStats gsFrameStats;
+    m_gsFrameTimer.GetFrameStats(&gsFrameStats);
 
     // Convert the frame-rate information into a string that can be displayed in a message box.
-    sprintf(outputString, "%s%0.2f%s", "The program ran at an average of ",
-            m_gsFrameTimer.GetFrameRate(), " frames per second.");
+    sprintf(outputString,
+            "%s%0.2f%s\n\n%s%0.2f / %0.2f / %0.2f / %0.2f / %0.2f%s\n%s%0.2f / %0.2f%s",
+            "The program ran at an average of ", m_gsFrameTimer.GetFrameRate(),
+            " frames per second.", "Frame time mean / min / max / p95 / p99: ",
+            gsFrameStats.dMean, gsFrameStats.dMin, gsFrameStats.dMax, gsFrameStats.dP95,
+            gsFrameStats.dP99, " ms.", "Frame pacing jitter mean / max: ",
+            m_gsFramePacer.GetJitter(), m_gsFramePacer.GetMaxJitter(), " ms.");
 
     // Display frame-rate information.
     MessageBox(NULL, outputString, "GAME INFORMATION", MB_OK | MB_ICONINFORMATION);
@@ -913,6 +957,10 @@ GS_Application::GS_Application()
     m_fFrameRate = GS_DEFAULT_FPS;
     m_fFrameTime = 0.0f;
     m_fWaitTime  = 0.0f;
+
+    m_fUpdateRate    = GS_DEFAULT_UPDATE_RATE;
+    m_dAccumulator   = 0.0;
+    m_fInterpolation = 1.0f;
 }
 
 GS_Application::~GS_Application()
@@ -1102,6 +1150,8 @@ INT GS_Application::Run()
         m_fWaitTime = 0.0f;
     }
 
+    m_gsFramePacer.SetFrameRate(m_fFrameRate);
+
     // Enable text input for WM_CHAR simulation
     SDL_StartTextInput();
 
@@ -1129,6 +1179,7 @@ INT GS_Application::Run()
                     {
                         GameRestore();
                         m_gsFrameTimer.MarkFrame();
+                        m_gsFramePacer.Reset();
                         m_bIsActive = TRUE;
                     }
                 }
@@ -1298,20 +1349,39 @@ INT GS_Application::Run()
 
         if (m_bIsActive && m_bIsReady)
         {
-            if ((m_fFrameTime = m_gsFrameTimer.GetFrameTime()) >= m_fWaitTime)
+            // Let the frame pacer know whether the swap already waits for the vertical blank.
+            SDL_DisplayMode sdlMode;
+            float fRefreshRate = 0.0f;
+
+            if (SDL_GetWindowDisplayMode(m_pWindow, &sdlMode) == 0)
             {
-                m_gsFrameTimer.MarkFrame();
+                fRefreshRate = (float) sdlMode.refresh_rate;
+            }
+
+            m_gsFramePacer.SetVSync(SDL_GL_GetSwapInterval() != 0, fRefreshRate);
+
+            // Record the frame if the profiler has been created.
+            m_gsProfiler.BeginFrame();
+
+            // Sleep until the next frame is due instead of polling the frame timer.
+            {
+                GS_PROFILE_SCOPE("WaitForFrame");
+                m_gsFramePacer.WaitForFrame();
+            }
+
+            m_fFrameTime = m_gsFrameTimer.GetFrameTime();
+            m_gsFrameTimer.MarkFrame();
+            {
+                GS_PROFILE_SCOPE("GameLoop");
+
                 if (TRUE != GameLoop())
                 {
                     GS_Error::Report("GS_APP.CPP", 165, "Error running main game loop!");
                     running = false;
                 }
             }
-            else
-            {
-                // Small delay to prevent busy-waiting
-                SDL_Delay(1);
-            }
+
+            m_gsProfiler.EndFrame();
         }
         else
         {
@@ -1360,14 +1430,157 @@ void GS_Application::SetFrameRate(float fFrameRate)
     {
         m_fWaitTime = 0.0f;
     }
+
+    m_gsFramePacer.SetFrameRate(m_fFrameRate);
 }
 
 void GS_Application::ShowFrameRate()
 {
-    char outputString[128] = { 0 };
-    sprintf(outputString, "The program ran at an average of %0.2f frames per second.",
-            m_gsFrameTimer.GetFrameRate());
+    char outputString[320] = { 0 };
+    GS_FrameStats gsFrameStats;
+    m_gsFrameTimer.GetFrameStats(&gsFrameStats);
+    sprintf(outputString, "The program ran at an average of %0.2f frames per second.\n\n"
+            "Frame time mean / min / max / p95 / p99: %0.2f / %0.2f / %0.2f / %0.2f / %0.2f ms.\n"
+            "Frame pacing jitter mean / max: %0.2f / %0.2f ms.",
+            m_gsFrameTimer.GetFrameRate(), gsFrameStats.dMean, gsFrameStats.dMin,
+            gsFrameStats.dMax, gsFrameStats.dP95, gsFrameStats.dP99,
+            m_gsFramePacer.GetJitter(), m_gsFramePacer.GetMaxJitter());
     MessageBox(NULL, outputString, "GAME INFORMATION", MB_OK | MB_ICONINFORMATION);
 }
 
 #endif // !GS_PLATFORM_WINDOWS
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Fixed Step Methods //////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Application::RunFixedStep():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Runs the game with a fixed simulation step, which is what GameLoop() does unless a
+//          game overrides it. The time the last frame took is added to an accumulator and
+//          GameUpdate() is called once for every whole step in it, so the simulation gives the
+//          same results whatever the frame rate. GameRender() is then called with how far the
+//          frame is between the last two steps, to interpolate what it draws.
+// ---------------------------------------------------------------------------------------------
+// Details: The accumulator is capped at GS_MAX_UPDATE_STEPS steps. After a long frame the game
+//          slows down rather than spending ever longer catching up.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if GameUpdate() or GameRender() failed.
+//==============================================================================================
+
+BOOL GS_Application::RunFixedStep()
+{
+
+    double dStepTime = 1000.0 / m_fUpdateRate;
+
+    m_dAccumulator += m_fFrameTime;
+
+    if (m_dAccumulator > dStepTime * GS_MAX_UPDATE_STEPS)
+    {
+        m_dAccumulator = dStepTime * GS_MAX_UPDATE_STEPS;
+    }
+
+    // Simulate all the whole steps that fit in the time passed.
+    while (m_dAccumulator >= dStepTime)
+    {
+        GS_PROFILE_SCOPE("GameUpdate");
+
+        if (TRUE != this->GameUpdate((float) (dStepTime / 1000.0)))
+        {
+            return FALSE;
+        }
+
+        m_dAccumulator -= dStepTime;
+    }
+
+    m_fInterpolation = (float) (m_dAccumulator / dStepTime);
+
+    GS_PROFILE_SCOPE("GameRender");
+
+    return this->GameRender(m_fInterpolation);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Application::SetUpdateRate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the number of fixed simulation steps per second, see RunFixedStep().
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_Application::SetUpdateRate(float fUpdateRate)
+{
+
+    if (fUpdateRate <= 0.0f)
+    {
+        return;
+    }
+
+    m_fUpdateRate  = fUpdateRate;
+    m_dAccumulator = 0.0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Application::GetUpdateRate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of fixed simulation steps per second.
+//==============================================================================================
+
+float GS_Application::GetUpdateRate()
+{
+
+    return m_fUpdateRate;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Application::GetStepTime():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The time, in seconds, each call to GameUpdate() simulates.
+//==============================================================================================
+
+float GS_Application::GetStepTime()
+{
+
+    return 1.0f / m_fUpdateRate;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Application::GetInterpolation():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: How far between the last two simulation steps the current frame is, from 0.0 (the
+//          previous step) to 1.0 (the last step).
+//==============================================================================================
+
+float GS_Application::GetInterpolation()
+{
+
+    return m_fInterpolation;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
@@ -27,6 +27,9 @@
 #define GS_DEFAULT_DEPTH  32
 #define GS_DEFAULT_MODE   1
 #define GS_DEFAULT_FPS    60.0f
+// ---------------------------------------------------------------------------------------------
+#define GS_DEFAULT_UPDATE_RATE 60.0f // Fixed simulation steps per second.
+#define GS_MAX_UPDATE_STEPS    5     // Most steps simulated in one frame to catch up.
 //==============================================================================================
 
 
@@ -64,6 +67,7 @@
 #include "gs_error.h"
 #include "gs_timer.h"
 #include "gs_object.h"
+#include "gs_profiler.h"
 //==============================================================================================
 
 
@@ -100,10 +104,17 @@ private:
     RECT  m_rcWindowClient;   // Coordinates of window's client area.
 
     GS_FrameTimer m_gsFrameTimer; // Frame timer object.
+    GS_FramePacer m_gsFramePacer; // Sleeps until each frame is due.
     float         m_fFrameRate;   // Frame-rate of application.
     float         m_fFrameTime;   // Time it took to complete the last frame.
     float         m_fWaitTime;    // Time to wait between frames.
 
+    GS_Profiler m_gsProfiler; // Times every frame once created (see GetProfiler()).
+
+    float  m_fUpdateRate;    // Number of fixed simulation steps per second.
+    double m_dAccumulator;   // Frame time not simulated yet, in milliseconds.
+    float  m_fInterpolation; // How far between the last two steps the frame is (0.0 to 1.0).
+
 protected:
 
     virtual BOOL GameInit()
@@ -123,6 +134,14 @@ protected:
         return TRUE;
     }
     virtual BOOL GameLoop()
+    {
+        return this->RunFixedStep();
+    }
+    virtual BOOL GameUpdate(float)
+    {
+        return TRUE;
+    }
+    virtual BOOL GameRender(float)
     {
         return TRUE;
     }
@@ -131,6 +150,8 @@ protected:
         return;
     }
 
+    BOOL RunFixedStep();
+
 
 public:
 
@@ -147,6 +168,11 @@ public:
     void SetFrameRate(float fFrameRate);
     void ShowFrameRate();
 
+    void  SetUpdateRate(float fUpdateRate);
+    float GetUpdateRate();
+    float GetStepTime();
+    float GetInterpolation();
+
 #ifdef GS_PLATFORM_WINDOWS
     HINSTANCE& GetInstance()
     {
@@ -204,6 +230,14 @@ public:
     {
         return m_fFrameTime;
     }
+    double GetFrameJitter()
+    {
+        return m_gsFramePacer.GetJitter();
+    }
+    GS_Profiler* GetProfiler()
+    {
+        return &m_gsProfiler;
+    }
 
     void SetTitle(LPCTSTR lpString)
     {
@@ -0,0 +1,753 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_collision_world.cpp, gs_collision_world.h                                        |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_CollisionWorld                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: A broad phase for collision detection. Bodies are rectangles kept in a uniform grid |
+ |        whose cells are hashed into buckets, so finding the bodies that may overlap only    |
+ |        tests bodies that share a cell instead of every body against every other body.      |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_collision_world.h"
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor/Destructor Methods //////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_CollisionWorld::GS_CollisionWorld():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The constructor, initializes class data when class object is created.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_CollisionWorld::GS_CollisionWorld()
+{
+
+    m_pBodies    = NULL;
+    m_nMaxBodies = 0;
+    m_nNumBodies = 0;
+    m_nFirstFree = -1;
+
+    m_pBuckets    = NULL;
+    m_nNumBuckets = 0;
+    m_nCellSize   = GS_COLLISION_CELL_SIZE;
+
+    m_nMark = 0;
+
+    m_bIsReady = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_CollisionWorld::~GS_CollisionWorld():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The de-structor, de-initializes class data when class object is destroyed.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_CollisionWorld::~GS_CollisionWorld()
+{
+
+    this->Destroy();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Create/Destroy Methods //////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_CollisionWorld::Create():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Creates an empty world with space for nMaxBodies bodies. The cell size should be
+//          about the size of a typical body, a body then covers no more than four cells.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if not.
+//==============================================================================================
+
+BOOL GS_CollisionWorld::Create(int nCellSize, int nMaxBodies)
+{
+
+    // Destroy the world if created previously.
+    this->Destroy();
+
+    if (nCellSize < 1)
+    {
+        nCellSize = 1;
+    }
+
+    if (nMaxBodies < 1)
+    {
+        nMaxBodies = 1;
+    }
+
+    // Use about two buckets per body, a power of two so a hash can be masked to a bucket.
+    int nNumBuckets = 64;
+
+    while (nNumBuckets < nMaxBodies * 2)
+    {
+        nNumBuckets *= 2;
+    }
+
+    m_pBodies  = new GS_CollisionBody[nMaxBodies];
+    m_pBuckets = new GS_List<int>[nNumBuckets];
+
+    if ((NULL == m_pBodies) || (NULL == m_pBuckets))
+    {
+        GS_Error::Report("GS_COLLISION_WORLD.CPP", 118, "Failed to allocate collision world!");
+        this->Destroy();
+        return FALSE;
+    }
+
+    // Chain all the bodies into the list of unused bodies.
+    for (int nLoop = 0; nLoop < nMaxBodies; nLoop++)
+    {
+        m_pBodies[nLoop].pUserData = NULL;
+        m_pBodies[nLoop].nMark     = 0;
+        m_pBodies[nLoop].nNextFree = (nLoop + 1 < nMaxBodies) ? nLoop + 1 : -1;
+        m_pBodies[nLoop].bIsUsed   = FALSE;
+    }
+
+    m_nMaxBodies  = nMaxBodies;
+    m_nNumBodies  = 0;
+    m_nFirstFree  = 0;
+    m_nNumBuckets = nNumBuckets;
+    m_nCellSize   = nCellSize;
+    m_nMark       = 0;
+
+    m_bIsReady = TRUE;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_CollisionWorld::Destroy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Removes all bodies and frees the memory used by the world.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_CollisionWorld::Destroy()
+{
+
+    GS_SAFE_DELETE_ARRAY(m_pBodies);
+    GS_SAFE_DELETE_ARRAY(m_pBuckets);
+
+    m_nMaxBodies  = 0;
+    m_nNumBodies  = 0;
+    m_nFirstFree  = -1;
+    m_nNumBuckets = 0;
+
+    m_bIsReady = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Grid Methods ////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_CollisionWorld::GetCell():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Converts a coordinate to the cell it lies in, rounding down for negative
+//          coordinates too.
+// ---------------------------------------------------------------------------------------------
+// Returns: The cell number.
+//==============================================================================================
+
+int GS_CollisionWorld::GetCell(long lCoord)
+{
+
+    if (lCoord >= 0)
+    {
+        return (int) (lCoord / m_nCellSize);
+    }
+
+    return (int) (-((-lCoord - 1) / m_nCellSize) - 1);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_CollisionWorld::GetBucket():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Hashes a cell to a bucket. Different cells may share a bucket, which only means a
+//          few more bodies are tested.
+// ---------------------------------------------------------------------------------------------
+// Returns: The bucket number.
+//==============================================================================================
+
+int GS_CollisionWorld::GetBucket(int nCellX, int nCellY)
+{
+
+    unsigned int nHash = ((unsigned int) nCellX * 73856093u) ^
+                         ((unsigned int) nCellY * 19349663u);
+
+    return (int) (nHash & (unsigned int) (m_nNumBuckets - 1));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_CollisionWorld::InsertCells():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Adds a body to the buckets of all the cells it covers.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_CollisionWorld::InsertCells(int nBody)
+{
+
+    GS_CollisionBody* pBody = &m_pBodies[nBody];
+
+    for (int nCellY = pBody->nCellBottom; nCellY <= pBody->nCellTop; nCellY++)
+    {
+        for (int nCellX = pBody->nCellLeft; nCellX <= pBody->nCellRight; nCellX++)
+        {
+            m_pBuckets[this->GetBucket(nCellX, nCellY)].AddItem(nBody);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_CollisionWorld::RemoveCells():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Removes a body from the buckets of all the cells it covers, once per cell since
+//          two of its cells may share a bucket.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_CollisionWorld::RemoveCells(int nBody)
+{
+
+    GS_CollisionBody* pBody = &m_pBodies[nBody];
+
+    for (int nCellY = pBody->nCellBottom; nCellY <= pBody->nCellTop; nCellY++)
+    {
+        for (int nCellX = pBody->nCellLeft; nCellX <= pBody->nCellRight; nCellX++)
+        {
+            GS_List<int>* pBucket = &m_pBuckets[this->GetBucket(nCellX, nCellY)];
+
+            pBucket->RemoveIndex(pBucket->FindItem(nBody));
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_CollisionWorld::NextMark():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Starts a new query. Bodies are marked as they are found so a body covering several
+//          cells is reported once, a new mark saves clearing the marks of the last query.
+// ---------------------------------------------------------------------------------------------
+// Returns: The mark for the new query.
+//==============================================================================================
+
+unsigned int GS_CollisionWorld::NextMark()
+{
+
+    // Clear the marks in the unlikely case that the counter wraps around.
+    if (++m_nMark == 0)
+    {
+        for (int nLoop = 0; nLoop < m_nMaxBodies; nLoop++)
+        {
+            m_pBodies[nLoop].nMark = 0;
+        }
+
+        m_nMark = 1;
+    }
+
+    return m_nMark;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_CollisionWorld::IsOverlapping():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Tests two rectangles for overlap the same way GS_OGLCollide::IsRectOnRect() does,
+//          rectangles that only touch don't overlap.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the rectangles overlap, FALSE if not.
+//==============================================================================================
+
+BOOL GS_CollisionWorld::IsOverlapping(const RECT& rcA, const RECT& rcB)
+{
+
+    return (rcA.top > rcB.bottom) && (rcA.bottom < rcB.top) &&
+           (rcA.right > rcB.left) && (rcA.left < rcB.right);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Body Methods ////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_CollisionWorld::AddBody():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Adds a body to the world. Only nPercent of the width and height of the rectangle,
+//          centered in it, is tested for collisions, like the nPercent argument of the
+//          GS_OGLCollide methods, but the rectangle is shrunk once instead of on every test.
+// ---------------------------------------------------------------------------------------------
+// Returns: The body number, -1 if the world is full.
+//==============================================================================================
+
+int GS_CollisionWorld::AddBody(RECT rcBounds, int nPercent, void* pUserData)
+{
+
+    if (!m_bIsReady)
+    {
+        return -1;
+    }
+
+    if (m_nFirstFree < 0)
+    {
+        GS_Error::Report("GS_COLLISION_WORLD.CPP", 355, "Too many collision bodies!");
+        return -1;
+    }
+
+    int nBody = m_nFirstFree;
+
+    GS_CollisionBody* pBody = &m_pBodies[nBody];
+
+    m_nFirstFree = pBody->nNextFree;
+
+    pBody->nPercent  = nPercent;
+    pBody->pUserData = pUserData;
+    pBody->nNextFree = -1;
+    pBody->bIsUsed   = TRUE;
+
+    // Set the rectangle and the cells it covers, then add it to their buckets.
+    pBody->nCellLeft   = 0;
+    pBody->nCellBottom = 0;
+    pBody->nCellRight  = -1;
+    pBody->nCellTop    = -1;
+
+    m_nNumBodies++;
+
+    this->MoveBody(nBody, rcBounds);
+
+    return nBody;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_CollisionWorld::RemoveBody():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Removes a body from the world, its number may be reused by AddBody().
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_CollisionWorld::RemoveBody(int nBody)
+{
+
+    if ((nBody < 0) || (nBody >= m_nMaxBodies) || (!m_pBodies[nBody].bIsUsed))
+    {
+        return;
+    }
+
+    this->RemoveCells(nBody);
+
+    m_pBodies[nBody].pUserData = NULL;
+    m_pBodies[nBody].nNextFree = m_nFirstFree;
+    m_pBodies[nBody].bIsUsed   = FALSE;
+
+    m_nFirstFree = nBody;
+    m_nNumBodies--;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_CollisionWorld::MoveBody():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets a new rectangle for a body. The buckets are only updated when the body moves
+//          into other cells, so a body moving within its cells costs next to nothing.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_CollisionWorld::MoveBody(int nBody, RECT rcBounds)
+{
+
+    if ((nBody < 0) || (nBody >= m_nMaxBodies) || (!m_pBodies[nBody].bIsUsed))
+    {
+        return;
+    }
+
+    GS_CollisionBody* pBody = &m_pBodies[nBody];
+
+    pBody->rcBounds = rcBounds;
+    pBody->rcShape  = rcBounds;
+
+    if (pBody->nPercent > 0)
+    {
+        m_gsCollide.SetRectPercentXY(&pBody->rcShape, pBody->nPercent);
+    }
+
+    // The right and top edges are exclusive.
+    int nCellLeft   = this->GetCell(pBody->rcShape.left);
+    int nCellBottom = this->GetCell(pBody->rcShape.bottom);
+    int nCellRight  = this->GetCell(std::max(pBody->rcShape.left, pBody->rcShape.right - 1));
+    int nCellTop    = this->GetCell(std::max(pBody->rcShape.bottom, pBody->rcShape.top - 1));
+
+    if ((nCellLeft  == pBody->nCellLeft)  && (nCellBottom == pBody->nCellBottom) &&
+        (nCellRight == pBody->nCellRight) && (nCellTop    == pBody->nCellTop))
+    {
+        return;
+    }
+
+    this->RemoveCells(nBody);
+
+    pBody->nCellLeft   = nCellLeft;
+    pBody->nCellBottom = nCellBottom;
+    pBody->nCellRight  = nCellRight;
+    pBody->nCellTop    = nCellTop;
+
+    this->InsertCells(nBody);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_CollisionWorld::GetBodyRect():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE and the rectangle of the body as given, FALSE if the body doesn't exist.
+//==============================================================================================
+
+BOOL GS_CollisionWorld::GetBodyRect(int nBody, RECT* prcBounds)
+{
+
+    if ((nBody < 0) || (nBody >= m_nMaxBodies) || (!m_pBodies[nBody].bIsUsed) || !prcBounds)
+    {
+        return FALSE;
+    }
+
+    *prcBounds = m_pBodies[nBody].rcBounds;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_CollisionWorld::GetUserData():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The user data the body was added with, NULL if the body doesn't exist.
+//==============================================================================================
+
+void* GS_CollisionWorld::GetUserData(int nBody)
+{
+
+    if ((nBody < 0) || (nBody >= m_nMaxBodies) || (!m_pBodies[nBody].bIsUsed))
+    {
+        return NULL;
+    }
+
+    return m_pBodies[nBody].pUserData;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_CollisionWorld::GetNumBodies():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of bodies in the world.
+//==============================================================================================
+
+int GS_CollisionWorld::GetNumBodies()
+{
+
+    return m_nNumBodies;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Query Methods ///////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_CollisionWorld::FindPairs():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Finds the pairs of bodies that overlap. Each body is only tested against the bodies
+//          in the buckets of its own cells, and against each of them once. Every pair is
+//          reported once, with the lower numbered body first.
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of pairs written to pPairs, at most nMaxPairs.
+//==============================================================================================
+
+int GS_CollisionWorld::FindPairs(GS_CollisionPair* pPairs, int nMaxPairs)
+{
+
+    if (!m_bIsReady || !pPairs)
+    {
+        return 0;
+    }
+
+    int nNumPairs = 0;
+
+    for (int nBodyA = 0; nBodyA < m_nMaxBodies; nBodyA++)
+    {
+        GS_CollisionBody* pBodyA = &m_pBodies[nBodyA];
+
+        if (!pBodyA->bIsUsed)
+        {
+            continue;
+        }
+
+        unsigned int nMark = this->NextMark();
+
+        for (int nCellY = pBodyA->nCellBottom; nCellY <= pBodyA->nCellTop; nCellY++)
+        {
+            for (int nCellX = pBodyA->nCellLeft; nCellX <= pBodyA->nCellRight; nCellX++)
+            {
+                GS_List<int>* pBucket = &m_pBuckets[this->GetBucket(nCellX, nCellY)];
+
+                for (int nLoop = 0; nLoop < pBucket->GetNumItems(); nLoop++)
+                {
+                    int nBodyB = (*pBucket)[nLoop];
+
+                    // Pairs are found from their lower numbered body.
+                    if ((nBodyB <= nBodyA) || (m_pBodies[nBodyB].nMark == nMark))
+                    {
+                        continue;
+                    }
+
+                    m_pBodies[nBodyB].nMark = nMark;
+
+                    if (IsOverlapping(pBodyA->rcShape, m_pBodies[nBodyB].rcShape))
+                    {
+                        if (nNumPairs >= nMaxPairs)
+                        {
+                            return nNumPairs;
+                        }
+
+                        pPairs[nNumPairs].nBodyA = nBodyA;
+                        pPairs[nNumPairs].nBodyB = nBodyB;
+                        nNumPairs++;
+                    }
+                }
+            }
+        }
+    }
+
+    return nNumPairs;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_CollisionWorld::QueryRect():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Finds the bodies overlapping a rectangle.
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of bodies written to pBodies, at most nMaxBodies.
+//==============================================================================================
+
+int GS_CollisionWorld::QueryRect(RECT rcArea, int* pBodies, int nMaxBodies)
+{
+
+    if (!m_bIsReady || !pBodies)
+    {
+        return 0;
+    }
+
+    int nNumBodies = 0;
+
+    unsigned int nMark = this->NextMark();
+
+    int nCellLeft   = this->GetCell(rcArea.left);
+    int nCellBottom = this->GetCell(rcArea.bottom);
+    int nCellRight  = this->GetCell(std::max(rcArea.left, rcArea.right - 1));
+    int nCellTop    = this->GetCell(std::max(rcArea.bottom, rcArea.top - 1));
+
+    for (int nCellY = nCellBottom; nCellY <= nCellTop; nCellY++)
+    {
+        for (int nCellX = nCellLeft; nCellX <= nCellRight; nCellX++)
+        {
+            GS_List<int>* pBucket = &m_pBuckets[this->GetBucket(nCellX, nCellY)];
+
+            for (int nLoop = 0; nLoop < pBucket->GetNumItems(); nLoop++)
+            {
+                int nBody = (*pBucket)[nLoop];
+
+                if (m_pBodies[nBody].nMark == nMark)
+                {
+                    continue;
+                }
+
+                m_pBodies[nBody].nMark = nMark;
+
+                if (IsOverlapping(rcArea, m_pBodies[nBody].rcShape))
+                {
+                    if (nNumBodies >= nMaxBodies)
+                    {
+                        return nNumBodies;
+                    }
+
+                    pBodies[nNumBodies++] = nBody;
+                }
+            }
+        }
+    }
+
+    return nNumBodies;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_CollisionWorld::QueryPoint():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Finds the bodies containing a point, the same way GS_OGLCollide::IsCoordInRect()
+//          tests a point (the left and bottom edges are inside, the right and top edges not).
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of bodies written to pBodies, at most nMaxBodies.
+//==============================================================================================
+
+int GS_CollisionWorld::QueryPoint(int nCoordX, int nCoordY, int* pBodies, int nMaxBodies)
+{
+
+    if (!m_bIsReady || !pBodies)
+    {
+        return 0;
+    }
+
+    int nNumBodies = 0;
+
+    // A point lies in one cell, so no body can be found twice, unless it is in the bucket more
+    // than once because two of its cells hash to it.
+    unsigned int nMark = this->NextMark();
+
+    GS_List<int>* pBucket = &m_pBuckets[this->GetBucket(this->GetCell(nCoordX),
+                                                        this->GetCell(nCoordY))];
+
+    for (int nLoop = 0; nLoop < pBucket->GetNumItems(); nLoop++)
+    {
+        int nBody = (*pBucket)[nLoop];
+
+        GS_CollisionBody* pBody = &m_pBodies[nBody];
+
+        if (pBody->nMark == nMark)
+        {
+            continue;
+        }
+
+        pBody->nMark = nMark;
+
+        if ((nCoordX >= pBody->rcShape.left)   && (nCoordX < pBody->rcShape.right) &&
+            (nCoordY >= pBody->rcShape.bottom) && (nCoordY < pBody->rcShape.top))
+        {
+            if (nNumBodies >= nMaxBodies)
+            {
+                return nNumBodies;
+            }
+
+            pBodies[nNumBodies++] = nBody;
+        }
+    }
+
+    return nNumBodies;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Status Methods //////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_CollisionWorld::IsReady():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the world has been created, FALSE if not.
+//==============================================================================================
+
+BOOL GS_CollisionWorld::IsReady()
+{
+
+    return m_bIsReady;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,146 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_collision_world.cpp, gs_collision_world.h                                        |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_CollisionWorld                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: A broad phase for collision detection. Bodies are rectangles kept in a uniform grid |
+ |        whose cells are hashed into buckets, so finding the bodies that may overlap only    |
+ |        tests bodies that share a cell instead of every body against every other body.      |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+#ifndef GS_COLLISION_WORLD_H
+#define GS_COLLISION_WORLD_H
+
+
+//==============================================================================================
+// Include platform abstraction header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_platform.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include standard C++ library header files.
+// ---------------------------------------------------------------------------------------------
+#include <algorithm>
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_error.h"
+#include "gs_list.h"
+#include "gs_object.h"
+#include "gs_ogl_collide.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Collision world defines.
+// ---------------------------------------------------------------------------------------------
+#define GS_COLLISION_CELL_SIZE  64   // Default width and height of a grid cell in pixels.
+#define GS_COLLISION_MAX_BODIES 1024 // Default number of bodies the world can hold.
+//==============================================================================================
+
+
+//==============================================================================================
+// Collision body structure.
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_COLLISION_BODY
+{
+    RECT  rcBounds;   // The rectangle as given (top is greater than bottom).
+    RECT  rcShape;    // The rectangle shrunk by nPercent, which is what is tested.
+    int   nPercent;   // Percentage of the size of the rectangle tested, 0 for all of it.
+    void* pUserData;  // Anything the caller wants to find the body's owner by.
+    int   nCellLeft;  // The range of grid cells the shape covers.
+    int   nCellBottom;
+    int   nCellRight;
+    int   nCellTop;
+    unsigned int nMark; // Used to report a body only once per query.
+    int   nNextFree;    // The next unused body, if this one is unused.
+    BOOL  bIsUsed;
+} GS_CollisionBody;
+//==============================================================================================
+
+
+//==============================================================================================
+// Collision pair structure.
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_COLLISION_PAIR
+{
+    int nBodyA; // The lower numbered of the two bodies.
+    int nBodyB;
+} GS_CollisionPair;
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_CollisionWorld : public GS_Object
+{
+
+private:
+
+    GS_OGLCollide m_gsCollide; // Shrinks rectangles by a percentage.
+
+    GS_CollisionBody* m_pBodies;
+    int m_nMaxBodies;
+    int m_nNumBodies;
+    int m_nFirstFree; // The first unused body, -1 if all are used.
+
+    GS_List<int>* m_pBuckets; // The bodies in the cells hashed to each bucket.
+    int m_nNumBuckets;        // Always a power of two.
+    int m_nCellSize;
+
+    unsigned int m_nMark; // Incremented for every query.
+
+    BOOL m_bIsReady;
+
+    int  GetCell(long lCoord);
+    int  GetBucket(int nCellX, int nCellY);
+    void InsertCells(int nBody);
+    void RemoveCells(int nBody);
+    unsigned int NextMark();
+
+    static BOOL IsOverlapping(const RECT& rcA, const RECT& rcB);
+
+protected:
+
+    // No protected members.
+
+public:
+
+    GS_CollisionWorld();
+    ~GS_CollisionWorld();
+
+    BOOL Create(int nCellSize = GS_COLLISION_CELL_SIZE,
+                int nMaxBodies = GS_COLLISION_MAX_BODIES);
+    void Destroy();
+
+    int  AddBody(RECT rcBounds, int nPercent = 0, void* pUserData = NULL);
+    void RemoveBody(int nBody);
+    void MoveBody(int nBody, RECT rcBounds);
+
+    BOOL  GetBodyRect(int nBody, RECT* prcBounds);
+    void* GetUserData(int nBody);
+    int   GetNumBodies();
+
+    int FindPairs(GS_CollisionPair* pPairs, int nMaxPairs);
+    int QueryRect(RECT rcArea, int* pBodies, int nMaxBodies);
+    int QueryPoint(int nCoordX, int nCoordY, int* pBodies, int nMaxBodies);
+
+    BOOL IsReady();
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -42,6 +42,36 @@ GS_Demo::GS_Demo() : GS_Application()
     m_nVolume = 255;
 
     m_bIsFirstRun = TRUE;
+    m_bIsProfileShown = FALSE;
+
+    m_glfRotTriangle     = 0.0f;
+    m_glfRotQuad         = 0.0f;
+    m_glfPrevRotTriangle = 0.0f;
+    m_glfPrevRotQuad     = 0.0f;
+
+    m_glfCubeRotateX     = 0.0f;
+    m_glfCubeRotateY     = 0.0f;
+    m_glfCubeDepthZ      = -5.0f;
+    m_glfPrevCubeRotateX = 0.0f;
+    m_glfPrevCubeRotateY = 0.0f;
+    m_glfPrevCubeDepthZ  = -5.0f;
+
+    m_glfRollGrnd = 0.0f;
+    m_glfRollClds = 0.0f;
+    m_glfRollTex  = 0.0f;
+    m_glfPrevRollGrnd = 0.0f;
+    m_glfPrevRollClds = 0.0f;
+    m_glfPrevRollTex  = 0.0f;
+
+    m_nPrevMapX = 0;
+    m_nPrevMapY = 0;
+
+    m_glfSpriteTransparency    = 1.0f;
+    m_glfFontTransparency      = 1.0f;
+    m_glfCollisionTransparency = 1.0f;
+    m_glfMenuTransparency      = 1.0f;
+    m_glfMapTransparency       = 1.0f;
+    m_glfParticleTransparency  = 1.0f;
 
     m_bUseVSync = FALSE;
     m_bUseAliasing = FALSE;
@@ -123,9 +153,6 @@ BOOL GS_Demo::GameSetup()
         }
     }
 
-    // Set render scaling values
-    this->SetRenderScaling(this->GetWidth(), this->GetHeight(), true);
-
     // Close the ini file.
     gsIniFile.Close();
 
@@ -195,15 +222,47 @@ BOOL GS_Demo::GameInit()
     m_gsDisplay.EnableVSync(FALSE);
     m_gsDisplay.EnableBlending(TRUE);
 
+    // Draw all sprites rendered between BeginRender2D() and EndRender2D() in batches.
+    m_gsDisplay.EnableBatching(TRUE);
+
+    // Render 2D at the internal resolution and scale it to the window in a single pass.
+    m_gsDisplay.SetRenderResolution(INTERNAL_RES_X, INTERNAL_RES_Y, TRUE);
+    m_gsDisplay.EnableRenderTarget(TRUE, GL_NEAREST);
+
     // Setup a light for lighting effects.
     m_gsDisplay.SetLightAmbient(0.5f, 0.5f, 0.5f, 1.0f);
     m_gsDisplay.SetLightDiffuse(1.0f, 1.0f, 1.0f, 1.0f);
     m_gsDisplay.SetLightPosition(0.0f, 0.0f, 2.0f, 1.0f);
 
+    // Time the frames, F6 shows the timings and F7 saves them to a trace file.
+    if (!this->GetProfiler()->IsReady())
+    {
+        this->GetProfiler()->Create();
+    }
+
     /////////////////////////////////////////////////////////////////////////////////////////////
 
+    // Pack the (unfiltered) font and menu images into a texture atlas, so that the fonts and
+    // menu created below share a single texture.
+    if (m_gsAtlas.Create())
+    {
+        m_gsAtlas.AddImage("data/font_s.tga");
+        m_gsAtlas.AddImage("data/font_l.tga");
+        m_gsAtlas.AddImage("data/menu.tga");
+        m_gsAtlas.AddImage("data/menu_font.tga");
+        m_gsAtlas.Build(FALSE);
+        m_gsAtlas.Activate();
+    }
+
+    // Start the worker threads (one for every core except this one).
+    m_gsJobSystem.Create();
+
+    // Load the textures that aren't needed right away in the background, GameLoop() creates
+    // them once they have been decoded.
+    m_gsAssetLoader.Create(&m_gsJobSystem);
+
     // Create an OpenGL texture.
-    m_gsTexture.Create("data/crate.tga");
+    m_gsAssetLoader.LoadTexture(&m_gsTexture, "data/crate.tga");
 
     // Create an unfiltered OpenGL background sprite.
     m_gsBackgrnd.Create("data/backgrnd.tga", FALSE);
@@ -212,10 +271,11 @@ BOOL GS_Demo::GameInit()
 
     // Create an unfiltered sprite with 25 frames, 5 frames per line and 96x96 size.
     m_gsSpriteEx.Create("data/asteroid_l.tga", 25, 5, 96, 96, FALSE);
-    // Create an OpenGL font with 16 characters per line and 16x16 size.
-    m_gsSmallFont.Create("data/font_s.tga", 16, 16, 16);
-    // Create an OpenGL font with 10 characters per line and 32x32 size.
-    m_gsLargeFont.Create("data/font_l.tga", 10, 32, 32);
+    // Create an unfiltered OpenGL font with 16 characters per line and 16x16 size, without
+    // mipmaps so that it comes from the texture atlas.
+    m_gsSmallFont.Create("data/font_s.tga", 16, 16, 16, FALSE, FALSE);
+    // Create an unfiltered OpenGL font with 10 characters per line and 32x32 size.
+    m_gsLargeFont.Create("data/font_l.tga", 10, 32, 32, FALSE, FALSE);
 
     // Create an unfiltered OpenGL mipmap texture for the asteroid sprites.
     m_gsSpriteTexture.Create("data/asteroid_s.tga", GS_MIPMAP, GL_NEAREST, GL_NEAREST);
@@ -237,12 +297,22 @@ BOOL GS_Demo::GameInit()
         m_fRotation[nLoop] = (rand() % MAXIMUM_ROTATION) + 1.0f;
     }
 
+    // Add the sprites to a collision world, only 60% of a sprite is tested for collisions.
+    m_gsCollisionWorld.Create(64, MAXIMUM_SPRITES);
+    for (int nLoop = 0; nLoop < MAXIMUM_SPRITES; nLoop++)
+    {
+        RECT rcSprite;
+        m_gsSprites[nLoop].GetDestRect(&rcSprite);
+        m_nSpriteBody[nLoop] = m_gsCollisionWorld.AddBody(rcSprite, 60, (void*) (intptr_t) nLoop);
+    }
+
     // Create textures for the ground and clouds.
-    m_gsGroundTexture.Create("data/ground.tga");
-    m_gsCloudsTexture.Create("data/clouds.tga");
+    m_gsAssetLoader.LoadTexture(&m_gsGroundTexture, "data/ground.tga");
+    m_gsAssetLoader.LoadTexture(&m_gsCloudsTexture, "data/clouds.tga");
     // Create a menu using the "menu.tga" and "menu_font.tga" images that has 16 characters per
-    // line with dimensions of 16x16 per letter/frame.
-    m_gsMenu.Create("data/menu.tga", "data/menu_font.tga", 16, 16, 16);
+    // line with dimensions of 16x16 per letter/frame (unfiltered and without mipmaps, like the
+    // texture atlas they are in).
+    m_gsMenu.Create("data/menu.tga", "data/menu_font.tga", 16, 16, 16, FALSE, FALSE);
 
     // Create a map using the "map.tga" image that has 64 frames with 8 frames per line and
     // a frame size of 32x32 pixels.
@@ -261,6 +331,8 @@ BOOL GS_Demo::GameInit()
     m_gsMap.SetWrapY(TRUE);
     // Do not render tile eight.
     m_gsMap.SetClearTileID(8);
+    // The player can't walk through tile zero.
+    m_gsMap.SetTileFlags(0, GS_MAP_TILE_SOLID);
     // Create sprite with 4 frames, 4 frames per line and 32x32 size.
     m_gsPlayerSprite.Create("data/player.tga", 4, 4, 32, 32);
     // Set the sprite position one tile up and right from the bottom left corner of the clip box.
@@ -270,6 +342,9 @@ BOOL GS_Demo::GameInit()
     // Create 100 particles using the "particle.tga" image.
     m_gsParticle.Create("data/particle.tga", 100);
 
+    // Everything using the atlas has been created.
+    m_gsAtlas.Activate(FALSE);
+
     // Setup initial starting coordinates for all the particles.
     m_gsParticle.SetDestX(INTERNAL_RES_X / 2);
     m_gsParticle.SetDestY(INTERNAL_RES_Y / 2);
@@ -296,12 +371,29 @@ BOOL GS_Demo::GameInit()
     // Add music to list.
     m_gsSound.AddMusic("data/music.s3m");
 
-    // Add samples to list.
-    m_gsSound.AddSample("data/sample1.wav");
-    m_gsSound.AddSample("data/sample2.wav");
-    m_gsSound.AddSample("data/sample3.wav");
-    m_gsSound.AddSample("data/sample4.wav");
-    m_gsSound.AddSample("data/sample5.wav");
+    // Add samples to list, all at once from the sound bank if it has been made and none of the
+    // samples changed since.
+#ifdef GS_USE_SDL_MIXER
+    if (!m_gsSound.AddSampleBank("data/samples.gsb"))
+#endif
+    {
+        m_gsSound.AddSample("data/sample1.wav");
+        m_gsSound.AddSample("data/sample2.wav");
+        m_gsSound.AddSample("data/sample3.wav");
+        m_gsSound.AddSample("data/sample4.wav");
+        m_gsSound.AddSample("data/sample5.wav");
+#ifdef GS_USE_SDL_MIXER
+        // Save the decoded samples as a sound bank, so they needn't be decoded next time.
+        m_gsSound.SaveSampleBank("data/samples.gsb");
+#endif
+    }
+
+    // The menu sounds may take a voice from the collision sounds when every voice is playing,
+    // but not the other way around.
+    m_gsSound.SetSamplePriority(SAMPLE_IMPACT, 64);
+    m_gsSound.SetSamplePriority(SAMPLE_COLLIDE, 64);
+    m_gsSound.SetSamplePriority(SAMPLE_OPTION, 192);
+    m_gsSound.SetSamplePriority(SAMPLE_SELECT, 192);
 
     // Start playing music at half the volume, half the speed and looping infinitely.
     m_gsSound.PlayMusic(MUSIC_BACKGROUND, 127, 0.5f, TRUE);
@@ -334,6 +426,17 @@ BOOL GS_Demo::GameShutdown()
     // Clear all menu items.
     m_gsMenu.ClearOptions();
 
+    // Remove all the bodies from the collision world.
+    m_gsCollisionWorld.Destroy();
+
+    // Destroy the particles and the asset loader before the worker threads they use.
+    m_gsParticle.Destroy();
+    m_gsAssetLoader.Destroy();
+    m_gsJobSystem.Destroy();
+
+    // Destroy the texture atlas pages while the OpenGL display still exists.
+    m_gsAtlas.Destroy();
+
     // Destroy the OpenGL display.
     m_gsDisplay.Destroy();
 
@@ -366,13 +469,13 @@ BOOL GS_Demo::GameRelease()
     }
 
     // Set OpenGL clear color to black.
-    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    m_gsDisplay.GetState()->ClearColor(0.0f, 0.0f, 0.0f, 0.0f);
     // Clear screen and depth buffer.
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     // Reset the current modelview matrix.
     glLoadIdentity();
     // Swap buffers (double buffering) to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     // Pause all sound.
     m_gsSound.Pause(TRUE);
@@ -512,27 +615,32 @@ BOOL GS_Demo::GameLoop()
     // Was the 'F1' key pressed?
     case GSK_F1:
         SetMode(320, 240, GetColorDepth(), IsWindowed());
-        this->SetRenderScaling(this->GetWidth(), this->GetHeight(), true);
         break;
     // Was the 'F2' key pressed?
     case GSK_F2:
         SetMode(400, 300, GetColorDepth(), IsWindowed());
-        this->SetRenderScaling(this->GetWidth(), this->GetHeight(), true);
         break;
     // Was the 'F3' key pressed?
     case GSK_F3:
         SetMode(640, 480, GetColorDepth(), IsWindowed());
-        this->SetRenderScaling(this->GetWidth(), this->GetHeight(), true);
         break;
     // Was the 'F4' key pressed?
     case GSK_F4:
         SetMode(800, 600, GetColorDepth(), IsWindowed());
-        this->SetRenderScaling(this->GetWidth(), this->GetHeight(), true);
         break;
     // Was the 'F5' key pressed?
     case GSK_F5:
         SetMode(1024, 768, GetColorDepth(), IsWindowed());
-        this->SetRenderScaling(this->GetWidth(), this->GetHeight(), true);
+        break;
+    // Was the 'F6' key pressed?
+    case GSK_F6:
+        // Show or hide the frame profile.
+        m_bIsProfileShown = !m_bIsProfileShown;
+        break;
+    // Was the 'F7' key pressed?
+    case GSK_F7:
+        // Save the most recent frames for chrome://tracing or Perfetto.
+        this->GetProfiler()->SaveTrace("profile.json");
         break;
     // Was the '+' key pressed?
     case GSK_ADD:
@@ -556,12 +664,82 @@ BOOL GS_Demo::GameLoop()
         break;
     } // end switch(nButton)
 
+    // Create the textures that have finished loading in the background.
+    m_gsAssetLoader.Update();
+
     // Setup particles for particle demo.
     if (m_nGameProgress != 11)
     {
         m_bIsFirstRun = TRUE;
     }
 
+    // Simulate the demo in fixed steps and render it, see GameUpdate() and GameRender().
+    return this->RunFixedStep();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// GS_Demo::GameUpdate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Simulates the running demo for one fixed step of fStepTime seconds.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if not.
+//==============================================================================================
+
+BOOL GS_Demo::GameUpdate(float fStepTime)
+{
+
+    // Simulate the running demo, XxxDemo() draws what XxxUpdate() moved.
+    switch (m_nGameProgress)
+    {
+    case 3:
+    case 4:
+        RotateUpdate(fStepTime);
+        break;
+    case 5:
+        TextureUpdate(fStepTime);
+        break;
+    case 6:
+        SpriteUpdate(fStepTime);
+        break;
+    case 7:
+        FontUpdate(fStepTime);
+        break;
+    case 8:
+        CollisionUpdate(fStepTime);
+        break;
+    case 9:
+        MenuUpdate(fStepTime);
+        break;
+    case 10:
+        MapUpdate(fStepTime);
+        break;
+    case 11:
+        ParticleUpdate(fStepTime);
+        break;
+    default:
+        // The clear, polygon and color demos don't move.
+        break;
+    }
+
+    return TRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// GS_Demo::GameRender():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Renders the running demo, fAlpha being how far between the last two simulation
+//          steps the frame is.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if not.
+//==============================================================================================
+
+BOOL GS_Demo::GameRender(float fAlpha)
+{
+
     // Run demo depending on progress.
     switch (m_nGameProgress)
     {
@@ -575,31 +753,31 @@ BOOL GS_Demo::GameLoop()
         ColorDemo();
         break;
     case 3:
-        RotateDemo();
+        RotateDemo(fAlpha);
         break;
     case 4:
-        ShapesDemo();
+        ShapesDemo(fAlpha);
         break;
     case 5:
-        TextureDemo();
+        TextureDemo(fAlpha);
         break;
     case 6:
-        SpriteDemo();
+        SpriteDemo(fAlpha);
         break;
     case 7:
-        FontDemo();
+        FontDemo(fAlpha);
         break;
     case 8:
-        CollisionDemo();
+        CollisionDemo(fAlpha);
         break;
     case 9:
-        MenuDemo();
+        MenuDemo(fAlpha);
         break;
     case 10:
-        MapDemo();
+        MapDemo(fAlpha);
         break;
     case 11:
-        ParticleDemo();
+        ParticleDemo(fAlpha);
         break;
     default:
         // ...
@@ -628,9 +806,6 @@ void GS_Demo::OnChangeMode()
 {
     // Change to windowed or fullscreen mode as selected by the user
     this->SetMode(this->GetWidth(), this->GetHeight(), this->GetColorDepth(), !this->IsWindowed());
-
-    // Set values for scaling
-    this->SetRenderScaling(this->GetWidth(), this->GetHeight(), true);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -720,23 +895,18 @@ LRESULT GS_Demo::MsgProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
             return 0L;
         case IDM_320X240:
             SetMode(320, 240, this->GetColorDepth(), this->IsWindowed());
-            this->SetRenderScaling(this->GetWidth(), this->GetHeight(), true);
             return 0L;
         case IDM_400X300:
             SetMode(400, 300, this->GetColorDepth(), this->IsWindowed());
-            this->SetRenderScaling(this->GetWidth(), this->GetHeight(), true);
             return 0L;
         case IDM_640X480:
             SetMode(640, 480, this->GetColorDepth(), this->IsWindowed());
-            this->SetRenderScaling(this->GetWidth(), this->GetHeight(), true);
             return 0L;
         case IDM_800X600:
             SetMode(800, 600, this->GetColorDepth(), this->IsWindowed());
-            this->SetRenderScaling(this->GetWidth(), this->GetHeight(), true);
             return 0L;
         case IDM_1024X768:
             SetMode(1024, 768, this->GetColorDepth(), this->IsWindowed());
-            this->SetRenderScaling(this->GetWidth(), this->GetHeight(), true);
             return 0L;
         // Sound options.
         case IDM_VOL_PLUS:
@@ -999,13 +1169,13 @@ BOOL GS_Demo::ClearDemo()
     if (IsPaused())
     {
         // Set OpenGL clear color to red.
-        glClearColor(1.0f, 0.0f, 0.0f, 0.0f);
+        m_gsDisplay.GetState()->ClearColor(1.0f, 0.0f, 0.0f, 0.0f);
         // Clear screen and depth buffer.
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         // Reset the current modelview matrix.
         glLoadIdentity();
         // Swap buffers (double buffering) to display results.
-        SwapBuffers(this->GetDevice());
+        m_gsDisplay.EndRender(this->GetDevice());
         // Exit the function.
         return TRUE;
     }
@@ -1025,7 +1195,7 @@ BOOL GS_Demo::ClearDemo()
     // not dark (0.0f). To make a white background, you would set all the colors as high as
     // possible (1.0f). To make a black background you would set all the colors to as low as
     // possible (0.0f).
-    glClearColor(0.0f, 0.0f, 1.0f, 0.0f);
+    m_gsDisplay.GetState()->ClearColor(0.0f, 0.0f, 1.0f, 0.0f);
 
     // Clear screen and depth buffer.
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -1042,10 +1212,10 @@ BOOL GS_Demo::ClearDemo()
     glLoadIdentity();
 
     // Disable texturing for this demo (we're drawing colored shapes)
-    glDisable(GL_TEXTURE_2D);
+    m_gsDisplay.GetState()->Disable(GL_TEXTURE_2D);
 
     // Swap buffers (double buffering) to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     return TRUE;
 }
@@ -1073,19 +1243,19 @@ BOOL GS_Demo::PolyDemo()
     if (IsPaused())
     {
         // Set OpenGL clear color to red.
-        glClearColor(1.0f, 0.0f, 0.0f, 1.0f);
+        m_gsDisplay.GetState()->ClearColor(1.0f, 0.0f, 0.0f, 1.0f);
         // Clear screen and depth buffer.
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         // Reset the current modelview matrix.
         glLoadIdentity();
         // Swap buffers (double buffering) to display results.
-        SwapBuffers(this->GetDevice());
+        m_gsDisplay.EndRender(this->GetDevice());
         // Exit the function.
         return TRUE;
     }
 
     // Set OpenGL clear color to black.
-    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    m_gsDisplay.GetState()->ClearColor(0.0f, 0.0f, 0.0f, 0.0f);
     // Clear screen and depth buffer.
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -1093,7 +1263,7 @@ BOOL GS_Demo::PolyDemo()
     glLoadIdentity();
 
     // Disable texturing for this demo (we're drawing colored shapes)
-    glDisable(GL_TEXTURE_2D);
+    m_gsDisplay.GetState()->Disable(GL_TEXTURE_2D);
 
     /////////////////////////////////////////////////////////////////////////////////////////////
     // New Code /////////////////////////////////////////////////////////////////////////////////
@@ -1166,7 +1336,7 @@ BOOL GS_Demo::PolyDemo()
     /////////////////////////////////////////////////////////////////////////////////////////////
 
     // Swap buffers (double buffering) to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     return TRUE;
 }
@@ -1194,19 +1364,19 @@ BOOL GS_Demo::ColorDemo()
     if (IsPaused())
     {
         // Set OpenGL clear color to red.
-        glClearColor(1.0f, 0.0f, 0.0f, 1.0f);
+        m_gsDisplay.GetState()->ClearColor(1.0f, 0.0f, 0.0f, 1.0f);
         // Clear screen and depth buffer.
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         // Reset the current modelview matrix.
         glLoadIdentity();
         // Swap buffers (double buffering) to display results.
-        SwapBuffers(this->GetDevice());
+        m_gsDisplay.EndRender(this->GetDevice());
         // Exit the function.
         return TRUE;
     }
 
     // Set OpenGL clear color to black.
-    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    m_gsDisplay.GetState()->ClearColor(0.0f, 0.0f, 0.0f, 0.0f);
     // Clear screen and depth buffer.
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -1214,7 +1384,7 @@ BOOL GS_Demo::ColorDemo()
     glLoadIdentity();
 
     // Disable texturing for this demo (we're drawing colored shapes)
-    glDisable(GL_TEXTURE_2D);
+    m_gsDisplay.GetState()->Disable(GL_TEXTURE_2D);
 
     // Move left 1.5 units and into the screen 6.0.
     glTranslatef(-1.5f, 0.0f, -6.0f);
@@ -1274,7 +1444,7 @@ BOOL GS_Demo::ColorDemo()
     glEnd();
 
     // Swap buffers (double buffering) to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     return TRUE;
 }
@@ -1289,7 +1459,7 @@ BOOL GS_Demo::ColorDemo()
 // Returns: TRUE if successfull and FALSE if not.
 //==============================================================================================
 
-BOOL GS_Demo::RotateDemo()
+BOOL GS_Demo::RotateDemo(float fAlpha)
 {
 
     // Make sure we have a valid display before drawing.
@@ -1298,8 +1468,10 @@ BOOL GS_Demo::RotateDemo()
         return FALSE;
     }
 
-    static GLfloat glfRotTrianle = 0.0f; // Rotation angle for the triangle. (NEW)
-    static GLfloat glfRotQuad = 0.0f;    // Rotation angle for the quad. (NEW)
+    // The triangle and quad are spun by RotateUpdate(), draw them between their rotations of
+    // the last two steps so they spin smoothly whatever the frame rate. (NEW)
+    GLfloat glfRotTrianle = GS_Lerp(m_glfPrevRotTriangle, m_glfRotTriangle, fAlpha);
+    GLfloat glfRotQuad    = GS_Lerp(m_glfPrevRotQuad, m_glfRotQuad, fAlpha);
 
     // Is the game paused?
     if (IsPaused())
@@ -1309,7 +1481,7 @@ BOOL GS_Demo::RotateDemo()
     }
 
     // Set OpenGL clear color to black.
-    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    m_gsDisplay.GetState()->ClearColor(0.0f, 0.0f, 0.0f, 0.0f);
     // Clear screen and depth buffer.
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -1317,10 +1489,10 @@ BOOL GS_Demo::RotateDemo()
     glLoadIdentity();
 
     // Disable texturing for this demo
-    glDisable(GL_TEXTURE_2D);
+    m_gsDisplay.GetState()->Disable(GL_TEXTURE_2D);
 
     // Enable depth testing so faces are drawn in correct order
-    glEnable(GL_DEPTH_TEST);
+    m_gsDisplay.GetState()->Enable(GL_DEPTH_TEST);
 
     // Move left 1.5 units and into the screen 6.0.
     glTranslatef(-1.5f, 0.0f, -6.0f);
@@ -1422,29 +1594,52 @@ BOOL GS_Demo::RotateDemo()
     // Finished drawing the quad.
     glEnd();
 
-    /////////////////////////////////////////////////////////////////////////////////////////////
-    // New Code /////////////////////////////////////////////////////////////////////////////////
-    /////////////////////////////////////////////////////////////////////////////////////////////
+    // Swap buffers (double buffering) to display results.
+    m_gsDisplay.EndRender(this->GetDevice());
+
+    return TRUE;
+}
 
-    // The next two lines are new. Think of glfRotTrianle, and glfRotQuad as containers. At the
-    // top of our program we made the containers. When we built the containers they had nothing
-    // in them. The first line below adds 0.2 to that container. So each time we check the value
-    // in the glfRotTrianle container after this section of code, it will have gone up by 0.2.
-    // The glfRotQuad container decreases by 0.15. So every time we check the glfRotQuad
-    // container, it will have gone down by 0.15. Going down will cause the object to spin the
-    // opposite direction it would spin if you were going up.
+////////////////////////////////////////////////////////////////////////////////////////////////
 
-    // Try chaning the + to a - in the line below see how the object spins the other direction.
-    // Try changing the values from 0.2 to 1.0. The higher the number, the faster the object will
-    // spin. The lower the number, the slower it will spin.
+//==============================================================================================
+// GS_Demo::RotateUpdate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Spins the triangle and quad of the rotate and shapes demos, one fixed step of
+//          fStepTime seconds at a time. The rotations are given per 1/60th of a second.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull and FALSE if not.
+//==============================================================================================
 
-    glfRotTrianle += 0.8f; // Increase the rotation variable for the triangle.
-    glfRotQuad -= 0.75f;   // Decrease the rotation variable for the quad.
+BOOL GS_Demo::RotateUpdate(float fStepTime)
+{
 
-    /////////////////////////////////////////////////////////////////////////////////////////////
+    // Scale the per 1/60th of a second rotations to the length of the step.
+    GLfloat glfStepScale = fStepTime * 60.0f;
 
-    // Swap buffers (double buffering) to display results.
-    SwapBuffers(this->GetDevice());
+    // Draw from where the triangle and quad are now.
+    m_glfPrevRotTriangle = m_glfRotTriangle;
+    m_glfPrevRotQuad     = m_glfRotQuad;
+
+    // Keep them where they are while the game is paused.
+    if (IsPaused())
+    {
+        return TRUE;
+    }
+
+    // Think of m_glfRotTriangle and m_glfRotQuad as containers. When we built the containers
+    // they had nothing in them. The first line below adds 0.8 to that container every 1/60th
+    // of a second. So each time we check the value in the m_glfRotTriangle container, it will
+    // have gone up by 0.8. The m_glfRotQuad container decreases by 0.75. So every time we
+    // check the m_glfRotQuad container, it will have gone down by 0.75. Going down will cause
+    // the object to spin the opposite direction it would spin if you were going up.
+
+    // Try chaning the + to a - in the line below see how the object spins the other direction.
+    // Try changing the values from 0.8 to 2.0. The higher the number, the faster the object
+    // will spin. The lower the number, the slower it will spin.
+
+    m_glfRotTriangle += 0.8f * glfStepScale; // Increase the rotation variable for the triangle.
+    m_glfRotQuad -= 0.75f * glfStepScale;    // Decrease the rotation variable for the quad.
 
     return TRUE;
 }
@@ -1459,7 +1654,7 @@ BOOL GS_Demo::RotateDemo()
 // Returns: TRUE if successfull and FALSE if not.
 //==============================================================================================
 
-BOOL GS_Demo::ShapesDemo()
+BOOL GS_Demo::ShapesDemo(float fAlpha)
 {
 
     // Make sure we have a valid display before drawing.
@@ -1468,8 +1663,10 @@ BOOL GS_Demo::ShapesDemo()
         return FALSE;
     }
 
-    static GLfloat glfRotTrianle = 0.0f; // Rotation angle for the triangle.
-    static GLfloat glfRotQuad = 0.0f;    // Rotation angle for the quad.
+    // The triangle and quad are spun by RotateUpdate(), draw them between their rotations of
+    // the last two steps.
+    GLfloat glfRotTrianle = GS_Lerp(m_glfPrevRotTriangle, m_glfRotTriangle, fAlpha);
+    GLfloat glfRotQuad    = GS_Lerp(m_glfPrevRotQuad, m_glfRotQuad, fAlpha);
 
     // Is the game paused?
     if (IsPaused())
@@ -1479,7 +1676,7 @@ BOOL GS_Demo::ShapesDemo()
     }
 
     // Set OpenGL clear color to black.
-    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    m_gsDisplay.GetState()->ClearColor(0.0f, 0.0f, 0.0f, 0.0f);
     // Clear screen and depth buffer.
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -1487,10 +1684,10 @@ BOOL GS_Demo::ShapesDemo()
     glLoadIdentity();
 
     // Disable texturing for this demo
-    glDisable(GL_TEXTURE_2D);
+    m_gsDisplay.GetState()->Disable(GL_TEXTURE_2D);
 
     // Enable depth testing so faces are drawn in correct order
-    glEnable(GL_DEPTH_TEST);
+    m_gsDisplay.GetState()->Enable(GL_DEPTH_TEST);
 
     // Move left 1.5 units and into the screen 6.0.
     glTranslatef(-1.5f, 0.0f, -6.0f);
@@ -1694,11 +1891,8 @@ BOOL GS_Demo::ShapesDemo()
 
     /////////////////////////////////////////////////////////////////////////////////////////////
 
-    glfRotTrianle += 0.8f; // Increase the rotation variable for the triangle.
-    glfRotQuad -= 0.75f;   // Decrease the rotation variable for the quad.
-
     // Swap buffers (double buffering) to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     return TRUE;
 }
@@ -1713,7 +1907,7 @@ BOOL GS_Demo::ShapesDemo()
 // Returns: TRUE if successfull and FALSE if not.
 //==============================================================================================
 
-BOOL GS_Demo::TextureDemo()
+BOOL GS_Demo::TextureDemo(float fAlpha)
 {
 
     // Make sure we have a valid display before drawing.
@@ -1730,7 +1924,7 @@ BOOL GS_Demo::TextureDemo()
     }
 
     // Set OpenGL clear color to black.
-    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    m_gsDisplay.GetState()->ClearColor(0.0f, 0.0f, 0.0f, 0.0f);
     // Clear screen and depth buffer.
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -1738,94 +1932,21 @@ BOOL GS_Demo::TextureDemo()
     glLoadIdentity();
 
     // Enable texturing for this demo
-    glEnable(GL_TEXTURE_2D);
+    m_gsDisplay.GetState()->Enable(GL_TEXTURE_2D);
 
     // Enable depth testing so faces are drawn in correct order
-    glEnable(GL_DEPTH_TEST);
+    m_gsDisplay.GetState()->Enable(GL_DEPTH_TEST);
 
     /////////////////////////////////////////////////////////////////////////////////////////////
     // New Code /////////////////////////////////////////////////////////////////////////////////
     ////////////////////////////////////////////////////////////////////////////////////////////
 
-    static GLfloat glfRotateX = 0.0f; // X rotation.
-    static GLfloat glfRotateY = 0.0f; // Y rotation.
-    static GLfloat glfRotateZ = 0.0f; // Z rotation.
-    static GLfloat glfRotSpeedX = 0;  // X rotation speed.
-    static GLfloat glfRotSpeedY = 0;  // Y rotation speed.
-    static GLfloat glfDepthZ = -5.0f; // How deep the cube is on the Z axis.
-
-    // Check to see wether a key or button was pressed.
-    int nKey = m_gsKeyboard.GetKeyPressed();
-    int nButton = m_gsController.GetButtonPressed();
-
-    if (nButton != -1)
-    {
-        nKey = nButton;
-    }
-
-    // Act depending on key pressed.
-    switch (nKey)
-    {
-    // Was the left cursor key pressed?
-    case GSK_LEFT:
-    case GSC_BUTTON_DPAD_LEFT:
-        if (glfRotSpeedY > -10.0f)
-        {
-            glfRotSpeedY -= 0.05f;
-        }
-        break;
-    // Was the right cursor key pressed?
-    case GSK_RIGHT:
-    case GSC_BUTTON_DPAD_RIGHT:
-        if (glfRotSpeedY < 10.0f)
-        {
-            glfRotSpeedY += 0.05f;
-        }
-        break;
-    // Was the up cursor key pressed?
-    case GSK_UP:
-    case GSC_BUTTON_DPAD_UP:
-        if (glfRotSpeedX > -10.0f)
-        {
-            glfRotSpeedX -= 0.05f;
-        }
-        break;
-    // Was the down cursor key pressed?
-    case GSK_DOWN:
-    case GSC_BUTTON_DPAD_DOWN:
-        if (glfRotSpeedX < 10.0f)
-        {
-            glfRotSpeedX += 0.05f;
-        }
-        break;
-    // Was the page down key pressed?
-    case GSK_PAGEDOWN:
-    case GSC_BUTTON_LEFTSHOULDER:
-        if (glfDepthZ > -100.0f)
-        {
-            glfDepthZ -= 0.05f;
-        }
-        break;
-    // Was the page up key pressed?
-    case GSK_PAGEUP:
-    case GSC_BUTTON_RIGHTSHOULDER:
-        if (glfDepthZ < 0.0f)
-        {
-            glfDepthZ += 0.05f;
-        }
-        break;
-    // Was the home key pressed?
-    case GSK_HOME:
-    case GSC_BUTTON_START:
-        // Reset all variables.
-        glfRotateX = 0.0f;
-        glfRotateY = 0.0f;
-        glfRotateZ = 0.0f;
-        glfRotSpeedY = 0;
-        glfRotSpeedX = 0;
-        glfDepthZ = -5.0f;
-        break;
-    }
+    // The cube is turned and moved by TextureUpdate(), draw it between where it was after the
+    // last two steps.
+    GLfloat glfRotateX = GS_Lerp(m_glfPrevCubeRotateX, m_glfCubeRotateX, fAlpha); // X rotation.
+    GLfloat glfRotateY = GS_Lerp(m_glfPrevCubeRotateY, m_glfCubeRotateY, fAlpha); // Y rotation.
+    GLfloat glfRotateZ = 0.0f;                                                    // Z rotation.
+    GLfloat glfDepthZ  = GS_Lerp(m_glfPrevCubeDepthZ, m_glfCubeDepthZ, fAlpha);   // Z depth.
 
     // Change the postion of the camera.
     glTranslatef(0.0f, 0.0f, glfDepthZ);
@@ -1849,7 +1970,7 @@ BOOL GS_Demo::TextureDemo()
     // a texture inside glBegin() and glEnd(), you have to do it before or after glBegin().
     // Notice how we use glBindTextures to specify which texture to create and to select a
     // specific texture.
-    glBindTexture(GL_TEXTURE_2D, m_gsTexture.GetID());
+    m_gsDisplay.GetState()->BindTexture(m_gsTexture.GetID());
 
     // To properly map a texture onto a quad, you have to make sure the top right of the texture
     // is mapped to the top right of the quad. The top left of the texture is mapped to the top
@@ -1962,20 +2083,13 @@ BOOL GS_Demo::TextureDemo()
 
     glEnd();
 
-    // Now we increase the value of glfRotateX, glfRotateY and glfRotateZ. Try changing the
-    // number each variable increases by to make the cube spin faster or slower, or try changing
-    // a + to a - to make the cube spin the other direction.
-    glfRotateX += glfRotSpeedX;
-    glfRotateY += glfRotSpeedY;
-    // glfRotateZ += 0.8f;
-
     // Undo the texture bind to prevent the texture from being used in other demonstartions.
-    glBindTexture(GL_TEXTURE_2D, 0);
+    m_gsDisplay.GetState()->BindTexture(0);
 
     /////////////////////////////////////////////////////////////////////////////////////////////
 
     // Swap buffers (double buffering) to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     return TRUE;
 }
@@ -1983,55 +2097,34 @@ BOOL GS_Demo::TextureDemo()
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 //==============================================================================================
-// GS_Demo::SpriteDemo():
+// GS_Demo::TextureUpdate():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Turns and moves the cube of the texture demo as the keys or buttons held down
+//          tell it to, one fixed step of fStepTime seconds at a time. The speeds and their
+//          changes are given per 1/60th of a second.
 // ---------------------------------------------------------------------------------------------
 // Returns: TRUE if successfull and FALSE if not.
 //==============================================================================================
 
-BOOL GS_Demo::SpriteDemo()
+BOOL GS_Demo::TextureUpdate(float fStepTime)
 {
 
-    // Make sure we have a valid display before drawing.
-    if (!m_gsDisplay.IsReady())
-    {
-        return FALSE;
-    }
+    // Scale the per 1/60th of a second speeds to the length of the step.
+    GLfloat glfStepScale = fStepTime * 60.0f;
 
-    // Is the game paused?
+    // Draw from where the cube is now.
+    m_glfPrevCubeRotateX = m_glfCubeRotateX;
+    m_glfPrevCubeRotateY = m_glfCubeRotateY;
+    m_glfPrevCubeDepthZ  = m_glfCubeDepthZ;
+
+    // Keep the cube where it is while the game is paused.
     if (IsPaused())
     {
-        glClearColor(1.0f, 0.0f, 0.0f, 0.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        glLoadIdentity();
-        m_gsDisplay.BeginRender2D(this->GetWindow());
-        m_gsBackgrnd.SetDestX((INTERNAL_RES_X - (long)m_gsBackgrnd.GetScaledWidth()) / 2);
-        m_gsBackgrnd.SetDestY((INTERNAL_RES_Y - (long)m_gsBackgrnd.GetScaledHeight()) / 2);
-        m_gsBackgrnd.RenderTiles(m_rcScreen);
-        m_gsSprite.SetDestX((INTERNAL_RES_X - (long)m_gsSprite.GetScaledWidth()) / 2);
-        m_gsSprite.SetDestY((INTERNAL_RES_Y - (long)m_gsSprite.GetScaledHeight()) / 2);
-        m_gsSprite.Render();
-        m_gsDisplay.EndRender2D();
-        SwapBuffers(this->GetDevice());
         return TRUE;
     }
 
-    // Set OpenGL clear color to blue.
-    glClearColor(0.0f, 0.0f, 1.0f, 0.0f);
-
-    // Clear screen and depth buffer.
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-    // Reset the current modelview matrix.
-    glLoadIdentity();
-
-    /////////////////////////////////////////////////////////////////////////////////////////////
-    // New Code /////////////////////////////////////////////////////////////////////////////////
-    ////////////////////////////////////////////////////////////////////////////////////////////
-
-    static GLfloat glfRotSpeed = 0.0f;     // Rotation speed.
-    static GLfloat glfTransparency = 1.0f; // Sprite transparency.
+    static GLfloat glfRotSpeedX = 0; // X rotation speed.
+    static GLfloat glfRotSpeedY = 0; // Y rotation speed.
 
     // Check to see wether a key or button was pressed.
     int nKey = m_gsKeyboard.GetKeyPressed();
@@ -2048,101 +2141,72 @@ BOOL GS_Demo::SpriteDemo()
     // Was the left cursor key pressed?
     case GSK_LEFT:
     case GSC_BUTTON_DPAD_LEFT:
-        if (glfRotSpeed < 10.0f)
+        if (glfRotSpeedY > -10.0f)
         {
-            glfRotSpeed += 0.1f;
+            glfRotSpeedY -= 0.05f * glfStepScale;
         }
         break;
     // Was the right cursor key pressed?
     case GSK_RIGHT:
     case GSC_BUTTON_DPAD_RIGHT:
-        if (glfRotSpeed > -10.0f)
+        if (glfRotSpeedY < 10.0f)
         {
-            glfRotSpeed -= 0.1f;
+            glfRotSpeedY += 0.05f * glfStepScale;
         }
         break;
     // Was the up cursor key pressed?
     case GSK_UP:
     case GSC_BUTTON_DPAD_UP:
-        m_gsSprite.AddScaleX(0.02f);
-        m_gsSprite.AddScaleY(0.02f);
-        m_gsBackgrnd.AddScaleX(0.02f);
-        m_gsBackgrnd.AddScaleY(0.02f);
+        if (glfRotSpeedX > -10.0f)
+        {
+            glfRotSpeedX -= 0.05f * glfStepScale;
+        }
         break;
     // Was the down cursor key pressed?
     case GSK_DOWN:
     case GSC_BUTTON_DPAD_DOWN:
-        m_gsSprite.AddScaleX(-0.02f);
-        m_gsSprite.AddScaleY(-0.02f);
-        if (m_gsBackgrnd.GetScaleX() > 0.2f)
+        if (glfRotSpeedX < 10.0f)
         {
-            m_gsBackgrnd.AddScaleX(-0.02f);
-            m_gsBackgrnd.AddScaleY(-0.02f);
+            glfRotSpeedX += 0.05f * glfStepScale;
         }
         break;
-    // Was the page up key pressed?
-    case GSK_PAGEUP:
+    // Was the page down key pressed?
+    case GSK_PAGEDOWN:
     case GSC_BUTTON_LEFTSHOULDER:
-        if (glfTransparency < 1.0f)
+        if (m_glfCubeDepthZ > -100.0f)
         {
-            glfTransparency += 0.05f;
+            m_glfCubeDepthZ -= 0.05f * glfStepScale;
         }
         break;
-    // Was the page down key pressed?
-    case GSK_PAGEDOWN:
+    // Was the page up key pressed?
+    case GSK_PAGEUP:
     case GSC_BUTTON_RIGHTSHOULDER:
-        if (glfTransparency > 0.0f)
+        if (m_glfCubeDepthZ < 0.0f)
         {
-            glfTransparency -= 0.05f;
+            m_glfCubeDepthZ += 0.05f * glfStepScale;
         }
         break;
     // Was the home key pressed?
     case GSK_HOME:
     case GSC_BUTTON_START:
         // Reset all variables.
-        m_gsSprite.SetScaleX(1.0f);
-        m_gsSprite.SetScaleY(1.0f);
-        m_gsSprite.SetRotateZ(0.0f);
-        m_gsBackgrnd.SetScaleX(1.0f);
-        m_gsBackgrnd.SetScaleY(1.0f);
-        glfRotSpeed = 0.0f;
-        glfTransparency = 1.0f;
+        m_glfCubeRotateX = 0.0f;
+        m_glfCubeRotateY = 0.0f;
+        glfRotSpeedY = 0;
+        glfRotSpeedX = 0;
+        m_glfCubeDepthZ = -5.0f;
+        // Don't draw the cube turning back.
+        m_glfPrevCubeRotateX = m_glfCubeRotateX;
+        m_glfPrevCubeRotateY = m_glfCubeRotateY;
+        m_glfPrevCubeDepthZ  = m_glfCubeDepthZ;
         break;
     }
 
-    // Setup the display for rendering in 2D.
-    m_gsDisplay.BeginRender2D(this->GetWindow());
-
-    // Set the modulate color of the background.
-    m_gsBackgrnd.SetModulateColor(-1.0f, -1.0f, -1.0f, glfTransparency);
-
-    // Scroll the background left and upwards.
-    m_gsBackgrnd.AddScrollX(-1.5f);
-    m_gsBackgrnd.AddScrollY(+0.5f);
-
-    // Draw the tile background image.
-    m_gsBackgrnd.RenderTiles(m_rcScreen);
-
-    // Set the modulate color of the sprite.
-    m_gsSprite.SetModulateColor(-1.0f, -1.0f, -1.0f, glfTransparency);
-
-    // Rotate the sprite on the Z-axis at the specified speed.
-    m_gsSprite.AddRotateZ(glfRotSpeed);
-
-    // Position the sprite centered on the screen.
-    m_gsSprite.SetDestX((INTERNAL_RES_X - (long)m_gsSprite.GetScaledWidth()) / 2);
-    m_gsSprite.SetDestY((INTERNAL_RES_Y - (long)m_gsSprite.GetScaledHeight()) / 2);
-
-    // Draw the sprite.
-    m_gsSprite.Render();
-
-    // Reset display after rendering in 2D.
-    m_gsDisplay.EndRender2D();
-
-    /////////////////////////////////////////////////////////////////////////////////////////////
-
-    // Swap buffers (double buffering) to display results.
-    SwapBuffers(this->GetDevice());
+    // Now we increase the rotation of the cube. Try changing the number each rotation
+    // increases by to make the cube spin faster or slower, or try changing a + to a - to make
+    // the cube spin the other direction.
+    m_glfCubeRotateX += glfRotSpeedX * glfStepScale;
+    m_glfCubeRotateY += glfRotSpeedY * glfStepScale;
 
     return TRUE;
 }
@@ -2150,14 +2214,14 @@ BOOL GS_Demo::SpriteDemo()
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 //==============================================================================================
-// GS_Demo::FontDemo():
+// GS_Demo::SpriteDemo():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
 // Returns: TRUE if successfull and FALSE if not.
 //==============================================================================================
 
-BOOL GS_Demo::FontDemo()
+BOOL GS_Demo::SpriteDemo(float fAlpha)
 {
 
     // Make sure we have a valid display before drawing.
@@ -2169,27 +2233,23 @@ BOOL GS_Demo::FontDemo()
     // Is the game paused?
     if (IsPaused())
     {
-        glClearColor(1.0f, 0.0f, 0.0f, 0.0f);
+        m_gsDisplay.GetState()->ClearColor(1.0f, 0.0f, 0.0f, 0.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         glLoadIdentity();
         m_gsDisplay.BeginRender2D(this->GetWindow());
-        m_gsBackgrnd.SetScrollXY(0.0f, 0.0f);
         m_gsBackgrnd.SetDestX((INTERNAL_RES_X - (long)m_gsBackgrnd.GetScaledWidth()) / 2);
         m_gsBackgrnd.SetDestY((INTERNAL_RES_Y - (long)m_gsBackgrnd.GetScaledHeight()) / 2);
         m_gsBackgrnd.RenderTiles(m_rcScreen);
-        m_gsSpriteEx.Render();
-        m_gsSmallFont.SetModulateColor(1.0f, 1.0f, 1.0f, 1.0f);
-        m_gsSmallFont.SetText("PAUSED");
-        m_gsSmallFont.SetDestXY((INTERNAL_RES_X - m_gsSmallFont.GetTextWidth()) / 2,
-                                (INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight()) / 2);
-        m_gsSmallFont.Render();
-        m_gsDisplay.EndRender2D();
-        SwapBuffers(this->GetDevice());
+        m_gsSprite.SetDestX((INTERNAL_RES_X - (long)m_gsSprite.GetScaledWidth()) / 2);
+        m_gsSprite.SetDestY((INTERNAL_RES_Y - (long)m_gsSprite.GetScaledHeight()) / 2);
+        m_gsSprite.Render();
+        m_gsDisplay.EndRender2D();
+        m_gsDisplay.EndRender(this->GetDevice());
         return TRUE;
     }
 
     // Set OpenGL clear color to blue.
-    glClearColor(0.0f, 0.0f, 1.0f, 0.0f);
+    m_gsDisplay.GetState()->ClearColor(0.0f, 0.0f, 1.0f, 0.0f);
 
     // Clear screen and depth buffer.
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -2197,18 +2257,68 @@ BOOL GS_Demo::FontDemo()
     // Reset the current modelview matrix.
     glLoadIdentity();
 
+    /////////////////////////////////////////////////////////////////////////////////////////////
+    // New Code /////////////////////////////////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////////////////////////////////////////////
+
     // Setup the display for rendering in 2D.
     m_gsDisplay.BeginRender2D(this->GetWindow());
 
+    // Set the modulate color of the background.
+    m_gsBackgrnd.SetModulateColor(-1.0f, -1.0f, -1.0f, m_glfSpriteTransparency);
+
+    // Draw the tile background image.
+    m_gsBackgrnd.RenderTiles(m_rcScreen);
+
+    // Set the modulate color of the sprite.
+    m_gsSprite.SetModulateColor(-1.0f, -1.0f, -1.0f, m_glfSpriteTransparency);
+
+    // The sprite is turned and scaled by SpriteUpdate(), draw it between its transforms of the
+    // last two steps.
+    m_gsSprite.SetInterpolation(fAlpha);
+
+    // Draw the sprite.
+    m_gsSprite.Render();
+
+    // Reset display after rendering in 2D.
+    m_gsDisplay.EndRender2D();
+
     /////////////////////////////////////////////////////////////////////////////////////////////
-    // New Code /////////////////////////////////////////////////////////////////////////////////
-    ////////////////////////////////////////////////////////////////////////////////////////////
 
-    static GLfloat glfRotSpeed = 0.0f;     // Rotation speed.
-    static GLfloat glfTransparency = 1.0f; // Sprite transparency.
+    // Swap buffers (double buffering) to display results.
+    m_gsDisplay.EndRender(this->GetDevice());
+
+    return TRUE;
+}
 
-    static BOOL bMoveRight = TRUE;
-    static BOOL bMoveUp = TRUE;
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// GS_Demo::SpriteUpdate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Turns and scales the sprite of the sprite demo as the keys or buttons held down
+//          tell it to and scrolls the background, one fixed step of fStepTime seconds at a
+//          time. The speeds and their changes are given per 1/60th of a second.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull and FALSE if not.
+//==============================================================================================
+
+BOOL GS_Demo::SpriteUpdate(float fStepTime)
+{
+
+    // Scale the per 1/60th of a second speeds to the length of the step.
+    GLfloat glfStepScale = fStepTime * 60.0f;
+
+    // Interpolate from where the sprite is now.
+    m_gsSprite.SaveTransform();
+
+    // Keep the sprite where it is while the game is paused.
+    if (IsPaused())
+    {
+        return TRUE;
+    }
+
+    static GLfloat glfRotSpeed = 0.0f; // Rotation speed.
 
     // Check to see wether a key or button was pressed.
     int nKey = m_gsKeyboard.GetKeyPressed();
@@ -2227,7 +2337,7 @@ BOOL GS_Demo::FontDemo()
     case GSC_BUTTON_DPAD_LEFT:
         if (glfRotSpeed < 10.0f)
         {
-            glfRotSpeed += 0.1f;
+            glfRotSpeed += 0.1f * glfStepScale;
         }
         break;
     // Was the right cursor key pressed?
@@ -2235,55 +2345,135 @@ BOOL GS_Demo::FontDemo()
     case GSC_BUTTON_DPAD_RIGHT:
         if (glfRotSpeed > -10.0f)
         {
-            glfRotSpeed -= 0.1f;
+            glfRotSpeed -= 0.1f * glfStepScale;
         }
         break;
     // Was the up cursor key pressed?
     case GSK_UP:
     case GSC_BUTTON_DPAD_UP:
-        m_gsSpriteEx.AddScaleX(0.05f);
-        m_gsSpriteEx.AddScaleY(0.05f);
+        m_gsSprite.AddScaleX(0.02f * glfStepScale);
+        m_gsSprite.AddScaleY(0.02f * glfStepScale);
+        m_gsBackgrnd.AddScaleX(0.02f * glfStepScale);
+        m_gsBackgrnd.AddScaleY(0.02f * glfStepScale);
         break;
     // Was the down cursor key pressed?
     case GSK_DOWN:
     case GSC_BUTTON_DPAD_DOWN:
-        m_gsSpriteEx.AddScaleX(-0.05f);
-        m_gsSpriteEx.AddScaleY(-0.05f);
+        m_gsSprite.AddScaleX(-0.02f * glfStepScale);
+        m_gsSprite.AddScaleY(-0.02f * glfStepScale);
+        if (m_gsBackgrnd.GetScaleX() > 0.2f)
+        {
+            m_gsBackgrnd.AddScaleX(-0.02f * glfStepScale);
+            m_gsBackgrnd.AddScaleY(-0.02f * glfStepScale);
+        }
         break;
     // Was the page up key pressed?
     case GSK_PAGEUP:
     case GSC_BUTTON_LEFTSHOULDER:
-        if (glfTransparency < 1.0f)
+        if (m_glfSpriteTransparency < 1.0f)
         {
-            glfTransparency += 0.05f;
+            m_glfSpriteTransparency += 0.05f * glfStepScale;
         }
         break;
     // Was the page down key pressed?
     case GSK_PAGEDOWN:
     case GSC_BUTTON_RIGHTSHOULDER:
-        if (glfTransparency > 0.0f)
+        if (m_glfSpriteTransparency > 0.0f)
         {
-            glfTransparency -= 0.05f;
+            m_glfSpriteTransparency -= 0.05f * glfStepScale;
         }
         break;
     // Was the home key pressed?
     case GSK_HOME:
     case GSC_BUTTON_START:
         // Reset all variables.
-        m_gsSpriteEx.SetScaleX(1.0f);
-        m_gsSpriteEx.SetScaleY(1.0f);
-        m_gsSpriteEx.SetRotateZ(0.0f);
+        m_gsSprite.SetScaleX(1.0f);
+        m_gsSprite.SetScaleY(1.0f);
+        m_gsSprite.SetRotateZ(0.0f);
+        m_gsBackgrnd.SetScaleX(1.0f);
+        m_gsBackgrnd.SetScaleY(1.0f);
         glfRotSpeed = 0.0f;
-        glfTransparency = 1.0f;
+        m_glfSpriteTransparency = 1.0f;
         break;
     }
 
+    // Scroll the background left and upwards.
+    m_gsBackgrnd.AddScrollX(-1.5f * glfStepScale);
+    m_gsBackgrnd.AddScrollY(+0.5f * glfStepScale);
+
+    // Rotate the sprite on the Z-axis at the specified speed.
+    m_gsSprite.AddRotateZ(glfRotSpeed * glfStepScale);
+
+    // Position the sprite centered on the screen.
+    m_gsSprite.SetDestX((INTERNAL_RES_X - (long)m_gsSprite.GetScaledWidth()) / 2);
+    m_gsSprite.SetDestY((INTERNAL_RES_Y - (long)m_gsSprite.GetScaledHeight()) / 2);
+
+    return TRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// GS_Demo::FontDemo():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull and FALSE if not.
+//==============================================================================================
+
+BOOL GS_Demo::FontDemo(float fAlpha)
+{
+
+    // Make sure we have a valid display before drawing.
+    if (!m_gsDisplay.IsReady())
+    {
+        return FALSE;
+    }
+
+    // Is the game paused?
+    if (IsPaused())
+    {
+        m_gsDisplay.GetState()->ClearColor(1.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        glLoadIdentity();
+        m_gsDisplay.BeginRender2D(this->GetWindow());
+        m_gsBackgrnd.SetScrollXY(0.0f, 0.0f);
+        m_gsBackgrnd.SetDestX((INTERNAL_RES_X - (long)m_gsBackgrnd.GetScaledWidth()) / 2);
+        m_gsBackgrnd.SetDestY((INTERNAL_RES_Y - (long)m_gsBackgrnd.GetScaledHeight()) / 2);
+        m_gsBackgrnd.RenderTiles(m_rcScreen);
+        m_gsSpriteEx.Render();
+        m_gsSmallFont.SetModulateColor(1.0f, 1.0f, 1.0f, 1.0f);
+        m_gsSmallFont.SetText("PAUSED");
+        m_gsSmallFont.SetDestXY((INTERNAL_RES_X - m_gsSmallFont.GetTextWidth()) / 2,
+                                (INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight()) / 2);
+        m_gsSmallFont.Render();
+        m_gsDisplay.EndRender2D();
+        m_gsDisplay.EndRender(this->GetDevice());
+        return TRUE;
+    }
+
+    // Set OpenGL clear color to blue.
+    m_gsDisplay.GetState()->ClearColor(0.0f, 0.0f, 1.0f, 0.0f);
+
+    // Clear screen and depth buffer.
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    // Reset the current modelview matrix.
+    glLoadIdentity();
+
+    // Setup the display for rendering in 2D.
+    m_gsDisplay.BeginRender2D(this->GetWindow());
+
+    /////////////////////////////////////////////////////////////////////////////////////////////
+    // New Code /////////////////////////////////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////////////////////////////////////////////
+
     // Reset the background scrolling and scaling.
     m_gsBackgrnd.SetScrollXY(0.0f, 0.0f);
     m_gsBackgrnd.SetScaleXY(1.0f, 1.0f);
 
     // Set the modulate color of the background.
-    m_gsBackgrnd.SetModulateColor(-1.0f, -1.0f, -1.0f, glfTransparency);
+    m_gsBackgrnd.SetModulateColor(-1.0f, -1.0f, -1.0f, m_glfFontTransparency);
 
     // Draw the tile background image.
     m_gsBackgrnd.RenderTiles(m_rcScreen);
@@ -2291,29 +2481,169 @@ BOOL GS_Demo::FontDemo()
     /////////////////////////////////////////////////////////////////////////////////////////////
 
     // Set the modulate color of the sprite.
-    m_gsSpriteEx.SetModulateColor(-1.0f, -1.0f, -1.0f, glfTransparency);
+    m_gsSpriteEx.SetModulateColor(-1.0f, -1.0f, -1.0f, m_glfFontTransparency);
+
+    // The sprite is moved by FontUpdate(), draw it between where it was after the last two
+    // steps.
+    m_gsSpriteEx.SetInterpolation(fAlpha);
+
+    // Render the sprite.
+    m_gsSpriteEx.Render();
+
+    /////////////////////////////////////////////////////////////////////////////////////////////
+
+    // Display the frames per second at the top left corner.
+    m_gsSmallFont.SetText("%0.2f", this->GetCurrentFrameRate());
+    m_gsSmallFont.SetDestXY(16, INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight() - 16);
+    m_gsSmallFont.Render();
+
+    // Display the frame profile below the frames per second if it is shown.
+    if (m_bIsProfileShown)
+    {
+        this->GetProfiler()->RenderOverlay(&m_gsSmallFont, 16,
+                                           INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight() - 24);
+    }
+
+    // Display the title of the demo centered at the bottom.
+    m_gsLargeFont.SetModulateColor(-1.0f, -1.0f, -1.0f, m_glfFontTransparency);
+    m_gsLargeFont.SetText("FONTS");
+    m_gsLargeFont.SetDestXY((INTERNAL_RES_X - m_gsLargeFont.GetTextWidth()) / 2, 16);
+    m_gsLargeFont.Render();
+
+    /////////////////////////////////////////////////////////////////////////////////////////////
+
+    // Reset display after rendering in 2D.
+    m_gsDisplay.EndRender2D();
+
+    // Swap buffers (double buffering) to display results.
+    m_gsDisplay.EndRender(this->GetDevice());
+
+    return TRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// GS_Demo::FontUpdate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Moves, turns, scales and animates the sprite of the font demo, bouncing it off the
+//          edges of the screen, one fixed step of fStepTime seconds at a time. The speeds and
+//          their changes are given per 1/60th of a second.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull and FALSE if not.
+//==============================================================================================
+
+BOOL GS_Demo::FontUpdate(float fStepTime)
+{
+
+    // Scale the per 1/60th of a second speeds to the length of the step.
+    GLfloat glfStepScale = fStepTime * 60.0f;
+
+    // Interpolate from where the sprite is now.
+    m_gsSpriteEx.SaveTransform();
+
+    // Keep the sprite where it is while the game is paused.
+    if (IsPaused())
+    {
+        return TRUE;
+    }
+
+    static GLfloat glfRotSpeed = 0.0f; // Rotation speed.
+
+    static BOOL bMoveRight = TRUE;
+    static BOOL bMoveUp = TRUE;
+
+    // Check to see wether a key or button was pressed.
+    int nKey = m_gsKeyboard.GetKeyPressed();
+    int nButton = m_gsController.GetButtonPressed();
+
+    if (nButton != -1)
+    {
+        nKey = nButton;
+    }
+
+    // Act depending on key pressed.
+    switch (nKey)
+    {
+    // Was the left cursor key pressed?
+    case GSK_LEFT:
+    case GSC_BUTTON_DPAD_LEFT:
+        if (glfRotSpeed < 10.0f)
+        {
+            glfRotSpeed += 0.1f * glfStepScale;
+        }
+        break;
+    // Was the right cursor key pressed?
+    case GSK_RIGHT:
+    case GSC_BUTTON_DPAD_RIGHT:
+        if (glfRotSpeed > -10.0f)
+        {
+            glfRotSpeed -= 0.1f * glfStepScale;
+        }
+        break;
+    // Was the up cursor key pressed?
+    case GSK_UP:
+    case GSC_BUTTON_DPAD_UP:
+        m_gsSpriteEx.AddScaleX(0.05f * glfStepScale);
+        m_gsSpriteEx.AddScaleY(0.05f * glfStepScale);
+        break;
+    // Was the down cursor key pressed?
+    case GSK_DOWN:
+    case GSC_BUTTON_DPAD_DOWN:
+        m_gsSpriteEx.AddScaleX(-0.05f * glfStepScale);
+        m_gsSpriteEx.AddScaleY(-0.05f * glfStepScale);
+        break;
+    // Was the page up key pressed?
+    case GSK_PAGEUP:
+    case GSC_BUTTON_LEFTSHOULDER:
+        if (m_glfFontTransparency < 1.0f)
+        {
+            m_glfFontTransparency += 0.05f * glfStepScale;
+        }
+        break;
+    // Was the page down key pressed?
+    case GSK_PAGEDOWN:
+    case GSC_BUTTON_RIGHTSHOULDER:
+        if (m_glfFontTransparency > 0.0f)
+        {
+            m_glfFontTransparency -= 0.05f * glfStepScale;
+        }
+        break;
+    // Was the home key pressed?
+    case GSK_HOME:
+    case GSC_BUTTON_START:
+        // Reset all variables.
+        m_gsSpriteEx.SetScaleX(1.0f);
+        m_gsSpriteEx.SetScaleY(1.0f);
+        m_gsSpriteEx.SetRotateZ(0.0f);
+        glfRotSpeed = 0.0f;
+        m_glfFontTransparency = 1.0f;
+        break;
+    }
 
     // Rotate the sprite on the Z-axis at the specified speed.
-    m_gsSpriteEx.AddRotateZ(glfRotSpeed);
+    m_gsSpriteEx.AddRotateZ(glfRotSpeed * glfStepScale);
+
+    GLint gliVelocity = (GLint) (2.0f * glfStepScale + 0.5f);
 
     // Determine the left/right movement.
     if (bMoveRight)
     {
-        m_gsSpriteEx.AddDestX(2);
+        m_gsSpriteEx.AddDestX(gliVelocity);
     }
     if (!bMoveRight)
     {
-        m_gsSpriteEx.AddDestX(-2);
+        m_gsSpriteEx.AddDestX(-gliVelocity);
     }
 
     // Determine the up/down movement.
     if (bMoveUp)
     {
-        m_gsSpriteEx.AddDestY(2);
+        m_gsSpriteEx.AddDestY(gliVelocity);
     }
     if (!bMoveUp)
     {
-        m_gsSpriteEx.AddDestY(-2);
+        m_gsSpriteEx.AddDestY(-gliVelocity);
     }
 
     RECT rcDest;
@@ -2347,11 +2677,92 @@ BOOL GS_Demo::FontDemo()
         m_gsSound.PlaySample(SAMPLE_IMPACT);
     }
 
-    // Render the sprite.
-    m_gsSpriteEx.Render();
+    // Go to the next frame.
+    m_gsSpriteEx.AddFrame(1);
+
+    return TRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// GS_Demo::CollisionDemo():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull and FALSE if not.
+//==============================================================================================
+
+BOOL GS_Demo::CollisionDemo(float fAlpha)
+{
+
+    // Make sure we have a valid display before drawing.
+    if (!m_gsDisplay.IsReady())
+    {
+        return FALSE;
+    }
+
+    // Is the game paused?
+    if (IsPaused())
+    {
+        m_gsDisplay.GetState()->ClearColor(1.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        glLoadIdentity();
+        m_gsDisplay.BeginRender2D(this->GetWindow());
+        m_gsBackgrnd.SetScrollXY(0.0f, 0.0f);
+        m_gsBackgrnd.SetDestX((INTERNAL_RES_X - (long)m_gsBackgrnd.GetScaledWidth()) / 2);
+        m_gsBackgrnd.SetDestY((INTERNAL_RES_Y - (long)m_gsBackgrnd.GetScaledHeight()) / 2);
+        m_gsBackgrnd.RenderTiles(m_rcScreen);
+        for (int nLoop = 0; nLoop < MAXIMUM_SPRITES; nLoop++)
+        {
+            m_gsSprites[nLoop].Render();
+        }
+        m_gsSmallFont.SetModulateColor(1.0f, 1.0f, 1.0f, 1.0f);
+        m_gsSmallFont.SetText("PAUSED");
+        m_gsSmallFont.SetDestXY((INTERNAL_RES_X - m_gsSmallFont.GetTextWidth()) / 2,
+                                (INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight()) / 2);
+        m_gsSmallFont.Render();
+        m_gsDisplay.EndRender2D();
+        m_gsDisplay.EndRender(this->GetDevice());
+        return TRUE;
+    }
+
+    // Set OpenGL clear color to blue.
+    m_gsDisplay.GetState()->ClearColor(0.0f, 0.0f, 1.0f, 0.0f);
+
+    // Clear screen and depth buffer.
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    // Reset the current modelview matrix.
+    glLoadIdentity();
+
+    // Setup the display for rendering in 2D.
+    m_gsDisplay.BeginRender2D(this->GetWindow());
+
+    /////////////////////////////////////////////////////////////////////////////////////////////
+
+    // Set the modulate color of the background.
+    m_gsBackgrnd.SetModulateColor(-1.0f, -1.0f, -1.0f, m_glfCollisionTransparency);
+
+    // Draw the tile background image.
+    m_gsBackgrnd.RenderTiles(m_rcScreen);
+
+    /////////////////////////////////////////////////////////////////////////////////////////////
+
+    /////////////////////////////////////////////////////////////////////////////////////////////
+    // New Code. ////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////
+
+    // The sprites are moved by CollisionUpdate(), draw them between the last two steps so they
+    // move smoothly whatever the frame rate.
+    for (int nLoop = 0; nLoop < MAXIMUM_SPRITES; nLoop++)
+    {
+        m_gsSprites[nLoop].SetModulateColor(-1.0f, -1.0f, -1.0f, m_glfCollisionTransparency);
+        m_gsSprites[nLoop].SetInterpolation(fAlpha);
 
-    // Go to the next frame.
-    m_gsSpriteEx.AddFrame(1);
+        // Render the sprite to the back surface.
+        m_gsSprites[nLoop].Render();
+    }
 
     /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -2360,9 +2771,16 @@ BOOL GS_Demo::FontDemo()
     m_gsSmallFont.SetDestXY(16, INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight() - 16);
     m_gsSmallFont.Render();
 
+    // Display the frame profile below the frames per second if it is shown.
+    if (m_bIsProfileShown)
+    {
+        this->GetProfiler()->RenderOverlay(&m_gsSmallFont, 16,
+                                           INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight() - 24);
+    }
+
     // Display the title of the demo centered at the bottom.
-    m_gsLargeFont.SetModulateColor(-1.0f, -1.0f, -1.0f, glfTransparency);
-    m_gsLargeFont.SetText("FONTS");
+    m_gsLargeFont.SetModulateColor(-1.0f, -1.0f, -1.0f, m_glfCollisionTransparency);
+    m_gsLargeFont.SetText("COLLISION");
     m_gsLargeFont.SetDestXY((INTERNAL_RES_X - m_gsLargeFont.GetTextWidth()) / 2, 16);
     m_gsLargeFont.Render();
 
@@ -2372,7 +2790,7 @@ BOOL GS_Demo::FontDemo()
     m_gsDisplay.EndRender2D();
 
     // Swap buffers (double buffering) to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     return TRUE;
 }
@@ -2380,63 +2798,34 @@ BOOL GS_Demo::FontDemo()
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 //==============================================================================================
-// GS_Demo::CollisionDemo():
+// GS_Demo::CollisionUpdate():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Moves, rotates and animates the sprites of the collision demo and bounces them off
+//          each other and the edges of the screen, one fixed step of fStepTime seconds at a
+//          time. Velocities and rotations are given per 1/60th of a second.
 // ---------------------------------------------------------------------------------------------
 // Returns: TRUE if successfull and FALSE if not.
 //==============================================================================================
 
-BOOL GS_Demo::CollisionDemo()
+BOOL GS_Demo::CollisionUpdate(float fStepTime)
 {
 
-    // Make sure we have a valid display before drawing.
-    if (!m_gsDisplay.IsReady())
+    // Scale the per 1/60th of a second velocities to the length of the step.
+    GLfloat glfStepScale = fStepTime * 60.0f;
+
+    // For all the sprites.
+    for (int nLoop = 0; nLoop < MAXIMUM_SPRITES; nLoop++)
     {
-        return FALSE;
+        // Interpolate from where the sprite is now.
+        m_gsSprites[nLoop].SaveTransform();
     }
 
-    // Is the game paused?
+    // Keep the sprites where they are while the game is paused.
     if (IsPaused())
     {
-        glClearColor(1.0f, 0.0f, 0.0f, 0.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        glLoadIdentity();
-        m_gsDisplay.BeginRender2D(this->GetWindow());
-        m_gsBackgrnd.SetScrollXY(0.0f, 0.0f);
-        m_gsBackgrnd.SetDestX((INTERNAL_RES_X - (long)m_gsBackgrnd.GetScaledWidth()) / 2);
-        m_gsBackgrnd.SetDestY((INTERNAL_RES_Y - (long)m_gsBackgrnd.GetScaledHeight()) / 2);
-        m_gsBackgrnd.RenderTiles(m_rcScreen);
-        for (int nLoop = 0; nLoop < MAXIMUM_SPRITES; nLoop++)
-        {
-            m_gsSprites[nLoop].Render();
-        }
-        m_gsSmallFont.SetModulateColor(1.0f, 1.0f, 1.0f, 1.0f);
-        m_gsSmallFont.SetText("PAUSED");
-        m_gsSmallFont.SetDestXY((INTERNAL_RES_X - m_gsSmallFont.GetTextWidth()) / 2,
-                                (INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight()) / 2);
-        m_gsSmallFont.Render();
-        m_gsDisplay.EndRender2D();
-        SwapBuffers(this->GetDevice());
         return TRUE;
     }
 
-    // Set OpenGL clear color to blue.
-    glClearColor(0.0f, 0.0f, 1.0f, 0.0f);
-
-    // Clear screen and depth buffer.
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-    // Reset the current modelview matrix.
-    glLoadIdentity();
-
-    // Setup the display for rendering in 2D.
-    m_gsDisplay.BeginRender2D(this->GetWindow());
-
-    /////////////////////////////////////////////////////////////////////////////////////////////
-
-    static GLfloat glfTransparency = 1.0f; // Sprite transparency.
-
     // Check to see wether a key or button was pressed.
     int nKey = m_gsKeyboard.GetKeyPressed();
     int nButton = m_gsController.GetButtonPressed();
@@ -2451,101 +2840,62 @@ BOOL GS_Demo::CollisionDemo()
     {
     // Was the page up key pressed?
     case GSK_PAGEUP:
-        if (glfTransparency < 1.0f)
+        if (m_glfCollisionTransparency < 1.0f)
         {
-            glfTransparency += 0.05f;
+            m_glfCollisionTransparency += 0.05f * glfStepScale;
         }
         break;
     // Was the page down key pressed?
     case GSK_PAGEDOWN:
-        if (glfTransparency > 0.0f)
+        if (m_glfCollisionTransparency > 0.0f)
         {
-            glfTransparency -= 0.05f;
+            m_glfCollisionTransparency -= 0.05f * glfStepScale;
         }
         break;
     // Was the home key pressed?
     case GSK_HOME:
         // Reset all variables.
-        glfTransparency = 1.0f;
+        m_glfCollisionTransparency = 1.0f;
         break;
     }
 
-    // Set the modulate color of the background.
-    m_gsBackgrnd.SetModulateColor(-1.0f, -1.0f, -1.0f, glfTransparency);
-
-    // Draw the tile background image.
-    m_gsBackgrnd.RenderTiles(m_rcScreen);
-
-    /////////////////////////////////////////////////////////////////////////////////////////////
-
-    /////////////////////////////////////////////////////////////////////////////////////////////
-    // New Code. ////////////////////////////////////////////////////////////////////////////////
-    /////////////////////////////////////////////////////////////////////////////////////////////
+    static BOOL bHasCollided = FALSE;
 
     // For all the sprites.
     for (int nLoop = 0; nLoop < MAXIMUM_SPRITES; nLoop++)
     {
 
-        static int nFrameCount[MAXIMUM_SPRITES] = {0};
-        static BOOL bHasCollided = FALSE;
+        static int nStepCount[MAXIMUM_SPRITES] = {0};
 
-        nFrameCount[nLoop]++;
+        nStepCount[nLoop]++;
 
-        // Reset the modulate color of the sprite after 15 frames.
-        if (nFrameCount[nLoop] >= 15)
+        // Reset the modulate color of the sprite after 15 steps.
+        if (nStepCount[nLoop] >= 15)
         {
-            m_gsSprites[nLoop].SetModulateColor(1.0f, 1.0f, 1.0f, glfTransparency);
-            nFrameCount[nLoop] = 0;
+            m_gsSprites[nLoop].SetModulateColor(1.0f, 1.0f, 1.0f);
+            nStepCount[nLoop] = 0;
             bHasCollided = FALSE;
         }
 
         // Increase the rotation factor to rotate the sprite.
-        m_gsSprites[nLoop].AddRotateZ(m_fRotation[nLoop]);
+        m_gsSprites[nLoop].AddRotateZ(m_fRotation[nLoop] * glfStepScale);
 
         // Reset the rotation factor once the sprite has been rotated all the way around.
         if (m_gsSprites[nLoop].GetRotateZ() >= 360.0f)
         {
-            m_gsSprites[nLoop].SetRotateZ(m_fRotation[nLoop]);
+            m_gsSprites[nLoop].SetRotateZ(m_gsSprites[nLoop].GetRotateZ() - 360.0f);
         }
 
-        // Check for collisions.
-        RECT rcSource, rcDest;
-
-        // Determine the screen coordinates of the source sprite.
-        m_gsSprites[nLoop].GetDestRect(&rcSource);
-
-        // Test sprite against all other sprites.
-        for (int cLoop = 0; cLoop < MAXIMUM_SPRITES; cLoop++)
-        {
-            // If the sprite is any sprite except the current one.
-            if (cLoop != nLoop)
-            {
-                // Determine the screen coordinates of the destination sprite.
-                m_gsSprites[cLoop].GetDestRect(&rcDest);
-                // If a collision has occured with one of the other sprites.
-                if ((m_gsCollide.IsRectOnRect(rcSource, rcDest, 60)) && (!bHasCollided))
-                {
-                    // Set flag to indicate a collision has taken place.
-                    bHasCollided = TRUE;
-                    // Change colliding sprites directions to opposites.
-                    m_bMoveRight[nLoop] = !m_bMoveRight[nLoop];
-                    m_bMoveDown[nLoop] = !m_bMoveDown[nLoop];
-                    m_bMoveRight[cLoop] = !m_bMoveRight[nLoop];
-                    m_bMoveDown[cLoop] = !m_bMoveDown[nLoop];
-                    // Play appropriate sound.
-                    m_gsSound.PlaySample(SAMPLE_COLLIDE);
-                    // Set sprite modulate color to show impact.
-                    m_gsSprites[nLoop].SetModulateColor(1.0f, 0.5f, 0.5f, glfTransparency);
-                }
-            }
-        }
+        // Pan the sounds of the sprite to where it is on the screen.
+        int nPanning = m_gsSprites[nLoop].GetDestX() + m_gsSprites[nLoop].GetFrameWidth() / 2;
+        nPanning = (nPanning < 0) ? 0 : (nPanning * 255 / INTERNAL_RES_X);
 
         // Start decrementing the X position once at far-side of screen.
         if (m_gsSprites[nLoop].GetDestX() >= (INTERNAL_RES_X - m_gsSprites[nLoop].GetFrameWidth()))
         {
             m_bMoveRight[nLoop] = FALSE;
             // Play appropriate sound.
-            m_gsSound.PlaySample(SAMPLE_IMPACT, 100);
+            m_gsSound.PlaySample(SAMPLE_IMPACT, 100, nPanning);
         }
 
         // Start incrementing the X position once at near-side of screen.
@@ -2553,17 +2903,19 @@ BOOL GS_Demo::CollisionDemo()
         {
             m_bMoveRight[nLoop] = TRUE;
             // Play appropriate sound.
-            m_gsSound.PlaySample(SAMPLE_IMPACT, 100);
+            m_gsSound.PlaySample(SAMPLE_IMPACT, 100, nPanning);
         }
 
+        GLint gliVelocity = (GLint) (m_fVelocity[nLoop] * glfStepScale + 0.5f);
+
         // Increment/decrement sprite X position.
         if (m_bMoveRight[nLoop])
         {
-            m_gsSprites[nLoop].AddDestX(m_fVelocity[nLoop]);
+            m_gsSprites[nLoop].AddDestX(gliVelocity);
         }
         else
         {
-            m_gsSprites[nLoop].AddDestX(-m_fVelocity[nLoop]);
+            m_gsSprites[nLoop].AddDestX(-gliVelocity);
         }
 
         // Start decrementing the Y position once at bottom of screen.
@@ -2571,7 +2923,7 @@ BOOL GS_Demo::CollisionDemo()
         {
             m_bMoveDown[nLoop] = FALSE;
             // Play appropriate sound.
-            m_gsSound.PlaySample(SAMPLE_IMPACT, 100);
+            m_gsSound.PlaySample(SAMPLE_IMPACT, 100, nPanning);
         }
 
         // Start incrementing the Y position once at top of screen.
@@ -2579,46 +2931,47 @@ BOOL GS_Demo::CollisionDemo()
         {
             m_bMoveDown[nLoop] = TRUE;
             // Play appropriate sound.
-            m_gsSound.PlaySample(SAMPLE_IMPACT, 100);
+            m_gsSound.PlaySample(SAMPLE_IMPACT, 100, nPanning);
         }
 
         // Increment/decrement sprite Y position.
         if (m_bMoveDown[nLoop])
         {
-            m_gsSprites[nLoop].AddDestY(m_fVelocity[nLoop]);
+            m_gsSprites[nLoop].AddDestY(gliVelocity);
         }
         else
         {
-            m_gsSprites[nLoop].AddDestY(-m_fVelocity[nLoop]);
+            m_gsSprites[nLoop].AddDestY(-gliVelocity);
         }
 
-        // Render the sprite to the back surface.
-        m_gsSprites[nLoop].Render();
-
         // Move to the next sprite frame.
         m_gsSprites[nLoop].AddFrame(1);
-    }
-
-    /////////////////////////////////////////////////////////////////////////////////////////////
-
-    // Display the frames per second at the top left corner.
-    m_gsSmallFont.SetText("%0.2f", this->GetCurrentFrameRate());
-    m_gsSmallFont.SetDestXY(16, INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight() - 16);
-    m_gsSmallFont.Render();
-
-    // Display the title of the demo centered at the bottom.
-    m_gsLargeFont.SetModulateColor(-1.0f, -1.0f, -1.0f, glfTransparency);
-    m_gsLargeFont.SetText("COLLISION");
-    m_gsLargeFont.SetDestXY((INTERNAL_RES_X - m_gsLargeFont.GetTextWidth()) / 2, 16);
-    m_gsLargeFont.Render();
 
-    /////////////////////////////////////////////////////////////////////////////////////////////
+        // Update the sprite's body in the collision world.
+        RECT rcSprite;
+        m_gsSprites[nLoop].GetDestRect(&rcSprite);
+        m_gsCollisionWorld.MoveBody(m_nSpriteBody[nLoop], rcSprite);
+    }
 
-    // Reset display after rendering in 2D.
-    m_gsDisplay.EndRender2D();
+    GS_CollisionPair gsPair;
 
-    // Swap buffers (double buffering) to display results.
-    SwapBuffers(this->GetDevice());
+    // Only one collision is shown at a time, so the first colliding pair of sprites will do.
+    if ((!bHasCollided) && (m_gsCollisionWorld.FindPairs(&gsPair, 1) > 0))
+    {
+        int nSource = (int) (intptr_t) m_gsCollisionWorld.GetUserData(gsPair.nBodyA);
+        int nDest   = (int) (intptr_t) m_gsCollisionWorld.GetUserData(gsPair.nBodyB);
+        // Set flag to indicate a collision has taken place.
+        bHasCollided = TRUE;
+        // Change colliding sprites directions to opposites.
+        m_bMoveRight[nSource] = !m_bMoveRight[nSource];
+        m_bMoveDown[nSource] = !m_bMoveDown[nSource];
+        m_bMoveRight[nDest] = !m_bMoveRight[nSource];
+        m_bMoveDown[nDest] = !m_bMoveDown[nSource];
+        // Play appropriate sound.
+        m_gsSound.PlaySample(SAMPLE_COLLIDE);
+        // Set sprite modulate color to show impact.
+        m_gsSprites[nSource].SetModulateColor(1.0f, 0.5f, 0.5f);
+    }
 
     return TRUE;
 }
@@ -2633,7 +2986,7 @@ BOOL GS_Demo::CollisionDemo()
 // Returns: TRUE if successfull and FALSE if not.
 //==============================================================================================
 
-BOOL GS_Demo::MenuDemo()
+BOOL GS_Demo::MenuDemo(float fAlpha)
 {
 
     // Make sure we have a valid display before drawing.
@@ -2645,7 +2998,7 @@ BOOL GS_Demo::MenuDemo()
     // Is the game paused?
     if (IsPaused())
     {
-        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        m_gsDisplay.GetState()->ClearColor(0.0f, 0.0f, 0.0f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         glLoadIdentity();
         m_gsDisplay.BeginRender2D(this->GetWindow());
@@ -2655,12 +3008,17 @@ BOOL GS_Demo::MenuDemo()
                                 (INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight()) / 2);
         m_gsSmallFont.Render();
         m_gsDisplay.EndRender2D();
-        SwapBuffers(this->GetDevice());
+        m_gsDisplay.EndRender(this->GetDevice());
         return TRUE;
     }
 
+    // The ground and clouds are scrolled by MenuUpdate(), draw them between where they were
+    // the last two steps so they scroll smoothly whatever the frame rate.
+    GLfloat glfRollClds = GS_Lerp(m_glfPrevRollClds, m_glfRollClds, fAlpha);
+    GLfloat glfRollGrnd = GS_Lerp(m_glfPrevRollGrnd, m_glfRollGrnd, fAlpha);
+
     // Set OpenGL clear color to dark red.
-    glClearColor(0.4f, 0.0f, 0.0f, 1.0f);
+    m_gsDisplay.GetState()->ClearColor(0.4f, 0.0f, 0.0f, 1.0f);
 
     // Clear screen and depth buffer.
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -2672,12 +3030,8 @@ BOOL GS_Demo::MenuDemo()
     // New Code /////////////////////////////////////////////////////////////////////////////////
     /////////////////////////////////////////////////////////////////////////////////////////////
 
-    static GLfloat glfRollGrnd = 0.0f;
-    static GLfloat glfRollClds = 0.0f;
-    static GLfloat glfRollSpeed = 0.001f;
-
     // Create two layers of scrolling clouds in the top half of the screen.
-    glBindTexture(GL_TEXTURE_2D, m_gsCloudsTexture.GetID());
+    m_gsDisplay.GetState()->BindTexture(m_gsCloudsTexture.GetID());
     glBegin(GL_QUADS);
     glNormal3f(0.0f, 0.0f, 1.0f);
     glTexCoord2f(1.0f, 1.0f + glfRollClds / 0.5f);
@@ -2699,20 +3053,8 @@ BOOL GS_Demo::MenuDemo()
     glVertex3f(28.0f, -3.0f, -50.0f); // Bottom right.
     glEnd();
 
-    glfRollClds -= glfRollSpeed;
-
-    // Reset texture once entire length has been scrolled.
-    if (glfRollClds < -1.0f + glfRollSpeed)
-    {
-        glfRollClds = 0.0f;
-    }
-    else if (glfRollClds >= 1.0f)
-    {
-        glfRollClds = 0.0f;
-    }
-
     // Create a scrolling landscape in the bottom half of the screen.
-    glBindTexture(GL_TEXTURE_2D, m_gsGroundTexture.GetID());
+    m_gsDisplay.GetState()->BindTexture(m_gsGroundTexture.GetID());
     glBegin(GL_QUADS);
     glNormal3f(0.0f, 0.0f, 1.0f);
     glTexCoord2f(7.0f, 4.0f - glfRollGrnd);
@@ -2724,19 +3066,7 @@ BOOL GS_Demo::MenuDemo()
     glTexCoord2f(7.0f, 0.0f - glfRollGrnd);
     glVertex3f(28.0f, -3.0f, 0.0f); // Bottom right.
     glEnd();
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    glfRollGrnd -= (glfRollSpeed * 10);
-
-    // Reset texture once entire length has been scrolled.
-    if (glfRollGrnd < -4.0f + glfRollSpeed)
-    {
-        glfRollGrnd = 0.0f;
-    }
-    else if (glfRollGrnd >= 4.0f)
-    {
-        glfRollGrnd = 0.0f;
-    }
+    m_gsDisplay.GetState()->BindTexture(0);
 
     /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -2744,8 +3074,6 @@ BOOL GS_Demo::MenuDemo()
     // New Code: Menu Rendering /////////////////////////////////////////////////////////////////
     /////////////////////////////////////////////////////////////////////////////////////////////
 
-    static GLfloat glfTransparency = 1.0f;
-
     // Setup the display for rendering in 2D.
     m_gsDisplay.BeginRender2D(this->GetWindow());
 
@@ -2753,11 +3081,104 @@ BOOL GS_Demo::MenuDemo()
     m_gsMenu.SetDestX((INTERNAL_RES_X - m_gsMenu.GetWidth()) / 2);
     m_gsMenu.SetDestY((INTERNAL_RES_Y - m_gsMenu.GetHeight()) / 2);
 
-    m_gsMenu.SetModulateColor(-1.0f, -1.0f, -1.0f, glfTransparency);
+    m_gsMenu.SetModulateColor(-1.0f, -1.0f, -1.0f, m_glfMenuTransparency);
 
     // Render the menu to the back surface.
     m_gsMenu.Render();
 
+    /////////////////////////////////////////////////////////////////////////////////////////////
+
+    // Display the frames per second at the top left corner.
+    m_gsSmallFont.SetText("%0.2f", this->GetCurrentFrameRate());
+    m_gsSmallFont.SetDestXY(16, INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight() - 16);
+    m_gsSmallFont.Render();
+
+    // Display the frame profile below the frames per second if it is shown.
+    if (m_bIsProfileShown)
+    {
+        this->GetProfiler()->RenderOverlay(&m_gsSmallFont, 16,
+                                           INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight() - 24);
+    }
+
+    // Display the mouse coordinates at the top right corner.
+    m_gsSmallFont.SetText("(%ld,%ld)", m_gsMouse.GetX(), m_gsMouse.GetY());
+    m_gsSmallFont.SetDestXY(INTERNAL_RES_X - m_gsSmallFont.GetTextWidth() - 16,
+                            INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight() - 16);
+    m_gsSmallFont.Render();
+
+    // Display the mouse cursor at the current mouse position.
+    m_gsLargeFont.SetText("#");
+    m_gsLargeFont.SetDestXY(m_gsMouse.GetX(), m_gsMouse.GetY() -
+                                                  (int)m_gsLargeFont.GetTextHeight() + 1);
+    m_gsLargeFont.Render();
+    m_gsLargeFont.SetModulateColor(1.0f, 1.0f, 1.0f, 1.0f);
+
+    // Display the title of the demo centered at the bottom.
+    m_gsLargeFont.SetModulateColor(-1.0f, -1.0f, -1.0f, m_glfMenuTransparency);
+    m_gsLargeFont.SetText("MENUS");
+    m_gsLargeFont.SetDestXY((INTERNAL_RES_X - m_gsLargeFont.GetTextWidth()) / 2, 16);
+    m_gsLargeFont.Render();
+
+    /////////////////////////////////////////////////////////////////////////////////////////////
+
+    // Reset display after rendering in 2D.
+    m_gsDisplay.EndRender2D();
+
+    // Swap buffers (double buffering) to display results.
+    m_gsDisplay.EndRender(this->GetDevice());
+
+    return TRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// GS_Demo::MenuUpdate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Scrolls the ground and clouds of the menu demo and lets the user pick options from
+//          the menu, one fixed step of fStepTime seconds at a time. The speeds and their
+//          changes are given per 1/60th of a second.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull and FALSE if not.
+//==============================================================================================
+
+BOOL GS_Demo::MenuUpdate(float fStepTime)
+{
+
+    // Scale the per 1/60th of a second speeds to the length of the step.
+    GLfloat glfStepScale = fStepTime * 60.0f;
+
+    // Draw from where the ground and clouds are now.
+    m_glfPrevRollClds = m_glfRollClds;
+    m_glfPrevRollGrnd = m_glfRollGrnd;
+
+    // Is the game paused?
+    if (IsPaused())
+    {
+        return TRUE;
+    }
+
+    static GLfloat glfRollSpeed = 0.001f;
+
+    m_glfRollClds -= glfRollSpeed * glfStepScale;
+
+    // Reset texture once entire length has been scrolled, moving the previous scroll along with
+    // it so the reset isn't drawn as a scroll back.
+    if ((m_glfRollClds < -1.0f + glfRollSpeed) || (m_glfRollClds >= 1.0f))
+    {
+        m_glfPrevRollClds -= m_glfRollClds;
+        m_glfRollClds = 0.0f;
+    }
+
+    m_glfRollGrnd -= (glfRollSpeed * 10 * glfStepScale);
+
+    // Reset texture once entire length has been scrolled.
+    if ((m_glfRollGrnd < -4.0f + glfRollSpeed) || (m_glfRollGrnd >= 4.0f))
+    {
+        m_glfPrevRollGrnd -= m_glfRollGrnd;
+        m_glfRollGrnd = 0.0f;
+    }
+
     static BOOL bWasMouseReleased = FALSE;
     static BOOL bWasKeyReleased = TRUE;
     static BOOL bWasButtonReleased = TRUE;
@@ -2832,17 +3253,17 @@ BOOL GS_Demo::MenuDemo()
     // Was the page up key pressed?
     case GSK_PAGEUP:
     case GSC_BUTTON_LEFTSHOULDER:
-        if (glfTransparency < 1.0f)
+        if (m_glfMenuTransparency < 1.0f)
         {
-            glfTransparency += 0.05f;
+            m_glfMenuTransparency += 0.05f * glfStepScale;
         }
         break;
     // Was the page down key pressed?
     case GSK_PAGEDOWN:
     case GSC_BUTTON_RIGHTSHOULDER:
-        if (glfTransparency > 0.0f)
+        if (m_glfMenuTransparency > 0.0f)
         {
-            glfTransparency -= 0.05f;
+            m_glfMenuTransparency -= 0.05f * glfStepScale;
         }
         break;
     // Was the right key pressed?
@@ -2850,7 +3271,7 @@ BOOL GS_Demo::MenuDemo()
     case GSC_BUTTON_DPAD_RIGHT:
         if (glfRollSpeed < 0.1f)
         {
-            glfRollSpeed += 0.0001f;
+            glfRollSpeed += 0.0001f * glfStepScale;
         }
         break;
     // Was the left key pressed?
@@ -2858,14 +3279,14 @@ BOOL GS_Demo::MenuDemo()
     case GSC_BUTTON_DPAD_LEFT:
         if (glfRollSpeed > -0.1f)
         {
-            glfRollSpeed -= 0.0001f;
+            glfRollSpeed -= 0.0001f * glfStepScale;
         }
         break;
     // Was the home key pressed?
     case GSK_HOME:
     case GSC_BUTTON_START:
         // Reset all variables.
-        glfTransparency = 1.0f;
+        m_glfMenuTransparency = 1.0f;
         glfRollSpeed = 0.001f;
         break;
     }
@@ -2965,40 +3386,6 @@ BOOL GS_Demo::MenuDemo()
         break;
     }
 
-    /////////////////////////////////////////////////////////////////////////////////////////////
-
-    // Display the frames per second at the top left corner.
-    m_gsSmallFont.SetText("%0.2f", this->GetCurrentFrameRate());
-    m_gsSmallFont.SetDestXY(16, INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight() - 16);
-    m_gsSmallFont.Render();
-
-    // Display the mouse coordinates at the top right corner.
-    m_gsSmallFont.SetText("(%ld,%ld)", m_gsMouse.GetX(), m_gsMouse.GetY());
-    m_gsSmallFont.SetDestXY(INTERNAL_RES_X - m_gsSmallFont.GetTextWidth() - 16,
-                            INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight() - 16);
-    m_gsSmallFont.Render();
-
-    // Display the mouse cursor at the current mouse position.
-    m_gsLargeFont.SetText("#");
-    m_gsLargeFont.SetDestXY(m_gsMouse.GetX(), m_gsMouse.GetY() -
-                                                  (int)m_gsLargeFont.GetTextHeight() + 1);
-    m_gsLargeFont.Render();
-    m_gsLargeFont.SetModulateColor(1.0f, 1.0f, 1.0f, 1.0f);
-
-    // Display the title of the demo centered at the bottom.
-    m_gsLargeFont.SetModulateColor(-1.0f, -1.0f, -1.0f, glfTransparency);
-    m_gsLargeFont.SetText("MENUS");
-    m_gsLargeFont.SetDestXY((INTERNAL_RES_X - m_gsLargeFont.GetTextWidth()) / 2, 16);
-    m_gsLargeFont.Render();
-
-    /////////////////////////////////////////////////////////////////////////////////////////////
-
-    // Reset display after rendering in 2D.
-    m_gsDisplay.EndRender2D();
-
-    // Swap buffers (double buffering) to display results.
-    SwapBuffers(this->GetDevice());
-
     return TRUE;
 }
 
@@ -3012,7 +3399,7 @@ BOOL GS_Demo::MenuDemo()
 // Returns: TRUE if successfull and FALSE if not.
 //==============================================================================================
 
-BOOL GS_Demo::MapDemo()
+BOOL GS_Demo::MapDemo(float fAlpha)
 {
 
     // Make sure we have a valid display before drawing.
@@ -3024,7 +3411,7 @@ BOOL GS_Demo::MapDemo()
     // Is the game paused?
     if (IsPaused())
     {
-        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        m_gsDisplay.GetState()->ClearColor(0.0f, 0.0f, 0.0f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         glLoadIdentity();
         m_gsDisplay.BeginRender2D(this->GetWindow());
@@ -3036,12 +3423,21 @@ BOOL GS_Demo::MapDemo()
                                 (INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight()) / 2);
         m_gsSmallFont.Render();
         m_gsDisplay.EndRender2D();
-        SwapBuffers(this->GetDevice());
+        m_gsDisplay.EndRender(this->GetDevice());
         return TRUE;
     }
 
+    // The clouds and map are scrolled by MapUpdate(), draw them between where they were the
+    // last two steps so they scroll smoothly whatever the frame rate.
+    GLfloat glfRollTex = GS_Lerp(m_glfPrevRollTex, m_glfRollTex, fAlpha);
+
+    int nMapX = m_gsMap.GetMapX();
+    int nMapY = m_gsMap.GetMapY();
+    GLfloat glfMapX = GS_Lerp((GLfloat) m_nPrevMapX, (GLfloat) nMapX, fAlpha);
+    GLfloat glfMapY = GS_Lerp((GLfloat) m_nPrevMapY, (GLfloat) nMapY, fAlpha);
+
     // Set OpenGL clear color to dark red.
-    glClearColor(0.3f, 0.0f, 0.0f, 1.0f);
+    m_gsDisplay.GetState()->ClearColor(0.3f, 0.0f, 0.0f, 1.0f);
 
     // Clear screen and depth buffer.
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -3051,13 +3447,9 @@ BOOL GS_Demo::MapDemo()
 
     /////////////////////////////////////////////////////////////////////////////////////////////
 
-    static GLfloat glfRollTex;
-
-    glfRollTex -= (this->GetFrameTime() * 0.00005f);
-
     // Create two layers of scrolling clouds (the one the invert of the other on the x-axis and
     // the first moving slower than the second) over the entire screen.
-    glBindTexture(GL_TEXTURE_2D, m_gsCloudsTexture.GetID());
+    m_gsDisplay.GetState()->BindTexture(m_gsCloudsTexture.GetID());
     glBegin(GL_QUADS);
     glNormal3f(0.0f, 0.0f, 1.0f);
     glTexCoord2f(1.0f, 1.0f - glfRollTex / 0.5f);
@@ -3079,20 +3471,113 @@ BOOL GS_Demo::MapDemo()
     glVertex3f(8.0f, -3.0f, -5.0f); // Bottom right.
     glEnd();
 
-    // Reset texture when scrolled entire length.
-    while (glfRollTex <= -1.0f)
+    /////////////////////////////////////////////////////////////////////////////////////////////
+
+    // Setup the display for rendering in 2D.
+    m_gsDisplay.BeginRender2D(this->GetWindow());
+
+    /////////////////////////////////////////////////////////////////////////////////////////////
+    // New Code /////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////
+
+    // Set the modulate color for the map.
+    m_gsMap.SetModulateColor(-1.0f, -1.0f, -1.0f, m_glfMapTransparency);
+
+    // Render the map scrolled between the last two steps, then put it back where it is.
+    m_gsMap.SetMapX((int) floor(glfMapX + 0.5f));
+    m_gsMap.SetMapY((int) floor(glfMapY + 0.5f));
+    m_gsMap.Render();
+    m_gsMap.SetMapX(nMapX);
+    m_gsMap.SetMapY(nMapY);
+
+    // Set the modulate color for the player sprite.
+    m_gsPlayerSprite.SetModulateColor(-1.0f, -1.0f, -1.0f, m_glfMapTransparency);
+
+    // The player is moved by MapUpdate() as well, draw it between its last two positions.
+    m_gsPlayerSprite.SetInterpolation(fAlpha);
+
+    // Render the player sprite.
+    m_gsPlayerSprite.Render();
+
+    /////////////////////////////////////////////////////////////////////////////////////////////
+
+    // Display the frames per second at the top left corner.
+    m_gsSmallFont.SetText("%0.2f", this->GetCurrentFrameRate());
+    m_gsSmallFont.SetDestXY(16, INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight() - 16);
+    m_gsSmallFont.Render();
+
+    // Display the frame profile below the frames per second if it is shown.
+    if (m_bIsProfileShown)
+    {
+        this->GetProfiler()->RenderOverlay(&m_gsSmallFont, 16,
+                                           INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight() - 24);
+    }
+
+    // Display the title of the demo centered at the bottom.
+    m_gsLargeFont.SetModulateColor(-1.0f, -1.0f, -1.0f, m_glfMapTransparency);
+    m_gsLargeFont.SetText("MAPS");
+    m_gsLargeFont.SetDestXY((INTERNAL_RES_X - m_gsLargeFont.GetTextWidth()) / 2, 16);
+    m_gsLargeFont.Render();
+
+    /////////////////////////////////////////////////////////////////////////////////////////////
+
+    // Reset display after rendering in 2D.
+    m_gsDisplay.EndRender2D();
+
+    // Unbind all textures.
+    m_gsDisplay.GetState()->BindTexture(0);
+
+    // Swap buffers (double buffering) to display results.
+    m_gsDisplay.EndRender(this->GetDevice());
+
+    return TRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// GS_Demo::MapUpdate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Moves the player through the map of the map demo (scrolling the map when the player
+//          gets near the edge of the clip box), animates the tiles and scrolls the clouds, one
+//          fixed step of fStepTime seconds at a time.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull and FALSE if not.
+//==============================================================================================
+
+BOOL GS_Demo::MapUpdate(float fStepTime)
+{
+
+    // Scale the per 1/60th of a second speeds to the length of the step.
+    GLfloat glfStepScale = fStepTime * 60.0f;
+
+    // Draw from where the clouds, map and player are now.
+    m_glfPrevRollTex = m_glfRollTex;
+    m_nPrevMapX = m_gsMap.GetMapX();
+    m_nPrevMapY = m_gsMap.GetMapY();
+    m_gsPlayerSprite.SaveTransform();
+
+    // Is the game paused?
+    if (IsPaused())
     {
-        glfRollTex += 1.0f;
+        return TRUE;
     }
 
-    /////////////////////////////////////////////////////////////////////////////////////////////
+    // Scroll the clouds a twentieth of their texture every second.
+    m_glfRollTex -= (fStepTime * 0.05f);
+
+    // Reset texture when scrolled entire length, along with the previous scroll.
+    while (m_glfRollTex <= -1.0f)
+    {
+        m_glfRollTex += 1.0f;
+        m_glfPrevRollTex += 1.0f;
+    }
 
-    static GLfloat glfTransparency = 1.0f;
     static BOOL bWasKeyReleased = TRUE;
     int KeyList[3] = {GSK_ENTER, GSK_UP, GSK_DOWN};
     int ButtonList[3] = {GSC_BUTTON_A, GSC_BUTTON_DPAD_UP, GSC_BUTTON_DPAD_DOWN};
 
-    static int nMoveDistance = 4;
+    int nMoveDistance = (int) (4.0f * glfStepScale + 0.5f);
     RECT rcPlayer;
 
     // Get the destination rectangle of the player sprite.
@@ -3101,6 +3586,16 @@ BOOL GS_Demo::MapDemo()
     // Set the collision rectangle 75% of the actual.
     m_gsCollide.SetRectPercentXY(&rcPlayer, 75);
 
+    // Convert the collision rectangle to map coordinates to find out how far the player can
+    // move before running into a wall.
+    RECT rcPlayerMap = rcPlayer;
+    rcPlayerMap.left   -= m_gsMap.GetMapX() + m_gsMap.GetClipBoxLeft();
+    rcPlayerMap.right  -= m_gsMap.GetMapX() + m_gsMap.GetClipBoxLeft();
+    rcPlayerMap.bottom -= m_gsMap.GetMapY() + m_gsMap.GetClipBoxBottom();
+    rcPlayerMap.top    -= m_gsMap.GetMapY() + m_gsMap.GetClipBoxBottom();
+
+    GS_MapContact gsContact;
+
     // Were all the keys in the key list released?
     if (TRUE == m_gsKeyboard.AreKeysUp(3, KeyList) &&
         TRUE == m_gsController.AreButtonsUp(3, ButtonList))
@@ -3124,36 +3619,21 @@ BOOL GS_Demo::MapDemo()
     // Was the up key pressed?
     case GSK_UP:
     case GSC_BUTTON_DPAD_UP:
+        // Find how far the player can move up before running into a wall.
+        m_gsMap.SweepRect(rcPlayerMap, 0, +nMoveDistance, GS_MAP_TILE_SOLID, &gsContact);
         // Has the player not moved half the height of the clip box?
         if ((m_gsPlayerSprite.GetDestY() + (m_gsPlayerSprite.GetFrameHeight() / 2)) <
             (m_gsMap.GetClipBoxBottom() + (m_gsMap.GetClipBoxHeight() / 2)))
         {
-            // Adjust the player rectangle with the planned move.
-            rcPlayer.bottom += nMoveDistance;
-            rcPlayer.top += nMoveDistance;
-            // Is the player rectangle not on the specified tile?
-            if (!m_gsMap.IsOnTile(rcPlayer, 0))
-            {
-                // Move the player up.
-                m_gsPlayerSprite.AddDestY(nMoveDistance);
-            }
-            else
-            {
-                // Move did not take place, reset the player rectangle.
-                rcPlayer.bottom -= nMoveDistance;
-                rcPlayer.top -= nMoveDistance;
-            }
+            // Move the player up.
+            m_gsPlayerSprite.AddDestY(gsContact.nMoveY);
+            rcPlayer.bottom += gsContact.nMoveY;
+            rcPlayer.top += gsContact.nMoveY;
         }
         else
         {
             // Scroll the map downwards.
-            m_gsMap.ScrollY(-nMoveDistance);
-            // Is the player rectangle on the specified tile?
-            if (m_gsMap.IsOnTile(rcPlayer, 0))
-            {
-                // Move did not take place, reset the map.
-                m_gsMap.ScrollY(+nMoveDistance);
-            }
+            m_gsMap.ScrollY(-gsContact.nMoveY);
         }
         // Select the appropriate frame.
         m_gsPlayerSprite.SetFrame(0);
@@ -3161,36 +3641,21 @@ BOOL GS_Demo::MapDemo()
     // Was the down key pressed?
     case GSK_DOWN:
     case GSC_BUTTON_DPAD_DOWN:
+        // Find how far the player can move down before running into a wall.
+        m_gsMap.SweepRect(rcPlayerMap, 0, -nMoveDistance, GS_MAP_TILE_SOLID, &gsContact);
         // Has the player not moved half the height of the clip box?
         if ((m_gsPlayerSprite.GetDestY() + (m_gsPlayerSprite.GetFrameHeight() / 2)) <
             (m_gsMap.GetClipBoxBottom() + (m_gsMap.GetClipBoxHeight() / 2)))
         {
             // Scroll the map upwards.
-            m_gsMap.ScrollY(+nMoveDistance);
-            // Is the player rectangle on the specified tile?
-            if (m_gsMap.IsOnTile(rcPlayer, 0))
-            {
-                // Move did not take place, reset the map.
-                m_gsMap.ScrollY(-nMoveDistance);
-            }
+            m_gsMap.ScrollY(-gsContact.nMoveY);
         }
         else
         {
-            // Adjust the player rectangle with the planned move.
-            rcPlayer.bottom -= nMoveDistance;
-            rcPlayer.top -= nMoveDistance;
-            // Is the player rectangle not on the specified tile?
-            if (!m_gsMap.IsOnTile(rcPlayer, 0))
-            {
-                // Move the player down.
-                m_gsPlayerSprite.AddDestY(-nMoveDistance);
-            }
-            else
-            {
-                // Move did not take place, reset the player rectangle.
-                rcPlayer.bottom += nMoveDistance;
-                rcPlayer.top += nMoveDistance;
-            }
+            // Move the player down.
+            m_gsPlayerSprite.AddDestY(gsContact.nMoveY);
+            rcPlayer.bottom += gsContact.nMoveY;
+            rcPlayer.top += gsContact.nMoveY;
         }
         // Select the appropriate frame.
         m_gsPlayerSprite.SetFrame(2);
@@ -3198,36 +3663,21 @@ BOOL GS_Demo::MapDemo()
     // Was the right key pressed?
     case GSK_LEFT:
     case GSC_BUTTON_DPAD_LEFT:
+        // Find how far the player can move left before running into a wall.
+        m_gsMap.SweepRect(rcPlayerMap, -nMoveDistance, 0, GS_MAP_TILE_SOLID, &gsContact);
         // Has the player not moved half the width of the clip box?
         if ((m_gsPlayerSprite.GetDestX() + (m_gsPlayerSprite.GetFrameWidth() / 2)) <
             (m_gsMap.GetClipBoxLeft() + (m_gsMap.GetClipBoxWidth() / 2)))
         {
             // Scroll the map to the right.
-            m_gsMap.ScrollX(+nMoveDistance);
-            // Is the player rectangle on the specified tile?
-            if (m_gsMap.IsOnTile(rcPlayer, 0))
-            {
-                // Move did not take place, reset the map.
-                m_gsMap.ScrollX(-nMoveDistance);
-            }
+            m_gsMap.ScrollX(-gsContact.nMoveX);
         }
         else
         {
-            // Adjust the player rectangle with the planned move.
-            rcPlayer.left -= nMoveDistance;
-            rcPlayer.right -= nMoveDistance;
-            // Is the player rectangle not on the specified tile?
-            if (!m_gsMap.IsOnTile(rcPlayer, 0))
-            {
-                // Move the player left.
-                m_gsPlayerSprite.AddDestX(-nMoveDistance);
-            }
-            else
-            {
-                // Move did not take place, reset the player rectangle.
-                rcPlayer.left += nMoveDistance;
-                rcPlayer.right += nMoveDistance;
-            }
+            // Move the player left.
+            m_gsPlayerSprite.AddDestX(gsContact.nMoveX);
+            rcPlayer.left += gsContact.nMoveX;
+            rcPlayer.right += gsContact.nMoveX;
         }
         // Select the appropriate frame.
         m_gsPlayerSprite.SetFrame(3);
@@ -3235,36 +3685,21 @@ BOOL GS_Demo::MapDemo()
     // Was the left key pressed?
     case GSK_RIGHT:
     case GSC_BUTTON_DPAD_RIGHT:
+        // Find how far the player can move right before running into a wall.
+        m_gsMap.SweepRect(rcPlayerMap, +nMoveDistance, 0, GS_MAP_TILE_SOLID, &gsContact);
         // Has the player not moved half the width of the clip box?
         if ((m_gsPlayerSprite.GetDestX() + (m_gsPlayerSprite.GetFrameWidth() / 2)) <
             (m_gsMap.GetClipBoxLeft() + (m_gsMap.GetClipBoxWidth() / 2)))
         {
-            // Adjust the player rectangle with the planned move.
-            rcPlayer.left += nMoveDistance;
-            rcPlayer.right += nMoveDistance;
-            // Is the player rectangle not on the specified tile?
-            if (!m_gsMap.IsOnTile(rcPlayer, 0))
-            {
-                // Move the player right.
-                m_gsPlayerSprite.AddDestX(+nMoveDistance);
-            }
-            else
-            {
-                // Move did not take place, reset the player rectangle.
-                rcPlayer.left -= nMoveDistance;
-                rcPlayer.right -= nMoveDistance;
-            }
+            // Move the player right.
+            m_gsPlayerSprite.AddDestX(gsContact.nMoveX);
+            rcPlayer.left += gsContact.nMoveX;
+            rcPlayer.right += gsContact.nMoveX;
         }
         else
         {
             // Scroll the map to the left.
-            m_gsMap.ScrollX(-nMoveDistance);
-            // Is the player rectangle on the specified tile?
-            if (m_gsMap.IsOnTile(rcPlayer, 0))
-            {
-                // Move did not take place, reset the map.
-                m_gsMap.ScrollX(+nMoveDistance);
-            }
+            m_gsMap.ScrollX(-gsContact.nMoveX);
         }
         // Select the appropriate frame.
         m_gsPlayerSprite.SetFrame(1);
@@ -3272,50 +3707,41 @@ BOOL GS_Demo::MapDemo()
     // Was the page up key pressed?
     case GSK_PAGEUP:
     case GSC_BUTTON_LEFTSHOULDER:
-        if (glfTransparency < 1.0f)
+        if (m_glfMapTransparency < 1.0f)
         {
-            glfTransparency += 0.05f;
+            m_glfMapTransparency += 0.05f * glfStepScale;
         }
         break;
     // Was the page down key pressed?
     case GSK_PAGEDOWN:
     case GSC_BUTTON_RIGHTSHOULDER:
-        if (glfTransparency > 0.0f)
+        if (m_glfMapTransparency > 0.0f)
         {
-            glfTransparency -= 0.05f;
+            m_glfMapTransparency -= 0.05f * glfStepScale;
         }
         break;
     // Was the home key pressed?
     case GSK_HOME:
     case GSC_BUTTON_START:
         // Reset all variables.
-        glfTransparency = 1.0f;
+        m_glfMapTransparency = 1.0f;
         m_gsMap.SetMapX(0);
         m_gsMap.SetMapY(0);
         m_gsPlayerSprite.SetDestX(m_gsMap.GetClipBoxLeft() + m_gsMap.GetTileWidth());
         m_gsPlayerSprite.SetDestY(m_gsMap.GetClipBoxBottom() + m_gsMap.GetTileHeight());
+        // Jump straight to the start rather than drawing the way back.
+        m_nPrevMapX = 0;
+        m_nPrevMapY = 0;
+        m_gsPlayerSprite.SaveTransform();
         break;
     }
 
-    // Setup the display for rendering in 2D.
-    m_gsDisplay.BeginRender2D(this->GetWindow());
-
-    /////////////////////////////////////////////////////////////////////////////////////////////
-    // New Code /////////////////////////////////////////////////////////////////////////////////
-    /////////////////////////////////////////////////////////////////////////////////////////////
-
     static int nOldTile = 2;
     static int nNewTile = 2;
-    static int nFrameCounter = 0;
-
-    // Set the modulate color for the map.
-    m_gsMap.SetModulateColor(-1.0f, -1.0f, -1.0f, glfTransparency);
-
-    // Render the map.
-    m_gsMap.Render();
+    static int nStepCount = 0;
 
-    // Wait five frames before changing tiles.
-    if (nFrameCounter++ >= 5)
+    // Wait five steps before changing tiles.
+    if (nStepCount++ >= 5)
     {
         // Replace the old tile with the new tile.
         m_gsMap.ReplaceTileID(nOldTile, nNewTile);
@@ -3329,16 +3755,10 @@ BOOL GS_Demo::MapDemo()
             // Start again from the start.
             nNewTile = 2;
         }
-        // Reset fram counter.
-        nFrameCounter = 0;
+        // Reset step counter.
+        nStepCount = 0;
     }
 
-    // Set the modulate color for the player sprite.
-    m_gsPlayerSprite.SetModulateColor(-1.0f, -1.0f, -1.0f, glfTransparency);
-
-    // Render the player sprite.
-    m_gsPlayerSprite.Render();
-
     // Set the collision rectangle 50% of the old.
     m_gsCollide.SetRectPercentXY(&rcPlayer, 50);
 
@@ -3350,33 +3770,21 @@ BOOL GS_Demo::MapDemo()
         m_gsMap.SetMapY(0);
         m_gsPlayerSprite.SetDestX(m_gsMap.GetClipBoxLeft() + m_gsMap.GetTileWidth());
         m_gsPlayerSprite.SetDestY(m_gsMap.GetClipBoxBottom() + m_gsMap.GetTileHeight());
+        // Jump straight to the start rather than drawing the way back.
+        m_nPrevMapX = 0;
+        m_nPrevMapY = 0;
+        m_gsPlayerSprite.SaveTransform();
         // Play appropriate sound.
         m_gsSound.PlaySample(SAMPLE_RESIZE);
     }
 
-    /////////////////////////////////////////////////////////////////////////////////////////////
-
-    // Display the frames per second at the top left corner.
-    m_gsSmallFont.SetText("%0.2f", this->GetCurrentFrameRate());
-    m_gsSmallFont.SetDestXY(16, INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight() - 16);
-    m_gsSmallFont.Render();
-
-    // Display the title of the demo centered at the bottom.
-    m_gsLargeFont.SetModulateColor(-1.0f, -1.0f, -1.0f, glfTransparency);
-    m_gsLargeFont.SetText("MAPS");
-    m_gsLargeFont.SetDestXY((INTERNAL_RES_X - m_gsLargeFont.GetTextWidth()) / 2, 16);
-    m_gsLargeFont.Render();
-
-    /////////////////////////////////////////////////////////////////////////////////////////////
-
-    // Reset display after rendering in 2D.
-    m_gsDisplay.EndRender2D();
-
-    // Unbind all textures.
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    // Swap buffers (double buffering) to display results.
-    SwapBuffers(this->GetDevice());
+    // Don't draw the map scrolling all the way across when it wrapped around.
+    if ((abs(m_gsMap.GetMapX() - m_nPrevMapX) > m_gsMap.GetMapWidth() / 2) ||
+        (abs(m_gsMap.GetMapY() - m_nPrevMapY) > m_gsMap.GetMapHeight() / 2))
+    {
+        m_nPrevMapX = m_gsMap.GetMapX();
+        m_nPrevMapY = m_gsMap.GetMapY();
+    }
 
     return TRUE;
 }
@@ -3391,7 +3799,7 @@ BOOL GS_Demo::MapDemo()
 // Returns: TRUE if successfull and FALSE if not.
 //==============================================================================================
 
-BOOL GS_Demo::ParticleDemo()
+BOOL GS_Demo::ParticleDemo(float fAlpha)
 {
 
     // Make sure we have a valid display before drawing.
@@ -3403,7 +3811,7 @@ BOOL GS_Demo::ParticleDemo()
     // Is the game paused?
     if (IsPaused())
     {
-        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        m_gsDisplay.GetState()->ClearColor(0.0f, 0.0f, 0.0f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         glLoadIdentity();
         m_gsDisplay.BeginRender2D(this->GetWindow());
@@ -3414,12 +3822,12 @@ BOOL GS_Demo::ParticleDemo()
                                 (INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight()) / 2);
         m_gsSmallFont.Render();
         m_gsDisplay.EndRender2D();
-        SwapBuffers(this->GetDevice());
+        m_gsDisplay.EndRender(this->GetDevice());
         return TRUE;
     }
 
     // Set OpenGL clear color to dark red.
-    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    m_gsDisplay.GetState()->ClearColor(0.0f, 0.0f, 0.0f, 1.0f);
     // glClearColor(0.3f, 0.0f, 0.0f, 1.0f);
 
     // Clear screen and depth buffer.
@@ -3437,7 +3845,7 @@ BOOL GS_Demo::ParticleDemo()
 
     // Create two layers of scrolling clouds (the one the invert of the other on the x-axis and
     // the first moving slower than the second) in the top half of the screen.
-    glBindTexture(GL_TEXTURE_2D, m_gsCloudsTexture.GetID());
+    m_gsDisplay.GetState()->BindTexture(m_gsCloudsTexture.GetID());
     glBegin(GL_QUADS);
        glNormal3f(0.0f, 0.0f, 1.0f);
        glTexCoord2f(1.0f,1.0f+glfRollClds/0.5f); glVertex3f( 28.0f,6.0f,0.0f);    // Top right.
@@ -3462,7 +3870,7 @@ BOOL GS_Demo::ParticleDemo()
        }
 
     // Create a scrolling landscape in the bottom half of the screen.
-    glBindTexture(GL_TEXTURE_2D, m_gsGroundTexture.GetID());
+    m_gsDisplay.GetState()->BindTexture(m_gsGroundTexture.GetID());
     glBegin(GL_QUADS);
        glNormal3f(0.0f, 0.0f, 1.0f);
        glTexCoord2f(7.0f,4.0f-glfRollGrnd); glVertex3f( 28.0f,-3.0f,-50.0f); // Top right.
@@ -3470,7 +3878,7 @@ BOOL GS_Demo::ParticleDemo()
        glTexCoord2f(0.0f,0.0f-glfRollGrnd); glVertex3f(-28.0f,-3.0f,0.0f);   // Bottom left.
        glTexCoord2f(7.0f,0.0f-glfRollGrnd); glVertex3f( 28.0f,-3.0f,0.0f);   // Bottom right.
     glEnd();
-    glBindTexture(GL_TEXTURE_2D, NULL);
+    m_gsDisplay.GetState()->BindTexture(0);
 
     glfRollGrnd -= glfRollSpeed;
 
@@ -3485,7 +3893,88 @@ BOOL GS_Demo::ParticleDemo()
 
     /////////////////////////////////////////////////////////////////////////////////////////////
 
-    static GLfloat glfTransparency = 1.0f;
+    // Setup the display for rendering in 2D.
+    m_gsDisplay.BeginRender2D(this->GetWindow());
+
+    /////////////////////////////////////////////////////////////////////////////////////////////
+    // New Code /////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////
+
+    // The particles are moved by ParticleUpdate(), draw them between their positions of the
+    // last two steps so they move smoothly whatever the frame rate.
+    m_gsParticle.SetInterpolation(fAlpha);
+
+    // Render all active particles.
+    m_gsParticle.Render();
+
+    /////////////////////////////////////////////////////////////////////////////////////////////
+
+    // Display the frames per second at the top left corner.
+    m_gsSmallFont.SetText("%0.2f", this->GetCurrentFrameRate());
+    m_gsSmallFont.SetDestXY(16, INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight() - 16);
+    m_gsSmallFont.Render();
+
+    // Display the frame profile below the frames per second if it is shown.
+    if (m_bIsProfileShown)
+    {
+        this->GetProfiler()->RenderOverlay(&m_gsSmallFont, 16,
+                                           INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight() - 24);
+    }
+
+    // Display the number of particles in the top right corner.
+    m_gsSmallFont.SetText("%04d", m_gsParticle.GetNumParticles());
+    m_gsSmallFont.SetDestX(INTERNAL_RES_X - m_gsSmallFont.GetTextWidth() - 16);
+    m_gsSmallFont.SetDestY(INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight() - 16);
+    m_gsSmallFont.Render();
+
+    // Display the title of the demo centered at the bottom.
+    m_gsLargeFont.SetModulateColor(-1.0f, -1.0f, -1.0f, m_glfParticleTransparency);
+    m_gsLargeFont.SetText("PARTICLES");
+    m_gsLargeFont.SetDestXY((INTERNAL_RES_X - m_gsLargeFont.GetTextWidth()) / 2, 16);
+    m_gsLargeFont.Render();
+
+    /////////////////////////////////////////////////////////////////////////////////////////////
+
+    // Reset display after rendering in 2D.
+    m_gsDisplay.EndRender2D();
+
+    // Unbind all textures.
+    m_gsDisplay.GetState()->BindTexture(0);
+
+    // Swap buffers (double buffering) to display results.
+    m_gsDisplay.EndRender(this->GetDevice());
+
+    return TRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Helper Methods //////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// GS_Demo::ParticleUpdate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Moves and scales the particles of the particle demo, sending them off again from
+//          the centre of the screen once they leave it, one fixed step of fStepTime seconds at
+//          a time.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull and FALSE if not.
+//==============================================================================================
+
+BOOL GS_Demo::ParticleUpdate(float fStepTime)
+{
+
+    // Scale the per 1/60th of a second speeds to the length of the step.
+    GLfloat glfStepScale = fStepTime * 60.0f;
+
+    // Draw from where the particles are now.
+    m_gsParticle.SaveTransform();
+
+    // Is the game paused?
+    if (IsPaused())
+    {
+        return TRUE;
+    }
 
     int nNumParticles = m_gsParticle.GetNumParticles();
     static float fAddScale = 0.100f;
@@ -3551,17 +4040,17 @@ BOOL GS_Demo::ParticleDemo()
     // Was the page up key pressed?
     case GSK_PAGEUP:
     case GSC_BUTTON_LEFTSHOULDER:
-        if (glfTransparency < 1.0f)
+        if (m_glfParticleTransparency < 1.0f)
         {
-            glfTransparency += 0.05f;
+            m_glfParticleTransparency += 0.05f * glfStepScale;
         }
         break;
     // Was the page down key pressed?
     case GSK_PAGEDOWN:
     case GSC_BUTTON_RIGHTSHOULDER:
-        if (glfTransparency > 0.0f)
+        if (m_glfParticleTransparency > 0.0f)
         {
-            glfTransparency -= 0.05f;
+            m_glfParticleTransparency -= 0.05f * glfStepScale;
         }
         break;
     // Was the home key pressed?
@@ -3571,44 +4060,19 @@ BOOL GS_Demo::ParticleDemo()
         m_gsParticle.SetNumParticles(100);
         m_gsParticle.Activate();
         fAddScale = 0.100f;
-        glfTransparency = 1.0f;
+        m_glfParticleTransparency = 1.0f;
         break;
     }
 
-    // Setup the display for rendering in 2D.
-    m_gsDisplay.BeginRender2D(this->GetWindow());
-
-    /////////////////////////////////////////////////////////////////////////////////////////////
-    // New Code /////////////////////////////////////////////////////////////////////////////////
-    /////////////////////////////////////////////////////////////////////////////////////////////
-
-    static float fAddX[MAX_PARTICLES] = {0.0f};
-    static float fAddY[MAX_PARTICLES] = {0.0f};
-    static int nMovementRateX[MAX_PARTICLES] = {0};
-    static int nMovementRateY[MAX_PARTICLES] = {0};
-    static BOOL bMoveLeft[MAX_PARTICLES] = {0};
-    static BOOL bMoveUp[MAX_PARTICLES] = {0};
-    // static BOOL  bIsFirstRun = TRUE;
-
     // Setup particles for the first time.
     if (m_bIsFirstRun)
     {
         // For each particle.
         for (int nLoop = 0; nLoop < m_gsParticle.GetNumParticles(); nLoop++)
         {
-            // Determine a new random movement speed.
-            nMovementRateX[nLoop] = 10;
-            nMovementRateY[nLoop] = 10;
-            // Set horizontal direction randomly.
-            if (rand() % 2 == 1)
-            {
-                bMoveLeft[nLoop] = !bMoveLeft[nLoop];
-            }
-            // Set vertical direction randomly.
-            if (rand() % 2 == 1)
-            {
-                bMoveUp[nLoop] = !bMoveUp[nLoop];
-            }
+            // Move 10 pixels 60 times every second in a random direction.
+            m_gsParticle.SetVelocity(nLoop, (rand() % 2 == 1) ? -600.0f : 600.0f,
+                                     (rand() % 2 == 1) ? 600.0f : -600.0f);
             // Determine random particle scale.
             float fScale = 0.1f; // + float(rand()%11) / 5.0f;
             m_gsParticle.SetScaleX(nLoop, fScale);
@@ -3619,6 +4083,8 @@ BOOL GS_Demo::ParticleDemo()
             // Select a random modulate color for the specified particle.
             m_gsParticle.SetModulateColor(nLoop, 0.0f, 0.0f, 0.0f, 0.0f);
         }
+        // Start from the centre rather than travelling there.
+        m_gsParticle.SaveTransform();
         // Not first run anymore.
         m_bIsFirstRun = FALSE;
     }
@@ -3626,54 +4092,10 @@ BOOL GS_Demo::ParticleDemo()
     // For each particle.
     for (int nLoop = 0; nLoop < m_gsParticle.GetNumParticles(); nLoop++)
     {
-        // Determine the interval required to move the particle at the specified speed, 60
-        // times every second at the current frame rate (on the x-axis) and add it to
-        // the previous intervals.
-        fAddX[nLoop] += (this->GetActionInterval(60) * nMovementRateX[nLoop]);
-        // Have the intervals added up enough to take an action?
-        while (fAddX[nLoop] >= 1.0f)
-        {
-            if (bMoveLeft[nLoop])
-            {
-                // Move the particle 1 pixel left on the x-axis.
-                m_gsParticle.AddDestX(nLoop, -1);
-            }
-            else
-            {
-                // Move the particle 1 pixel right on the x-axis.
-                m_gsParticle.AddDestX(nLoop, +1);
-            }
-            // One action less to be taken.
-            fAddX[nLoop] -= 1.0f;
-        }
-        // Determine the interval required to move the particle at the specified speed, 60
-        // times every second at the current frame rate (on the y-axis) and add it to
-        // the previous intervals.
-        fAddY[nLoop] += (this->GetActionInterval(60) * nMovementRateY[nLoop]);
-        // Have the intervals added up enough to take an action?
-        while (fAddY[nLoop] >= 1.0f)
-        {
-            if (bMoveUp[nLoop])
-            {
-                // Move the particle 1 pixel up on the y-axis.
-                m_gsParticle.AddDestY(nLoop, +1);
-            }
-            else
-            {
-                // Move the particle 1 pixel down on the y-axis.
-                m_gsParticle.AddDestY(nLoop, -1);
-            }
-            // One action less to be taken.
-            fAddY[nLoop] -= 1.0f;
-        }
-        // Scale the particle horizontally at the specified rate 60 times every second.
-        m_gsParticle.AddScaleX(nLoop, this->GetActionInterval(60) * fAddScale);
         if (m_gsParticle.GetScaleX(nLoop) < 1.0f)
         {
             m_gsParticle.SetScaleX(nLoop, 1.0f);
         }
-        // Scale the particle vertically at the specified rate 60 times every second.
-        m_gsParticle.AddScaleY(nLoop, this->GetActionInterval(60) * fAddScale);
         if (m_gsParticle.GetScaleY(nLoop) < 1.0f)
         {
             m_gsParticle.SetScaleY(nLoop, 1.0f);
@@ -3684,186 +4106,49 @@ BOOL GS_Demo::ParticleDemo()
             (m_gsParticle.GetDestY(nLoop) >= INTERNAL_RES_Y) ||
             (m_gsParticle.GetDestY(nLoop) <= 0 - m_gsParticle.GetScaledHeight(nLoop)))
         {
-            // Determine a new random movement speed.
-            nMovementRateX[nLoop] = rand() % 9 + 2;
-            nMovementRateY[nLoop] = rand() % 9 + 2;
-            // Set horizontal direction randomly.
-            if (rand() % 2 == 1)
-            {
-                bMoveLeft[nLoop] = !bMoveLeft[nLoop];
-            }
-            // Set vertical direction randomly.
-            if (rand() % 2 == 1)
-            {
-                bMoveUp[nLoop] = !bMoveUp[nLoop];
-            }
+            // Determine a new random movement speed and direction, 2 to 10 pixels 60 times
+            // every second.
+            int nMovementRateX = rand() % 9 + 2;
+            int nMovementRateY = rand() % 9 + 2;
+            BOOL bMoveLeft = (rand() % 2 == 1);
+            BOOL bMoveUp = (rand() % 2 == 1);
+            m_gsParticle.SetVelocity(nLoop, (bMoveLeft ? -60.0f : 60.0f) * nMovementRateX,
+                                     (bMoveUp ? 60.0f : -60.0f) * nMovementRateY);
             // Determine random particle scale.
             float fScale = 0.1f + float(rand() % 11) / 5.0f;
             m_gsParticle.SetScaleX(nLoop, fScale);
             m_gsParticle.SetScaleY(nLoop, fScale);
             // Set starting position in the centre of the screen.
-            if (bMoveLeft[nLoop])
+            if (bMoveLeft)
             {
                 m_gsParticle.SetDestX(nLoop, (INTERNAL_RES_X / 2) -
-                                                 (100 - 10 * nMovementRateY[nLoop]));
+                                                 (100 - 10 * nMovementRateY));
             }
             else
             {
                 m_gsParticle.SetDestX(nLoop, (INTERNAL_RES_X / 2) +
-                                                 (100 - 10 * nMovementRateY[nLoop]));
+                                                 (100 - 10 * nMovementRateY));
             }
             m_gsParticle.SetDestY(nLoop, INTERNAL_RES_Y / 2 - 35);
+            // Start from the centre rather than travelling there.
+            m_gsParticle.SaveTransform(nLoop);
             // Select a random modulate color for the specified particle.
             m_gsParticle.SetModulateColor(nLoop, float((rand() % 100) + 1) / 100,
                                           float((rand() % 100) + 1) / 100,
                                           float((rand() % 100) + 1) / 100,
-                                          glfTransparency);
+                                          m_glfParticleTransparency);
         }
     }
 
-    // Render all active particles.
-    m_gsParticle.Render();
-
-    /////////////////////////////////////////////////////////////////////////////////////////////
-
-    // Display the frames per second at the top left corner.
-    m_gsSmallFont.SetText("%0.2f", this->GetCurrentFrameRate());
-    m_gsSmallFont.SetDestXY(16, INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight() - 16);
-    m_gsSmallFont.Render();
-
-    // Display the number of particles in the top right corner.
-    m_gsSmallFont.SetText("%04d", nNumParticles);
-    m_gsSmallFont.SetDestX(INTERNAL_RES_X - m_gsSmallFont.GetTextWidth() - 16);
-    m_gsSmallFont.SetDestY(INTERNAL_RES_Y - m_gsSmallFont.GetTextHeight() - 16);
-    m_gsSmallFont.Render();
-
-    // Display the title of the demo centered at the bottom.
-    m_gsLargeFont.SetModulateColor(-1.0f, -1.0f, -1.0f, glfTransparency);
-    m_gsLargeFont.SetText("PARTICLES");
-    m_gsLargeFont.SetDestXY((INTERNAL_RES_X - m_gsLargeFont.GetTextWidth()) / 2, 16);
-    m_gsLargeFont.Render();
-
-    /////////////////////////////////////////////////////////////////////////////////////////////
-
-    // Reset display after rendering in 2D.
-    m_gsDisplay.EndRender2D();
-
-    // Unbind all textures.
-    glBindTexture(GL_TEXTURE_2D, 0);
+    // Scale all particles at the specified rate 60 times every second.
+    m_gsParticle.SetGrowth(fAddScale * 60.0f);
 
-    // Swap buffers (double buffering) to display results.
-    SwapBuffers(this->GetDevice());
+    // Move and scale all particles by the length of the step, spread over the worker threads.
+    m_gsParticle.Update(fStepTime, &m_gsJobSystem);
 
     return TRUE;
 }
 
-////////////////////////////////////////////////////////////////////////////////////////////////
-// Helper Methods //////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////////////////////
-
-//==============================================================================================
-// GS_Demo::SetRenderScaling():
-// ---------------------------------------------------------------------------------------------
-// Purpose: Set the values used for upscaling or downscaling when rendering
-// ---------------------------------------------------------------------------------------------
-// Returns: Nothing
-//==============================================================================================
-
-void GS_Demo::SetRenderScaling(int nWidth, int nHeight, bool bKeepAspect)
-{
-    // Is no scaling required?
-    if ((nWidth == INTERNAL_RES_X) && (nHeight == INTERNAL_RES_Y))
-    {
-        // Reset the default scaling values
-        GS_OGLDisplay::SetScaleFactorX(1.0f);
-        GS_OGLDisplay::SetScaleFactorY(1.0f);
-
-        GS_OGLDisplay::SetRenderModX(0.0f);
-        GS_OGLDisplay::SetRenderModY(0.0f);
-
-        return;
-    }
-
-    // Determine the aspect ratio of the internal resolution
-    float aspect = (float)INTERNAL_RES_X / (float)INTERNAL_RES_Y;
-
-    // Set up default values for upscaling or downscaling
-    float fAspectWidth = (float)nWidth;
-    float fAspectHeight = (float)nHeight;
-    float fRenderModX = 0;
-    float fRenderModY = 0;
-
-    // Should we keep the aspect ratio?
-    if (bKeepAspect)
-    {
-        // Is the horizontal dimension greater than the vertical?
-        if (INTERNAL_RES_X >= INTERNAL_RES_Y)
-        {
-            // Try to scale the rendering to the given width
-            fAspectWidth = (float)nWidth;
-            fAspectHeight = (float)fAspectWidth / aspect;
-            fRenderModX = 0;
-            fRenderModY = (nHeight - fAspectHeight) / 2.0f;
-
-            // Have we scaled beyond the given height
-            if (fAspectHeight > (float)nHeight)
-            {
-                // Scale the rendering to the given height
-                fAspectHeight = (float)nHeight;
-                fAspectWidth = fAspectHeight * aspect;
-                fRenderModX = (nWidth - fAspectWidth) / 2.0f;
-                fRenderModY = 0;
-            }
-        }
-        else
-        {
-            // Try to scale the rendering to the given height
-            fAspectHeight = (float)nHeight;
-            fAspectWidth = fAspectHeight * aspect;
-            fRenderModX = (nWidth - fAspectWidth) / 2.0f;
-            fRenderModY = 0;
-
-            // Have we scaled beyond the given width
-            if (fAspectWidth > (float)nWidth)
-            {
-                // Scale the rendering to the given width
-                fAspectWidth = (float)nWidth;
-                fAspectHeight = (float)fAspectWidth / aspect;
-                fRenderModX = 0;
-                fRenderModY = (nHeight - fAspectHeight) / 2.0f;
-            }
-        }
-    }
-
-    // Set the amount with which the rendering coordinates should be modified
-    GS_OGLDisplay::SetRenderModX(fRenderModX);
-    GS_OGLDisplay::SetRenderModY(fRenderModY);
-
-    // Set the scale factor to effect upscaling or downscaling depending on the resolution
-    GS_OGLDisplay::SetScaleFactorX((float)fAspectWidth / (float)INTERNAL_RES_X);
-    GS_OGLDisplay::SetScaleFactorY((float)fAspectHeight / (float)INTERNAL_RES_Y);
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////////
-
-//==============================================================================================
-// GS_Demo::GetActionInterval():
-// ---------------------------------------------------------------------------------------------
-// Purpose: ...
-// ---------------------------------------------------------------------------------------------
-// Returns: The interval into which any action or actions must be divided in order to be
-//          completed in a second at the current frame rate of the application.
-//==============================================================================================
-
-float GS_Demo::GetActionInterval(float fActionsPerSecond)
-{
-
-    // Convert frame time to seconds and multiply it by the number of actions to determine
-    // what fraction of the action needs to be completed in order to complete the action in
-    // one second (at the current frame rate).
-    return ((this->GetFrameTime() / 1000) * fActionsPerSecond);
-}
-
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 // GS_Error::Report("GS_DEMO.CPP", 441, "Break Point!");
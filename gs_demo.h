@@ -57,6 +57,7 @@ private:
     GS_Controller m_gsController; // Controller object.
 
     GS_OGLDisplay m_gsDisplay; // OpenGL display object.
+    GS_TextureAtlas m_gsAtlas; // Texture atlas holding the font and menu images.
     GS_FmodSound m_gsSound;    // FMOD sound object.
 
     GS_OGLTexture m_gsTexture; // OpenGL texture object.
@@ -68,6 +69,7 @@ private:
     GS_OGLSpriteEx m_gsSpriteEx; // OpenGL sprite ex object.
 
     GS_OGLCollide m_gsCollide;                   // Collision detection object.
+    GS_CollisionWorld m_gsCollisionWorld;        // Finds the sprites that may collide.
     GS_OGLTexture m_gsSpriteTexture;             // OpenGL texture object.
     GS_OGLSpriteEx m_gsSprites[MAXIMUM_SPRITES]; // Array of sprite ex objects.
 
@@ -78,18 +80,50 @@ private:
     GS_OGLMap m_gsMap;               // OpenGL map object.
     GS_OGLSpriteEx m_gsPlayerSprite; // OpenGL sprite ex object.
 
-    GS_OGLParticle m_gsParticle; // OpenGL particle object.
+    GS_JobSystem m_gsJobSystem;     // Worker threads for updating particles and loading assets.
+    GS_AssetLoader m_gsAssetLoader; // Loads textures in the background.
+    GS_OGLParticle m_gsParticle;    // OpenGL particle object.
 
     BOOL m_bMoveRight[MAXIMUM_SPRITES];   // Wether to move right or left.
     BOOL m_bMoveDown[MAXIMUM_SPRITES];    // Wether to move Up or down.
     GLfloat m_fVelocity[MAXIMUM_SPRITES]; // Speed at which to move.
     GLfloat m_fRotation[MAXIMUM_SPRITES]; // Speed at which to rotate.
+    int m_nSpriteBody[MAXIMUM_SPRITES];   // The collision world body of each sprite.
+
+    // What the XxxUpdate() methods move and the XxxDemo() methods draw. The previous values
+    // are those of the step before, the demos are drawn in between.
+    GLfloat m_glfRotTriangle;     // Rotation of the triangle (rotate and shapes demos).
+    GLfloat m_glfRotQuad;         // Rotation of the quad (rotate and shapes demos).
+    GLfloat m_glfPrevRotTriangle;
+    GLfloat m_glfPrevRotQuad;
+    GLfloat m_glfCubeRotateX;     // Rotation of the cube (texture demo).
+    GLfloat m_glfCubeRotateY;
+    GLfloat m_glfCubeDepthZ;      // How deep the cube is on the Z axis.
+    GLfloat m_glfPrevCubeRotateX;
+    GLfloat m_glfPrevCubeRotateY;
+    GLfloat m_glfPrevCubeDepthZ;
+    GLfloat m_glfRollGrnd;        // Scrolling of the ground texture (menu demo).
+    GLfloat m_glfRollClds;        // Scrolling of the clouds texture (menu demo).
+    GLfloat m_glfRollTex;         // Scrolling of the clouds texture (map demo).
+    GLfloat m_glfPrevRollGrnd;
+    GLfloat m_glfPrevRollClds;
+    GLfloat m_glfPrevRollTex;
+    int m_nPrevMapX;              // Scrolling of the map (map demo).
+    int m_nPrevMapY;
+
+    GLfloat m_glfSpriteTransparency; // Transparency chosen in each demo.
+    GLfloat m_glfFontTransparency;
+    GLfloat m_glfCollisionTransparency;
+    GLfloat m_glfMenuTransparency;
+    GLfloat m_glfMapTransparency;
+    GLfloat m_glfParticleTransparency;
 
     RECT m_rcScreen;
 
     int m_nGameProgress;
     int m_nVolume;
     BOOL m_bIsFirstRun;
+    BOOL m_bIsProfileShown;
 
     BOOL m_bUseVSync;
     BOOL m_bUseAliasing;
@@ -103,6 +137,8 @@ protected:
     BOOL GameRelease();
     BOOL GameRestore();
     BOOL GameLoop();
+    BOOL GameUpdate(float fStepTime);
+    BOOL GameRender(float fAlpha);
     void OnChangeMode();
 
 public:
@@ -120,19 +156,23 @@ public:
     BOOL ClearDemo();
     BOOL PolyDemo();
     BOOL ColorDemo();
-    BOOL RotateDemo();
-    BOOL ShapesDemo();
-    BOOL TextureDemo();
-    BOOL SpriteDemo();
-    BOOL FontDemo();
-    BOOL CollisionDemo();
-    BOOL MenuDemo();
-    BOOL MapDemo();
-    BOOL ParticleDemo();
-
-    // Helper methods.
-    void SetRenderScaling(int nWidth, int nHeight, bool bKeepAspect);
-    float GetActionInterval(float fActionsPerSecond);
+    BOOL RotateDemo(float fAlpha);
+    BOOL RotateUpdate(float fStepTime);
+    BOOL ShapesDemo(float fAlpha);
+    BOOL TextureDemo(float fAlpha);
+    BOOL TextureUpdate(float fStepTime);
+    BOOL SpriteDemo(float fAlpha);
+    BOOL SpriteUpdate(float fStepTime);
+    BOOL FontDemo(float fAlpha);
+    BOOL FontUpdate(float fStepTime);
+    BOOL CollisionDemo(float fAlpha);
+    BOOL CollisionUpdate(float fStepTime);
+    BOOL MenuDemo(float fAlpha);
+    BOOL MenuUpdate(float fStepTime);
+    BOOL MapDemo(float fAlpha);
+    BOOL MapUpdate(float fStepTime);
+    BOOL ParticleDemo(float fAlpha);
+    BOOL ParticleUpdate(float fStepTime);
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -308,6 +308,47 @@ BOOL GS_File::Exists(const char* pszFilename)
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+//==============================================================================================
+// GS_File::GetModifiedTime():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Gets when a file was last written, to tell wether a file made from it is out of
+//          date.
+// ---------------------------------------------------------------------------------------------
+// Returns: True if the file exists, FALSE if not.
+//==============================================================================================
+
+BOOL GS_File::GetModifiedTime(const char* pszFilename, time_t* pTime)
+{
+
+    if ((!pszFilename) || (!pTime))
+    {
+        return FALSE;
+    }
+
+    char szFullname[_MAX_PATH];
+
+    // Get the full pathname (directory + filename) of the file.
+    if (FALSE == this->GetFullName(pszFilename, szFullname))
+    {
+        return FALSE;
+    }
+
+    struct stat FileStatus;
+
+    if (stat(szFullname, &FileStatus) != 0)
+    {
+        return FALSE;
+    }
+
+    *pTime = FileStatus.st_mtime;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // File Get/Set Methods. ///////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -20,6 +20,9 @@
 // ---------------------------------------------------------------------------------------------
 #include <stdlib.h>
 #include <stdio.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
 //==============================================================================================
 
 
@@ -97,6 +100,7 @@ public:
     BOOL IsOpen();
     BOOL IsEndOfFile();
     BOOL Exists(const char* pszFilename);
+    BOOL GetModifiedTime(const char* pszFilename, time_t* pTime);
 
     FILE_MODE_FLAGS GetMode();
     unsigned long GetLength();
@@ -0,0 +1,285 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_file_map.cpp, gs_file_map.h                                                      |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_FileMap                                                                          |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Maps the contents of a file into memory for reading, so large data files can be     |
+ |        used directly without reading them piece by piece.                                  |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_file_map.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include platform specific header files.
+// ---------------------------------------------------------------------------------------------
+#ifndef GS_PLATFORM_WINDOWS
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor/Destructor Methods //////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_FileMap::GS_FileMap():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The constructor, initializes class data when class object is created.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_FileMap::GS_FileMap()
+{
+#ifdef GS_PLATFORM_WINDOWS
+    m_FileHandle    = INVALID_HANDLE_VALUE;
+    m_MappingHandle = NULL;
+#else
+    m_nFileDescriptor = -1;
+#endif
+
+    m_pData   = NULL;
+    m_lLength = 0;
+
+    m_bIsOpened = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_FileMap::~GS_FileMap():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The de-structor, de-initializes class data when class object is destroyed.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_FileMap::~GS_FileMap()
+{
+
+    this->Close();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Open/Close Methods. /////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_FileMap::Open():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Opens an existing file and maps its entire contents into memory for reading. Empty
+//          files can't be mapped.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if failed.
+//==============================================================================================
+
+BOOL GS_FileMap::Open(const char* pszFilename)
+{
+
+    // Exit if no valid filename.
+    if (!pszFilename) return FALSE;
+
+    // Close the file if it has already been opened.
+    this->Close();
+
+#ifdef GS_PLATFORM_WINDOWS
+    m_FileHandle = CreateFile(pszFilename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (m_FileHandle == INVALID_HANDLE_VALUE)
+    {
+        return FALSE;
+    }
+
+    m_lLength = GetFileSize(m_FileHandle, NULL);
+
+    if ((m_lLength == 0) || (m_lLength == 0xFFFFFFFF))
+    {
+        this->Close();
+        return FALSE;
+    }
+
+    m_MappingHandle = CreateFileMapping(m_FileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+
+    if (NULL == m_MappingHandle)
+    {
+        this->Close();
+        return FALSE;
+    }
+
+    m_pData = (const BYTE*) MapViewOfFile(m_MappingHandle, FILE_MAP_READ, 0, 0, 0);
+
+    if (NULL == m_pData)
+    {
+        this->Close();
+        return FALSE;
+    }
+#else
+    char szFullname[_MAX_PATH];
+
+    // Normalize the path.
+    strncpy(szFullname, pszFilename, _MAX_PATH - 1);
+    szFullname[_MAX_PATH - 1] = 0;
+    GS_Platform::NormalizePath(szFullname);
+
+    m_nFileDescriptor = open(szFullname, O_RDONLY);
+
+    if (m_nFileDescriptor < 0)
+    {
+        return FALSE;
+    }
+
+    struct stat FileStat;
+
+    if ((fstat(m_nFileDescriptor, &FileStat) != 0) || (FileStat.st_size <= 0))
+    {
+        this->Close();
+        return FALSE;
+    }
+
+    m_lLength = (unsigned long) FileStat.st_size;
+
+    void* pMapping = mmap(NULL, m_lLength, PROT_READ, MAP_PRIVATE, m_nFileDescriptor, 0);
+
+    if (pMapping == MAP_FAILED)
+    {
+        this->Close();
+        return FALSE;
+    }
+
+    m_pData = (const BYTE*) pMapping;
+#endif
+
+    m_bIsOpened = TRUE;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_FileMap::Close():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Unmaps the file contents and closes the file. Any pointers returned by GetData()
+//          are no longer valid afterwards.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_FileMap::Close()
+{
+#ifdef GS_PLATFORM_WINDOWS
+    if (m_pData != NULL)
+    {
+        UnmapViewOfFile(m_pData);
+    }
+    if (m_MappingHandle != NULL)
+    {
+        CloseHandle(m_MappingHandle);
+    }
+    if (m_FileHandle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(m_FileHandle);
+    }
+    m_MappingHandle = NULL;
+    m_FileHandle    = INVALID_HANDLE_VALUE;
+#else
+    if (m_pData != NULL)
+    {
+        munmap((void*) m_pData, m_lLength);
+    }
+    if (m_nFileDescriptor >= 0)
+    {
+        close(m_nFileDescriptor);
+    }
+    m_nFileDescriptor = -1;
+#endif
+
+    m_pData   = NULL;
+    m_lLength = 0;
+
+    m_bIsOpened = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// File-state Methods. /////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_FileMap::IsOpen():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the file has been opened and mapped, FALSE if not.
+//==============================================================================================
+
+BOOL GS_FileMap::IsOpen()
+{
+
+    return m_bIsOpened;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_FileMap::GetData():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: A pointer to the mapped file contents, NULL if the file has not been opened.
+//==============================================================================================
+
+const BYTE* GS_FileMap::GetData()
+{
+
+    return m_pData;
+}
+
+
+//==============================================================================================
+// GS_FileMap::GetLength():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The length of the mapped file in bytes, 0 if the file has not been opened.
+//==============================================================================================
+
+unsigned long GS_FileMap::GetLength()
+{
+
+    return m_lLength;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
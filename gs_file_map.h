@@ -0,0 +1,76 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_file_map.cpp, gs_file_map.h                                                      |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_FileMap                                                                          |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Maps the contents of a file into memory for reading, so large data files can be     |
+ |        used directly without reading them piece by piece.                                  |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+#ifndef GS_FILE_MAP_H
+#define GS_FILE_MAP_H
+
+
+//==============================================================================================
+// Include platform abstraction header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_platform.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_error.h"
+#include "gs_object.h"
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_FileMap : public GS_Object
+{
+
+private:
+
+#ifdef GS_PLATFORM_WINDOWS
+    HANDLE m_FileHandle;    // The opened file.
+    HANDLE m_MappingHandle; // The file mapping object.
+#else
+    int m_nFileDescriptor;  // The opened file.
+#endif
+
+    const BYTE*   m_pData;   // The start of the mapped file contents.
+    unsigned long m_lLength; // The length of the mapped file in bytes.
+
+    BOOL m_bIsOpened;
+
+protected:
+
+    // No protected members.
+
+public:
+
+    GS_FileMap();
+    ~GS_FileMap();
+
+    BOOL Open(const char* pszFilename);
+    void Close();
+
+    BOOL IsOpen();
+
+    const BYTE*   GetData();
+    unsigned long GetLength();
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
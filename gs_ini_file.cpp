@@ -15,103 +15,205 @@
 // Include Game System (GS) header files.
 // ---------------------------------------------------------------------------------------------
 #include "gs_ini_file.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include standard C library header files.
+// ---------------------------------------------------------------------------------------------
+#include <ctype.h>
+//==============================================================================================
 
 #ifndef GS_PLATFORM_WINDOWS
 #include <fstream>
-#include <sstream>
+#include <list>
 #include <map>
 #include <string>
 
 namespace GS_IniFile_Platform {
 
-// Simple INI file parser
-static std::map<std::string, std::map<std::string, std::string>> g_iniCache;
-static std::string g_lastIniFile;
+// A parsed INI file. Every line is kept as it was read (comments, blank lines and the key
+// order included) so that writing the file back only changes the values that were written.
+struct IniLine {
+    std::string text;       // The line as it is written back.
+    std::string key;        // Empty for comments, blank lines and section headers.
+    std::string value;
+    size_t      valueStart; // Where the value starts in the text.
+};
+
+typedef std::list<IniLine> IniLines;
+
+// Orders section and key names without case, as Windows INI files ignore case.
+struct IniNameLess {
+    bool operator()(const std::string& name1, const std::string& name2) const {
+        return strcasecmp(name1.c_str(), name2.c_str()) < 0;
+    }
+};
 
-static void LoadIniFile(const char* filename) {
-    // Normalize the path first
-    char normalizedPath[_MAX_PATH];
+typedef std::map<std::string, IniLines::iterator, IniNameLess> IniKeys;
+
+struct IniSection {
+    IniLines::iterator last; // The header or last key of the section, new keys go after it.
+    IniKeys keys;
+};
+
+typedef std::map<std::string, IniSection, IniNameLess> IniSections;
+
+struct IniDocument {
+    IniLines lines;
+    IniSections sections;
+    int  refCount;  // The GS_IniFile objects that have the file open.
+    bool isDirty;   // Written to since it was last saved.
+    bool useCRLF;   // The file had Windows line endings.
+};
+
+// Every INI file read or written, by normalized path. Files stay parsed while they are open, so
+// switching between files doesn't read them again.
+static std::map<std::string, IniDocument> g_iniDocuments;
+
+static void NormalizeFilename(const char* filename, char* normalizedPath) {
     strncpy(normalizedPath, filename, _MAX_PATH - 1);
     normalizedPath[_MAX_PATH - 1] = '\0';
     GS_Platform::NormalizePath(normalizedPath);
-    
-    if (g_lastIniFile == normalizedPath) return;
-    
-    g_iniCache.clear();
-    g_lastIniFile = normalizedPath;
-    
-    std::ifstream file(normalizedPath);
+}
+
+static std::string Trim(const std::string& text, size_t* start = NULL) {
+    size_t first = text.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) {
+        if (start) *start = text.length();
+        return std::string();
+    }
+    size_t last = text.find_last_not_of(" \t\r\n");
+    if (start) *start = first;
+    return text.substr(first, last - first + 1);
+}
+
+static void LoadIniFile(IniDocument& document, const char* filename) {
+    document.lines.clear();
+    document.sections.clear();
+    document.isDirty = false;
+    document.useCRLF = false;
+
+    std::ifstream file(filename, std::ios::binary);
     if (!file.is_open()) return;
-    
+
     std::string line;
-    std::string currentSection;
-    
+    IniSection* currentSection = NULL;
+
     while (std::getline(file, line)) {
-        // Trim whitespace
-        size_t start = line.find_first_not_of(" \t\r\n");
-        size_t end = line.find_last_not_of(" \t\r\n");
-        if (start == std::string::npos) continue;
-        line = line.substr(start, end - start + 1);
-        
-        // Skip comments
-        if (line.empty() || line[0] == ';' || line[0] == '#') continue;
-        
-        // Section header
-        if (line[0] == '[' && line[line.length()-1] == ']') {
-            currentSection = line.substr(1, line.length()-2);
+        // Remember the line endings so that they are written back the same way.
+        if (!line.empty() && line[line.length() - 1] == '\r') {
+            line.erase(line.length() - 1);
+            document.useCRLF = true;
+        }
+
+        IniLine iniLine;
+        iniLine.text = line;
+        iniLine.valueStart = 0;
+        IniLines::iterator it = document.lines.insert(document.lines.end(), iniLine);
+
+        std::string trimmed = Trim(line);
+
+        // Skip blank lines and comments
+        if (trimmed.empty() || trimmed[0] == ';' || trimmed[0] == '#') continue;
+
+        // Section header (a section that appears twice is merged into the first)
+        if (trimmed[0] == '[' && trimmed[trimmed.length()-1] == ']') {
+            std::string name = trimmed.substr(1, trimmed.length()-2);
+            IniSections::iterator sec = document.sections.find(name);
+            if (sec == document.sections.end()) {
+                sec = document.sections.insert(std::make_pair(name, IniSection())).first;
+            }
+            sec->second.last = it;
+            currentSection = &sec->second;
             continue;
         }
-        
+
         // Key=Value pair
         size_t pos = line.find('=');
         if (pos != std::string::npos) {
-            std::string key = line.substr(0, pos);
-            std::string value = line.substr(pos + 1);
-            
-            // Trim key and value
-            start = key.find_first_not_of(" \t");
-            end = key.find_last_not_of(" \t");
-            if (start != std::string::npos) {
-                key = key.substr(start, end - start + 1);
+            // Keys before the first section header belong to the unnamed section.
+            if (!currentSection) {
+                currentSection = &document.sections[""];
             }
-            
-            start = value.find_first_not_of(" \t");
-            end = value.find_last_not_of(" \t");
-            if (start != std::string::npos) {
-                value = value.substr(start, end - start + 1);
-            }
-            
-            g_iniCache[currentSection][key] = value;
+
+            size_t valueStart;
+            it->key = Trim(line.substr(0, pos));
+            it->value = Trim(line.substr(pos + 1), &valueStart);
+            it->valueStart = pos + 1 + valueStart;
+
+            currentSection->keys[it->key] = it;
+            currentSection->last = it;
         }
     }
-    
+
+    file.close();
+}
+
+// Returns the parsed file, reading it if it isn't parsed yet.
+static IniDocument& GetIniDocument(const char* normalizedPath) {
+    std::map<std::string, IniDocument>::iterator doc = g_iniDocuments.find(normalizedPath);
+
+    if (doc == g_iniDocuments.end()) {
+        doc = g_iniDocuments.insert(std::make_pair(std::string(normalizedPath),
+                                                   IniDocument())).first;
+        doc->second.refCount = 0;
+        LoadIniFile(doc->second, normalizedPath);
+    }
+
+    return doc->second;
+}
+
+// Writes the file to a temporary file next to it and renames that over the file, so a crash
+// while saving leaves either the old or the new file and never half of one.
+static int SaveIniFile(IniDocument& document, const char* normalizedPath) {
+    if (!document.isDirty) return 1;
+
+    std::string tempPath = std::string(normalizedPath) + ".tmp";
+    const char* newline = document.useCRLF ? "\r\n" : "\n";
+
+    std::ofstream file(tempPath.c_str(), std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return 0;
+
+    for (IniLines::iterator it = document.lines.begin(); it != document.lines.end(); ++it) {
+        file << it->text << newline;
+    }
+
     file.close();
+
+    if (file.fail() || rename(tempPath.c_str(), normalizedPath) != 0) {
+        remove(tempPath.c_str());
+        return 0;
+    }
+
+    document.isDirty = false;
+    return 1;
 }
 
-int GetPrivateProfileString(const char* section, const char* key, 
-                            const char* defaultValue, char* buffer, 
+int GetPrivateProfileString(const char* section, const char* key,
+                            const char* defaultValue, char* buffer,
                             int bufferSize, const char* filename) {
     if (!buffer || bufferSize <= 0) return 0;
-    
+
     // Normalize the path
     char normalizedPath[_MAX_PATH];
-    strncpy(normalizedPath, filename, _MAX_PATH - 1);
-    normalizedPath[_MAX_PATH - 1] = '\0';
-    GS_Platform::NormalizePath(normalizedPath);
-    
-    LoadIniFile(normalizedPath);
-    
-    std::string value = defaultValue ? defaultValue : "";
-    
-    if (g_iniCache.find(section) != g_iniCache.end()) {
-        if (g_iniCache[section].find(key) != g_iniCache[section].end()) {
-            value = g_iniCache[section][key];
+    NormalizeFilename(filename, normalizedPath);
+
+    IniDocument& document = GetIniDocument(normalizedPath);
+
+    const char* value = defaultValue ? defaultValue : "";
+
+    IniSections::iterator sec = document.sections.find(section);
+    if (sec != document.sections.end()) {
+        IniKeys::iterator kv = sec->second.keys.find(key);
+        if (kv != sec->second.keys.end()) {
+            value = kv->second->value.c_str();
         }
     }
-    
-    strncpy(buffer, value.c_str(), bufferSize - 1);
+
+    strncpy(buffer, value, bufferSize - 1);
     buffer[bufferSize - 1] = '\0';
-    
+
     return strlen(buffer);
 }
 
@@ -119,31 +221,188 @@ int WritePrivateProfileString(const char* section, const char* key,
                                const char* value, const char* filename) {
     // Normalize the path
     char normalizedPath[_MAX_PATH];
-    strncpy(normalizedPath, filename, _MAX_PATH - 1);
-    normalizedPath[_MAX_PATH - 1] = '\0';
-    GS_Platform::NormalizePath(normalizedPath);
-    
-    LoadIniFile(normalizedPath);
-    
-    // Update cache
-    g_iniCache[section][key] = value;
-    
-    // Write entire file
-    std::ofstream file(normalizedPath);
-    if (!file.is_open()) return 0;
-    
-    for (auto& sec : g_iniCache) {
-        file << "[" << sec.first << "]" << std::endl;
-        for (auto& kv : sec.second) {
-            file << kv.first << "=" << kv.second << std::endl;
+    NormalizeFilename(filename, normalizedPath);
+
+    IniDocument& document = GetIniDocument(normalizedPath);
+
+    IniSections::iterator sec = document.sections.find(section);
+    bool insertAtStart = false;
+
+    // Add a missing section at the end of the file (or the start for the unnamed section).
+    if (sec == document.sections.end()) {
+        sec = document.sections.insert(std::make_pair(std::string(section),
+                                                      IniSection())).first;
+        if (section[0] == '\0') {
+            insertAtStart = true;
+        } else {
+            if (!document.lines.empty() && !Trim(document.lines.back().text).empty()) {
+                IniLine blank;
+                blank.valueStart = 0;
+                document.lines.push_back(blank);
+            }
+            IniLine header;
+            header.text = std::string("[") + section + "]";
+            header.valueStart = 0;
+            sec->second.last = document.lines.insert(document.lines.end(), header);
         }
-        file << std::endl;
     }
-    
-    file.close();
+
+    IniKeys::iterator kv = sec->second.keys.find(key);
+
+    if (kv != sec->second.keys.end()) {
+        // Nothing to save if the value didn't change.
+        if (kv->second->value == value) return 1;
+
+        // Replace only the value, keeping the key as it was written.
+        kv->second->value = value;
+        kv->second->text = kv->second->text.substr(0, kv->second->valueStart) + value;
+    } else {
+        // Add a missing key after the last key of the section.
+        IniLine iniLine;
+        iniLine.key = key;
+        iniLine.value = value;
+        iniLine.text = iniLine.key + "=" + value;
+        iniLine.valueStart = iniLine.key.length() + 1;
+
+        IniLines::iterator next = document.lines.begin();
+        if (!insertAtStart) {
+            next = sec->second.last;
+            ++next;
+        }
+        IniLines::iterator it = document.lines.insert(next, iniLine);
+
+        sec->second.keys[iniLine.key] = it;
+        sec->second.last = it;
+    }
+
+    document.isDirty = true;
+
+    // Files that are open are saved by FlushPrivateProfile() or ClosePrivateProfile(), others
+    // right away.
+    if (document.refCount > 0) return 1;
+
+    return SaveIniFile(document, normalizedPath);
+}
+
+// Copies strings into a buffer the way Windows returns lists, each string ending with a zero
+// and the list with another. A list that doesn't fit is cut off and bufferSize - 2 returned.
+static int CopyStringList(const std::list<std::string>& strings, char* buffer,
+                          int bufferSize) {
+    if (!buffer || bufferSize < 2) return 0;
+
+    int length = 0;
+    for (std::list<std::string>::const_iterator it = strings.begin(); it != strings.end();
+         ++it) {
+        int size = (int) it->length() + 1;
+        if (length + size > bufferSize - 1) {
+            buffer[bufferSize - 2] = '\0';
+            buffer[bufferSize - 1] = '\0';
+            return bufferSize - 2;
+        }
+        memcpy(buffer + length, it->c_str(), size);
+        length += size;
+    }
+
+    buffer[length] = '\0';
+    return length;
+}
+
+int GetPrivateProfileSectionNames(char* buffer, int bufferSize, const char* filename) {
+    // Normalize the path
+    char normalizedPath[_MAX_PATH];
+    NormalizeFilename(filename, normalizedPath);
+
+    IniDocument& document = GetIniDocument(normalizedPath);
+
+    // The unnamed section would end the list, it is read by its (empty) name instead.
+    std::list<std::string> names;
+    for (IniSections::iterator sec = document.sections.begin();
+         sec != document.sections.end(); ++sec) {
+        if (!sec->first.empty()) names.push_back(sec->first);
+    }
+
+    return CopyStringList(names, buffer, bufferSize);
+}
+
+int GetPrivateProfileSection(const char* section, char* buffer, int bufferSize,
+                             const char* filename) {
+    // Normalize the path
+    char normalizedPath[_MAX_PATH];
+    NormalizeFilename(filename, normalizedPath);
+
+    IniDocument& document = GetIniDocument(normalizedPath);
+
+    std::list<std::string> pairs;
+    IniSections::iterator sec = document.sections.find(section);
+    if (sec != document.sections.end()) {
+        for (IniKeys::iterator kv = sec->second.keys.begin(); kv != sec->second.keys.end();
+             ++kv) {
+            pairs.push_back(kv->first + "=" + kv->second->value);
+        }
+    }
+
+    return CopyStringList(pairs, buffer, bufferSize);
+}
+
+int OpenPrivateProfile(const char* filename) {
+    // Normalize the path
+    char normalizedPath[_MAX_PATH];
+    NormalizeFilename(filename, normalizedPath);
+
+    IniDocument& document = GetIniDocument(normalizedPath);
+
+    // Read a file nobody has open again, it may have been changed since it was parsed.
+    if (document.refCount == 0 && !document.isDirty) {
+        LoadIniFile(document, normalizedPath);
+    }
+
+    document.refCount++;
     return 1;
 }
 
+int ReloadPrivateProfile(const char* filename) {
+    // Normalize the path
+    char normalizedPath[_MAX_PATH];
+    NormalizeFilename(filename, normalizedPath);
+
+    IniDocument& document = GetIniDocument(normalizedPath);
+
+    // Save any values written first, or they would be lost.
+    int result = SaveIniFile(document, normalizedPath);
+    LoadIniFile(document, normalizedPath);
+
+    return result;
+}
+
+int FlushPrivateProfile(const char* filename) {
+    // Normalize the path
+    char normalizedPath[_MAX_PATH];
+    NormalizeFilename(filename, normalizedPath);
+
+    std::map<std::string, IniDocument>::iterator doc = g_iniDocuments.find(normalizedPath);
+    if (doc == g_iniDocuments.end()) return 1;
+
+    return SaveIniFile(doc->second, normalizedPath);
+}
+
+int ClosePrivateProfile(const char* filename) {
+    // Normalize the path
+    char normalizedPath[_MAX_PATH];
+    NormalizeFilename(filename, normalizedPath);
+
+    std::map<std::string, IniDocument>::iterator doc = g_iniDocuments.find(normalizedPath);
+    if (doc == g_iniDocuments.end()) return 1;
+
+    int result = SaveIniFile(doc->second, normalizedPath);
+
+    // Forget the file once the last GS_IniFile object closes it.
+    if (doc->second.refCount > 0 && --doc->second.refCount == 0 && !doc->second.isDirty) {
+        g_iniDocuments.erase(doc);
+    }
+
+    return result;
+}
+
 } // namespace GS_IniFile_Platform
 #endif // !GS_PLATFORM_WINDOWS
 
@@ -163,9 +422,12 @@ int WritePrivateProfileString(const char* section, const char* key,
 GS_IniFile::GS_IniFile()
 {
     memset(m_pszFullname, 0, sizeof(m_pszFullname));
-    memset(m_cBuffer, 0, sizeof(m_cBuffer));
 
     m_bIsOpen = FALSE;
+
+    m_pEntries    = NULL;
+    m_nMaxEntries = 0;
+    m_nNumEntries = 0;
 }
 
 
@@ -187,6 +449,8 @@ GS_IniFile::~GS_IniFile()
     {
         this->Close();
     }
+
+    this->Clear();
 }
 
 
@@ -201,7 +465,10 @@ GS_IniFile::~GS_IniFile()
 //==============================================================================================
 // GS_IniFile::Open():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Opens an INI file and reads all its values, so that reading them later doesn't
+//          touch the file again. Values written while the file is open are kept in memory
+//          until Flush() or Close() is called. Any number of files can be open at the same
+//          time.
 // ---------------------------------------------------------------------------------------------
 // Returns: True if successfull, FALSE if not.
 //==============================================================================================
@@ -216,9 +483,47 @@ BOOL GS_IniFile::Open(const char* pszFilename)
 
     strcpy(m_pszFullname, pszFilename);
 
+#ifndef GS_PLATFORM_WINDOWS
+    GS_IniFile_Platform::OpenPrivateProfile(m_pszFullname);
+#endif
+
     m_bIsOpen = TRUE;
 
+    // A file that doesn't exist yet is simply empty.
+    this->Load();
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_IniFile::Flush():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Saves the values written since the file was opened or last flushed. The file is
+//          written to a temporary file first that then replaces it, so it is never left half
+//          written.
+// ---------------------------------------------------------------------------------------------
+// Returns: True if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_IniFile::Flush()
+{
+
+    if (!this->IsOpen())
+    {
+        return FALSE;
+    }
+
+#ifdef GS_PLATFORM_WINDOWS
+    // Passing NULL for everything makes Windows write its cached copy of the file.
+    WritePrivateProfileString(NULL, NULL, NULL, m_pszFullname);
     return TRUE;
+#else
+    return (GS_IniFile_Platform::FlushPrivateProfile(m_pszFullname) != 0);
+#endif
 }
 
 
@@ -228,7 +533,8 @@ BOOL GS_IniFile::Open(const char* pszFilename)
 //==============================================================================================
 // GS_IniFile::Close():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Saves the values written since the file was opened or last flushed and closes it.
+//          The values returned by GetValue() must not be used after the file is closed.
 // ---------------------------------------------------------------------------------------------
 // Returns: True if successfull, FALSE if not.
 //==============================================================================================
@@ -236,9 +542,22 @@ BOOL GS_IniFile::Open(const char* pszFilename)
 BOOL GS_IniFile::Close()
 {
 
+    if (!this->IsOpen())
+    {
+        return TRUE;
+    }
+
+    BOOL bResult = this->Flush();
+
+#ifndef GS_PLATFORM_WINDOWS
+    GS_IniFile_Platform::ClosePrivateProfile(m_pszFullname);
+#endif
+
+    this->Clear();
+
     m_bIsOpen = FALSE;
 
-    return TRUE;
+    return bResult;
 }
 
 
@@ -263,48 +582,231 @@ BOOL GS_IniFile::IsOpen()
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+//==============================================================================================
+// GS_IniFile::Reload():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Reads all the values of the file again, for example after it was edited while the
+//          game was running. The values returned by GetValue() stay valid and are updated.
+// ---------------------------------------------------------------------------------------------
+// Returns: True if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_IniFile::Reload()
+{
+
+    if (!this->IsOpen())
+    {
+        return FALSE;
+    }
+
+    // Save any values written first, or they would be lost.
+    this->Flush();
+
+#ifndef GS_PLATFORM_WINDOWS
+    GS_IniFile_Platform::ReloadPrivateProfile(m_pszFullname);
+#endif
+
+    return this->Load();
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
-// Read Methods ////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Value Table Methods /////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
 //==============================================================================================
-// GS_IniFile::ReadInt():
+// GS_IniFile::HashName():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Hashes a section and key (FNV-1a). Names are hashed without case, as Windows INI
+//          files ignore case.
 // ---------------------------------------------------------------------------------------------
-// Returns: An integer value indicating the value read or the default value if unsuccessfull.
+// Returns: The hash, never 0 as 0 marks unused entries.
 //==============================================================================================
 
-int GS_IniFile::ReadInt(const char* pszSection, const char* pszKey, int nDefaultValue)
+unsigned int GS_IniFile::HashName(const char* pszSection, const char* pszKey)
 {
-    if (!this->IsOpen())
+
+    unsigned int nHash = 2166136261u;
+
+    for (const char* pszChar = pszSection; *pszChar != '\0'; pszChar++)
     {
-        return nDefaultValue;
+        nHash = (nHash ^ (unsigned char) tolower((unsigned char) *pszChar)) * 16777619u;
     }
 
-    char cTempBuffer[50];
+    // Separate the section from the key so "ab", "c" and "a", "bc" differ.
+    nHash = (nHash ^ 0xFF) * 16777619u;
+
+    for (const char* pszChar = pszKey; *pszChar != '\0'; pszChar++)
+    {
+        nHash = (nHash ^ (unsigned char) tolower((unsigned char) *pszChar)) * 16777619u;
+    }
 
-    sprintf(cTempBuffer, "%i", nDefaultValue);
+    return (nHash != 0) ? nHash : 1;
+}
 
-#ifdef GS_PLATFORM_WINDOWS
-    GetPrivateProfileString(pszSection, pszKey, cTempBuffer, m_cBuffer,INI_FILE_BUFFER_SIZE - 2,
-                            m_pszFullname);
-#else
-    GS_IniFile_Platform::GetPrivateProfileString(pszSection, pszKey, cTempBuffer, m_cBuffer,
-                                                  INI_FILE_BUFFER_SIZE - 2, m_pszFullname);
-#endif
 
-    int nValue;
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_IniFile::IsSameName():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Compares two section or key names without case.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the names are the same, FALSE if not.
+//==============================================================================================
+
+BOOL GS_IniFile::IsSameName(const char* pszName1, const char* pszName2)
+{
+
+    while (tolower((unsigned char) *pszName1) == tolower((unsigned char) *pszName2))
+    {
+        if (*pszName1 == '\0')
+        {
+            return TRUE;
+        }
+
+        pszName1++;
+        pszName2++;
+    }
+
+    return FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_IniFile::SetValue():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets a value from the text in the file, which is read as an integer and a float
+//          once here rather than every time the value is read.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_IniFile::SetValue(GS_IniValue* pgsValue, const char* pszValue)
+{
+
+    strncpy(pgsValue->szValue, pszValue, INI_FILE_BUFFER_SIZE - 1);
+    pgsValue->szValue[INI_FILE_BUFFER_SIZE - 1] = '\0';
+
+    pgsValue->bIsSet   = TRUE;
+    pgsValue->bIsInt   = (sscanf(pgsValue->szValue, "%i", &pgsValue->nValue) == 1);
+    pgsValue->bIsFloat = (sscanf(pgsValue->szValue, "%f", &pgsValue->fValue) == 1);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_IniFile::FindValue():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Looks a section and key up in the hash table, optionally adding it (unset) if it
+//          isn't there.
+// ---------------------------------------------------------------------------------------------
+// Returns: The value of the key, NULL if it wasn't found and not added.
+//==============================================================================================
 
-    if (sscanf(m_cBuffer, "%i", &nValue) == 1)
+GS_IniValue* GS_IniFile::FindValue(const char* pszSection, const char* pszKey, BOOL bAdd)
+{
+
+    if ((NULL == pszSection) || (NULL == pszKey))
     {
-        return nValue;
+        return NULL;
     }
-    else
+
+    unsigned int nHash = HashName(pszSection, pszKey);
+
+    if (m_nMaxEntries > 0)
     {
-        return nDefaultValue;
+        int nMask  = m_nMaxEntries - 1;
+        int nEntry = (int) (nHash & nMask);
+
+        // Probe until the key or an unused entry is found.
+        while (m_pEntries[nEntry].nHash != 0)
+        {
+            if (m_pEntries[nEntry].nHash == nHash)
+            {
+                const char* pszName = m_strNames.c_str() + m_pEntries[nEntry].nName;
+
+                if (IsSameName(pszName, pszSection))
+                {
+                    pszName += strlen(pszName) + 1;
+
+                    if (IsSameName(pszName, pszKey))
+                    {
+                        return m_pEntries[nEntry].pValue;
+                    }
+                }
+            }
+
+            nEntry = (nEntry + 1) & nMask;
+        }
+    }
+
+    if (!bAdd)
+    {
+        return NULL;
     }
+
+    // Keep the table at most half full, so keys are found in a probe or two.
+    if ((m_nNumEntries + 1) * 2 > m_nMaxEntries)
+    {
+        int nMaxEntries = (m_nMaxEntries > 0) ? (m_nMaxEntries * 2) : INI_FILE_MIN_ENTRIES;
+
+        GS_IniEntry* pEntries = new GS_IniEntry[nMaxEntries];
+        memset(pEntries, 0, nMaxEntries * sizeof(GS_IniEntry));
+
+        for (int nLoop = 0; nLoop < m_nMaxEntries; nLoop++)
+        {
+            if (m_pEntries[nLoop].nHash != 0)
+            {
+                int nEntry = (int) (m_pEntries[nLoop].nHash & (nMaxEntries - 1));
+
+                while (pEntries[nEntry].nHash != 0)
+                {
+                    nEntry = (nEntry + 1) & (nMaxEntries - 1);
+                }
+
+                pEntries[nEntry] = m_pEntries[nLoop];
+            }
+        }
+
+        GS_SAFE_DELETE_ARRAY(m_pEntries);
+
+        m_pEntries    = pEntries;
+        m_nMaxEntries = nMaxEntries;
+    }
+
+    int nEntry = (int) (nHash & (m_nMaxEntries - 1));
+
+    while (m_pEntries[nEntry].nHash != 0)
+    {
+        nEntry = (nEntry + 1) & (m_nMaxEntries - 1);
+    }
+
+    // Add the names to the pool.
+    m_pEntries[nEntry].nHash = nHash;
+    m_pEntries[nEntry].nName = (int) m_strNames.length();
+    m_strNames.append(pszSection).append(1, '\0');
+    m_strNames.append(pszKey).append(1, '\0');
+
+    // Add an unset value.
+    GS_IniValue gsValue;
+    memset(&gsValue, 0, sizeof(gsValue));
+    m_Values.push_back(gsValue);
+
+    m_pEntries[nEntry].pValue = &m_Values.back();
+    m_nNumEntries++;
+
+    return m_pEntries[nEntry].pValue;
 }
 
 
@@ -312,42 +814,217 @@ int GS_IniFile::ReadInt(const char* pszSection, const char* pszKey, int nDefault
 
 
 //==============================================================================================
-// GS_IniFile::ReadFloat():
+// GS_IniFile::Load():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Reads every value in the file into the hash table. Values no longer in the file
+//          are unset, but stay in the table so the handles given out stay valid. The values
+//          are read back section by section from the parsed file, so it is parsed in one
+//          place only and values written but not yet flushed are read too.
 // ---------------------------------------------------------------------------------------------
-// Returns: A float value indicating the value read or the default value if unsuccessfull.
+// Returns: True if successfull, FALSE if not.
 //==============================================================================================
 
-float GS_IniFile::ReadFloat(const char* pszSection, const char* pszKey, float fDefaultValue)
+BOOL GS_IniFile::Load()
 {
-    if (!this->IsOpen())
+
+    for (std::deque<GS_IniValue>::iterator it = m_Values.begin(); it != m_Values.end(); ++it)
     {
-        return fDefaultValue;
+        it->bIsSet   = FALSE;
+        it->bIsInt   = FALSE;
+        it->bIsFloat = FALSE;
+        it->szValue[0] = '\0';
     }
 
-    char cTempBuffer[50];
+    // Keys before the first section header are in the unnamed section.
+    this->LoadSection("");
+
+    // A list that doesn't fit is cut off two characters short of the buffer size.
+    std::string strNames(INI_FILE_BUFFER_SIZE * 10, '\0');
+    int nLength;
+
+    do
+    {
+        strNames.resize(strNames.size() * 2);
+
+#ifdef GS_PLATFORM_WINDOWS
+        nLength = GetPrivateProfileSectionNames(&strNames[0], (DWORD) strNames.size(),
+                                                m_pszFullname);
+#else
+        nLength = GS_IniFile_Platform::GetPrivateProfileSectionNames(&strNames[0],
+                                                                     (int) strNames.size(),
+                                                                     m_pszFullname);
+#endif
+    } while (nLength == (int) strNames.size() - 2);
+
+    for (const char* pszName = strNames.c_str(); *pszName != '\0';
+         pszName += strlen(pszName) + 1)
+    {
+        this->LoadSection(pszName);
+    }
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_IniFile::LoadSection():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Reads every value of a section into the hash table.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_IniFile::LoadSection(const char* pszSection)
+{
 
-    sprintf(cTempBuffer, "%.2f", fDefaultValue);
+    // A list that doesn't fit is cut off two characters short of the buffer size.
+    std::string strPairs(INI_FILE_BUFFER_SIZE * 10, '\0');
+    int nLength;
+
+    do
+    {
+        strPairs.resize(strPairs.size() * 2);
 
 #ifdef GS_PLATFORM_WINDOWS
-    GetPrivateProfileString(pszSection, pszKey, cTempBuffer, m_cBuffer, INI_FILE_BUFFER_SIZE - 2,
-                            m_pszFullname);
+        nLength = GetPrivateProfileSection(pszSection, &strPairs[0], (DWORD) strPairs.size(),
+                                           m_pszFullname);
 #else
-    GS_IniFile_Platform::GetPrivateProfileString(pszSection, pszKey, cTempBuffer, m_cBuffer,
-                                                  INI_FILE_BUFFER_SIZE - 2, m_pszFullname);
+        nLength = GS_IniFile_Platform::GetPrivateProfileSection(pszSection, &strPairs[0],
+                                                                (int) strPairs.size(),
+                                                                m_pszFullname);
 #endif
+    } while (nLength == (int) strPairs.size() - 2);
 
-    float fValue;
+    // Each pair is "key=value", Windows also returns the comments of the section.
+    char* pszNext;
 
-    if (sscanf(m_cBuffer, "%f", &fValue) == 1)
+    for (char* pszPair = &strPairs[0]; *pszPair != '\0'; pszPair = pszNext)
     {
-        return fValue;
+        pszNext = pszPair + strlen(pszPair) + 1;
+
+        char* pszEqual = strchr(pszPair, '=');
+
+        if ((NULL == pszEqual) || (*pszPair == ';') || (*pszPair == '#'))
+        {
+            continue;
+        }
+
+        char* pszValue = pszEqual + 1;
+
+        do
+        {
+            *pszEqual-- = '\0';
+        } while ((pszEqual >= pszPair) && ((*pszEqual == ' ') || (*pszEqual == '\t')));
+
+        while ((*pszValue == ' ') || (*pszValue == '\t'))
+        {
+            pszValue++;
+        }
+
+        SetValue(this->FindValue(pszSection, pszPair, TRUE), pszValue);
     }
-    else
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_IniFile::Clear():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Empties the hash table.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_IniFile::Clear()
+{
+
+    GS_SAFE_DELETE_ARRAY(m_pEntries);
+
+    m_nMaxEntries = 0;
+    m_nNumEntries = 0;
+
+    m_Values.clear();
+    m_strNames.clear();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Read Methods ////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_IniFile::GetValue():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Gets a handle to the value of a key, which can be kept and read with the static
+//          ReadInt(), ReadFloat() and ReadString() methods for as long as the file is open,
+//          without looking the key up again. A key that isn't in the file yet gets a handle
+//          too, it is set when the key is written or the file is reloaded.
+// ---------------------------------------------------------------------------------------------
+// Returns: The handle, NULL if the file isn't open.
+//==============================================================================================
+
+const GS_IniValue* GS_IniFile::GetValue(const char* pszSection, const char* pszKey)
+{
+
+    if (!this->IsOpen())
+    {
+        return NULL;
+    }
+
+    return this->FindValue(pszSection, pszKey, TRUE);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_IniFile::ReadInt():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: An integer value indicating the value read or the default value if unsuccessfull.
+//==============================================================================================
+
+int GS_IniFile::ReadInt(const char* pszSection, const char* pszKey, int nDefaultValue)
+{
+    if (!this->IsOpen())
+    {
+        return nDefaultValue;
+    }
+
+    return ReadInt(this->FindValue(pszSection, pszKey, FALSE), nDefaultValue);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_IniFile::ReadFloat():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: A float value indicating the value read or the default value if unsuccessfull.
+//==============================================================================================
+
+float GS_IniFile::ReadFloat(const char* pszSection, const char* pszKey, float fDefaultValue)
+{
+    if (!this->IsOpen())
     {
         return fDefaultValue;
     }
+
+    return ReadFloat(this->FindValue(pszSection, pszKey, FALSE), fDefaultValue);
 }
 
 
@@ -370,18 +1047,11 @@ const char* GS_IniFile::ReadString(const char* pszSection, const char* pszKey,
         return pszDefaultValue;
     }
 
-#ifdef GS_PLATFORM_WINDOWS
-    GetPrivateProfileString(pszSection, pszKey, pszDefaultValue, m_cBuffer,
-                            INI_FILE_BUFFER_SIZE - 2, m_pszFullname);
-#else
-    GS_IniFile_Platform::GetPrivateProfileString(pszSection, pszKey, pszDefaultValue, m_cBuffer,
-                                                  INI_FILE_BUFFER_SIZE - 2, m_pszFullname);
-#endif
-
-    return m_cBuffer;
+    return ReadString(this->FindValue(pszSection, pszKey, FALSE), pszDefaultValue);
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Write Methods ///////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -406,11 +1076,7 @@ BOOL GS_IniFile::WriteInt(const char* pszSection, const char* pszKey, int nValue
 
     sprintf(cTempBuffer, "%i", nValue);
 
-#ifdef GS_PLATFORM_WINDOWS
-    return (WritePrivateProfileString(pszSection, pszKey, cTempBuffer, m_pszFullname) != 0);
-#else
-    return (GS_IniFile_Platform::WritePrivateProfileString(pszSection, pszKey, cTempBuffer, m_pszFullname) != 0);
-#endif
+    return this->WriteString(pszSection, pszKey, cTempBuffer);
 }
 
 
@@ -436,11 +1102,7 @@ BOOL GS_IniFile::WriteFloat(const char* pszSection, const char* pszKey, float fV
 
     sprintf(cTempBuffer, "%.2f", fValue);
 
-#ifdef GS_PLATFORM_WINDOWS
-    return (WritePrivateProfileString(pszSection, pszKey, cTempBuffer, m_pszFullname) != 0);
-#else
-    return (GS_IniFile_Platform::WritePrivateProfileString(pszSection, pszKey, cTempBuffer, m_pszFullname) != 0);
-#endif
+    return this->WriteString(pszSection, pszKey, cTempBuffer);
 }
 
 
@@ -463,10 +1125,20 @@ BOOL GS_IniFile::WriteString(const char* pszSection, const char* pszKey, const c
     }
 
 #ifdef GS_PLATFORM_WINDOWS
-    return (WritePrivateProfileString(pszSection, pszKey, pszValue, m_pszFullname) != 0);
+    BOOL bResult = (WritePrivateProfileString(pszSection, pszKey, pszValue,
+                                              m_pszFullname) != 0);
 #else
-    return (GS_IniFile_Platform::WritePrivateProfileString(pszSection, pszKey, pszValue, m_pszFullname) != 0);
+    BOOL bResult = (GS_IniFile_Platform::WritePrivateProfileString(pszSection, pszKey, pszValue,
+                                                                   m_pszFullname) != 0);
 #endif
+
+    // Keep the value that is read back the same as the one written.
+    if (bResult)
+    {
+        SetValue(this->FindValue(pszSection, pszKey, TRUE), pszValue);
+    }
+
+    return bResult;
 }
 
 
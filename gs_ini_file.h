@@ -23,6 +23,14 @@
 //==============================================================================================
 
 
+//==============================================================================================
+// Include standard C++ library header files.
+// ---------------------------------------------------------------------------------------------
+#include <deque>
+#include <string>
+//==============================================================================================
+
+
 //==============================================================================================
 // Include Game System (GS) header files.
 // ---------------------------------------------------------------------------------------------
@@ -44,6 +52,13 @@ namespace GS_IniFile_Platform {
                                 int bufferSize, const char* filename);
     int WritePrivateProfileString(const char* section, const char* key,
                                    const char* value, const char* filename);
+    int GetPrivateProfileSectionNames(char* buffer, int bufferSize, const char* filename);
+    int GetPrivateProfileSection(const char* section, char* buffer, int bufferSize,
+                                 const char* filename);
+    int OpenPrivateProfile(const char* filename);
+    int ReloadPrivateProfile(const char* filename);
+    int FlushPrivateProfile(const char* filename);
+    int ClosePrivateProfile(const char* filename);
 }
 #endif
 
@@ -51,6 +66,29 @@ namespace GS_IniFile_Platform {
 // Class constants.
 // ---------------------------------------------------------------------------------------------
 const int INI_FILE_BUFFER_SIZE = 100;
+const int INI_FILE_MIN_ENTRIES = 64;
+//==============================================================================================
+
+
+//==============================================================================================
+// INI file structures.
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_INI_VALUE
+{
+    BOOL  bIsSet;   // Wether the key is in the file.
+    BOOL  bIsInt;   // Wether the value could be read as an integer.
+    BOOL  bIsFloat; // Wether the value could be read as a float.
+    int   nValue;
+    float fValue;
+    char  szValue[INI_FILE_BUFFER_SIZE];
+} GS_IniValue;
+
+typedef struct GS_INI_ENTRY
+{
+    unsigned int nHash;  // The hash of the section and key, 0 if the entry is not used.
+    int          nName;  // Where the section and key are in the name pool.
+    GS_IniValue* pValue;
+} GS_IniEntry;
 //==============================================================================================
 
 
@@ -67,7 +105,20 @@ private:
 
     BOOL m_bIsOpen;
 
-    char m_cBuffer[INI_FILE_BUFFER_SIZE];
+    GS_IniEntry* m_pEntries;          // A hash table of every section and key read or written.
+    int m_nMaxEntries;                // Always a power of two.
+    int m_nNumEntries;
+    std::deque<GS_IniValue> m_Values; // Never moved, so the handles given out stay valid.
+    std::string m_strNames;           // Every section and key name, each ending with a zero.
+
+    static unsigned int HashName(const char* pszSection, const char* pszKey);
+    static BOOL IsSameName(const char* pszName1, const char* pszName2);
+    static void SetValue(GS_IniValue* pgsValue, const char* pszValue);
+
+    GS_IniValue* FindValue(const char* pszSection, const char* pszKey, BOOL bAdd);
+    BOOL Load();
+    void LoadSection(const char* pszSection);
+    void Clear();
 
 protected:
 
@@ -79,10 +130,15 @@ public:
     ~GS_IniFile();
 
     BOOL Open(const char* pszFilename);
+    BOOL Flush();
     BOOL Close();
 
     BOOL IsOpen();
 
+    BOOL Reload();
+
+    const GS_IniValue* GetValue(const char* pszSection, const char* pszKey);
+
     int   ReadInt  (const char* pszSection, const char* pszKey, int nDefaultValue);
     float ReadFloat(const char* pszSection, const char* pszKey, float fDefaultValue);
     const char* ReadString(const char* pszSection, const char* pszKey,
@@ -91,6 +147,19 @@ public:
     BOOL WriteInt   (const char* pszSection, const char* pszKey, int nValue);
     BOOL WriteFloat (const char* pszSection, const char* pszKey, float fValue);
     BOOL WriteString(const char* pszSection, const char* pszKey, const char* pszValue);
+
+    static int ReadInt(const GS_IniValue* pgsValue, int nDefaultValue)
+    {
+        return ((pgsValue != NULL) && pgsValue->bIsInt) ? pgsValue->nValue : nDefaultValue;
+    }
+    static float ReadFloat(const GS_IniValue* pgsValue, float fDefaultValue)
+    {
+        return ((pgsValue != NULL) && pgsValue->bIsFloat) ? pgsValue->fValue : fDefaultValue;
+    }
+    static const char* ReadString(const GS_IniValue* pgsValue, const char* pszDefaultValue)
+    {
+        return ((pgsValue != NULL) && pgsValue->bIsSet) ? pgsValue->szValue : pszDefaultValue;
+    }
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,465 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_job_system.cpp, gs_job_system.h                                                  |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_JobSystem                                                                        |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: A small pool of worker threads that run jobs over ranges of items. Every worker has |
+ |        its own job queue and steals jobs from the other queues once its own runs empty.    |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_job_system.h"
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor/Destructor Methods //////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_JobSystem::GS_JobSystem():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The constructor, initializes class data when class object is created.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_JobSystem::GS_JobSystem()
+{
+
+    m_pQueues    = NULL;
+    m_nNumQueues = 0;
+    m_nNextQueue = 0;
+
+    m_nNumQueuedJobs = 0;
+    m_bIsQuitting    = false;
+
+    m_bIsReady = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_JobSystem::~GS_JobSystem():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The de-structor, de-initializes class data when class object is destroyed.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_JobSystem::~GS_JobSystem()
+{
+
+    this->Destroy();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Create/Destroy Methods. /////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_JobSystem::Create():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Starts the specified number of worker threads. By default one worker is started for
+//          every processor core except the one the calling thread runs on, since the thread
+//          calling Wait() runs jobs as well. With no worker threads all jobs run in Wait().
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_JobSystem::Create(int nNumThreads)
+{
+
+    // Destroy job system if created previously.
+    this->Destroy();
+
+    if (nNumThreads < 0)
+    {
+        // hardware_concurrency() returns 0 if the number of cores is unknown.
+        nNumThreads = (int) std::thread::hardware_concurrency() - 1;
+
+        if (nNumThreads < 0)
+        {
+            nNumThreads = 0;
+        }
+    }
+
+    if (nNumThreads > GS_JOB_MAX_THREADS)
+    {
+        nNumThreads = GS_JOB_MAX_THREADS;
+    }
+
+    m_nNumQueues = nNumThreads + 1;
+    m_pQueues = new GS_JobQueue[m_nNumQueues];
+
+    if (NULL == m_pQueues)
+    {
+        GS_Error::Report("GS_JOB_SYSTEM.CPP", 112, "Failed to allocate job queues!");
+        m_nNumQueues = 0;
+        return FALSE;
+    }
+
+    m_nNextQueue     = 0;
+    m_nNumQueuedJobs = 0;
+    m_bIsQuitting    = false;
+
+    // Worker threads own the queues after the first.
+    for (int nLoop = 1; nLoop < m_nNumQueues; nLoop++)
+    {
+        try
+        {
+            m_Threads.push_back(std::thread(&GS_JobSystem::WorkerLoop, this, nLoop));
+        }
+        catch (...)
+        {
+            // Carry on with the workers that were started, jobs added to the queues of the
+            // missing workers are stolen by the others.
+            GS_Error::Report("GS_JOB_SYSTEM.CPP", 132, "Failed to start worker thread!");
+            break;
+        }
+    }
+
+    m_bIsReady = TRUE;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_JobSystem::Destroy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Stops all worker threads. Wait for all dispatched jobs before destroying the job
+//          system, jobs that haven't started yet are discarded.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_JobSystem::Destroy()
+{
+
+    // Wake all workers and have them exit.
+    {
+        std::lock_guard<std::mutex> WakeLock(m_WakeMutex);
+        m_bIsQuitting = true;
+    }
+    m_WakeCondition.notify_all();
+
+    for (size_t nLoop = 0; nLoop < m_Threads.size(); nLoop++)
+    {
+        m_Threads[nLoop].join();
+    }
+
+    m_Threads.clear();
+
+    GS_SAFE_DELETE_ARRAY(m_pQueues);
+    m_nNumQueues = 0;
+
+    m_nNumQueuedJobs = 0;
+
+    m_bIsReady = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Job Methods. ////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_JobSystem::Dispatch():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Splits the items into jobs of nItemsPerJob items each and adds them to the queues
+//          of the workers, without waiting for them to finish. The counter is increased by the
+//          number of jobs added and every finished job decreases it, pass it to Wait() to wait
+//          for the jobs. Which items a job processes doesn't depend on the number of threads,
+//          so jobs that write only to their own items give the same results on any machine.
+//
+//          If the job system hasn't been created all jobs run before Dispatch() returns.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_JobSystem::Dispatch(GS_JobFunction pFunction, void* pData, int nNumItems,
+                            int nItemsPerJob, GS_JobCounter* pCounter)
+{
+
+    if ((NULL == pFunction) || (NULL == pCounter) || (nNumItems <= 0))
+    {
+        return;
+    }
+
+    if (nItemsPerJob < 1)
+    {
+        nItemsPerJob = 1;
+    }
+
+    int nNumJobs = (nNumItems + nItemsPerJob - 1) / nItemsPerJob;
+
+    // Run the jobs right away if there is no one to hand them to.
+    if (!m_bIsReady)
+    {
+        for (int nFirst = 0; nFirst < nNumItems; nFirst += nItemsPerJob)
+        {
+            int nLast = (nFirst + nItemsPerJob < nNumItems) ? nFirst + nItemsPerJob : nNumItems;
+            pFunction(pData, nFirst, nLast);
+        }
+        return;
+    }
+
+    // Count the jobs before any of them can be taken or finish.
+    pCounter->fetch_add(nNumJobs);
+    m_nNumQueuedJobs.fetch_add(nNumJobs);
+
+    // Spread the jobs over all queues, idle workers steal what the busy ones don't get to.
+    for (int nFirst = 0; nFirst < nNumItems; nFirst += nItemsPerJob)
+    {
+        GS_Job gsJob;
+        gsJob.pFunction = pFunction;
+        gsJob.pData     = pData;
+        gsJob.nFirst    = nFirst;
+        gsJob.nLast     = (nFirst + nItemsPerJob < nNumItems) ? nFirst + nItemsPerJob : nNumItems;
+        gsJob.pCounter  = pCounter;
+
+        GS_JobQueue* pQueue = &m_pQueues[m_nNextQueue.fetch_add(1) % m_nNumQueues];
+
+        std::lock_guard<std::mutex> QueueLock(pQueue->Mutex);
+        pQueue->Jobs.push_back(gsJob);
+    }
+
+    // Wake the workers, taking the lock so no worker misses the wake up while going to sleep.
+    {
+        std::lock_guard<std::mutex> WakeLock(m_WakeMutex);
+    }
+    m_WakeCondition.notify_all();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_JobSystem::Wait():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Waits until all jobs counted by the counter have finished, running queued jobs on
+//          the calling thread in the meantime.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_JobSystem::Wait(GS_JobCounter* pCounter)
+{
+
+    if ((NULL == pCounter) || !m_bIsReady)
+    {
+        return;
+    }
+
+    while (pCounter->load() > 0)
+    {
+        GS_Job gsJob;
+
+        // Help out instead of sleeping, otherwise give the workers a chance to finish.
+        if (this->TakeJob(0, &gsJob))
+        {
+            this->RunJob(&gsJob);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_JobSystem::ParallelFor():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Dispatches the items as jobs of nItemsPerJob items each and waits for all of them
+//          to finish.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_JobSystem::ParallelFor(GS_JobFunction pFunction, void* pData, int nNumItems,
+                               int nItemsPerJob)
+{
+
+    GS_JobCounter gsCounter(0);
+
+    this->Dispatch(pFunction, pData, nNumItems, nItemsPerJob, &gsCounter);
+    this->Wait(&gsCounter);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_JobSystem::TakeJob():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Takes the most recently added job from the specified queue or, if that queue is
+//          empty, steals the oldest job from one of the other queues.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if a job was taken, FALSE if all queues are empty.
+//==============================================================================================
+
+BOOL GS_JobSystem::TakeJob(int nQueue, GS_Job* pJob)
+{
+
+    // Nothing to take?
+    if (m_nNumQueuedJobs.load() <= 0)
+    {
+        return FALSE;
+    }
+
+    for (int nLoop = 0; nLoop < m_nNumQueues; nLoop++)
+    {
+        GS_JobQueue* pQueue = &m_pQueues[(nQueue + nLoop) % m_nNumQueues];
+
+        std::lock_guard<std::mutex> QueueLock(pQueue->Mutex);
+
+        if (pQueue->Jobs.empty())
+        {
+            continue;
+        }
+
+        if (nLoop == 0)
+        {
+            *pJob = pQueue->Jobs.back();
+            pQueue->Jobs.pop_back();
+        }
+        else
+        {
+            *pJob = pQueue->Jobs.front();
+            pQueue->Jobs.pop_front();
+        }
+
+        m_nNumQueuedJobs.fetch_sub(1);
+
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_JobSystem::RunJob():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Runs the job and counts it as finished.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_JobSystem::RunJob(GS_Job* pJob)
+{
+
+    pJob->pFunction(pJob->pData, pJob->nFirst, pJob->nLast);
+    pJob->pCounter->fetch_sub(1);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_JobSystem::WorkerLoop():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The worker thread, runs jobs until the job system is destroyed and sleeps whenever
+//          there are no jobs to run.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_JobSystem::WorkerLoop(int nQueue)
+{
+
+    while (!m_bIsQuitting)
+    {
+        GS_Job gsJob;
+
+        if (this->TakeJob(nQueue, &gsJob))
+        {
+            this->RunJob(&gsJob);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> WakeLock(m_WakeMutex);
+
+        while (!m_bIsQuitting && (m_nNumQueuedJobs.load() <= 0))
+        {
+            m_WakeCondition.wait(WakeLock);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Status Methods. /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_JobSystem::IsReady():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the job system has been created, FALSE if not.
+//==============================================================================================
+
+BOOL GS_JobSystem::IsReady()
+{
+
+    return m_bIsReady;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_JobSystem::GetNumThreads():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of worker threads running.
+//==============================================================================================
+
+int GS_JobSystem::GetNumThreads()
+{
+
+    return (int) m_Threads.size();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
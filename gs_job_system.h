@@ -0,0 +1,132 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_job_system.cpp, gs_job_system.h                                                  |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_JobSystem                                                                        |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: A small pool of worker threads that run jobs over ranges of items. Every worker has |
+ |        its own job queue and steals jobs from the other queues once its own runs empty.    |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+#ifndef GS_JOB_SYSTEM_H
+#define GS_JOB_SYSTEM_H
+
+
+//==============================================================================================
+// Include platform abstraction header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_platform.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include standard C++ library header files.
+// ---------------------------------------------------------------------------------------------
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_error.h"
+#include "gs_object.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Job system defines.
+// ---------------------------------------------------------------------------------------------
+#define GS_JOB_MAX_THREADS 64 // Maximum number of worker threads.
+//==============================================================================================
+
+
+//==============================================================================================
+// Job types.
+// ---------------------------------------------------------------------------------------------
+
+// A job function processes the items from nFirst up to (but not including) nLast.
+typedef void (*GS_JobFunction)(void* pData, int nFirst, int nLast);
+
+// Counts the jobs of a dispatch that have not finished yet (see Dispatch() and Wait()).
+typedef std::atomic<int> GS_JobCounter;
+
+typedef struct GS_JOB
+{
+    GS_JobFunction pFunction;
+    void* pData;
+    int   nFirst;
+    int   nLast;
+    GS_JobCounter* pCounter;
+} GS_Job;
+
+typedef struct GS_JOB_QUEUE
+{
+    std::mutex Mutex;
+    std::deque<GS_Job> Jobs; // The owner takes jobs from the back, thieves from the front.
+} GS_JobQueue;
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_JobSystem : public GS_Object
+{
+
+private:
+
+    std::vector<std::thread> m_Threads; // The worker threads.
+
+    // One job queue per worker thread plus one (the first) for the threads calling Wait().
+    GS_JobQueue* m_pQueues;
+    int m_nNumQueues;
+    std::atomic<int> m_nNextQueue; // The queue the next dispatched job is added to.
+
+    std::mutex m_WakeMutex;                 // Protects sleeping and waking the workers.
+    std::condition_variable m_WakeCondition;
+    std::atomic<int>  m_nNumQueuedJobs;     // Jobs added to the queues but not yet taken.
+    std::atomic<bool> m_bIsQuitting;        // Wether the workers should exit.
+
+    BOOL m_bIsReady;
+
+    void WorkerLoop(int nQueue);
+    BOOL TakeJob(int nQueue, GS_Job* pJob);
+    void RunJob(GS_Job* pJob);
+
+protected:
+
+    // No protected members.
+
+public:
+
+    GS_JobSystem();
+    ~GS_JobSystem();
+
+    BOOL Create(int nNumThreads = -1);
+    void Destroy();
+
+    BOOL IsReady();
+    int  GetNumThreads();
+
+    void Dispatch(GS_JobFunction pFunction, void* pData, int nNumItems, int nItemsPerJob,
+                  GS_JobCounter* pCounter);
+    void Wait(GS_JobCounter* pCounter);
+
+    void ParallelFor(GS_JobFunction pFunction, void* pData, int nNumItems, int nItemsPerJob);
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -104,6 +104,8 @@ GS_Keyboard::~GS_Keyboard()
 
 void GS_Keyboard::Update(HWND hWnd)
 {
+    GS_PROFILE_SCOPE("GS_Keyboard::Update");
+
 #ifdef GS_PLATFORM_WINDOWS
     MSG msg;
     while (PeekMessage(&msg, hWnd, 0, 0, PM_NOREMOVE))
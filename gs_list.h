@@ -30,12 +30,59 @@
 //==============================================================================================
 
 
+//==============================================================================================
+// Include standard C++ library header files.
+// ---------------------------------------------------------------------------------------------
+#include <new>
+#include <type_traits>
+#include <utility>
+//==============================================================================================
+
+
+//==============================================================================================
+// List defines.
+// ---------------------------------------------------------------------------------------------
+#define GS_LIST_MIN_ALLOCATION 4 // Least number of items space is allocated for on the heap.
+//==============================================================================================
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
-// Class Definition ////////////////////////////////////////////////////////////////////////////
+// Inline Storage //////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+//==============================================================================================
+// Uninitialized space for nNumInline items inside the list object itself, used before any
+// memory is allocated on the heap. Lists without inline items use the specialization below.
+// ---------------------------------------------------------------------------------------------
+template<class type, int nNumInline>
+struct GS_ListStorage
+{
+    typename std::aligned_storage<sizeof(type), alignof(type)>::type aItems[nNumInline];
+
+    type* GetItems()
+    {
+        return reinterpret_cast<type*>(aItems);
+    }
+};
+
 template<class type>
+struct GS_ListStorage<type, 0>
+{
+    type* GetItems()
+    {
+        return 0;
+    }
+};
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition ////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+template<class type, int nNumInline = 0>
 class GS_List
 {
 
@@ -46,30 +93,51 @@ private:
     int m_nNumItems;     // Number of items actually in the array.
     int m_nNumAllocated; // Number of items for which space has been allocated.
 
+    GS_ListStorage<type, nNumInline> m_gsInline; // Space for the first nNumInline items.
+
     void Allocate(int nNumToAllocate);
+    void Grow(int nNumRequired);
+    void Free();
+
+    BOOL IsInline()
+    {
+        return (m_ptArray == m_gsInline.GetItems());
+    }
+
+    template<class data>
+    void Append(data&& tData);
 
 public:
 
     GS_List(int size = 0);
+    GS_List(const GS_List& gsList);
+    GS_List(GS_List&& gsList);
     virtual ~GS_List();
 
-    int FindItem(const type ctData);
+    GS_List& operator = (const GS_List& gsList);
+    GS_List& operator = (GS_List&& gsList);
 
-    void AddItem(type tData);
-    void InsertItem(int nIndex, const type ctData);
+    int FindItem(const type& ctData);
 
-    void RemoveItem(const type tData);
+    void AddItem(const type& ctData);
+    void AddItem(type&& tData);
+    void InsertItem(int nIndex, const type& ctData);
+
+    void RemoveItem(const type& ctData);
     void RemoveIndex(int nIndex);
     void RemoveEmptyItems();
     void RemoveAllItems();
 
-    inline type operator [] (int nIndex) const;
-    inline type GetItem(int nIndex);
-    void SetItem(int nIndex, type tData);
+    inline const type& operator [] (int nIndex) const;
+    inline const type& GetItem(int nIndex);
+    void SetItem(int nIndex, const type& ctData);
 
     inline int GetNumItems();
     void SetNumItems(int nNumToAllocate);
 
+    void Reserve(int nNumToReserve);
+    inline int GetNumAllocated();
+
     inline BOOL IsEmpty();
 };
 
@@ -90,13 +158,13 @@ public:
 // Returns: Nothing.
 //==============================================================================================
 
-template<class type>
-GS_List<type>::GS_List(int nNumToAllocate)
+template<class type, int nNumInline>
+GS_List<type, nNumInline>::GS_List(int nNumToAllocate)
 {
 
-    m_ptArray       = 0;
+    m_ptArray       = m_gsInline.GetItems();
     m_nNumItems     = 0;
-    m_nNumAllocated = 0;
+    m_nNumAllocated = nNumInline;
 
     if (nNumToAllocate)
     {
@@ -108,6 +176,52 @@ GS_List<type>::GS_List(int nNumToAllocate)
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+//==============================================================================================
+// GS_List::GS_List():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The copy constructor, copies all the items of another list.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+template<class type, int nNumInline>
+GS_List<type, nNumInline>::GS_List(const GS_List& gsList)
+{
+
+    m_ptArray       = m_gsInline.GetItems();
+    m_nNumItems     = 0;
+    m_nNumAllocated = nNumInline;
+
+    *this = gsList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_List::GS_List():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The move constructor, takes over the items of another list, leaving it empty.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+template<class type, int nNumInline>
+GS_List<type, nNumInline>::GS_List(GS_List&& gsList)
+{
+
+    m_ptArray       = m_gsInline.GetItems();
+    m_nNumItems     = 0;
+    m_nNumAllocated = nNumInline;
+
+    *this = std::move(gsList);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
 // GS_List::~GS_List():
 // ---------------------------------------------------------------------------------------------
@@ -116,14 +230,97 @@ GS_List<type>::GS_List(int nNumToAllocate)
 // Returns: Nothing.
 //==============================================================================================
 
-template<class type>
-GS_List<type>::~GS_List()
+template<class type, int nNumInline>
+GS_List<type, nNumInline>::~GS_List()
+{
+
+    this->Free();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Assignment Methods. /////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_List::operator = ():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Replaces the items of the list with copies of the items of another list.
+// ---------------------------------------------------------------------------------------------
+// Returns: The list.
+//==============================================================================================
+
+template<class type, int nNumInline>
+GS_List<type, nNumInline>& GS_List<type, nNumInline>::operator = (const GS_List& gsList)
+{
+
+    if (this != &gsList)
+    {
+        this->RemoveAllItems();
+        this->Reserve(gsList.m_nNumItems);
+
+        for (int nLoop = 0; nLoop < gsList.m_nNumItems; nLoop++)
+        {
+            new (&m_ptArray[nLoop]) type(gsList.m_ptArray[nLoop]);
+        }
+
+        m_nNumItems = gsList.m_nNumItems;
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_List::operator = ():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Replaces the items of the list with the items of another list, leaving it empty.
+//          A heap array is taken over as it is, inline items have to be moved one by one.
+// ---------------------------------------------------------------------------------------------
+// Returns: The list.
+//==============================================================================================
+
+template<class type, int nNumInline>
+GS_List<type, nNumInline>& GS_List<type, nNumInline>::operator = (GS_List&& gsList)
 {
 
-    if (m_ptArray)
+    if (this == &gsList)
+    {
+        return *this;
+    }
+
+    this->RemoveAllItems();
+
+    if (!gsList.IsInline())
     {
-        delete [] m_ptArray;
+        m_ptArray       = gsList.m_ptArray;
+        m_nNumItems     = gsList.m_nNumItems;
+        m_nNumAllocated = gsList.m_nNumAllocated;
+
+        gsList.m_ptArray       = gsList.m_gsInline.GetItems();
+        gsList.m_nNumItems     = 0;
+        gsList.m_nNumAllocated = nNumInline;
     }
+    else
+    {
+        for (int nLoop = 0; nLoop < gsList.m_nNumItems; nLoop++)
+        {
+            new (&m_ptArray[nLoop]) type(std::move(gsList.m_ptArray[nLoop]));
+        }
+
+        m_nNumItems = gsList.m_nNumItems;
+
+        gsList.RemoveAllItems();
+    }
+
+    return *this;
 }
 
 
@@ -138,13 +335,14 @@ GS_List<type>::~GS_List()
 //==============================================================================================
 // GS_List::Allocate():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Moves the items to a new array with space for nNumToAllocate items. The array is
+//          left uninitialized beyond the items, which are constructed as they are added.
 // ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
-template<class type>
-void GS_List<type>::Allocate(int nNumToAllocate)
+template<class type, int nNumInline>
+void GS_List<type, nNumInline>::Allocate(int nNumToAllocate)
 {
 
     // Can't alocate space for less items than currently in the list.
@@ -153,25 +351,125 @@ void GS_List<type>::Allocate(int nNumToAllocate)
         return;
     }
 
-    // Create a pointer to the current item array.
-    type* ptOldArray = m_ptArray;
+    // Allocate memory for a new array with space for nNumToAllocate items.
+    type* ptNewArray = static_cast<type*>(::operator new(nNumToAllocate * sizeof(type)));
 
-    // Set how many items to allocate space for.
+    // Move the items to the new array, copying them with memcpy() if that is all a move does.
+    if (std::is_trivially_copyable<type>::value)
+    {
+        if (m_nNumItems > 0)
+        {
+            memcpy((void*) ptNewArray, (const void*) m_ptArray, m_nNumItems * sizeof(type));
+        }
+    }
+    else
+    {
+        for (int nLoop = 0; nLoop < m_nNumItems; nLoop++)
+        {
+            new (&ptNewArray[nLoop]) type(std::move(m_ptArray[nLoop]));
+            m_ptArray[nLoop].~type();
+        }
+    }
+
+    // Delete the old array, unless it is the inline one.
+    if (!this->IsInline())
+    {
+        ::operator delete(m_ptArray);
+    }
+
+    m_ptArray       = ptNewArray;
     m_nNumAllocated = nNumToAllocate;
+}
 
-    // Allocate memory for a new array with space for m_nNumAllocated items.
-    m_ptArray = new type[m_nNumAllocated];
 
-    // If the old array had one or more items, copy them to the new array.
-    if (m_nNumItems > 0)
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_List::Grow():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Makes space for at least nNumRequired items. The space allocated doubles each time
+//          the list is full, so adding N items one at a time moves each item only a constant
+//          number of times on average, rather than moving all the items for every new one.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+template<class type, int nNumInline>
+void GS_List<type, nNumInline>::Grow(int nNumRequired)
+{
+
+    if (nNumRequired <= m_nNumAllocated)
+    {
+        return;
+    }
+
+    int nNumToAllocate = m_nNumAllocated * 2;
+
+    if (nNumToAllocate < GS_LIST_MIN_ALLOCATION)
+    {
+        nNumToAllocate = GS_LIST_MIN_ALLOCATION;
+    }
+
+    if (nNumToAllocate < nNumRequired)
+    {
+        nNumToAllocate = nNumRequired;
+    }
+
+    this->Allocate(nNumToAllocate);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_List::Free():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Destroys all the items and deletes the array if it was allocated on the heap.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+template<class type, int nNumInline>
+void GS_List<type, nNumInline>::Free()
+{
+
+    for (int nLoop = 0; nLoop < m_nNumItems; nLoop++)
     {
-        memcpy(m_ptArray, ptOldArray, m_nNumItems * sizeof(type));
+        m_ptArray[nLoop].~type();
     }
 
-    // Delete the old array.
-    if (ptOldArray)
+    if (!this->IsInline())
     {
-        delete [] ptOldArray;
+        ::operator delete(m_ptArray);
+    }
+
+    m_ptArray       = m_gsInline.GetItems();
+    m_nNumItems     = 0;
+    m_nNumAllocated = nNumInline;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_List::Reserve():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Makes space for at least nNumToReserve items, so that many items can be added
+//          without the list allocating any more memory. Never frees space.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+template<class type, int nNumInline>
+void GS_List<type, nNumInline>::Reserve(int nNumToReserve)
+{
+
+    if (nNumToReserve > m_nNumAllocated)
+    {
+        this->Allocate(nNumToReserve);
     }
 }
 
@@ -185,22 +483,22 @@ void GS_List<type>::Allocate(int nNumToAllocate)
 
 
 //==============================================================================================
-// GS_List::GS_List():
+// GS_List::FindItem():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: Nothing.
+// Returns: The index of the first item equal to ctData, -1 if there is none.
 //==============================================================================================
 
-template<class type>
-int GS_List<type>::FindItem(const type tData)
+template<class type, int nNumInline>
+int GS_List<type, nNumInline>::FindItem(const type& ctData)
 {
 
     // Loop through all the items in the list.
     for (int nLoop = 0; nLoop < m_nNumItems; nLoop++)
     {
         // Return the index if the item that matches the search criteria.
-        if (m_ptArray[nLoop] == tData)
+        if (m_ptArray[nLoop] == ctData)
         {
             return nLoop;
         }
@@ -220,35 +518,70 @@ int GS_List<type>::FindItem(const type tData)
 
 
 //==============================================================================================
-// GS_List::AddItem():
+// GS_List::Append():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Copies or moves an item to the end of the list. If the list has to grow the item
+//          is taken out first, since it may be an item of the list itself.
 // ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
-template<class type>
-void GS_List<type>::AddItem(type tData)
+template<class type, int nNumInline>
+template<class data>
+void GS_List<type, nNumInline>::Append(data&& tData)
 {
 
     // If there are as many items as space have been allocated for.
     if (m_nNumItems == m_nNumAllocated)
     {
-        // If no space has been allocated yet.
-        if (m_nNumAllocated == 0)
-        {
-            // Allocate space for one item.
-            Allocate(1);
-        }
-        else
-        {
-            // Allocate space for one more item.
-            Allocate(m_nNumAllocated + 1);
-        }
+        type tItem(std::forward<data>(tData));
+
+        this->Grow(m_nNumItems + 1);
+
+        new (&m_ptArray[m_nNumItems++]) type(std::move(tItem));
     }
+    else
+    {
+        new (&m_ptArray[m_nNumItems++]) type(std::forward<data>(tData));
+    }
+}
 
-    // Add the item to the end of the list.
-    m_ptArray[m_nNumItems++] = tData;
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_List::AddItem():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Adds a copy of an item to the end of the list.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+template<class type, int nNumInline>
+void GS_List<type, nNumInline>::AddItem(const type& ctData)
+{
+
+    this->Append(ctData);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_List::AddItem():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Moves an item to the end of the list.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+template<class type, int nNumInline>
+void GS_List<type, nNumInline>::AddItem(type&& tData)
+{
+
+    this->Append(std::move(tData));
 }
 
 
@@ -263,8 +596,8 @@ void GS_List<type>::AddItem(type tData)
 // Returns: Nothing.
 //==============================================================================================
 
-template<class type>
-void GS_List<type>::InsertItem(int nIndex, type tData)
+template<class type, int nNumInline>
+void GS_List<type, nNumInline>::InsertItem(int nIndex, const type& ctData)
 {
 
     // Check if a valid index was specified.
@@ -274,30 +607,33 @@ void GS_List<type>::InsertItem(int nIndex, type tData)
     }
 
     // If item is inserted at the end of the list.
-    if ((m_nNumItems == 0) || (nIndex == m_nNumItems))
+    if (nIndex == m_nNumItems)
     {
         // Simply add the item to the list.
-        addItem(tData);
+        this->AddItem(ctData);
     }
     else
     {
-        // Save the last item in the list.
-        type tLastItem = m_ptArray[m_nNumItems - 1];
+        // Copy the item first, it may be an item of the list itself.
+        type tItem(ctData);
+
+        // Move the last item one position forward, to the end of the list.
+        this->Grow(m_nNumItems + 1);
+        new (&m_ptArray[m_nNumItems]) type(std::move(m_ptArray[m_nNumItems - 1]));
 
         // Iterate backwards through the list up to where the new item will be inserted.
         for (int nLoop = m_nNumItems - 1; nLoop > nIndex; nLoop--)
         {
-            // Overwite the current item in the list with the one just before it (thus moving all
-            // the items, from the position where the new item should be inserted onward, one
-            // position forward and overwriting the last item).
-            m_ptArray[nLoop] = m_ptArray[nLoop - 1];
+            // Overwite the current item in the list with the one just before it (thus moving
+            // all the items, from the position where the new item should be inserted onward,
+            // one position forward).
+            m_ptArray[nLoop] = std::move(m_ptArray[nLoop - 1]);
         }
 
         // Insert the item at the specified position.
-        m_ptArray[nIndex] = tData;
+        m_ptArray[nIndex] = std::move(tItem);
 
-        // Add the last item at the end of the list.
-        AddItem(tLastItem);
+        m_nNumItems++;
     }
 }
 
@@ -318,18 +654,21 @@ void GS_List<type>::InsertItem(int nIndex, type tData)
 // Returns: Nothing.
 //==============================================================================================
 
-template<class type>
-void GS_List<type>::RemoveItem(const type tData)
+template<class type, int nNumInline>
+void GS_List<type, nNumInline>::RemoveItem(const type& ctData)
 {
 
+    // Copy the item first, it may be an item of the list itself.
+    type tItem(ctData);
+
     // Find the item to remove from the list.
-    int nIndex = FindItem(tData);
+    int nIndex = FindItem(tItem);
 
     // Remove all items matching the criteria from the list.
     while (nIndex != -1)
     {
         RemoveIndex(nIndex);
-        nIndex = FindItem(tData);
+        nIndex = FindItem(tItem);
     }
 }
 
@@ -345,8 +684,8 @@ void GS_List<type>::RemoveItem(const type tData)
 // Returns: Nothing.
 //==============================================================================================
 
-template<class type>
-void GS_List<type>::RemoveIndex(int nIndex)
+template<class type, int nNumInline>
+void GS_List<type, nNumInline>::RemoveIndex(int nIndex)
 {
 
 
@@ -356,15 +695,15 @@ void GS_List<type>::RemoveIndex(int nIndex)
         return;
     }
 
-    // Remove the item at the specified index.
-    if (nIndex < m_nNumItems - 1)
+    // Move all the items after the indicated item one back to overwrite the indicated item.
+    for (int nLoop = nIndex; nLoop < m_nNumItems - 1; nLoop++)
     {
-        // Move all the items after the indicated item one back to overwrite the indicated item.
-        memmove(&m_ptArray[nIndex], &m_ptArray[nIndex+1], (m_nNumItems-1-nIndex) * sizeof(type));
+        m_ptArray[nLoop] = std::move(m_ptArray[nLoop + 1]);
     }
 
     // List now has one less item.
     m_nNumItems--;
+    m_ptArray[m_nNumItems].~type();
 }
 
 
@@ -379,8 +718,8 @@ void GS_List<type>::RemoveIndex(int nIndex)
 // Returns: Nothing.
 //==============================================================================================
 
-template<class type>
-void GS_List<type>::RemoveEmptyItems()
+template<class type, int nNumInline>
+void GS_List<type, nNumInline>::RemoveEmptyItems()
 {
 
     int nIndex = m_nNumItems;
@@ -403,28 +742,16 @@ void GS_List<type>::RemoveEmptyItems()
 //==============================================================================================
 // GS_List::RemoveAllItems():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Removes all the items and frees the memory allocated for them.
 // ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
-template<class type>
-void GS_List<type>::RemoveAllItems()
+template<class type, int nNumInline>
+void GS_List<type, nNumInline>::RemoveAllItems()
 {
 
-    // Reset the number of items in the list to zero.
-    m_nNumItems = 0;
-
-    // If memory has been allocated for the array.
-    if (m_ptArray)
-    {
-        // Delete the entire array.
-        delete [] m_ptArray;
-        m_ptArray = 0;
-    }
-
-    // Indicate that no memory has been allocated.
-    m_nNumAllocated = 0;
+    this->Free();
 }
 
 
@@ -441,11 +768,11 @@ void GS_List<type>::RemoveAllItems()
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: Nothing.
+// Returns: The item at the specified index.
 //==============================================================================================
 
-template<class type>
-inline type GS_List<type>::operator [] (int nIndex) const
+template<class type, int nNumInline>
+inline const type& GS_List<type, nNumInline>::operator [] (int nIndex) const
 {
 
     // Check if a valid index was specified.
@@ -467,8 +794,8 @@ inline type GS_List<type>::operator [] (int nIndex) const
 // Returns: An item of type at the specified index.
 //==============================================================================================
 
-template<class type>
-inline type GS_List<type>::GetItem(int nIndex)
+template<class type, int nNumInline>
+inline const type& GS_List<type, nNumInline>::GetItem(int nIndex)
 {
 
     // Check if a valid index was specified.
@@ -490,15 +817,15 @@ inline type GS_List<type>::GetItem(int nIndex)
 // Returns: Nothing.
 //==============================================================================================
 
-template<class type>
-void GS_List<type>::SetItem(int nIndex, type tData)
+template<class type, int nNumInline>
+void GS_List<type, nNumInline>::SetItem(int nIndex, const type& ctData)
 {
 
     // If the index is valid, set the item at the specified index to the specified data,
     // overwriting the previous item stored there, if any.
-    if ((nIndex >= 0) || (nIndex < m_nNumItems))
+    if ((nIndex >= 0) && (nIndex < m_nNumItems))
     {
-        m_ptArray[nIndex] = tData;
+        m_ptArray[nIndex] = ctData;
     }
 }
 
@@ -511,11 +838,11 @@ void GS_List<type>::SetItem(int nIndex, type tData)
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: Nothing.
+// Returns: The number of items in the list.
 //==============================================================================================
 
-template<class type>
-inline int GS_List<type>::GetNumItems()
+template<class type, int nNumInline>
+inline int GS_List<type, nNumInline>::GetNumItems()
 {
 
     return m_nNumItems;
@@ -528,34 +855,57 @@ inline int GS_List<type>::GetNumItems()
 //==============================================================================================
 // GS_List::SetNumItems():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Sets the number of items in the list. New items are value initialized (zero for
+//          pointers and numbers), items beyond the new number are removed.
 // ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
-template<class type>
-void GS_List<type>::SetNumItems(int nNumToAllocate)
+template<class type, int nNumInline>
+void GS_List<type, nNumInline>::SetNumItems(int nNumToAllocate)
 {
 
     // If no space should be allocated.
-    if (nNumToAllocate == 0)
+    if (nNumToAllocate <= 0)
     {
         // Delete the array.
-        if (m_ptArray)
-        {
-            delete [] m_ptArray;
-            m_ptArray = 0;
-        }
+        this->Free();
+        return;
     }
-    else
+
+    // Allocate space for exactly the required number of items.
+    this->Reserve(nNumToAllocate);
+
+    // Remove the items beyond the new number of items.
+    while (m_nNumItems > nNumToAllocate)
     {
-        // Allocate space for the required number of items.
-        Allocate(nNumToAllocate);
+        m_ptArray[--m_nNumItems].~type();
     }
 
+    // Add items up to the new number of items.
+    while (m_nNumItems < nNumToAllocate)
+    {
+        new (&m_ptArray[m_nNumItems++]) type();
+    }
+}
+
 
-    // Set number of items to the number allocated.
-    m_nNumItems = nNumToAllocate;
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_List::GetNumAllocated():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of items space has been allocated for (inline or on the heap).
+//==============================================================================================
+
+template<class type, int nNumInline>
+inline int GS_List<type, nNumInline>::GetNumAllocated()
+{
+
+    return m_nNumAllocated;
 }
 
 
@@ -575,8 +925,8 @@ void GS_List<type>::SetNumItems(int nNumToAllocate)
 // Returns: TRUE if list is empty, FALSE if not.
 //==============================================================================================
 
-template<class type>
-inline BOOL GS_List<type>::IsEmpty()
+template<class type, int nNumInline>
+inline BOOL GS_List<type, nNumInline>::IsEmpty()
 {
 
     return (m_nNumItems == 0);
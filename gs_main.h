@@ -44,12 +44,17 @@
 // Include Game System (GS) header files.
 // ---------------------------------------------------------------------------------------------
 #include "gs_app.h"
+#include "gs_collision_world.h"
 #include "gs_error.h"
 #include "gs_file.h"
+#include "gs_file_map.h"
 #include "gs_ini_file.h"
+#include "gs_job_system.h"
 #include "gs_keyboard.h"
 #include "gs_mouse.h"
+#include "gs_profiler.h"
 #include "gs_timer.h"
+#include "gs_ogl_asset_loader.h"
 #include "gs_ogl_collide.h"
 #include "gs_ogl_display.h"
 #include "gs_ogl_font.h"
@@ -57,10 +62,16 @@
 #include "gs_ogl_map.h"
 #include "gs_ogl_menu.h"
 #include "gs_ogl_particle.h"
+#include "gs_ogl_render_target.h"
 #include "gs_ogl_sprite.h"
 #include "gs_ogl_sprite_ex.h"
+#include "gs_ogl_sprite_batch.h"
+#include "gs_ogl_state.h"
 #include "gs_ogl_texture.h"
+#include "gs_ogl_texture_atlas.h"
+#include "gs_ogl_texture_cache.h"
 #include "gs_sdl_controller.h"
+#include "gs_soft_mixer.h"
 
 #ifdef GS_USE_SDL_MIXER
 #include "gs_sdl_mixer_sound.h"
@@ -46,6 +46,8 @@ float GS_Cos(float angle);
 float GS_ArcTan(float y, float x);
 float GS_Abs(float x);
 float GS_Sqrt(float x);
+float GS_Lerp(float from, float to, float t);
+float GS_LerpAngle(float from, float to, float t);
 //==============================================================================================
 
 
@@ -160,6 +162,54 @@ inline float GS_Sqrt(float x)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Lerp():
+// ---------------------------------------------------------------------------------------------
+// Purpose: To interpolate linearly between two values, t being 0.0 at from and 1.0 at to.
+// ---------------------------------------------------------------------------------------------
+// Returns: The interpolated value.
+//==============================================================================================
+
+inline float GS_Lerp(float from, float to, float t)
+{
+
+    return from + (to - from) * t;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_LerpAngle():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Same as GS_Lerp() but for angles in degrees, which are interpolated the shortest
+//          way round so an angle wrapping from 359 to 1 degrees doesn't turn all the way back.
+// ---------------------------------------------------------------------------------------------
+// Returns: The interpolated angle.
+//==============================================================================================
+
+inline float GS_LerpAngle(float from, float to, float t)
+{
+
+    float delta = fmodf(to - from, 360.0f);
+
+    if (delta > 180.0f)
+    {
+        delta -= 360.0f;
+    }
+    else if (delta < -180.0f)
+    {
+        delta += 360.0f;
+    }
+
+    return from + delta * t;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 #endif
@@ -95,6 +95,8 @@ GS_Mouse::~GS_Mouse()
 
 void GS_Mouse::Update(HWND hWnd)
 {
+    GS_PROFILE_SCOPE("GS_Mouse::Update");
+
 #ifdef GS_PLATFORM_WINDOWS
     MSG msg;
     while (PeekMessage(&msg, hWnd, 0, 0, PM_NOREMOVE))
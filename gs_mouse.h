@@ -18,6 +18,7 @@
 // Include Game System (GS) header files.
 // ---------------------------------------------------------------------------------------------
 #include "gs_object.h"
+#include "gs_profiler.h"
 //==============================================================================================
 
 
@@ -0,0 +1,641 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_asset_loader.cpp, gs_ogl_asset_loader.h                                      |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_AssetLoader                                                                      |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Loads textures in the background. Image files are read and decoded by the workers   |
+ |        of a job system, Update() then uploads the decoded images to OpenGL on the render   |
+ |        thread, a limited number of bytes per frame so that loading never causes a hitch.   |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_ogl_asset_loader.h"
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor/Destructor Methods //////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_AssetLoader::GS_AssetLoader():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The constructor, initializes class data when class object is created.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_AssetLoader::GS_AssetLoader()
+{
+
+    m_pJobSystem = NULL;
+    m_gsCounter  = 0;
+
+    m_pRequests    = NULL;
+    m_nMaxRequests = 0;
+    m_nNumRequests = 0;
+
+    m_nUploadBudget = GS_ASSET_UPLOAD_BUDGET;
+
+    m_bIsReady = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_AssetLoader::~GS_AssetLoader():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The de-structor, de-initializes class data when class object is destroyed.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_AssetLoader::~GS_AssetLoader()
+{
+
+    this->Destroy();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Create/Destroy Methods. /////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_AssetLoader::Create():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets up room for nMaxRequests requests at a time. Images are decoded by the workers
+//          of the job system, or right away by LoadTexture() if no job system is specified.
+//          Update() uploads up to nUploadBudget bytes of image data per call, a budget of 0 or
+//          less uploads everything that has been decoded.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_AssetLoader::Create(GS_JobSystem* pJobSystem, int nMaxRequests, int nUploadBudget)
+{
+
+    // Destroy asset loader if created previously.
+    this->Destroy();
+
+    if (nMaxRequests < 1)
+    {
+        nMaxRequests = 1;
+    }
+
+    m_pRequests = new GS_AssetRequest[nMaxRequests];
+
+    if (NULL == m_pRequests)
+    {
+        GS_Error::Report("GS_OGL_ASSET_LOADER.CPP", 104, "Failed to allocate asset requests!");
+        return FALSE;
+    }
+
+    for (int nLoop = 0; nLoop < nMaxRequests; nLoop++)
+    {
+        m_pRequests[nLoop].szFilename[0] = '\0';
+        m_pRequests[nLoop].pTexture      = NULL;
+        m_pRequests[nLoop].nState        = GS_ASSET_INVALID;
+        m_pRequests[nLoop].bIsUsed       = FALSE;
+        m_pRequests[nLoop].bIsReleased   = FALSE;
+    }
+
+    m_pJobSystem   = pJobSystem;
+    m_gsCounter    = 0;
+    m_nMaxRequests = nMaxRequests;
+    m_nNumRequests = 0;
+
+    m_nUploadBudget = nUploadBudget;
+
+    m_bIsReady = TRUE;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_AssetLoader::Destroy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Waits for the images being decoded and frees all requests. Textures that haven't
+//          been uploaded yet are left as they are. Destroy the asset loader before the job
+//          system.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_AssetLoader::Destroy()
+{
+
+    if (!m_bIsReady)
+    {
+        return;
+    }
+
+    // No worker may still be writing to a request.
+    if (m_pJobSystem)
+    {
+        m_pJobSystem->Wait(&m_gsCounter);
+    }
+
+    GS_SAFE_DELETE_ARRAY(m_pRequests);
+    m_nMaxRequests = 0;
+    m_nNumRequests = 0;
+
+    m_pJobSystem = NULL;
+    m_gsCounter  = 0;
+
+    m_bIsReady = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Load Methods. ///////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_AssetLoader::LoadTexture():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Starts loading the image file in the background. Once the image has been decoded
+//          Update() creates the texture from it with the specified type and filters, until
+//          then the texture is left as it is. The texture must exist until the request is done
+//          or has been released.
+// ---------------------------------------------------------------------------------------------
+// Returns: A handle to the request, -1 if the request couldn't be made.
+//==============================================================================================
+
+int GS_AssetLoader::LoadTexture(GS_OGLTexture* pTexture, const char* pszFilename,
+                                GS_TextureType gsTextureType, GLint glMinFilter,
+                                GLint glMagFilter)
+{
+
+    if (!m_bIsReady || !pTexture || !pszFilename)
+    {
+        return -1;
+    }
+
+    // Find a free request slot.
+    int nHandle = -1;
+
+    for (int nLoop = 0; nLoop < m_nMaxRequests; nLoop++)
+    {
+        if (!m_pRequests[nLoop].bIsUsed)
+        {
+            nHandle = nLoop;
+            break;
+        }
+    }
+
+    if (nHandle < 0)
+    {
+        GS_Error::Report("GS_OGL_ASSET_LOADER.CPP", 211, "Too many asset requests!");
+        return -1;
+    }
+
+    GS_AssetRequest* pRequest = &m_pRequests[nHandle];
+
+    strncpy(pRequest->szFilename, pszFilename, _MAX_PATH - 1);
+    pRequest->szFilename[_MAX_PATH - 1] = '\0';
+
+    pRequest->pTexture      = pTexture;
+    pRequest->gsTextureType = gsTextureType;
+    pRequest->glMinFilter   = glMinFilter;
+    pRequest->glMagFilter   = glMagFilter;
+    pRequest->nState        = GS_ASSET_LOADING;
+    pRequest->bIsUsed       = TRUE;
+    pRequest->bIsReleased   = FALSE;
+
+    m_nNumRequests++;
+
+    // Hand the request to a worker, everything it needs has been filled in.
+    if (m_pJobSystem)
+    {
+        m_pJobSystem->Dispatch(GS_AssetLoader::DecodeJob, pRequest, 1, 1, &m_gsCounter);
+    }
+    else
+    {
+        GS_AssetLoader::DecodeJob(pRequest, 0, 1);
+    }
+
+    return nHandle;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_AssetLoader::Release():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Frees the request so the handle can be reused, the texture itself is not destroyed.
+//          A texture that hasn't been uploaded yet never will be.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_AssetLoader::Release(int nHandle)
+{
+
+    if (!m_bIsReady || (nHandle < 0) || (nHandle >= m_nMaxRequests))
+    {
+        return;
+    }
+
+    GS_AssetRequest* pRequest = &m_pRequests[nHandle];
+
+    if (!pRequest->bIsUsed)
+    {
+        return;
+    }
+
+    // A worker is still decoding the image, have Update() free the request afterwards.
+    if (pRequest->nState.load(std::memory_order_acquire) == GS_ASSET_LOADING)
+    {
+        pRequest->bIsReleased = TRUE;
+        return;
+    }
+
+    this->FreeRequest(pRequest);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_AssetLoader::DecodeJob():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The job run by the workers, reads and decodes the image of a request.
+//          Every request is a job of its own, so the range of the job is not used.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_AssetLoader::DecodeJob(void* pData, int, int)
+{
+
+    GS_AssetRequest* pRequest = (GS_AssetRequest*) pData;
+
+    BOOL bResult = pRequest->gsImage.Load(pRequest->szFilename);
+
+    // Publish the image to the render thread.
+    pRequest->nState.store(bResult ? GS_ASSET_UPLOADING : GS_ASSET_FAILED,
+                           std::memory_order_release);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Upload Methods. /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_AssetLoader::Update():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Creates the textures of the decoded images, up to the upload budget per call. Call
+//          once per frame on the thread owning the OpenGL context. At least one texture is
+//          created per call, however large its image.
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of textures created.
+//==============================================================================================
+
+int GS_AssetLoader::Update()
+{
+
+    if (!m_bIsReady || (m_nNumRequests <= 0))
+    {
+        return 0;
+    }
+
+    // Without worker threads the images are only decoded while waiting for them.
+    if (m_pJobSystem && (m_pJobSystem->GetNumThreads() == 0))
+    {
+        m_pJobSystem->Wait(&m_gsCounter);
+    }
+
+    return this->UploadPending(m_nUploadBudget);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_AssetLoader::Finish():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Waits for all images to be decoded and creates all their textures, regardless of
+//          the upload budget. Useful behind a loading screen.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_AssetLoader::Finish()
+{
+
+    if (!m_bIsReady)
+    {
+        return;
+    }
+
+    if (m_pJobSystem)
+    {
+        m_pJobSystem->Wait(&m_gsCounter);
+    }
+
+    this->UploadPending(0);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_AssetLoader::UploadPending():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Creates the textures of decoded images in request order until nBudget bytes of image
+//          data have been uploaded (everything if nBudget is 0 or less), reports failed requests
+//          and frees released requests the workers are done with.
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of textures created.
+//==============================================================================================
+
+int GS_AssetLoader::UploadPending(int nBudget)
+{
+
+    int nNumUploaded = 0;
+    int nBytesLeft   = nBudget;
+
+    for (int nLoop = 0; nLoop < m_nMaxRequests; nLoop++)
+    {
+        GS_AssetRequest* pRequest = &m_pRequests[nLoop];
+
+        if (!pRequest->bIsUsed)
+        {
+            continue;
+        }
+
+        int nState = pRequest->nState.load(std::memory_order_acquire);
+
+        // Still being decoded?
+        if (nState == GS_ASSET_LOADING)
+        {
+            continue;
+        }
+
+        if (pRequest->bIsReleased)
+        {
+            this->FreeRequest(pRequest);
+            continue;
+        }
+
+        // Report a failed request once, the texture is no longer needed.
+        if ((nState == GS_ASSET_FAILED) && pRequest->pTexture)
+        {
+            GS_Error::Report("GS_OGL_ASSET_LOADER.CPP", 416, "Failed to load texture image!");
+            pRequest->pTexture = NULL;
+            continue;
+        }
+
+        if (nState != GS_ASSET_UPLOADING)
+        {
+            continue;
+        }
+
+        // Used up the budget for this frame?
+        if ((nBudget > 0) && (nBytesLeft <= 0))
+        {
+            break;
+        }
+
+        nBytesLeft -= pRequest->gsImage.GetWidth() * pRequest->gsImage.GetHeight() *
+                      pRequest->gsImage.GetColorBytes();
+
+        this->Upload(pRequest);
+
+        nNumUploaded++;
+    }
+
+    return nNumUploaded;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_AssetLoader::Upload():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Creates the texture of a request from its decoded image and frees the image.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if failed.
+//==============================================================================================
+
+BOOL GS_AssetLoader::Upload(GS_AssetRequest* pRequest)
+{
+
+    BOOL bResult = pRequest->pTexture->Create(&pRequest->gsImage, pRequest->gsTextureType,
+                                              pRequest->glMinFilter, pRequest->glMagFilter);
+
+    // The image is no longer needed once it has been uploaded.
+    pRequest->gsImage.Destroy();
+
+    pRequest->nState.store(bResult ? GS_ASSET_READY : GS_ASSET_FAILED, std::memory_order_release);
+
+    return bResult;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_AssetLoader::FreeRequest():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Frees a request that no worker is using.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_AssetLoader::FreeRequest(GS_AssetRequest* pRequest)
+{
+
+    pRequest->gsImage.Destroy();
+
+    pRequest->szFilename[0] = '\0';
+    pRequest->pTexture      = NULL;
+    pRequest->nState        = GS_ASSET_INVALID;
+    pRequest->bIsUsed       = FALSE;
+    pRequest->bIsReleased   = FALSE;
+
+    m_nNumRequests--;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Status Methods. /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_AssetLoader::GetState():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The state of the request, GS_ASSET_INVALID if the handle isn't in use.
+//==============================================================================================
+
+GS_AssetState GS_AssetLoader::GetState(int nHandle)
+{
+
+    if (!m_bIsReady || (nHandle < 0) || (nHandle >= m_nMaxRequests))
+    {
+        return GS_ASSET_INVALID;
+    }
+
+    GS_AssetRequest* pRequest = &m_pRequests[nHandle];
+
+    if (!pRequest->bIsUsed || pRequest->bIsReleased)
+    {
+        return GS_ASSET_INVALID;
+    }
+
+    return (GS_AssetState) pRequest->nState.load(std::memory_order_acquire);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_AssetLoader::IsDone():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the texture has been created or failed to load, FALSE if not.
+//==============================================================================================
+
+BOOL GS_AssetLoader::IsDone(int nHandle)
+{
+
+    GS_AssetState gsState = this->GetState(nHandle);
+
+    return ((gsState == GS_ASSET_READY) || (gsState == GS_ASSET_FAILED));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_AssetLoader::GetNumPending():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of requests being decoded or waiting to be uploaded.
+//==============================================================================================
+
+int GS_AssetLoader::GetNumPending()
+{
+
+    int nNumPending = 0;
+
+    for (int nLoop = 0; nLoop < m_nMaxRequests; nLoop++)
+    {
+        if (!m_pRequests[nLoop].bIsUsed || m_pRequests[nLoop].bIsReleased)
+        {
+            continue;
+        }
+
+        int nState = m_pRequests[nLoop].nState.load(std::memory_order_acquire);
+
+        if ((nState == GS_ASSET_LOADING) || (nState == GS_ASSET_UPLOADING))
+        {
+            nNumPending++;
+        }
+    }
+
+    return nNumPending;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_AssetLoader::SetUploadBudget():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the number of image bytes Update() uploads per call, 0 or less for no limit.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_AssetLoader::SetUploadBudget(int nUploadBudget)
+{
+
+    m_nUploadBudget = nUploadBudget;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_AssetLoader::GetUploadBudget():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of image bytes Update() uploads per call.
+//==============================================================================================
+
+int GS_AssetLoader::GetUploadBudget()
+{
+
+    return m_nUploadBudget;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_AssetLoader::IsReady():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the asset loader has been created, FALSE if not.
+//==============================================================================================
+
+BOOL GS_AssetLoader::IsReady()
+{
+
+    return m_bIsReady;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,145 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_asset_loader.cpp, gs_ogl_asset_loader.h                                      |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_AssetLoader                                                                      |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Loads textures in the background. Image files are read and decoded by the workers   |
+ |        of a job system, Update() then uploads the decoded images to OpenGL on the render   |
+ |        thread, a limited number of bytes per frame so that loading never causes a hitch.   |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+#ifndef GS_OGL_ASSET_LOADER_H
+#define GS_OGL_ASSET_LOADER_H
+
+
+//==============================================================================================
+// Include platform abstraction header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_platform.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include standard C++ library header files.
+// ---------------------------------------------------------------------------------------------
+#include <atomic>
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_error.h"
+#include "gs_job_system.h"
+#include "gs_object.h"
+#include "gs_ogl_image.h"
+#include "gs_ogl_texture.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Asset loader defines.
+// ---------------------------------------------------------------------------------------------
+#define GS_ASSET_MAX_REQUESTS  64            // Default number of requests that can be pending.
+#define GS_ASSET_UPLOAD_BUDGET (1024 * 1024) // Default number of image bytes uploaded per frame.
+//==============================================================================================
+
+
+//==============================================================================================
+// Asset request states.
+// ---------------------------------------------------------------------------------------------
+typedef enum GS_ASSET_STATE
+{
+    GS_ASSET_INVALID,   // The handle doesn't belong to a request.
+    GS_ASSET_LOADING,   // The image is being read and decoded by a worker.
+    GS_ASSET_UPLOADING, // The image has been decoded and waits for Update() to upload it.
+    GS_ASSET_READY,     // The texture has been created.
+    GS_ASSET_FAILED     // The image couldn't be loaded or the texture couldn't be created.
+} GS_AssetState;
+//==============================================================================================
+
+
+//==============================================================================================
+// Asset request structure.
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_ASSET_REQUEST
+{
+    char szFilename[_MAX_PATH];
+    GS_OGLTexture* pTexture;      // The texture to create, owned by the caller.
+    GS_TextureType gsTextureType;
+    GLint glMinFilter;
+    GLint glMagFilter;
+    GS_OGLImage gsImage;          // Written by the worker until the state leaves LOADING.
+    std::atomic<int> nState;      // A GS_AssetState.
+    BOOL bIsUsed;                 // Wether the request slot holds a request.
+    BOOL bIsReleased;             // Wether to free the slot as soon as the worker is done.
+} GS_AssetRequest;
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_AssetLoader : public GS_Object
+{
+
+private:
+
+    GS_JobSystem* m_pJobSystem; // The job system decoding the images.
+    GS_JobCounter m_gsCounter;  // Counts the decode jobs that haven't finished.
+
+    GS_AssetRequest* m_pRequests;
+    int m_nMaxRequests;
+    int m_nNumRequests; // Number of used request slots.
+
+    int m_nUploadBudget; // Number of image bytes to upload per frame.
+
+    BOOL m_bIsReady;
+
+    static void DecodeJob(void* pData, int nFirst, int nLast);
+
+    int  UploadPending(int nBudget);
+    BOOL Upload(GS_AssetRequest* pRequest);
+    void FreeRequest(GS_AssetRequest* pRequest);
+
+protected:
+
+    // No protected members.
+
+public:
+
+    GS_AssetLoader();
+    ~GS_AssetLoader();
+
+    BOOL Create(GS_JobSystem* pJobSystem, int nMaxRequests = GS_ASSET_MAX_REQUESTS,
+                int nUploadBudget = GS_ASSET_UPLOAD_BUDGET);
+    void Destroy();
+
+    int  LoadTexture(GS_OGLTexture* pTexture, const char* pszFilename,
+                     GS_TextureType gsTextureType = GS_MIPMAP, GLint glMinFilter = GL_LINEAR,
+                     GLint glMagFilter = GL_LINEAR);
+    void Release(int nHandle);
+
+    int  Update();
+    void Finish();
+
+    GS_AssetState GetState(int nHandle);
+    BOOL IsDone(int nHandle);
+    int  GetNumPending();
+
+    void SetUploadBudget(int nUploadBudget);
+    int  GetUploadBudget();
+
+    BOOL IsReady();
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
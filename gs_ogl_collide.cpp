@@ -334,4 +334,115 @@ BOOL GS_OGLCollide::IsRectOnRect(RECT rcSource, RECT rcDest, int nPercent)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLCollide::TestRectOnRects():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Tests the source rectangle against many rectangles the same way IsRectOnRect() does,
+//          using SIMD instructions to test several at a time. The rectangles are given as
+//          separate arrays of their edges. Bit n % 32 of pdwMask[n / 32] is set if rectangle n
+//          overlaps the source rectangle, so pdwMask must hold (nNumRects + 31) / 32 values.
+//          Rectangles are tested as they are, use SetRectPercentXY() to shrink them first.
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of rectangles overlapping the source rectangle.
+//==============================================================================================
+
+int GS_OGLCollide::TestRectOnRects(RECT rcSource, const int* pnLeft, const int* pnTop,
+                                   const int* pnRight, const int* pnBottom, int nNumRects,
+                                   DWORD* pdwMask)
+{
+
+    if ((nNumRects <= 0) || (!pnLeft) || (!pnTop) || (!pnRight) || (!pnBottom) || (!pdwMask))
+    {
+        return 0;
+    }
+
+    int nNumWords = (nNumRects + 31) / 32;
+
+    // Clear the mask, the bits of the overlapping rectangles are or'ed into it.
+    for (int nWord = 0; nWord < nNumWords; nWord++)
+    {
+        pdwMask[nWord] = 0;
+    }
+
+    int nRect = 0;
+
+#if defined(GS_SIMD_AVX2)
+    // Test 8 rectangles at a time. Each compare sets the lanes where it holds to all ones, the
+    // sign bits of the lanes where all four hold are then the mask bits of the rectangles.
+    const __m256i ymmLeft   = _mm256_set1_epi32((int) rcSource.left);
+    const __m256i ymmTop    = _mm256_set1_epi32((int) rcSource.top);
+    const __m256i ymmRight  = _mm256_set1_epi32((int) rcSource.right);
+    const __m256i ymmBottom = _mm256_set1_epi32((int) rcSource.bottom);
+
+    for (; (nRect + 8) <= nNumRects; nRect += 8)
+    {
+        __m256i ymmDestLeft   = _mm256_loadu_si256((const __m256i*) (pnLeft + nRect));
+        __m256i ymmDestTop    = _mm256_loadu_si256((const __m256i*) (pnTop + nRect));
+        __m256i ymmDestRight  = _mm256_loadu_si256((const __m256i*) (pnRight + nRect));
+        __m256i ymmDestBottom = _mm256_loadu_si256((const __m256i*) (pnBottom + nRect));
+
+        __m256i ymmOverlapY = _mm256_and_si256(_mm256_cmpgt_epi32(ymmTop, ymmDestBottom),
+                                               _mm256_cmpgt_epi32(ymmDestTop, ymmBottom));
+        __m256i ymmOverlapX = _mm256_and_si256(_mm256_cmpgt_epi32(ymmRight, ymmDestLeft),
+                                               _mm256_cmpgt_epi32(ymmDestRight, ymmLeft));
+        __m256i ymmOverlap  = _mm256_and_si256(ymmOverlapX, ymmOverlapY);
+
+        pdwMask[nRect / 32] |=
+            (DWORD) _mm256_movemask_ps(_mm256_castsi256_ps(ymmOverlap)) << (nRect % 32);
+    }
+#endif
+
+#if defined(GS_SIMD_SSE2)
+    // Test 4 rectangles at a time, or the last 4 that are left after testing 8 at a time.
+    const __m128i xmmLeft   = _mm_set1_epi32((int) rcSource.left);
+    const __m128i xmmTop    = _mm_set1_epi32((int) rcSource.top);
+    const __m128i xmmRight  = _mm_set1_epi32((int) rcSource.right);
+    const __m128i xmmBottom = _mm_set1_epi32((int) rcSource.bottom);
+
+    for (; (nRect + 4) <= nNumRects; nRect += 4)
+    {
+        __m128i xmmDestLeft   = _mm_loadu_si128((const __m128i*) (pnLeft + nRect));
+        __m128i xmmDestTop    = _mm_loadu_si128((const __m128i*) (pnTop + nRect));
+        __m128i xmmDestRight  = _mm_loadu_si128((const __m128i*) (pnRight + nRect));
+        __m128i xmmDestBottom = _mm_loadu_si128((const __m128i*) (pnBottom + nRect));
+
+        __m128i xmmOverlapY = _mm_and_si128(_mm_cmpgt_epi32(xmmTop, xmmDestBottom),
+                                            _mm_cmpgt_epi32(xmmDestTop, xmmBottom));
+        __m128i xmmOverlapX = _mm_and_si128(_mm_cmpgt_epi32(xmmRight, xmmDestLeft),
+                                            _mm_cmpgt_epi32(xmmDestRight, xmmLeft));
+        __m128i xmmOverlap  = _mm_and_si128(xmmOverlapX, xmmOverlapY);
+
+        pdwMask[nRect / 32] |=
+            (DWORD) _mm_movemask_ps(_mm_castsi128_ps(xmmOverlap)) << (nRect % 32);
+    }
+#endif
+
+    // Test the remaining rectangles one at a time.
+    for (; nRect < nNumRects; nRect++)
+    {
+        if ((rcSource.top > pnBottom[nRect]) && (rcSource.bottom < pnTop[nRect]) &&
+            (rcSource.right > pnLeft[nRect]) && (rcSource.left < pnRight[nRect]))
+        {
+            pdwMask[nRect / 32] |= (DWORD) 1 << (nRect % 32);
+        }
+    }
+
+    int nNumOverlaps = 0;
+
+    // Count the bits that are set, clearing the lowest one each time.
+    for (int nWord = 0; nWord < nNumWords; nWord++)
+    {
+        for (DWORD dwBits = pdwMask[nWord]; dwBits != 0; dwBits &= dwBits - 1)
+        {
+            nNumOverlaps++;
+        }
+    }
+
+    return nNumOverlaps;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -58,6 +58,9 @@ public:
 
     BOOL IsRectInRect(RECT rcSource, RECT rcDest, int nPercent = 0);
     BOOL IsRectOnRect(RECT rcSource, RECT rcDest, int nPercent = 0);
+
+    int TestRectOnRects(RECT rcSource, const int* pnLeft, const int* pnTop, const int* pnRight,
+                        const int* pnBottom, int nNumRects, DWORD* pdwMask);
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
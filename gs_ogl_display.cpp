@@ -42,6 +42,19 @@ GS_OGLDisplay::GS_OGLDisplay()
     m_bIsDepthTestEnabled = FALSE;
     m_bIsLightingEnabled  = FALSE;
 
+    m_bIsBatchingEnabled = FALSE;
+
+    m_nRenderWidth     = 0;
+    m_nRenderHeight    = 0;
+    m_bIsKeepingAspect = TRUE;
+    SetRect(&m_rcRenderArea, 0, 0, 0, 0);
+    m_nWindowWidth     = 0;
+    m_nWindowHeight    = 0;
+
+    m_bIsRenderTargetEnabled = FALSE;
+    m_bIsRenderingToTarget   = FALSE;
+    m_glRenderFilter         = GL_NEAREST;
+
     m_bIsReady = FALSE;
 
     g_fRenderModX = 0.0f;
@@ -190,21 +203,29 @@ BOOL GS_OGLDisplay::Create(SDL_Window* pWindow, int nWidth, int nHeight, int nDe
     // Display has been successfully created.
     m_bIsReady = TRUE;
 
+    // Objects created from now on share textures loaded from the same file.
+    m_gsTextureCache.Activate();
+
+    // Renderers change OpenGL state through our tracker, nothing is known about the new
+    // rendering context yet.
+    m_gsState.Invalidate();
+    m_gsState.Activate();
+
     // Set the perspective of the OpenGL screen.
     this->SetViewport(nWidth, nHeight, 45.0f);
 
     // Set OpenGL clear color to black.
-    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    m_gsState.ClearColor(0.0f, 0.0f, 0.0f, 0.0f);
     // Depth buffer setup.
     glClearDepth(1.0f);
 
     // Enable texture mapping.
-    glEnable(GL_TEXTURE_2D);
+    m_gsState.Enable(GL_TEXTURE_2D);
 
     // Draw front and back faces of polygons.
-    glDisable(GL_CULL_FACE);
+    m_gsState.Disable(GL_CULL_FACE);
     // Use depth testing.
-    glEnable(GL_DEPTH_TEST);
+    m_gsState.Enable(GL_DEPTH_TEST);
     // The type of depth testing to do.
     glDepthFunc(GL_LEQUAL);
     // Enable smooth shading.
@@ -235,6 +256,15 @@ GLvoid GS_OGLDisplay::Destroy()
         return;
     }
 
+    // Release the sprite batch, the render target and any textures still in the cache while
+    // the rendering context is still current.
+    m_gsSpriteBatch.Destroy();
+    m_gsRenderTarget.Destroy();
+    m_gsTextureCache.Destroy();
+
+    m_gsState.Activate(FALSE);
+    m_gsState.Invalidate();
+
 #ifdef GS_PLATFORM_WINDOWS
     if (m_hRC)
     {
@@ -263,6 +293,21 @@ GLvoid GS_OGLDisplay::Destroy()
     m_bIsDepthTestEnabled = FALSE;
     m_bIsLightingEnabled  = FALSE;
 
+    m_bIsBatchingEnabled = FALSE;
+
+    m_nRenderWidth     = 0;
+    m_nRenderHeight    = 0;
+    m_bIsKeepingAspect = TRUE;
+
+    m_bIsRenderTargetEnabled = FALSE;
+    m_bIsRenderingToTarget   = FALSE;
+    m_glRenderFilter         = GL_NEAREST;
+
+    g_fRenderModX   = 0.0f;
+    g_fRenderModY   = 0.0f;
+    g_fScaleFactorX = 1.0f;
+    g_fScaleFactorY = 1.0f;
+
     m_bIsReady = FALSE;
 }
 
@@ -354,7 +399,9 @@ GLvoid GS_OGLDisplay::EnableAliasing(BOOL bEnable, GLenum glType)
 //==============================================================================================
 // GS_OGLDisplay::EnableVSync():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Enables or disables vertical sync. Adaptive vertical sync is used where the driver
+//          supports it, so a frame that misses the vertical blank is shown straight away (with
+//          a tear) instead of waiting a whole refresh and halving the frame rate.
 // ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
@@ -369,7 +416,8 @@ GLvoid GS_OGLDisplay::EnableVSync(BOOL bEnable)
 
     if (bEnable)
     {
-        if (wglSwapIntervalEXT)
+        // A negative interval needs WGL_EXT_swap_control_tear.
+        if (wglSwapIntervalEXT && !wglSwapIntervalEXT(-1))
         {
             wglSwapIntervalEXT(1);
         }
@@ -382,7 +430,18 @@ GLvoid GS_OGLDisplay::EnableVSync(BOOL bEnable)
         }
     }
 #else
-    SDL_GL_SetSwapInterval(bEnable ? 1 : 0);
+    if (bEnable)
+    {
+        // Fall back on regular vertical sync without adaptive vertical sync.
+        if (SDL_GL_SetSwapInterval(-1) != 0)
+        {
+            SDL_GL_SetSwapInterval(1);
+        }
+    }
+    else
+    {
+        SDL_GL_SetSwapInterval(0);
+    }
 #endif
 
     m_bIsVSyncEnabled = bEnable;
@@ -407,13 +466,13 @@ GLvoid GS_OGLDisplay::EnableDepthTesting(BOOL bEnable, GLenum glType)
     if (bEnable)
     {
         // Enable depth testing and set type.
-        glEnable(GL_DEPTH_TEST);
+        m_gsState.Enable(GL_DEPTH_TEST);
         glDepthFunc(glType);
     }
     else
     {
         // Disable depth testing.
-        glDisable(GL_DEPTH_TEST);
+        m_gsState.Disable(GL_DEPTH_TEST);
     }
 }
 
@@ -436,13 +495,146 @@ GLvoid GS_OGLDisplay::EnableBlending(BOOL bEnable, GLenum glSourceFactor, GLenum
     if (bEnable)
     {
         // Set type of blending and enable it.
-        glBlendFunc(glSourceFactor, glDestFactor);
-        glEnable(GL_BLEND);
+        m_gsState.BlendFunc(glSourceFactor, glDestFactor);
+        m_gsState.Enable(GL_BLEND);
     }
     else
     {
         // Disable blending.
-        glDisable(GL_BLEND);
+        m_gsState.Disable(GL_BLEND);
+    }
+
+    // Let the active sprite batch know, sprites added from now on use the new blend state.
+    if (GS_SpriteBatch::GetActive() != NULL)
+    {
+        GS_SpriteBatch::GetActive()->SetBlendState(bEnable, glSourceFactor, glDestFactor);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLDisplay::EnableBatching():
+// ---------------------------------------------------------------------------------------------
+// Purpose: When enabled, every sprite rendered between BeginRender2D() and EndRender2D() is
+//          queued in a sprite batch and drawn with as few draw calls as possible when
+//          EndRender2D() is called (or earlier if something needs the queued sprites drawn).
+//          Sprites rendered with their own window handle are never batched.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLDisplay::EnableBatching(BOOL bEnable, int nSortMode)
+{
+
+    // Should we enable batching?
+    if (bEnable)
+    {
+        // Create the sprite batch the first time batching is enabled.
+        if (!m_gsSpriteBatch.IsReady())
+        {
+            if (!m_gsSpriteBatch.Create(GS_BATCH_DEFAULT_QUADS, nSortMode))
+            {
+                GS_Error::Report("GS_OGL_DISPLAY.CPP", 486, "Failed to create sprite batch!");
+                return FALSE;
+            }
+        }
+        else
+        {
+            m_gsSpriteBatch.SetSortMode(nSortMode);
+        }
+    }
+    else
+    {
+        // Draw anything still queued.
+        m_gsSpriteBatch.End();
+    }
+
+    m_bIsBatchingEnabled = bEnable;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLDisplay::SetRenderResolution():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the resolution 2D rendering is done at, whatever the size of the window. Every
+//          object is positioned and sized in render resolution pixels and the result is scaled
+//          to the window when EndRender2D() is called, letterboxed if the aspect ratio is kept.
+//          A width or height of 0 renders at the size of the client area (the default).
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GLvoid GS_OGLDisplay::SetRenderResolution(int nWidth, int nHeight, BOOL bKeepAspect)
+{
+
+    if ((nWidth <= 0) || (nHeight <= 0))
+    {
+        nWidth  = 0;
+        nHeight = 0;
+    }
+
+    m_nRenderWidth     = nWidth;
+    m_nRenderHeight    = nHeight;
+    m_bIsKeepingAspect = bKeepAspect;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLDisplay::EnableRenderTarget():
+// ---------------------------------------------------------------------------------------------
+// Purpose: When enabled, 2D rendering is drawn to an offscreen texture the size of the render
+//          resolution which is drawn to the window with the given filter (GL_NEAREST for sharp
+//          pixels, GL_LINEAR for smooth scaling) once EndRender2D() is called. Without a render
+//          target (or framebuffer support) the render resolution is scaled by the viewport.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GLvoid GS_OGLDisplay::EnableRenderTarget(BOOL bEnable, GLenum glFilter)
+{
+
+    // The target itself is created by BeginRender2D() once the render resolution is known.
+    if (!bEnable)
+    {
+        m_gsRenderTarget.Destroy();
+    }
+
+    m_bIsRenderTargetEnabled = bEnable;
+
+    this->SetRenderFilter(glFilter);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLDisplay::SetRenderFilter():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the filter the render target is scaled to the window with.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GLvoid GS_OGLDisplay::SetRenderFilter(GLenum glFilter)
+{
+
+    m_glRenderFilter = glFilter;
+
+    if (m_gsRenderTarget.IsReady())
+    {
+        m_gsRenderTarget.SetFilter(glFilter);
     }
 }
 
@@ -465,13 +657,13 @@ GLvoid GS_OGLDisplay::EnableLighting(BOOL bEnable, GLenum glLightNum)
     if (bEnable)
     {
         // Enable lighting and set type.
-        glEnable(GL_LIGHTING);
-        glEnable(glLightNum);
+        m_gsState.Enable(GL_LIGHTING);
+        m_gsState.Enable(glLightNum);
     }
     else
     {
         // Disable lighting.
-        glDisable(GL_LIGHTING);
+        m_gsState.Disable(GL_LIGHTING);
     }
 }
 
@@ -607,6 +799,7 @@ GLvoid GS_OGLDisplay::EndRender(HDC& hDC)
     {
         return;
     }
+    GS_PROFILE_SCOPE("EndRender");
     SwapBuffers(hDC);
 }
 #else
@@ -616,6 +809,7 @@ GLvoid GS_OGLDisplay::EndRender(SDL_Window* pWindow)
     {
         return;
     }
+    GS_PROFILE_SCOPE("EndRender");
     SDL_GL_SwapWindow(pWindow);
 }
 #endif
@@ -639,58 +833,15 @@ BOOL GS_OGLDisplay::BeginRender2D(HWND& hWnd)
         return FALSE;
     }
 
-    RECT ClientRect;
-
 #ifdef GS_PLATFORM_WINDOWS
+    RECT ClientRect;
     GetClientRect(hWnd, &ClientRect);
+
+    return this->BeginRender2D(ClientRect.right - ClientRect.left,
+                               ClientRect.bottom - ClientRect.top);
 #else
-    GS_Platform::GetClientRect(hWnd, &ClientRect);
+    return this->BeginRender2D((void*) hWnd);
 #endif
-
-    // Disable depth testing if enabled.
-    if (glIsEnabled(GL_DEPTH_TEST) == GL_TRUE)
-    {
-        glDisable(GL_DEPTH_TEST);
-        m_bIsDepthTestEnabled = TRUE;
-    }
-    else
-    {
-        m_bIsDepthTestEnabled = FALSE;
-    }
-
-    // Disable lighting if enabled.
-    if (glIsEnabled(GL_LIGHTING) == GL_TRUE)
-    {
-        glDisable(GL_LIGHTING);
-        m_bIsLightingEnabled = TRUE;
-    }
-    else
-    {
-        m_bIsLightingEnabled = FALSE;
-    }
-
-    glMatrixMode(GL_PROJECTION); // Select the projection matrix.
-    glPushMatrix();              // Store the projection matrix.
-    glLoadIdentity();            // Reset the projection matrix.
-
-    // Set up an ortho screen with the same dimensions as the client area of the current
-    // window and with a depth large enough to rotate the entire screen around either
-    // the x or y axis.
-    if (ClientRect.right >= ClientRect.top)
-    {
-        glOrtho(0,ClientRect.right,0,ClientRect.bottom,-((ClientRect.right-ClientRect.left)/2),
-                ((ClientRect.right-ClientRect.left)/2));
-    }
-    else
-    {
-        glOrtho(0,ClientRect.right,0,ClientRect.bottom,-((ClientRect.top-ClientRect.bottom)/2),
-                ((ClientRect.top-ClientRect.bottom)/2));
-    }
-
-    glMatrixMode(GL_MODELVIEW); // Select the modelview matrix.
-    glPushMatrix();             // Store the modelview matrix.
-
-    return TRUE;
 }
 
 
@@ -707,12 +858,56 @@ BOOL GS_OGLDisplay::BeginRender2D(HWND& hWnd)
 
 BOOL GS_OGLDisplay::EndRender2D()
 {
+    GS_PROFILE_SCOPE("EndRender2D");
+
+    // Draw all batched sprites before the 2D projection is removed.
+    m_gsSpriteBatch.End();
+
+    // Leave no texture selected and the color white for code drawing without the renderers.
+    m_gsState.Reset();
+
     glMatrixMode(GL_PROJECTION);
     glPopMatrix();
     
     glMatrixMode(GL_MODELVIEW);
     glPopMatrix();
-    
+
+    // Nothing more to do if rendering was done at the size of the window.
+    if ((m_nRenderWidth <= 0) || (m_nRenderHeight <= 0))
+    {
+        return TRUE;
+    }
+
+    // Everything else is drawn to the entire window again.
+    if (m_bIsRenderingToTarget)
+    {
+        m_gsRenderTarget.End();
+        m_bIsRenderingToTarget = FALSE;
+    }
+
+    glViewport(0, 0, m_nWindowWidth, m_nWindowHeight);
+
+    // Draw the render target over the window, the only scaling done for the entire frame.
+    if (m_gsRenderTarget.IsReady())
+    {
+        glMatrixMode(GL_PROJECTION);
+        glPushMatrix();
+        glLoadIdentity();
+        glOrtho(0, m_nWindowWidth, 0, m_nWindowHeight, -1, 1);
+
+        glMatrixMode(GL_MODELVIEW);
+        glPushMatrix();
+        glLoadIdentity();
+
+        m_gsRenderTarget.Draw(m_rcRenderArea);
+
+        glMatrixMode(GL_PROJECTION);
+        glPopMatrix();
+
+        glMatrixMode(GL_MODELVIEW);
+        glPopMatrix();
+    }
+
     return TRUE;
 }
 
@@ -729,10 +924,40 @@ BOOL GS_OGLDisplay::BeginRender2D(void* pWindow)
 
     GS_Platform::GetClientRect(pWindow, &ClientRect);
 
+    // The window may have more pixels than its size suggests on high DPI displays.
+    int nWidth  = (int) (ClientRect.right - ClientRect.left);
+    int nHeight = (int) (ClientRect.bottom - ClientRect.top);
+
+    if (pWindow != NULL)
+    {
+        SDL_GL_GetDrawableSize((SDL_Window*) pWindow, &nWidth, &nHeight);
+    }
+
+    return this->BeginRender2D(nWidth, nHeight);
+}
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLDisplay::BeginRender2D():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets up 2D rendering for a window of the given size in pixels. If a render
+//          resolution was set, it is letterboxed in the window and drawn either to the render
+//          target or, without one, straight to the window through a scaled viewport.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLDisplay::BeginRender2D(int nWidth, int nHeight)
+{
+
     // Disable depth testing if enabled.
-    if (glIsEnabled(GL_DEPTH_TEST) == GL_TRUE)
+    if (m_gsState.IsEnabled(GL_DEPTH_TEST))
     {
-        glDisable(GL_DEPTH_TEST);
+        m_gsState.Disable(GL_DEPTH_TEST);
         m_bIsDepthTestEnabled = TRUE;
     }
     else
@@ -741,9 +966,9 @@ BOOL GS_OGLDisplay::BeginRender2D(void* pWindow)
     }
 
     // Disable lighting if enabled.
-    if (glIsEnabled(GL_LIGHTING) == GL_TRUE)
+    if (m_gsState.IsEnabled(GL_LIGHTING))
     {
-        glDisable(GL_LIGHTING);
+        m_gsState.Disable(GL_LIGHTING);
         m_bIsLightingEnabled = TRUE;
     }
     else
@@ -751,27 +976,109 @@ BOOL GS_OGLDisplay::BeginRender2D(void* pWindow)
         m_bIsLightingEnabled = FALSE;
     }
 
+    m_nWindowWidth  = nWidth;
+    m_nWindowHeight = nHeight;
+
+    // Is 2D rendering done at a resolution of its own?
+    if ((m_nRenderWidth > 0) && (m_nRenderHeight > 0))
+    {
+        // Determine where the render resolution ends up in the window.
+        int nAreaWidth  = nWidth;
+        int nAreaHeight = nHeight;
+
+        if (m_bIsKeepingAspect)
+        {
+            float fScale = (float) nWidth / (float) m_nRenderWidth;
+
+            if (((float) nHeight / (float) m_nRenderHeight) < fScale)
+            {
+                fScale = (float) nHeight / (float) m_nRenderHeight;
+            }
+
+            nAreaWidth  = (int) ((m_nRenderWidth  * fScale) + 0.5f);
+            nAreaHeight = (int) ((m_nRenderHeight * fScale) + 0.5f);
+        }
+
+        SetRect(&m_rcRenderArea, (nWidth - nAreaWidth) / 2,
+                ((nHeight - nAreaHeight) / 2) + nAreaHeight,
+                ((nWidth - nAreaWidth) / 2) + nAreaWidth, (nHeight - nAreaHeight) / 2);
+
+        // (Re)create the render target if the render resolution has changed, and stop trying
+        // if framebuffers turn out not to be supported.
+        if (m_bIsRenderTargetEnabled && ((!m_gsRenderTarget.IsReady()) ||
+            (m_gsRenderTarget.GetWidth() != m_nRenderWidth) ||
+            (m_gsRenderTarget.GetHeight() != m_nRenderHeight)))
+        {
+            if ((!GS_OGLRenderTarget::IsSupported()) ||
+                (!m_gsRenderTarget.Create(m_nRenderWidth, m_nRenderHeight, m_glRenderFilter)))
+            {
+                m_bIsRenderTargetEnabled = FALSE;
+            }
+        }
+
+        if (m_bIsRenderTargetEnabled && m_gsRenderTarget.Begin())
+        {
+            glViewport(0, 0, m_nRenderWidth, m_nRenderHeight);
+
+            // Start with a transparent target so only what is drawn covers the window.
+            GLfloat glfClearColor[4];
+            m_gsState.GetClearColor(glfClearColor);
+            m_gsState.ClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            m_gsState.ClearColor(glfClearColor[0], glfClearColor[1], glfClearColor[2],
+                                 glfClearColor[3]);
+
+            // The target is the size of the render resolution, so no scissor box is scaled.
+            g_fScaleFactorX = 1.0f;
+            g_fScaleFactorY = 1.0f;
+            g_fRenderModX   = 0.0f;
+            g_fRenderModY   = 0.0f;
+
+            m_bIsRenderingToTarget = TRUE;
+        }
+        else
+        {
+            glViewport(m_rcRenderArea.left, m_rcRenderArea.bottom, nAreaWidth, nAreaHeight);
+
+            // The viewport scales the rendering, but scissor boxes are still in window pixels.
+            g_fScaleFactorX = (float) nAreaWidth  / (float) m_nRenderWidth;
+            g_fScaleFactorY = (float) nAreaHeight / (float) m_nRenderHeight;
+            g_fRenderModX   = (float) m_rcRenderArea.left;
+            g_fRenderModY   = (float) m_rcRenderArea.bottom;
+        }
+
+        nWidth  = m_nRenderWidth;
+        nHeight = m_nRenderHeight;
+    }
+
     glMatrixMode(GL_PROJECTION); // Select the projection matrix.
     glPushMatrix();              // Store the projection matrix.
     glLoadIdentity();            // Reset the projection matrix.
 
-    // Set up an ortho screen with the same dimensions as the client area of the current
-    // window and with a depth large enough to rotate the entire screen around either
-    // the x or y axis.
-    if (ClientRect.right >= ClientRect.top)
+    // Set up an ortho screen with the same dimensions as the render resolution (the client area
+    // of the window unless set) and with a depth large enough to rotate the entire screen
+    // around either the x or y axis.
+    if (nWidth >= nHeight)
     {
-        glOrtho(0,ClientRect.right,0,ClientRect.bottom,-((ClientRect.right-ClientRect.left)/2),
-                ((ClientRect.right-ClientRect.left)/2));
+        glOrtho(0, nWidth, 0, nHeight, -(nWidth / 2), (nWidth / 2));
     }
     else
     {
-        glOrtho(0,ClientRect.right,0,ClientRect.bottom,-((ClientRect.top-ClientRect.bottom)/2),
-                ((ClientRect.top-ClientRect.bottom)/2));
+        glOrtho(0, nWidth, 0, nHeight, -(nHeight / 2), (nHeight / 2));
     }
 
     glMatrixMode(GL_MODELVIEW); // Select the modelview matrix.
     glPushMatrix();             // Store the modelview matrix.
-    
+
+    // The texture and color may have been changed directly since the last 2D rendering.
+    m_gsState.InvalidateTexture();
+    m_gsState.InvalidateColor();
+
+    // Start collecting sprite draws if batching is enabled.
+    if (m_bIsBatchingEnabled)
+    {
+        m_gsSpriteBatch.Begin();
+    }
+
     return TRUE;
 }
-#endif
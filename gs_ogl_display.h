@@ -39,13 +39,17 @@
 // ---------------------------------------------------------------------------------------------
 #include "gs_error.h"
 #include "gs_object.h"
+#include "gs_ogl_render_target.h"
+#include "gs_profiler.h"
+#include "gs_ogl_sprite_batch.h"
+#include "gs_ogl_state.h"
+#include "gs_ogl_texture_cache.h"
 //==============================================================================================
 
 
 //==============================================================================================
-// Global variables for adjusting the scale factor of sprites allowing upscaling and downscaling
-// without affecting the game mechanics in any way. These variable will be declared and used in
-// the gs_ogl_sprite.cpp file
+// Global variables mapping the render resolution to window pixels, set by BeginRender2D() and
+// used to place scissor boxes. These variable will be declared in the gs_ogl_sprite.cpp file.
 // ---------------------------------------------------------------------------------------------
 extern float g_fRenderModX;
 extern float g_fRenderModY;
@@ -77,6 +81,27 @@ private:
     BOOL m_bIsDepthTestEnabled; // Wether depth testing is enabled (for 2D rendering).
     BOOL m_bIsLightingEnabled;  // Wether lighting is enabled (for 2D rendering).
 
+    GS_SpriteBatch m_gsSpriteBatch; // Batches sprite draws between BeginRender2D/EndRender2D.
+    BOOL m_bIsBatchingEnabled;      // Wether sprite batching is enabled.
+
+    GS_TextureCache m_gsTextureCache; // Shares textures loaded from the same file.
+
+    GS_OGLState m_gsState; // Skips OpenGL state changes that would not change anything.
+
+    int  m_nRenderWidth;  // The resolution 2D rendering is done at, 0 for the client area.
+    int  m_nRenderHeight;
+    BOOL m_bIsKeepingAspect; // Wether the render resolution is letterboxed in the window.
+    RECT m_rcRenderArea;     // Where the render resolution ends up in the window (pixels).
+    int  m_nWindowWidth;     // The size of the window during the current 2D rendering.
+    int  m_nWindowHeight;
+
+    GS_OGLRenderTarget m_gsRenderTarget; // 2D rendering is drawn here and scaled once.
+    BOOL   m_bIsRenderTargetEnabled;     // Wether 2D rendering goes through the target.
+    BOOL   m_bIsRenderingToTarget;       // Wether the current 2D rendering does.
+    GLenum m_glRenderFilter;             // The filter the target is scaled with.
+
+    BOOL BeginRender2D(int nWidth, int nHeight);
+
     BOOL m_bIsReady;      // Wether OpenGL display is ready or not.
 
 protected:
@@ -103,6 +128,11 @@ public:
     GLvoid EnableBlending(BOOL bEnable = TRUE, GLenum glSourceFactor = GL_SRC_ALPHA,
                           GLenum glDestFactor = GL_ONE_MINUS_SRC_ALPHA);
     GLvoid EnableLighting(BOOL bEnable = TRUE, GLenum glLightNum = GL_LIGHT1);
+    BOOL   EnableBatching(BOOL bEnable = TRUE, int nSortMode = GS_BATCH_ORDERED);
+
+    GLvoid SetRenderResolution(int nWidth, int nHeight, BOOL bKeepAspect = TRUE);
+    GLvoid EnableRenderTarget(BOOL bEnable = TRUE, GLenum glFilter = GL_NEAREST);
+    GLvoid SetRenderFilter(GLenum glFilter);
 
     GLvoid SetLightAmbient( GLfloat fRed, GLfloat fGreen, GLfloat fBlue, GLfloat fAlpha,
                             GLenum glLightNum = GL_LIGHT1);
@@ -142,20 +172,48 @@ public:
         return m_bIsVSyncEnabled;
     }
 
+    BOOL IsBatchingEnabled()
+    {
+        return m_bIsBatchingEnabled;
+    }
+    GS_SpriteBatch* GetSpriteBatch()
+    {
+        return &m_gsSpriteBatch;
+    }
+
+    GS_OGLState* GetState()
+    {
+        return &m_gsState;
+    }
+
+    int GetRenderWidth()
+    {
+        return m_nRenderWidth;
+    }
+    int GetRenderHeight()
+    {
+        return m_nRenderHeight;
+    }
+    BOOL IsRenderTargetEnabled()
+    {
+        return m_bIsRenderTargetEnabled;
+    }
+
     BOOL IsBlendingEnabled()
     {
-        return glIsEnabled(GL_BLEND);
+        return m_gsState.IsEnabled(GL_BLEND);
     }
     BOOL IsLightingEnabled()
     {
-        return glIsEnabled(GL_LIGHTING);
+        return m_gsState.IsEnabled(GL_LIGHTING);
     }
     BOOL IsDepthTestingEnabled()
     {
-        return glIsEnabled(GL_DEPTH_TEST);
+        return m_gsState.IsEnabled(GL_DEPTH_TEST);
     }
 
-    // Static functions for ajusting the scale factor
+    // Static functions for ajusting the scale factor. BeginRender2D() sets these to map the
+    // render resolution to window pixels, renderers only use them to place scissor boxes.
     static float GetScaleFactorX() { return g_fScaleFactorX; }
     static void SetScaleFactorX(float fScaleFactorX)
     {
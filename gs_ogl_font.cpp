@@ -15,6 +15,7 @@
 // Include Game System (GS) header files.
 // ---------------------------------------------------------------------------------------------
 #include "gs_ogl_font.h"
+#include "gs_ogl_state.h"
 //==============================================================================================
 
 
@@ -35,10 +36,20 @@ GS_OGLFont::GS_OGLFont() : GS_OGLSprite()
 {
 
     m_pszTextString = NULL;
+    m_nTextLength   = 0;
+    m_nNumLines     = 1;
+    m_nLongestLine  = 0;
 
     m_nCharsPerLine = 0;
     m_nLetterWidth  = 0;
     m_nLetterHeight = 0;
+
+    m_pGlyphQuads    = NULL;
+    m_nNumGlyphQuads = 0;
+    m_nMaxGlyphQuads = 0;
+
+    ZeroMemory(&m_gsLayout, sizeof(GS_FontLayout));
+    m_bIsLayoutValid = FALSE;
 }
 
 
@@ -92,6 +103,8 @@ BOOL GS_OGLFont::Create(const char* pszPathname, int nCharsPerLine, int nLetterW
     m_nLetterWidth  = nLetterWidth;
     m_nLetterHeight = nLetterHeight;
 
+    m_bIsLayoutValid = FALSE;
+
     // Create the sprite containing the font characters.
     return GS_OGLSprite::Create(pszPathname, bFiltered, bMipmap);
 }
@@ -120,6 +133,8 @@ BOOL GS_OGLFont::Create(GLuint glTexture, int nWidth, int nHeight, int nCharsPer
     m_nLetterWidth  = nLetterWidth;
     m_nLetterHeight = nLetterHeight;
 
+    m_bIsLayoutValid = FALSE;
+
     // Create the sprite containing the font characters.
     return GS_OGLSprite::Create(glTexture, nWidth, nHeight);
 }
@@ -151,10 +166,19 @@ void GS_OGLFont::Destroy()
         delete [] m_pszTextString;
     }
     m_pszTextString = NULL;
+    m_nTextLength   = 0;
+    m_nNumLines     = 1;
+    m_nLongestLine  = 0;
 
     m_nCharsPerLine = 0;
     m_nLetterWidth  = 0;
     m_nLetterHeight = 0;
+
+    GS_SAFE_DELETE_ARRAY(m_pGlyphQuads);
+    m_nNumGlyphQuads = 0;
+    m_nMaxGlyphQuads = 0;
+
+    m_bIsLayoutValid = FALSE;
 }
 
 
@@ -169,10 +193,10 @@ void GS_OGLFont::Destroy()
 //==============================================================================================
 // GS_OGLFont::Render():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
-// ---------------------------------------------------------------------------------------------
-// Notes: For the calculation to be correct, this method assumes that the source image of the
-//        font begins at the coordinate (0, 0) on the texture surface.
+// Purpose: Renders the text string with a single draw call (or as a single run of quads if a
+//          sprite batch is collecting draws). The quads are only laid out again when the text
+//          or any of the font settings they depend on have changed since the last call. Each
+//          '\n' in the text starts a new line below the previous one.
 // ---------------------------------------------------------------------------------------------
 // Returns: TRUE if successfull, FALSE if not.
 //==============================================================================================
@@ -186,34 +210,80 @@ BOOL GS_OGLFont::Render(HWND hWnd)
         return FALSE;
     }
 
-    BOOL bResult;
+    // Nothing to render?
+    if ((NULL == m_pszTextString) || (m_nTextLength == 0))
+    {
+        return TRUE;
+    }
 
-    // Store the original (x ,y) starting position.
-    GLint gliStartX = GS_OGLSprite::GetDestX();
-    GLint gliStartY = GS_OGLSprite::GetDestY();
+    // Is a sprite batch collecting draws (see GS_OGLSprite::Render())?
+    GS_SpriteBatch* pBatch = GS_SpriteBatch::GetActive();
 
-    // For each character in the string to be rendered.
-    for (int nLoop=0; nLoop<(int)(lstrlen(m_pszTextString)); nLoop++)
+    // Setup display for 2D rendering.
+    if (hWnd != NULL)
     {
-        // Find and render the current character from the text string.
-        bResult = RenderChar(m_pszTextString[nLoop], hWnd);
-        // Was rendering character successfull?
-        if (!bResult)
+        GS_SpriteBatch::FlushActive();
+        pBatch = NULL;
+        this->BeginRender(hWnd);
+    }
+
+    GS_FontLayout gsLayout;
+    this->GetLayout(&gsLayout);
+
+    // Lay the text out again if anything affecting the quads has changed.
+    if ((!m_bIsLayoutValid) || (memcmp(&gsLayout, &m_gsLayout, sizeof(GS_FontLayout)) != 0))
+    {
+        if (!this->LayoutText(&gsLayout))
         {
-            GS_Error::Report("GS_OGL_FONT.CPP", 190, "Failed to render character to surface!");
-            // Restore the original (x ,y) starting position.
-            GS_OGLSprite::SetDestX(gliStartX);
-            GS_OGLSprite::SetDestY(gliStartY);
+            GS_Error::Report("GS_OGL_FONT.CPP", 237, "Failed to lay out text!");
+
+            if (hWnd != NULL)
+            {
+                this->EndRender();
+            }
+
             return FALSE;
         }
-        // Shift the target X location to the right by the pixel width of each letter. If we
-        // don't do this, we'll be drawing each letter directly on top of the previous.
-        GS_OGLSprite::AddDestX(int(this->GetLetterWidth()));
     }
 
-    // Restore the original (x ,y) starting position.
-    GS_OGLSprite::SetDestX(gliStartX);
-    GS_OGLSprite::SetDestY(gliStartY);
+    // Queue the quads if a batch is collecting draws.
+    if (pBatch != NULL)
+    {
+        pBatch->AddQuads(GS_OGLSprite::GetTextureID(), m_nNumGlyphQuads, m_pGlyphQuads);
+    }
+    else if (m_nNumGlyphQuads > 0)
+    {
+        // Reset the modelview matrix.
+        glLoadIdentity();
+
+        // Select the font texture.
+        GS_OGLState::GetActive()->BindTexture(GS_OGLSprite::GetTextureID());
+
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glEnableClientState(GL_VERTEX_ARRAY);
+
+        glTexCoordPointer(2, GL_FLOAT, sizeof(GS_BatchVertex), &m_pGlyphQuads[0].fTexU);
+        glColorPointer(4, GL_FLOAT, sizeof(GS_BatchVertex), &m_pGlyphQuads[0].fRed);
+        glVertexPointer(3, GL_FLOAT, sizeof(GS_BatchVertex), &m_pGlyphQuads[0].fX);
+
+        // Draw the whole string at once.
+        glDrawArrays(GL_QUADS, 0, m_nNumGlyphQuads * 4);
+        GS_Profiler::CountDrawCall(m_nNumGlyphQuads * 4);
+
+        glDisableClientState(GL_VERTEX_ARRAY);
+        glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+
+        // Drawing from a color array leaves the current color undefined.
+        GS_OGLState::GetActive()->InvalidateColor();
+    }
+
+    // Reset display after 2D rendering.
+    if (hWnd != NULL)
+    {
+        this->EndRender();
+    }
 
     return TRUE;
 }
@@ -222,71 +292,200 @@ BOOL GS_OGLFont::Render(HWND hWnd)
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
-/*
-BOOL GS_OGLFont::Render(HWND hWnd) {
-
-   // Can't render if no valid sprite.
-   if (!GS_OGLSprite::IsReady()) {
-      return FALSE;
-      }
-
-   char cTextChar;
-   int nLoop;
-   int nXoffset, nYoffset; // The x,y top left location of the character image.
-   GS_OGLColor gsColor;
-   this->GetModulateColor(&gsColor);
-
-   // Store the original (x ,y) starting position.
-   GLint gliStartX = GS_OGLSprite::GetDestX();
-   GLint gliStartY = GS_OGLSprite::GetDestY();
-
-   // For each character in the string to be rendered.
-   for (nLoop=0; nLoop<(int)(lstrlen(m_pszTextString)); nLoop++) {
-      // Find and render the current character from the text string.
-      // bResult = RenderChar(m_pszTextString[nLoop], hWnd);
-      // We are allowing ascii characters from space (32) to ~ (126). As the 1st char on our
-      // image surface is a space, we can subtract 32 from the ascii value of the character we
-      // want to render. This gives us a zero based index.
-      cTextChar = char(m_pszTextString[nLoop] - 32);
-      // Check wether character is within minimum bounds.
-      if (cTextChar < 0) {
-         cTextChar = 0;
-         }
-      // Use the remainder to determine the horizontal offset of the letter.
-      nXoffset = (cTextChar%m_nCharsPerLine) * m_nLetterWidth;
-      // Use the quotient to determine the vertical offset of the letter starting from the top
-      // of the image and working towards the bottom.
-      nYoffset = this->GetTextureHeight() - (((cTextChar - (cTextChar%m_nCharsPerLine)) /
-                 m_nCharsPerLine) * m_nLetterHeight);
-      // Set the target to the specified letter.
-      m_gsTargets[nLoop].nDestX     = gliStartX;
-      m_gsTargets[nLoop].nDestY     = gliStartY;
-      m_gsTargets[nLoop].nSrcLeft   = nXoffset;
-      m_gsTargets[nLoop].nSrcTop    = nYoffset;
-      m_gsTargets[nLoop].nSrcRight  = nXoffset + m_nLetterWidth;
-      m_gsTargets[nLoop].nSrcBottom = nYoffset - m_nLetterHeight;
-      m_gsTargets[nLoop].fScaleX  = this->GetScaleX();
-      m_gsTargets[nLoop].fScaleY  = this->GetScaleY();
-      m_gsTargets[nLoop].fRotateX = this->GetRotateX();
-      m_gsTargets[nLoop].fRotateY = this->GetRotateY();
-      m_gsTargets[nLoop].fRotateZ = this->GetRotateZ();
-      m_gsTargets[nLoop].fRed     = gsColor.fRed;
-      m_gsTargets[nLoop].fGreen   = gsColor.fGreen;
-      m_gsTargets[nLoop].fBlue    = gsColor.fBlue;
-      m_gsTargets[nLoop].fAlpha   = gsColor.fAlpha;
-      m_gsTargets[nLoop].fScrollX = this->GetScrollX();
-      m_gsTargets[nLoop].fScrollY = this->GetScrollY();
-      // Shift the target X location to the right by the pixel width of each letter. If we
-      // don't do this, we'll be drawing each letter directly on top of the previous.
-      gliStartX += this->GetLetterWidth();
-      }
-
-   // Render all the letters at once.
-   this->RenderTargets(nLoop, m_gsTargets, hWnd);
-
-   return TRUE;
+//==============================================================================================
+// GS_OGLFont::LayoutText():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Builds a quad for every character of the text string, placing and rotating each
+//          character the same way rendering it with RenderChar() would.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLFont::LayoutText(GS_FontLayout* pgsLayout)
+{
+
+    if ((m_nCharsPerLine <= 0) || (GS_OGLSprite::GetTextureWidth() <= 0) ||
+        (GS_OGLSprite::GetTextureHeight() <= 0))
+    {
+        return FALSE;
+    }
+
+    // Make room for a quad per character if needed.
+    if (m_nTextLength > m_nMaxGlyphQuads)
+    {
+        GS_BatchVertex* pGlyphQuads = new GS_BatchVertex[m_nTextLength * 4];
+
+        if (NULL == pGlyphQuads)
+        {
+            return FALSE;
+        }
+
+        GS_SAFE_DELETE_ARRAY(m_pGlyphQuads);
+        m_pGlyphQuads    = pGlyphQuads;
+        m_nMaxGlyphQuads = m_nTextLength;
+    }
+
+    // The characters are relative to the image, which is only part of the texture if the font
+    // was created from a texture atlas.
+    RECT ImageRect;
+    GS_OGLSprite::GetImageRect(&ImageRect);
+
+    GLfloat fTexWidth  = (GLfloat) GS_OGLSprite::GetTextureWidth();
+    GLfloat fTexHeight = (GLfloat) GS_OGLSprite::GetTextureHeight();
+
+    GLfloat glfScaleX = pgsLayout->fScaleX;
+    GLfloat glfScaleY = pgsLayout->fScaleY;
+
+    // Every character rotates around its own rotation point, the center unless one was set.
+    int nRotationPointX = m_nLetterWidth  / 2;
+    int nRotationPointY = m_nLetterHeight / 2;
+
+    if (pgsLayout->gliRotationPointX >= 0)
+    {
+        nRotationPointX = pgsLayout->gliRotationPointX;
+    }
+
+    if (pgsLayout->gliRotationPointY >= 0)
+    {
+        nRotationPointY = pgsLayout->gliRotationPointY;
+    }
+
+    // The corners of every character relative to its rotation point, in the same order as
+    // GS_OGLSprite::Render() draws them.
+    GLfloat fLeft   = -nRotationPointX * glfScaleX;
+    GLfloat fBottom = -nRotationPointY * glfScaleY;
+    GLfloat fRight  = (m_nLetterWidth  - nRotationPointX) * glfScaleX;
+    GLfloat fTop    = (m_nLetterHeight - nRotationPointY) * glfScaleY;
+
+    GLfloat fCornerX[4] = { fLeft,   fRight,  fRight, fLeft };
+    GLfloat fCornerY[4] = { fBottom, fBottom, fTop,   fTop  };
+
+    // The first two columns of the rotation matrix (X * Y * Z), shared by all characters.
+    GLfloat fXx = 1.0f, fXy = 0.0f, fXz = 0.0f;
+    GLfloat fYx = 0.0f, fYy = 1.0f, fYz = 0.0f;
+
+    if ((pgsLayout->fRotateX != 0.0f) || (pgsLayout->fRotateY != 0.0f) ||
+        (pgsLayout->fRotateZ != 0.0f))
+    {
+        GLfloat fSinX = GS_Sin(pgsLayout->fRotateX), fCosX = GS_Cos(pgsLayout->fRotateX);
+        GLfloat fSinY = GS_Sin(pgsLayout->fRotateY), fCosY = GS_Cos(pgsLayout->fRotateY);
+        GLfloat fSinZ = GS_Sin(pgsLayout->fRotateZ), fCosZ = GS_Cos(pgsLayout->fRotateZ);
+
+        fXx = fCosZ * fCosY;
+        fXy = fSinZ * fCosX + fCosZ * fSinY * fSinX;
+        fXz = fSinZ * fSinX - fCosZ * fSinY * fCosX;
+
+        fYx = -fSinZ * fCosY;
+        fYy =  fCosZ * fCosX - fSinZ * fSinY * fSinX;
+        fYz =  fCosZ * fSinX + fSinZ * fSinY * fCosX;
+    }
+
+    // The distance between characters and lines (in unscaled screen pixels).
+    int nAdvanceX = int(this->GetLetterWidth());
+    int nAdvanceY = int(this->GetLetterHeight());
+
+    GS_BatchVertex* pVertex = m_pGlyphQuads;
+    int nNumQuads = 0;
+    int nColumn   = 0;
+    int nLine     = 0;
+
+    for (int nLoop = 0; nLoop < m_nTextLength; nLoop++)
+    {
+        // Start a new line?
+        if (m_pszTextString[nLoop] == '\n')
+        {
+            nColumn = 0;
+            nLine++;
+            continue;
+        }
+
+        // The first character in the font image is a space (see RenderChar()).
+        char cTextChar = char(m_pszTextString[nLoop] - 32);
+
+        if (cTextChar < 0)
+        {
+            cTextChar = 0;
+        }
+
+        // The top left corner of the character in the font image.
+        int nXoffset = ImageRect.left + (cTextChar % m_nCharsPerLine) * m_nLetterWidth;
+        int nYoffset = ImageRect.top - ((cTextChar / m_nCharsPerLine) * m_nLetterHeight);
+
+        GLfloat fTexLeft   = (nXoffset + pgsLayout->fScrollX) / fTexWidth;
+        GLfloat fTexRight  = (nXoffset + m_nLetterWidth + pgsLayout->fScrollX) / fTexWidth;
+        GLfloat fTexTop    = (nYoffset + pgsLayout->fScrollY) / fTexHeight;
+        GLfloat fTexBottom = (nYoffset - m_nLetterHeight + pgsLayout->fScrollY) / fTexHeight;
+
+        GLfloat fTexU[4] = { fTexLeft,   fTexRight,  fTexRight, fTexLeft };
+        GLfloat fTexV[4] = { fTexBottom, fTexBottom, fTexTop,   fTexTop  };
+
+        // The screen position of the rotation point of the character.
+        GLfloat fPosX = (pgsLayout->gliDestX + (nColumn * nAdvanceX)) - fLeft;
+        GLfloat fPosY = (pgsLayout->gliDestY - (nLine * nAdvanceY)) - fBottom;
+
+        for (int nCorner = 0; nCorner < 4; nCorner++)
+        {
+            pVertex->fTexU  = fTexU[nCorner];
+            pVertex->fTexV  = fTexV[nCorner];
+            pVertex->fRed   = pgsLayout->fRed;
+            pVertex->fGreen = pgsLayout->fGreen;
+            pVertex->fBlue  = pgsLayout->fBlue;
+            pVertex->fAlpha = pgsLayout->fAlpha;
+            pVertex->fX = fPosX + (fXx * fCornerX[nCorner]) + (fYx * fCornerY[nCorner]);
+            pVertex->fY = fPosY + (fXy * fCornerX[nCorner]) + (fYy * fCornerY[nCorner]);
+            pVertex->fZ = (fXz * fCornerX[nCorner]) + (fYz * fCornerY[nCorner]);
+            pVertex++;
+        }
+
+        nNumQuads++;
+        nColumn++;
+    }
+
+    m_nNumGlyphQuads = nNumQuads;
+    m_gsLayout       = *pgsLayout;
+    m_bIsLayoutValid = TRUE;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLFont::GetLayout():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Collects the current values of everything the laid out quads depend on, apart from
+//          the text and letter settings, which invalidate the layout when they are changed.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLFont::GetLayout(GS_FontLayout* pgsLayout)
+{
+
+    GS_OGLColor gsColor;
+    GS_OGLSprite::GetModulateColor(&gsColor);
+
+    // Clear the structure first, since layouts are compared with memcmp().
+    ZeroMemory(pgsLayout, sizeof(GS_FontLayout));
+
+    pgsLayout->gliDestX          = GS_OGLSprite::GetDestX();
+    pgsLayout->gliDestY          = GS_OGLSprite::GetDestY();
+    pgsLayout->fScaleX           = GS_OGLSprite::GetScaleX();
+    pgsLayout->fScaleY           = GS_OGLSprite::GetScaleY();
+    pgsLayout->fRotateX          = GS_OGLSprite::GetRotateX();
+    pgsLayout->fRotateY          = GS_OGLSprite::GetRotateY();
+    pgsLayout->fRotateZ          = GS_OGLSprite::GetRotateZ();
+    pgsLayout->gliRotationPointX = GS_OGLSprite::GetRotationPointX();
+    pgsLayout->gliRotationPointY = GS_OGLSprite::GetRotationPointY();
+    pgsLayout->fScrollX          = GS_OGLSprite::GetScrollX();
+    pgsLayout->fScrollY          = GS_OGLSprite::GetScrollY();
+    pgsLayout->fRed              = gsColor.fRed;
+    pgsLayout->fGreen            = gsColor.fGreen;
+    pgsLayout->fBlue             = gsColor.fBlue;
+    pgsLayout->fAlpha            = gsColor.fAlpha;
 }
-*/
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -327,12 +526,15 @@ BOOL GS_OGLFont::RenderChar(char cTextChar, HWND hWnd)
     }
 
     // Use the remainder to determine the horizontal offset of the letter.
-    nXoffset = (cTextChar%m_nCharsPerLine) * m_nLetterWidth;
+    RECT ImageRect;
+    GS_OGLSprite::GetImageRect(&ImageRect);
+
+    nXoffset = ImageRect.left + (cTextChar%m_nCharsPerLine) * m_nLetterWidth;
 
     // Use the quotient to determine the vertical offset of the letter starting from the top
-    // of the image and working towards the bottom.
-    nYoffset = this->GetTextureHeight() - (((cTextChar - (cTextChar%m_nCharsPerLine)) /
-                                            m_nCharsPerLine) * m_nLetterHeight);
+    // of the image (which is only part of the texture when using a texture atlas).
+    nYoffset = ImageRect.top - (((cTextChar - (cTextChar%m_nCharsPerLine)) /
+                                 m_nCharsPerLine) * m_nLetterHeight);
 
     // Set the source rectangle to the specified frame.
     SourceRect.left   = nXoffset;
@@ -381,6 +583,8 @@ void GS_OGLFont::SetCharsPerLine(int nCharsPerLine)
 {
 
     m_nCharsPerLine = nCharsPerLine;
+
+    m_bIsLayoutValid = FALSE;
 }
 
 
@@ -414,6 +618,8 @@ void GS_OGLFont::SetLetterWidth(int nLetterWidth)
 {
 
     m_nLetterWidth = nLetterWidth;
+
+    m_bIsLayoutValid = FALSE;
 }
 
 
@@ -447,6 +653,8 @@ void GS_OGLFont::SetLetterHeight(int nLetterHeight)
 {
 
     m_nLetterHeight = nLetterHeight;
+
+    m_bIsLayoutValid = FALSE;
 }
 
 
@@ -488,13 +696,6 @@ void GS_OGLFont::SetText(const char* pszTextString, ...)
         return;
     }
 
-    // Delete string if exists.
-    if (m_pszTextString)
-    {
-        delete [] m_pszTextString;
-    }
-    m_pszTextString=NULL;
-
     char szTempString[256];
 
     // Pointer to a list of arguments.
@@ -503,9 +704,22 @@ void GS_OGLFont::SetText(const char* pszTextString, ...)
     // Parses the string for variables.
     va_start(pArg, pszTextString);
     // Converts symbols to actual numbers and save.
-    vsprintf(szTempString, pszTextString, pArg);
+    vsnprintf(szTempString, sizeof(szTempString), pszTextString, pArg);
     va_end(pArg);
 
+    // Text set every frame usually doesn't change, keep the laid out quads if it didn't.
+    if ((m_pszTextString) && (strcmp(m_pszTextString, szTempString) == 0))
+    {
+        return;
+    }
+
+    // Delete string if exists.
+    if (m_pszTextString)
+    {
+        delete [] m_pszTextString;
+    }
+    m_pszTextString=NULL;
+
     // Determine length of string and allocate memory.
     int nStringLength = lstrlen(szTempString) + 1;
     m_pszTextString = new char[nStringLength];
@@ -515,6 +729,26 @@ void GS_OGLFont::SetText(const char* pszTextString, ...)
 
     // Terminate the string.
     m_pszTextString[nStringLength-1] = '\0';
+
+    m_nTextLength  = nStringLength - 1;
+    m_nNumLines    = 1;
+    m_nLongestLine = 0;
+
+    // Measure the text once here rather than every time it is rendered.
+    for (int nLoop = 0, nColumn = 0; nLoop < m_nTextLength; nLoop++)
+    {
+        if (m_pszTextString[nLoop] == '\n')
+        {
+            nColumn = 0;
+            m_nNumLines++;
+        }
+        else if (++nColumn > m_nLongestLine)
+        {
+            m_nLongestLine = nColumn;
+        }
+    }
+
+    m_bIsLayoutValid = FALSE;
 }
 
 
@@ -526,13 +760,13 @@ void GS_OGLFont::SetText(const char* pszTextString, ...)
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: Nothing.
+// Returns: The width of the longest line of text.
 //==============================================================================================
 
 float GS_OGLFont::GetTextWidth()
 {
 
-    return (this->GetLetterWidth() * lstrlen(m_pszTextString));
+    return (this->GetLetterWidth() * m_nLongestLine);
 }
 
 
@@ -544,13 +778,13 @@ float GS_OGLFont::GetTextWidth()
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: Nothing.
+// Returns: The height of all lines of text.
 //==============================================================================================
 
 float GS_OGLFont::GetTextHeight()
 {
 
-    return this->GetLetterHeight();
+    return (this->GetLetterHeight() * m_nNumLines);
 }
 
 
@@ -560,7 +794,8 @@ float GS_OGLFont::GetTextHeight()
 //==============================================================================================
 // GS_OGLFont::GetDestRect():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Retrieves the area covered by the text. The first line sits on the destination
+//          coordinates and any further lines are below it.
 // ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
@@ -569,19 +804,20 @@ void GS_OGLFont::GetDestRect(long* pLeft, long* pTop, long* pRight, long* pBotto
 {
 
     *pLeft   = GS_OGLSprite::GetDestX();
-    *pTop    = GS_OGLSprite::GetDestY() + (long)this->GetTextHeight();
+    *pTop    = GS_OGLSprite::GetDestY() + (long)this->GetLetterHeight();
     *pRight  = GS_OGLSprite::GetDestX() + (long)this->GetTextWidth();
-    *pBottom = GS_OGLSprite::GetDestY();
+    *pBottom = *pTop - (long)this->GetTextHeight();
 }
 
 
 void GS_OGLFont::GetDestRect(RECT* pDestRect)
 {
 
-    SetRect(pDestRect, GS_OGLSprite::GetDestX(),
-            (GS_OGLSprite::GetDestY() + (long)this->GetTextHeight()),
+    long lTop = GS_OGLSprite::GetDestY() + (long)this->GetLetterHeight();
+
+    SetRect(pDestRect, GS_OGLSprite::GetDestX(), lTop,
             (GS_OGLSprite::GetDestX() + (long)this->GetTextWidth()),
-            GS_OGLSprite::GetDestY());
+            lTop - (long)this->GetTextHeight());
 }
 
 
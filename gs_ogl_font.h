@@ -39,7 +39,34 @@
 // Include Game System (GS) header files.
 // ---------------------------------------------------------------------------------------------
 #include "gs_error.h"
+#include "gs_math.h"
 #include "gs_ogl_sprite.h"
+#include "gs_ogl_sprite_batch.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Font layout structure, everything apart from the text and letter settings that the quads of
+// the laid out text depend on.
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_FONT_LAYOUT
+{
+    GLint   gliDestX;          // The position of the first character.
+    GLint   gliDestY;
+    GLfloat fScaleX;           // The scale of the characters.
+    GLfloat fScaleY;
+    GLfloat fRotateX;          // The rotation of every character.
+    GLfloat fRotateY;
+    GLfloat fRotateZ;
+    GLint   gliRotationPointX; // The rotation point of every character.
+    GLint   gliRotationPointY;
+    GLfloat fScrollX;          // How far the characters are scrolled.
+    GLfloat fScrollY;
+    GLfloat fRed;              // The modulate color.
+    GLfloat fGreen;
+    GLfloat fBlue;
+    GLfloat fAlpha;
+} GS_FontLayout;
 //==============================================================================================
 
 
@@ -53,14 +80,25 @@ class GS_OGLFont : public GS_OGLSprite
 
 private:
 
-    // GS_RenderTarget m_gsTargets[160]; // ...
-
     char* m_pszTextString; // Text string to output to screen.
+    int   m_nTextLength;   // Number of characters in the text string.
+    int   m_nNumLines;     // Number of lines in the text string.
+    int   m_nLongestLine;  // Number of characters on the longest line.
 
     int   m_nCharsPerLine; // Number of characters per line of the font image.
     int   m_nLetterWidth;  // Width of each letter.
     int   m_nLetterHeight; // Height of each letter.
 
+    GS_BatchVertex* m_pGlyphQuads; // The quads of the laid out text (four vertices each).
+    int m_nNumGlyphQuads;          // Number of quads in the laid out text.
+    int m_nMaxGlyphQuads;          // Number of quads there is room for.
+
+    GS_FontLayout m_gsLayout; // The settings the text was laid out with.
+    BOOL m_bIsLayoutValid;    // Wether the quads match the text and the letter settings.
+
+    BOOL LayoutText(GS_FontLayout* pgsLayout);
+    void GetLayout(GS_FontLayout* pgsLayout);
+
 protected:
 
     // ...
@@ -77,7 +115,6 @@ public:
 
     void Destroy();
 
-    // BOOL Render(HWND hWnd = NULL);
     BOOL RenderChar(char cTextChar, HWND hWnd = NULL);
     BOOL Render(HWND hWnd = NULL);
 
@@ -74,99 +74,145 @@ GS_OGLImage::~GS_OGLImage()
 //==============================================================================================
 // GS_OGLImage::LoadUncompressedTGA():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Decodes the pixels of an uncompressed TGA file held in memory. The data starts at
+//          the 12 byte TGA header, which has already been checked.
 // ---------------------------------------------------------------------------------------------
 // Returns: TRUE if successful, FALSE if failed.
 //==============================================================================================
 
-BOOL GS_OGLImage::LoadUncompressedTGA(FILE* pFile)
+BOOL GS_OGLImage::LoadUncompressedTGA(const BYTE* pData, unsigned long lLength)
 {
 
-    // Variable for holding the TGA header.
-    BYTE TGAHeader[6] = { 0,0,0,0,0,0 };
-
-    // Read TGA header.
-    if (fread(TGAHeader, sizeof(TGAHeader), 1, pFile) == 0)
+    // Create an image as described by the TGA header.
+    if (!this->CreateFromTGAHeader(pData, lLength))
     {
-        // Is file still open?
-        if (pFile != NULL)
-        {
-            fclose(pFile);
-        }
         return FALSE;
     }
 
-    // Determine the image width (highbyte * 256 + lowbyte).
-    m_nImageWidth  = TGAHeader[1] * 256 + TGAHeader[0];
-    // Determine the image height (highbyte * 256 + lowbyte).
-    m_nImageHeight = TGAHeader[3] * 256 + TGAHeader[2];
-    // Determine the color size of the image in bytes.
-    m_nColorBytes  = TGAHeader[4] / 8;
-    // Determine if the image has an alpha component.
-    m_bHasAlpha    = (m_nColorBytes==4);
-
-    // Is the image information valid?
-    if ((m_nImageWidth <= 0) || (m_nImageHeight <= 0) || ((m_nColorBytes != 3) &&
-            (m_nColorBytes != 4)))
+    // Is all of the image data there?
+    if ((lLength - GS_TGA_HEADER_SIZE) < (unsigned long) m_nImageSize)
     {
         // Clear image data and attributes.
         this->Destroy();
-        // Is file still open?
-        if (pFile != NULL)
-        {
-            fclose(pFile);
-        }
         return FALSE;
     }
 
-    // Compute the total amount of memory needed to store the image data.
-    m_nImageSize = (m_nColorBytes * m_nImageWidth * m_nImageHeight);
+    // Copy the image data in one go.
+    memcpy(m_pImage, pData + GS_TGA_HEADER_SIZE, m_nImageSize);
 
-    // Does image exist already?
-    if (m_pImage != NULL)
+    // Swap bytes to the correct color format (BGR -> RGB).
+    SwapRedBlue(m_pImage, m_nImageWidth * m_nImageHeight, m_nColorBytes);
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLImage::LoadCompressedTGA():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Decodes the pixels of a RLE compressed TGA file held in memory. The data starts at
+//          the 12 byte TGA header, which has already been checked.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if failed.
+//==============================================================================================
+
+BOOL GS_OGLImage::LoadCompressedTGA(const BYTE* pData, unsigned long lLength)
+{
+
+    // Create an image as described by the TGA header.
+    if (!this->CreateFromTGAHeader(pData, lLength))
     {
-        // De-allocate memory for image data.
-        delete []m_pImage;
+        return FALSE;
     }
-    m_pImage = NULL;
 
-    // Allocate enough memory for the image data.
-    m_pImage = new BYTE [m_nImageSize];
+    const BYTE* pRead    = pData + GS_TGA_HEADER_SIZE; // The next chunk in the file.
+    const BYTE* pReadEnd = pData + lLength;
+    BYTE* pWrite    = m_pImage;                         // The next pixel in the image.
+    BYTE* pWriteEnd = m_pImage + m_nImageSize;
 
-    // Were we able to allocate memory?
-    if (!m_pImage)
+    int nColorBytes = m_nColorBytes;
+
+    // Expand the chunks straight into the image, the colors stay BGR(A) until the end.
+    while (pWrite < pWriteEnd)
     {
-        // Clear image data and attributes.
-        this->Destroy();
-        // Is file still open?
-        if (pFile != NULL)
+        // Make sure there is a chunk header left.
+        if (pRead >= pReadEnd)
         {
-            fclose(pFile);
+            // Clear image data and attributes.
+            this->Destroy();
+            return FALSE;
         }
-        return FALSE;
-    }
 
-    // Were we able to read the TGA image data?
-    if (fread(m_pImage, 1, m_nImageSize, pFile) != (unsigned)m_nImageSize)
-    {
-        // Clear image data and attributes.
-        this->Destroy();
-        // Is file still open?
-        if (pFile != NULL)
+        // The lower 7 bits of the chunk header are the number of pixels minus one, the upper
+        // bit tells wether the chunk is RAW (0) or RLE (1).
+        BYTE ucChunkHeader = *pRead++;
+        long lNumBytes = ((ucChunkHeader & 0x7f) + 1) * nColorBytes;
+
+        // Make sure the chunk doesn't write too many pixels.
+        if (lNumBytes > (pWriteEnd - pWrite))
         {
-            fclose(pFile);
+            // Clear image data and attributes.
+            this->Destroy();
+            return FALSE;
         }
-        return FALSE;
-    }
 
-    // Swap bytes to the correct color format (BGR -> RGB).
-    for (int nSwap = 0; nSwap < m_nImageSize; nSwap += m_nColorBytes)
-    {
-        m_pImage[nSwap] ^= m_pImage[nSwap+2] ^= m_pImage[nSwap] ^= m_pImage[nSwap+2];
+        // RAW chunk, the pixels follow the header.
+        if (ucChunkHeader < 128)
+        {
+            if (lNumBytes > (pReadEnd - pRead))
+            {
+                // Clear image data and attributes.
+                this->Destroy();
+                return FALSE;
+            }
+
+            memcpy(pWrite, pRead, lNumBytes);
+            pRead  += lNumBytes;
+            pWrite += lNumBytes;
+        }
+        // RLE chunk, a single color to repeat follows the header.
+        else
+        {
+            if (nColorBytes > (pReadEnd - pRead))
+            {
+                // Clear image data and attributes.
+                this->Destroy();
+                return FALSE;
+            }
+
+            BYTE* pChunkEnd = pWrite + lNumBytes;
+
+            if (nColorBytes == 4)
+            {
+                DWORD dwColor;
+                memcpy(&dwColor, pRead, 4);
+
+                for (; pWrite < pChunkEnd; pWrite += 4)
+                {
+                    memcpy(pWrite, &dwColor, 4);
+                }
+            }
+            else
+            {
+                BYTE ucBlue = pRead[0], ucGreen = pRead[1], ucRed = pRead[2];
+
+                for (; pWrite < pChunkEnd; pWrite += 3)
+                {
+                    pWrite[0] = ucBlue;
+                    pWrite[1] = ucGreen;
+                    pWrite[2] = ucRed;
+                }
+            }
+
+            pRead += nColorBytes;
+        }
     }
 
-    // Close the TGA file.
-    fclose(pFile);
+    // Swap bytes to the correct color format (BGR -> RGB).
+    SwapRedBlue(m_pImage, m_nImageWidth * m_nImageHeight, m_nColorBytes);
 
     return TRUE;
 }
@@ -176,229 +222,126 @@ BOOL GS_OGLImage::LoadUncompressedTGA(FILE* pFile)
 
 
 //==============================================================================================
-// GS_OGLImage::LoadCompressedTGA():
+// GS_OGLImage::CreateFromTGAHeader():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Reads the image information following the 12 byte TGA header and creates an image
+//          to hold the pixels.
 // ---------------------------------------------------------------------------------------------
 // Returns: TRUE if successful, FALSE if failed.
 //==============================================================================================
 
-BOOL GS_OGLImage::LoadCompressedTGA(FILE* pFile)
+BOOL GS_OGLImage::CreateFromTGAHeader(const BYTE* pData, unsigned long lLength)
 {
 
-    // Variable for holding the TGA header.
-    BYTE TGAHeader[6] = { 0,0,0,0,0,0 };
-
-    // Read the TGA header.
-    if (fread(TGAHeader, sizeof(TGAHeader), 1, pFile) == 0)
+    if (lLength < GS_TGA_HEADER_SIZE)
     {
-        // Is file still open?
-        if (pFile != NULL)
-        {
-            fclose(pFile);
-        }
         return FALSE;
     }
 
-    // Determine the image width (highbyte * 256 + lowbyte).
-    m_nImageWidth  = TGAHeader[1] * 256 + TGAHeader[0];
-    // Determine the image height (highbyte * 256 + lowbyte).
-    m_nImageHeight = TGAHeader[3] * 256 + TGAHeader[2];
+    // The 6 useful bytes following the 12 byte header.
+    const BYTE* TGAHeader = pData + 12;
+
+    // Determine the image width and height (highbyte * 256 + lowbyte).
+    int nWidth  = TGAHeader[1] * 256 + TGAHeader[0];
+    int nHeight = TGAHeader[3] * 256 + TGAHeader[2];
     // Determine the color size of the image in bytes.
-    m_nColorBytes  = TGAHeader[4] / 8;
-    // Determine the alpha component.
-    m_bHasAlpha    = (m_nColorBytes==4);
+    int nColorBytes = TGAHeader[4] / 8;
 
     // Is the image information valid?
-    if ((m_nImageWidth <= 0) || (m_nImageHeight <= 0) || ((m_nColorBytes != 3) &&
-            (m_nColorBytes != 4)))
+    if ((nWidth <= 0) || (nHeight <= 0) || ((nColorBytes != 3) && (nColorBytes != 4)))
     {
         // Clear image data and attributes.
         this->Destroy();
-        // Is file still open?
-        if (pFile != NULL)
-        {
-            fclose(pFile);
-        }
         return FALSE;
     }
 
-    // Compute the total amout of memory needed to store the image data.
-    m_nImageSize = (m_nColorBytes * m_nImageWidth * m_nImageHeight);
+    // Create the image, the image has an alpha component if it is 32-bit.
+    return this->Create(nWidth, nHeight, (nColorBytes == 4));
+}
 
-    // Does image exist already?
-    if (m_pImage != NULL)
-    {
-        // De-allocate memory for image data.
-        delete []m_pImage;
-    }
-    m_pImage = NULL;
 
-    // Allocate enough memory for the image data.
-    m_pImage = new BYTE [m_nImageSize];
+////////////////////////////////////////////////////////////////////////////////////////////////
 
-    // Were we able to allocate memory?
-    if (!m_pImage)
-    {
-        // Clear image data and attributes.
-        this->Destroy();
-        // Is file still open?
-        if (pFile != NULL)
-        {
-            fclose(pFile);
-        }
-        return FALSE;
-    }
 
-    unsigned int nPixelCount   = m_nImageHeight * m_nImageWidth; // Nuber of pixels in the image.
-    unsigned int nCurrentPixel = 0; // Current pixel being read.
-    unsigned int nCurrentByte  = 0; // Current byte.
+//==============================================================================================
+// GS_OGLImage::SwapRedBlue():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Swaps the red and blue bytes of every pixel (BGR -> RGB or BGRA -> RGBA), using
+//          SIMD instructions for as many pixels as possible.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLImage::SwapRedBlue(BYTE* pPixels, int nNumPixels, int nColorBytes)
+{
 
-    // Allocate enough memory for the color of a single pixel.
-    BYTE* pColorBuffer = new BYTE [m_nColorBytes];
+    int nPixel = 0;
 
-    // Were we able to allocate memory?
-    if (!pColorBuffer)
+#if defined(GS_SIMD_SSSE3)
+    // Shuffle 16 bytes at a time, that is 4 pixels of 4 bytes or 5 pixels of 3 bytes (the last
+    // byte belongs to the next pixel and is left alone).
+    const __m128i xmmShuffle = (nColorBytes == 4) ?
+        _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15) :
+        _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15);
+    const int nStep = (nColorBytes == 4) ? 4 : 5;
+
+    for (; ((nPixel * nColorBytes) + 16) <= (nNumPixels * nColorBytes); nPixel += nStep)
     {
-        // Clear image data and attributes.
-        this->Destroy();
-        // Is file still open?
-        if (pFile != NULL)
-        {
-            fclose(pFile);
-        }
-        return FALSE;
+        __m128i* pBlock = (__m128i*) (pPixels + (nPixel * nColorBytes));
+        _mm_storeu_si128(pBlock, _mm_shuffle_epi8(_mm_loadu_si128(pBlock), xmmShuffle));
     }
-
-    do
+#elif defined(GS_SIMD_SSE2)
+    // Without a byte shuffle only 4 byte pixels can be swapped, by masking and shifting.
+    if (nColorBytes == 4)
     {
-        BYTE ucChunkHeader = 0; // Storage for "chunk" header.
+        const __m128i xmmKeep = _mm_set1_epi32((int) 0xff00ff00);
+        const __m128i xmmByte = _mm_set1_epi32(0x000000ff);
 
-        // Read in the chunk header.
-        if (fread(&ucChunkHeader, sizeof(BYTE), 1, pFile) == 0)
+        for (; (nPixel + 4) <= nNumPixels; nPixel += 4)
         {
-            // Clear image data and attributes.
-            this->Destroy();
-            // Is file still open?
-            if (pFile != NULL)
-            {
-                fclose(pFile);
-            }
-            return FALSE;
+            __m128i* pBlock = (__m128i*) (pPixels + (nPixel * 4));
+            __m128i xmmPixels = _mm_loadu_si128(pBlock);
+            __m128i xmmRed    = _mm_and_si128(_mm_srli_epi32(xmmPixels, 16), xmmByte);
+            __m128i xmmBlue   = _mm_slli_epi32(_mm_and_si128(xmmPixels, xmmByte), 16);
+            xmmPixels = _mm_or_si128(_mm_and_si128(xmmPixels, xmmKeep),
+                                     _mm_or_si128(xmmRed, xmmBlue));
+            _mm_storeu_si128(pBlock, xmmPixels);
         }
-
-        // If the header is < 128, it means the that is the number of RAW color packets minus one.
-        if (ucChunkHeader < 128)
+    }
+#elif defined(GS_SIMD_NEON)
+    // De-interleave 16 pixels at a time and store them with the red and blue planes swapped.
+    if (nColorBytes == 4)
+    {
+        for (; (nPixel + 16) <= nNumPixels; nPixel += 16)
         {
-            // Add 1 to get number of following color values.
-            ucChunkHeader++;
-            // Read RAW color values.
-            for (short sLoop = 0; sLoop < ucChunkHeader; sLoop++)
-            {
-                // Try to read 1 pixel.
-                if (fread(pColorBuffer, 1, m_nColorBytes, pFile) != (unsigned)m_nColorBytes)
-                {
-                    // Clear image data and attributes.
-                    this->Destroy();
-                    // De-allocate memory for color data.
-                    delete [] pColorBuffer;
-                    // Is file still open?
-                    if (pFile != NULL)
-                    {
-                        fclose(pFile);
-                    }
-                    return FALSE;
-                }
-                // Write to memory and flip the R and B color values around in the process.
-                m_pImage[nCurrentByte]   = pColorBuffer[2];
-                m_pImage[nCurrentByte+1] = pColorBuffer[1];
-                m_pImage[nCurrentByte+2] = pColorBuffer[0];
-                // If it's a 32-bit image.
-                if (m_nColorBytes == 4)
-                {
-                    // Copy the 4th byte.
-                    m_pImage[nCurrentByte+3] = pColorBuffer[3];
-                }
-                // Increase the current byte by the number of bytes per pixel.
-                nCurrentByte += m_nColorBytes;
-                // Increase current pixel by 1.
-                nCurrentPixel++;
-                // Make sure we haven't read too many pixels.
-                if (nCurrentPixel > nPixelCount)
-                {
-                    // Clear image data and attributes.
-                    this->Destroy();
-                    // De-allocate memory for color data.
-                    delete [] pColorBuffer;
-                    // Is file still open?
-                    if (pFile != NULL)
-                    {
-                        fclose(pFile);
-                    }
-                    return FALSE;
-                }
-            }
+            uint8x16x4_t neonPixels = vld4q_u8(pPixels + (nPixel * 4));
+            uint8x16_t   neonTemp   = neonPixels.val[0];
+            neonPixels.val[0] = neonPixels.val[2];
+            neonPixels.val[2] = neonTemp;
+            vst4q_u8(pPixels + (nPixel * 4), neonPixels);
         }
-        // ucChunkHeader > 128 RLE data, next color reapeated ucChunkHeader - 127 times.
-        else
+    }
+    else
+    {
+        for (; (nPixel + 16) <= nNumPixels; nPixel += 16)
         {
-            // Subteact 127 to get rid of the ID bit.
-            ucChunkHeader -= (unsigned char)127;
-            // Read a single RLE color value.
-            if (fread(pColorBuffer, 1, m_nColorBytes, pFile) != (unsigned)m_nColorBytes)
-            {
-                // Clear image data and attributes.
-                this->Destroy();
-                // De-allocate memory for color data.
-                delete [] pColorBuffer;
-                // Is file still open?
-                if (pFile != NULL)
-                {
-                    fclose(pFile);
-                }
-                return FALSE;
-            }
-            // Write RLE the color value to memory as many times as required.
-            for (short sLoop = 0; sLoop < ucChunkHeader; sLoop++)
-            {
-                // Write to memory and flip the R and B color values around in the process.
-                m_pImage[nCurrentByte]   = pColorBuffer[2];
-                m_pImage[nCurrentByte+1] = pColorBuffer[1];
-                m_pImage[nCurrentByte+2] = pColorBuffer[0];
-                // If TGA images is 32 bpp.
-                if (m_nColorBytes == 4)
-                {
-                    // Copy 4th byte
-                    m_pImage[nCurrentByte+3] = pColorBuffer[3];
-                }
-                // Increase current byte by the number of bytes per pixel.
-                nCurrentByte += m_nColorBytes;
-                // Increase pixel count by 1
-                nCurrentPixel++;
-                // Make sure we havent written too many pixels.
-                if (nCurrentPixel > nPixelCount)
-                {
-                    // Clear image data and attributes.
-                    this->Destroy();
-                    // De-allocate memory for color data.
-                    delete [] pColorBuffer;
-                    // Is file still open?
-                    if (pFile != NULL)
-                    {
-                        fclose(pFile);
-                    }
-                    return FALSE;
-                }
-            }
+            uint8x16x3_t neonPixels = vld3q_u8(pPixels + (nPixel * 3));
+            uint8x16_t   neonTemp   = neonPixels.val[0];
+            neonPixels.val[0] = neonPixels.val[2];
+            neonPixels.val[2] = neonTemp;
+            vst3q_u8(pPixels + (nPixel * 3), neonPixels);
         }
-        // Loop while there are still pixels left.
     }
-    while(nCurrentPixel < nPixelCount);
-
-    // Close the TGA file.
-    fclose(pFile);
+#endif
 
-    return TRUE;
+    // Swap the remaining pixels one at a time.
+    for (BYTE* pPixel = pPixels + (nPixel * nColorBytes); nPixel < nNumPixels; nPixel++)
+    {
+        BYTE ucTemp = pPixel[0];
+        pPixel[0] = pPixel[2];
+        pPixel[2] = ucTemp;
+        pPixel += nColorBytes;
+    }
 }
 
 
@@ -555,7 +498,7 @@ BOOL GS_OGLImage::Load(const char* pszFilename)
 //==============================================================================================
 // GS_OGLImage::LoadBMP():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Maps the bitmap file into memory and decodes it with LoadBMP(pData, lLength).
 // ---------------------------------------------------------------------------------------------
 // Returns: TRUE if successful, FALSE if failed.
 //==============================================================================================
@@ -569,63 +512,89 @@ BOOL GS_OGLImage::LoadBMP(const char* pszFilename)
         return FALSE;
     }
 
-    // Try to open the bitmap file.
-    FILE* pFile = fopen(pszFilename, "rb");
+    GS_FileMap gsFileMap;
 
-    // Were we able to open the bitmap file?
-    if (!pFile)
+    // Read the whole file in one go.
+    if (!gsFileMap.Open(pszFilename))
     {
         return FALSE;
     }
 
-    BITMAPFILEHEADER BitmapHeader;
+    return this->LoadBMP(gsFileMap.GetData(), gsFileMap.GetLength());
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLImage::LoadBMP():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Decodes a 24-bit or 32-bit bitmap file held in memory.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if failed.
+//==============================================================================================
 
-    // Read the header of the bitmap file.
-    if (!fread(&BitmapHeader, sizeof(BITMAPFILEHEADER), 1, pFile))
+BOOL GS_OGLImage::LoadBMP(const BYTE* pData, unsigned long lLength)
+{
+
+    // Is there enough data for both headers?
+    if (!pData || (lLength < (sizeof(BITMAPFILEHEADER) + sizeof(BITMAPINFOHEADER))))
     {
-        // Is file still open?
-        if (pFile != NULL)
-        {
-            fclose(pFile);
-        }
         return FALSE;
     }
 
+    BITMAPFILEHEADER BitmapHeader;
+    BITMAPINFOHEADER HeaderInfo;
+
+    // Copy the headers out of the file data (which need not be aligned).
+    memcpy(&BitmapHeader, pData, sizeof(BITMAPFILEHEADER));
+    memcpy(&HeaderInfo, pData + sizeof(BITMAPFILEHEADER), sizeof(BITMAPINFOHEADER));
+
     // Check the type field to make sure we have a valid bitmap file.
     if (memcmp(&BitmapHeader.bfType, "BM", 2))
     {
-        // Is file still open?
-        if (pFile != NULL)
-        {
-            fclose(pFile);
-        }
         return FALSE;
     }
 
-    BITMAPINFOHEADER HeaderInfo;
+    // We only support 24-bit and 32-bit bitmaps so make sure that's what we have.
+    if ((HeaderInfo.biBitCount!=24) && (HeaderInfo.biBitCount!=32))
+    {
+        return FALSE;
+    }
 
-    // Read the information header of the bitmap file.
-    if (!fread(&HeaderInfo, sizeof(BITMAPINFOHEADER), 1, pFile))
+    // We only support bottom-up bitmaps with a valid size.
+    if ((HeaderInfo.biWidth <= 0) || (HeaderInfo.biHeight <= 0))
     {
-        // Is file still open?
-        if (pFile != NULL)
-        {
-            fclose(pFile);
-        }
         return FALSE;
     }
 
-    // We only support 24-bit and 32-bit bitmaps so make sure that's what we have.
-    if ((HeaderInfo.biBitCount!=24) && (HeaderInfo.biBitCount!=32))
+    // Set stride - The stride is the TRUE number of bytes in a line of pixels. Windows makes
+    // all the bitmaps DWORD aligned (divisible evenly by 4), so if you bitmap say was 103x103
+    // pixels, Windows would add 1 "padding byte" to it so in memory it would be 104x103 pixels.
+    // The "padding bytes" do not get blit (drawn) to the screen, they're just there so again
+    // everything is DWORD aligned which makes blitting (drawing to the screen) easier.
+    unsigned long lBitmapStride = ((HeaderInfo.biWidth * HeaderInfo.biBitCount) + 31) / 32 * 4;
+
+    // Bytes per line (number of bytes in a scan line).
+    unsigned long lBytesPerLine = HeaderInfo.biWidth * (HeaderInfo.biBitCount / 8);
+
+    // Is all of the pixel data there?
+    if ((BitmapHeader.bfOffBits > lLength) ||
+            ((lLength - BitmapHeader.bfOffBits) / lBitmapStride) <
+            (unsigned long) HeaderInfo.biHeight)
     {
-        // Is file still open?
-        if (pFile != NULL)
-        {
-            fclose(pFile);
-        }
         return FALSE;
     }
 
+    // Does image exist already?
+    if (m_pImage != NULL)
+    {
+        // De-allocate memory for image data.
+        delete []m_pImage;
+    }
+    m_pImage = NULL;
+
     // Save image dimensions.
     m_nImageWidth  = HeaderInfo.biWidth;
     m_nImageHeight = HeaderInfo.biHeight;
@@ -639,14 +608,6 @@ BOOL GS_OGLImage::LoadBMP(const char* pszFilename)
     // Set image size for allocating memory.
     m_nImageSize = m_nImageWidth * m_nImageHeight * m_nColorBytes;
 
-    // Does image exist already?
-    if (m_pImage != NULL)
-    {
-        // De-allocate memory for image data.
-        delete []m_pImage;
-    }
-    m_pImage = NULL;
-
     // Allocate enough space for the image data.
     m_pImage = new BYTE [m_nImageSize];
 
@@ -655,88 +616,26 @@ BOOL GS_OGLImage::LoadBMP(const char* pszFilename)
     {
         // Clear image data and attributes.
         this->Destroy();
-        // Is file still open?
-        if (pFile != NULL)
-        {
-            fclose(pFile);
-        }
         return FALSE;
     }
 
-    // Set stride - The stride is the TRUE number of bytes in a line of pixels. Windows makes
-    // all the bitmaps DWORD aligned (divisible evenly by 4), so if you bitmap say was 103x103
-    // pixels, Windows would add 1 "padding byte" to it so in memory it would be 104x103 pixels.
-    // The "padding bytes" do not get blit (drawn) to the screen, they're just there so again
-    // everything is DWORD aligned which makes blitting (drawing to the screen) easier.
-    int nBitmapStride = HeaderInfo.biWidth * (HeaderInfo.biBitCount / 8);
+    const BYTE* pPixels = pData + BitmapHeader.bfOffBits;
 
-    // Ensure nBitmapStride is DWORD aligned.
-    while ((nBitmapStride % 4) != 0)
+    // Copy the scan lines (all the rows of pixels in the image) without the padding bytes.
+    if (lBytesPerLine == lBitmapStride)
     {
-        nBitmapStride++;
+        memcpy(m_pImage, pPixels, m_nImageSize);
     }
-
-    // Bytes per line (number of bytes in a scan line).
-    unsigned int nBytesPerLine = HeaderInfo.biWidth * (HeaderInfo.biBitCount / 8);
-
-    // Calculate how many "padding" bytes there are. We do NOT want to read in the padding bytes.
-    // Remember that Windows adds padding bytes to ensure all bitmaps are DWORD aligned.
-    unsigned int nPaddingBytes = nBitmapStride - nBytesPerLine;
-
-    // Jump to the location where the pixel data is stored.
-    if (fseek(pFile, BitmapHeader.bfOffBits, SEEK_SET))
+    else
     {
-        // Clear image data and attributes.
-        this->Destroy();
-        // Is file still open?
-        if (pFile != NULL)
+        for (int y = 0; y < m_nImageHeight; y++)
         {
-            fclose(pFile);
+            memcpy(m_pImage + (lBytesPerLine * y), pPixels + (lBitmapStride * y), lBytesPerLine);
         }
-        return FALSE;
     }
 
-    // Loop over all the scan lines (all the rows of pixels in the image).
-    for (int y = 0; y < HeaderInfo.biHeight; y++)
-    {
-        // Read the precise number of bytes that the scan line requires into the image.
-        if (!fread(m_pImage + (nBitmapStride * y), nBytesPerLine, 1, pFile))
-        {
-            // Clear image data and attributes.
-            this->Destroy();
-            // Is file still open?
-            if (pFile != NULL)
-            {
-                fclose(pFile);
-            }
-            return FALSE;
-        }
-        // Skip over any padding bytes.
-        if (fseek(pFile, nPaddingBytes, SEEK_CUR))
-        {
-            // Clear image data and attributes.
-            this->Destroy();
-            // Is file still open?
-            if (pFile != NULL)
-            {
-                fclose(pFile);
-            }
-            return FALSE;
-        }
-    }
-
-    // Close the BMP file.
-    fclose(pFile);
-
-    BYTE temp;
-
     // Convert image data from BGR to RGB color format.
-    for (long i = 0; i < m_nImageSize; i += m_nColorBytes)
-    {
-        temp = m_pImage[i+0];
-        m_pImage[i+0] = m_pImage[i+2];
-        m_pImage[i+2] = temp;
-    }
+    SwapRedBlue(m_pImage, m_nImageWidth * m_nImageHeight, m_nColorBytes);
 
     return TRUE;
 }
@@ -748,7 +647,7 @@ BOOL GS_OGLImage::LoadBMP(const char* pszFilename)
 //==============================================================================================
 // GS_OGLImage::LoadPCX():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Maps the PCX file into memory and decodes it with LoadPCX(pData, lLength).
 // ---------------------------------------------------------------------------------------------
 // Returns: TRUE if successful, FALSE if failed.
 //==============================================================================================
@@ -756,201 +655,145 @@ BOOL GS_OGLImage::LoadBMP(const char* pszFilename)
 BOOL GS_OGLImage::LoadPCX(const char* pszFilename)
 {
 
-    // Open the PCX file for reading.
-    FILE* pFile = fopen(pszFilename,"rb");
+    // Do we have a valid filename?
+    if (!pszFilename)
+    {
+        return FALSE;
+    }
+
+    GS_FileMap gsFileMap;
 
-    // Were we able to open the file?
-    if (!pFile)
+    // Read the whole file in one go.
+    if (!gsFileMap.Open(pszFilename))
     {
         return FALSE;
     }
 
-    // Creata an array to hold palette.
-    BYTE Palette[768];
+    return this->LoadPCX(gsFileMap.GetData(), gsFileMap.GetLength());
+}
 
-    // Go to the end of the file (where the palette is located).
-    fseek(pFile, -769, SEEK_END);
 
-    // Read value to see wether it's the palette.
-    int nCurrentValue = fgetc(pFile);
+////////////////////////////////////////////////////////////////////////////////////////////////
 
-    // Are we at the palette?
-    if (nCurrentValue != 12)
+
+//==============================================================================================
+// GS_OGLImage::LoadPCX():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Decodes a RLE compressed 8-bit PCX file with a 256 color palette held in memory.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if failed.
+//==============================================================================================
+
+BOOL GS_OGLImage::LoadPCX(const BYTE* pData, unsigned long lLength)
+{
+
+    // Is there enough data for the header and the palette?
+    if (!pData || (lLength < (sizeof(GS_PCXHeader) + 769)))
     {
-        // Is file still open?
-        if (pFile != NULL)
-        {
-            fclose(pFile);
-        }
         return FALSE;
     }
 
-    // Were we able to read the entire palette?
-    if (!fread(Palette, 1, 768, pFile))
+    // The palette is located at the end of the file, after a marker with the value 12.
+    const BYTE* pPalette = pData + lLength - 768;
+
+    // Are we at the palette?
+    if (pPalette[-1] != 12)
     {
-        // Is file still open?
-        if (pFile != NULL)
-        {
-            fclose(pFile);
-        }
         return FALSE;
     }
 
-    // Return to the beginning of the file.
-    fseek(pFile, 0, SEEK_SET);
-
     // Structure to hold PCX header.
     GS_PCXHeader gsPCXHeader;
+    memcpy(&gsPCXHeader, pData, sizeof(GS_PCXHeader));
 
-    // Were we able to read the entire header?
-    if (!fread(&gsPCXHeader, sizeof(GS_PCXHeader), 1, pFile))
+    // Make sure the file we have is a PCX file we can decode.
+    if ((gsPCXHeader.cManufacturer != 10) || (gsPCXHeader.cVersion != 5) ||
+            (gsPCXHeader.cEncoding != 1) || (gsPCXHeader.cBitsPerPixel != 8) ||
+            (gsPCXHeader.cPlanes != 1))
     {
-        // Is file still open?
-        if (pFile != NULL)
-        {
-            fclose(pFile);
-        }
         return FALSE;
     }
 
-    // Make sure the file we have is a PCX file.
-    if ((gsPCXHeader.cManufacturer != 10) || (gsPCXHeader.cVersion != 5) ||
-            (gsPCXHeader.cEncoding != 1))
+    int nWidth  = gsPCXHeader.wMaxX - gsPCXHeader.wMinX + 1;
+    int nHeight = gsPCXHeader.wMaxY - gsPCXHeader.wMinY + 1;
+
+    if ((nWidth <= 0) || (nHeight <= 0))
     {
-        // Is file still open?
-        if (pFile != NULL)
-        {
-            fclose(pFile);
-        }
         return FALSE;
     }
 
-    // Save image dimensions.
-    m_nImageWidth  = gsPCXHeader.wMaxX - gsPCXHeader.wMinX + 1;
-    m_nImageHeight = gsPCXHeader.wMaxY - gsPCXHeader.wMinY + 1;
-
-    // Image has no alpha component.
-    m_bHasAlpha   = FALSE;
-
-    // Set image color size.
-    m_nColorBytes = 3;
-
-    // Set image size for allocating memory.
-    m_nImageSize = m_nImageWidth * m_nImageHeight * m_nColorBytes;
-
-    // Does image exist already?
-    if (m_pImage != NULL)
+    // Create the image, it has no alpha component.
+    if (!this->Create(nWidth, nHeight, FALSE))
     {
-        // De-allocate memory for image data.
-        delete []m_pImage;
+        return FALSE;
     }
-    m_pImage = NULL;
 
-    // Allocate enough space for the image data.
-    m_pImage = new BYTE [m_nImageSize];
+    // Each scan line is encoded separately and may be padded past the image width.
+    int nBytesPerLine = gsPCXHeader.wBytesPerLine;
 
-    // Were we able to allocate memory?
-    if (!m_pImage)
+    if (nBytesPerLine < nWidth)
     {
-        // Clear image data and attributes.
-        this->Destroy();
-        // Is file still open?
-        if (pFile != NULL)
-        {
-            fclose(pFile);
-        }
-        return FALSE;
+        nBytesPerLine = nWidth;
     }
 
-    /* Varialble to hold postion in file.
-    // int nPosition = 0;
-
-    // Run through the image.
-    while (nPosition < m_nImageSize) {
-       // Get the current character.
-       nCurrentValue = fgetc(pFile);
-       // Is it a status byte (i.e. RLE encoded)?
-       if (nCurrentValue >= 0xc0) {
-          // Get the repeat length.
-          int nRepeatLength = 0x3f & nCurrentValue;
-          // Get the next character in the file.
-          nCurrentValue = fgetc(pFile);
-          // Repeat it the number of times.
-          for (int nLoop = 0; nLoop < nRepeatLength; nLoop++) {
-             // Write the pixel to the image data.
-             m_pImage[nPosition]   = Palette[nCurrentValue*3];
-             m_pImage[nPosition+1] = Palette[nCurrentValue*3+1];
-             m_pImage[nPosition+2] = Palette[nCurrentValue*3+2];
-             // Move forward to the next pixel.
-             nPosition += m_nColorBytes;
-            }
-          }
-       else {
-          // Write the pixel to the image data.
-          m_pImage[nPosition]   = Palette[nCurrentValue*3];
-          m_pImage[nPosition+1] = Palette[nCurrentValue*3+1];
-          m_pImage[nPosition+2] = Palette[nCurrentValue*3+2];
-          // Move forward to the next pixel.
-          nPosition += m_nColorBytes;
-          }
-       } */
-
-    // Varialble to hold postion in file.
-    int nPosition;
+    const BYTE* pRead    = pData + sizeof(GS_PCXHeader); // The next byte in the file.
+    const BYTE* pReadEnd = pPalette - 1;                 // The encoded data ends at the marker.
+
+    int         nRepeatLength = 0;    // Number of pixels left in the current run.
+    const BYTE* pColor        = NULL; // Palette entry of the current run.
 
     // Run through the entire image from bottom to top and left to right thereby flipping
     // the image vertically (otherwise the image will be the wrong side up).
-    for (long y = m_nImageHeight-1; y >= 0; y--)
+    for (int y = m_nImageHeight-1; y >= 0; y--)
     {
-        for (long x = 0; x < m_nImageWidth; x++)
+        BYTE* pWrite = m_pImage + (m_nImageWidth * y * 3);
+
+        for (int x = 0; x < nBytesPerLine; x++)
         {
-            // Get the current character.
-            nCurrentValue = fgetc(pFile);
-            // Is it a status byte (i.e. RLE encoded)?
-            if (nCurrentValue >= 0xc0)
+            // Start a new run when the current one is used up.
+            while (nRepeatLength == 0)
             {
-                // Get the repeat length.
-                int nRepeatLength = 0x3f & nCurrentValue;
-                // Get the next character in the file.
-                nCurrentValue = fgetc(pFile);
-                // Repeat it the number of times.
-                for (int nLoop = 0; nLoop < nRepeatLength; nLoop++)
+                if (pRead >= pReadEnd)
+                {
+                    // Clear image data and attributes.
+                    this->Destroy();
+                    return FALSE;
+                }
+
+                int nCurrentValue = *pRead++;
+                nRepeatLength = 1;
+
+                // Is it a status byte (i.e. RLE encoded)?
+                if (nCurrentValue >= 0xc0)
                 {
-                    // Determine the position of the current pixel.
-                    nPosition = (((m_nImageWidth * y) + x) * m_nColorBytes);
-                    // Write the pixel to the image data.
-                    m_pImage[nPosition]   = Palette[nCurrentValue*3];
-                    m_pImage[nPosition+1] = Palette[nCurrentValue*3+1];
-                    m_pImage[nPosition+2] = Palette[nCurrentValue*3+2];
-                    // Is horizontal value equal to image width?
-                    if (x >= m_nImageWidth)
+                    if (pRead >= pReadEnd)
                     {
-                        // Reset to start of row.
-                        x = 0;
-                        // Start a new row.
-                        y--;
+                        // Clear image data and attributes.
+                        this->Destroy();
+                        return FALSE;
                     }
-                    // Next value in row.
-                    x++;
+
+                    // Get the repeat length and the value to repeat.
+                    nRepeatLength = 0x3f & nCurrentValue;
+                    nCurrentValue = *pRead++;
                 }
-                // Adjust value.
-                x--;
+
+                pColor = &pPalette[nCurrentValue*3];
             }
-            else
+
+            // Write the pixel to the image data, skipping padding past the image width.
+            if (x < m_nImageWidth)
             {
-                // Determine the position of the current pixel.
-                nPosition = (((m_nImageWidth * y) + x) * m_nColorBytes);
-                // Write the pixel to the image data.
-                m_pImage[nPosition]   = Palette[nCurrentValue*3];
-                m_pImage[nPosition+1] = Palette[nCurrentValue*3+1];
-                m_pImage[nPosition+2] = Palette[nCurrentValue*3+2];
+                pWrite[0] = pColor[0];
+                pWrite[1] = pColor[1];
+                pWrite[2] = pColor[2];
+                pWrite += 3;
             }
+
+            nRepeatLength--;
         }
     }
 
-    // Close the PCX file.
-    fclose(pFile);
-
     return TRUE;
 }
 
@@ -961,7 +804,7 @@ BOOL GS_OGLImage::LoadPCX(const char* pszFilename)
 //==============================================================================================
 // GS_OGLImage::LoadTGA():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Maps the TGA file into memory and decodes it with LoadTGA(pData, lLength).
 // ---------------------------------------------------------------------------------------------
 // Returns: TRUE if successful, FALSE if failed.
 //==============================================================================================
@@ -969,29 +812,41 @@ BOOL GS_OGLImage::LoadPCX(const char* pszFilename)
 BOOL GS_OGLImage::LoadTGA(const char* pszFilename)
 {
 
-    // Pointer to TGA image file.
-    FILE* pFile;
+    // Do we have a valid filename?
+    if (!pszFilename)
+    {
+        return FALSE;
+    }
 
-    // Open the TGA file for reading.
-    pFile = fopen(pszFilename, "rb");
+    GS_FileMap gsFileMap;
 
-    // Were we able to open the file?
-    if (pFile == NULL)
+    // Read the whole file in one go.
+    if (!gsFileMap.Open(pszFilename))
     {
         return FALSE;
     }
 
-    // Variable to store TGA header.
-    BYTE TGAHeader[12] = { 0,0,0,0,0,0,0,0,0,0,0,0 };
+    return this->LoadTGA(gsFileMap.GetData(), gsFileMap.GetLength());
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLImage::LoadTGA():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Decodes an uncompressed or RLE compressed 24-bit or 32-bit TGA file held in memory.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if failed.
+//==============================================================================================
 
-    // Attempt to read 12 byte header from file.
-    if (fread(TGAHeader, sizeof(TGAHeader), 1, pFile) == 0)
+BOOL GS_OGLImage::LoadTGA(const BYTE* pData, unsigned long lLength)
+{
+
+    // Is there enough data for the 12 byte header?
+    if (!pData || (lLength < 12))
     {
-        // Is file still open?
-        if (pFile != NULL)
-        {
-            fclose(pFile);
-        }
         return FALSE;
     }
 
@@ -999,25 +854,20 @@ BOOL GS_OGLImage::LoadTGA(const char* pszFilename)
     BYTE CompressedTGA[12]   = { 0,0,10,0,0,0,0,0,0,0,0,0 }; // Compressed TGA header.
 
     // See if header matches the predefined header of an uncompressed TGA image.
-    if (memcmp(UncompressedTGA, TGAHeader, sizeof(TGAHeader)) == 0)
+    if (memcmp(UncompressedTGA, pData, 12) == 0)
     {
         // If so, jump to uncompressed TGA loading code.
-        LoadUncompressedTGA(pFile);
+        return this->LoadUncompressedTGA(pData, lLength);
     }
     // See if header matches the predefined header of an RLE compressed TGA image.
-    else if(memcmp(CompressedTGA, TGAHeader, sizeof(TGAHeader)) == 0)
+    else if (memcmp(CompressedTGA, pData, 12) == 0)
     {
         // If so, jump to compressed TGA loading code.
-        LoadCompressedTGA(pFile);
-    }
-    // If header matches neither type.
-    else
-    {
-        fclose(pFile);
-        return FALSE;
+        return this->LoadCompressedTGA(pData, lLength);
     }
 
-    return TRUE;
+    // If header matches neither type.
+    return FALSE;
 }
 
 
@@ -34,6 +34,7 @@
 // Include Game System (GS) header files.
 // ---------------------------------------------------------------------------------------------
 #include "gs_error.h"
+#include "gs_file_map.h"
 #include "gs_object.h"
 #include "gs_ogl_color.h"
 //==============================================================================================
@@ -42,6 +43,8 @@
 //==============================================================================================
 // TGA image structures.
 // ---------------------------------------------------------------------------------------------
+#define GS_TGA_HEADER_SIZE 18 // The 12 byte header plus the 6 bytes of image information.
+// ---------------------------------------------------------------------------------------------
 typedef struct TGAHEADER
 {
     BYTE Header[12];
@@ -116,8 +119,11 @@ private:
         return (((y * m_nImageWidth) + x) * m_nColorBytes);
     };
 
-    BOOL LoadUncompressedTGA(FILE *pFile);
-    BOOL LoadCompressedTGA(FILE *pFile);
+    BOOL CreateFromTGAHeader(const BYTE* pData, unsigned long lLength);
+    BOOL LoadUncompressedTGA(const BYTE* pData, unsigned long lLength);
+    BOOL LoadCompressedTGA(const BYTE* pData, unsigned long lLength);
+
+    static void SwapRedBlue(BYTE* pPixels, int nNumPixels, int nColorBytes);
 
 protected:
 
@@ -136,6 +142,10 @@ public:
     BOOL LoadPCX(const char* pszFilename);
     BOOL LoadTGA(const char* pszFilename);
 
+    BOOL LoadBMP(const BYTE* pData, unsigned long lLength);
+    BOOL LoadPCX(const BYTE* pData, unsigned long lLength);
+    BOOL LoadTGA(const BYTE* pData, unsigned long lLength);
+
     void        SetPixel(int x, int y, GS_OGLColor gsColor);
     GS_OGLColor GetPixel(int x, int y);
 
@@ -15,6 +15,7 @@
 // Include Game System (GS) header files.
 // ---------------------------------------------------------------------------------------------
 #include "gs_ogl_map.h"
+#include "gs_ogl_state.h"
 //==============================================================================================
 
 
@@ -34,13 +35,6 @@
 GS_OGLMap::GS_OGLMap()
 {
 
-    for (int nRows = 0; nRows < MAX_MAP_ROWS; nRows++)
-    {
-        for (int nCols = 0; nCols < MAX_MAP_COLS; nCols++)
-        {
-            m_nMap[nRows][nCols] = -1;
-        }
-    }
     m_nNumCols = 0;
     m_nNumRows = 0;
 
@@ -62,6 +56,16 @@ GS_OGLMap::GS_OGLMap()
     m_bWrapX  = FALSE;
     m_bWrapY  = FALSE;
 
+    m_pChunks       = NULL;
+    m_nNumChunkCols = 0;
+    m_nNumChunkRows = 0;
+
+    m_pTileFlags    = NULL;
+    m_nNumTileFlags = 0;
+
+    m_glfChunkScaleX = 1.0f;
+    m_glfChunkScaleY = 1.0f;
+
     m_bIsReady = FALSE;
 }
 
@@ -119,6 +123,9 @@ BOOL GS_OGLMap::Create(const char* pszPathname, int nTotalTiles, int nTilesPerLi
     m_nTileWidth  = nTileWidth;
     m_nTileHeight = nTileHeight;
 
+    // Any cached chunks refer to the previous tile sprites.
+    this->SetAllChunksDirty();
+
     m_bIsReady = TRUE;
 
     return TRUE;
@@ -151,6 +158,9 @@ BOOL GS_OGLMap::Create(GLuint glTexture, int nWidth, int nHeight, int nTotalTile
     m_nTileWidth  = nTileWidth;
     m_nTileHeight = nTileHeight;
 
+    // Any cached chunks refer to the previous tile sprites.
+    this->SetAllChunksDirty();
+
     m_bIsReady = TRUE;
 
     return TRUE;
@@ -171,6 +181,15 @@ BOOL GS_OGLMap::Create(GLuint glTexture, int nWidth, int nHeight, int nTotalTile
 void GS_OGLMap::Destroy()
 {
 
+    // A map can be loaded before the map is created, so always free the chunks.
+    this->DestroyChunks();
+    m_nNumCols = 0;
+    m_nNumRows = 0;
+
+    // Tile flags can also be set before the map is created.
+    GS_SAFE_DELETE_ARRAY(m_pTileFlags);
+    m_nNumTileFlags = 0;
+
     if (!m_bIsReady)
     {
         return;
@@ -178,16 +197,6 @@ void GS_OGLMap::Destroy()
 
     m_gsTileSprites.Destroy();
 
-    for (int nRows = 0; nRows < MAX_MAP_ROWS; nRows++)
-    {
-        for (int nCols = 0; nCols < MAX_MAP_COLS; nCols++)
-        {
-            m_nMap[nRows][nCols] = -1;
-        }
-    }
-    m_nNumCols = 0;
-    m_nNumRows = 0;
-
     m_rcClipBox.left   = 0;
     m_rcClipBox.top    = 0;
     m_rcClipBox.right  = 0;
@@ -230,57 +239,181 @@ BOOL GS_OGLMap::Render(int nMapCoordX, int nMapCoordY, HWND hWnd)
 {
 
     // Can't render if no valid sprite or map.
-    if ((!m_bIsReady) || (m_nNumCols <= 0) || (m_nNumRows <= 0))
+    if ((!m_bIsReady) || (m_nNumCols <= 0) || (m_nNumRows <= 0) || (NULL == m_pChunks))
     {
         return FALSE;
     }
 
+    GS_PROFILE_SCOPE("GS_OGLMap::Render");
+
     /////////////////////////////////////////////////////////////////////////////////////////////
     // Create a scissor box. ////////////////////////////////////////////////////////////////////
     /////////////////////////////////////////////////////////////////////////////////////////////
 
+    // Quads queued before the map must not be clipped.
+    GS_SpriteBatch::FlushActive();
+
+    GS_OGLState* pgsState = GS_OGLState::GetActive();
+
     // Create a window (called a scissor box) that will automatically clip any rendering to fit.
-    glScissor
+    // The scissor box is in window pixels, which only differ from the render resolution when
+    // the display has no render target to draw to.
+    pgsState->Scissor
     (
         m_rcClipBox.left * g_fScaleFactorX + g_fRenderModX,
         m_rcClipBox.bottom * g_fScaleFactorY + g_fRenderModY,
-        (m_rcClipBox.right - m_rcClipBox.left) * g_fScaleFactorX + g_fRenderModX,
-        (m_rcClipBox.top - m_rcClipBox.bottom) * g_fScaleFactorY + g_fRenderModY
+        (m_rcClipBox.right - m_rcClipBox.left) * g_fScaleFactorX,
+        (m_rcClipBox.top - m_rcClipBox.bottom) * g_fScaleFactorY
     );
 
     // Enable the scissor box.
-    glEnable(GL_SCISSOR_TEST);
+    pgsState->Enable(GL_SCISSOR_TEST);
+
+    /////////////////////////////////////////////////////////////////////////////////////////////
+    // Determine the visible tiles. /////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////
+
+    // The screen coordinates of the bottom left corner of the map.
+    int nOriginX = m_rcClipBox.left   + nMapCoordX;
+    int nOriginY = m_rcClipBox.bottom + nMapCoordY;
+
+    // Determine the first and last column and row overlapping the clip box area.
+    int nFirstCol = (int) floor(float(m_rcClipBox.left   - nOriginX) / m_nTileWidth);
+    int nLastCol  = (int) ceil (float(m_rcClipBox.right  - nOriginX) / m_nTileWidth)  - 1;
+    int nFirstRow = (int) floor(float(m_rcClipBox.bottom - nOriginY) / m_nTileHeight);
+    int nLastRow  = (int) ceil (float(m_rcClipBox.top    - nOriginY) / m_nTileHeight) - 1;
+
+    // Keep the range within the map.
+    if (nFirstCol < 0)
+    {
+        nFirstCol = 0;
+    }
+    if (nLastCol >= m_nNumCols)
+    {
+        nLastCol = m_nNumCols - 1;
+    }
+    if (nFirstRow < 0)
+    {
+        nFirstRow = 0;
+    }
+    if (nLastRow >= m_nNumRows)
+    {
+        nLastRow = m_nNumRows - 1;
+    }
 
     /////////////////////////////////////////////////////////////////////////////////////////////
     // Render the map. //////////////////////////////////////////////////////////////////////////
     /////////////////////////////////////////////////////////////////////////////////////////////
 
-    // For every element of the map.
-    for (int nRow = 0; nRow < m_nNumRows; nRow++)
+    // Is any part of the map visible?
+    if ((nFirstCol <= nLastCol) && (nFirstRow <= nLastRow))
     {
-        for (int nCol = 0; nCol < m_nNumCols; nCol++)
+        // Setup display for 2D rendering.
+        if (hWnd != NULL)
         {
-            // Is the map element visible?
-            if (m_nMap[nRow][nCol] != m_nClearTileID)
-            {
-                // Set the tile image depending on the map.
-                m_gsTileSprites.SetFrame(m_nMap[nRow][nCol]);
-                // Determine the x and y coordinates at which to render the tile image.
-                int nDestX = m_rcClipBox.left   + nMapCoordX + (m_nTileWidth  * nCol);
-                int nDestY = m_rcClipBox.bottom + nMapCoordY + (m_nTileHeight * nRow);
-                // Does the tile overlap the clip box area?
-                if ((nDestX > m_rcClipBox.left   -  m_nTileWidth) &&
-                        (nDestX < m_rcClipBox.right) &&
-                        (nDestY > m_rcClipBox.bottom - m_nTileHeight) &&
-                        (nDestY < m_rcClipBox.top))
+            m_gsTileSprites.BeginRender(hWnd);
+        }
+
+        // Rotated tiles turn around their own centres, which can't be done by transforming
+        // whole chunks, so draw the visible tiles one by one like the sprites they are.
+        if ((m_gsTileSprites.GetRotateX() != 0.0f) || (m_gsTileSprites.GetRotateY() != 0.0f) ||
+            (m_gsTileSprites.GetRotateZ() != 0.0f))
+        {
+            for (int nRow = nFirstRow; nRow <= nLastRow; nRow++)
+            {
+                for (int nCol = nFirstCol; nCol <= nLastCol; nCol++)
+                {
+                    int nTileID = this->GetTileID(nRow, nCol);
+
+                    // Is the map element visible?
+                    if (nTileID == m_nClearTileID)
+                    {
+                        continue;
+                    }
+
+                    m_gsTileSprites.SetFrame(nTileID);
+                    m_gsTileSprites.SetDestX(nOriginX + (m_nTileWidth  * nCol));
+                    m_gsTileSprites.SetDestY(nOriginY + (m_nTileHeight * nRow));
+                    m_gsTileSprites.Render();
+                }
+            }
+
+            // Draw tiles queued by a sprite batch while the scissor box is still enabled.
+            GS_SpriteBatch::FlushActive();
+        }
+        else
+        {
+            // The chunks are built at the scale of the tiles, rebuild them when it changes.
+            if ((m_glfChunkScaleX != m_gsTileSprites.GetScaleX()) ||
+                (m_glfChunkScaleY != m_gsTileSprites.GetScaleY()))
+            {
+                m_glfChunkScaleX = m_gsTileSprites.GetScaleX();
+                m_glfChunkScaleY = m_gsTileSprites.GetScaleY();
+                this->SetAllChunksDirty();
+            }
+
+            // The chunks are built in map pixels, so position them as a whole.
+            glLoadIdentity();
+            glTranslatef((GLfloat) nOriginX, (GLfloat) nOriginY, 0.0f);
+
+            // Scroll the tile images by moving the texture coordinates of all chunks at once.
+            GLfloat glfScrollX = m_gsTileSprites.GetScrollX();
+            GLfloat glfScrollY = m_gsTileSprites.GetScrollY();
+            BOOL    bIsScrolled = (glfScrollX != 0.0f) || (glfScrollY != 0.0f);
+
+            if (bIsScrolled)
+            {
+                glMatrixMode(GL_TEXTURE);
+                glLoadIdentity();
+                glTranslatef(glfScrollX / m_gsTileSprites.GetTextureWidth(),
+                             glfScrollY / m_gsTileSprites.GetTextureHeight(), 0.0f);
+                glMatrixMode(GL_MODELVIEW);
+            }
+
+            // Draw tiles in a different hue or even with transparency.
+            GS_OGLColor gsColor;
+            m_gsTileSprites.GetModulateColor(&gsColor);
+            pgsState->Color(gsColor.fRed, gsColor.fGreen, gsColor.fBlue, gsColor.fAlpha);
+
+            // Select the tile texture.
+            pgsState->BindTexture(m_gsTileSprites.GetTextureID());
+
+            // Draw every chunk overlapping the visible tiles, rebuilding it if it has changed.
+            for (int nChunkRow = nFirstRow / GS_MAP_CHUNK_SIZE;
+                    nChunkRow <= nLastRow / GS_MAP_CHUNK_SIZE; nChunkRow++)
+            {
+                for (int nChunkCol = nFirstCol / GS_MAP_CHUNK_SIZE;
+                        nChunkCol <= nLastCol / GS_MAP_CHUNK_SIZE; nChunkCol++)
                 {
-                    // Set the tile coordinates.
-                    m_gsTileSprites.SetDestX(nDestX);
-                    m_gsTileSprites.SetDestY(nDestY);
-                    // Render the tile.
-                    m_gsTileSprites.Render(hWnd);
+                    GS_MapChunk* pChunk =
+                        &m_pChunks[(nChunkRow * m_nNumChunkCols) + nChunkCol];
+
+                    if (pChunk->bIsDirty)
+                    {
+                        this->BuildChunk(nChunkRow, nChunkCol);
+                    }
+
+                    if ((pChunk->gluList != 0) && (pChunk->nNumQuads > 0))
+                    {
+                        glCallList(pChunk->gluList);
+                        GS_Profiler::CountDrawCall(pChunk->nNumQuads * 4);
+                    }
                 }
             }
+
+            // Leave the texture coordinates of whatever is drawn next alone.
+            if (bIsScrolled)
+            {
+                glMatrixMode(GL_TEXTURE);
+                glLoadIdentity();
+                glMatrixMode(GL_MODELVIEW);
+            }
+        }
+
+        // Reset display after 2D rendering.
+        if (hWnd != NULL)
+        {
+            m_gsTileSprites.EndRender();
         }
     }
 
@@ -289,7 +422,7 @@ BOOL GS_OGLMap::Render(int nMapCoordX, int nMapCoordY, HWND hWnd)
     /////////////////////////////////////////////////////////////////////////////////////////////
 
     // Disable the scissor box.
-    glDisable(GL_SCISSOR_TEST);
+    pgsState->Disable(GL_SCISSOR_TEST);
 
     return TRUE;
 }
@@ -414,6 +547,233 @@ BOOL GS_OGLMap::Render(HWND hWnd)
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Chunk Methods. //////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::CreateChunks():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Creates an empty chunk for every GS_MAP_CHUNK_SIZE by GS_MAP_CHUNK_SIZE block of
+//          tiles in the map. The tiles of a chunk are only allocated when one of them is set and
+//          the geometry of a chunk is only built when the chunk is first drawn.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLMap::CreateChunks()
+{
+
+    // Free any previously created chunks.
+    this->DestroyChunks();
+
+    if ((m_nNumCols <= 0) || (m_nNumRows <= 0))
+    {
+        return FALSE;
+    }
+
+    m_nNumChunkCols = (m_nNumCols + GS_MAP_CHUNK_SIZE - 1) / GS_MAP_CHUNK_SIZE;
+    m_nNumChunkRows = (m_nNumRows + GS_MAP_CHUNK_SIZE - 1) / GS_MAP_CHUNK_SIZE;
+
+    m_pChunks = new GS_MapChunk[m_nNumChunkCols * m_nNumChunkRows];
+
+    if (NULL == m_pChunks)
+    {
+        GS_Error::Report("GS_OGL_MAP.CPP", 511, "Failed to allocate map chunks!");
+        m_nNumChunkCols = 0;
+        m_nNumChunkRows = 0;
+        return FALSE;
+    }
+
+    for (int nLoop = 0; nLoop < m_nNumChunkCols * m_nNumChunkRows; nLoop++)
+    {
+        m_pChunks[nLoop].pTiles    = NULL;
+        m_pChunks[nLoop].pFlags    = NULL;
+        m_pChunks[nLoop].gluList   = 0;
+        m_pChunks[nLoop].nNumQuads = 0;
+        m_pChunks[nLoop].bIsDirty  = TRUE;
+    }
+
+    return TRUE;
+}
+
+
+//==============================================================================================
+// GS_OGLMap::DestroyChunks():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Deletes the display lists of all chunks and frees the chunks and their tiles.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLMap::DestroyChunks()
+{
+
+    if (m_pChunks != NULL)
+    {
+        for (int nLoop = 0; nLoop < m_nNumChunkCols * m_nNumChunkRows; nLoop++)
+        {
+            if (m_pChunks[nLoop].gluList != 0)
+            {
+                glDeleteLists(m_pChunks[nLoop].gluList, 1);
+            }
+
+            GS_SAFE_DELETE_ARRAY(m_pChunks[nLoop].pTiles);
+            GS_SAFE_DELETE_ARRAY(m_pChunks[nLoop].pFlags);
+        }
+    }
+
+    GS_SAFE_DELETE_ARRAY(m_pChunks);
+
+    m_nNumChunkCols = 0;
+    m_nNumChunkRows = 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::BuildChunk():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Compiles the tiles of a chunk into its display list. The vertices are in map pixels
+//          relative to the bottom left corner of the map, Render() positions and scales them.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLMap::BuildChunk(int nChunkRow, int nChunkCol)
+{
+
+    GS_MapChunk* pChunk = &m_pChunks[(nChunkRow * m_nNumChunkCols) + nChunkCol];
+
+    // Create the display list the first time the chunk is built.
+    if (pChunk->gluList == 0)
+    {
+        pChunk->gluList = glGenLists(1);
+
+        if (pChunk->gluList == 0)
+        {
+            GS_Error::Report("GS_OGL_MAP.CPP", 584, "Failed to create map chunk display list!");
+            return;
+        }
+    }
+
+    // The tiles in the chunk (chunks on the edge of the map may be smaller).
+    int nFirstRow = nChunkRow * GS_MAP_CHUNK_SIZE;
+    int nFirstCol = nChunkCol * GS_MAP_CHUNK_SIZE;
+    int nLastRow  = nFirstRow + GS_MAP_CHUNK_SIZE;
+    int nLastCol  = nFirstCol + GS_MAP_CHUNK_SIZE;
+
+    if (nLastRow > m_nNumRows)
+    {
+        nLastRow = m_nNumRows;
+    }
+    if (nLastCol > m_nNumCols)
+    {
+        nLastCol = m_nNumCols;
+    }
+
+    // Texture dimensions for converting frame rectangles to texture coordinates.
+    GLfloat fTextureWidth  = (GLfloat) m_gsTileSprites.GetTextureWidth();
+    GLfloat fTextureHeight = (GLfloat) m_gsTileSprites.GetTextureHeight();
+
+    // The size at which tiles are drawn.
+    GLfloat fQuadWidth  = m_gsTileSprites.GetFrameWidth();
+    GLfloat fQuadHeight = m_gsTileSprites.GetFrameHeight();
+
+    GLfloat* pVertex = m_fChunkVertices;
+    int nNumQuads = 0;
+
+    for (int nRow = nFirstRow; nRow < nLastRow; nRow++)
+    {
+        for (int nCol = nFirstCol; nCol < nLastCol; nCol++)
+        {
+            int nTileID = this->GetTileID(nRow, nCol);
+
+            // Is the map element visible?
+            if (nTileID == m_nClearTileID)
+            {
+                continue;
+            }
+
+            RECT rcFrame;
+            m_gsTileSprites.GetFrameRect(nTileID, &rcFrame);
+
+            GLfloat fLeft   = rcFrame.left   / fTextureWidth;
+            GLfloat fBottom = rcFrame.bottom / fTextureHeight;
+            GLfloat fRight  = rcFrame.right  / fTextureWidth;
+            GLfloat fTop    = rcFrame.top    / fTextureHeight;
+
+            GLfloat fX1 = (GLfloat) (nCol * m_nTileWidth);
+            GLfloat fY1 = (GLfloat) (nRow * m_nTileHeight);
+            GLfloat fX2 = fX1 + fQuadWidth;
+            GLfloat fY2 = fY1 + fQuadHeight;
+
+            // Bottom left, bottom right, top right and top left texture coordinate and vertex.
+            *pVertex++ = fLeft;  *pVertex++ = fBottom; *pVertex++ = fX1; *pVertex++ = fY1;
+            *pVertex++ = fRight; *pVertex++ = fBottom; *pVertex++ = fX2; *pVertex++ = fY1;
+            *pVertex++ = fRight; *pVertex++ = fTop;    *pVertex++ = fX2; *pVertex++ = fY2;
+            *pVertex++ = fLeft;  *pVertex++ = fTop;    *pVertex++ = fX1; *pVertex++ = fY2;
+
+            nNumQuads++;
+        }
+    }
+
+    // Compile the quads into the display list (the vertex data is copied into the list).
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+
+    glTexCoordPointer(2, GL_FLOAT, 4 * sizeof(GLfloat), &m_fChunkVertices[0]);
+    glVertexPointer(2, GL_FLOAT, 4 * sizeof(GLfloat), &m_fChunkVertices[2]);
+
+    glNewList(pChunk->gluList, GL_COMPILE);
+
+    if (nNumQuads > 0)
+    {
+        glDrawArrays(GL_QUADS, 0, nNumQuads * 4);
+    }
+
+    glEndList();
+
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    pChunk->nNumQuads = nNumQuads;
+    pChunk->bIsDirty  = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::SetAllChunksDirty():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Marks all chunks to be rebuilt before they are drawn.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLMap::SetAllChunksDirty()
+{
+
+    if (NULL == m_pChunks)
+    {
+        return;
+    }
+
+    for (int nLoop = 0; nLoop < m_nNumChunkCols * m_nNumChunkRows; nLoop++)
+    {
+        m_pChunks[nLoop].bIsDirty = TRUE;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // ClipBox Methods. ///////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -576,6 +936,45 @@ int GS_OGLMap::GetClipBoxHeight()
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+//==============================================================================================
+// GS_OGLMap::CreateMap():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Creates an empty map of the specified size, replacing the current map. Tiles are only
+//          allocated (a chunk at a time) once they are set, so large maps that are mostly empty
+//          use little memory.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if failed.
+//==============================================================================================
+
+BOOL GS_OGLMap::CreateMap(int nNumRows, int nNumCols)
+{
+
+    // Are the row and column values valid?
+    if ((nNumRows <= 0) || (nNumCols <= 0) ||
+            (nNumRows > GS_MAP_MAX_SIZE) || (nNumCols > GS_MAP_MAX_SIZE))
+    {
+        return FALSE;
+    }
+
+    // Save map dimensions.
+    m_nNumCols = nNumCols;
+    m_nNumRows = nNumRows;
+
+    // Create the chunks holding the tiles.
+    if (!this->CreateChunks())
+    {
+        m_nNumCols = 0;
+        m_nNumRows = 0;
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
 // GS_OGLMap::LoadMap():
 // ---------------------------------------------------------------------------------------------
@@ -605,17 +1004,14 @@ BOOL GS_OGLMap::LoadMap(const char* pszPathname, int nNumRows, int nNumCols)
         return FALSE;
     }
 
-    // Make sure map is not too large.
-    if (nNumRows > MAX_MAP_ROWS)
-    {
-        nNumRows =  MAX_MAP_ROWS;
-    }
-    if (nNumCols > MAX_MAP_COLS)
+    // Create an empty map to read the values into.
+    if (!this->CreateMap(nNumRows, nNumCols))
     {
-        nNumCols =  MAX_MAP_COLS;
+        gsMapFile.Close();
+        return FALSE;
     }
 
-    // Read all the values from the file into the map array.
+    // Read all the values from the file into the map.
     for (int nRows = nNumRows - 1; nRows >= 0; nRows--)
     {
         for (int nCols = 0; nCols < nNumCols; nCols++)
@@ -632,30 +1028,26 @@ BOOL GS_OGLMap::LoadMap(const char* pszPathname, int nNumRows, int nNumCols)
             if ((nTemp >= 48) && (nTemp <= 57))
             {
                 // 0 - 9 is 0 - 9.
-                m_nMap[nRows][nCols] = nTemp - 48;
+                this->SetTileID(nRows, nCols, nTemp - 48);
             }
             else if ((nTemp >= 65) && (nTemp <= 90))
             {
                 // A - Z is 10 to 35.
-                m_nMap[nRows][nCols] = nTemp - 55;
+                this->SetTileID(nRows, nCols, nTemp - 55);
             }
             else if ((nTemp >= 97) && (nTemp <= 122))
             {
                 // a - z is 36 to 61.
-                m_nMap[nRows][nCols] = nTemp - 61;
+                this->SetTileID(nRows, nCols, nTemp - 61);
             }
             else
             {
                 // Unrecognised value.
-                m_nMap[nRows][nCols] = -1;
+                this->SetTileID(nRows, nCols, -1);
             }
         }
     }
 
-    // Save map dimensions.
-    m_nNumCols = nNumCols;
-    m_nNumRows = nNumRows;
-
     // Close the map file.
     gsMapFile.Close();
 
@@ -691,25 +1083,27 @@ BOOL GS_OGLMap::SaveMap(const char* pszPathname)
         return FALSE;
     }
 
-    // Write all the values from the map array to the file.
+    // Write all the values from the map to the file.
     for (int nRows = m_nNumRows - 1; nRows >= 0; nRows--)
     {
         for (int nCols = 0; nCols < m_nNumCols; nCols++)
         {
+            int nTileID = this->GetTileID(nRows, nCols);
+
             // Write numbers 0 - 9 as characters '0' - '9'.
-            if ((m_nMap[nRows][nCols] >= 0) && (m_nMap[nRows][nCols] <= 9))
+            if ((nTileID >= 0) && (nTileID <= 9))
             {
-                gsMapFile.PutByte((unsigned short)(m_nMap[nRows][nCols] + 48));
+                gsMapFile.PutByte((unsigned short)(nTileID + 48));
             }
             // Write numbers 10 - 35 as characters 'A' - 'Z'.
-            else if ((m_nMap[nRows][nCols] >= 10) && (m_nMap[nRows][nCols] <= 35))
+            else if ((nTileID >= 10) && (nTileID <= 35))
             {
-                gsMapFile.PutByte((unsigned short)(m_nMap[nRows][nCols] + 55));
+                gsMapFile.PutByte((unsigned short)(nTileID + 55));
             }
             // Write numbers 36 - 61 as characters 'a' - 'z'.
-            else if ((m_nMap[nRows][nCols] >= 36) && (m_nMap[nRows][nCols] <= 61))
+            else if ((nTileID >= 36) && (nTileID <= 61))
             {
-                gsMapFile.PutByte((unsigned short)(m_nMap[nRows][nCols] + 61));
+                gsMapFile.PutByte((unsigned short)(nTileID + 61));
             }
             else
             {
@@ -736,62 +1130,303 @@ BOOL GS_OGLMap::SaveMap(const char* pszPathname)
 
 
 //==============================================================================================
-// GS_OGLMap::SetMapX():
+// GS_OGLMap::LoadBinaryMap():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Loads a map saved by SaveBinaryMap(), replacing the current map. The file is mapped
+//          into memory and the stored chunks are copied straight into the map, so no per tile
+//          parsing is done. The whole file is validated before the current map is replaced.
 // ---------------------------------------------------------------------------------------------
-// Returns: Nothing.
+// Returns: TRUE if successful, FALSE if failed.
 //==============================================================================================
 
-void GS_OGLMap::SetMapX(int nDestX)
+BOOL GS_OGLMap::LoadBinaryMap(const char* pszPathname)
 {
 
-    m_nMapCoordX = nDestX;
-}
+    // Do we have a valid filename?
+    if (NULL == pszPathname)
+    {
+        return FALSE;
+    }
 
+    GS_FileMap gsMapFile;
 
-//==============================================================================================
-// GS_OGLMap::SetMapY():
-// ---------------------------------------------------------------------------------------------
-// Purpose: ...
-// ---------------------------------------------------------------------------------------------
-// Returns: Nothing.
-//==============================================================================================
+    // Were we able to map the file into memory?
+    if (FALSE == gsMapFile.Open(pszPathname))
+    {
+        return FALSE;
+    }
 
-void GS_OGLMap::SetMapY(int nDestY)
-{
+    const BYTE* pData = gsMapFile.GetData();
+    unsigned long lLength = gsMapFile.GetLength();
 
-    m_nMapCoordY = nDestY;
-}
+    const unsigned long lChunkBytes = GS_MAP_CHUNK_SIZE * GS_MAP_CHUNK_SIZE * sizeof(WORD);
 
+    /////////////////////////////////////////////////////////////////////////////////////////////
+    // Validate the file. ///////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////
 
-//==============================================================================================
-// GS_OGLMap::GetMapX():
+    GS_MapFileHeader gsHeader;
+
+    if (lLength < sizeof(GS_MapFileHeader))
+    {
+        return FALSE;
+    }
+
+    memcpy(&gsHeader, pData, sizeof(GS_MapFileHeader));
+    this->ConvertByteOrder(&gsHeader);
+
+    // Is this a binary map file we can read? The dimensions are bounded so the sizes worked
+    // out from them can't overflow.
+    if ((memcmp(gsHeader.szMagic, GS_MAP_FILE_MAGIC, 4) != 0) ||
+            (gsHeader.wVersion < 1) || (gsHeader.wVersion > GS_MAP_FILE_VERSION) ||
+            (gsHeader.wChunkSize != GS_MAP_CHUNK_SIZE) ||
+            (gsHeader.dwNumRows == 0) || (gsHeader.dwNumRows > GS_MAP_MAX_SIZE) ||
+            (gsHeader.dwNumCols == 0) || (gsHeader.dwNumCols > GS_MAP_MAX_SIZE))
+    {
+        return FALSE;
+    }
+
+    size_t nNumChunks = ((size_t) (gsHeader.dwNumRows + GS_MAP_CHUNK_SIZE - 1) /
+                         GS_MAP_CHUNK_SIZE) *
+                        ((size_t) (gsHeader.dwNumCols + GS_MAP_CHUNK_SIZE - 1) /
+                         GS_MAP_CHUNK_SIZE);
+
+    // Does the layer table fit in the file?
+    if ((gsHeader.dwLayerOffset > lLength) ||
+            (gsHeader.dwNumLayers > (lLength - gsHeader.dwLayerOffset) / sizeof(GS_MapFileLayer)))
+    {
+        return FALSE;
+    }
+
+    for (DWORD dwLayer = 0; dwLayer < gsHeader.dwNumLayers; dwLayer++)
+    {
+        GS_MapFileLayer gsLayer;
+        memcpy(&gsLayer, pData + gsHeader.dwLayerOffset + (dwLayer * sizeof(GS_MapFileLayer)),
+               sizeof(GS_MapFileLayer));
+        this->ConvertByteOrder(&gsLayer);
+
+        // Skip layers we don't know.
+        if (gsLayer.dwType != GS_MAP_LAYER_TILES)
+        {
+            continue;
+        }
+
+        // Does the chunk table fit in the file, and are there no more chunks than the map has?
+        if ((gsLayer.dwChunkOffset > lLength) ||
+                (gsLayer.dwNumChunks >
+                 (lLength - gsLayer.dwChunkOffset) / sizeof(GS_MapFileChunk)) ||
+                (gsLayer.dwNumChunks > nNumChunks))
+        {
+            return FALSE;
+        }
+
+        for (DWORD dwChunk = 0; dwChunk < gsLayer.dwNumChunks; dwChunk++)
+        {
+            GS_MapFileChunk gsChunk;
+            memcpy(&gsChunk, pData + gsLayer.dwChunkOffset + (dwChunk * sizeof(GS_MapFileChunk)),
+                   sizeof(GS_MapFileChunk));
+            this->ConvertByteOrder(&gsChunk);
+
+            // Is the chunk part of the map and do its values fit in the file?
+            if ((gsChunk.dwChunkIndex >= nNumChunks) ||
+                    (gsChunk.dwDataOffset > lLength) ||
+                    (lChunkBytes > lLength - gsChunk.dwDataOffset))
+            {
+                return FALSE;
+            }
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////////////////
+    // Load the map. ////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////
+
+    // Create an empty map to copy the chunks into.
+    if (!this->CreateMap(gsHeader.dwNumRows, gsHeader.dwNumCols))
+    {
+        return FALSE;
+    }
+
+    for (DWORD dwLayer = 0; dwLayer < gsHeader.dwNumLayers; dwLayer++)
+    {
+        GS_MapFileLayer gsLayer;
+        memcpy(&gsLayer, pData + gsHeader.dwLayerOffset + (dwLayer * sizeof(GS_MapFileLayer)),
+               sizeof(GS_MapFileLayer));
+        this->ConvertByteOrder(&gsLayer);
+
+        if (gsLayer.dwType != GS_MAP_LAYER_TILES)
+        {
+            continue;
+        }
+
+        for (DWORD dwChunk = 0; dwChunk < gsLayer.dwNumChunks; dwChunk++)
+        {
+            GS_MapFileChunk gsChunk;
+            memcpy(&gsChunk, pData + gsLayer.dwChunkOffset + (dwChunk * sizeof(GS_MapFileChunk)),
+                   sizeof(GS_MapFileChunk));
+            this->ConvertByteOrder(&gsChunk);
+
+            GS_MapChunk* pChunk = &m_pChunks[gsChunk.dwChunkIndex];
+
+            if ((NULL == pChunk->pTiles) && (!this->CreateChunkTiles(pChunk)))
+            {
+                this->DestroyChunks();
+                m_nNumCols = 0;
+                m_nNumRows = 0;
+                return FALSE;
+            }
+
+            // Copy the chunk values and set the collision flags of the loaded tiles.
+            memcpy(pChunk->pTiles, pData + gsChunk.dwDataOffset, lChunkBytes);
+            this->ConvertByteOrder(pChunk->pTiles, GS_MAP_CHUNK_SIZE * GS_MAP_CHUNK_SIZE);
+            this->BuildFlags(pChunk);
+            pChunk->bIsDirty = TRUE;
+        }
+    }
+
+    // The file is unmapped when gsMapFile goes out of scope.
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::SaveBinaryMap():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Saves the map in the binary map format (see gs_ogl_map.h). Only chunks containing
+//          tiles are stored.
 // ---------------------------------------------------------------------------------------------
-// Returns: The current horizontal map coordinate.
+// Returns: TRUE if successful, FALSE if failed.
 //==============================================================================================
 
-int GS_OGLMap::GetMapX()
+BOOL GS_OGLMap::SaveBinaryMap(const char* pszPathname)
 {
 
-    return m_nMapCoordX;
+    // Do we have a valid filename and a map to save?
+    if ((NULL == pszPathname) || (NULL == m_pChunks))
+    {
+        return FALSE;
+    }
+
+    const unsigned long lChunkBytes = GS_MAP_CHUNK_SIZE * GS_MAP_CHUNK_SIZE * sizeof(WORD);
+
+    int nNumChunks = m_nNumChunkCols * m_nNumChunkRows;
+
+    // Count the chunks containing tiles.
+    DWORD dwNumStored = 0;
+
+    for (int nLoop = 0; nLoop < nNumChunks; nLoop++)
+    {
+        if (m_pChunks[nLoop].pTiles != NULL)
+        {
+            dwNumStored++;
+        }
+    }
+
+    // Setup the header and the layer table (the tile layer is the only layer).
+    GS_MapFileHeader gsHeader;
+    memcpy(gsHeader.szMagic, GS_MAP_FILE_MAGIC, 4);
+    gsHeader.wVersion      = GS_MAP_FILE_VERSION;
+    gsHeader.wChunkSize    = GS_MAP_CHUNK_SIZE;
+    gsHeader.dwNumRows     = m_nNumRows;
+    gsHeader.dwNumCols     = m_nNumCols;
+    gsHeader.dwNumLayers   = 1;
+    gsHeader.dwLayerOffset = sizeof(GS_MapFileHeader);
+
+    GS_MapFileLayer gsLayer;
+    gsLayer.dwType        = GS_MAP_LAYER_TILES;
+    gsLayer.dwNumChunks   = dwNumStored;
+    gsLayer.dwChunkOffset = gsHeader.dwLayerOffset + sizeof(GS_MapFileLayer);
+
+    // Write the values little-endian.
+    this->ConvertByteOrder(&gsHeader);
+    this->ConvertByteOrder(&gsLayer);
+
+    GS_File gsMapFile;
+
+    // Were we able to open the file for writing?
+    if (FALSE == gsMapFile.Open(pszPathname, FILE_WRITE))
+    {
+        return FALSE;
+    }
+
+    BOOL bResult = (gsMapFile.Write(&gsHeader, sizeof(GS_MapFileHeader)) ==
+                    sizeof(GS_MapFileHeader));
+    bResult = bResult && (gsMapFile.Write(&gsLayer, sizeof(GS_MapFileLayer)) ==
+                          sizeof(GS_MapFileLayer));
+
+    // Write the chunk table, the chunk values follow it in the same order.
+    DWORD dwDataOffset = (DWORD) sizeof(GS_MapFileHeader) + sizeof(GS_MapFileLayer) +
+                         (dwNumStored * sizeof(GS_MapFileChunk));
+
+    for (int nLoop = 0; (nLoop < nNumChunks) && bResult; nLoop++)
+    {
+        if (m_pChunks[nLoop].pTiles != NULL)
+        {
+            GS_MapFileChunk gsChunk;
+            gsChunk.dwChunkIndex = nLoop;
+            gsChunk.dwDataOffset = dwDataOffset;
+            this->ConvertByteOrder(&gsChunk);
+
+            bResult = (gsMapFile.Write(&gsChunk, sizeof(GS_MapFileChunk)) ==
+                       sizeof(GS_MapFileChunk));
+
+            dwDataOffset += lChunkBytes;
+        }
+    }
+
+    // Write the chunk values, through a copy in file order on big-endian hosts.
+    unsigned short usTiles[GS_MAP_CHUNK_SIZE * GS_MAP_CHUNK_SIZE];
+
+    for (int nLoop = 0; (nLoop < nNumChunks) && bResult; nLoop++)
+    {
+        unsigned short* pTiles = m_pChunks[nLoop].pTiles;
+
+        if (pTiles != NULL)
+        {
+            if (this->IsBigEndian())
+            {
+                memcpy(usTiles, pTiles, lChunkBytes);
+                this->ConvertByteOrder(usTiles, GS_MAP_CHUNK_SIZE * GS_MAP_CHUNK_SIZE);
+                pTiles = usTiles;
+            }
+
+            bResult = (gsMapFile.Write(pTiles, lChunkBytes) == lChunkBytes);
+        }
+    }
+
+    // Close the map file.
+    gsMapFile.Close();
+
+    return bResult;
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
-// GS_OGLMap::GetMapY():
+// GS_OGLMap::ConvertMap():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Converts a text map (as read by LoadMap()) to the binary map format.
 // ---------------------------------------------------------------------------------------------
-// Returns: The current vertical map coordinate.
+// Returns: TRUE if successful, FALSE if failed.
 //==============================================================================================
 
-int GS_OGLMap::GetMapY()
+BOOL GS_OGLMap::ConvertMap(const char* pszTextPathname, int nNumRows, int nNumCols,
+                           const char* pszBinaryPathname)
 {
 
-    return m_nMapCoordY;
+    GS_OGLMap gsMap;
+
+    if (!gsMap.LoadMap(pszTextPathname, nNumRows, nNumCols))
+    {
+        return FALSE;
+    }
+
+    return gsMap.SaveBinaryMap(pszBinaryPathname);
 }
 
 
@@ -799,32 +1434,43 @@ int GS_OGLMap::GetMapY()
 
 
 //==============================================================================================
-// GS_OGLMap::GetMapWidth():
+// GS_OGLMap::IsBigEndian():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Checks the byte order of the host, binary map files are always little-endian.
 // ---------------------------------------------------------------------------------------------
-// Returns: The current width of the map in pixels.
+// Returns: TRUE if the host is big-endian, FALSE if it is little-endian.
 //==============================================================================================
 
-int GS_OGLMap::GetMapWidth()
+BOOL GS_OGLMap::IsBigEndian()
 {
 
-    return(m_nNumCols *  m_gsTileSprites.GetFrameWidth());
+    const WORD wValue = 1;
+
+    return (*(const BYTE*) &wValue == 0);
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
-// GS_OGLMap::GetMapHeight():
+// GS_OGLMap::ConvertByteOrder():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Converts a value between the byte order of the host and that of binary map files.
+//          The same conversion works both ways, and does nothing on little-endian hosts.
 // ---------------------------------------------------------------------------------------------
-// Returns: The current height of the map in pixels.
+// Returns: The converted value.
 //==============================================================================================
 
-int GS_OGLMap::GetMapHeight()
+WORD GS_OGLMap::ConvertByteOrder(WORD wValue)
 {
 
-    return(m_nNumRows * m_gsTileSprites.GetFrameHeight());
+    if (!IsBigEndian())
+    {
+        return wValue;
+    }
+
+    return (WORD) ((wValue >> 8) | (wValue << 8));
 }
 
 
@@ -832,42 +1478,46 @@ int GS_OGLMap::GetMapHeight()
 
 
 //==============================================================================================
-// GS_OGLMap::SetLimitX():
+// GS_OGLMap::ConvertByteOrder():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Converts a value between the byte order of the host and that of binary map files.
 // ---------------------------------------------------------------------------------------------
-// Returns: Nothing.
+// Returns: The converted value.
 //==============================================================================================
 
-void GS_OGLMap::SetLimitX(BOOL bEnableLimit)
+DWORD GS_OGLMap::ConvertByteOrder(DWORD dwValue)
 {
 
-    m_bLimitX = bEnableLimit;
-
-    if (m_bLimitX)
+    if (!IsBigEndian())
     {
-        m_bWrapX = FALSE;
+        return dwValue;
     }
+
+    return ((dwValue >> 24) | ((dwValue >> 8) & 0x0000FF00) |
+            ((dwValue << 8) & 0x00FF0000) | (dwValue << 24));
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
-// GS_OGLMap::SetLimitY():
+// GS_OGLMap::ConvertByteOrder():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Converts all the values of a binary map file header in place.
 // ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
-void GS_OGLMap::SetLimitY(BOOL bEnableLimit)
+void GS_OGLMap::ConvertByteOrder(GS_MapFileHeader* pHeader)
 {
 
-    m_bLimitY = bEnableLimit;
-
-    if (m_bLimitY)
-    {
-        m_bWrapY = FALSE;
-    }
+    pHeader->wVersion      = ConvertByteOrder(pHeader->wVersion);
+    pHeader->wChunkSize    = ConvertByteOrder(pHeader->wChunkSize);
+    pHeader->dwNumRows     = ConvertByteOrder(pHeader->dwNumRows);
+    pHeader->dwNumCols     = ConvertByteOrder(pHeader->dwNumCols);
+    pHeader->dwNumLayers   = ConvertByteOrder(pHeader->dwNumLayers);
+    pHeader->dwLayerOffset = ConvertByteOrder(pHeader->dwLayerOffset);
 }
 
 
@@ -875,42 +1525,38 @@ void GS_OGLMap::SetLimitY(BOOL bEnableLimit)
 
 
 //==============================================================================================
-// GS_OGLMap::SetWrapX():
+// GS_OGLMap::ConvertByteOrder():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Converts all the values of a binary map file layer in place.
 // ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
-void GS_OGLMap::SetWrapX(BOOL bEnableWrap)
+void GS_OGLMap::ConvertByteOrder(GS_MapFileLayer* pLayer)
 {
 
-    m_bWrapX = bEnableWrap;
-
-    if (m_bWrapX)
-    {
-        m_bLimitX = FALSE;
-    }
+    pLayer->dwType        = ConvertByteOrder(pLayer->dwType);
+    pLayer->dwNumChunks   = ConvertByteOrder(pLayer->dwNumChunks);
+    pLayer->dwChunkOffset = ConvertByteOrder(pLayer->dwChunkOffset);
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
-// GS_OGLMap::SetWrapY():
+// GS_OGLMap::ConvertByteOrder():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Converts all the values of a binary map file chunk entry in place.
 // ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
-void GS_OGLMap::SetWrapY(BOOL bEnableWrap)
+void GS_OGLMap::ConvertByteOrder(GS_MapFileChunk* pChunk)
 {
 
-    m_bWrapY = bEnableWrap;
-
-    if (m_bWrapY)
-    {
-        m_bLimitY = FALSE;
-    }
+    pChunk->dwChunkIndex = ConvertByteOrder(pChunk->dwChunkIndex);
+    pChunk->dwDataOffset = ConvertByteOrder(pChunk->dwDataOffset);
 }
 
 
@@ -918,196 +1564,121 @@ void GS_OGLMap::SetWrapY(BOOL bEnableWrap)
 
 
 //==============================================================================================
-// GS_OGLMap::ScrollX():
+// GS_OGLMap::ConvertByteOrder():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Converts the tile values of a chunk in place.
 // ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
-void GS_OGLMap::ScrollX(int nDistance)
+void GS_OGLMap::ConvertByteOrder(unsigned short* pTiles, int nNumTiles)
 {
 
-    // Is scroll limited in the horizontal aspect?
-    if (m_bLimitX)
+    if (!IsBigEndian())
     {
-        // Will the scroll distance leave a space to the right of the clip box?
-        if ((m_nMapCoordX + nDistance) < (this->GetClipBoxWidth() - this->GetMapWidth()))
-        {
-            // Adjust the scroll distance to prevent open spaces.
-            nDistance = this->GetClipBoxWidth() - this->GetMapWidth() -  m_nMapCoordX;
-        }
-        // Will the scroll distance leave a space to the left of the clip box?
-        else if ((m_nMapCoordX + nDistance) > 0)
-        {
-            // Adjust the scroll distance to prevent open spaces.
-            nDistance = 0 - m_nMapCoordX;
-        }
+        return;
     }
-    // Should scroll be wrapped in the horizontal aspect?
-    else if (m_bWrapX)
+
+    for (int nLoop = 0; nLoop < nNumTiles; nLoop++)
     {
-        // Has the map scrolled it's entire width to the left?
-        if ((m_nMapCoordX + nDistance) <= (-this->GetMapWidth()))
-        {
-            // Adjust the scroll distance by the distance over-scrolled.
-            nDistance = (m_nMapCoordX + nDistance) + this->GetMapWidth();
-            // Set the map coordinate to the far right.
-            m_nMapCoordX = this->GetMapWidth();
-        }
-        // Has the map scrolled it's entire width to the right?
-        else if ((m_nMapCoordX + nDistance) >= (this->GetMapWidth()))
-        {
-            // Adjust the scroll distance by the distance over-scrolled.
-            nDistance = (m_nMapCoordX + nDistance) - this->GetMapWidth();
-            // Set the map coordinate to the far left.
-            m_nMapCoordX = -this->GetMapWidth();
-        }
+        pTiles[nLoop] = ConvertByteOrder((WORD) pTiles[nLoop]);
     }
+}
 
-    // Adjust the horizontal coordinate.
-    m_nMapCoordX += nDistance;
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::SetMapX():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLMap::SetMapX(int nDestX)
+{
+
+    m_nMapCoordX = nDestX;
 }
 
 
 //==============================================================================================
-// GS_OGLMap::ScrollY():
+// GS_OGLMap::SetMapY():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
-void GS_OGLMap::ScrollY(int nDistance)
+void GS_OGLMap::SetMapY(int nDestY)
 {
 
-    // Is scroll limited in the vertical aspect?
-    if (m_bLimitY)
-    {
-        // Will the scroll distance leave a space at the top of the clip box?
-        if ((m_nMapCoordY + nDistance) < (this->GetClipBoxHeight() - this->GetMapHeight()))
-        {
-            // Adjust the scroll distance to prevent open spaces.
-            nDistance = this->GetClipBoxHeight() - this->GetMapHeight() -  m_nMapCoordY;
-        }
-        // Will the scroll distance leave a space at the bottom of the clip box?
-        else if ((m_nMapCoordY + nDistance) > 0)
-        {
-            // Adjust the scroll distance to prevent open spaces.
-            nDistance = 0 - m_nMapCoordY;
-        }
-    }
-    // Should scroll be wrapped in the vertical aspect?
-    else if (m_bWrapY)
-    {
-        // Has the map scrolled it's entire height to the bottom?
-        if ((m_nMapCoordY + nDistance) <= (-this->GetMapHeight()))
-        {
-            // Adjust the scroll distance by the distance over-scrolled.
-            nDistance = (m_nMapCoordY + nDistance) + this->GetMapHeight();
-            // Set the map coordinate to the far top.
-            m_nMapCoordY = this->GetMapHeight();
-        }
-        // Has the map scrolled it's entire height to the top?
-        else if ((m_nMapCoordY + nDistance) >= (this->GetMapHeight()))
-        {
-            // Adjust the scroll distance by the distance over-scrolled.
-            nDistance = (m_nMapCoordY + nDistance) - this->GetMapHeight();
-            // Set the map coordinate to the far bottom.
-            m_nMapCoordY = -this->GetMapHeight();
-        }
-    }
-
-    // Adjust the vertical coordinate.
-    m_nMapCoordY += nDistance;
+    m_nMapCoordY = nDestY;
 }
 
 
-////////////////////////////////////////////////////////////////////////////////////////////////
-
-
-////////////////////////////////////////////////////////////////////////////////////////////////
-// Tile Methods. ///////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////////////////////
-
-
 //==============================================================================================
-// GS_OGLMap::SetTileID():
+// GS_OGLMap::GetMapX():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: Nothing.
+// Returns: The current horizontal map coordinate.
 //==============================================================================================
 
-void GS_OGLMap::SetTileID(int nRow, int nCol, int nNewTileID)
+int GS_OGLMap::GetMapX()
 {
 
-    if ((nRow >= 0) && (nRow < m_nNumRows) && (nCol >= 0) && (nCol < m_nNumCols))
-    {
-        m_nMap[nRow][nCol] = nNewTileID;
-    }
+    return m_nMapCoordX;
 }
 
 
 //==============================================================================================
-// GS_OGLMap::GetTileID():
+// GS_OGLMap::GetMapY():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: An integer value indicating the selected tile ID or -1.
+// Returns: The current vertical map coordinate.
 //==============================================================================================
 
-int GS_OGLMap::GetTileID(int nRow, int nCol)
+int GS_OGLMap::GetMapY()
 {
 
-    if ((nRow >= 0) && (nRow < m_nNumRows) && (nCol >= 0) && (nCol < m_nNumCols))
-    {
-        return m_nMap[nRow][nCol];
-    }
-
-    return -1;
+    return m_nMapCoordY;
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
-// GS_OGLMap::ReplaceTileID():
+// GS_OGLMap::GetMapWidth():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: Nothing.
+// Returns: The current width of the map in pixels.
 //==============================================================================================
 
-void GS_OGLMap::ReplaceTileID(int nOldTileID, int nNewTileID)
+int GS_OGLMap::GetMapWidth()
 {
 
-    for (int nRows = 0; nRows < m_nNumRows; nRows++)
-    {
-        for (int nCols = 0; nCols < m_nNumCols; nCols++)
-        {
-            if (m_nMap[nRows][nCols] == nOldTileID)
-            {
-                m_nMap[nRows][nCols] = nNewTileID;
-            }
-        }
-    }
+    return(m_nNumCols *  m_gsTileSprites.GetFrameWidth());
 }
 
 
-////////////////////////////////////////////////////////////////////////////////////////////////
-
-
 //==============================================================================================
-// GS_OGLMap::SetClearTileID():
+// GS_OGLMap::GetMapHeight():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: Nothing.
+// Returns: The current height of the map in pixels.
 //==============================================================================================
 
-void GS_OGLMap::SetClearTileID(int nTileID)
+int GS_OGLMap::GetMapHeight()
 {
 
-    m_nClearTileID = nTileID;
+    return(m_nNumRows * m_gsTileSprites.GetFrameHeight());
 }
 
 
@@ -1115,32 +1686,42 @@ void GS_OGLMap::SetClearTileID(int nTileID)
 
 
 //==============================================================================================
-// GS_OGLMap::GetTileWidth():
+// GS_OGLMap::SetLimitX():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: The width of each individual map tile in pixels.
+// Returns: Nothing.
 //==============================================================================================
 
-GLfloat GS_OGLMap::GetTileWidth()
+void GS_OGLMap::SetLimitX(BOOL bEnableLimit)
 {
 
-    return m_nTileWidth;
+    m_bLimitX = bEnableLimit;
+
+    if (m_bLimitX)
+    {
+        m_bWrapX = FALSE;
+    }
 }
 
 
 //==============================================================================================
-// GS_OGLMap::GetTileHeight():
+// GS_OGLMap::SetLimitY():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: The height of each individual map tile in pixels.
+// Returns: Nothing.
 //==============================================================================================
 
-GLfloat GS_OGLMap::GetTileHeight()
+void GS_OGLMap::SetLimitY(BOOL bEnableLimit)
 {
 
-    return m_nTileHeight;
+    m_bLimitY = bEnableLimit;
+
+    if (m_bLimitY)
+    {
+        m_bWrapY = FALSE;
+    }
 }
 
 
@@ -1148,32 +1729,42 @@ GLfloat GS_OGLMap::GetTileHeight()
 
 
 //==============================================================================================
-// GS_OGLMap::SetTotalTiles():
+// GS_OGLMap::SetWrapX():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
-void GS_OGLMap::SetTotalTiles(int nTotalTiles)
+void GS_OGLMap::SetWrapX(BOOL bEnableWrap)
 {
 
-    m_gsTileSprites.SetTotalFrames(nTotalTiles);
+    m_bWrapX = bEnableWrap;
+
+    if (m_bWrapX)
+    {
+        m_bLimitX = FALSE;
+    }
 }
 
 
 //==============================================================================================
-// GS_OGLMap::GetTotalTiles():
+// GS_OGLMap::SetWrapY():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: The total number of tiles used by the map.
+// Returns: Nothing.
 //==============================================================================================
 
-int GS_OGLMap::GetTotalTiles()
+void GS_OGLMap::SetWrapY(BOOL bEnableWrap)
 {
 
-    return m_gsTileSprites.GetTotalFrames();
+    m_bWrapY = bEnableWrap;
+
+    if (m_bWrapY)
+    {
+        m_bLimitY = FALSE;
+    }
 }
 
 
@@ -1181,248 +1772,282 @@ int GS_OGLMap::GetTotalTiles()
 
 
 //==============================================================================================
-// GS_OGLMap::SetTilesPerLine():
+// GS_OGLMap::ScrollX():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
-void GS_OGLMap::SetTilesPerLine(int nTilesPerLine)
+void GS_OGLMap::ScrollX(int nDistance)
 {
 
-    m_gsTileSprites.SetFramesPerLine(nTilesPerLine);
+    // Is scroll limited in the horizontal aspect?
+    if (m_bLimitX)
+    {
+        // Will the scroll distance leave a space to the right of the clip box?
+        if ((m_nMapCoordX + nDistance) < (this->GetClipBoxWidth() - this->GetMapWidth()))
+        {
+            // Adjust the scroll distance to prevent open spaces.
+            nDistance = this->GetClipBoxWidth() - this->GetMapWidth() -  m_nMapCoordX;
+        }
+        // Will the scroll distance leave a space to the left of the clip box?
+        else if ((m_nMapCoordX + nDistance) > 0)
+        {
+            // Adjust the scroll distance to prevent open spaces.
+            nDistance = 0 - m_nMapCoordX;
+        }
+    }
+    // Should scroll be wrapped in the horizontal aspect?
+    else if (m_bWrapX)
+    {
+        // Has the map scrolled it's entire width to the left?
+        if ((m_nMapCoordX + nDistance) <= (-this->GetMapWidth()))
+        {
+            // Adjust the scroll distance by the distance over-scrolled.
+            nDistance = (m_nMapCoordX + nDistance) + this->GetMapWidth();
+            // Set the map coordinate to the far right.
+            m_nMapCoordX = this->GetMapWidth();
+        }
+        // Has the map scrolled it's entire width to the right?
+        else if ((m_nMapCoordX + nDistance) >= (this->GetMapWidth()))
+        {
+            // Adjust the scroll distance by the distance over-scrolled.
+            nDistance = (m_nMapCoordX + nDistance) - this->GetMapWidth();
+            // Set the map coordinate to the far left.
+            m_nMapCoordX = -this->GetMapWidth();
+        }
+    }
+
+    // Adjust the horizontal coordinate.
+    m_nMapCoordX += nDistance;
 }
 
 
 //==============================================================================================
-// GS_OGLMap::GetTilesPerLine():
+// GS_OGLMap::ScrollY():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: The number of tiles per line of the tile image.
+// Returns: Nothing.
 //==============================================================================================
 
-int GS_OGLMap::GetTilesPerLine()
+void GS_OGLMap::ScrollY(int nDistance)
 {
 
-    return m_gsTileSprites.GetFramesPerLine();
+    // Is scroll limited in the vertical aspect?
+    if (m_bLimitY)
+    {
+        // Will the scroll distance leave a space at the top of the clip box?
+        if ((m_nMapCoordY + nDistance) < (this->GetClipBoxHeight() - this->GetMapHeight()))
+        {
+            // Adjust the scroll distance to prevent open spaces.
+            nDistance = this->GetClipBoxHeight() - this->GetMapHeight() -  m_nMapCoordY;
+        }
+        // Will the scroll distance leave a space at the bottom of the clip box?
+        else if ((m_nMapCoordY + nDistance) > 0)
+        {
+            // Adjust the scroll distance to prevent open spaces.
+            nDistance = 0 - m_nMapCoordY;
+        }
+    }
+    // Should scroll be wrapped in the vertical aspect?
+    else if (m_bWrapY)
+    {
+        // Has the map scrolled it's entire height to the bottom?
+        if ((m_nMapCoordY + nDistance) <= (-this->GetMapHeight()))
+        {
+            // Adjust the scroll distance by the distance over-scrolled.
+            nDistance = (m_nMapCoordY + nDistance) + this->GetMapHeight();
+            // Set the map coordinate to the far top.
+            m_nMapCoordY = this->GetMapHeight();
+        }
+        // Has the map scrolled it's entire height to the top?
+        else if ((m_nMapCoordY + nDistance) >= (this->GetMapHeight()))
+        {
+            // Adjust the scroll distance by the distance over-scrolled.
+            nDistance = (m_nMapCoordY + nDistance) - this->GetMapHeight();
+            // Set the map coordinate to the far bottom.
+            m_nMapCoordY = -this->GetMapHeight();
+        }
+    }
+
+    // Adjust the vertical coordinate.
+    m_nMapCoordY += nDistance;
 }
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
-// Conversion Methods. /////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Tile Methods. ///////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
 //==============================================================================================
-// GS_OGLMap::MapToID():
+// GS_OGLMap::SetTileID():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Sets the ID of the specified tile. Tile IDs range from 0 to GS_MAP_MAX_TILE_ID, an ID
+//          of -1 (or any other negative value) empties the tile and larger IDs are clamped.
 // ---------------------------------------------------------------------------------------------
-// Returns: The ID of the tile located at the specified map coordinate, or -1.
+// Returns: Nothing.
 //==============================================================================================
 
-int GS_OGLMap::MapToID(int nCoordX, int nCoordY)
+void GS_OGLMap::SetTileID(int nRow, int nCol, int nNewTileID)
 {
 
-    // Determine the column and row of the map at the specified x and y coordinates.
-    int nCol = (nCoordX - (nCoordX%m_nTileWidth))  /  m_nTileWidth;
-    int nRow = (nCoordY - (nCoordY%m_nTileHeight)) / m_nTileHeight;
-
-    // Do we have a valid map row and column?
     if ((nRow < 0) || (nRow >= m_nNumRows) || (nCol < 0) || (nCol >= m_nNumCols))
     {
-        return -1;
+        return;
     }
 
-    // Return the tile ID at the specified coordinates.
-    return(m_nMap[nRow][nCol]);
-}
+    // Convert the tile ID to the value stored in the chunk.
+    unsigned short usValue = GS_MAP_EMPTY_TILE;
 
+    if (nNewTileID > GS_MAP_MAX_TILE_ID)
+    {
+        usValue = GS_MAP_MAX_TILE_ID;
+    }
+    else if (nNewTileID >= 0)
+    {
+        usValue = (unsigned short) nNewTileID;
+    }
 
-//==============================================================================================
-// GS_OGLMap::MapToCol():
-// ---------------------------------------------------------------------------------------------
-// Purpose: ...
-// ---------------------------------------------------------------------------------------------
-// Returns: The column of the tile located at the specified map coordinate, or -1.
-//==============================================================================================
+    GS_MapChunk* pChunk = &m_pChunks[((nRow / GS_MAP_CHUNK_SIZE) * m_nNumChunkCols) +
+                                     (nCol / GS_MAP_CHUNK_SIZE)];
 
-int GS_OGLMap::MapToCol(int nCoordX)
-{
+    // Allocate the chunk tiles the first time a tile in the chunk is set.
+    if (NULL == pChunk->pTiles)
+    {
+        // An unallocated chunk is already empty.
+        if (usValue == GS_MAP_EMPTY_TILE)
+        {
+            return;
+        }
 
-    // Determine the column of the map at the specified x-coordinate.
-    int nCol = (nCoordX - (nCoordX%m_nTileWidth))  /  m_nTileWidth;
+        if (!this->CreateChunkTiles(pChunk))
+        {
+            return;
+        }
+    }
 
-    // Do we have a valid map column?
-    if ((nCol < 0) || (nCol >= m_nNumCols))
+    int nTile = ((nRow % GS_MAP_CHUNK_SIZE) * GS_MAP_CHUNK_SIZE) + (nCol % GS_MAP_CHUNK_SIZE);
+
+    if (pChunk->pTiles[nTile] != usValue)
     {
-        return -1;
-    }
+        pChunk->pTiles[nTile] = usValue;
+        pChunk->bIsDirty = TRUE;
 
-    return nCol;
+        // Update the collision flags of the tile.
+        pChunk->pFlags[nTile] = this->GetTileFlags(usValue);
+    }
 }
 
 
 //==============================================================================================
-// GS_OGLMap::MapToRow():
+// GS_OGLMap::GetTileID():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: The row of the tile located at the specified map coordinate, or -1.
+// Returns: An integer value indicating the selected tile ID or -1.
 //==============================================================================================
 
-int GS_OGLMap::MapToRow(int nCoordY)
+int GS_OGLMap::GetTileID(int nRow, int nCol)
 {
 
-    // Determine the row of the map at the specified y-coordinate.
-    int nRow = (nCoordY - (nCoordY%m_nTileHeight)) / m_nTileHeight;
-
-    // Do we have a valid map row and column?
-    if ((nRow < 0) || (nRow >= m_nNumRows))
+    if ((nRow < 0) || (nRow >= m_nNumRows) || (nCol < 0) || (nCol >= m_nNumCols))
     {
         return -1;
     }
 
-    return nRow;
-}
-
-
-////////////////////////////////////////////////////////////////////////////////////////////////
-
+    GS_MapChunk* pChunk = &m_pChunks[((nRow / GS_MAP_CHUNK_SIZE) * m_nNumChunkCols) +
+                                     (nCol / GS_MAP_CHUNK_SIZE)];
 
-//==============================================================================================
-// GS_OGLMap::ScreenToID():
-// ---------------------------------------------------------------------------------------------
-// Purpose: ...
-// ---------------------------------------------------------------------------------------------
-// Returns: The ID of the tile located at the specified screen coordinate, or -1.
-//==============================================================================================
+    // Tiles in unallocated chunks are empty.
+    if (NULL == pChunk->pTiles)
+    {
+        return -1;
+    }
 
-int GS_OGLMap::ScreenToID(int nCoordX, int nCoordY)
-{
+    unsigned short usValue = pChunk->pTiles[((nRow % GS_MAP_CHUNK_SIZE) * GS_MAP_CHUNK_SIZE) +
+                                            (nCol % GS_MAP_CHUNK_SIZE)];
 
-    // Were we able to convert the screen- to a map coordinate.
-    if (!this->ScreenToMap(&nCoordX, &nCoordY))
+    if (usValue == GS_MAP_EMPTY_TILE)
     {
         return -1;
     }
 
-    // Return the ID of the tile at the specified coordinate.
-    return(this->MapToID(nCoordX, nCoordY));
+    return usValue;
 }
 
 
 //==============================================================================================
-// GS_OGLMap::ScreenToCol():
+// GS_OGLMap::ReplaceTileID():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: The column of the tile located at the specified screen coordinate, or -1.
+// Returns: Nothing.
 //==============================================================================================
 
-int GS_OGLMap::ScreenToCol(int nCoordX)
+void GS_OGLMap::ReplaceTileID(int nOldTileID, int nNewTileID)
 {
 
-    // Is the x-coordinate not within the clip box?
-    if ((nCoordX < m_rcClipBox.left) || (nCoordX >= m_rcClipBox.right))
+    if (nOldTileID == nNewTileID)
     {
-        return -1;
+        return;
     }
 
-    // Convert the x-coordinate to a map coordinate.
-    nCoordX -= (m_nMapCoordX + m_rcClipBox.left);
-
-    // Is the x-coordinate not within the map area?
-    if ((nCoordX < 0) || (nCoordX >= (m_nNumCols * m_nTileWidth)))
+    for (int nChunkRow = 0; nChunkRow < m_nNumChunkRows; nChunkRow++)
     {
-        // Is the map wrapped horizontally?
-        if (m_bWrapX)
+        for (int nChunkCol = 0; nChunkCol < m_nNumChunkCols; nChunkCol++)
         {
-            // Has the map been scrolled to the left?
-            if (m_nMapCoordX <= 0)
-            {
-                // Adjust the x-coordinate to the left.
-                nCoordX -= (m_nNumCols * m_nTileWidth);
-            }
-            else
+            GS_MapChunk* pChunk = &m_pChunks[(nChunkRow * m_nNumChunkCols) + nChunkCol];
+
+            // Only empty tiles can match in unallocated chunks, skip them unless we are
+            // replacing empty tiles.
+            if ((NULL == pChunk->pTiles) && (nOldTileID >= 0))
             {
-                // Adjust the x-coordinate to the right.
-                nCoordX += (m_nNumCols * m_nTileWidth);
+                continue;
             }
-            // Is the x-coordinate not within the map area?
-            if ((nCoordX < 0) || (nCoordX >= (m_nNumCols * m_nTileWidth)))
+
+            int nFirstRow = nChunkRow * GS_MAP_CHUNK_SIZE;
+            int nFirstCol = nChunkCol * GS_MAP_CHUNK_SIZE;
+
+            for (int nRow = nFirstRow; nRow < nFirstRow + GS_MAP_CHUNK_SIZE; nRow++)
             {
-                // Conversion failed.
-                return -1;
+                for (int nCol = nFirstCol; nCol < nFirstCol + GS_MAP_CHUNK_SIZE; nCol++)
+                {
+                    if (this->GetTileID(nRow, nCol) == nOldTileID)
+                    {
+                        this->SetTileID(nRow, nCol, nNewTileID);
+                    }
+                }
             }
         }
-        else
-        {
-            // Conversion failed.
-            return -1;
-        }
     }
-
-    // Return the column of the map at the specified x-coordinate.
-    return(this->MapToCol(nCoordX));
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
-// GS_OGLMap::ScreenToRow():
+// GS_OGLMap::SetClearTileID():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: The row of the tile located at the specified screen coordinate, or -1.
+// Returns: Nothing.
 //==============================================================================================
 
-int GS_OGLMap::ScreenToRow(int nCoordY)
+void GS_OGLMap::SetClearTileID(int nTileID)
 {
 
-    // Is the y-coordinate not within the clip box?
-    if ((nCoordY < m_rcClipBox.bottom) || (nCoordY >= m_rcClipBox.top))
-    {
-        return -1;
-    }
-
-    // Convert the y-coordinate to a map coordinate.
-    nCoordY -= (m_nMapCoordY + m_rcClipBox.bottom);
-
-    // Is the y-coordinate not within the map area?
-    if ((nCoordY < 0) || (nCoordY >= (m_nNumRows * m_nTileHeight)))
+    if (m_nClearTileID != nTileID)
     {
-        // Is the map wrapped vertically?
-        if (m_bWrapY)
-        {
-            // Has the map been scrolled to the bottom?
-            if (m_nMapCoordY <= 0)
-            {
-                // Adjust the y-coordinate to the bottom.
-                nCoordY -= (m_nNumRows * m_nTileHeight);
-            }
-            else
-            {
-                // Adjust the y-coordinate to the top.
-                nCoordY += (m_nNumRows * m_nTileHeight);
-            }
-            // Is the y-coordinate not within the map area?
-            if ((nCoordY < 0) || (nCoordY >= (m_nNumRows * m_nTileHeight)))
-            {
-                // Conversion failed.
-                return -1;
-            }
-        }
-        else
-        {
-            // Conversion failed.
-            return -1;
-        }
+        m_nClearTileID = nTileID;
+        this->SetAllChunksDirty();
     }
-
-    // Return the column of the map at the specified y-coordinate.
-    return(this->MapToRow(nCoordY));
 }
 
 
@@ -1430,122 +2055,498 @@ int GS_OGLMap::ScreenToRow(int nCoordY)
 
 
 //==============================================================================================
-// GS_OGLMap::MapToScreen():
+// GS_OGLMap::GetTileWidth():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: TRUE coordinate is within the clip box, FALSE if not.
+// Returns: The width of each individual map tile in pixels.
 //==============================================================================================
 
-BOOL GS_OGLMap::MapToScreen(int* pnCoordX, int* pnCoordY)
+GLfloat GS_OGLMap::GetTileWidth()
 {
 
-    int nCoordX = *pnCoordX;
-    int nCoordY = *pnCoordY;
-
-    // Is the x-coordinate not within the map area?
-    if ((nCoordX < 0) || (nCoordX >= (m_nNumCols * m_nTileWidth)))
-    {
-        // Conversion failed.
-        return FALSE;
-    }
-
-    // Is the y-coordinate not within the map area?
-    if ((nCoordY < 0) || (nCoordY >= (m_nNumRows * m_nTileHeight)))
-    {
-        // Conversion failed.
-        return FALSE;
-    }
+    return m_nTileWidth;
+}
 
-    // Convert the x-coordinate from map to screen coordinates.
-    nCoordX  += (m_nMapCoordX + m_rcClipBox.left);
 
-    // Is the x-coordinate not within the clip box?
-    if ((nCoordX < m_rcClipBox.left) || (nCoordX >= m_rcClipBox.right))
-    {
-        // Is the map wrapped horizontally?
-        if (m_bWrapX)
-        {
-            // Has the map been scrolled to the left?
-            if (m_nMapCoordX <= 0)
-            {
-                // Adjust the x-coordinate to the right.
-                nCoordX  += (m_nNumCols * m_nTileWidth);
-            }
-            else
-            {
-                // Adjust the x-coordinate to the left.
-                nCoordX  -= (m_nNumCols * m_nTileWidth);
-            }
-            // Is the x-coordinate not within the clip box?
-            if ((nCoordX < m_rcClipBox.left) || (nCoordX >= m_rcClipBox.right))
-            {
-                // Conversion failed.
-                return FALSE;
-            }
-        }
-        else
-        {
-            // Conversion failed.
-            return FALSE;
-        }
-    }
+//==============================================================================================
+// GS_OGLMap::GetTileHeight():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The height of each individual map tile in pixels.
+//==============================================================================================
 
-    // Convert the y-coordinate from map to screen coordinates.
-    nCoordY +=  (m_nMapCoordY + m_rcClipBox.bottom);
+GLfloat GS_OGLMap::GetTileHeight()
+{
 
-    // Is the y-coordinate not within the clip box?
-    if ((nCoordY < m_rcClipBox.bottom) || (nCoordY >= m_rcClipBox.top))
-    {
-        // Is the map wrapped vertically?
-        if (m_bWrapY)
-        {
-            // Has the map been scrolled to the bottom?
-            if (m_nMapCoordY <= 0)
-            {
-                // Adjust the y-coordinate to the top.
-                nCoordY += (m_nNumRows * m_nTileHeight);
-            }
-            else
-            {
-                // Adjust the y-coordinate to the bottom.
-                nCoordY -= (m_nNumRows * m_nTileHeight);
-            }
-            // Is the y-coordinate not within the clip box?
-            if ((nCoordY < m_rcClipBox.bottom) || (nCoordY >= m_rcClipBox.top))
-            {
-                // Conversion failed.
-                return FALSE;
-            }
-        }
-        else
-        {
-            // Conversion failed.
-            return FALSE;
-        }
-    }
+    return m_nTileHeight;
+}
 
-    // Assign converted coordinate.
-    *pnCoordX = nCoordX;
-    *pnCoordY = nCoordY;
 
-    // Conversion successful.
-    return TRUE;
-}
+////////////////////////////////////////////////////////////////////////////////////////////////
 
 
 //==============================================================================================
-// GS_OGLMap::MapToScreen():
+// GS_OGLMap::SetTotalTiles():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: TRUE source rectangle overlaps the clip box, FALSE if not.
+// Returns: Nothing.
 //==============================================================================================
 
-BOOL GS_OGLMap::MapToScreen(RECT* prcSource)
+void GS_OGLMap::SetTotalTiles(int nTotalTiles)
 {
 
-    RECT rcSource = *prcSource;
+    m_gsTileSprites.SetTotalFrames(nTotalTiles);
+
+    // Tile IDs are clamped to the total number of tiles, so rebuild all chunks.
+    this->SetAllChunksDirty();
+}
+
+
+//==============================================================================================
+// GS_OGLMap::GetTotalTiles():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The total number of tiles used by the map.
+//==============================================================================================
+
+int GS_OGLMap::GetTotalTiles()
+{
+
+    return m_gsTileSprites.GetTotalFrames();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::SetTilesPerLine():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLMap::SetTilesPerLine(int nTilesPerLine)
+{
+
+    m_gsTileSprites.SetFramesPerLine(nTilesPerLine);
+}
+
+
+//==============================================================================================
+// GS_OGLMap::GetTilesPerLine():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of tiles per line of the tile image.
+//==============================================================================================
+
+int GS_OGLMap::GetTilesPerLine()
+{
+
+    return m_gsTileSprites.GetFramesPerLine();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::SetTileScroll():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Scrolls the images of all tiles within their frames, the same as scrolling a sprite.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLMap::SetTileScroll(GLfloat glfScrollX, GLfloat glfScrollY)
+{
+
+    m_gsTileSprites.SetScrollXY(glfScrollX, glfScrollY);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::SetTileRotate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Rotates every tile around its centre (in degrees). Rotated tiles are drawn one by
+//          one rather than a chunk at a time, so rotating them makes rendering slower.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLMap::SetTileRotate(GLfloat glfRotateX, GLfloat glfRotateY, GLfloat glfRotateZ)
+{
+
+    m_gsTileSprites.SetRotateX(glfRotateX);
+    m_gsTileSprites.SetRotateY(glfRotateY);
+    m_gsTileSprites.SetRotateZ(glfRotateZ);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::SetTileScale():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the size tiles are drawn at (1.0f is normal), the tiles stay where they are.
+//          The chunks are rebuilt the next time they are drawn at a new scale.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLMap::SetTileScale(GLfloat glfScaleX, GLfloat glfScaleY)
+{
+
+    m_gsTileSprites.SetScaleXY(glfScaleX, glfScaleY);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Conversion Methods. /////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::MapToID():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The ID of the tile located at the specified map coordinate, or -1.
+//==============================================================================================
+
+int GS_OGLMap::MapToID(int nCoordX, int nCoordY)
+{
+
+    // Determine the column and row of the map at the specified x and y coordinates.
+    int nCol = (nCoordX - (nCoordX%m_nTileWidth))  /  m_nTileWidth;
+    int nRow = (nCoordY - (nCoordY%m_nTileHeight)) / m_nTileHeight;
+
+    // Do we have a valid map row and column?
+    if ((nRow < 0) || (nRow >= m_nNumRows) || (nCol < 0) || (nCol >= m_nNumCols))
+    {
+        return -1;
+    }
+
+    // Return the tile ID at the specified coordinates.
+    return this->GetTileID(nRow, nCol);
+}
+
+
+//==============================================================================================
+// GS_OGLMap::MapToCol():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The column of the tile located at the specified map coordinate, or -1.
+//==============================================================================================
+
+int GS_OGLMap::MapToCol(int nCoordX)
+{
+
+    // Determine the column of the map at the specified x-coordinate.
+    int nCol = (nCoordX - (nCoordX%m_nTileWidth))  /  m_nTileWidth;
+
+    // Do we have a valid map column?
+    if ((nCol < 0) || (nCol >= m_nNumCols))
+    {
+        return -1;
+    }
+
+    return nCol;
+}
+
+
+//==============================================================================================
+// GS_OGLMap::MapToRow():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The row of the tile located at the specified map coordinate, or -1.
+//==============================================================================================
+
+int GS_OGLMap::MapToRow(int nCoordY)
+{
+
+    // Determine the row of the map at the specified y-coordinate.
+    int nRow = (nCoordY - (nCoordY%m_nTileHeight)) / m_nTileHeight;
+
+    // Do we have a valid map row and column?
+    if ((nRow < 0) || (nRow >= m_nNumRows))
+    {
+        return -1;
+    }
+
+    return nRow;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::ScreenToID():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The ID of the tile located at the specified screen coordinate, or -1.
+//==============================================================================================
+
+int GS_OGLMap::ScreenToID(int nCoordX, int nCoordY)
+{
+
+    // Were we able to convert the screen- to a map coordinate.
+    if (!this->ScreenToMap(&nCoordX, &nCoordY))
+    {
+        return -1;
+    }
+
+    // Return the ID of the tile at the specified coordinate.
+    return(this->MapToID(nCoordX, nCoordY));
+}
+
+
+//==============================================================================================
+// GS_OGLMap::ScreenToCol():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The column of the tile located at the specified screen coordinate, or -1.
+//==============================================================================================
+
+int GS_OGLMap::ScreenToCol(int nCoordX)
+{
+
+    // Is the x-coordinate not within the clip box?
+    if ((nCoordX < m_rcClipBox.left) || (nCoordX >= m_rcClipBox.right))
+    {
+        return -1;
+    }
+
+    // Convert the x-coordinate to a map coordinate.
+    nCoordX -= (m_nMapCoordX + m_rcClipBox.left);
+
+    // Is the x-coordinate not within the map area?
+    if ((nCoordX < 0) || (nCoordX >= (m_nNumCols * m_nTileWidth)))
+    {
+        // Is the map wrapped horizontally?
+        if (m_bWrapX)
+        {
+            // Has the map been scrolled to the left?
+            if (m_nMapCoordX <= 0)
+            {
+                // Adjust the x-coordinate to the left.
+                nCoordX -= (m_nNumCols * m_nTileWidth);
+            }
+            else
+            {
+                // Adjust the x-coordinate to the right.
+                nCoordX += (m_nNumCols * m_nTileWidth);
+            }
+            // Is the x-coordinate not within the map area?
+            if ((nCoordX < 0) || (nCoordX >= (m_nNumCols * m_nTileWidth)))
+            {
+                // Conversion failed.
+                return -1;
+            }
+        }
+        else
+        {
+            // Conversion failed.
+            return -1;
+        }
+    }
+
+    // Return the column of the map at the specified x-coordinate.
+    return(this->MapToCol(nCoordX));
+}
+
+
+//==============================================================================================
+// GS_OGLMap::ScreenToRow():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The row of the tile located at the specified screen coordinate, or -1.
+//==============================================================================================
+
+int GS_OGLMap::ScreenToRow(int nCoordY)
+{
+
+    // Is the y-coordinate not within the clip box?
+    if ((nCoordY < m_rcClipBox.bottom) || (nCoordY >= m_rcClipBox.top))
+    {
+        return -1;
+    }
+
+    // Convert the y-coordinate to a map coordinate.
+    nCoordY -= (m_nMapCoordY + m_rcClipBox.bottom);
+
+    // Is the y-coordinate not within the map area?
+    if ((nCoordY < 0) || (nCoordY >= (m_nNumRows * m_nTileHeight)))
+    {
+        // Is the map wrapped vertically?
+        if (m_bWrapY)
+        {
+            // Has the map been scrolled to the bottom?
+            if (m_nMapCoordY <= 0)
+            {
+                // Adjust the y-coordinate to the bottom.
+                nCoordY -= (m_nNumRows * m_nTileHeight);
+            }
+            else
+            {
+                // Adjust the y-coordinate to the top.
+                nCoordY += (m_nNumRows * m_nTileHeight);
+            }
+            // Is the y-coordinate not within the map area?
+            if ((nCoordY < 0) || (nCoordY >= (m_nNumRows * m_nTileHeight)))
+            {
+                // Conversion failed.
+                return -1;
+            }
+        }
+        else
+        {
+            // Conversion failed.
+            return -1;
+        }
+    }
+
+    // Return the column of the map at the specified y-coordinate.
+    return(this->MapToRow(nCoordY));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::MapToScreen():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE coordinate is within the clip box, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLMap::MapToScreen(int* pnCoordX, int* pnCoordY)
+{
+
+    int nCoordX = *pnCoordX;
+    int nCoordY = *pnCoordY;
+
+    // Is the x-coordinate not within the map area?
+    if ((nCoordX < 0) || (nCoordX >= (m_nNumCols * m_nTileWidth)))
+    {
+        // Conversion failed.
+        return FALSE;
+    }
+
+    // Is the y-coordinate not within the map area?
+    if ((nCoordY < 0) || (nCoordY >= (m_nNumRows * m_nTileHeight)))
+    {
+        // Conversion failed.
+        return FALSE;
+    }
+
+    // Convert the x-coordinate from map to screen coordinates.
+    nCoordX  += (m_nMapCoordX + m_rcClipBox.left);
+
+    // Is the x-coordinate not within the clip box?
+    if ((nCoordX < m_rcClipBox.left) || (nCoordX >= m_rcClipBox.right))
+    {
+        // Is the map wrapped horizontally?
+        if (m_bWrapX)
+        {
+            // Has the map been scrolled to the left?
+            if (m_nMapCoordX <= 0)
+            {
+                // Adjust the x-coordinate to the right.
+                nCoordX  += (m_nNumCols * m_nTileWidth);
+            }
+            else
+            {
+                // Adjust the x-coordinate to the left.
+                nCoordX  -= (m_nNumCols * m_nTileWidth);
+            }
+            // Is the x-coordinate not within the clip box?
+            if ((nCoordX < m_rcClipBox.left) || (nCoordX >= m_rcClipBox.right))
+            {
+                // Conversion failed.
+                return FALSE;
+            }
+        }
+        else
+        {
+            // Conversion failed.
+            return FALSE;
+        }
+    }
+
+    // Convert the y-coordinate from map to screen coordinates.
+    nCoordY +=  (m_nMapCoordY + m_rcClipBox.bottom);
+
+    // Is the y-coordinate not within the clip box?
+    if ((nCoordY < m_rcClipBox.bottom) || (nCoordY >= m_rcClipBox.top))
+    {
+        // Is the map wrapped vertically?
+        if (m_bWrapY)
+        {
+            // Has the map been scrolled to the bottom?
+            if (m_nMapCoordY <= 0)
+            {
+                // Adjust the y-coordinate to the top.
+                nCoordY += (m_nNumRows * m_nTileHeight);
+            }
+            else
+            {
+                // Adjust the y-coordinate to the bottom.
+                nCoordY -= (m_nNumRows * m_nTileHeight);
+            }
+            // Is the y-coordinate not within the clip box?
+            if ((nCoordY < m_rcClipBox.bottom) || (nCoordY >= m_rcClipBox.top))
+            {
+                // Conversion failed.
+                return FALSE;
+            }
+        }
+        else
+        {
+            // Conversion failed.
+            return FALSE;
+        }
+    }
+
+    // Assign converted coordinate.
+    *pnCoordX = nCoordX;
+    *pnCoordY = nCoordY;
+
+    // Conversion successful.
+    return TRUE;
+}
+
+
+//==============================================================================================
+// GS_OGLMap::MapToScreen():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE source rectangle overlaps the clip box, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLMap::MapToScreen(RECT* prcSource)
+{
+
+    RECT rcSource = *prcSource;
 
     // Are the x-coordinates of the source not within the map area?
     if ((rcSource.right <= 0) || (rcSource.left >= (m_nNumCols * m_nTileWidth)))
@@ -1836,28 +2837,212 @@ BOOL GS_OGLMap::ScreenToMap(RECT* prcSource)
             }
             else
             {
-                // Adjust the source coordinates to the top.
-                rcSource.bottom += (m_nNumRows * m_nTileHeight);
-                rcSource.top = rcSource.bottom + nSourceHeight;
+                // Adjust the source coordinates to the top.
+                rcSource.bottom += (m_nNumRows * m_nTileHeight);
+                rcSource.top = rcSource.bottom + nSourceHeight;
+            }
+            // Are the y-coordinates of the source not within the map area?
+            if ((rcSource.top <= 0) || (rcSource.bottom >= (m_nNumRows * m_nTileHeight)))
+            {
+                // Conversion failed.
+                return FALSE;
+            }
+        }
+        else
+        {
+            // Conversion failed.
+            return FALSE;
+        }
+    }
+
+    // Assign converted rectangle.
+    *prcSource = rcSource;
+
+    // Conversion successful.
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Collision Methods. //////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::IsOnTile():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if a certain point overlaps a certain kind of tile, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLMap::IsOnTile(int nCoordX, int nCoordY, int nTileID)
+{
+
+    // Do we not have a valid tile ID?
+    if ((nTileID < 0) || (nTileID >= m_gsTileSprites.GetTotalFrames()))
+    {
+        return FALSE;
+    }
+
+    // Were we unable to convert the screen to map coordinate?
+    if (!this->ScreenToMap(&nCoordX, &nCoordY))
+    {
+        // Coordinate not on tile.
+        return FALSE;
+    }
+
+    // Is the tile at the specified coordinate not the right one?
+    if (this->MapToID(nCoordX, nCoordY) != nTileID)
+    {
+        // Coordinate not on tile.
+        return FALSE;
+    }
+
+    // Coordinate on tile.
+    return TRUE;
+}
+
+
+//==============================================================================================
+// GS_OGLMap::IsOnTile():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if a certain source area overlaps a certain kind of tile, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLMap::IsOnTile(RECT rcSource, int nTileID)
+{
+
+    // Do we not have a valid tile ID?
+    if ((nTileID < 0) || (nTileID >= m_gsTileSprites.GetTotalFrames()))
+    {
+        return FALSE;
+    }
+
+    int nMaxCoordY = rcSource.top   + m_nTileHeight;
+    int nMaxCoordX = rcSource.right + m_nTileWidth;
+
+    int nTempX, nTempY;
+
+    // Check every tile within the source rectangle's area.
+    for (int nCoordY = rcSource.bottom; nCoordY < nMaxCoordY; nCoordY += m_nTileHeight)
+    {
+        for (int nCoordX = rcSource.left; nCoordX < nMaxCoordX; nCoordX += m_nTileWidth)
+        {
+            // Have we reached the maximum x-coordinate?
+            if (nCoordX >= rcSource.right)
+            {
+                // Set x-coordinate to maximum.
+                nTempX = rcSource.right-1;
+            }
+            else
+            {
+                nTempX = nCoordX;
+            }
+            // Have we reached the maximum y-coordinate?
+            if (nCoordY >= rcSource.top)
+            {
+                // Set y-coordinate to maximum.
+                nTempY = rcSource.top-1;
+            }
+            else
+            {
+                nTempY = nCoordY;
+            }
+            // Were we able to convert the screen coordinate to a map coordinate?
+            if (this->ScreenToMap(&nTempX, &nTempY))
+            {
+                // Is the tile at the specified coordinate the right kind?
+                if (this->MapToID(nTempX, nTempY) == nTileID)
+                {
+                    // Overlap occured.
+                    return TRUE;
+                }
+            }
+        }
+    }
+
+    // No overlap occured.
+    return FALSE;
+}
+
+
+//==============================================================================================
+// GS_OGLMap::IsInTile():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if a certain source area is within a certain kind of tile(s), FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLMap::IsInTile(RECT rcSource, int nTileID)
+{
+
+    // Do we not have a valid tile ID?
+    if ((nTileID < 0) || (nTileID >= m_gsTileSprites.GetTotalFrames()))
+    {
+        return FALSE;
+    }
+
+    int nMaxCoordY = rcSource.top   + m_nTileHeight;
+    int nMaxCoordX = rcSource.right + m_nTileWidth;
+
+    int nTempX, nTempY;
+
+    // Check every tile within the source rectangle's area.
+    for (int nCoordY = rcSource.bottom; nCoordY < nMaxCoordY; nCoordY += m_nTileHeight)
+    {
+        for (int nCoordX = rcSource.left; nCoordX < nMaxCoordX; nCoordX += m_nTileWidth)
+        {
+            // Have we reached the maximum x-coordinate?
+            if (nCoordX >= rcSource.right)
+            {
+                // Set x-coordinate to maximum.
+                nTempX = rcSource.right-1;
+            }
+            else
+            {
+                nTempX = nCoordX;
+            }
+            // Are the x-coordinates not entirely within the clip box?
+            if ((nTempX < m_rcClipBox.left) || (nTempX >= m_rcClipBox.right))
+            {
+                return FALSE;
+            }
+            // Have we reached the maximum y-coordinate?
+            if (nCoordY >= rcSource.top)
+            {
+                // Set y-coordinate to maximum.
+                nTempY = rcSource.top-1;
+            }
+            else
+            {
+                nTempY = nCoordY;
             }
-            // Are the y-coordinates of the source not within the map area?
-            if ((rcSource.top <= 0) || (rcSource.bottom >= (m_nNumRows * m_nTileHeight)))
+            // Are the y-coordinates not entirely within the clip box?
+            if ((nTempY < m_rcClipBox.bottom) || (nTempY >= m_rcClipBox.top))
             {
-                // Conversion failed.
                 return FALSE;
             }
-        }
-        else
-        {
-            // Conversion failed.
-            return FALSE;
+            // Were we able to convert the screen coordinate to a map coordinate?
+            if (this->ScreenToMap(&nTempX, &nTempY))
+            {
+                // Is the tile at the specified coordinate the wrong kind?
+                if (this->MapToID(nTempX, nTempY) != nTileID)
+                {
+                    // Source not within tile(s).
+                    return FALSE;
+                }
+            }
         }
     }
 
-    // Assign converted rectangle.
-    *prcSource = rcSource;
-
-    // Conversion successful.
+    // Source is within tile(s).
     return TRUE;
 }
 
@@ -1865,24 +3050,19 @@ BOOL GS_OGLMap::ScreenToMap(RECT* prcSource)
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
-////////////////////////////////////////////////////////////////////////////////////////////////
-// Collision Methods. //////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////////////////////
-
-
 //==============================================================================================
 // GS_OGLMap::IsOnTile():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: TRUE if a certain point overlaps a certain kind of tile, FALSE if not.
+// Returns: TRUE if a certain point overlaps a certain tile, FALSE if not.
 //==============================================================================================
 
-BOOL GS_OGLMap::IsOnTile(int nCoordX, int nCoordY, int nTileID)
+BOOL GS_OGLMap::IsOnTile(int nCoordX, int nCoordY, int nRow, int nCol)
 {
 
-    // Do we not have a valid tile ID?
-    if ((nTileID < 0) || (nTileID >= m_gsTileSprites.GetTotalFrames()))
+    // Do we not have a valid map row and column?
+    if ((nRow < 0) || (nRow >= m_nNumRows) || (nCol < 0) || (nCol >= m_nNumCols))
     {
         return FALSE;
     }
@@ -1894,8 +3074,15 @@ BOOL GS_OGLMap::IsOnTile(int nCoordX, int nCoordY, int nTileID)
         return FALSE;
     }
 
-    // Is the tile at the specified coordinate not the right one?
-    if (this->MapToID(nCoordX, nCoordY) != nTileID)
+    // Is the x-coordinate not in the correct map column?
+    if (nCol != (nCoordX-(nCoordX%m_nTileWidth)) / m_nTileWidth)
+    {
+        // Coordinate not on tile.
+        return FALSE;
+    }
+
+    // Is the y-coordinate not in the correct map row?
+    if (nRow != (nCoordY-(nCoordY%m_nTileHeight)) / m_nTileHeight)
     {
         // Coordinate not on tile.
         return FALSE;
@@ -1911,63 +3098,105 @@ BOOL GS_OGLMap::IsOnTile(int nCoordX, int nCoordY, int nTileID)
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: TRUE if a certain source area overlaps a certain kind of tile, FALSE if not.
+// Returns: TRUE if a certain source area overlaps a certain tile area, FALSE if not.
 //==============================================================================================
 
-BOOL GS_OGLMap::IsOnTile(RECT rcSource, int nTileID)
+BOOL GS_OGLMap::IsOnTile(RECT rcSource, int nRow, int nCol)
 {
 
-    // Do we not have a valid tile ID?
-    if ((nTileID < 0) || (nTileID >= m_gsTileSprites.GetTotalFrames()))
+    // Do we not have a valid map row and column?
+    if ((nRow < 0) || (nRow >= m_nNumRows) || (nCol < 0) || (nCol >= m_nNumCols))
     {
         return FALSE;
     }
 
-    int nMaxCoordY = rcSource.top   + m_nTileHeight;
-    int nMaxCoordX = rcSource.right + m_nTileWidth;
+    // Are the x-coordinates of the source not within the clip box?
+    if ((rcSource.right <= m_rcClipBox.left) || (rcSource.left >= m_rcClipBox.right))
+    {
+        return FALSE;
+    }
 
-    int nTempX, nTempY;
+    // Are the y-coordinates of the source not within the clip box?
+    if ((rcSource.top <= m_rcClipBox.bottom) || (rcSource.bottom >= m_rcClipBox.top))
+    {
+        return FALSE;
+    }
 
-    // Check every tile within the source rectangle's area.
-    for (int nCoordY = rcSource.bottom; nCoordY < nMaxCoordY; nCoordY += m_nTileHeight)
+    RECT rcTile;
+
+    // Determine the map coordinates of the specified tile.
+    rcTile.left   = nCol * m_nTileWidth;
+    rcTile.right  = rcTile.left + m_nTileWidth;
+    rcTile.bottom = nRow * m_nTileHeight;
+    rcTile.top    = rcTile.bottom + m_nTileHeight;
+
+    // Were we unable to convert the map to screen coordinates?
+    if (!this->MapToScreen(&rcTile))
     {
-        for (int nCoordX = rcSource.left; nCoordX < nMaxCoordX; nCoordX += m_nTileWidth)
-        {
-            // Have we reached the maximum x-coordinate?
-            if (nCoordX >= rcSource.right)
-            {
-                // Set x-coordinate to maximum.
-                nTempX = rcSource.right-1;
-            }
-            else
-            {
-                nTempX = nCoordX;
-            }
-            // Have we reached the maximum y-coordinate?
-            if (nCoordY >= rcSource.top)
-            {
-                // Set y-coordinate to maximum.
-                nTempY = rcSource.top-1;
-            }
-            else
-            {
-                nTempY = nCoordY;
-            }
-            // Were we able to convert the screen coordinate to a map coordinate?
-            if (this->ScreenToMap(&nTempX, &nTempY))
-            {
-                // Is the tile at the specified coordinate the right kind?
-                if (this->MapToID(nTempX, nTempY) == nTileID)
-                {
-                    // Overlap occured.
-                    return TRUE;
-                }
-            }
-        }
+        // No overlap possible.
+        return FALSE;
     }
 
-    // No overlap occured.
-    return FALSE;
+    // +--------+
+    // |        |
+    // |  TILE  |
+    // |        |
+    // +--------+
+    // +--------+
+    // |        |
+    // | SOURCE |
+    // |        |
+    // +--------+
+
+    if (rcSource.top <= rcTile.bottom)
+    {
+        // No overlap possible.
+        return FALSE;
+    }
+
+    // +--------+
+    // |        |
+    // | SOURCE |
+    // |        |
+    // +--------+
+    // +--------+
+    // |        |
+    // |  TILE  |
+    // |        |
+    // +--------+
+
+    if (rcSource.bottom >= rcTile.top)
+    {
+        // No overlap possible.
+        return FALSE;
+    }
+
+    // +--------+ +--------+
+    // |        | |        |
+    // | SOURCE | |  TILE  |
+    // |        | |        |
+    // +--------+ +--------+
+
+    if (rcSource.right <= rcTile.left)
+    {
+        // No overlap possible.
+        return FALSE;
+    }
+
+    // +--------+ +--------+
+    // |        | |        |
+    // |  TILE  | | SOURCE |
+    // |        | |        |
+    // +--------+ +--------+
+
+    if (rcSource.left >= rcTile.right)
+    {
+        // No overlap possible.
+        return FALSE;
+    }
+
+    // Overlap has occured.
+    return TRUE;
 }
 
 
@@ -1976,72 +3205,90 @@ BOOL GS_OGLMap::IsOnTile(RECT rcSource, int nTileID)
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: TRUE if a certain source area is within a certain kind of tile(s), FALSE if not.
+// Returns: TRUE if a certain source area is within a certain tile, FALSE if not.
 //==============================================================================================
 
-BOOL GS_OGLMap::IsInTile(RECT rcSource, int nTileID)
+BOOL GS_OGLMap::IsInTile(RECT rcSource, int nRow, int nCol)
 {
 
-    // Do we not have a valid tile ID?
-    if ((nTileID < 0) || (nTileID >= m_gsTileSprites.GetTotalFrames()))
+    // Do we not have a valid map row and column?
+    if ((nRow < 0) || (nRow >= m_nNumRows) || (nCol < 0) || (nCol >= m_nNumCols))
     {
         return FALSE;
     }
 
-    int nMaxCoordY = rcSource.top   + m_nTileHeight;
-    int nMaxCoordX = rcSource.right + m_nTileWidth;
+    // Are the x-coordinates of the source not entirely within the clip box?
+    if ((rcSource.left < m_rcClipBox.left) || (rcSource.right > m_rcClipBox.right))
+    {
+        return FALSE;
+    }
 
-    int nTempX, nTempY;
+    // Are the y-coordinates of the source not entirely within the clip box?
+    if ((rcSource.bottom < m_rcClipBox.bottom) || (rcSource.top > m_rcClipBox.top))
+    {
+        return FALSE;
+    }
+
+    // Is the source wider than the tile?
+    if (m_nTileWidth < (rcSource.right - rcSource.left))
+    {
+        return FALSE;
+    }
+
+    // Is the source higher than the tile?
+    if (m_nTileHeight < (rcSource.top - rcSource.bottom))
+    {
+        return FALSE;
+    }
+
+    RECT rcTile;
+
+    // Determine the map coordinates of the specified tile.
+    rcTile.left   = nCol * m_nTileWidth;
+    rcTile.right  = rcTile.left + m_nTileWidth;
+    rcTile.bottom = nRow * m_nTileHeight;
+    rcTile.top    = rcTile.bottom + m_nTileHeight;
+
+    // Were we unable to convert the map to screen coordinates?
+    if (!this->MapToScreen(&rcTile))
+    {
+        // Source not within tile.
+        return FALSE;
+    }
+
+    //   +------+
+    //   |      |
+    // +-|      |-+
+    // | |      | |
+    // | |      | |
+    // | |      | |
+    // +-|      |-+
+    //   |      |
+    //   +------+
+
+    if ((rcSource.top > rcTile.top)  || (rcSource.bottom < rcTile.bottom))
+    {
+        // Source not within tile.
+        return FALSE;
+    }
+
+    //   +------+
+    //   |      |
+    // +----------+
+    // |          |
+    // |          |
+    // |          |
+    // +----------+
+    //   |      |
+    //   +------+
 
-    // Check every tile within the source rectangle's area.
-    for (int nCoordY = rcSource.bottom; nCoordY < nMaxCoordY; nCoordY += m_nTileHeight)
+    if ((rcSource.right > rcTile.right) || (rcSource.left < rcTile.left))
     {
-        for (int nCoordX = rcSource.left; nCoordX < nMaxCoordX; nCoordX += m_nTileWidth)
-        {
-            // Have we reached the maximum x-coordinate?
-            if (nCoordX >= rcSource.right)
-            {
-                // Set x-coordinate to maximum.
-                nTempX = rcSource.right-1;
-            }
-            else
-            {
-                nTempX = nCoordX;
-            }
-            // Are the x-coordinates not entirely within the clip box?
-            if ((nTempX < m_rcClipBox.left) || (nTempX >= m_rcClipBox.right))
-            {
-                return FALSE;
-            }
-            // Have we reached the maximum y-coordinate?
-            if (nCoordY >= rcSource.top)
-            {
-                // Set y-coordinate to maximum.
-                nTempY = rcSource.top-1;
-            }
-            else
-            {
-                nTempY = nCoordY;
-            }
-            // Are the y-coordinates not entirely within the clip box?
-            if ((nTempY < m_rcClipBox.bottom) || (nTempY >= m_rcClipBox.top))
-            {
-                return FALSE;
-            }
-            // Were we able to convert the screen coordinate to a map coordinate?
-            if (this->ScreenToMap(&nTempX, &nTempY))
-            {
-                // Is the tile at the specified coordinate the wrong kind?
-                if (this->MapToID(nTempX, nTempY) != nTileID)
-                {
-                    // Source not within tile(s).
-                    return FALSE;
-                }
-            }
-        }
+        // Source not within tile.
+        return FALSE;
     }
 
-    // Source is within tile(s).
+    // Source within tile.
     return TRUE;
 }
 
@@ -2050,65 +3297,65 @@ BOOL GS_OGLMap::IsInTile(RECT rcSource, int nTileID)
 
 
 //==============================================================================================
-// GS_OGLMap::IsOnTile():
+// GS_OGLMap::IsOnArea():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: TRUE if a certain point overlaps a certain tile, FALSE if not.
+// Returns: TRUE if a certain point overlaps a certain map area, FALSE if not.
 //==============================================================================================
 
-BOOL GS_OGLMap::IsOnTile(int nCoordX, int nCoordY, int nRow, int nCol)
+BOOL GS_OGLMap::IsOnArea(int nCoordX, int nCoordY, RECT rcMapArea)
 {
 
-    // Do we not have a valid map row and column?
-    if ((nRow < 0) || (nRow >= m_nNumRows) || (nCol < 0) || (nCol >= m_nNumCols))
-    {
-        return FALSE;
-    }
-
     // Were we unable to convert the screen to map coordinate?
     if (!this->ScreenToMap(&nCoordX, &nCoordY))
     {
-        // Coordinate not on tile.
+        // Coordinate not in area.
         return FALSE;
     }
 
-    // Is the x-coordinate not in the correct map column?
-    if (nCol != (nCoordX-(nCoordX%m_nTileWidth)) / m_nTileWidth)
+    // (x, y)
+    // +--------+
+    // |        |
+    // |  TILE  |
+    // |        |
+    // +--------+
+    // (x, y)
+
+    if ((nCoordY < rcMapArea.bottom) || (nCoordY >= rcMapArea.top))
     {
-        // Coordinate not on tile.
+        // Coordinate not in area.
         return FALSE;
     }
 
-    // Is the y-coordinate not in the correct map row?
-    if (nRow != (nCoordY-(nCoordY%m_nTileHeight)) / m_nTileHeight)
+    //        +--------+
+    //        |        |
+    // (x, y) |  TILE  | (x, y)
+    //        |        |
+    //        +--------+
+
+    if ((nCoordX < rcMapArea.left) || (nCoordX >= rcMapArea.right))
     {
-        // Coordinate not on tile.
+        // Coordinate not in area.
         return FALSE;
     }
 
-    // Coordinate on tile.
+    // Coordinate in area.
     return TRUE;
 }
 
 
 //==============================================================================================
-// GS_OGLMap::IsOnTile():
+// GS_OGLMap::IsOnArea():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: TRUE if a certain source area overlaps a certain tile area, FALSE if not.
+// Returns: TRUE if a certain source area overlaps a certain map area, FALSE if not.
 //==============================================================================================
 
-BOOL GS_OGLMap::IsOnTile(RECT rcSource, int nRow, int nCol)
+BOOL GS_OGLMap::IsOnArea(RECT rcSource, RECT rcMapArea)
 {
 
-    // Do we not have a valid map row and column?
-    if ((nRow < 0) || (nRow >= m_nNumRows) || (nCol < 0) || (nCol >= m_nNumCols))
-    {
-        return FALSE;
-    }
-
     // Are the x-coordinates of the source not within the clip box?
     if ((rcSource.right <= m_rcClipBox.left) || (rcSource.left >= m_rcClipBox.right))
     {
@@ -2121,16 +3368,8 @@ BOOL GS_OGLMap::IsOnTile(RECT rcSource, int nRow, int nCol)
         return FALSE;
     }
 
-    RECT rcTile;
-
-    // Determine the map coordinates of the specified tile.
-    rcTile.left   = nCol * m_nTileWidth;
-    rcTile.right  = rcTile.left + m_nTileWidth;
-    rcTile.bottom = nRow * m_nTileHeight;
-    rcTile.top    = rcTile.bottom + m_nTileHeight;
-
     // Were we unable to convert the map to screen coordinates?
-    if (!this->MapToScreen(&rcTile))
+    if (!this->MapToScreen(&rcMapArea))
     {
         // No overlap possible.
         return FALSE;
@@ -2147,7 +3386,7 @@ BOOL GS_OGLMap::IsOnTile(RECT rcSource, int nRow, int nCol)
     // |        |
     // +--------+
 
-    if (rcSource.top <= rcTile.bottom)
+    if (rcSource.top <= rcMapArea.bottom)
     {
         // No overlap possible.
         return FALSE;
@@ -2164,7 +3403,7 @@ BOOL GS_OGLMap::IsOnTile(RECT rcSource, int nRow, int nCol)
     // |        |
     // +--------+
 
-    if (rcSource.bottom >= rcTile.top)
+    if (rcSource.bottom >= rcMapArea.top)
     {
         // No overlap possible.
         return FALSE;
@@ -2176,7 +3415,7 @@ BOOL GS_OGLMap::IsOnTile(RECT rcSource, int nRow, int nCol)
     // |        | |        |
     // +--------+ +--------+
 
-    if (rcSource.right <= rcTile.left)
+    if (rcSource.right <= rcMapArea.left)
     {
         // No overlap possible.
         return FALSE;
@@ -2188,7 +3427,7 @@ BOOL GS_OGLMap::IsOnTile(RECT rcSource, int nRow, int nCol)
     // |        | |        |
     // +--------+ +--------+
 
-    if (rcSource.left >= rcTile.right)
+    if (rcSource.left >= rcMapArea.right)
     {
         // No overlap possible.
         return FALSE;
@@ -2200,22 +3439,16 @@ BOOL GS_OGLMap::IsOnTile(RECT rcSource, int nRow, int nCol)
 
 
 //==============================================================================================
-// GS_OGLMap::IsInTile():
+// GS_OGLMap::IsInArea():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: TRUE if a certain source area is within a certain tile, FALSE if not.
+// Returns: TRUE if a certain source area is within a certain map area, FALSE if not.
 //==============================================================================================
 
-BOOL GS_OGLMap::IsInTile(RECT rcSource, int nRow, int nCol)
+BOOL GS_OGLMap::IsInArea(RECT rcSource, RECT rcMapArea)
 {
 
-    // Do we not have a valid map row and column?
-    if ((nRow < 0) || (nRow >= m_nNumRows) || (nCol < 0) || (nCol >= m_nNumCols))
-    {
-        return FALSE;
-    }
-
     // Are the x-coordinates of the source not entirely within the clip box?
     if ((rcSource.left < m_rcClipBox.left) || (rcSource.right > m_rcClipBox.right))
     {
@@ -2228,30 +3461,22 @@ BOOL GS_OGLMap::IsInTile(RECT rcSource, int nRow, int nCol)
         return FALSE;
     }
 
-    // Is the source wider than the tile?
-    if (m_nTileWidth < (rcSource.right - rcSource.left))
+    // Is the source wider than the map area?
+    if ((rcMapArea.right - rcMapArea.left) < (rcSource.right - rcSource.left))
     {
         return FALSE;
     }
 
-    // Is the source higher than the tile?
-    if (m_nTileHeight < (rcSource.top - rcSource.bottom))
+    // Is the source higher than the map area?
+    if ((rcMapArea.top - rcMapArea.bottom) < (rcSource.top - rcSource.bottom))
     {
         return FALSE;
     }
 
-    RECT rcTile;
-
-    // Determine the map coordinates of the specified tile.
-    rcTile.left   = nCol * m_nTileWidth;
-    rcTile.right  = rcTile.left + m_nTileWidth;
-    rcTile.bottom = nRow * m_nTileHeight;
-    rcTile.top    = rcTile.bottom + m_nTileHeight;
-
     // Were we unable to convert the map to screen coordinates?
-    if (!this->MapToScreen(&rcTile))
+    if (!this->MapToScreen(&rcMapArea))
     {
-        // Source not within tile.
+        // No overlap possible.
         return FALSE;
     }
 
@@ -2265,9 +3490,9 @@ BOOL GS_OGLMap::IsInTile(RECT rcSource, int nRow, int nCol)
     //   |      |
     //   +------+
 
-    if ((rcSource.top > rcTile.top)  || (rcSource.bottom < rcTile.bottom))
+    if ((rcSource.top > rcMapArea.top)  || (rcSource.bottom < rcMapArea.bottom))
     {
-        // Source not within tile.
+        // Source not within area vertically.
         return FALSE;
     }
 
@@ -2281,238 +3506,516 @@ BOOL GS_OGLMap::IsInTile(RECT rcSource, int nRow, int nCol)
     //   |      |
     //   +------+
 
-    if ((rcSource.right > rcTile.right) || (rcSource.left < rcTile.left))
+    if ((rcSource.right > rcMapArea.right) || (rcSource.left < rcMapArea.left))
+    {
+        // Source not within area horizontally.
+        return FALSE;
+    }
+
+    // Source within area.
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Collision Flag Methods. /////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::CreateChunkTiles():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Allocates the tiles of a chunk and their collision flags, all tiles start out empty
+//          and without flags.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the tiles were allocated, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLMap::CreateChunkTiles(GS_MapChunk* pChunk)
+{
+
+    pChunk->pTiles = new unsigned short[GS_MAP_CHUNK_SIZE * GS_MAP_CHUNK_SIZE];
+    pChunk->pFlags = new BYTE[GS_MAP_CHUNK_SIZE * GS_MAP_CHUNK_SIZE];
+
+    if ((NULL == pChunk->pTiles) || (NULL == pChunk->pFlags))
+    {
+        GS_Error::Report("GS_OGL_MAP.CPP", 3300, "Failed to allocate map chunk tiles!");
+        GS_SAFE_DELETE_ARRAY(pChunk->pTiles);
+        GS_SAFE_DELETE_ARRAY(pChunk->pFlags);
+        return FALSE;
+    }
+
+    for (int nLoop = 0; nLoop < GS_MAP_CHUNK_SIZE * GS_MAP_CHUNK_SIZE; nLoop++)
+    {
+        pChunk->pTiles[nLoop] = GS_MAP_EMPTY_TILE;
+        pChunk->pFlags[nLoop] = 0;
+    }
+
+    return TRUE;
+}
+
+
+//==============================================================================================
+// GS_OGLMap::BuildFlags():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the collision flags of every tile of a chunk from the flags of its tile ID.
+//          SetTileID() and SetTileFlags() keep them up to date after that, so only loading the
+//          tiles of a chunk needs to build them.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLMap::BuildFlags(GS_MapChunk* pChunk)
+{
+
+    if ((NULL == pChunk->pTiles) || (NULL == pChunk->pFlags))
+    {
+        return;
+    }
+
+    for (int nLoop = 0; nLoop < GS_MAP_CHUNK_SIZE * GS_MAP_CHUNK_SIZE; nLoop++)
+    {
+        pChunk->pFlags[nLoop] = this->GetTileFlags(pChunk->pTiles[nLoop]);
+    }
+}
+
+
+//==============================================================================================
+// GS_OGLMap::GetTileCol():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Converts a map x-coordinate to a column, rounding down for coordinates left of the
+//          map too. The column may lie outside of the map.
+// ---------------------------------------------------------------------------------------------
+// Returns: The column containing the coordinate.
+//==============================================================================================
+
+int GS_OGLMap::GetTileCol(long lCoordX)
+{
+
+    if (lCoordX >= 0)
+    {
+        return (int) (lCoordX / m_nTileWidth);
+    }
+
+    return (int) (-((-lCoordX - 1) / m_nTileWidth) - 1);
+}
+
+
+//==============================================================================================
+// GS_OGLMap::GetTileRow():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Converts a map y-coordinate to a row, rounding down for coordinates below the map
+//          too. The row may lie outside of the map.
+// ---------------------------------------------------------------------------------------------
+// Returns: The row containing the coordinate.
+//==============================================================================================
+
+int GS_OGLMap::GetTileRow(long lCoordY)
+{
+
+    if (lCoordY >= 0)
+    {
+        return (int) (lCoordY / m_nTileHeight);
+    }
+
+    return (int) (-((-lCoordY - 1) / m_nTileHeight) - 1);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::SetTileFlags():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the collision flags (GS_MAP_TILE_SOLID or any other bits) of all the tiles with
+//          the specified ID. Only the tiles with that ID are updated, chunks without tiles are
+//          skipped.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLMap::SetTileFlags(int nTileID, BYTE ucFlags)
+{
+
+    if ((nTileID < 0) || (nTileID > GS_MAP_MAX_TILE_ID) ||
+        (this->GetTileFlags(nTileID) == ucFlags))
+    {
+        return;
+    }
+
+    // Make room for the flags of the tile ID.
+    if (nTileID >= m_nNumTileFlags)
+    {
+        BYTE* pTileFlags = new BYTE[nTileID + 1];
+
+        if (NULL == pTileFlags)
+        {
+            GS_Error::Report("GS_OGL_MAP.CPP", 3350, "Failed to allocate tile flags!");
+            return;
+        }
+
+        for (int nLoop = 0; nLoop <= nTileID; nLoop++)
+        {
+            pTileFlags[nLoop] = (nLoop < m_nNumTileFlags) ? m_pTileFlags[nLoop] : 0;
+        }
+
+        GS_SAFE_DELETE_ARRAY(m_pTileFlags);
+
+        m_pTileFlags    = pTileFlags;
+        m_nNumTileFlags = nTileID + 1;
+    }
+
+    m_pTileFlags[nTileID] = ucFlags;
+
+    if (NULL == m_pChunks)
     {
-        // Source not within tile.
-        return FALSE;
+        return;
     }
 
-    // Source within tile.
-    return TRUE;
-}
+    for (int nLoop = 0; nLoop < m_nNumChunkCols * m_nNumChunkRows; nLoop++)
+    {
+        GS_MapChunk* pChunk = &m_pChunks[nLoop];
 
+        if (NULL == pChunk->pTiles)
+        {
+            continue;
+        }
 
-////////////////////////////////////////////////////////////////////////////////////////////////
+        for (int nTile = 0; nTile < GS_MAP_CHUNK_SIZE * GS_MAP_CHUNK_SIZE; nTile++)
+        {
+            if (pChunk->pTiles[nTile] == nTileID)
+            {
+                pChunk->pFlags[nTile] = ucFlags;
+            }
+        }
+    }
+}
 
 
 //==============================================================================================
-// GS_OGLMap::IsOnArea():
+// GS_OGLMap::GetTileFlags():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: TRUE if a certain point overlaps a certain map area, FALSE if not.
+// Returns: The collision flags of the specified tile ID, 0 for empty tiles.
 //==============================================================================================
 
-BOOL GS_OGLMap::IsOnArea(int nCoordX, int nCoordY, RECT rcMapArea)
+BYTE GS_OGLMap::GetTileFlags(int nTileID)
 {
 
-    // Were we unable to convert the screen to map coordinate?
-    if (!this->ScreenToMap(&nCoordX, &nCoordY))
-    {
-        // Coordinate not in area.
-        return FALSE;
-    }
-
-    // (x, y)
-    // +--------+
-    // |        |
-    // |  TILE  |
-    // |        |
-    // +--------+
-    // (x, y)
-
-    if ((nCoordY < rcMapArea.bottom) || (nCoordY >= rcMapArea.top))
+    if ((nTileID < 0) || (nTileID >= m_nNumTileFlags))
     {
-        // Coordinate not in area.
-        return FALSE;
+        return 0;
     }
 
-    //        +--------+
-    //        |        |
-    // (x, y) |  TILE  | (x, y)
-    //        |        |
-    //        +--------+
+    return m_pTileFlags[nTileID];
+}
 
-    if ((nCoordX < rcMapArea.left) || (nCoordX >= rcMapArea.right))
-    {
-        // Coordinate not in area.
-        return FALSE;
-    }
 
-    // Coordinate in area.
-    return TRUE;
-}
+////////////////////////////////////////////////////////////////////////////////////////////////
 
 
 //==============================================================================================
-// GS_OGLMap::IsOnArea():
+// GS_OGLMap::GetFlags():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Gets the collision flags of the tile at the specified row and column. Rows and
+//          columns outside of the map are wrapped around if the map wraps in that direction.
 // ---------------------------------------------------------------------------------------------
-// Returns: TRUE if a certain source area overlaps a certain map area, FALSE if not.
+// Returns: The collision flags of the tile, 0 if the tile is outside of the map.
 //==============================================================================================
 
-BOOL GS_OGLMap::IsOnArea(RECT rcSource, RECT rcMapArea)
+BYTE GS_OGLMap::GetFlags(int nRow, int nCol)
 {
 
-    // Are the x-coordinates of the source not within the clip box?
-    if ((rcSource.right <= m_rcClipBox.left) || (rcSource.left >= m_rcClipBox.right))
+    if (NULL == m_pChunks)
     {
-        return FALSE;
+        return 0;
     }
 
-    // Are the y-coordinates of the source not within the clip box?
-    if ((rcSource.top <= m_rcClipBox.bottom) || (rcSource.bottom >= m_rcClipBox.top))
+    if ((nCol < 0) || (nCol >= m_nNumCols))
     {
-        return FALSE;
+        if (!m_bWrapX)
+        {
+            return 0;
+        }
+
+        nCol %= m_nNumCols;
+
+        if (nCol < 0)
+        {
+            nCol += m_nNumCols;
+        }
     }
 
-    // Were we unable to convert the map to screen coordinates?
-    if (!this->MapToScreen(&rcMapArea))
+    if ((nRow < 0) || (nRow >= m_nNumRows))
     {
-        // No overlap possible.
-        return FALSE;
-    }
+        if (!m_bWrapY)
+        {
+            return 0;
+        }
 
-    // +--------+
-    // |        |
-    // |  TILE  |
-    // |        |
-    // +--------+
-    // +--------+
-    // |        |
-    // | SOURCE |
-    // |        |
-    // +--------+
+        nRow %= m_nNumRows;
 
-    if (rcSource.top <= rcMapArea.bottom)
-    {
-        // No overlap possible.
-        return FALSE;
+        if (nRow < 0)
+        {
+            nRow += m_nNumRows;
+        }
     }
 
-    // +--------+
-    // |        |
-    // | SOURCE |
-    // |        |
-    // +--------+
-    // +--------+
-    // |        |
-    // |  TILE  |
-    // |        |
-    // +--------+
+    GS_MapChunk* pChunk = &m_pChunks[((nRow / GS_MAP_CHUNK_SIZE) * m_nNumChunkCols) +
+                                     (nCol / GS_MAP_CHUNK_SIZE)];
 
-    if (rcSource.bottom >= rcMapArea.top)
+    // Tiles in unallocated chunks are empty.
+    if (NULL == pChunk->pFlags)
     {
-        // No overlap possible.
-        return FALSE;
+        return 0;
     }
 
-    // +--------+ +--------+
-    // |        | |        |
-    // | SOURCE | |  TILE  |
-    // |        | |        |
-    // +--------+ +--------+
+    return pChunk->pFlags[((nRow % GS_MAP_CHUNK_SIZE) * GS_MAP_CHUNK_SIZE) +
+                          (nCol % GS_MAP_CHUNK_SIZE)];
+}
 
-    if (rcSource.right <= rcMapArea.left)
+
+//==============================================================================================
+// GS_OGLMap::GetFlags():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Gets the collision flags of all the tiles a map area (in map coordinates) overlaps.
+//          Each tile is looked up once, however many pixels of it the area covers.
+// ---------------------------------------------------------------------------------------------
+// Returns: The collision flags of all the tiles or'ed together.
+//==============================================================================================
+
+BYTE GS_OGLMap::GetFlags(RECT rcMapArea)
+{
+
+    // Without tile sizes (before Create()) there is nothing to convert the area to tiles by.
+    if ((NULL == m_pChunks) || (m_nTileWidth <= 0) || (m_nTileHeight <= 0) ||
+        (rcMapArea.right <= rcMapArea.left) || (rcMapArea.top <= rcMapArea.bottom))
     {
-        // No overlap possible.
-        return FALSE;
+        return 0;
     }
 
-    // +--------+ +--------+
-    // |        | |        |
-    // |  TILE  | | SOURCE |
-    // |        | |        |
-    // +--------+ +--------+
+    BYTE ucFlags = 0;
 
-    if (rcSource.left >= rcMapArea.right)
+    int nLastRow = this->GetTileRow(rcMapArea.top - 1);
+    int nLastCol = this->GetTileCol(rcMapArea.right - 1);
+
+    for (int nRow = this->GetTileRow(rcMapArea.bottom); nRow <= nLastRow; nRow++)
     {
-        // No overlap possible.
-        return FALSE;
+        for (int nCol = this->GetTileCol(rcMapArea.left); nCol <= nLastCol; nCol++)
+        {
+            ucFlags |= this->GetFlags(nRow, nCol);
+        }
     }
 
-    // Overlap has occured.
-    return TRUE;
+    return ucFlags;
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
-// GS_OGLMap::IsInArea():
+// GS_OGLMap::SweepRect():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Finds the first tile with any of the specified flags that a map area (in map
+//          coordinates) runs into when it is moved by nMoveX and nMoveY. Only the tiles the
+//          moving area passes over are tested. Tiles the area already overlaps are ignored, so
+//          an area stuck inside a tile can always move out of it, and an area that ends up just
+//          touching a tile has not hit it.
 // ---------------------------------------------------------------------------------------------
-// Returns: TRUE if a certain source area is within a certain map area, FALSE if not.
+// Returns: TRUE and the contact with the first tile if a tile was hit, FALSE and a contact
+//          allowing the whole move if not.
 //==============================================================================================
 
-BOOL GS_OGLMap::IsInArea(RECT rcSource, RECT rcMapArea)
+BOOL GS_OGLMap::SweepRect(RECT rcMapArea, int nMoveX, int nMoveY, BYTE ucFlags,
+                          GS_MapContact* pContact)
 {
 
-    // Are the x-coordinates of the source not entirely within the clip box?
-    if ((rcSource.left < m_rcClipBox.left) || (rcSource.right > m_rcClipBox.right))
-    {
-        return FALSE;
-    }
+    GS_MapContact gsContact;
 
-    // Are the y-coordinates of the source not entirely within the clip box?
-    if ((rcSource.bottom < m_rcClipBox.bottom) || (rcSource.top > m_rcClipBox.top))
-    {
-        return FALSE;
-    }
+    gsContact.fTime    = 1.0f;
+    gsContact.nMoveX   = nMoveX;
+    gsContact.nMoveY   = nMoveY;
+    gsContact.nNormalX = 0;
+    gsContact.nNormalY = 0;
+    gsContact.nRow     = -1;
+    gsContact.nCol     = -1;
 
-    // Is the source wider than the map area?
-    if ((rcMapArea.right - rcMapArea.left) < (rcSource.right - rcSource.left))
-    {
-        return FALSE;
-    }
+    BOOL bIsHit = FALSE;
 
-    // Is the source higher than the map area?
-    if ((rcMapArea.top - rcMapArea.bottom) < (rcSource.top - rcSource.bottom))
+    if ((m_pChunks != NULL) && (m_nTileWidth > 0) && (m_nTileHeight > 0) &&
+        ((nMoveX != 0) || (nMoveY != 0)) &&
+        (rcMapArea.right > rcMapArea.left) && (rcMapArea.top > rcMapArea.bottom))
     {
-        return FALSE;
+        // The tiles covered by the area anywhere along the move.
+        int nFirstCol = this->GetTileCol(rcMapArea.left + ((nMoveX < 0) ? nMoveX : 0));
+        int nLastCol  = this->GetTileCol(rcMapArea.right + ((nMoveX > 0) ? nMoveX : 0) - 1);
+        int nFirstRow = this->GetTileRow(rcMapArea.bottom + ((nMoveY < 0) ? nMoveY : 0));
+        int nLastRow  = this->GetTileRow(rcMapArea.top + ((nMoveY > 0) ? nMoveY : 0) - 1);
+
+        for (int nRow = nFirstRow; nRow <= nLastRow; nRow++)
+        {
+            long lTileBottom = (long) nRow * m_nTileHeight;
+            long lTileTop    = lTileBottom + m_nTileHeight;
+
+            for (int nCol = nFirstCol; nCol <= nLastCol; nCol++)
+            {
+                if (!(this->GetFlags(nRow, nCol) & ucFlags))
+                {
+                    continue;
+                }
+
+                long lTileLeft  = (long) nCol * m_nTileWidth;
+                long lTileRight = lTileLeft + m_nTileWidth;
+
+                BOOL bIsOverX = (rcMapArea.right > lTileLeft) && (rcMapArea.left < lTileRight);
+                BOOL bIsOverY = (rcMapArea.top > lTileBottom) && (rcMapArea.bottom < lTileTop);
+
+                // Is the area already overlapping the tile?
+                if (bIsOverX && bIsOverY)
+                {
+                    continue;
+                }
+
+                // Determine when the area starts and stops overlapping the tile along each
+                // axis, an axis without movement overlaps during the whole move or never.
+                float fEntryX = -1.0f, fExitX = 2.0f;
+                float fEntryY = -1.0f, fExitY = 2.0f;
+
+                if (nMoveX > 0)
+                {
+                    fEntryX = (float) (lTileLeft - rcMapArea.right) / nMoveX;
+                    fExitX  = (float) (lTileRight - rcMapArea.left) / nMoveX;
+                }
+                else if (nMoveX < 0)
+                {
+                    fEntryX = (float) (lTileRight - rcMapArea.left) / nMoveX;
+                    fExitX  = (float) (lTileLeft - rcMapArea.right) / nMoveX;
+                }
+                else if (!bIsOverX)
+                {
+                    continue;
+                }
+
+                if (nMoveY > 0)
+                {
+                    fEntryY = (float) (lTileBottom - rcMapArea.top) / nMoveY;
+                    fExitY  = (float) (lTileTop - rcMapArea.bottom) / nMoveY;
+                }
+                else if (nMoveY < 0)
+                {
+                    fEntryY = (float) (lTileTop - rcMapArea.bottom) / nMoveY;
+                    fExitY  = (float) (lTileBottom - rcMapArea.top) / nMoveY;
+                }
+                else if (!bIsOverY)
+                {
+                    continue;
+                }
+
+                float fEntry = (fEntryX > fEntryY) ? fEntryX : fEntryY;
+                float fExit  = (fExitX < fExitY) ? fExitX : fExitY;
+
+                // The area overlaps the tile between entering it along both axes and leaving
+                // it along either, is that during this move and before any other tile?
+                if ((fEntry >= fExit) || (fEntry < 0.0f) || (fEntry >= gsContact.fTime))
+                {
+                    continue;
+                }
+
+                bIsHit = TRUE;
+
+                gsContact.fTime    = fEntry;
+                gsContact.nNormalX = (fEntryX >= fEntryY) ? ((nMoveX > 0) ? -1 : 1) : 0;
+                gsContact.nNormalY = (fEntryY >= fEntryX) ? ((nMoveY > 0) ? -1 : 1) : 0;
+                gsContact.nRow     = nRow;
+                gsContact.nCol     = nCol;
+
+                // Stop against the tile, whole pixels along the axis that hit it and the
+                // covered part of the move along the other.
+                if (gsContact.nNormalX != 0)
+                {
+                    gsContact.nMoveX = (nMoveX > 0) ? (int) (lTileLeft - rcMapArea.right) :
+                                                      (int) (lTileRight - rcMapArea.left);
+                }
+                else
+                {
+                    gsContact.nMoveX = (int) (nMoveX * fEntry);
+                }
+
+                if (gsContact.nNormalY != 0)
+                {
+                    gsContact.nMoveY = (nMoveY > 0) ? (int) (lTileBottom - rcMapArea.top) :
+                                                      (int) (lTileTop - rcMapArea.bottom);
+                }
+                else
+                {
+                    gsContact.nMoveY = (int) (nMoveY * fEntry);
+                }
+            }
+        }
     }
 
-    // Were we unable to convert the map to screen coordinates?
-    if (!this->MapToScreen(&rcMapArea))
+    if (pContact != NULL)
     {
-        // No overlap possible.
-        return FALSE;
+        *pContact = gsContact;
     }
 
-    //   +------+
-    //   |      |
-    // +-|      |-+
-    // | |      | |
-    // | |      | |
-    // | |      | |
-    // +-|      |-+
-    //   |      |
-    //   +------+
+    return bIsHit;
+}
 
-    if ((rcSource.top > rcMapArea.top)  || (rcSource.bottom < rcMapArea.bottom))
+
+//==============================================================================================
+// GS_OGLMap::MoveRect():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Moves a map area (in map coordinates) as far as it can go without running into a
+//          tile with any of the specified flags. The area is moved horizontally and then
+//          vertically, so an area blocked along one axis still slides along the other.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the area was blocked, FALSE if it made the whole move. The contact holds
+//          the move that was made, the normals of the blocked axes and the last tile hit.
+//==============================================================================================
+
+BOOL GS_OGLMap::MoveRect(RECT* prcMapArea, int nMoveX, int nMoveY, BYTE ucFlags,
+                         GS_MapContact* pContact)
+{
+
+    if (NULL == prcMapArea)
     {
-        // Source not within area vertically.
         return FALSE;
     }
 
-    //   +------+
-    //   |      |
-    // +----------+
-    // |          |
-    // |          |
-    // |          |
-    // +----------+
-    //   |      |
-    //   +------+
+    GS_MapContact gsContactX, gsContactY;
 
-    if ((rcSource.right > rcMapArea.right) || (rcSource.left < rcMapArea.left))
+    // Move the area horizontally.
+    BOOL bIsHitX = this->SweepRect(*prcMapArea, nMoveX, 0, ucFlags, &gsContactX);
+
+    prcMapArea->left  += gsContactX.nMoveX;
+    prcMapArea->right += gsContactX.nMoveX;
+
+    // Move the area vertically from where it ended up.
+    BOOL bIsHitY = this->SweepRect(*prcMapArea, 0, nMoveY, ucFlags, &gsContactY);
+
+    prcMapArea->bottom += gsContactY.nMoveY;
+    prcMapArea->top    += gsContactY.nMoveY;
+
+    if (pContact != NULL)
     {
-        // Source not within area horizontally.
-        return FALSE;
+        pContact->fTime    = (gsContactX.fTime < gsContactY.fTime) ? gsContactX.fTime :
+                                                                   gsContactY.fTime;
+        pContact->nMoveX   = gsContactX.nMoveX;
+        pContact->nMoveY   = gsContactY.nMoveY;
+        pContact->nNormalX = gsContactX.nNormalX;
+        pContact->nNormalY = gsContactY.nNormalY;
+        pContact->nRow     = bIsHitY ? gsContactY.nRow : gsContactX.nRow;
+        pContact->nCol     = bIsHitY ? gsContactY.nCol : gsContactX.nCol;
     }
 
-    // Source within area.
-    return TRUE;
+    return (bIsHitX || bIsHitY);
 }
 
 
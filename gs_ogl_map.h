@@ -47,6 +47,7 @@
 #include "gs_error.h"
 #include "gs_object.h"
 #include "gs_file.h"
+#include "gs_file_map.h"
 #include "gs_math.h"
 #include "gs_ogl_color.h"
 #include "gs_ogl_sprite_ex.h"
@@ -56,15 +57,94 @@
 //==============================================================================================
 // Defines.
 // ---------------------------------------------------------------------------------------------
-#define MAX_MAP_COLS 128
-#define MAX_MAP_ROWS 128
+#define GS_MAP_CHUNK_SIZE 16    // Number of tiles along each side of a map chunk.
+#define GS_MAP_MAX_SIZE   65535 // Most rows or columns a map can have.
+
+#define GS_MAP_EMPTY_TILE  0xFFFF // Stored tile value of an empty tile (tile ID -1).
+#define GS_MAP_MAX_TILE_ID 0xFFFE // Largest tile ID that can be stored in a map.
+
+#define GS_MAP_FILE_MAGIC   "GSMP" // Identifies a binary map file.
+#define GS_MAP_FILE_VERSION 1      // The binary map file version written by SaveBinaryMap().
+
+#define GS_MAP_LAYER_TILES 1 // Layer containing the tile IDs of the map.
+
+#define GS_MAP_TILE_SOLID 0x01 // Tile flag for tiles that rectangles can't move into.
+//==============================================================================================
+
+
+//==============================================================================================
+// Binary map file structures. A binary map file starts with the header, followed by the layer
+// table, then for every layer a table of the chunks stored in it. Each stored chunk holds the
+// GS_MAP_CHUNK_SIZE * GS_MAP_CHUNK_SIZE 16-bit values of the chunk row by row. Chunks that are
+// not stored are empty. Offsets are in bytes from the start of the file and all values are
+// little-endian. Loaders skip layers of a type they don't know.
+// ---------------------------------------------------------------------------------------------
+#pragma pack(push, 1)
+typedef struct GS_MAP_FILE_HEADER
+{
+    char  szMagic[4];    // GS_MAP_FILE_MAGIC (not null terminated).
+    WORD  wVersion;      // GS_MAP_FILE_VERSION.
+    WORD  wChunkSize;    // GS_MAP_CHUNK_SIZE.
+    DWORD dwNumRows;     // Map height in tiles.
+    DWORD dwNumCols;     // Map width in tiles.
+    DWORD dwNumLayers;   // Number of entries in the layer table.
+    DWORD dwLayerOffset; // Offset of the layer table.
+} GS_MapFileHeader;
+
+typedef struct GS_MAP_FILE_LAYER
+{
+    DWORD dwType;        // What the layer contains (GS_MAP_LAYER_TILES).
+    DWORD dwNumChunks;   // Number of entries in the chunk table of the layer.
+    DWORD dwChunkOffset; // Offset of the chunk table of the layer.
+} GS_MapFileLayer;
+
+typedef struct GS_MAP_FILE_CHUNK
+{
+    DWORD dwChunkIndex; // Index of the chunk (chunk row * chunk columns + chunk column).
+    DWORD dwDataOffset; // Offset of the chunk values.
+} GS_MapFileChunk;
+#pragma pack(pop)
+//==============================================================================================
+
+
+//==============================================================================================
+// Map chunk structure, holds the tile IDs of a square block of tiles and caches its geometry in
+// a display list so the block can be drawn with a single call until one of its tiles changes.
+// The tiles are only allocated once a tile in the chunk is set, until then all tiles are empty.
+// The collision flags of the tiles are allocated along with them, so collision tests don't have
+// to look up the tile IDs and an empty chunk costs no memory for either.
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_MAP_CHUNK
+{
+    unsigned short* pTiles; // The tile IDs of the chunk, row by row (NULL if all empty).
+    BYTE*  pFlags;    // The collision flags of the tiles, row by row (NULL with pTiles).
+    GLuint gluList;   // The display list holding the chunk geometry (0 if not yet built).
+    int    nNumQuads; // The number of tiles in the chunk that are actually drawn.
+    BOOL   bIsDirty;  // Wether the display list has to be rebuilt before drawing.
+} GS_MapChunk;
 //==============================================================================================
 
 
 //==============================================================================================
-// Global variables for adjusting the scale factor of sprites allowing upscaling and downscaling
-// without affecting the game mechanics in any way. These variable will be declared and used in
-// the gs_ogl_sprite.cpp file
+// Map contact structure, describes where a rectangle moved by SweepRect() or MoveRect() hit a
+// tile. Coordinates are map coordinates, the normal points away from the tile that was hit.
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_MAP_CONTACT
+{
+    float fTime;    // How far along the move the tile was hit, 0.0 to 1.0 (1.0 if not hit).
+    int   nMoveX;   // The part of the move that can be made without entering the tile.
+    int   nMoveY;
+    int   nNormalX; // -1, 0 or 1 (both the x and y normal are set if a corner was hit exactly).
+    int   nNormalY;
+    int   nRow;     // The tile that was hit, or -1.
+    int   nCol;
+} GS_MapContact;
+//==============================================================================================
+
+
+//==============================================================================================
+// Global variables mapping the render resolution to window pixels, set by BeginRender2D() and
+// used to place scissor boxes. These variable will be declared in the gs_ogl_sprite.cpp file.
 // ---------------------------------------------------------------------------------------------
 extern float g_fRenderModX;
 extern float g_fRenderModY;
@@ -93,9 +173,8 @@ private:
 
     GS_OGLSpriteEx m_gsTileSprites; // Sprite object to hold tile images.
 
-    int m_nMap[MAX_MAP_ROWS][MAX_MAP_COLS]; // Map array to hold tile IDs.
-    int m_nNumCols;
-    int m_nNumRows;
+    int m_nNumCols; // Map width in tiles.
+    int m_nNumRows; // Map height in tiles.
 
     RECT m_rcClipBox; // Rectangle structure containing the viewport coordinates.
 
@@ -112,8 +191,39 @@ private:
     BOOL m_bWrapX;  // Wether scrolling should be wrapped horizontally.
     BOOL m_bWrapY;  // Wether scrolling should be wrapped vertically.
 
+    GS_MapChunk* m_pChunks; // The tiles and cached geometry of each map chunk.
+    int m_nNumChunkCols;    // Number of chunks needed to cover the map horizontally.
+    int m_nNumChunkRows;    // Number of chunks needed to cover the map vertically.
+
+    BYTE* m_pTileFlags;    // The collision flags of each tile ID.
+    int   m_nNumTileFlags; // Number of tile IDs that have flags.
+
+    GLfloat m_glfChunkScaleX; // The tile scale the chunks were built at.
+    GLfloat m_glfChunkScaleY;
+
+    // Scratch buffer for building chunks (four vertices per tile, each with u, v, x, y).
+    GLfloat m_fChunkVertices[GS_MAP_CHUNK_SIZE * GS_MAP_CHUNK_SIZE * 16];
+
     BOOL m_bIsReady; // Wether we are ready to render or not.
 
+    BOOL CreateChunks();
+    void DestroyChunks();
+    void BuildChunk(int nChunkRow, int nChunkCol);
+    void SetAllChunksDirty();
+
+    BOOL CreateChunkTiles(GS_MapChunk* pChunk);
+    void BuildFlags(GS_MapChunk* pChunk);
+
+    static BOOL  IsBigEndian();
+    static WORD  ConvertByteOrder(WORD wValue);
+    static DWORD ConvertByteOrder(DWORD dwValue);
+    static void  ConvertByteOrder(GS_MapFileHeader* pHeader);
+    static void  ConvertByteOrder(GS_MapFileLayer* pLayer);
+    static void  ConvertByteOrder(GS_MapFileChunk* pChunk);
+    static void  ConvertByteOrder(unsigned short* pTiles, int nNumTiles);
+    int  GetTileCol(long lCoordX);
+    int  GetTileRow(long lCoordY);
+
 protected:
 
     // ...
@@ -153,9 +263,16 @@ public:
 
     // Map methods.
 
+    BOOL CreateMap(int nNumRows, int nNumCols);
     BOOL LoadMap(const char* pszPathname, int nNumRows, int nNumCols);
     BOOL SaveMap(const char* pszPathname = NULL);
 
+    BOOL LoadBinaryMap(const char* pszPathname);
+    BOOL SaveBinaryMap(const char* pszPathname);
+
+    static BOOL ConvertMap(const char* pszTextPathname, int nNumRows, int nNumCols,
+                           const char* pszBinaryPathname);
+
     void SetMapX(int nDestX);
     void SetMapY(int nDestY);
     int  GetMapX();
@@ -190,6 +307,10 @@ public:
     void SetTilesPerLine(int nTilesPerLine);
     int  GetTilesPerLine();
 
+    void SetTileScroll(GLfloat glfScrollX, GLfloat glfScrollY);
+    void SetTileRotate(GLfloat glfRotateX, GLfloat glfRotateY, GLfloat glfRotateZ);
+    void SetTileScale(GLfloat glfScaleX, GLfloat glfScaleY);
+
     // Conversion methods.
 
     int MapToID(int nCoordX, int nCoordY);
@@ -220,6 +341,19 @@ public:
     BOOL IsOnArea(RECT rcSource, RECT rcMapArea);
     BOOL IsInArea(RECT rcSource, RECT rcMapArea);
 
+    // Collision flag methods.
+
+    void SetTileFlags(int nTileID, BYTE ucFlags);
+    BYTE GetTileFlags(int nTileID);
+
+    BYTE GetFlags(int nRow, int nCol);
+    BYTE GetFlags(RECT rcMapArea);
+
+    BOOL SweepRect(RECT rcMapArea, int nMoveX, int nMoveY, BYTE ucFlags,
+                   GS_MapContact* pContact);
+    BOOL MoveRect(RECT* prcMapArea, int nMoveX, int nMoveY, BYTE ucFlags,
+                  GS_MapContact* pContact = NULL);
+
     // Color methods.
 
     void GetModulateColor(GS_OGLColor* pgsColor);
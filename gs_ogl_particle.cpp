@@ -15,6 +15,7 @@
 // Include Game System (GS) header files.
 // ---------------------------------------------------------------------------------------------
 #include "gs_ogl_particle.h"
+#include "gs_ogl_state.h"
 //==============================================================================================
 
 
@@ -34,9 +35,18 @@
 GS_OGLParticle::GS_OGLParticle()
 {
 
+    m_pSharedTexture = NULL;
+    m_pSharedCache   = NULL;
     m_gluTexture = 0;
 
+    m_fTexLeft   = 0.0f;
+    m_fTexBottom = 0.0f;
+    m_fTexRight  = 1.0f;
+    m_fTexTop    = 1.0f;
+
     m_nNumParticles = 0;
+    m_nCapacity     = 0;
+    m_nNextEmit     = 0;
 
     m_bIsReady = FALSE;
 
@@ -46,21 +56,52 @@ GS_OGLParticle::GS_OGLParticle()
     m_gliWidth  = 0;
     m_gliHeight = 0;
 
-    for (int nLoop = 0; nLoop < MAX_PARTICLES; nLoop++)
-    {
-        m_gsParticles[nLoop].bIsActive = FALSE;
-        m_gsParticles[nLoop].gliDestX = 0;
-        m_gsParticles[nLoop].gliDestY = 0;
-        m_gsParticles[nLoop].glfRotateX = 0.0f;
-        m_gsParticles[nLoop].glfRotateY = 0.0f;
-        m_gsParticles[nLoop].glfRotateZ = 0.0f;
-        m_gsParticles[nLoop].glfScaleX = 1.0f;
-        m_gsParticles[nLoop].glfScaleY = 1.0f;
-        m_gsParticles[nLoop].glfR = 1.0f;
-        m_gsParticles[nLoop].glfG = 1.0f;
-        m_gsParticles[nLoop].glfB = 1.0f;
-        m_gsParticles[nLoop].glfA = 1.0f;
-    }
+    m_pAttributes = NULL;
+    m_pPosX       = NULL;
+    m_pPosY       = NULL;
+    m_pVelX       = NULL;
+    m_pVelY       = NULL;
+    m_pRotateX    = NULL;
+    m_pRotateY    = NULL;
+    m_pRotateZ    = NULL;
+    m_pSpin       = NULL;
+    m_pScaleX     = NULL;
+    m_pScaleY     = NULL;
+    m_pGrowth     = NULL;
+    m_pRed        = NULL;
+    m_pGreen      = NULL;
+    m_pBlue       = NULL;
+    m_pAlpha      = NULL;
+    m_pFade       = NULL;
+    m_pAge        = NULL;
+    m_pLifetime   = NULL;
+    m_pPrevPosX   = NULL;
+    m_pPrevPosY   = NULL;
+    m_pIsActive   = NULL;
+
+    m_fAccelX = 0.0f;
+    m_fAccelY = 0.0f;
+
+    m_pStreams[0]        = NULL;
+    m_pStreams[1]        = NULL;
+    m_nNumStreamQuads[0] = 0;
+    m_nNumStreamQuads[1] = 0;
+    m_nFrontStream       = 0;
+    m_bIsStreamReady     = FALSE;
+
+    m_pStreamDeltas[0]     = NULL;
+    m_pStreamDeltas[1]     = NULL;
+    m_fStreamInterpolation = 1.0f;
+    m_fInterpolation       = 1.0f;
+
+    m_pJobQuads       = NULL;
+    m_fUpdateTime     = 0.0f;
+    m_pJobSystem      = NULL;
+    m_gsUpdateCounter = 0;
+    m_bIsUpdating     = FALSE;
+
+    // Make room for the default number of particles.
+    this->SetCapacity(MAX_PARTICLES);
 }
 
 
@@ -79,6 +120,14 @@ GS_OGLParticle::~GS_OGLParticle()
 {
 
     this->Destroy();
+
+    GS_SAFE_DELETE_ARRAY(m_pAttributes);
+    GS_SAFE_DELETE_ARRAY(m_pIsActive);
+    GS_SAFE_DELETE_ARRAY(m_pStreams[0]);
+    GS_SAFE_DELETE_ARRAY(m_pStreams[1]);
+    GS_SAFE_DELETE_ARRAY(m_pStreamDeltas[0]);
+    GS_SAFE_DELETE_ARRAY(m_pStreamDeltas[1]);
+    GS_SAFE_DELETE_ARRAY(m_pJobQuads);
 }
 
 
@@ -113,60 +162,70 @@ BOOL GS_OGLParticle::Create(const char* pszPathname,int nNumParticles,BOOL bFilt
         this->Destroy();
     }
 
-    BOOL bResult;
+    // Use the image in the active texture atlas if it is in there, as long as the atlas pages
+    // are filtered the way we want (they are never mipmapped).
+    GS_AtlasRegion gsRegion;
 
-    // Should the texture we create be filtered or not?
-    if (bFiltered)
+    if ((GS_TextureAtlas::GetActive() != NULL) &&
+        GS_TextureAtlas::GetActive()->GetRegion(pszPathname, &gsRegion) &&
+        (!bMipmap) && ((!bFiltered) == (!gsRegion.bFiltered)))
     {
-        // Should texture be a mipmap?
-        if (bMipmap)
-        {
-            // Create a filtered mipmap particle texture from the specified file.
-            bResult = m_gsTexture.Create(pszPathname, GS_MIPMAP, GL_LINEAR, GL_LINEAR);
-        }
-        else
-        {
-            // Create a filtered particle texture from the specified file.
-            bResult = m_gsTexture.Create(pszPathname, GS_IMAGE2D, GL_LINEAR, GL_LINEAR);
-        }
+        return this->Create(&gsRegion, nNumParticles);
     }
-    else
+
+    GS_TextureType gsTextureType = bMipmap ? GS_MIPMAP : GS_IMAGE2D;
+    GLint glFilter = bFiltered ? GL_LINEAR : GL_NEAREST;
+
+    GS_OGLTexture* pTexture = &m_gsTexture;
+
+    // Share the texture with other objects created from the same file if there is a texture
+    // cache, otherwise create a texture of our own.
+    if (GS_TextureCache::GetActive() != NULL)
     {
-        // Should texture be a mipmap?
-        if (bMipmap)
-        {
-            // Create an unfiltered mipmap particle texture from the specified file.
-            bResult = m_gsTexture.Create(pszPathname, GS_MIPMAP, GL_NEAREST, GL_NEAREST);
-        }
-        else
-        {
-            // Create an unfiltered particle texture from the specified file.
-            bResult = m_gsTexture.Create(pszPathname, GS_IMAGE2D, GL_NEAREST, GL_NEAREST);
-        }
+        m_pSharedCache   = GS_TextureCache::GetActive();
+        m_pSharedTexture = m_pSharedCache->Acquire(pszPathname, gsTextureType, glFilter,
+                                                   glFilter);
+        pTexture = m_pSharedTexture;
+    }
+    else if (!m_gsTexture.Create(pszPathname, gsTextureType, glFilter, glFilter))
+    {
+        pTexture = NULL;
     }
 
     // Were we able to create the particle texture?
-    if (!bResult)
+    if (NULL == pTexture)
     {
-        GS_Error::Report("GS_OGL_PARTICLE.CPP", 138, "Failed to create particle texture!");
+        GS_Error::Report("GS_OGL_PARTICLE.CPP", 184, "Failed to create particle texture!");
         return FALSE;
     }
 
     // Remember the texture ID.
-    m_gluTexture = m_gsTexture.GetID();
+    m_gluTexture = pTexture->GetID();
 
     // Determine the actual dimensions of the particle.
-    m_gliWidth  = m_gsTexture.GetWidth();
-    m_gliHeight = m_gsTexture.GetHeight();
+    m_gliWidth  = pTexture->GetWidth();
+    m_gliHeight = pTexture->GetHeight();
 
     // Set how many particles are active initially.
-    if (nNumParticles > MAX_PARTICLES)
+    if (nNumParticles < 0)
     {
-        nNumParticles = MAX_PARTICLES;
+        nNumParticles = 0;
     }
-    else if (nNumParticles < 0)
+
+    // Make room for the particles if needed.
+    if ((nNumParticles > m_nCapacity) && (!this->SetCapacity(nNumParticles)))
     {
-        nNumParticles = 0;
+        m_gsTexture.Destroy();
+
+        if ((m_pSharedTexture != NULL) && (m_pSharedCache != NULL))
+        {
+            m_pSharedCache->Release(m_pSharedTexture);
+        }
+
+        m_pSharedTexture = NULL;
+        m_pSharedCache   = NULL;
+        m_gluTexture = 0;
+        return FALSE;
     }
 
     m_nNumParticles = nNumParticles;
@@ -174,7 +233,7 @@ BOOL GS_OGLParticle::Create(const char* pszPathname,int nNumParticles,BOOL bFilt
     // Activate the specified number of particles.
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].bIsActive = TRUE;
+        m_pIsActive[nLoop] = TRUE;
     }
 
     m_bIsReady = TRUE;
@@ -214,13 +273,16 @@ BOOL GS_OGLParticle::Create(GLuint glTexture, int nWidth, int nHeight, int nNumP
     m_gliHeight = nHeight;
 
     // Set how many particles are active initially.
-    if (nNumParticles > MAX_PARTICLES)
+    if (nNumParticles < 0)
     {
-        nNumParticles = MAX_PARTICLES;
+        nNumParticles = 0;
     }
-    else if (nNumParticles < 0)
+
+    // Make room for the particles if needed.
+    if ((nNumParticles > m_nCapacity) && (!this->SetCapacity(nNumParticles)))
     {
-        nNumParticles = 0;
+        m_gluTexture = 0;
+        return FALSE;
     }
 
     m_nNumParticles = nNumParticles;
@@ -228,7 +290,7 @@ BOOL GS_OGLParticle::Create(GLuint glTexture, int nWidth, int nHeight, int nNumP
     // Activate the specified number of particles.
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].bIsActive = TRUE;
+        m_pIsActive[nLoop] = TRUE;
     }
 
     m_bIsReady = TRUE;
@@ -237,6 +299,41 @@ BOOL GS_OGLParticle::Create(GLuint glTexture, int nWidth, int nHeight, int nNumP
 }
 
 
+//==============================================================================================
+// GS_OGLParticle::Create():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Creates the particles from an image packed into a texture atlas page, so they
+//          share the page texture with the other images in the atlas.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLParticle::Create(GS_AtlasRegion* pRegion, int nNumParticles)
+{
+
+    // Can't create particle if no valid region.
+    if ((!pRegion) || (pRegion->nPageWidth <= 0) || (pRegion->nPageHeight <= 0))
+    {
+        return FALSE;
+    }
+
+    // The particle is as large as the image, not the page.
+    if (!this->Create(pRegion->gluTexture, pRegion->ImageRect.right - pRegion->ImageRect.left,
+                      pRegion->ImageRect.top - pRegion->ImageRect.bottom, nNumParticles))
+    {
+        return FALSE;
+    }
+
+    // Only show the part of the page holding the image.
+    m_fTexLeft   = (GLfloat) pRegion->ImageRect.left   / pRegion->nPageWidth;
+    m_fTexBottom = (GLfloat) pRegion->ImageRect.bottom / pRegion->nPageHeight;
+    m_fTexRight  = (GLfloat) pRegion->ImageRect.right  / pRegion->nPageWidth;
+    m_fTexTop    = (GLfloat) pRegion->ImageRect.top    / pRegion->nPageHeight;
+
+    return TRUE;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -251,6 +348,9 @@ BOOL GS_OGLParticle::Create(GLuint glTexture, int nWidth, int nHeight, int nNumP
 void GS_OGLParticle::Destroy()
 {
 
+    // Finish any update still running before the particles go away.
+    this->EndUpdate();
+
     if (!m_bIsReady)
     {
         return;
@@ -258,8 +358,21 @@ void GS_OGLParticle::Destroy()
 
     m_gsTexture.Destroy();
 
+    // Let go of the shared texture through the cache it came from.
+    if ((m_pSharedTexture != NULL) && (m_pSharedCache != NULL))
+    {
+        m_pSharedCache->Release(m_pSharedTexture);
+    }
+
+    m_pSharedTexture = NULL;
+    m_pSharedCache   = NULL;
     m_gluTexture = 0;
 
+    m_fTexLeft   = 0.0f;
+    m_fTexBottom = 0.0f;
+    m_fTexRight  = 1.0f;
+    m_fTexTop    = 1.0f;
+
     m_nNumParticles = 0;
 
     m_bIsReady = FALSE;
@@ -270,21 +383,20 @@ void GS_OGLParticle::Destroy()
     m_gliWidth  = 0;
     m_gliHeight = 0;
 
-    for (int nLoop = 0; nLoop < MAX_PARTICLES; nLoop++)
-    {
-        m_gsParticles[nLoop].bIsActive = FALSE;
-        m_gsParticles[nLoop].gliDestX = 0;
-        m_gsParticles[nLoop].gliDestY = 0;
-        m_gsParticles[nLoop].glfRotateX = 0.0f;
-        m_gsParticles[nLoop].glfRotateY = 0.0f;
-        m_gsParticles[nLoop].glfRotateZ = 0.0f;
-        m_gsParticles[nLoop].glfScaleX = 1.0f;
-        m_gsParticles[nLoop].glfScaleY = 1.0f;
-        m_gsParticles[nLoop].glfR = 1.0f;
-        m_gsParticles[nLoop].glfG = 1.0f;
-        m_gsParticles[nLoop].glfB = 1.0f;
-        m_gsParticles[nLoop].glfA = 1.0f;
-    }
+    m_nNextEmit = 0;
+
+    m_fAccelX = 0.0f;
+    m_fAccelY = 0.0f;
+
+    m_nNumStreamQuads[0] = 0;
+    m_nNumStreamQuads[1] = 0;
+    m_bIsStreamReady     = FALSE;
+
+    m_fStreamInterpolation = 1.0f;
+    m_fInterpolation       = 1.0f;
+
+    // Reset all particles (the storage is kept for the next time the particles are created).
+    this->ResetParticles(0, m_nCapacity);
 }
 
 
@@ -321,10 +433,12 @@ BOOL GS_OGLParticle::BeginRender(HWND hWnd)
     GS_Platform::GetClientRect(hWnd, &ClientRect);
 #endif
 
+    GS_OGLState* pgsState = GS_OGLState::GetActive();
+
     // Disable depth testing if enabled.
-    if (glIsEnabled(GL_DEPTH_TEST) == GL_TRUE)
+    if (pgsState->IsEnabled(GL_DEPTH_TEST))
     {
-        glDisable(GL_DEPTH_TEST);
+        pgsState->Disable(GL_DEPTH_TEST);
         m_bDepthTestEnabled = TRUE;
     }
     else
@@ -333,9 +447,9 @@ BOOL GS_OGLParticle::BeginRender(HWND hWnd)
     }
 
     // Disable lighting if enabled.
-    if (glIsEnabled(GL_LIGHTING) == GL_TRUE)
+    if (pgsState->IsEnabled(GL_LIGHTING))
     {
-        glDisable(GL_LIGHTING);
+        pgsState->Disable(GL_LIGHTING);
         m_bLightingEnabled = TRUE;
     }
     else
@@ -382,6 +496,11 @@ BOOL GS_OGLParticle::BeginRender(HWND hWnd)
 void GS_OGLParticle::EndRender()
 {
 
+    GS_OGLState* pgsState = GS_OGLState::GetActive();
+
+    // Leave no texture selected and the color white for code drawing without the renderers.
+    pgsState->Reset();
+
     glMatrixMode(GL_PROJECTION); // Select the projection matrix.
     glPopMatrix();               // Restore the old projection matrix.
     glMatrixMode(GL_MODELVIEW);  // Select the modelview matrix.
@@ -390,13 +509,13 @@ void GS_OGLParticle::EndRender()
     // Was depth testing enabled?
     if (m_bDepthTestEnabled == TRUE)
     {
-        glEnable(GL_DEPTH_TEST);
+        pgsState->Enable(GL_DEPTH_TEST);
     }
 
     // Was lighting enabled?
     if (m_bLightingEnabled == TRUE)
     {
-        glEnable(GL_LIGHTING);
+        pgsState->Enable(GL_LIGHTING);
     }
 }
 
@@ -421,109 +540,105 @@ BOOL GS_OGLParticle::Render(HWND hWnd)
         return FALSE;
     }
 
+    GS_PROFILE_SCOPE("GS_OGLParticle::Render");
+
+    // Particles are drawn immediately, so draw any sprites queued before them first.
+    GS_SpriteBatch::FlushActive();
+
     // Setup display for 2D rendering.
     if (hWnd != NULL)
     {
         this->BeginRender(hWnd);
     }
 
-    GLint gliSrcFactor, gliDstFactor;
+    GS_OGLState* pgsState = GS_OGLState::GetActive();
 
-    GLboolean glbIsBlendingEnabled = glIsEnabled(GL_BLEND);
+    GLenum glSourceFactor, glDestFactor;
 
-    // Is blending enabled?
-    if (glbIsBlendingEnabled)
-    {
-        // Save blending parameters.
-        glGetIntegerv(GL_BLEND_SRC, &gliSrcFactor);
-        glGetIntegerv(GL_BLEND_DST, &gliDstFactor);
-        // Disable blending.
-        glDisable(GL_BLEND);
-    }
+    // Save blending parameters.
+    BOOL bIsBlendingEnabled = pgsState->IsEnabled(GL_BLEND);
+    pgsState->GetBlendFunc(&glSourceFactor, &glDestFactor);
 
     // Setup blending for particles.
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-    glEnable(GL_BLEND);
+    pgsState->BlendFunc(GL_SRC_ALPHA, GL_ONE);
+    pgsState->Enable(GL_BLEND);
 
-    // For each particle.
-    for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
+    GS_BatchVertex* pVertices = m_pStreams[m_nFrontStream];
+    GLfloat* pDeltas = m_pStreamDeltas[m_nFrontStream];
+    int nNumQuads;
+
+    // Draw the vertex stream of the last update, or the current particles if they have not
+    // been updated since the last time they were rendered. While an update is running the
+    // particles are being written to by the update jobs, so only the stream can be drawn.
+    if (m_bIsStreamReady || m_bIsUpdating)
     {
+        nNumQuads = m_nNumStreamQuads[m_nFrontStream];
+    }
+    else
+    {
+        nNumQuads = this->BuildVertices(0, m_nNumParticles, pVertices, pDeltas);
+        m_nNumStreamQuads[m_nFrontStream] = nNumQuads;
+        m_fStreamInterpolation = 1.0f;
+    }
 
-        // Should the specified particle be rendered?
-        if (m_gsParticles[nLoop].bIsActive)
+    if (!m_bIsUpdating)
+    {
+        m_bIsStreamReady = FALSE;
+    }
+
+    // Move the quads from where the stream has them to between the positions saved by
+    // SaveTransform() and the current positions, as set by SetInterpolation().
+    GLfloat fShift = m_fInterpolation - m_fStreamInterpolation;
+
+    if (fShift != 0.0f)
+    {
+        for (int nQuad = 0; nQuad < nNumQuads; nQuad++)
         {
-            // Reset the modelview matrix.
-            glLoadIdentity();
-
-            // Select the particle texture.
-            glBindTexture(GL_TEXTURE_2D, m_gluTexture);
-
-            // Draw particle in a different hue or transparency depending on the alpha factor.
-            glColor4f(m_gsParticles[nLoop].glfR, m_gsParticles[nLoop].glfG,
-                      m_gsParticles[nLoop].glfB, m_gsParticles[nLoop].glfA);
-
-            // Determine the scaled particle dimensions and divide by two to take into account
-            // that the particle is drawn from the center outwards.
-            float fHalfWidth  = ((float)m_gliWidth  / 2) * m_gsParticles[nLoop].glfScaleX * g_fScaleFactorX;
-            float fHalfHeight = ((float)m_gliHeight / 2) * m_gsParticles[nLoop].glfScaleY * g_fScaleFactorY;
-
-            // Position the particle (the coordinates (0,0) is the bottom left of the screen). Note
-            // that because the particle is actually positioned from the center, some adjustments
-            // have to be made for the particle to be postioned by the bottom left corner.
-            glTranslated
-            (
-                (m_gsParticles[nLoop].gliDestX * g_fScaleFactorX) + fHalfWidth + g_fRenderModX,
-                (m_gsParticles[nLoop].gliDestY * g_fScaleFactorX) + fHalfHeight + g_fRenderModY,
-                0
-            );
-
-            // Rotate the particle on the X, Y and Z-axis.
-            glRotatef(m_gsParticles[nLoop].glfRotateX, 1.0f, 0.0f, 0.0f);
-            glRotatef(m_gsParticles[nLoop].glfRotateY, 0.0f, 1.0f, 0.0f);
-            glRotatef(m_gsParticles[nLoop].glfRotateZ, 0.0f, 0.0f, 1.0f);
-
-            // Start drawing a quad. In order for the particle to be rotated correctly, the
-            // particle has to/ be drawn from a center point outwards. If the center of the
-            // particle is (0, 0) then the bottom left corner of the particle is (0 - (particle
-            // width / 2), 0 - (particle height/2)), the bottom right corner of the particle is
-            // (0 + (particle width / 2), 0 - (particle height/2)), the top right corner of the
-            // particle is (0 + (particle width / 2), 0 + (particle height/2)) and the top left
-            // corner of the particle is (0 - (particle width / 2), 0 + (particle height/2)).
-            glBegin(GL_QUADS);
-            // Bottom left texture coordinate and vertex.
-            glTexCoord2f(0.0f, 0.0f);
-            glVertex2f(-fHalfWidth, -fHalfHeight);
-            // Bottom right texture coordinate and vertex.
-            glTexCoord2f(1.0f, 0.0f);
-            glVertex2f( fHalfWidth, -fHalfHeight);
-            // Top right texture coordinate and vertex.
-            glTexCoord2f(1.0f, 1.0f);
-            glVertex2f( fHalfWidth,  fHalfHeight);
-            // Top left texture coordinate and vertex.
-            glTexCoord2f(0.0f, 1.0f);
-            glVertex2f(-fHalfWidth,  fHalfHeight);
-            glEnd();
-
-            // Unselect the particle texture.
-            glBindTexture(GL_TEXTURE_2D, 0);  // Use 0 instead of NULL
+            GLfloat fShiftX = fShift * pDeltas[nQuad * 2];
+            GLfloat fShiftY = fShift * pDeltas[nQuad * 2 + 1];
+
+            for (int nCorner = 0; nCorner < 4; nCorner++)
+            {
+                pVertices[nQuad * 4 + nCorner].fX += fShiftX;
+                pVertices[nQuad * 4 + nCorner].fY += fShiftY;
+            }
         }
+
+        m_fStreamInterpolation = m_fInterpolation;
     }
 
+    // Draw all active particles with a single call.
+    if (nNumQuads > 0)
+    {
+        // Reset the modelview matrix.
+        glLoadIdentity();
+
+        // Select the particle texture.
+        pgsState->BindTexture(m_gluTexture);
 
-    // Reset the color for other textures to white.
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glEnableClientState(GL_VERTEX_ARRAY);
 
-    // Disable particle blending.
-    glDisable(GL_BLEND);
+        glTexCoordPointer(2, GL_FLOAT, sizeof(GS_BatchVertex), &pVertices[0].fTexU);
+        glColorPointer(4, GL_FLOAT, sizeof(GS_BatchVertex), &pVertices[0].fRed);
+        glVertexPointer(3, GL_FLOAT, sizeof(GS_BatchVertex), &pVertices[0].fX);
 
-    // Was blending enabled originally?
-    if (glbIsBlendingEnabled)
-    {
-        // Restore and enable original blending;
-        glBlendFunc(gliSrcFactor, gliDstFactor);
-        glEnable(GL_BLEND);
+        glDrawArrays(GL_QUADS, 0, nNumQuads * 4);
+        GS_Profiler::CountDrawCall(nNumQuads * 4);
+
+        glDisableClientState(GL_VERTEX_ARRAY);
+        glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+
+        // Drawing from a color array leaves the current color undefined.
+        pgsState->InvalidateColor();
     }
 
+    // Restore original blending.
+    pgsState->BlendFunc(glSourceFactor, glDestFactor);
+    pgsState->SetEnabled(GL_BLEND, bIsBlendingEnabled);
+
     // Reset display after 2D rendering.
     if (hWnd != NULL)
     {
@@ -538,223 +653,396 @@ BOOL GS_OGLParticle::Render(HWND hWnd)
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
-// Status Methods. /////////////////////////////////////////////////////////////////////////////
+// Simulation Methods. /////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
 //==============================================================================================
-// GS_OGLParticle::IsReady():
+// GS_OGLParticle::Update():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Moves all particles forward in time by the specified number of seconds, applying
+//          acceleration, velocity, spin, growth and fade, and deactivates particles that have
+//          lived out their lifetime. The updated particles are also written to the vertex
+//          stream drawn by the next Render(), changes made to the particles after the update
+//          only show once they are rendered without being updated first.
+//
+//          With a job system the particles are split into ranges of GS_PARTICLE_JOB_SIZE
+//          particles that are updated on the worker threads. The ranges don't depend on the
+//          number of threads and every range only writes its own particles, so the results
+//          are the same with or without a job system.
 // ---------------------------------------------------------------------------------------------
-// Returns: TRUE if particles have been created, FALSE if not.
+// Returns: Nothing.
 //==============================================================================================
 
-BOOL GS_OGLParticle::IsReady()
+void GS_OGLParticle::Update(GLfloat fDeltaTime, GS_JobSystem* pJobSystem)
 {
 
-    return m_bIsReady;
+    GS_PROFILE_SCOPE("GS_OGLParticle::Update");
+
+    this->BeginUpdate(fDeltaTime, pJobSystem);
+    this->EndUpdate();
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
-// GS_OGLParticle::IsActive():
+// GS_OGLParticle::BeginUpdate():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Starts updating the particles (see Update()) on the job system without waiting for
+//          the update to finish, so other work can be done (for example rendering the stream
+//          of the previous update) in the meantime. The particles must not be changed or read
+//          until EndUpdate() has been called.
 // ---------------------------------------------------------------------------------------------
-// Returns: TRUE if particle is active, FALSE if not.
+// Returns: Nothing.
 //==============================================================================================
 
-BOOL GS_OGLParticle::IsActive(int nParticleIndex)
+void GS_OGLParticle::BeginUpdate(GLfloat fDeltaTime, GS_JobSystem* pJobSystem)
 {
 
-    if (nParticleIndex >= m_nNumParticles)
+    // Finish the previous update first.
+    this->EndUpdate();
+
+    m_fUpdateTime = (fDeltaTime > 0.0f) ? fDeltaTime : 0.0f;
+    m_pJobSystem  = pJobSystem;
+    m_bIsUpdating = TRUE;
+
+    if (pJobSystem != NULL)
     {
-        nParticleIndex = m_nNumParticles - 1;
+        pJobSystem->Dispatch(GS_OGLParticle::UpdateJob, this, m_nNumParticles,
+                             GS_PARTICLE_JOB_SIZE, &m_gsUpdateCounter);
     }
-    else if (nParticleIndex < 0)
+    else
     {
-        nParticleIndex = 0;
+        // Update the same ranges as the job system would, one after the other.
+        for (int nFirst = 0; nFirst < m_nNumParticles; nFirst += GS_PARTICLE_JOB_SIZE)
+        {
+            int nLast = nFirst + GS_PARTICLE_JOB_SIZE;
+            GS_OGLParticle::UpdateJob(this, nFirst,
+                                      (nLast < m_nNumParticles) ? nLast : m_nNumParticles);
+        }
     }
-
-    return m_gsParticles[nParticleIndex].bIsActive;
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
-// GS_OGLParticle::Activate():
+// GS_OGLParticle::EndUpdate():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Waits for the update started by BeginUpdate() to finish and makes the vertex
+//          stream it wrote the one drawn by Render().
 // ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
-void GS_OGLParticle::Activate(int nParticleIndex, BOOL bActivate)
+void GS_OGLParticle::EndUpdate()
 {
 
-    if (nParticleIndex >= m_nNumParticles)
+    if (!m_bIsUpdating)
     {
-        nParticleIndex = m_nNumParticles - 1;
+        return;
     }
-    else if (nParticleIndex < 0)
+
+    if (m_pJobSystem != NULL)
     {
-        nParticleIndex = 0;
+        m_pJobSystem->Wait(&m_gsUpdateCounter);
     }
 
-    m_gsParticles[nParticleIndex].bIsActive = bActivate;
-}
+    // Every job wrote its quads to the start of its own part of the back stream, move them
+    // together so that all of them can be drawn with a single call.
+    GS_BatchVertex* pVertices = m_pStreams[1 - m_nFrontStream];
+    GLfloat* pDeltas = m_pStreamDeltas[1 - m_nFrontStream];
+    int nNumQuads = 0;
 
+    for (int nFirst = 0; nFirst < m_nNumParticles; nFirst += GS_PARTICLE_JOB_SIZE)
+    {
+        int nJobQuads = m_pJobQuads[nFirst / GS_PARTICLE_JOB_SIZE];
 
-void GS_OGLParticle::Activate(BOOL bActivate)
-{
+        if ((nJobQuads > 0) && (nNumQuads != nFirst))
+        {
+            memmove(pVertices + (nNumQuads * 4), pVertices + (nFirst * 4),
+                    nJobQuads * 4 * sizeof(GS_BatchVertex));
+            memmove(pDeltas + (nNumQuads * 2), pDeltas + (nFirst * 2),
+                    nJobQuads * 2 * sizeof(GLfloat));
+        }
 
-    for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
-    {
-        m_gsParticles[nLoop].bIsActive = bActivate;
+        nNumQuads += nJobQuads;
     }
-}
 
+    // Swap the streams.
+    m_nFrontStream = 1 - m_nFrontStream;
+    m_nNumStreamQuads[m_nFrontStream] = nNumQuads;
+    m_bIsStreamReady = TRUE;
+    m_fStreamInterpolation = 1.0f;
 
-////////////////////////////////////////////////////////////////////////////////////////////////
+    m_pJobSystem  = NULL;
+    m_bIsUpdating = FALSE;
+}
 
 
-////////////////////////////////////////////////////////////////////////////////////////////////
-// Get/Set Methods. ////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
 //==============================================================================================
-// GS_OGLParticle::GetNumParticles():
+// GS_OGLParticle::UpdateJob():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Updates the particles from nFirst up to (but not including) nLast and writes them
+//          to their part of the back stream, called from the worker threads of the job system.
 // ---------------------------------------------------------------------------------------------
-// Returns: An integer value indicating the number of particles.
+// Returns: Nothing.
 //==============================================================================================
 
-int GS_OGLParticle::GetNumParticles()
+void GS_OGLParticle::UpdateJob(void* pData, int nFirst, int nLast)
 {
 
-    return m_nNumParticles;
+    GS_OGLParticle* pParticle = (GS_OGLParticle*) pData;
+
+    pParticle->UpdateRange(nFirst, nLast, pParticle->m_fUpdateTime);
+
+    int nBack = 1 - pParticle->m_nFrontStream;
+
+    pParticle->m_pJobQuads[nFirst / GS_PARTICLE_JOB_SIZE] =
+        pParticle->BuildVertices(nFirst, nLast, pParticle->m_pStreams[nBack] + (nFirst * 4),
+                                 pParticle->m_pStreamDeltas[nBack] + (nFirst * 2));
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
-// GS_OGLParticle::SetNumParticles():
+// GS_OGLParticle::UpdateRange():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Moves the particles from nFirst up to (but not including) nLast forward in time.
+//          Each attribute is integrated in its own loop over a plain float array so the
+//          compiler can vectorize the loops.
 // ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
-void GS_OGLParticle::SetNumParticles(int nNumParticles)
+void GS_OGLParticle::UpdateRange(int nFirst, int nLast, GLfloat fDeltaTime)
 {
 
-    // Is number of particles within bounds?
-    if (nNumParticles > MAX_PARTICLES)
+    // Inactive particles are integrated as well, that is cheaper than testing each of them.
+    GLfloat fAddVelX = m_fAccelX * fDeltaTime;
+    GLfloat fAddVelY = m_fAccelY * fDeltaTime;
+
+    if ((fAddVelX != 0.0f) || (fAddVelY != 0.0f))
     {
-        nNumParticles = MAX_PARTICLES;
+        for (int nLoop = nFirst; nLoop < nLast; nLoop++)
+        {
+            m_pVelX[nLoop] += fAddVelX;
+            m_pVelY[nLoop] += fAddVelY;
+        }
     }
-    else if (nNumParticles < 0)
+
+    for (int nLoop = nFirst; nLoop < nLast; nLoop++)
     {
-        nNumParticles = 0;
+        m_pPosX[nLoop] += m_pVelX[nLoop] * fDeltaTime;
+        m_pPosY[nLoop] += m_pVelY[nLoop] * fDeltaTime;
     }
 
-    // Set the number of particles.
-    m_nNumParticles = nNumParticles;
-}
-
-
-//==============================================================================================
-// GS_OGLParticle::GetDestX():
-// ---------------------------------------------------------------------------------------------
-// Purpose: ...
-// ---------------------------------------------------------------------------------------------
-// Returns: An integer value indicating the horizontal position of the particle.
-//==============================================================================================
+    for (int nLoop = nFirst; nLoop < nLast; nLoop++)
+    {
+        m_pRotateZ[nLoop] += m_pSpin[nLoop] * fDeltaTime;
+    }
 
-GLint GS_OGLParticle::GetDestX(int nParticleIndex)
-{
+    for (int nLoop = nFirst; nLoop < nLast; nLoop++)
+    {
+        GLfloat fScaleX = m_pScaleX[nLoop] + (m_pGrowth[nLoop] * fDeltaTime);
+        GLfloat fScaleY = m_pScaleY[nLoop] + (m_pGrowth[nLoop] * fDeltaTime);
+        m_pScaleX[nLoop] = (fScaleX > 0.0f) ? fScaleX : 0.0f;
+        m_pScaleY[nLoop] = (fScaleY > 0.0f) ? fScaleY : 0.0f;
+    }
 
-    if (nParticleIndex >= m_nNumParticles)
+    for (int nLoop = nFirst; nLoop < nLast; nLoop++)
     {
-        nParticleIndex = m_nNumParticles - 1;
+        GLfloat fAlpha = m_pAlpha[nLoop] + (m_pFade[nLoop] * fDeltaTime);
+        fAlpha = (fAlpha > 0.0f) ? fAlpha : 0.0f;
+        m_pAlpha[nLoop] = (fAlpha < 1.0f) ? fAlpha : 1.0f;
     }
-    else if (nParticleIndex < 0)
+
+    for (int nLoop = nFirst; nLoop < nLast; nLoop++)
     {
-        nParticleIndex = 0;
+        m_pAge[nLoop] += fDeltaTime;
     }
 
-    return m_gsParticles[nParticleIndex].gliDestX;
+    // Deactivate particles that have lived out their lifetime.
+    for (int nLoop = nFirst; nLoop < nLast; nLoop++)
+    {
+        if ((m_pLifetime[nLoop] > 0.0f) && (m_pAge[nLoop] >= m_pLifetime[nLoop]))
+        {
+            m_pIsActive[nLoop] = FALSE;
+        }
+    }
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
-// GS_OGLParticle::SetDestX():
+// GS_OGLParticle::BuildVertices():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Transforms the corners of the active particles from nFirst up to (but not
+//          including) nLast into quads in the specified vertex array, one after the other,
+//          and how far each of them moved since SaveTransform() into the delta array. Only
+//          reads the particles, so different ranges can be built at the same time.
 // ---------------------------------------------------------------------------------------------
-// Returns: Nothing.
+// Returns: The number of quads written.
 //==============================================================================================
 
-void  GS_OGLParticle::SetDestX(int nParticleIndex, GLint gliDestX)
+int GS_OGLParticle::BuildVertices(int nFirst, int nLast, GS_BatchVertex* pVertices,
+                                  GLfloat* pDeltas)
 {
 
-    if (nParticleIndex >= m_nNumParticles)
-    {
-        nParticleIndex = m_nNumParticles - 1;
-    }
-    else if (nParticleIndex < 0)
-    {
-        nParticleIndex = 0;
-    }
+    // The corners of every particle in the same order as GS_OGLSprite::Render() draws them.
+    static const GLfloat fCornerX[4] = { -1.0f,  1.0f, 1.0f, -1.0f };
+    static const GLfloat fCornerY[4] = { -1.0f, -1.0f, 1.0f,  1.0f };
 
-    m_gsParticles[nParticleIndex].gliDestX = gliDestX;
-}
+    // The texture coordinates of the corners (only part of the texture if it is an atlas page).
+    const GLfloat fTexU[4] = { m_fTexLeft,   m_fTexRight,  m_fTexRight, m_fTexLeft };
+    const GLfloat fTexV[4] = { m_fTexBottom, m_fTexBottom, m_fTexTop,   m_fTexTop  };
 
+    // Half the particle dimensions at a scale of one, since particles are drawn from the center
+    // outwards.
+    GLfloat fHalfWidth  = (GLfloat) m_gliWidth  / 2;
+    GLfloat fHalfHeight = (GLfloat) m_gliHeight / 2;
 
-void  GS_OGLParticle::SetDestX(GLint gliDestX)
-{
+    GS_BatchVertex* pVertex = pVertices;
+    int nNumQuads = 0;
 
-    for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
+    // Transform the corners of every active particle into the vertex array.
+    for (int nLoop = nFirst; nLoop < nLast; nLoop++)
     {
-        m_gsParticles[nLoop].gliDestX = gliDestX;
+        // Should the specified particle be rendered?
+        if (!m_pIsActive[nLoop])
+        {
+            continue;
+        }
+
+        GLfloat fScaledHalfWidth  = fHalfWidth  * m_pScaleX[nLoop];
+        GLfloat fScaledHalfHeight = fHalfHeight * m_pScaleY[nLoop];
+
+        // Position the particle by its center (the coordinates (0,0) is the bottom left of the
+        // screen and the particle is positioned by its bottom left corner).
+        GLfloat fCenterX = m_pPosX[nLoop] + fScaledHalfWidth;
+        GLfloat fCenterY = m_pPosY[nLoop] + fScaledHalfHeight;
+
+        // The first two columns of the rotation matrix (X * Y * Z).
+        GLfloat fXx = fScaledHalfWidth, fXy = 0.0f, fXz = 0.0f;
+        GLfloat fYx = 0.0f, fYy = fScaledHalfHeight, fYz = 0.0f;
+
+        // Only bother with the rotation matrix if the particle is actually rotated.
+        if ((m_pRotateX[nLoop] != 0.0f) || (m_pRotateY[nLoop] != 0.0f) ||
+            (m_pRotateZ[nLoop] != 0.0f))
+        {
+            GLfloat fSinX = GS_Sin(m_pRotateX[nLoop]), fCosX = GS_Cos(m_pRotateX[nLoop]);
+            GLfloat fSinY = GS_Sin(m_pRotateY[nLoop]), fCosY = GS_Cos(m_pRotateY[nLoop]);
+            GLfloat fSinZ = GS_Sin(m_pRotateZ[nLoop]), fCosZ = GS_Cos(m_pRotateZ[nLoop]);
+
+            fXx = fScaledHalfWidth * (fCosZ * fCosY);
+            fXy = fScaledHalfWidth * (fSinZ * fCosX + fCosZ * fSinY * fSinX);
+            fXz = fScaledHalfWidth * (fSinZ * fSinX - fCosZ * fSinY * fCosX);
+
+            fYx = fScaledHalfHeight * (-fSinZ * fCosY);
+            fYy = fScaledHalfHeight * ( fCosZ * fCosX - fSinZ * fSinY * fSinX);
+            fYz = fScaledHalfHeight * ( fCosZ * fSinX + fSinZ * fSinY * fCosX);
+        }
+
+        for (int nCorner = 0; nCorner < 4; nCorner++)
+        {
+            pVertex->fTexU  = fTexU[nCorner];
+            pVertex->fTexV  = fTexV[nCorner];
+            pVertex->fRed   = m_pRed[nLoop];
+            pVertex->fGreen = m_pGreen[nLoop];
+            pVertex->fBlue  = m_pBlue[nLoop];
+            pVertex->fAlpha = m_pAlpha[nLoop];
+            pVertex->fX = fCenterX + (fXx * fCornerX[nCorner]) + (fYx * fCornerY[nCorner]);
+            pVertex->fY = fCenterY + (fXy * fCornerX[nCorner]) + (fYy * fCornerY[nCorner]);
+            pVertex->fZ = (fXz * fCornerX[nCorner]) + (fYz * fCornerY[nCorner]);
+            pVertex++;
+        }
+
+        pDeltas[nNumQuads * 2]     = m_pPosX[nLoop] - m_pPrevPosX[nLoop];
+        pDeltas[nNumQuads * 2 + 1] = m_pPosY[nLoop] - m_pPrevPosY[nLoop];
+
+        nNumQuads++;
     }
+
+    return nNumQuads;
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
-// GS_OGLParticle::GetDestY():
+// GS_OGLParticle::Emit():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Activates an inactive particle at the specified position with the specified
+//          velocity and lifetime (0.0f means the particle lives until it is deactivated). All
+//          other attributes of the particle are reset to their defaults.
 // ---------------------------------------------------------------------------------------------
-// Returns: An integer value indicating the vertical position of the particle.
+// Returns: The index of the emitted particle, or -1 if all particles are active.
 //==============================================================================================
 
-GLint GS_OGLParticle::GetDestY(int nParticleIndex)
+int GS_OGLParticle::Emit(GLfloat fPosX, GLfloat fPosY, GLfloat fVelX, GLfloat fVelY,
+                         GLfloat fLifetime)
 {
 
-    if (nParticleIndex >= m_nNumParticles)
-    {
-        nParticleIndex = m_nNumParticles - 1;
-    }
-    else if (nParticleIndex < 0)
+    // Look for an inactive particle, starting after the last particle emitted.
+    for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        nParticleIndex = 0;
+        int nIndex = (m_nNextEmit + nLoop) % m_nNumParticles;
+
+        if (!m_pIsActive[nIndex])
+        {
+            this->ResetParticles(nIndex, nIndex + 1);
+
+            m_pPosX[nIndex]     = fPosX;
+            m_pPosY[nIndex]     = fPosY;
+            m_pPrevPosX[nIndex] = fPosX;
+            m_pPrevPosY[nIndex] = fPosY;
+            m_pVelX[nIndex]     = fVelX;
+            m_pVelY[nIndex]     = fVelY;
+            m_pLifetime[nIndex] = fLifetime;
+            m_pIsActive[nIndex] = TRUE;
+
+            m_nNextEmit = (nIndex + 1) % m_nNumParticles;
+
+            return nIndex;
+        }
     }
 
-    return m_gsParticles[nParticleIndex].gliDestY;
+    return -1;
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Interpolation Methods. //////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
-// GS_OGLParticle::SetDestY():
+// GS_OGLParticle::SaveTransform():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Saves the position of the specified particle, or of all particles, as its previous
+//          position. Call it at the start of each fixed simulation step, before updating the
+//          particles, and again for a particle moved somewhere it shouldn't appear to travel
+//          to. Render() then draws the particles between their previous and current
+//          positions, as set by SetInterpolation().
 // ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
-void  GS_OGLParticle::SetDestY(int nParticleIndex, GLint gliDestY)
+void GS_OGLParticle::SaveTransform(int nParticleIndex)
 {
 
     if (nParticleIndex >= m_nNumParticles)
@@ -766,28 +1054,673 @@ void  GS_OGLParticle::SetDestY(int nParticleIndex, GLint gliDestY)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].gliDestY = gliDestY;
+    m_pPrevPosX[nParticleIndex] = m_pPosX[nParticleIndex];
+    m_pPrevPosY[nParticleIndex] = m_pPosY[nParticleIndex];
 }
 
-void  GS_OGLParticle::SetDestY(GLint gliDestY)
+
+void GS_OGLParticle::SaveTransform()
+{
+
+    // Finish any update still running before the positions are read.
+    this->EndUpdate();
+
+    memcpy(m_pPrevPosX, m_pPosX, m_nNumParticles * sizeof(GLfloat));
+    memcpy(m_pPrevPosY, m_pPosY, m_nNumParticles * sizeof(GLfloat));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLParticle::SetInterpolation():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets how far between the previous positions (0.0) and the current positions (1.0)
+//          Render() draws the particles, normally GS_Application::GetInterpolation().
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLParticle::SetInterpolation(GLfloat fInterpolation)
+{
+
+    if (fInterpolation < 0.0f)
+    {
+        fInterpolation = 0.0f;
+    }
+    else if (fInterpolation > 1.0f)
+    {
+        fInterpolation = 1.0f;
+    }
+
+    m_fInterpolation = fInterpolation;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Status Methods. /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLParticle::IsReady():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if particles have been created, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLParticle::IsReady()
+{
+
+    return m_bIsReady;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLParticle::GetCapacity():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of particles there is room for.
+//==============================================================================================
+
+int GS_OGLParticle::GetCapacity()
+{
+
+    return m_nCapacity;
+}
+
+
+//==============================================================================================
+// GS_OGLParticle::SetCapacity():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets how many particles there is room for, keeping the attributes of the
+//          particles that still fit. The number of particles is reduced if it doesn't fit.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLParticle::SetCapacity(int nCapacity)
+{
+
+    if (nCapacity < 1)
+    {
+        return FALSE;
+    }
+
+    if (nCapacity == m_nCapacity)
+    {
+        return TRUE;
+    }
+
+    // Finish any update still running before the particles are moved.
+    this->EndUpdate();
+
+    int nNumJobs = (nCapacity + GS_PARTICLE_JOB_SIZE - 1) / GS_PARTICLE_JOB_SIZE;
+
+    GLfloat* pAttributes = new GLfloat[nCapacity * GS_PARTICLE_NUM_ATTRIBUTES];
+    BYTE* pIsActive = new BYTE[nCapacity];
+    GS_BatchVertex* pFrontStream = new GS_BatchVertex[nCapacity * 4];
+    GS_BatchVertex* pBackStream = new GS_BatchVertex[nCapacity * 4];
+    GLfloat* pFrontDeltas = new GLfloat[nCapacity * 2];
+    GLfloat* pBackDeltas = new GLfloat[nCapacity * 2];
+    int* pJobQuads = new int[nNumJobs];
+
+    if ((NULL == pAttributes) || (NULL == pIsActive) || (NULL == pFrontStream) ||
+        (NULL == pBackStream) || (NULL == pFrontDeltas) || (NULL == pBackDeltas) ||
+        (NULL == pJobQuads))
+    {
+        GS_Error::Report("GS_OGL_PARTICLE.CPP", 995, "Failed to allocate particles!");
+        GS_SAFE_DELETE_ARRAY(pAttributes);
+        GS_SAFE_DELETE_ARRAY(pIsActive);
+        GS_SAFE_DELETE_ARRAY(pFrontStream);
+        GS_SAFE_DELETE_ARRAY(pBackStream);
+        GS_SAFE_DELETE_ARRAY(pFrontDeltas);
+        GS_SAFE_DELETE_ARRAY(pBackDeltas);
+        GS_SAFE_DELETE_ARRAY(pJobQuads);
+        return FALSE;
+    }
+
+    // Copy the particles that still fit.
+    int nNumKept = (m_nCapacity < nCapacity) ? m_nCapacity : nCapacity;
+
+    if (nNumKept > 0)
+    {
+        for (int nAttribute = 0; nAttribute < GS_PARTICLE_NUM_ATTRIBUTES; nAttribute++)
+        {
+            memcpy(pAttributes + (nAttribute * nCapacity),
+                   m_pAttributes + (nAttribute * m_nCapacity), nNumKept * sizeof(GLfloat));
+        }
+
+        memcpy(pIsActive, m_pIsActive, nNumKept * sizeof(BYTE));
+    }
+
+    GS_SAFE_DELETE_ARRAY(m_pAttributes);
+    GS_SAFE_DELETE_ARRAY(m_pIsActive);
+    GS_SAFE_DELETE_ARRAY(m_pStreams[0]);
+    GS_SAFE_DELETE_ARRAY(m_pStreams[1]);
+    GS_SAFE_DELETE_ARRAY(m_pStreamDeltas[0]);
+    GS_SAFE_DELETE_ARRAY(m_pStreamDeltas[1]);
+    GS_SAFE_DELETE_ARRAY(m_pJobQuads);
+
+    m_pAttributes = pAttributes;
+    m_pIsActive   = pIsActive;
+    m_pJobQuads   = pJobQuads;
+    m_nCapacity   = nCapacity;
+
+    // The streams are rebuilt on the next update or render.
+    m_pStreams[0]        = pFrontStream;
+    m_pStreams[1]        = pBackStream;
+    m_nNumStreamQuads[0] = 0;
+    m_nNumStreamQuads[1] = 0;
+    m_nFrontStream       = 0;
+    m_bIsStreamReady     = FALSE;
+
+    m_pStreamDeltas[0]     = pFrontDeltas;
+    m_pStreamDeltas[1]     = pBackDeltas;
+    m_fStreamInterpolation = 1.0f;
+
+    // Each attribute array starts where the previous one ends.
+    m_pPosX     = m_pAttributes;
+    m_pPosY     = m_pPosX     + m_nCapacity;
+    m_pVelX     = m_pPosY     + m_nCapacity;
+    m_pVelY     = m_pVelX     + m_nCapacity;
+    m_pRotateX  = m_pVelY     + m_nCapacity;
+    m_pRotateY  = m_pRotateX  + m_nCapacity;
+    m_pRotateZ  = m_pRotateY  + m_nCapacity;
+    m_pSpin     = m_pRotateZ  + m_nCapacity;
+    m_pScaleX   = m_pSpin     + m_nCapacity;
+    m_pScaleY   = m_pScaleX   + m_nCapacity;
+    m_pGrowth   = m_pScaleY   + m_nCapacity;
+    m_pRed      = m_pGrowth   + m_nCapacity;
+    m_pGreen    = m_pRed      + m_nCapacity;
+    m_pBlue     = m_pGreen    + m_nCapacity;
+    m_pAlpha    = m_pBlue     + m_nCapacity;
+    m_pFade     = m_pAlpha    + m_nCapacity;
+    m_pAge      = m_pFade     + m_nCapacity;
+    m_pLifetime = m_pAge      + m_nCapacity;
+    m_pPrevPosX = m_pLifetime + m_nCapacity;
+    m_pPrevPosY = m_pPrevPosX + m_nCapacity;
+
+    // Initialize the particles that were added.
+    this->ResetParticles(nNumKept, m_nCapacity);
+
+    if (m_nNumParticles > m_nCapacity)
+    {
+        m_nNumParticles = m_nCapacity;
+    }
+
+    if (m_nNextEmit >= m_nCapacity)
+    {
+        m_nNextEmit = 0;
+    }
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLParticle::ResetParticles():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Resets the particles from nFirst up to (but not including) nLast to defaults.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLParticle::ResetParticles(int nFirst, int nLast)
+{
+
+    for (int nLoop = nFirst; nLoop < nLast; nLoop++)
+    {
+        m_pIsActive[nLoop] = FALSE;
+        m_pPosX[nLoop]     = 0.0f;
+        m_pPosY[nLoop]     = 0.0f;
+        m_pVelX[nLoop]     = 0.0f;
+        m_pVelY[nLoop]     = 0.0f;
+        m_pRotateX[nLoop]  = 0.0f;
+        m_pRotateY[nLoop]  = 0.0f;
+        m_pRotateZ[nLoop]  = 0.0f;
+        m_pSpin[nLoop]     = 0.0f;
+        m_pScaleX[nLoop]   = 1.0f;
+        m_pScaleY[nLoop]   = 1.0f;
+        m_pGrowth[nLoop]   = 0.0f;
+        m_pRed[nLoop]      = 1.0f;
+        m_pGreen[nLoop]    = 1.0f;
+        m_pBlue[nLoop]     = 1.0f;
+        m_pAlpha[nLoop]    = 1.0f;
+        m_pFade[nLoop]     = 0.0f;
+        m_pAge[nLoop]      = 0.0f;
+        m_pLifetime[nLoop] = 0.0f;
+        m_pPrevPosX[nLoop] = 0.0f;
+        m_pPrevPosY[nLoop] = 0.0f;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLParticle::IsActive():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if particle is active, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLParticle::IsActive(int nParticleIndex)
+{
+
+    if (nParticleIndex >= m_nNumParticles)
+    {
+        nParticleIndex = m_nNumParticles - 1;
+    }
+    else if (nParticleIndex < 0)
+    {
+        nParticleIndex = 0;
+    }
+
+    return m_pIsActive[nParticleIndex];
+}
+
+
+//==============================================================================================
+// GS_OGLParticle::Activate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLParticle::Activate(int nParticleIndex, BOOL bActivate)
+{
+
+    if (nParticleIndex >= m_nNumParticles)
+    {
+        nParticleIndex = m_nNumParticles - 1;
+    }
+    else if (nParticleIndex < 0)
+    {
+        nParticleIndex = 0;
+    }
+
+    m_pIsActive[nParticleIndex] = bActivate;
+}
+
+
+void GS_OGLParticle::Activate(BOOL bActivate)
+{
+
+    for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
+    {
+        m_pIsActive[nLoop] = bActivate;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Get/Set Methods. ////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLParticle::GetNumParticles():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: An integer value indicating the number of particles.
+//==============================================================================================
+
+int GS_OGLParticle::GetNumParticles()
+{
+
+    return m_nNumParticles;
+}
+
+
+//==============================================================================================
+// GS_OGLParticle::SetNumParticles():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLParticle::SetNumParticles(int nNumParticles)
+{
+
+    // Is number of particles within bounds?
+    if (nNumParticles < 0)
+    {
+        nNumParticles = 0;
+    }
+
+    // Make room for more particles if needed, growing the capacity at least twofold so that
+    // adding particles one at a time doesn't reallocate every time.
+    if (nNumParticles > m_nCapacity)
+    {
+        int nCapacity = (nNumParticles > m_nCapacity * 2) ? nNumParticles : m_nCapacity * 2;
+
+        if (!this->SetCapacity(nCapacity))
+        {
+            nNumParticles = m_nCapacity;
+        }
+    }
+
+    // Set the number of particles.
+    m_nNumParticles = nNumParticles;
+}
+
+
+//==============================================================================================
+// GS_OGLParticle::GetDestX():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: An integer value indicating the horizontal position of the particle.
+//==============================================================================================
+
+GLint GS_OGLParticle::GetDestX(int nParticleIndex)
+{
+
+    if (nParticleIndex >= m_nNumParticles)
+    {
+        nParticleIndex = m_nNumParticles - 1;
+    }
+    else if (nParticleIndex < 0)
+    {
+        nParticleIndex = 0;
+    }
+
+    return (GLint) m_pPosX[nParticleIndex];
+}
+
+
+//==============================================================================================
+// GS_OGLParticle::SetDestX():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void  GS_OGLParticle::SetDestX(int nParticleIndex, GLint gliDestX)
+{
+
+    if (nParticleIndex >= m_nNumParticles)
+    {
+        nParticleIndex = m_nNumParticles - 1;
+    }
+    else if (nParticleIndex < 0)
+    {
+        nParticleIndex = 0;
+    }
+
+    m_pPosX[nParticleIndex] = gliDestX;
+}
+
+
+void  GS_OGLParticle::SetDestX(GLint gliDestX)
+{
+
+    for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
+    {
+        m_pPosX[nLoop] = gliDestX;
+    }
+}
+
+
+//==============================================================================================
+// GS_OGLParticle::GetDestY():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: An integer value indicating the vertical position of the particle.
+//==============================================================================================
+
+GLint GS_OGLParticle::GetDestY(int nParticleIndex)
+{
+
+    if (nParticleIndex >= m_nNumParticles)
+    {
+        nParticleIndex = m_nNumParticles - 1;
+    }
+    else if (nParticleIndex < 0)
+    {
+        nParticleIndex = 0;
+    }
+
+    return (GLint) m_pPosY[nParticleIndex];
+}
+
+
+//==============================================================================================
+// GS_OGLParticle::SetDestY():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void  GS_OGLParticle::SetDestY(int nParticleIndex, GLint gliDestY)
+{
+
+    if (nParticleIndex >= m_nNumParticles)
+    {
+        nParticleIndex = m_nNumParticles - 1;
+    }
+    else if (nParticleIndex < 0)
+    {
+        nParticleIndex = 0;
+    }
+
+    m_pPosY[nParticleIndex] = gliDestY;
+}
+
+void  GS_OGLParticle::SetDestY(GLint gliDestY)
+{
+
+    for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
+    {
+        m_pPosY[nLoop] = gliDestY;
+    }
+}
+
+
+//==============================================================================================
+// GS_OGLParticle::GetRotateX():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: A floating point value indicating the rotation on the x-axis.
+//==============================================================================================
+
+GLfloat GS_OGLParticle::GetRotateX(int nParticleIndex)
+{
+
+    if (nParticleIndex >= m_nNumParticles)
+    {
+        nParticleIndex = m_nNumParticles - 1;
+    }
+    else if (nParticleIndex < 0)
+    {
+        nParticleIndex = 0;
+    }
+
+    return m_pRotateX[nParticleIndex];
+}
+
+
+//==============================================================================================
+// GS_OGLParticle::SetRotateX():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLParticle::SetRotateX(int nParticleIndex, GLfloat glfRotateX)
+{
+
+    if (nParticleIndex >= m_nNumParticles)
+    {
+        nParticleIndex = m_nNumParticles - 1;
+    }
+    else if (nParticleIndex < 0)
+    {
+        nParticleIndex = 0;
+    }
+
+    m_pRotateX[nParticleIndex] = glfRotateX;
+}
+
+void GS_OGLParticle::SetRotateX(GLfloat glfRotateX)
+{
+
+    for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
+    {
+        m_pRotateX[nLoop] = glfRotateX;
+    }
+}
+
+
+//==============================================================================================
+// GS_OGLParticle::GetRotateY():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: A floating point value indicating the rotation on the y-axis.
+//==============================================================================================
+
+GLfloat GS_OGLParticle::GetRotateY(int nParticleIndex)
+{
+
+    if (nParticleIndex >= m_nNumParticles)
+    {
+        nParticleIndex = m_nNumParticles - 1;
+    }
+    else if (nParticleIndex < 0)
+    {
+        nParticleIndex = 0;
+    }
+
+    return m_pRotateY[nParticleIndex];
+}
+
+
+//==============================================================================================
+// GS_OGLParticle::SetRotateY():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLParticle::SetRotateY(int nParticleIndex, GLfloat glfRotateY)
+{
+
+    if (nParticleIndex >= m_nNumParticles)
+    {
+        nParticleIndex = m_nNumParticles - 1;
+    }
+    else if (nParticleIndex < 0)
+    {
+        nParticleIndex = 0;
+    }
+
+    m_pRotateY[nParticleIndex] = glfRotateY;
+}
+
+void GS_OGLParticle::SetRotateY(GLfloat glfRotateY)
+{
+
+    for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
+    {
+        m_pRotateY[nLoop] = glfRotateY;
+    }
+}
+
+
+//==============================================================================================
+// GS_OGLParticle::GetRotateZ():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: A floating point value indicating the rotation on the z-axis.
+//==============================================================================================
+
+GLfloat GS_OGLParticle::GetRotateZ(int nParticleIndex)
+{
+
+    if (nParticleIndex >= m_nNumParticles)
+    {
+        nParticleIndex = m_nNumParticles - 1;
+    }
+    else if (nParticleIndex < 0)
+    {
+        nParticleIndex = 0;
+    }
+
+    return m_pRotateZ[nParticleIndex];
+}
+
+
+//==============================================================================================
+// GS_OGLParticle::SetRotateZ():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLParticle::SetRotateZ(int nParticleIndex, GLfloat glfRotateZ)
+{
+
+    if (nParticleIndex >= m_nNumParticles)
+    {
+        nParticleIndex = m_nNumParticles - 1;
+    }
+    else if (nParticleIndex < 0)
+    {
+        nParticleIndex = 0;
+    }
+
+    m_pRotateZ[nParticleIndex] = glfRotateZ;
+}
+
+void GS_OGLParticle::SetRotateZ(GLfloat glfRotateZ)
 {
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].gliDestY = gliDestY;
+        m_pRotateZ[nLoop] = glfRotateZ;
     }
 }
 
 
 //==============================================================================================
-// GS_OGLParticle::GetRotateX():
+// GS_OGLParticle::GetScaleX():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: A floating point value indicating the rotation on the x-axis.
+// Returns: A floating point value indicating the horizontal scale of the particle.
 //==============================================================================================
 
-GLfloat GS_OGLParticle::GetRotateX(int nParticleIndex)
+GLfloat GS_OGLParticle::GetScaleX(int nParticleIndex)
 {
 
     if (nParticleIndex >= m_nNumParticles)
@@ -799,19 +1732,19 @@ GLfloat GS_OGLParticle::GetRotateX(int nParticleIndex)
         nParticleIndex = 0;
     }
 
-    return m_gsParticles[nParticleIndex].glfRotateX;
+    return m_pScaleX[nParticleIndex];
 }
 
 
 //==============================================================================================
-// GS_OGLParticle::SetRotateX():
+// GS_OGLParticle::SetScaleX():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
-void GS_OGLParticle::SetRotateX(int nParticleIndex, GLfloat glfRotateX)
+void GS_OGLParticle::SetScaleX(int nParticleIndex, GLfloat glfScaleX)
 {
 
     if (nParticleIndex >= m_nNumParticles)
@@ -823,28 +1756,28 @@ void GS_OGLParticle::SetRotateX(int nParticleIndex, GLfloat glfRotateX)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].glfRotateX = glfRotateX;
+    m_pScaleX[nParticleIndex] = glfScaleX;
 }
 
-void GS_OGLParticle::SetRotateX(GLfloat glfRotateX)
+void GS_OGLParticle::SetScaleX(GLfloat glfScaleX)
 {
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfRotateX = glfRotateX;
+        m_pScaleX[nLoop] = glfScaleX;
     }
 }
 
 
 //==============================================================================================
-// GS_OGLParticle::GetRotateY():
+// GS_OGLParticle::GetScaleY():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: A floating point value indicating the rotation on the y-axis.
+// Returns: A floating point value indicating the vertical scale of the particle.
 //==============================================================================================
 
-GLfloat GS_OGLParticle::GetRotateY(int nParticleIndex)
+GLfloat GS_OGLParticle::GetScaleY(int nParticleIndex)
 {
 
     if (nParticleIndex >= m_nNumParticles)
@@ -856,19 +1789,19 @@ GLfloat GS_OGLParticle::GetRotateY(int nParticleIndex)
         nParticleIndex = 0;
     }
 
-    return m_gsParticles[nParticleIndex].glfRotateY;
+    return m_pScaleY[nParticleIndex];
 }
 
 
 //==============================================================================================
-// GS_OGLParticle::SetRotateY():
+// GS_OGLParticle::SetScaleY():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
-void GS_OGLParticle::SetRotateY(int nParticleIndex, GLfloat glfRotateY)
+void GS_OGLParticle::SetScaleY(int nParticleIndex, GLfloat glfScaleY)
 {
 
     if (nParticleIndex >= m_nNumParticles)
@@ -880,28 +1813,28 @@ void GS_OGLParticle::SetRotateY(int nParticleIndex, GLfloat glfRotateY)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].glfRotateY = glfRotateY;
+    m_pScaleY[nParticleIndex] = glfScaleY;
 }
 
-void GS_OGLParticle::SetRotateY(GLfloat glfRotateY)
+void GS_OGLParticle::SetScaleY(GLfloat glfScaleY)
 {
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfRotateY = glfRotateY;
+        m_pScaleY[nLoop] = glfScaleY;
     }
 }
 
 
 //==============================================================================================
-// GS_OGLParticle::GetRotateZ():
+// GS_OGLParticle::GetVelocityX():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: A floating point value indicating the rotation on the z-axis.
+// Returns: A floating point value indicating the horizontal velocity of the particle.
 //==============================================================================================
 
-GLfloat GS_OGLParticle::GetRotateZ(int nParticleIndex)
+GLfloat GS_OGLParticle::GetVelocityX(int nParticleIndex)
 {
 
     if (nParticleIndex >= m_nNumParticles)
@@ -913,19 +1846,43 @@ GLfloat GS_OGLParticle::GetRotateZ(int nParticleIndex)
         nParticleIndex = 0;
     }
 
-    return m_gsParticles[nParticleIndex].glfRotateZ;
+    return m_pVelX[nParticleIndex];
 }
 
 
 //==============================================================================================
-// GS_OGLParticle::SetRotateZ():
+// GS_OGLParticle::GetVelocityY():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
+// Returns: A floating point value indicating the vertical velocity of the particle.
+//==============================================================================================
+
+GLfloat GS_OGLParticle::GetVelocityY(int nParticleIndex)
+{
+
+    if (nParticleIndex >= m_nNumParticles)
+    {
+        nParticleIndex = m_nNumParticles - 1;
+    }
+    else if (nParticleIndex < 0)
+    {
+        nParticleIndex = 0;
+    }
+
+    return m_pVelY[nParticleIndex];
+}
+
+
+//==============================================================================================
+// GS_OGLParticle::SetVelocity():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the velocity of the particle in pixels per second (see Update()).
+// ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
-void GS_OGLParticle::SetRotateZ(int nParticleIndex, GLfloat glfRotateZ)
+void GS_OGLParticle::SetVelocity(int nParticleIndex, GLfloat fVelX, GLfloat fVelY)
 {
 
     if (nParticleIndex >= m_nNumParticles)
@@ -937,28 +1894,54 @@ void GS_OGLParticle::SetRotateZ(int nParticleIndex, GLfloat glfRotateZ)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].glfRotateZ = glfRotateZ;
+    m_pVelX[nParticleIndex] = fVelX;
+    m_pVelY[nParticleIndex] = fVelY;
 }
 
-void GS_OGLParticle::SetRotateZ(GLfloat glfRotateZ)
+
+void GS_OGLParticle::SetVelocity(GLfloat fVelX, GLfloat fVelY)
 {
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfRotateZ = glfRotateZ;
+        m_pVelX[nLoop] = fVelX;
+        m_pVelY[nLoop] = fVelY;
     }
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
-// GS_OGLParticle::GetScaleX():
+// GS_OGLParticle::SetAcceleration():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the acceleration applied to all particles by Update() in pixels per second
+//          squared (for example gravity).
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLParticle::SetAcceleration(GLfloat fAccelX, GLfloat fAccelY)
+{
+
+    m_fAccelX = fAccelX;
+    m_fAccelY = fAccelY;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLParticle::GetSpin():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: A floating point value indicating the horizontal scale of the particle.
+// Returns: A floating point value indicating the spin of the particle.
 //==============================================================================================
 
-GLfloat GS_OGLParticle::GetScaleX(int nParticleIndex)
+GLfloat GS_OGLParticle::GetSpin(int nParticleIndex)
 {
 
     if (nParticleIndex >= m_nNumParticles)
@@ -970,19 +1953,80 @@ GLfloat GS_OGLParticle::GetScaleX(int nParticleIndex)
         nParticleIndex = 0;
     }
 
-    return m_gsParticles[nParticleIndex].glfScaleX;
+    return m_pSpin[nParticleIndex];
 }
 
 
 //==============================================================================================
-// GS_OGLParticle::SetScaleX():
+// GS_OGLParticle::SetSpin():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets how many degrees per second Update() rotates the particle on the Z-axis.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLParticle::SetSpin(int nParticleIndex, GLfloat fSpin)
+{
+
+    if (nParticleIndex >= m_nNumParticles)
+    {
+        nParticleIndex = m_nNumParticles - 1;
+    }
+    else if (nParticleIndex < 0)
+    {
+        nParticleIndex = 0;
+    }
+
+    m_pSpin[nParticleIndex] = fSpin;
+}
+
+
+void GS_OGLParticle::SetSpin(GLfloat fSpin)
+{
+
+    for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
+    {
+        m_pSpin[nLoop] = fSpin;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLParticle::GetGrowth():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
+// Returns: A floating point value indicating the growth of the particle.
+//==============================================================================================
+
+GLfloat GS_OGLParticle::GetGrowth(int nParticleIndex)
+{
+
+    if (nParticleIndex >= m_nNumParticles)
+    {
+        nParticleIndex = m_nNumParticles - 1;
+    }
+    else if (nParticleIndex < 0)
+    {
+        nParticleIndex = 0;
+    }
+
+    return m_pGrowth[nParticleIndex];
+}
+
+
+//==============================================================================================
+// GS_OGLParticle::SetGrowth():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets how much Update() changes the scale of the particle per second.
+// ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
-void GS_OGLParticle::SetScaleX(int nParticleIndex, GLfloat glfScaleX)
+void GS_OGLParticle::SetGrowth(int nParticleIndex, GLfloat fGrowth)
 {
 
     if (nParticleIndex >= m_nNumParticles)
@@ -994,28 +2038,32 @@ void GS_OGLParticle::SetScaleX(int nParticleIndex, GLfloat glfScaleX)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].glfScaleX = glfScaleX;
+    m_pGrowth[nParticleIndex] = fGrowth;
 }
 
-void GS_OGLParticle::SetScaleX(GLfloat glfScaleX)
+
+void GS_OGLParticle::SetGrowth(GLfloat fGrowth)
 {
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfScaleX = glfScaleX;
+        m_pGrowth[nLoop] = fGrowth;
     }
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
-// GS_OGLParticle::GetScaleY():
+// GS_OGLParticle::GetFade():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
-// Returns: A floating point value indicating the vertical scale of the particle.
+// Returns: A floating point value indicating the fade of the particle.
 //==============================================================================================
 
-GLfloat GS_OGLParticle::GetScaleY(int nParticleIndex)
+GLfloat GS_OGLParticle::GetFade(int nParticleIndex)
 {
 
     if (nParticleIndex >= m_nNumParticles)
@@ -1027,19 +2075,105 @@ GLfloat GS_OGLParticle::GetScaleY(int nParticleIndex)
         nParticleIndex = 0;
     }
 
-    return m_gsParticles[nParticleIndex].glfScaleY;
+    return m_pFade[nParticleIndex];
 }
 
 
 //==============================================================================================
-// GS_OGLParticle::SetScaleY():
+// GS_OGLParticle::SetFade():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets how much Update() changes the alpha of the particle per second.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLParticle::SetFade(int nParticleIndex, GLfloat fFade)
+{
+
+    if (nParticleIndex >= m_nNumParticles)
+    {
+        nParticleIndex = m_nNumParticles - 1;
+    }
+    else if (nParticleIndex < 0)
+    {
+        nParticleIndex = 0;
+    }
+
+    m_pFade[nParticleIndex] = fFade;
+}
+
+
+void GS_OGLParticle::SetFade(GLfloat fFade)
+{
+
+    for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
+    {
+        m_pFade[nLoop] = fFade;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLParticle::GetAge():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: A floating point value indicating the seconds since the particle was emitted.
+//==============================================================================================
+
+GLfloat GS_OGLParticle::GetAge(int nParticleIndex)
+{
+
+    if (nParticleIndex >= m_nNumParticles)
+    {
+        nParticleIndex = m_nNumParticles - 1;
+    }
+    else if (nParticleIndex < 0)
+    {
+        nParticleIndex = 0;
+    }
+
+    return m_pAge[nParticleIndex];
+}
+
+
+//==============================================================================================
+// GS_OGLParticle::GetLifetime():
 // ---------------------------------------------------------------------------------------------
 // Purpose: ...
 // ---------------------------------------------------------------------------------------------
+// Returns: A floating point value indicating the lifetime of the particle.
+//==============================================================================================
+
+GLfloat GS_OGLParticle::GetLifetime(int nParticleIndex)
+{
+
+    if (nParticleIndex >= m_nNumParticles)
+    {
+        nParticleIndex = m_nNumParticles - 1;
+    }
+    else if (nParticleIndex < 0)
+    {
+        nParticleIndex = 0;
+    }
+
+    return m_pLifetime[nParticleIndex];
+}
+
+
+//==============================================================================================
+// GS_OGLParticle::SetLifetime():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets how many seconds the particle lives for after being emitted before Update()
+//          deactivates it, 0.0f means the particle lives until it is deactivated.
+// ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
-void GS_OGLParticle::SetScaleY(int nParticleIndex, GLfloat glfScaleY)
+void GS_OGLParticle::SetLifetime(int nParticleIndex, GLfloat fLifetime)
 {
 
     if (nParticleIndex >= m_nNumParticles)
@@ -1051,19 +2185,23 @@ void GS_OGLParticle::SetScaleY(int nParticleIndex, GLfloat glfScaleY)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].glfScaleY = glfScaleY;
+    m_pLifetime[nParticleIndex] = fLifetime;
 }
 
-void GS_OGLParticle::SetScaleY(GLfloat glfScaleY)
+
+void GS_OGLParticle::SetLifetime(GLfloat fLifetime)
 {
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfScaleY = glfScaleY;
+        m_pLifetime[nLoop] = fLifetime;
     }
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
 // GS_OGLParticle::GetWidth():
 // ---------------------------------------------------------------------------------------------
@@ -1114,7 +2252,7 @@ GLfloat GS_OGLParticle::GetScaledWidth(int nParticleIndex)
         nParticleIndex = 0;
     }
 
-    return (m_gliWidth * m_gsParticles[nParticleIndex].glfScaleX);
+    return (m_gliWidth * m_pScaleX[nParticleIndex]);
 }
 
 
@@ -1143,11 +2281,11 @@ void GS_OGLParticle::SetScaledWidth(int nParticleIndex, GLint gliWidth)
 
     if (m_gliWidth > 0)
     {
-        m_gsParticles[nParticleIndex].glfScaleX = float(gliWidth) / m_gliWidth;
+        m_pScaleX[nParticleIndex] = float(gliWidth) / m_gliWidth;
     }
     else
     {
-        m_gsParticles[nParticleIndex].glfScaleX = 0.0f;
+        m_pScaleX[nParticleIndex] = 0.0f;
     }
 }
 
@@ -1167,7 +2305,7 @@ void GS_OGLParticle::SetScaledWidth(GLint gliWidth)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfScaleX = fScaleX;
+        m_pScaleX[nLoop] = fScaleX;
     }
 }
 
@@ -1195,7 +2333,7 @@ GLfloat GS_OGLParticle::GetScaledHeight(int nParticleIndex)
         nParticleIndex = 0;
     }
 
-    return (m_gliHeight * m_gsParticles[nParticleIndex].glfScaleY);
+    return (m_gliHeight * m_pScaleY[nParticleIndex]);
 }
 
 
@@ -1224,11 +2362,11 @@ void GS_OGLParticle::SetScaledHeight(int nParticleIndex, GLint gliHeight)
 
     if (m_gliHeight > 0)
     {
-        m_gsParticles[nParticleIndex].glfScaleY = float(gliHeight) / m_gliHeight;
+        m_pScaleY[nParticleIndex] = float(gliHeight) / m_gliHeight;
     }
     else
     {
-        m_gsParticles[nParticleIndex].glfScaleY = 0.0f;
+        m_pScaleY[nParticleIndex] = 0.0f;
     }
 }
 
@@ -1248,7 +2386,7 @@ void GS_OGLParticle::SetScaledHeight(GLint gliHeight)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfScaleY = fScaleY;
+        m_pScaleY[nLoop] = fScaleY;
     }
 }
 
@@ -1277,12 +2415,12 @@ void GS_OGLParticle::GetDestRect(int nParticleIndex, long* pLeft, long* pTop, lo
         nParticleIndex = 0;
     }
 
-    *(pLeft)   = m_gsParticles[nParticleIndex].gliDestX;
-    *(pTop)    = m_gsParticles[nParticleIndex].gliDestY +
+    *(pLeft)   = long(m_pPosX[nParticleIndex]);
+    *(pTop)    = long(m_pPosY[nParticleIndex]) +
                  long(this->GetScaledHeight(nParticleIndex));
-    *(pRight)  = m_gsParticles[nParticleIndex].gliDestX +
+    *(pRight)  = long(m_pPosX[nParticleIndex]) +
                  long(this->GetScaledWidth(nParticleIndex));
-    *(pBottom) = m_gsParticles[nParticleIndex].gliDestY;
+    *(pBottom) = long(m_pPosY[nParticleIndex]);
 }
 
 void GS_OGLParticle::GetDestRect(int nParticleIndex, RECT* pDestRect)
@@ -1297,10 +2435,10 @@ void GS_OGLParticle::GetDestRect(int nParticleIndex, RECT* pDestRect)
         nParticleIndex = 0;
     }
 
-    SetRect(pDestRect, m_gsParticles[nParticleIndex].gliDestX,
-            m_gsParticles[nParticleIndex].gliDestY + long(this->GetScaledHeight(nParticleIndex)),
-            m_gsParticles[nParticleIndex].gliDestX + long(this->GetScaledWidth(nParticleIndex)),
-            m_gsParticles[nParticleIndex].gliDestY);
+    SetRect(pDestRect, long(m_pPosX[nParticleIndex]),
+            long(m_pPosY[nParticleIndex]) + long(this->GetScaledHeight(nParticleIndex)),
+            long(m_pPosX[nParticleIndex]) + long(this->GetScaledWidth(nParticleIndex)),
+            long(m_pPosY[nParticleIndex]));
 }
 
 
@@ -1332,7 +2470,7 @@ void GS_OGLParticle::AddDestX(int nParticleIndex, GLint gliAddX)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].gliDestX += gliAddX;
+    m_pPosX[nParticleIndex] += gliAddX;
 }
 
 void GS_OGLParticle::AddDestX(GLint gliAddX)
@@ -1340,7 +2478,7 @@ void GS_OGLParticle::AddDestX(GLint gliAddX)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].gliDestX += gliAddX;
+        m_pPosX[nLoop] += gliAddX;
     }
 }
 
@@ -1368,7 +2506,7 @@ void GS_OGLParticle::AddDestY(int nParticleIndex, GLint gliAddY)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].gliDestY += gliAddY;
+    m_pPosY[nParticleIndex] += gliAddY;
 }
 
 void GS_OGLParticle::AddDestY(GLint gliAddY)
@@ -1376,7 +2514,7 @@ void GS_OGLParticle::AddDestY(GLint gliAddY)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].gliDestY += gliAddY;
+        m_pPosY[nLoop] += gliAddY;
     }
 }
 
@@ -1404,7 +2542,7 @@ void GS_OGLParticle::AddRotateX(int nParticleIndex, GLfloat glfRotateX)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].glfRotateX += glfRotateX;
+    m_pRotateX[nParticleIndex] += glfRotateX;
 }
 
 void GS_OGLParticle::AddRotateX(GLfloat glfRotateX)
@@ -1412,7 +2550,7 @@ void GS_OGLParticle::AddRotateX(GLfloat glfRotateX)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfRotateX += glfRotateX;
+        m_pRotateX[nLoop] += glfRotateX;
     }
 }
 
@@ -1440,7 +2578,7 @@ void GS_OGLParticle::AddRotateY(int nParticleIndex, GLfloat glfRotateY)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].glfRotateY += glfRotateY;
+    m_pRotateY[nParticleIndex] += glfRotateY;
 }
 
 void GS_OGLParticle::AddRotateY(GLfloat glfRotateY)
@@ -1448,7 +2586,7 @@ void GS_OGLParticle::AddRotateY(GLfloat glfRotateY)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfRotateY += glfRotateY;
+        m_pRotateY[nLoop] += glfRotateY;
     }
 }
 
@@ -1476,7 +2614,7 @@ void GS_OGLParticle::AddRotateZ(int nParticleIndex, GLfloat glfRotateZ)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].glfRotateZ += glfRotateZ;
+    m_pRotateZ[nParticleIndex] += glfRotateZ;
 }
 
 void GS_OGLParticle::AddRotateZ(GLfloat glfRotateZ)
@@ -1484,7 +2622,7 @@ void GS_OGLParticle::AddRotateZ(GLfloat glfRotateZ)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfRotateZ += glfRotateZ;
+        m_pRotateZ[nLoop] += glfRotateZ;
     }
 }
 
@@ -1512,7 +2650,7 @@ void GS_OGLParticle::AddScaleX(int nParticleIndex, GLfloat glfScaleX)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].glfScaleX += glfScaleX;
+    m_pScaleX[nParticleIndex] += glfScaleX;
 }
 
 void GS_OGLParticle::AddScaleX(GLfloat glfScaleX)
@@ -1520,7 +2658,7 @@ void GS_OGLParticle::AddScaleX(GLfloat glfScaleX)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfScaleX += glfScaleX;
+        m_pScaleX[nLoop] += glfScaleX;
     }
 }
 
@@ -1548,7 +2686,7 @@ void GS_OGLParticle::AddScaleY(int nParticleIndex, GLfloat glfScaleY)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].glfScaleY += glfScaleY;
+    m_pScaleY[nParticleIndex] += glfScaleY;
 }
 
 void GS_OGLParticle::AddScaleY(GLfloat glfScaleY)
@@ -1556,7 +2694,7 @@ void GS_OGLParticle::AddScaleY(GLfloat glfScaleY)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfScaleY += glfScaleY;
+        m_pScaleY[nLoop] += glfScaleY;
     }
 }
 
@@ -1584,10 +2722,10 @@ void GS_OGLParticle::SetModulateColor(int nParticleIndex, GS_OGLColor gsColor)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].glfR = gsColor.fRed;
-    m_gsParticles[nParticleIndex].glfG = gsColor.fGreen;
-    m_gsParticles[nParticleIndex].glfB = gsColor.fBlue;
-    m_gsParticles[nParticleIndex].glfA = gsColor.fAlpha;
+    m_pRed[nParticleIndex] = gsColor.fRed;
+    m_pGreen[nParticleIndex] = gsColor.fGreen;
+    m_pBlue[nParticleIndex] = gsColor.fBlue;
+    m_pAlpha[nParticleIndex] = gsColor.fAlpha;
 }
 
 void GS_OGLParticle::SetModulateColor(GS_OGLColor gsColor)
@@ -1595,10 +2733,10 @@ void GS_OGLParticle::SetModulateColor(GS_OGLColor gsColor)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfR = gsColor.fRed;
-        m_gsParticles[nLoop].glfG = gsColor.fGreen;
-        m_gsParticles[nLoop].glfB = gsColor.fBlue;
-        m_gsParticles[nLoop].glfA = gsColor.fAlpha;
+        m_pRed[nLoop] = gsColor.fRed;
+        m_pGreen[nLoop] = gsColor.fGreen;
+        m_pBlue[nLoop] = gsColor.fBlue;
+        m_pAlpha[nLoop] = gsColor.fAlpha;
     }
 }
 
@@ -1617,19 +2755,19 @@ void GS_OGLParticle::SetModulateColor(int nParticleIndex, float fRed, float fGre
 
     if (fRed   > -1.0f)
     {
-        m_gsParticles[nParticleIndex].glfR = fRed;
+        m_pRed[nParticleIndex] = fRed;
     }
     if (fGreen > -1.0f)
     {
-        m_gsParticles[nParticleIndex].glfG = fGreen;
+        m_pGreen[nParticleIndex] = fGreen;
     }
     if (fBlue  > -1.0f)
     {
-        m_gsParticles[nParticleIndex].glfB = fBlue;
+        m_pBlue[nParticleIndex] = fBlue;
     }
     if (fAlpha > -1.0f)
     {
-        m_gsParticles[nParticleIndex].glfA = fAlpha;
+        m_pAlpha[nParticleIndex] = fAlpha;
     }
 }
 
@@ -1640,19 +2778,19 @@ void GS_OGLParticle::SetModulateColor(float fRed, float fGreen, float fBlue, flo
     {
         if (fRed   > -1.0f)
         {
-            m_gsParticles[nLoop].glfR = fRed;
+            m_pRed[nLoop] = fRed;
         }
         if (fGreen > -1.0f)
         {
-            m_gsParticles[nLoop].glfG = fGreen;
+            m_pGreen[nLoop] = fGreen;
         }
         if (fBlue  > -1.0f)
         {
-            m_gsParticles[nLoop].glfB = fBlue;
+            m_pBlue[nLoop] = fBlue;
         }
         if (fAlpha > -1.0f)
         {
-            m_gsParticles[nLoop].glfA = fAlpha;
+            m_pAlpha[nLoop] = fAlpha;
         }
     }
 }
@@ -40,44 +40,23 @@
 #include "gs_error.h"
 #include "gs_object.h"
 #include "gs_ogl_texture.h"
+#include "gs_ogl_texture_cache.h"
+#include "gs_ogl_texture_atlas.h"
+#include "gs_math.h"
 #include "gs_ogl_color.h"
+#include "gs_ogl_sprite_batch.h"
+#include "gs_job_system.h"
 //==============================================================================================
 
 
 //==============================================================================================
 // Particle defines.
 // ---------------------------------------------------------------------------------------------
-#define MAX_PARTICLES 1000
-//==============================================================================================
-
-
-//==============================================================================================
-// Global variables for adjusting the scale factor of sprites allowing upscaling and downscaling
-// without affecting the game mechanics in any way. These variable will be declared and used in
-// the gs_ogl_sprite.cpp file
-// ---------------------------------------------------------------------------------------------
-extern float g_fRenderModX;
-extern float g_fRenderModY;
-extern float g_fScaleFactorX;
-extern float g_fScaleFactorY;
-// ---------------------------------------------------------------------------------------------
+#define MAX_PARTICLES 1000 // Default particle capacity (see SetCapacity()).
 
+#define GS_PARTICLE_NUM_ATTRIBUTES 20 // Number of floating point attributes per particle.
 
-//==============================================================================================
-// Particle structures.
-// ---------------------------------------------------------------------------------------------
-typedef struct GS_PARTICLE
-{
-    BOOL    bIsActive;  // Wether particle should be rendered or not.
-    GLint   gliDestX;   // Destination X and Y of the bottom left corner of the particle.
-    GLint   gliDestY;
-    GLfloat glfRotateX; // Particle rotation on the X, Y and Z-axis (in degrees).
-    GLfloat glfRotateY;
-    GLfloat glfRotateZ;
-    GLfloat glfScaleX;  // X and Y particle scale (1.0f is normal).
-    GLfloat glfScaleY;
-    GLfloat glfR, glfG, glfB, glfA; // Colors to modulate the particle with.
-} GS_Particle;
+#define GS_PARTICLE_JOB_SIZE 2048 // Number of particles updated by each job (see Update()).
 //==============================================================================================
 
 
@@ -92,9 +71,20 @@ class GS_OGLParticle : public GS_Object
 private:
 
     GS_OGLTexture m_gsTexture; // The texture surface holding the particle image.
+    GS_OGLTexture* m_pSharedTexture; // The texture if it is shared through a texture cache.
+    GS_TextureCache* m_pSharedCache; // The cache the shared texture was acquired from.
     GLuint m_gluTexture;       // The texture surface holding the particle image.
 
-    int m_nNumParticles; // How many particles are active.
+    // The texture coordinates of the particle image, all of the texture unless the particle
+    // was created from a texture atlas.
+    GLfloat m_fTexLeft;
+    GLfloat m_fTexBottom;
+    GLfloat m_fTexRight;
+    GLfloat m_fTexTop;
+
+    int m_nNumParticles; // How many particles are in use (active or not).
+    int m_nCapacity;     // How many particles there is room for.
+    int m_nNextEmit;     // Where Emit() starts looking for an inactive particle.
 
     BOOL m_bIsReady; // Wether particle object has been created or not.
 
@@ -104,7 +94,58 @@ private:
     GLint m_gliWidth;  // The actual width of the particle.
     GLint m_gliHeight; // The actual height of the particle.
 
-    GS_Particle m_gsParticles[MAX_PARTICLES];
+    // The particle attributes in structure-of-arrays layout, each array holds m_nCapacity
+    // values and all of them are part of the single m_pAttributes allocation.
+    GLfloat* m_pAttributes;
+    GLfloat* m_pPosX;     // Position of the bottom left corner of the particle.
+    GLfloat* m_pPosY;
+    GLfloat* m_pVelX;     // Velocity in pixels per second.
+    GLfloat* m_pVelY;
+    GLfloat* m_pRotateX;  // Rotation on the X, Y and Z-axis (in degrees).
+    GLfloat* m_pRotateY;
+    GLfloat* m_pRotateZ;
+    GLfloat* m_pSpin;     // Rotation speed on the Z-axis in degrees per second.
+    GLfloat* m_pScaleX;   // X and Y particle scale (1.0f is normal).
+    GLfloat* m_pScaleY;
+    GLfloat* m_pGrowth;   // Scale change per second (on both axes).
+    GLfloat* m_pRed;      // Colors to modulate the particle with.
+    GLfloat* m_pGreen;
+    GLfloat* m_pBlue;
+    GLfloat* m_pAlpha;
+    GLfloat* m_pFade;     // Alpha change per second.
+    GLfloat* m_pAge;      // Seconds since the particle was emitted.
+    GLfloat* m_pLifetime; // Seconds the particle lives for (0.0f means forever).
+    GLfloat* m_pPrevPosX; // Position saved by SaveTransform().
+    GLfloat* m_pPrevPosY;
+    BYTE*    m_pIsActive; // Wether a particle should be updated and rendered or not.
+
+    GLfloat m_fAccelX; // Acceleration applied to all particles in pixels per second squared.
+    GLfloat m_fAccelY;
+
+    // Double-buffered vertex stream (4 vertices per quad). Updates write the back stream while
+    // Render() draws the front stream, the two are swapped once an update has finished.
+    GS_BatchVertex* m_pStreams[2];
+    int  m_nNumStreamQuads[2];
+    int  m_nFrontStream;
+    BOOL m_bIsStreamReady; // Wether the front stream holds the result of the last update.
+
+    // How far each quad of the streams moved since SaveTransform() (2 floats per quad), so the
+    // front stream can be moved back between the two positions by Render().
+    GLfloat* m_pStreamDeltas[2];
+    GLfloat m_fStreamInterpolation; // The interpolation the front stream is positioned at.
+    GLfloat m_fInterpolation;       // How far between the saved and current position to draw.
+
+    int* m_pJobQuads;               // Number of quads written by each update job.
+    GLfloat m_fUpdateTime;          // The time step of the running update.
+    GS_JobSystem* m_pJobSystem;     // The job system running the update, if any.
+    GS_JobCounter m_gsUpdateCounter; // Update jobs that have not finished yet.
+    BOOL m_bIsUpdating;             // Wether an update has been started but not ended.
+
+    void ResetParticles(int nFirst, int nLast);
+
+    static void UpdateJob(void* pData, int nFirst, int nLast);
+    void UpdateRange(int nFirst, int nLast, GLfloat fDeltaTime);
+    int  BuildVertices(int nFirst, int nLast, GS_BatchVertex* pVertices, GLfloat* pDeltas);
 
 protected:
 
@@ -118,14 +159,28 @@ public:
     BOOL Create(const char* pszPathname, int nNumParticles, BOOL bFiltered = TRUE,
                 BOOL bMipmap = FALSE);
     BOOL Create(GLuint glTexture, int nWidth, int nHeight, int nNumParticles);
+    BOOL Create(GS_AtlasRegion* pRegion, int nNumParticles);
     void Destroy();
 
     BOOL BeginRender(HWND hWnd);
     void EndRender();
     BOOL Render(HWND hWnd = NULL);
 
+    void Update(GLfloat fDeltaTime, GS_JobSystem* pJobSystem = NULL);
+    void BeginUpdate(GLfloat fDeltaTime, GS_JobSystem* pJobSystem = NULL);
+    void EndUpdate();
+    int  Emit(GLfloat fPosX, GLfloat fPosY, GLfloat fVelX = 0.0f, GLfloat fVelY = 0.0f,
+              GLfloat fLifetime = 0.0f);
+
+    void SaveTransform(int nParticleIndex);
+    void SaveTransform();
+    void SetInterpolation(GLfloat fInterpolation);
+
     BOOL IsReady();
 
+    int  GetCapacity();
+    BOOL SetCapacity(int nCapacity);
+
     BOOL IsActive(int nParticleIndex);
     void Activate(int nParticleIndex, BOOL bActivate = TRUE);
     void Activate(BOOL bActivate = TRUE);
@@ -161,6 +216,30 @@ public:
     void SetScaleY(int nParticleIndex, GLfloat glfScaleY);
     void SetScaleY(GLfloat glfScaleY);
 
+    GLfloat GetVelocityX(int nParticleIndex);
+    GLfloat GetVelocityY(int nParticleIndex);
+    void SetVelocity(int nParticleIndex, GLfloat fVelX, GLfloat fVelY);
+    void SetVelocity(GLfloat fVelX, GLfloat fVelY);
+
+    void SetAcceleration(GLfloat fAccelX, GLfloat fAccelY);
+
+    GLfloat GetSpin(int nParticleIndex);
+    void SetSpin(int nParticleIndex, GLfloat fSpin);
+    void SetSpin(GLfloat fSpin);
+
+    GLfloat GetGrowth(int nParticleIndex);
+    void SetGrowth(int nParticleIndex, GLfloat fGrowth);
+    void SetGrowth(GLfloat fGrowth);
+
+    GLfloat GetFade(int nParticleIndex);
+    void SetFade(int nParticleIndex, GLfloat fFade);
+    void SetFade(GLfloat fFade);
+
+    GLfloat GetAge(int nParticleIndex);
+    GLfloat GetLifetime(int nParticleIndex);
+    void SetLifetime(int nParticleIndex, GLfloat fLifetime);
+    void SetLifetime(GLfloat fLifetime);
+
     GLint GetWidth();
     GLint GetHeight();
 
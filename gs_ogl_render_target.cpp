@@ -0,0 +1,553 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_render_target.cpp, gs_ogl_render_target.h                                    |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_OGLRenderTarget                                                                  |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: An offscreen framebuffer with a texture attached to it. Everything is drawn to the  |
+ |        target at a fixed resolution and the texture is then drawn to the screen once,      |
+ |        scaled with a selectable filter.                                                    |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_ogl_render_target.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Static members.
+// ---------------------------------------------------------------------------------------------
+GS_PFNGENFRAMEBUFFERSPROC        GS_OGLRenderTarget::m_pfnGenFramebuffers        = NULL;
+GS_PFNDELETEFRAMEBUFFERSPROC     GS_OGLRenderTarget::m_pfnDeleteFramebuffers     = NULL;
+GS_PFNBINDFRAMEBUFFERPROC        GS_OGLRenderTarget::m_pfnBindFramebuffer        = NULL;
+GS_PFNFRAMEBUFFERTEXTURE2DPROC   GS_OGLRenderTarget::m_pfnFramebufferTexture2D   = NULL;
+GS_PFNCHECKFRAMEBUFFERSTATUSPROC GS_OGLRenderTarget::m_pfnCheckFramebufferStatus = NULL;
+GS_PFNBLENDFUNCSEPARATEPROC      GS_OGLRenderTarget::m_pfnBlendFuncSeparate      = NULL;
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor/Destructor Methods //////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::GS_OGLRenderTarget():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The constructor, initializes class data when class object is created.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_OGLRenderTarget::GS_OGLRenderTarget()
+{
+
+    m_gluFramebuffer = 0;
+    m_gluTexture     = 0;
+
+    m_nWidth   = 0;
+    m_nHeight  = 0;
+    m_glFilter = GL_NEAREST;
+
+    m_bIsBound = FALSE;
+    m_bIsReady = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::~GS_OGLRenderTarget():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The de-structor, de-initializes class data when class object is destroyed.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_OGLRenderTarget::~GS_OGLRenderTarget()
+{
+
+    this->Destroy();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Create/Destroy Methods //////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::Create():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Creates a framebuffer with a texture of the given size attached to it. Needs a
+//          current rendering context that supports framebuffer objects (see IsSupported()).
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLRenderTarget::Create(int nWidth, int nHeight, GLenum glFilter)
+{
+
+    if ((nWidth <= 0) || (nHeight <= 0))
+    {
+        return FALSE;
+    }
+
+    // Destroy target if created previously.
+    if (m_bIsReady)
+    {
+        this->Destroy();
+    }
+
+    if (!IsSupported())
+    {
+        GS_Error::Report("GS_OGL_RENDER_TARGET.CPP", 114, "Framebuffers are not supported!");
+        return FALSE;
+    }
+
+    GS_OGLState* pgsState = GS_OGLState::GetActive();
+
+    m_nWidth   = nWidth;
+    m_nHeight  = nHeight;
+    m_glFilter = glFilter;
+
+    // Create the texture everything is drawn to.
+    glGenTextures(1, &m_gluTexture);
+    pgsState->BindTexture(m_gluTexture);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_glFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_glFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_nWidth, m_nHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                 NULL);
+
+    pgsState->BindTexture(0);
+
+    // Attach the texture to a new framebuffer.
+    m_pfnGenFramebuffers(1, &m_gluFramebuffer);
+    m_pfnBindFramebuffer(GL_FRAMEBUFFER_EXT, m_gluFramebuffer);
+    m_pfnFramebufferTexture2D(GL_FRAMEBUFFER_EXT, GL_COLOR_ATTACHMENT0_EXT, GL_TEXTURE_2D,
+                              m_gluTexture, 0);
+
+    GLenum glStatus = m_pfnCheckFramebufferStatus(GL_FRAMEBUFFER_EXT);
+
+    m_pfnBindFramebuffer(GL_FRAMEBUFFER_EXT, 0);
+
+    m_bIsReady = TRUE;
+
+    // Can the driver draw to the texture?
+    if (glStatus != GL_FRAMEBUFFER_COMPLETE_EXT)
+    {
+        this->Destroy();
+        GS_Error::Report("GS_OGL_RENDER_TARGET.CPP", 154, "Failed to create framebuffer!");
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::Destroy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLRenderTarget::Destroy()
+{
+
+    if (!m_bIsReady)
+    {
+        return;
+    }
+
+    this->End();
+
+    if (m_gluFramebuffer != 0)
+    {
+        m_pfnDeleteFramebuffers(1, &m_gluFramebuffer);
+    }
+
+    if (m_gluTexture != 0)
+    {
+        glDeleteTextures(1, &m_gluTexture);
+        GS_OGLState::GetActive()->ReleaseTexture(m_gluTexture);
+    }
+
+    m_gluFramebuffer = 0;
+    m_gluTexture     = 0;
+
+    m_nWidth  = 0;
+    m_nHeight = 0;
+
+    m_bIsReady = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Render Methods //////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::Begin():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sends everything drawn from now on to the target. Setting up a viewport and
+//          projection the size of the target is left to the caller.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLRenderTarget::Begin()
+{
+
+    if (!m_bIsReady)
+    {
+        return FALSE;
+    }
+
+    m_pfnBindFramebuffer(GL_FRAMEBUFFER_EXT, m_gluFramebuffer);
+
+    // Keep the alpha channel as coverage so the target can be drawn over the screen.
+    GS_OGLState::GetActive()->SetBlendFuncSeparate(m_pfnBlendFuncSeparate);
+
+    m_bIsBound = TRUE;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::End():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sends everything drawn from now on to the screen again.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLRenderTarget::End()
+{
+
+    if (!m_bIsBound)
+    {
+        return;
+    }
+
+    m_pfnBindFramebuffer(GL_FRAMEBUFFER_EXT, 0);
+
+    GS_OGLState::GetActive()->SetBlendFuncSeparate(NULL);
+
+    m_bIsBound = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::Draw():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Draws the texture over the given rectangle (in the coordinates of the current
+//          projection) with premultiplied alpha blending, so only what was drawn to the target
+//          covers the screen.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLRenderTarget::Draw(const RECT& rcDest)
+{
+
+    if ((!m_bIsReady) || m_bIsBound)
+    {
+        return FALSE;
+    }
+
+    GS_OGLState* pgsState = GS_OGLState::GetActive();
+
+    // Save the state we are about to change.
+    BOOL bIsBlendingEnabled  = pgsState->IsEnabled(GL_BLEND);
+    BOOL bIsTexturingEnabled = pgsState->IsEnabled(GL_TEXTURE_2D);
+
+    GLenum glSourceFactor, glDestFactor;
+    pgsState->GetBlendFunc(&glSourceFactor, &glDestFactor);
+
+    pgsState->BlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    pgsState->Enable(GL_BLEND);
+    pgsState->Enable(GL_TEXTURE_2D);
+    pgsState->Color(1.0f, 1.0f, 1.0f, 1.0f);
+    pgsState->BindTexture(m_gluTexture);
+
+    glBegin(GL_QUADS);
+
+    // Bottom left texture coordinate and vertex.
+    glTexCoord2f(0.0f, 0.0f);
+    glVertex2f((GLfloat) rcDest.left, (GLfloat) rcDest.bottom);
+
+    // Bottom right texture coordinate and vertex.
+    glTexCoord2f(1.0f, 0.0f);
+    glVertex2f((GLfloat) rcDest.right, (GLfloat) rcDest.bottom);
+
+    // Top right texture coordinate and vertex.
+    glTexCoord2f(1.0f, 1.0f);
+    glVertex2f((GLfloat) rcDest.right, (GLfloat) rcDest.top);
+
+    // Top left texture coordinate and vertex.
+    glTexCoord2f(0.0f, 1.0f);
+    glVertex2f((GLfloat) rcDest.left, (GLfloat) rcDest.top);
+
+    glEnd();
+    GS_Profiler::CountDrawCall(4);
+
+    // Restore the state.
+    pgsState->BindTexture(0);
+    pgsState->BlendFunc(glSourceFactor, glDestFactor);
+    pgsState->SetEnabled(GL_BLEND, bIsBlendingEnabled);
+    pgsState->SetEnabled(GL_TEXTURE_2D, bIsTexturingEnabled);
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Get/Set Methods. ////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::SetFilter():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the filter used when the target is drawn at a different size, GL_NEAREST for
+//          sharp pixels or GL_LINEAR for smooth scaling.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLRenderTarget::SetFilter(GLenum glFilter)
+{
+
+    m_glFilter = glFilter;
+
+    if (!m_bIsReady)
+    {
+        return;
+    }
+
+    GS_OGLState::GetActive()->BindTexture(m_gluTexture);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_glFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_glFilter);
+
+    GS_OGLState::GetActive()->BindTexture(0);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::GetFilter():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The filter used when the target is drawn at a different size.
+//==============================================================================================
+
+GLenum GS_OGLRenderTarget::GetFilter()
+{
+
+    return m_glFilter;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::GetWidth():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The width of the target in pixels.
+//==============================================================================================
+
+int GS_OGLRenderTarget::GetWidth()
+{
+
+    return m_nWidth;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::GetHeight():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The height of the target in pixels.
+//==============================================================================================
+
+int GS_OGLRenderTarget::GetHeight()
+{
+
+    return m_nHeight;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::GetTextureID():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The texture attached to the target, 0 if there is none.
+//==============================================================================================
+
+GLuint GS_OGLRenderTarget::GetTextureID()
+{
+
+    return m_gluTexture;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::IsBound():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if drawing goes to the target, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLRenderTarget::IsBound()
+{
+
+    return m_bIsBound;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::IsReady():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the target has been created, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLRenderTarget::IsReady()
+{
+
+    return m_bIsReady;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::GetProc():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Looks up an OpenGL function by its core name and then by its extension name.
+// ---------------------------------------------------------------------------------------------
+// Returns: The address of the function, NULL if the driver doesn't have it.
+//==============================================================================================
+
+void* GS_OGLRenderTarget::GetProc(const char* pszName, const char* pszNameEXT)
+{
+
+    void* pProc;
+
+#ifdef GS_PLATFORM_WINDOWS
+    pProc = (void*) wglGetProcAddress(pszName);
+
+    if (NULL == pProc)
+    {
+        pProc = (void*) wglGetProcAddress(pszNameEXT);
+    }
+#else
+    pProc = SDL_GL_GetProcAddress(pszName);
+
+    if (NULL == pProc)
+    {
+        pProc = SDL_GL_GetProcAddress(pszNameEXT);
+    }
+#endif
+
+    return pProc;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::IsSupported():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Loads the framebuffer functions the first time it is called, which needs a current
+//          rendering context.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the driver supports framebuffer objects, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLRenderTarget::IsSupported()
+{
+
+    if (NULL == m_pfnBindFramebuffer)
+    {
+        m_pfnGenFramebuffers = (GS_PFNGENFRAMEBUFFERSPROC)
+            GetProc("glGenFramebuffers", "glGenFramebuffersEXT");
+        m_pfnDeleteFramebuffers = (GS_PFNDELETEFRAMEBUFFERSPROC)
+            GetProc("glDeleteFramebuffers", "glDeleteFramebuffersEXT");
+        m_pfnFramebufferTexture2D = (GS_PFNFRAMEBUFFERTEXTURE2DPROC)
+            GetProc("glFramebufferTexture2D", "glFramebufferTexture2DEXT");
+        m_pfnCheckFramebufferStatus = (GS_PFNCHECKFRAMEBUFFERSTATUSPROC)
+            GetProc("glCheckFramebufferStatus", "glCheckFramebufferStatusEXT");
+        m_pfnBlendFuncSeparate = (GS_PFNBLENDFUNCSEPARATEPROC)
+            GetProc("glBlendFuncSeparate", "glBlendFuncSeparateEXT");
+
+        // Loaded last, it tells us the functions above have been looked up.
+        m_pfnBindFramebuffer = (GS_PFNBINDFRAMEBUFFERPROC)
+            GetProc("glBindFramebuffer", "glBindFramebufferEXT");
+    }
+
+    return (m_pfnGenFramebuffers != NULL) && (m_pfnDeleteFramebuffers != NULL) &&
+           (m_pfnBindFramebuffer != NULL) && (m_pfnFramebufferTexture2D != NULL) &&
+           (m_pfnCheckFramebufferStatus != NULL);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
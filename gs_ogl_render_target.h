@@ -0,0 +1,137 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_render_target.cpp, gs_ogl_render_target.h                                    |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_OGLRenderTarget                                                                  |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: An offscreen framebuffer with a texture attached to it. Everything is drawn to the  |
+ |        target at a fixed resolution and the texture is then drawn to the screen once,      |
+ |        scaled with a selectable filter.                                                    |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+#ifndef GS_OGL_RENDER_TARGET_H
+#define GS_OGL_RENDER_TARGET_H
+
+
+//==============================================================================================
+// Include platform abstraction header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_platform.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include OpenGL header files.
+// ---------------------------------------------------------------------------------------------
+#ifdef __APPLE__
+    #include <OpenGL/gl.h>
+#else
+    #include <GL/gl.h>
+#endif
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_error.h"
+#include "gs_object.h"
+#include "gs_ogl_state.h"
+#include "gs_profiler.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Framebuffer object defines (GL_EXT_framebuffer_object, not in every gl.h).
+// ---------------------------------------------------------------------------------------------
+#ifndef GL_FRAMEBUFFER_EXT
+    #define GL_FRAMEBUFFER_EXT          0x8D40
+    #define GL_COLOR_ATTACHMENT0_EXT    0x8CE0
+    #define GL_FRAMEBUFFER_COMPLETE_EXT 0x8CD5
+#endif
+#ifndef GL_CLAMP_TO_EDGE
+    #define GL_CLAMP_TO_EDGE 0x812F
+#endif
+//==============================================================================================
+
+
+//==============================================================================================
+// Framebuffer object functions (loaded at run time).
+// ---------------------------------------------------------------------------------------------
+typedef void   (APIENTRY* GS_PFNGENFRAMEBUFFERSPROC)(GLsizei glsNum, GLuint* pgluFramebuffers);
+typedef void   (APIENTRY* GS_PFNDELETEFRAMEBUFFERSPROC)(GLsizei glsNum,
+                                                        const GLuint* pgluFramebuffers);
+typedef void   (APIENTRY* GS_PFNBINDFRAMEBUFFERPROC)(GLenum glTarget, GLuint gluFramebuffer);
+typedef void   (APIENTRY* GS_PFNFRAMEBUFFERTEXTURE2DPROC)(GLenum glTarget, GLenum glAttachment,
+                                                          GLenum glTexTarget, GLuint gluTexture,
+                                                          GLint gliLevel);
+typedef GLenum (APIENTRY* GS_PFNCHECKFRAMEBUFFERSTATUSPROC)(GLenum glTarget);
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_OGLRenderTarget : public GS_Object
+{
+
+private:
+
+    static GS_PFNGENFRAMEBUFFERSPROC        m_pfnGenFramebuffers;
+    static GS_PFNDELETEFRAMEBUFFERSPROC     m_pfnDeleteFramebuffers;
+    static GS_PFNBINDFRAMEBUFFERPROC        m_pfnBindFramebuffer;
+    static GS_PFNFRAMEBUFFERTEXTURE2DPROC   m_pfnFramebufferTexture2D;
+    static GS_PFNCHECKFRAMEBUFFERSTATUSPROC m_pfnCheckFramebufferStatus;
+    static GS_PFNBLENDFUNCSEPARATEPROC      m_pfnBlendFuncSeparate;
+
+    GLuint m_gluFramebuffer; // The framebuffer object.
+    GLuint m_gluTexture;     // The texture attached to the framebuffer.
+
+    int    m_nWidth;  // The size of the texture in pixels.
+    int    m_nHeight;
+    GLenum m_glFilter; // The filter the texture is scaled with when drawn.
+
+    BOOL m_bIsBound; // Wether drawing currently goes to the target.
+    BOOL m_bIsReady;
+
+    static void* GetProc(const char* pszName, const char* pszNameEXT);
+
+protected:
+
+    // No protected members.
+
+public:
+
+    GS_OGLRenderTarget();
+    ~GS_OGLRenderTarget();
+
+    BOOL Create(int nWidth, int nHeight, GLenum glFilter = GL_NEAREST);
+    void Destroy();
+
+    BOOL Begin();
+    void End();
+    BOOL Draw(const RECT& rcDest);
+
+    void   SetFilter(GLenum glFilter);
+    GLenum GetFilter();
+
+    int    GetWidth();
+    int    GetHeight();
+    GLuint GetTextureID();
+
+    BOOL IsBound();
+    BOOL IsReady();
+
+    static BOOL IsSupported();
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -15,12 +15,14 @@
 // Include Game System (GS) header files.
 // ---------------------------------------------------------------------------------------------
 #include "gs_ogl_sprite.h"
+#include "gs_ogl_state.h"
+#include "gs_math.h"
 //==============================================================================================
 
 
 //==============================================================================================
-// Global variables decaled in the gs_ogl_display.h file which effects upscaling or downscaling
-// without affecting the game mechanics
+// Global variables decaled in the gs_ogl_display.h file which map the render resolution to
+// window pixels (see GS_OGLDisplay::BeginRender2D())
 // ---------------------------------------------------------------------------------------------
 float g_fScaleFactorX;
 float g_fScaleFactorY;
@@ -46,7 +48,10 @@ GS_OGLSprite::GS_OGLSprite()
 {
 
     ZeroMemory(&m_SourceRect, sizeof(RECT));
+    ZeroMemory(&m_ImageRect, sizeof(RECT));
 
+    m_pSharedTexture = NULL;
+    m_pSharedCache   = NULL;
     m_gluTexture = 0;
 
     m_bIsReady = FALSE;
@@ -77,6 +82,17 @@ GS_OGLSprite::GS_OGLSprite()
     m_gsModulateColor.fGreen = 1.0f;
     m_gsModulateColor.fBlue  = 1.0f;
     m_gsModulateColor.fAlpha = 1.0f;
+
+    m_bIsInterpolated  = FALSE;
+    m_glfInterpolation = 1.0f;
+
+    m_gliPrevDestX   = 0;
+    m_gliPrevDestY   = 0;
+    m_glfPrevRotateX = 0.0f;
+    m_glfPrevRotateY = 0.0f;
+    m_glfPrevRotateZ = 0.0f;
+    m_glfPrevScaleX  = 1.0f;
+    m_glfPrevScaleY  = 1.0f;
 }
 
 
@@ -135,51 +151,49 @@ BOOL GS_OGLSprite::Create(const char* pszPathname, BOOL bFiltered, BOOL bMipmap)
         this->Destroy();
     }
 
-    BOOL bResult;
+    // Use the image in the active texture atlas if it is in there, as long as the atlas pages
+    // are filtered the way we want (they are never mipmapped).
+    GS_AtlasRegion gsRegion;
 
-    // Should the texture we create be filtered or not?
-    if (bFiltered)
+    if ((GS_TextureAtlas::GetActive() != NULL) &&
+        GS_TextureAtlas::GetActive()->GetRegion(pszPathname, &gsRegion) &&
+        (!bMipmap) && ((!bFiltered) == (!gsRegion.bFiltered)))
     {
-        // Should texture be a mipmap?
-        if (bMipmap)
-        {
-            // Create a filtered mipmap sprite texture from the specified file.
-            bResult = m_gsTexture.Create(pszPathname, GS_MIPMAP, GL_LINEAR, GL_LINEAR);
-        }
-        else
-        {
-            // Create a filtered sprite texture from the specified file.
-            bResult = m_gsTexture.Create(pszPathname, GS_IMAGE2D, GL_LINEAR, GL_LINEAR);
-        }
+        return this->Create(&gsRegion);
     }
-    else
+
+    GS_TextureType gsTextureType = bMipmap ? GS_MIPMAP : GS_IMAGE2D;
+    GLint glFilter = bFiltered ? GL_LINEAR : GL_NEAREST;
+
+    GS_OGLTexture* pTexture = &m_gsTexture;
+
+    // Share the texture with other objects created from the same file if there is a texture
+    // cache, otherwise create a texture of our own.
+    if (GS_TextureCache::GetActive() != NULL)
     {
-        // Should texture be a mipmap?
-        if (bMipmap)
-        {
-            // Create an unfiltered mipmap sprite texture from the specified file.
-            bResult = m_gsTexture.Create(pszPathname, GS_MIPMAP, GL_NEAREST, GL_NEAREST);
-        }
-        else
-        {
-            // Create an unfiltered sprite texture from the specified file.
-            bResult = m_gsTexture.Create(pszPathname, GS_IMAGE2D, GL_NEAREST, GL_NEAREST);
-        }
+        m_pSharedCache   = GS_TextureCache::GetActive();
+        m_pSharedTexture = m_pSharedCache->Acquire(pszPathname, gsTextureType, glFilter,
+                                                   glFilter);
+        pTexture = m_pSharedTexture;
+    }
+    else if (!m_gsTexture.Create(pszPathname, gsTextureType, glFilter, glFilter))
+    {
+        pTexture = NULL;
     }
 
     // Were we able to create the sprite texture?
-    if (!bResult)
+    if (NULL == pTexture)
     {
-        GS_Error::Report("GS_OGL_SPRITE.CPP", 147, "Failed to create sprite texture!");
+        GS_Error::Report("GS_OGL_SPRITE.CPP", 170, "Failed to create sprite texture!");
         return FALSE;
     }
 
     // Remember the texture ID.
-    m_gluTexture = m_gsTexture.GetID();
+    m_gluTexture = pTexture->GetID();
 
     // Determine the actual dimensions of the sprite.
-    m_gliWidth  = m_gsTexture.GetWidth();
-    m_gliHeight = m_gsTexture.GetHeight();
+    m_gliWidth  = pTexture->GetWidth();
+    m_gliHeight = pTexture->GetHeight();
 
     // Set source rectangle to texture size.
     m_SourceRect.left   = 0;
@@ -187,6 +201,9 @@ BOOL GS_OGLSprite::Create(const char* pszPathname, BOOL bFiltered, BOOL bMipmap)
     m_SourceRect.right  = m_gliWidth;
     m_SourceRect.top    = m_gliHeight;
 
+    // The image fills the entire texture.
+    m_ImageRect = m_SourceRect;
+
     m_bIsReady = TRUE;
 
     return TRUE;
@@ -229,12 +246,47 @@ BOOL GS_OGLSprite::Create(GLuint glTexture, int nWidth, int nHeight)
     m_SourceRect.right  = nWidth;
     m_SourceRect.top    = nHeight;
 
+    // The image fills the entire texture.
+    m_ImageRect = m_SourceRect;
+
     m_bIsReady = TRUE;
 
     return TRUE;
 }
 
 
+//==============================================================================================
+// GS_OGLSprite::Create():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Creates the sprite from an image packed into a texture atlas page. The source
+//          rectangle (and the frames of sprite ex objects, fonts and maps) is relative to the
+//          page, so sprites on the same page can be batched together.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLSprite::Create(GS_AtlasRegion* pRegion)
+{
+
+    // Can't create sprite if no valid region.
+    if (!pRegion)
+    {
+        return FALSE;
+    }
+
+    if (!this->Create(pRegion->gluTexture, pRegion->nPageWidth, pRegion->nPageHeight))
+    {
+        return FALSE;
+    }
+
+    // Only show the part of the page holding the image.
+    m_SourceRect = pRegion->ImageRect;
+    m_ImageRect  = pRegion->ImageRect;
+
+    return TRUE;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -259,7 +311,17 @@ void GS_OGLSprite::Destroy()
         m_gsTexture.Destroy();
     }
 
+    // Let go of the shared texture through the cache it came from.
+    if ((m_pSharedTexture != NULL) && (m_pSharedCache != NULL))
+    {
+        m_pSharedCache->Release(m_pSharedTexture);
+    }
+
+    m_pSharedTexture = NULL;
+    m_pSharedCache   = NULL;
+
     ZeroMemory(&m_SourceRect, sizeof(RECT));
+    ZeroMemory(&m_ImageRect, sizeof(RECT));
 
     m_gluTexture = 0;
 
@@ -324,10 +386,12 @@ BOOL GS_OGLSprite::BeginRender(HWND hWnd)
     GS_Platform::GetClientRect(hWnd, &ClientRect);
 #endif
 
+    GS_OGLState* pgsState = GS_OGLState::GetActive();
+
     // Disable depth testing if enabled.
-    if (glIsEnabled(GL_DEPTH_TEST) == GL_TRUE)
+    if (pgsState->IsEnabled(GL_DEPTH_TEST))
     {
-        glDisable(GL_DEPTH_TEST);
+        pgsState->Disable(GL_DEPTH_TEST);
         m_bDepthTestEnabled = TRUE;
     }
     else
@@ -336,9 +400,9 @@ BOOL GS_OGLSprite::BeginRender(HWND hWnd)
     }
 
     // Disable lighting if enabled.
-    if (glIsEnabled(GL_LIGHTING) == GL_TRUE)
+    if (pgsState->IsEnabled(GL_LIGHTING))
     {
-        glDisable(GL_LIGHTING);
+        pgsState->Disable(GL_LIGHTING);
         m_bLightingEnabled = TRUE;
     }
     else
@@ -385,6 +449,11 @@ BOOL GS_OGLSprite::BeginRender(HWND hWnd)
 void GS_OGLSprite::EndRender()
 {
 
+    GS_OGLState* pgsState = GS_OGLState::GetActive();
+
+    // Leave no texture selected and the color white for code drawing without the renderers.
+    pgsState->Reset();
+
     glMatrixMode(GL_PROJECTION); // Select the projection matrix.
     glPopMatrix();               // Restore the old projection matrix.
     glMatrixMode(GL_MODELVIEW);  // Select the modelview matrix.
@@ -393,13 +462,13 @@ void GS_OGLSprite::EndRender()
     // Was depth testing enabled?
     if (m_bDepthTestEnabled == TRUE)
     {
-        glEnable(GL_DEPTH_TEST);
+        pgsState->Enable(GL_DEPTH_TEST);
     }
 
     // Was lighting enabled?
     if (m_bLightingEnabled == TRUE)
     {
-        glEnable(GL_LIGHTING);
+        pgsState->Enable(GL_LIGHTING);
     }
 }
 
@@ -423,33 +492,40 @@ BOOL GS_OGLSprite::Render(HWND hWnd)
         return FALSE;
     }
 
+    // Is a sprite batch collecting draws? Rendering with our own 2D setup (hWnd) can't be
+    // batched, so draw whatever the batch has queued so far and render immediately.
+    GS_SpriteBatch* pBatch = GS_SpriteBatch::GetActive();
+
     // Setup display for 2D rendering.
     if (hWnd != NULL)
     {
+        GS_SpriteBatch::FlushActive();
+        pBatch = NULL;
         this->BeginRender(hWnd);
     }
 
-    // Adjust the default scale and coordinates by the scale factor (this causes upscaling or
-    // downscaling without affecting the actual game mechanics)
-    GLfloat glfScaleX = m_glfScaleX * g_fScaleFactorX;
-    GLfloat glfScaleY = m_glfScaleY * g_fScaleFactorY;
-    GLfloat glfDestX = m_gliDestX * g_fScaleFactorX;
-    GLfloat glfDestY = m_gliDestY * g_fScaleFactorY;
-
-    // Reset the modelview matrix.
-    glLoadIdentity();
-
-    // Draw sprite in a different hue or even with transparency depending on the alpha factor.
-    glColor4f
-    (
-        m_gsModulateColor.fRed,
-        m_gsModulateColor.fGreen,
-        m_gsModulateColor.fBlue,
-        m_gsModulateColor.fAlpha
-    );
-
-    // Select the sprite texture.
-    glBindTexture(GL_TEXTURE_2D, m_gluTexture);
+    GLfloat glfDestX   = (GLfloat) m_gliDestX;
+    GLfloat glfDestY   = (GLfloat) m_gliDestY;
+    GLfloat glfScaleX  = m_glfScaleX;
+    GLfloat glfScaleY  = m_glfScaleY;
+    GLfloat glfRotateX = m_glfRotateX;
+    GLfloat glfRotateY = m_glfRotateY;
+    GLfloat glfRotateZ = m_glfRotateZ;
+
+    // Blend from the previous transform to the current one when rendering between two fixed
+    // simulation steps.
+    if (m_bIsInterpolated && m_glfInterpolation < 1.0f)
+    {
+        GLfloat glfT = m_glfInterpolation;
+
+        glfDestX   = GS_Lerp((GLfloat) m_gliPrevDestX, glfDestX, glfT);
+        glfDestY   = GS_Lerp((GLfloat) m_gliPrevDestY, glfDestY, glfT);
+        glfScaleX  = GS_Lerp(m_glfPrevScaleX, glfScaleX, glfT);
+        glfScaleY  = GS_Lerp(m_glfPrevScaleY, glfScaleY, glfT);
+        glfRotateX = GS_LerpAngle(m_glfPrevRotateX, glfRotateX, glfT);
+        glfRotateY = GS_LerpAngle(m_glfPrevRotateY, glfRotateY, glfT);
+        glfRotateZ = GS_LerpAngle(m_glfPrevRotateZ, glfRotateZ, glfT);
+    }
 
     // Set default rotation point in the center of the source rectangle
     int nRotationPointX = (float((m_SourceRect.right-m_SourceRect.left))/2);
@@ -473,14 +549,6 @@ BOOL GS_OGLSprite::Render(HWND hWnd)
     float fVertexHeight1 = float((nRotationPointY) * glfScaleY);
     float fVertexHeight2 = float((m_SourceRect.top - m_SourceRect.bottom - nRotationPointY) * glfScaleY);
 
-    // Position the sprite (note that the sprite will be drawn around the rotation point).
-    glTranslated(glfDestX + g_fRenderModX + fVertexWidth1, glfDestY + g_fRenderModY + fVertexHeight1, 0);
-
-    // Rotate the sprite on the X, Y and Z-axis.
-    glRotatef(m_glfRotateX, 1.0f, 0.0f, 0.0f);
-    glRotatef(m_glfRotateY, 0.0f, 1.0f, 0.0f);
-    glRotatef(m_glfRotateZ, 0.0f, 0.0f, 1.0f);
-
     // Determine the sprite dimensions as a factor of one, taking into account the coordinates
     // of the source rectangle as well as how far the sprite is scrolled on the x- or y-axis.
     float fLeft   = (1.0f / (float)m_gliWidth)  * (m_SourceRect.left   + m_glfScrollX);
@@ -488,6 +556,56 @@ BOOL GS_OGLSprite::Render(HWND hWnd)
     float fRight  = (1.0f / (float)m_gliWidth)  * (m_SourceRect.right  + m_glfScrollX);
     float fTop    = (1.0f / (float)m_gliHeight) * (m_SourceRect.top    + m_glfScrollY);
 
+    // Queue the sprite if a batch is collecting draws, it will transform the quad itself.
+    if (pBatch != NULL)
+    {
+        GS_BatchSprite gsQuad;
+
+        gsQuad.gluTexture = m_gluTexture;
+        gsQuad.fPosX      = glfDestX + fVertexWidth1;
+        gsQuad.fPosY      = glfDestY + fVertexHeight1;
+        gsQuad.fLeft      = -fVertexWidth1;
+        gsQuad.fBottom    = -fVertexHeight1;
+        gsQuad.fRight     =  fVertexWidth2;
+        gsQuad.fTop       =  fVertexHeight2;
+        gsQuad.fRotateX   = glfRotateX;
+        gsQuad.fRotateY   = glfRotateY;
+        gsQuad.fRotateZ   = glfRotateZ;
+        gsQuad.fTexLeft   = fLeft;
+        gsQuad.fTexBottom = fBottom;
+        gsQuad.fTexRight  = fRight;
+        gsQuad.fTexTop    = fTop;
+        gsQuad.gsColor    = m_gsModulateColor;
+
+        return pBatch->AddSprite(&gsQuad);
+    }
+
+    // Reset the modelview matrix.
+    glLoadIdentity();
+
+    GS_OGLState* pgsState = GS_OGLState::GetActive();
+
+    // Draw sprite in a different hue or even with transparency depending on the alpha factor.
+    pgsState->Color
+    (
+        m_gsModulateColor.fRed,
+        m_gsModulateColor.fGreen,
+        m_gsModulateColor.fBlue,
+        m_gsModulateColor.fAlpha
+    );
+
+    // Select the sprite texture (the texture and color are left for the next sprite, they are
+    // reset once 2D rendering ends).
+    pgsState->BindTexture(m_gluTexture);
+
+    // Position the sprite (note that the sprite will be drawn around the rotation point).
+    glTranslated(glfDestX + fVertexWidth1, glfDestY + fVertexHeight1, 0);
+
+    // Rotate the sprite on the X, Y and Z-axis.
+    glRotatef(glfRotateX, 1.0f, 0.0f, 0.0f);
+    glRotatef(glfRotateY, 0.0f, 1.0f, 0.0f);
+    glRotatef(glfRotateZ, 0.0f, 0.0f, 1.0f);
+
     // Start drawing a quad. In order for the sprite to be rotated correctly, the sprite has to
     // be drawn from the rotation point outwards.
     glBegin(GL_QUADS);
@@ -509,12 +627,7 @@ BOOL GS_OGLSprite::Render(HWND hWnd)
     glVertex2f(-fVertexWidth1,  fVertexHeight2);
 
     glEnd();
-
-    // Unselect the sprite texture.
-    glBindTexture(GL_TEXTURE_2D, 0);  // Use 0 instead of NULL
-
-    // Reset the color for other textures to white.
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+    GS_Profiler::CountDrawCall(4);
 
     // Reset display after 2D rendering.
     if (hWnd != NULL)
@@ -547,21 +660,19 @@ BOOL GS_OGLSprite::RenderTiles(RECT rcTileArea, BOOL bWrapAround, HWND hWnd)
         return FALSE;
     }
 
+    // Tiles are queued if a sprite batch is collecting draws (see GS_OGLSprite::Render()).
+    GS_SpriteBatch* pBatch = GS_SpriteBatch::GetActive();
+
     // Setup display for 2D rendering.
     if (hWnd != NULL)
     {
+        GS_SpriteBatch::FlushActive();
+        pBatch = NULL;
         this->BeginRender(hWnd);
     }
 
-    // Adjust the default scale and coordinates by the scale factor (this causes upscaling or
-    // downscaling without affecting the actual game mechanics)
-    GLfloat glfScaleX = m_glfScaleX * g_fScaleFactorX;
-    GLfloat glfScaleY = m_glfScaleY * g_fScaleFactorY;
-
-    rcTileArea.left   = rcTileArea.left * g_fScaleFactorX; //  + g_fRenderModX;
-    rcTileArea.top    = rcTileArea.top * g_fScaleFactorY;  // + g_fRenderModY;
-    rcTileArea.right  = rcTileArea.right * g_fScaleFactorX; //  + g_fRenderModX;
-    rcTileArea.bottom = rcTileArea.bottom * g_fScaleFactorY; // + g_fRenderModY;
+    GLfloat glfScaleX = m_glfScaleX;
+    GLfloat glfScaleY = m_glfScaleY;
 
     // Determine the width and height of the tile sprite.
     int nTileWidth  = (m_SourceRect.right-m_SourceRect.left) * glfScaleX;
@@ -570,30 +681,37 @@ BOOL GS_OGLSprite::RenderTiles(RECT rcTileArea, BOOL bWrapAround, HWND hWnd)
     // Should we clip the tiles to the dest area?
     if (bWrapAround)
     {
-        // Create a scissor box that will automatically clip any rendering to fit.
-        glScissor
+        // Quads queued before the tiles must not be clipped.
+        GS_SpriteBatch::FlushActive();
+
+        // Create a scissor box that will automatically clip any rendering to fit (the scissor
+        // box is in window pixels, see GS_OGLDisplay::BeginRender2D()).
+        GS_OGLState::GetActive()->Scissor
         (
-            rcTileArea.left,
-            rcTileArea.bottom,
-            rcTileArea.right - rcTileArea.left,
-            rcTileArea.top - rcTileArea.bottom
+            rcTileArea.left * g_fScaleFactorX + g_fRenderModX,
+            rcTileArea.bottom * g_fScaleFactorY + g_fRenderModY,
+            (rcTileArea.right - rcTileArea.left) * g_fScaleFactorX,
+            (rcTileArea.top - rcTileArea.bottom) * g_fScaleFactorY
         );
 
         // Enable the scissor box.
-        glEnable(GL_SCISSOR_TEST);
+        GS_OGLState::GetActive()->Enable(GL_SCISSOR_TEST);
     }
 
-    // Draw sprite in a different hue or even with transparency depending on the alpha factor.
-    glColor4f
-    (
-        m_gsModulateColor.fRed,
-        m_gsModulateColor.fGreen,
-        m_gsModulateColor.fBlue,
-        m_gsModulateColor.fAlpha
-    );
+    if (NULL == pBatch)
+    {
+        // Draw sprite in a different hue or even with transparency depending on the alpha factor.
+        GS_OGLState::GetActive()->Color
+        (
+            m_gsModulateColor.fRed,
+            m_gsModulateColor.fGreen,
+            m_gsModulateColor.fBlue,
+            m_gsModulateColor.fAlpha
+        );
 
-    // Select the sprite texture.
-    glBindTexture(GL_TEXTURE_2D, m_gluTexture);
+        // Select the sprite texture.
+        GS_OGLState::GetActive()->BindTexture(m_gluTexture);
+    }
 
     // Determine the scaled sprite dimensions and divide by two to take into account that the
     // sprite is drawn from the center outwards.
@@ -605,26 +723,51 @@ BOOL GS_OGLSprite::RenderTiles(RECT rcTileArea, BOOL bWrapAround, HWND hWnd)
     {
         for (int nDestX = rcTileArea.left; nDestX < (int)rcTileArea.right; nDestX+= nTileWidth)
         {
+            // Determine the sprite dimensions as a factor of one, taking into account the coords
+            // of the source rectangle as well as how far the sprite is scrolled.
+            float fLeft   = (1.0f / (float)m_gliWidth)  * (m_SourceRect.left   + m_glfScrollX);
+            float fBottom = (1.0f / (float)m_gliHeight) * (m_SourceRect.bottom + m_glfScrollY);
+            float fRight  = (1.0f / (float)m_gliWidth)  * (m_SourceRect.right  + m_glfScrollX);
+            float fTop    = (1.0f / (float)m_gliHeight) * (m_SourceRect.top    + m_glfScrollY);
+
+            // Queue the tile if a batch is collecting draws.
+            if (pBatch != NULL)
+            {
+                GS_BatchSprite gsQuad;
+
+                gsQuad.gluTexture = m_gluTexture;
+                gsQuad.fPosX      = nDestX + fHalfWidth;
+                gsQuad.fPosY      = nDestY + fHalfHeight;
+                gsQuad.fLeft      = -fHalfWidth;
+                gsQuad.fBottom    = -fHalfHeight;
+                gsQuad.fRight     =  fHalfWidth;
+                gsQuad.fTop       =  fHalfHeight;
+                gsQuad.fRotateX   = m_glfRotateX;
+                gsQuad.fRotateY   = m_glfRotateY;
+                gsQuad.fRotateZ   = m_glfRotateZ;
+                gsQuad.fTexLeft   = fLeft;
+                gsQuad.fTexBottom = fBottom;
+                gsQuad.fTexRight  = fRight;
+                gsQuad.fTexTop    = fTop;
+                gsQuad.gsColor    = m_gsModulateColor;
+
+                pBatch->AddSprite(&gsQuad);
+                continue;
+            }
+
             // Reset the modelview matrix.
             glLoadIdentity();
 
             // Position the sprite (the coordinates (0,0) is the bottom left corner of the screen).
             // Because the sprite is actually positioned from the center, some adjustments have to
             // be made for the sprite to be postioned by the bottom left corner.
-            glTranslated(nDestX + g_fRenderModX + fHalfWidth, nDestY + g_fRenderModY + fHalfHeight, 0);
+            glTranslated(nDestX + fHalfWidth, nDestY + fHalfHeight, 0);
 
             // Rotate the sprite on the X, Y and Z-axis.
             glRotatef(m_glfRotateX, 1.0f, 0.0f, 0.0f);
             glRotatef(m_glfRotateY, 0.0f, 1.0f, 0.0f);
             glRotatef(m_glfRotateZ, 0.0f, 0.0f, 1.0f);
 
-            // Determine the sprite dimensions as a factor of one, taking into account the coords
-            // of the source rectangle as well as how far the sprite is scrolled.
-            float fLeft   = (1.0f / (float)m_gliWidth)  * (m_SourceRect.left   + m_glfScrollX);
-            float fBottom = (1.0f / (float)m_gliHeight) * (m_SourceRect.bottom + m_glfScrollY);
-            float fRight  = (1.0f / (float)m_gliWidth)  * (m_SourceRect.right  + m_glfScrollX);
-            float fTop    = (1.0f / (float)m_gliHeight) * (m_SourceRect.top    + m_glfScrollY);
-
             // Start drawing a quad. In order for it to be rotated correctly, the sprite has to
             // be drawn from a center point outwards. If the center of the sprite is (0,0) then the
             // bottom left corner of the sprite is (0-(sprite width/2),0-(sprite height/2)), the
@@ -650,20 +793,18 @@ BOOL GS_OGLSprite::RenderTiles(RECT rcTileArea, BOOL bWrapAround, HWND hWnd)
             glVertex2f(-fHalfWidth,  fHalfHeight);
 
             glEnd();
+            GS_Profiler::CountDrawCall(4);
         }
     }
 
-    // Unselect the sprite texture.
-    glBindTexture(GL_TEXTURE_2D, 0);  // Use 0 instead of NULL
-
-    // Reset the color for other textures to white.
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-
     // Was clipping enabled?
     if (bWrapAround)
     {
+        // The queued tiles must be drawn while the scissor box is still in place.
+        GS_SpriteBatch::FlushActive();
+
         // Disable the scissor box.
-        glDisable(GL_SCISSOR_TEST);
+        GS_OGLState::GetActive()->Disable(GL_SCISSOR_TEST);
     }
 
     // Reset display after 2D rendering.
@@ -700,62 +841,96 @@ BOOL GS_OGLSprite::RenderTargets(int nNumTargets, GS_RenderTarget* pgsTargets, H
         return FALSE;
     }
 
+    // Targets are queued if a sprite batch is collecting draws (see GS_OGLSprite::Render()).
+    GS_SpriteBatch* pBatch = GS_SpriteBatch::GetActive();
+
     // Setup display for 2D rendering.
     if (hWnd != NULL)
     {
+        GS_SpriteBatch::FlushActive();
+        pBatch = NULL;
         this->BeginRender(hWnd);
     }
 
     float fHalfWidth, fHalfHeight, fLeft, fBottom, fRight, fTop;
 
+    GS_OGLState* pgsState = GS_OGLState::GetActive();
+
     // Select the sprite texture.
-    glBindTexture(GL_TEXTURE_2D, m_gluTexture);
+    if (NULL == pBatch)
+    {
+        pgsState->BindTexture(m_gluTexture);
+    }
 
     // Start rendering multipile objects.
     for (int nLoop = 0; nLoop < nNumTargets; nLoop++)
     {
-        // Adjust the default scale and coordinates by the scale factor (this causes
-        // upscaling or downscaling without affecting the actual game mechanics)
-        glfScaleX = pgsTargets[nLoop].fScaleX * g_fScaleFactorX;
-        glfScaleY = pgsTargets[nLoop].fScaleY * g_fScaleFactorY;
-        glfDestX = pgsTargets[nLoop].nDestX * g_fScaleFactorX;
-        glfDestY = pgsTargets[nLoop].nDestY * g_fScaleFactorY;
+        glfScaleX = pgsTargets[nLoop].fScaleX;
+        glfScaleY = pgsTargets[nLoop].fScaleY;
+        glfDestX  = pgsTargets[nLoop].nDestX;
+        glfDestY  = pgsTargets[nLoop].nDestY;
 
         RECT rcDestRect;
-        rcDestRect.left   = pgsTargets[nLoop].nSrcLeft * g_fScaleFactorX;
-        rcDestRect.top    = pgsTargets[nLoop].nSrcTop * g_fScaleFactorY;
-        rcDestRect.right  = pgsTargets[nLoop].nSrcRight * g_fScaleFactorX;
-        rcDestRect.bottom = pgsTargets[nLoop].nSrcBottom * g_fScaleFactorY;
-
-        // Reset the modelview matrix.
-        glLoadIdentity();
-
-        // Draw sprite in a different hue or even with transparency depending on the alpha factor.
-        glColor4f(pgsTargets[nLoop].fRed, pgsTargets[nLoop].fGreen, pgsTargets[nLoop].fBlue,
-                  pgsTargets[nLoop].fAlpha);
+        rcDestRect.left   = pgsTargets[nLoop].nSrcLeft;
+        rcDestRect.top    = pgsTargets[nLoop].nSrcTop;
+        rcDestRect.right  = pgsTargets[nLoop].nSrcRight;
+        rcDestRect.bottom = pgsTargets[nLoop].nSrcBottom;
 
         // Determine the scaled sprite dimensions and divide by two to take into account that the
         // sprite is drawn from the center outwards.
         fHalfWidth  = (float((rcDestRect.right-rcDestRect.left))/2) * glfScaleX;
         fHalfHeight = (float((rcDestRect.top-rcDestRect.bottom))/2) * glfScaleY;
 
+        // Determine the sprite dimensions as a factor of one, taking into account the coordinates
+        // of the source rectangle as well as how far the sprite is scrolled on the x- or y-axis.
+        fLeft   = (1.0f / (float)m_gliWidth) * (rcDestRect.left + pgsTargets[nLoop].fScrollX);
+        fBottom = (1.0f / (float)m_gliHeight) * (rcDestRect.bottom + pgsTargets[nLoop].fScrollY);
+        fRight  = (1.0f / (float)m_gliWidth) * (rcDestRect.right + pgsTargets[nLoop].fScrollX);
+        fTop    = (1.0f / (float)m_gliHeight) * (rcDestRect.top + pgsTargets[nLoop].fScrollY);
+
+        // Queue the target if a batch is collecting draws.
+        if (pBatch != NULL)
+        {
+            GS_BatchSprite gsQuad;
+
+            gsQuad.gluTexture = m_gluTexture;
+            gsQuad.fPosX      = glfDestX + fHalfWidth;
+            gsQuad.fPosY      = glfDestY + fHalfHeight;
+            gsQuad.fLeft      = -fHalfWidth;
+            gsQuad.fBottom    = -fHalfHeight;
+            gsQuad.fRight     =  fHalfWidth;
+            gsQuad.fTop       =  fHalfHeight;
+            gsQuad.fRotateX   = pgsTargets[nLoop].fRotateX;
+            gsQuad.fRotateY   = pgsTargets[nLoop].fRotateY;
+            gsQuad.fRotateZ   = pgsTargets[nLoop].fRotateZ;
+            gsQuad.fTexLeft   = fLeft;
+            gsQuad.fTexBottom = fBottom;
+            gsQuad.fTexRight  = fRight;
+            gsQuad.fTexTop    = fTop;
+            gsQuad.gsColor    = GS_OGLColor(pgsTargets[nLoop].fRed, pgsTargets[nLoop].fGreen,
+                                            pgsTargets[nLoop].fBlue, pgsTargets[nLoop].fAlpha);
+
+            pBatch->AddSprite(&gsQuad);
+            continue;
+        }
+
+        // Reset the modelview matrix.
+        glLoadIdentity();
+
+        // Draw sprite in a different hue or even with transparency depending on the alpha factor.
+        pgsState->Color(pgsTargets[nLoop].fRed, pgsTargets[nLoop].fGreen,
+                        pgsTargets[nLoop].fBlue, pgsTargets[nLoop].fAlpha);
+
         // Position the sprite (the coordinates (0,0) is the bottom left corner of the screen).
         // Because the sprite is actually positioned from the center, some adjustments have to
         // be made for the sprite to be postioned by the bottom left corner.
-        glTranslated(glfDestX + g_fRenderModX + fHalfWidth, glfDestY + g_fRenderModY + fHalfHeight, 0);
+        glTranslated(glfDestX + fHalfWidth, glfDestY + fHalfHeight, 0);
 
         // Rotate the sprite on the X, Y and Z-axis.
         glRotatef(pgsTargets[nLoop].fRotateX, 1.0f, 0.0f, 0.0f);
         glRotatef(pgsTargets[nLoop].fRotateY, 0.0f, 1.0f, 0.0f);
         glRotatef(pgsTargets[nLoop].fRotateZ, 0.0f, 0.0f, 1.0f);
 
-        // Determine the sprite dimensions as a factor of one, taking into account the coordinates
-        // of the source rectangle as well as how far the sprite is scrolled on the x- or y-axis.
-        fLeft   = (1.0f / (float)m_gliWidth) * (rcDestRect.left + pgsTargets[nLoop].fScrollX);
-        fBottom = (1.0f / (float)m_gliHeight) * (rcDestRect.bottom + pgsTargets[nLoop].fScrollY);
-        fRight  = (1.0f / (float)m_gliWidth) * (rcDestRect.right + pgsTargets[nLoop].fScrollX);
-        fTop    = (1.0f / (float)m_gliHeight) * (rcDestRect.top + pgsTargets[nLoop].fScrollY);
-
         // Start drawing a quad. In order for the sprite to be rotated correctly, the sprite has to
         // be drawn from a center point outwards. If the center of the sprite is (0, 0) then the
         // bottom left corner of the sprite is (0 - (sprite width / 2), 0 - (sprite height/2)), the
@@ -780,14 +955,9 @@ BOOL GS_OGLSprite::RenderTargets(int nNumTargets, GS_RenderTarget* pgsTargets, H
         glTexCoord2f(fLeft,  fTop   );
         glVertex2f(-fHalfWidth,  fHalfHeight);
         glEnd();
+        GS_Profiler::CountDrawCall(4);
     }
 
-    // Unselect the sprite texture.
-    glBindTexture(GL_TEXTURE_2D, 0);  // Use 0 instead of NULL
-
-    // Reset the color for other textures to white.
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-
     // Reset display after 2D rendering.
     if (hWnd != NULL)
     {
@@ -819,6 +989,69 @@ BOOL GS_OGLSprite::IsReady()
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Interpolation Methods. //////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSprite::SaveTransform():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Saves the position, rotation and scale of the sprite as its previous transform.
+//          Call it at the start of each fixed simulation step, before moving the sprite, and
+//          again after moving it somewhere it shouldn't appear to travel to (a teleport).
+//          Render() then draws the sprite between the previous and the current transform, as
+//          set by SetInterpolation().
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLSprite::SaveTransform()
+{
+
+    m_bIsInterpolated = TRUE;
+
+    m_gliPrevDestX   = m_gliDestX;
+    m_gliPrevDestY   = m_gliDestY;
+    m_glfPrevRotateX = m_glfRotateX;
+    m_glfPrevRotateY = m_glfRotateY;
+    m_glfPrevRotateZ = m_glfRotateZ;
+    m_glfPrevScaleX  = m_glfScaleX;
+    m_glfPrevScaleY  = m_glfScaleY;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSprite::SetInterpolation():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets how far between the previous transform (0.0) and the current transform (1.0)
+//          Render() draws the sprite, normally GS_Application::GetInterpolation().
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLSprite::SetInterpolation(GLfloat glfInterpolation)
+{
+
+    if (glfInterpolation < 0.0f)
+    {
+        glfInterpolation = 0.0f;
+    }
+    else if (glfInterpolation > 1.0f)
+    {
+        glfInterpolation = 1.0f;
+    }
+
+    m_glfInterpolation = glfInterpolation;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Add Methods. ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1565,6 +1798,46 @@ GLint GS_OGLSprite::GetTextureHeight()
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+//==============================================================================================
+// GS_OGLSprite::GetImageRect():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Retrieves the part of the texture holding the sprite image, which is the entire
+//          texture unless the sprite was created from a texture atlas.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLSprite::GetImageRect(RECT* pImageRect)
+{
+
+    if (pImageRect)
+    {
+        *pImageRect = m_ImageRect;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSprite::GetTextureID():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The ID of the OpenGL texture used by the sprite.
+//==============================================================================================
+
+GLuint GS_OGLSprite::GetTextureID()
+{
+
+    return m_gluTexture;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
 // GS_OGLSprite::GetScaledWidth():
 // ---------------------------------------------------------------------------------------------
@@ -40,7 +40,10 @@
 // ---------------------------------------------------------------------------------------------
 #include "gs_error.h"
 #include "gs_ogl_texture.h"
+#include "gs_ogl_texture_cache.h"
+#include "gs_ogl_texture_atlas.h"
 #include "gs_ogl_color.h"
+#include "gs_ogl_sprite_batch.h"
 //==============================================================================================
 
 
@@ -101,9 +104,13 @@ class GS_OGLSprite : public GS_Object
 private:
 
     GS_OGLTexture m_gsTexture;  // The texture surface holding the sprite image.
+    GS_OGLTexture* m_pSharedTexture; // The texture if it is shared through a texture cache.
+    GS_TextureCache* m_pSharedCache; // The cache the shared texture was acquired from.
     GLuint m_gluTexture;        // The texture surface holding the sprite image.
 
     RECT m_SourceRect; // The source rectangle containing the sprite.
+    RECT m_ImageRect;  // The part of the texture holding the sprite image (all of it, unless
+                       // the texture is a texture atlas page).
 
     BOOL m_bIsReady; // Wether sprite object has been created or not.
 
@@ -132,6 +139,16 @@ private:
 
     GS_OGLColor m_gsModulateColor; // Color to modulate the sprite with.
 
+    BOOL m_bIsInterpolated;     // Wether a previous transform has been saved to interpolate from.
+    GLfloat m_glfInterpolation; // How far between the previous and current transform to render.
+    GLint m_gliPrevDestX;       // The transform saved by SaveTransform().
+    GLint m_gliPrevDestY;
+    GLfloat m_glfPrevRotateX;
+    GLfloat m_glfPrevRotateY;
+    GLfloat m_glfPrevRotateZ;
+    GLfloat m_glfPrevScaleX;
+    GLfloat m_glfPrevScaleY;
+
 protected:
 
     // ...
@@ -143,6 +160,7 @@ public:
 
     BOOL Create(const char* pszPathname, BOOL bFiltered = TRUE, BOOL bMipmap = TRUE);
     BOOL Create(GLuint glTexture, int nWidth, int nHeight);
+    BOOL Create(GS_AtlasRegion* pRegion);
     void Destroy();
 
     BOOL BeginRender(HWND hWnd);
@@ -153,6 +171,9 @@ public:
 
     BOOL IsReady();
 
+    void SaveTransform();
+    void SetInterpolation(GLfloat glfInterpolation);
+
     void AddDestX(GLint gliAddX);
     void AddDestY(GLint gliAddY);
 
@@ -209,6 +230,10 @@ public:
     GLint GetTextureWidth();
     GLint GetTextureHeight();
 
+    void GetImageRect(RECT* pImageRect);
+
+    GLuint GetTextureID();
+
     GLfloat GetScaledWidth();
     GLfloat GetScaledHeight();
 
@@ -0,0 +1,786 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_sprite_batch.cpp, gs_ogl_sprite_batch.h                                      |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_SpriteBatch                                                                      |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Collects sprite quads, transforms their corners on the CPU and draws each group of  |
+ |        quads sharing a texture and blend state with a single vertex array draw call.       |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_ogl_sprite_batch.h"
+#include "gs_ogl_state.h"
+#include "gs_math.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Static members.
+// ---------------------------------------------------------------------------------------------
+GS_SpriteBatch* GS_SpriteBatch::m_pActiveBatch = NULL;
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor/Destructor Methods. /////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SpriteBatch::GS_SpriteBatch():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The constructor, initializes class data to defaults when class object is created.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_SpriteBatch::GS_SpriteBatch()
+{
+
+    m_pVertices   = NULL;
+    m_pSorted     = NULL;
+    m_pQuadGroups = NULL;
+
+    m_nMaxQuads = 0;
+    m_nNumQuads = 0;
+
+    m_nNumGroups = 0;
+
+    m_gsBlendState.gluTexture     = 0;
+    m_gsBlendState.bBlending      = FALSE;
+    m_gsBlendState.glSourceFactor = GL_ONE;
+    m_gsBlendState.glDestFactor   = GL_ZERO;
+
+    m_nSortMode     = GS_BATCH_ORDERED;
+    m_nNumDrawCalls = 0;
+
+    m_bIsDrawing = FALSE;
+    m_bIsReady   = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SpriteBatch::~GS_SpriteBatch():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The de-structor, de-initializes class data when class object is destroyed and frees
+//          all memory used by it.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_SpriteBatch::~GS_SpriteBatch()
+{
+
+    this->Destroy();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Create/Destroy Methods. /////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SpriteBatch::Create():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Allocates room for the specified number of quads. When more quads than that are
+//          added between Begin() and End() the batch simply flushes itself and carries on.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_SpriteBatch::Create(int nMaxQuads, int nSortMode)
+{
+
+    // Can't create a batch without room for at least one quad.
+    if (nMaxQuads <= 0)
+    {
+        return FALSE;
+    }
+
+    // Destroy batch if created previously.
+    if (m_bIsReady)
+    {
+        this->Destroy();
+    }
+
+    m_pVertices   = new GS_BatchVertex[nMaxQuads * 4];
+    m_pSorted     = new GS_BatchVertex[nMaxQuads * 4];
+    m_pQuadGroups = new int[nMaxQuads];
+
+    // Were we able to allocate the vertex arrays?
+    if ((NULL == m_pVertices) || (NULL == m_pSorted) || (NULL == m_pQuadGroups))
+    {
+        GS_Error::Report("GS_OGL_SPRITE_BATCH.CPP", 126, "Failed to allocate vertex arrays!");
+        this->Destroy();
+        return FALSE;
+    }
+
+    m_nMaxQuads  = nMaxQuads;
+    m_nNumQuads  = 0;
+    m_nNumGroups = 0;
+
+    this->SetSortMode(nSortMode);
+
+    m_bIsReady = TRUE;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SpriteBatch::Destroy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SpriteBatch::Destroy()
+{
+
+    // Stop collecting sprite draws if we are the active batch.
+    if (m_bIsDrawing)
+    {
+        this->End();
+    }
+
+    GS_SAFE_DELETE_ARRAY(m_pVertices);
+    GS_SAFE_DELETE_ARRAY(m_pSorted);
+    GS_SAFE_DELETE_ARRAY(m_pQuadGroups);
+
+    m_nMaxQuads  = 0;
+    m_nNumQuads  = 0;
+    m_nNumGroups = 0;
+
+    m_nNumDrawCalls = 0;
+
+    m_bIsReady = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Render Methods. /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SpriteBatch::Begin():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Makes this the active batch so that GS_OGLSprite::Render() (and everything that
+//          renders through it) queues quads here instead of drawing them immediately.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_SpriteBatch::Begin()
+{
+
+    // Can't begin if no valid batch.
+    if (!m_bIsReady)
+    {
+        return FALSE;
+    }
+
+    // Finish any other batch that is still collecting draws.
+    if ((m_pActiveBatch != NULL) && (m_pActiveBatch != this))
+    {
+        m_pActiveBatch->End();
+    }
+
+    // Read the current blend state once, from here on EnableBlending() keeps us up to date.
+    GS_OGLState* pgsState = GS_OGLState::GetActive();
+
+    GLenum glSourceFactor, glDestFactor;
+
+    pgsState->GetBlendFunc(&glSourceFactor, &glDestFactor);
+
+    this->SetBlendState(pgsState->IsEnabled(GL_BLEND), glSourceFactor, glDestFactor);
+
+    m_nNumQuads     = 0;
+    m_nNumGroups    = 0;
+    m_nNumDrawCalls = 0;
+
+    m_bIsDrawing   = TRUE;
+    m_pActiveBatch = this;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SpriteBatch::End():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Draws all queued quads and stops collecting sprite draws.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SpriteBatch::End()
+{
+
+    if (!m_bIsDrawing)
+    {
+        return;
+    }
+
+    this->Flush();
+
+    m_bIsDrawing = FALSE;
+
+    if (m_pActiveBatch == this)
+    {
+        m_pActiveBatch = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SpriteBatch::Flush():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Draws all queued quads, one glDrawArrays() call per texture/blend group. Must be
+//          called before any state the queued quads depend on (scissor box, projection) is
+//          changed, or before anything is drawn without going through the batch.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SpriteBatch::Flush()
+{
+
+    // Anything to draw?
+    if (m_nNumQuads <= 0)
+    {
+        return;
+    }
+
+    GS_PROFILE_SCOPE("GS_SpriteBatch::Flush");
+
+    GS_BatchVertex* pVertices = m_pVertices;
+
+    // Should the quads be sorted by group?
+    if ((m_nSortMode == GS_BATCH_TEXTURE) && (m_nNumGroups > 1))
+    {
+        int nGroup;
+        int nOffsets[GS_BATCH_MAX_GROUPS];
+
+        // Determine where each group starts in the sorted vertex array.
+        int nFirstQuad = 0;
+        for (nGroup = 0; nGroup < m_nNumGroups; nGroup++)
+        {
+            m_gsGroups[nGroup].nFirstQuad = nFirstQuad;
+            nOffsets[nGroup] = nFirstQuad;
+            nFirstQuad += m_gsGroups[nGroup].nNumQuads;
+        }
+
+        // Copy each quad to its place in the sorted array (keeping order within a group).
+        for (int nQuad = 0; nQuad < m_nNumQuads; nQuad++)
+        {
+            nGroup = m_pQuadGroups[nQuad];
+            memcpy(&m_pSorted[nOffsets[nGroup] * 4], &m_pVertices[nQuad * 4],
+                   sizeof(GS_BatchVertex) * 4);
+            nOffsets[nGroup]++;
+        }
+
+        pVertices = m_pSorted;
+    }
+
+    // Quads have already been transformed to screen coordinates.
+    glLoadIdentity();
+
+    // Point OpenGL to the interleaved vertex data.
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glEnableClientState(GL_VERTEX_ARRAY);
+
+    glTexCoordPointer(2, GL_FLOAT, sizeof(GS_BatchVertex), &pVertices[0].fTexU);
+    glColorPointer(4, GL_FLOAT, sizeof(GS_BatchVertex), &pVertices[0].fRed);
+    glVertexPointer(3, GL_FLOAT, sizeof(GS_BatchVertex), &pVertices[0].fX);
+
+    GS_BatchState gsCurrentState = m_gsBlendState;
+
+    // Draw each group with a single call.
+    for (int nLoop = 0; nLoop < m_nNumGroups; nLoop++)
+    {
+        GS_BatchGroup* pGroup = &m_gsGroups[nLoop];
+
+        if (pGroup->nNumQuads <= 0)
+        {
+            continue;
+        }
+
+        // Select the group texture.
+        GS_OGLState::GetActive()->BindTexture(pGroup->gsState.gluTexture);
+
+        // Change the blend state only if the group needs a different one.
+        if ((pGroup->gsState.bBlending != gsCurrentState.bBlending) ||
+            (pGroup->gsState.glSourceFactor != gsCurrentState.glSourceFactor) ||
+            (pGroup->gsState.glDestFactor != gsCurrentState.glDestFactor))
+        {
+            this->ApplyBlendState(&pGroup->gsState);
+            gsCurrentState = pGroup->gsState;
+        }
+
+        glDrawArrays(GL_QUADS, pGroup->nFirstQuad * 4, pGroup->nNumQuads * 4);
+
+        m_nNumDrawCalls++;
+        GS_Profiler::CountDrawCall(pGroup->nNumQuads * 4);
+    }
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+
+    // Restore the blend state the application expects.
+    if ((m_gsBlendState.bBlending != gsCurrentState.bBlending) ||
+        (m_gsBlendState.glSourceFactor != gsCurrentState.glSourceFactor) ||
+        (m_gsBlendState.glDestFactor != gsCurrentState.glDestFactor))
+    {
+        this->ApplyBlendState(&m_gsBlendState);
+    }
+
+    // Drawing from a color array leaves the current color undefined.
+    GS_OGLState::GetActive()->InvalidateColor();
+
+    m_nNumQuads  = 0;
+    m_nNumGroups = 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SpriteBatch::AddSprite():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Transforms the corners of the sprite quad exactly like the glTranslated() and
+//          glRotatef() calls in GS_OGLSprite::Render() would and queues the result.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_SpriteBatch::AddSprite(GS_BatchSprite* pgsSprite)
+{
+
+    // Can't add sprites unless we're between Begin() and End().
+    if ((!m_bIsDrawing) || (NULL == pgsSprite))
+    {
+        return FALSE;
+    }
+
+    // Make room if the vertex array is full.
+    if (m_nNumQuads >= m_nMaxQuads)
+    {
+        this->Flush();
+    }
+
+    int nGroup = this->FindGroup(pgsSprite->gluTexture);
+
+    // The first two columns of the rotation matrix (X * Y * Z), the third is not needed
+    // because the quad corners all have a z-coordinate of 0.
+    GLfloat fXx = 1.0f, fXy = 0.0f, fXz = 0.0f;
+    GLfloat fYx = 0.0f, fYy = 1.0f, fYz = 0.0f;
+
+    // Only bother with the rotation matrix if the sprite is actually rotated.
+    if ((pgsSprite->fRotateX != 0.0f) || (pgsSprite->fRotateY != 0.0f) ||
+        (pgsSprite->fRotateZ != 0.0f))
+    {
+        GLfloat fSinX = GS_Sin(pgsSprite->fRotateX), fCosX = GS_Cos(pgsSprite->fRotateX);
+        GLfloat fSinY = GS_Sin(pgsSprite->fRotateY), fCosY = GS_Cos(pgsSprite->fRotateY);
+        GLfloat fSinZ = GS_Sin(pgsSprite->fRotateZ), fCosZ = GS_Cos(pgsSprite->fRotateZ);
+
+        fXx = fCosZ * fCosY;
+        fXy = fSinZ * fCosX + fCosZ * fSinY * fSinX;
+        fXz = fSinZ * fSinX - fCosZ * fSinY * fCosX;
+
+        fYx = -fSinZ * fCosY;
+        fYy =  fCosZ * fCosX - fSinZ * fSinY * fSinX;
+        fYz =  fCosZ * fSinX + fSinZ * fSinY * fCosX;
+    }
+
+    // The corners in the same order as GS_OGLSprite::Render() draws them.
+    GLfloat fCornerX[4] = { pgsSprite->fLeft,   pgsSprite->fRight,  pgsSprite->fRight,
+                            pgsSprite->fLeft };
+    GLfloat fCornerY[4] = { pgsSprite->fBottom, pgsSprite->fBottom, pgsSprite->fTop,
+                            pgsSprite->fTop };
+    GLfloat fTexU[4]    = { pgsSprite->fTexLeft,   pgsSprite->fTexRight, pgsSprite->fTexRight,
+                            pgsSprite->fTexLeft };
+    GLfloat fTexV[4]    = { pgsSprite->fTexBottom, pgsSprite->fTexBottom, pgsSprite->fTexTop,
+                            pgsSprite->fTexTop };
+
+    GS_BatchVertex* pVertex = &m_pVertices[m_nNumQuads * 4];
+
+    for (int nLoop = 0; nLoop < 4; nLoop++)
+    {
+        pVertex[nLoop].fTexU  = fTexU[nLoop];
+        pVertex[nLoop].fTexV  = fTexV[nLoop];
+        pVertex[nLoop].fRed   = pgsSprite->gsColor.fRed;
+        pVertex[nLoop].fGreen = pgsSprite->gsColor.fGreen;
+        pVertex[nLoop].fBlue  = pgsSprite->gsColor.fBlue;
+        pVertex[nLoop].fAlpha = pgsSprite->gsColor.fAlpha;
+        pVertex[nLoop].fX = pgsSprite->fPosX + (fXx * fCornerX[nLoop]) + (fYx * fCornerY[nLoop]);
+        pVertex[nLoop].fY = pgsSprite->fPosY + (fXy * fCornerX[nLoop]) + (fYy * fCornerY[nLoop]);
+        pVertex[nLoop].fZ = (fXz * fCornerX[nLoop]) + (fYz * fCornerY[nLoop]);
+    }
+
+    m_pQuadGroups[m_nNumQuads] = nGroup;
+    m_gsGroups[nGroup].nNumQuads++;
+
+    m_nNumQuads++;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SpriteBatch::AddQuads():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Queues quads that have already been transformed to screen coordinates (four
+//          vertices each, in the order GS_OGLSprite::Render() draws the corners), such as the
+//          laid out text of a font. The quads are copied as they are.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_SpriteBatch::AddQuads(GLuint gluTexture, int nNumQuads, const GS_BatchVertex* pVertices)
+{
+
+    // Can't add quads unless we're between Begin() and End().
+    if ((!m_bIsDrawing) || (NULL == pVertices) || (nNumQuads < 0))
+    {
+        return FALSE;
+    }
+
+    while (nNumQuads > 0)
+    {
+        // Make room if the vertex array is full.
+        if (m_nNumQuads >= m_nMaxQuads)
+        {
+            this->Flush();
+        }
+
+        // Finding the group may flush the batch too, so only see how many quads fit after.
+        int nGroup = this->FindGroup(gluTexture);
+        int nNumCopied = m_nMaxQuads - m_nNumQuads;
+
+        if (nNumCopied > nNumQuads)
+        {
+            nNumCopied = nNumQuads;
+        }
+
+        memcpy(&m_pVertices[m_nNumQuads * 4], pVertices, nNumCopied * 4 * sizeof(GS_BatchVertex));
+
+        for (int nLoop = 0; nLoop < nNumCopied; nLoop++)
+        {
+            m_pQuadGroups[m_nNumQuads + nLoop] = nGroup;
+        }
+
+        m_gsGroups[nGroup].nNumQuads += nNumCopied;
+        m_nNumQuads += nNumCopied;
+
+        pVertices += nNumCopied * 4;
+        nNumQuads -= nNumCopied;
+    }
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SpriteBatch::FindGroup():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Finds the group that a quad with the specified texture and the current blend state
+//          belongs to, creating a new group if needed. In ordered mode only the last group is
+//          a candidate, so that quads are never drawn out of order.
+// ---------------------------------------------------------------------------------------------
+// Returns: The index of the group.
+//==============================================================================================
+
+int GS_SpriteBatch::FindGroup(GLuint gluTexture)
+{
+
+    GS_BatchState gsState = m_gsBlendState;
+    gsState.gluTexture = gluTexture;
+
+    int nFirstCandidate = 0;
+
+    if (m_nSortMode == GS_BATCH_ORDERED)
+    {
+        nFirstCandidate = m_nNumGroups - 1;
+    }
+
+    for (int nLoop = m_nNumGroups - 1; nLoop >= nFirstCandidate && nLoop >= 0; nLoop--)
+    {
+        GS_BatchState* pState = &m_gsGroups[nLoop].gsState;
+
+        if ((pState->gluTexture == gsState.gluTexture) &&
+            (pState->bBlending == gsState.bBlending) &&
+            (pState->glSourceFactor == gsState.glSourceFactor) &&
+            (pState->glDestFactor == gsState.glDestFactor))
+        {
+            return nLoop;
+        }
+    }
+
+    // Out of groups? Draw what we have and start over.
+    if (m_nNumGroups >= GS_BATCH_MAX_GROUPS)
+    {
+        this->Flush();
+    }
+
+    m_gsGroups[m_nNumGroups].gsState    = gsState;
+    m_gsGroups[m_nNumGroups].nFirstQuad = m_nNumQuads;
+    m_gsGroups[m_nNumGroups].nNumQuads  = 0;
+
+    return m_nNumGroups++;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SpriteBatch::ApplyBlendState():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SpriteBatch::ApplyBlendState(GS_BatchState* pgsState)
+{
+
+    if (pgsState->bBlending)
+    {
+        GS_OGLState::GetActive()->BlendFunc(pgsState->glSourceFactor, pgsState->glDestFactor);
+        GS_OGLState::GetActive()->Enable(GL_BLEND);
+    }
+    else
+    {
+        GS_OGLState::GetActive()->Disable(GL_BLEND);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Get/Set Methods. ////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SpriteBatch::SetBlendState():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the blend state that quads added from now on will be drawn with. Called by
+//          GS_OGLDisplay::EnableBlending() so that the batch knows about blend changes without
+//          having to query OpenGL for every sprite.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SpriteBatch::SetBlendState(BOOL bEnable, GLenum glSourceFactor, GLenum glDestFactor)
+{
+
+    m_gsBlendState.bBlending = bEnable ? TRUE : FALSE;
+
+    // The blend factors don't matter when blending is disabled, so don't let them split groups.
+    if (m_gsBlendState.bBlending)
+    {
+        m_gsBlendState.glSourceFactor = glSourceFactor;
+        m_gsBlendState.glDestFactor   = glDestFactor;
+    }
+    else
+    {
+        m_gsBlendState.glSourceFactor = GL_ONE;
+        m_gsBlendState.glDestFactor   = GL_ZERO;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SpriteBatch::GetSortMode():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: Either GS_BATCH_ORDERED or GS_BATCH_TEXTURE.
+//==============================================================================================
+
+int GS_SpriteBatch::GetSortMode()
+{
+
+    return m_nSortMode;
+}
+
+
+//==============================================================================================
+// GS_SpriteBatch::SetSortMode():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets wether quads are drawn in the order they were added (GS_BATCH_ORDERED) or
+//          sorted by texture and blend state (GS_BATCH_TEXTURE). Sorting gives the fewest draw
+//          calls but should only be used when the sprites drawn don't overlap.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SpriteBatch::SetSortMode(int nSortMode)
+{
+
+    // Groups built under the old mode must be drawn before switching.
+    this->Flush();
+
+    if (nSortMode == GS_BATCH_TEXTURE)
+    {
+        m_nSortMode = GS_BATCH_TEXTURE;
+    }
+    else
+    {
+        m_nSortMode = GS_BATCH_ORDERED;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SpriteBatch::GetNumQuads():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of quads currently queued.
+//==============================================================================================
+
+int GS_SpriteBatch::GetNumQuads()
+{
+
+    return m_nNumQuads;
+}
+
+
+//==============================================================================================
+// GS_SpriteBatch::GetNumDrawCalls():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of draw calls issued since Begin() was called.
+//==============================================================================================
+
+int GS_SpriteBatch::GetNumDrawCalls()
+{
+
+    return m_nNumDrawCalls;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SpriteBatch::IsDrawing():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if between Begin() and End(), FALSE if not.
+//==============================================================================================
+
+BOOL GS_SpriteBatch::IsDrawing()
+{
+
+    return m_bIsDrawing;
+}
+
+
+//==============================================================================================
+// GS_SpriteBatch::IsReady():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if created, FALSE if not.
+//==============================================================================================
+
+BOOL GS_SpriteBatch::IsReady()
+{
+
+    return m_bIsReady;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Static Methods. /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SpriteBatch::GetActive():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The batch currently collecting sprite draws, or NULL if none.
+//==============================================================================================
+
+GS_SpriteBatch* GS_SpriteBatch::GetActive()
+{
+
+    return m_pActiveBatch;
+}
+
+
+//==============================================================================================
+// GS_SpriteBatch::FlushActive():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Flushes the active batch, if any. Anything that draws directly with OpenGL, or
+//          changes state that queued quads depend on, calls this first.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SpriteBatch::FlushActive()
+{
+
+    if (m_pActiveBatch != NULL)
+    {
+        m_pActiveBatch->Flush();
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
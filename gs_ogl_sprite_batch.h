@@ -0,0 +1,197 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_sprite_batch.cpp, gs_ogl_sprite_batch.h                                      |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_SpriteBatch                                                                      |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Collects sprite quads, transforms their corners on the CPU and draws each group of  |
+ |        quads sharing a texture and blend state with a single vertex array draw call.       |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+#ifndef GS_OGL_SPRITE_BATCH_H
+#define GS_OGL_SPRITE_BATCH_H
+
+
+//==============================================================================================
+// Include platform abstraction header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_platform.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include OpenGL header files.
+// ---------------------------------------------------------------------------------------------
+#ifdef __APPLE__
+    #include <OpenGL/gl.h>
+#else
+    #include <GL/gl.h>
+#endif
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_error.h"
+#include "gs_object.h"
+#include "gs_ogl_color.h"
+#include "gs_profiler.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Defines.
+// ---------------------------------------------------------------------------------------------
+#define GS_BATCH_DEFAULT_QUADS 4096 // Number of quads queued before the batch flushes itself.
+#define GS_BATCH_MAX_GROUPS      64 // Number of texture/blend groups queued before a flush.
+
+#define GS_BATCH_ORDERED 0 // Draw quads in the order they were added (safe for overlaps).
+#define GS_BATCH_TEXTURE 1 // Sort quads by texture and blend state (fewest draw calls).
+//==============================================================================================
+
+
+//==============================================================================================
+// Batch vertex structure (interleaved texture coordinate, color and position).
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_BATCH_VERTEX
+{
+    GLfloat fTexU;   // Texture coordinates.
+    GLfloat fTexV;
+    GLfloat fRed;    // Modulate color.
+    GLfloat fGreen;
+    GLfloat fBlue;
+    GLfloat fAlpha;
+    GLfloat fX;      // Transformed screen position.
+    GLfloat fY;
+    GLfloat fZ;
+} GS_BatchVertex;
+//==============================================================================================
+
+
+//==============================================================================================
+// Batch state structure (everything that forces a separate draw call).
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_BATCH_STATE
+{
+    GLuint gluTexture;     // The texture used by the quads.
+    BOOL   bBlending;      // Wether blending is enabled.
+    GLenum glSourceFactor; // The blend factors (only valid if blending is enabled).
+    GLenum glDestFactor;
+} GS_BatchState;
+//==============================================================================================
+
+
+//==============================================================================================
+// Batch group structure.
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_BATCH_GROUP
+{
+    GS_BatchState gsState; // The state shared by all quads in the group.
+    int nFirstQuad;        // Index of the first quad in the (sorted) vertex array.
+    int nNumQuads;         // Number of quads in the group.
+} GS_BatchGroup;
+//==============================================================================================
+
+
+//==============================================================================================
+// Batch sprite structure, describes a single quad in the same terms GS_OGLSprite::Render()
+// uses: a position to translate to, the extents of the quad around that position, the
+// rotation around each axis and the texture coordinates.
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_BATCH_SPRITE
+{
+    GLuint  gluTexture; // The texture to draw the quad with.
+    GLfloat fPosX;      // The screen position of the rotation point.
+    GLfloat fPosY;
+    GLfloat fLeft;      // The extents of the quad relative to the rotation point.
+    GLfloat fBottom;
+    GLfloat fRight;
+    GLfloat fTop;
+    GLfloat fRotateX;   // How much the quad should be rotated (in degrees).
+    GLfloat fRotateY;
+    GLfloat fRotateZ;
+    GLfloat fTexLeft;   // The texture coordinates of the quad.
+    GLfloat fTexBottom;
+    GLfloat fTexRight;
+    GLfloat fTexTop;
+    GS_OGLColor gsColor; // The modulate color of the quad.
+} GS_BatchSprite;
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_SpriteBatch : public GS_Object
+{
+
+private:
+
+    static GS_SpriteBatch* m_pActiveBatch; // The batch currently collecting sprite draws.
+
+    GS_BatchVertex* m_pVertices; // The vertices of all queued quads (four per quad).
+    GS_BatchVertex* m_pSorted;   // The vertices sorted by group (GS_BATCH_TEXTURE only).
+    int* m_pQuadGroups;          // The group index of each queued quad.
+
+    int m_nMaxQuads; // The maximum number of quads that can be queued.
+    int m_nNumQuads; // The number of quads currently queued.
+
+    GS_BatchGroup m_gsGroups[GS_BATCH_MAX_GROUPS]; // The groups of quads currently queued.
+    int m_nNumGroups;                              // The number of groups currently queued.
+
+    GS_BatchState m_gsBlendState; // The blend state that new quads are added with.
+
+    int m_nSortMode;     // Either GS_BATCH_ORDERED or GS_BATCH_TEXTURE.
+    int m_nNumDrawCalls; // The number of draw calls issued since Begin() was called.
+
+    BOOL m_bIsDrawing; // Wether the batch is between Begin() and End().
+    BOOL m_bIsReady;   // Wether the batch has been created or not.
+
+    int  FindGroup(GLuint gluTexture);
+    void ApplyBlendState(GS_BatchState* pgsState);
+
+protected:
+
+    // No protected members.
+
+public:
+
+    GS_SpriteBatch();
+    ~GS_SpriteBatch();
+
+    BOOL Create(int nMaxQuads = GS_BATCH_DEFAULT_QUADS, int nSortMode = GS_BATCH_ORDERED);
+    void Destroy();
+
+    BOOL Begin();
+    void End();
+    void Flush();
+
+    BOOL AddSprite(GS_BatchSprite* pgsSprite);
+    BOOL AddQuads(GLuint gluTexture, int nNumQuads, const GS_BatchVertex* pVertices);
+
+    void SetBlendState(BOOL bEnable, GLenum glSourceFactor, GLenum glDestFactor);
+
+    int  GetSortMode();
+    void SetSortMode(int nSortMode);
+
+    int GetNumQuads();
+    int GetNumDrawCalls();
+
+    BOOL IsDrawing();
+    BOOL IsReady();
+
+    static GS_SpriteBatch* GetActive();
+    static void FlushActive();
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -110,14 +110,19 @@ BOOL GS_OGLSpriteEx::Create(const char* pszPathname, int nTotalFrames, int nFram
     int nXoffset, nYoffset; // The starting x and y offsets of the frame.
     int nQuotient;          // The quotient used to determine the offset.
 
+    // The frames are relative to the image, which is only part of the texture if the sprite
+    // was created from a texture atlas.
+    RECT ImageRect;
+    GS_OGLSprite::GetImageRect(&ImageRect);
+
     // Determine the coordinates of each frame.
     for (int nLoop = 0; nLoop < m_nTotalFrames; nLoop++)
     {
         // Use the remainder to determine the horizontal offset of the frame.
-        nXoffset   = (nLoop%m_nFramesPerLine) * m_nFrameWidth;
+        nXoffset   = ImageRect.left + (nLoop%m_nFramesPerLine) * m_nFrameWidth;
         // Use the quotient to determine the vertical offset of the frame.
         nQuotient = (nLoop-(nLoop%m_nFramesPerLine)) / m_nFramesPerLine;
-        nYoffset  = this->GetTextureHeight() - (nQuotient * m_nFrameHeight);
+        nYoffset  = ImageRect.top - (nQuotient * m_nFrameHeight);
         // Set the source rectangle to the specified frame.
         m_pFrameRects[nLoop].left   = nXoffset;
         m_pFrameRects[nLoop].top    = nYoffset;
@@ -440,4 +445,37 @@ GLfloat GS_OGLSpriteEx::GetFrameHeight()
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSpriteEx::GetFrameRect():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Retrieves the source rectangle of the specified frame. The frame is clamped to the
+//          valid range in the same way as GS_OGLSpriteEx::SetFrame().
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLSpriteEx::GetFrameRect(int nFrame, RECT* pFrameRect)
+{
+
+    if ((NULL == pFrameRect) || (NULL == m_pFrameRects) || (m_nTotalFrames <= 0))
+    {
+        return;
+    }
+
+    if (nFrame >= m_nTotalFrames)
+    {
+        nFrame = m_nTotalFrames - 1;
+    }
+    else if (nFrame < 0)
+    {
+        nFrame = 0;
+    }
+
+    *pFrameRect = m_pFrameRects[nFrame];
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -95,6 +95,8 @@ public:
 
     GLfloat GetFrameWidth();
     GLfloat GetFrameHeight();
+
+    void GetFrameRect(int nFrame, RECT* pFrameRect);
 };
 
 
@@ -0,0 +1,843 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_state.cpp, gs_ogl_state.h                                                    |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_OGLState                                                                         |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Keeps a copy of the OpenGL state the renderers change most (enable bits, the bound  |
+ |        texture, the blend function, the color and the scissor box) so that calls which     |
+ |        would not change anything, and queries such as glIsEnabled(), never reach OpenGL.   |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_ogl_state.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Static members.
+// ---------------------------------------------------------------------------------------------
+GS_OGLState* GS_OGLState::m_pActiveState = NULL;
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor/Destructor Methods //////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::GS_OGLState():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The constructor, initializes class data when class object is created.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_OGLState::GS_OGLState()
+{
+
+    m_bIsCaching = TRUE;
+
+    m_pfnBlendFuncSeparate = NULL;
+
+    this->Invalidate();
+    this->ResetStats();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::~GS_OGLState():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The de-structor, de-initializes class data when class object is destroyed.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_OGLState::~GS_OGLState()
+{
+
+    this->Activate(FALSE);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Invalidate Methods //////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::Invalidate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Forgets everything that is known about the OpenGL state. Must be called after
+//          OpenGL state is changed without going through this class (or a new rendering
+//          context is made current), the next call for each piece of state then goes straight
+//          to OpenGL again.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::Invalidate()
+{
+
+    for (int nLoop = 0; nLoop < GS_STATE_NUM_CAPS; nLoop++)
+    {
+        m_bIsCapEnabled[nLoop] = FALSE;
+        m_bIsCapKnown[nLoop]   = FALSE;
+    }
+
+    m_glSourceFactor    = GL_ONE;
+    m_glDestFactor      = GL_ZERO;
+    m_bIsBlendFuncKnown = FALSE;
+
+    m_gliScissor[0]   = 0;
+    m_gliScissor[1]   = 0;
+    m_gliScissor[2]   = 0;
+    m_gliScissor[3]   = 0;
+    m_bIsScissorKnown = FALSE;
+
+    m_glfClearColor[0]   = 0.0f;
+    m_glfClearColor[1]   = 0.0f;
+    m_glfClearColor[2]   = 0.0f;
+    m_glfClearColor[3]   = 0.0f;
+    m_bIsClearColorKnown = FALSE;
+
+    this->InvalidateTexture();
+    this->InvalidateColor();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::InvalidateTexture():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Forgets which texture is bound, for after glBindTexture() was called directly.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::InvalidateTexture()
+{
+
+    m_gluTexture      = 0;
+    m_bIsTextureKnown = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::InvalidateColor():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Forgets the current color, for after glColor*() was called directly or something
+//          was drawn from a color array (which leaves the current color undefined).
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::InvalidateColor()
+{
+
+    m_glfColor[0]   = 1.0f;
+    m_glfColor[1]   = 1.0f;
+    m_glfColor[2]   = 1.0f;
+    m_glfColor[3]   = 1.0f;
+    m_bIsColorKnown = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Capability Methods //////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::GetCapIndex():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The index the capability is tracked at, -1 if it isn't tracked.
+//==============================================================================================
+
+int GS_OGLState::GetCapIndex(GLenum glCap)
+{
+
+    switch (glCap)
+    {
+    case GL_TEXTURE_2D:
+        return 0;
+    case GL_DEPTH_TEST:
+        return 1;
+    case GL_LIGHTING:
+        return 2;
+    case GL_BLEND:
+        return 3;
+    case GL_SCISSOR_TEST:
+        return 4;
+    case GL_CULL_FACE:
+        return 5;
+    default:
+        return -1;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::Enable():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::Enable(GLenum glCap)
+{
+
+    this->SetEnabled(glCap, TRUE);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::Disable():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::Disable(GLenum glCap)
+{
+
+    this->SetEnabled(glCap, FALSE);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::SetEnabled():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Enables or disables a capability, capabilities that aren't tracked are always
+//          passed on to OpenGL.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::SetEnabled(GLenum glCap, BOOL bEnable)
+{
+
+    int nIndex = GetCapIndex(glCap);
+
+    bEnable = bEnable ? TRUE : FALSE;
+
+    m_nNumCalls++;
+
+    if ((nIndex >= 0) && m_bIsCaching && m_bIsCapKnown[nIndex] &&
+        (m_bIsCapEnabled[nIndex] == bEnable))
+    {
+        m_nNumSkipped++;
+        return;
+    }
+
+    if (bEnable)
+    {
+        glEnable(glCap);
+    }
+    else
+    {
+        glDisable(glCap);
+    }
+
+    if (nIndex >= 0)
+    {
+        m_bIsCapEnabled[nIndex] = bEnable;
+        m_bIsCapKnown[nIndex]   = TRUE;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::IsEnabled():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Asks OpenGL only the first time after the capability was invalidated.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the capability is enabled, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLState::IsEnabled(GLenum glCap)
+{
+
+    int nIndex = GetCapIndex(glCap);
+
+    m_nNumCalls++;
+
+    if ((nIndex >= 0) && m_bIsCaching && m_bIsCapKnown[nIndex])
+    {
+        m_nNumSkipped++;
+        return m_bIsCapEnabled[nIndex];
+    }
+
+    BOOL bIsEnabled = (glIsEnabled(glCap) == GL_TRUE) ? TRUE : FALSE;
+
+    if (nIndex >= 0)
+    {
+        m_bIsCapEnabled[nIndex] = bIsEnabled;
+        m_bIsCapKnown[nIndex]   = TRUE;
+    }
+
+    return bIsEnabled;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Texture Methods /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::BindTexture():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Binds a texture to GL_TEXTURE_2D unless it is already bound.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::BindTexture(GLuint gluTexture)
+{
+
+    m_nNumCalls++;
+
+    if (m_bIsCaching && m_bIsTextureKnown && (m_gluTexture == gluTexture))
+    {
+        m_nNumSkipped++;
+        return;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, gluTexture);
+
+    m_gluTexture      = gluTexture;
+    m_bIsTextureKnown = TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::GetBoundTexture():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The texture bound to GL_TEXTURE_2D.
+//==============================================================================================
+
+GLuint GS_OGLState::GetBoundTexture()
+{
+
+    m_nNumCalls++;
+
+    if (m_bIsCaching && m_bIsTextureKnown)
+    {
+        m_nNumSkipped++;
+        return m_gluTexture;
+    }
+
+    GLint gliTexture = 0;
+
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &gliTexture);
+
+    m_gluTexture      = (GLuint) gliTexture;
+    m_bIsTextureKnown = TRUE;
+
+    return m_gluTexture;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::ReleaseTexture():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Must be called when a texture is deleted, OpenGL binds texture 0 in its place if
+//          it was bound, and a new texture may be given the same name later on.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::ReleaseTexture(GLuint gluTexture)
+{
+
+    if (m_bIsTextureKnown && (m_gluTexture == gluTexture))
+    {
+        m_gluTexture = 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Blend, Color and Scissor Methods ////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::BlendFunc():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::BlendFunc(GLenum glSourceFactor, GLenum glDestFactor)
+{
+
+    m_nNumCalls++;
+
+    if (m_bIsCaching && m_bIsBlendFuncKnown && (m_glSourceFactor == glSourceFactor) &&
+        (m_glDestFactor == glDestFactor))
+    {
+        m_nNumSkipped++;
+        return;
+    }
+
+    if (m_pfnBlendFuncSeparate != NULL)
+    {
+        m_pfnBlendFuncSeparate(glSourceFactor, glDestFactor, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    }
+    else
+    {
+        glBlendFunc(glSourceFactor, glDestFactor);
+    }
+
+    m_glSourceFactor    = glSourceFactor;
+    m_glDestFactor      = glDestFactor;
+    m_bIsBlendFuncKnown = TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::GetBlendFunc():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::GetBlendFunc(GLenum* pglSourceFactor, GLenum* pglDestFactor)
+{
+
+    m_nNumCalls++;
+
+    if (m_bIsCaching && m_bIsBlendFuncKnown)
+    {
+        m_nNumSkipped++;
+    }
+    else
+    {
+        GLint gliSrcFactor = GL_ONE;
+        GLint gliDstFactor = GL_ZERO;
+
+        glGetIntegerv(GL_BLEND_SRC, &gliSrcFactor);
+        glGetIntegerv(GL_BLEND_DST, &gliDstFactor);
+
+        m_glSourceFactor    = (GLenum) gliSrcFactor;
+        m_glDestFactor      = (GLenum) gliDstFactor;
+        m_bIsBlendFuncKnown = TRUE;
+    }
+
+    if (pglSourceFactor)
+    {
+        *pglSourceFactor = m_glSourceFactor;
+    }
+
+    if (pglDestFactor)
+    {
+        *pglDestFactor = m_glDestFactor;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::SetBlendFuncSeparate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: While set, the alpha channel is always blended with GL_ONE, GL_ONE_MINUS_SRC_ALPHA
+//          whatever blend function is asked for. A render target drawn to like this holds
+//          premultiplied colors and the coverage of everything drawn to it, so it can be drawn
+//          over the screen in one go. Pass NULL to go back to glBlendFunc().
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::SetBlendFuncSeparate(GS_PFNBLENDFUNCSEPARATEPROC pfnBlendFuncSeparate)
+{
+
+    if (m_pfnBlendFuncSeparate == pfnBlendFuncSeparate)
+    {
+        return;
+    }
+
+    m_pfnBlendFuncSeparate = pfnBlendFuncSeparate;
+
+    // Apply the current blend function again the new way.
+    GLenum glSourceFactor, glDestFactor;
+    this->GetBlendFunc(&glSourceFactor, &glDestFactor);
+
+    m_bIsBlendFuncKnown = FALSE;
+    this->BlendFunc(glSourceFactor, glDestFactor);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::Color():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::Color(GLfloat glfRed, GLfloat glfGreen, GLfloat glfBlue, GLfloat glfAlpha)
+{
+
+    m_nNumCalls++;
+
+    if (m_bIsCaching && m_bIsColorKnown && (m_glfColor[0] == glfRed) &&
+        (m_glfColor[1] == glfGreen) && (m_glfColor[2] == glfBlue) &&
+        (m_glfColor[3] == glfAlpha))
+    {
+        m_nNumSkipped++;
+        return;
+    }
+
+    glColor4f(glfRed, glfGreen, glfBlue, glfAlpha);
+
+    m_glfColor[0]   = glfRed;
+    m_glfColor[1]   = glfGreen;
+    m_glfColor[2]   = glfBlue;
+    m_glfColor[3]   = glfAlpha;
+    m_bIsColorKnown = TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::Scissor():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the scissor box, enabling GL_SCISSOR_TEST is left to the caller.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::Scissor(GLint gliLeft, GLint gliBottom, GLsizei glsWidth, GLsizei glsHeight)
+{
+
+    m_nNumCalls++;
+
+    if (m_bIsCaching && m_bIsScissorKnown && (m_gliScissor[0] == gliLeft) &&
+        (m_gliScissor[1] == gliBottom) && (m_gliScissor[2] == glsWidth) &&
+        (m_gliScissor[3] == glsHeight))
+    {
+        m_nNumSkipped++;
+        return;
+    }
+
+    glScissor(gliLeft, gliBottom, glsWidth, glsHeight);
+
+    m_gliScissor[0]   = gliLeft;
+    m_gliScissor[1]   = gliBottom;
+    m_gliScissor[2]   = glsWidth;
+    m_gliScissor[3]   = glsHeight;
+    m_bIsScissorKnown = TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::ClearColor():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the color glClear() fills the color buffer with.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::ClearColor(GLfloat glfRed, GLfloat glfGreen, GLfloat glfBlue,
+                             GLfloat glfAlpha)
+{
+
+    m_nNumCalls++;
+
+    if (m_bIsCaching && m_bIsClearColorKnown && (m_glfClearColor[0] == glfRed) &&
+        (m_glfClearColor[1] == glfGreen) && (m_glfClearColor[2] == glfBlue) &&
+        (m_glfClearColor[3] == glfAlpha))
+    {
+        m_nNumSkipped++;
+        return;
+    }
+
+    glClearColor(glfRed, glfGreen, glfBlue, glfAlpha);
+
+    m_glfClearColor[0]   = glfRed;
+    m_glfClearColor[1]   = glfGreen;
+    m_glfClearColor[2]   = glfBlue;
+    m_glfClearColor[3]   = glfAlpha;
+    m_bIsClearColorKnown = TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::GetClearColor():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Gets the clear color into pglfColor (four floats). OpenGL is only asked when the
+//          color is not known, once ClearColor() was called it never stalls on a query.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::GetClearColor(GLfloat* pglfColor)
+{
+
+    m_nNumCalls++;
+
+    if (m_bIsCaching && m_bIsClearColorKnown)
+    {
+        m_nNumSkipped++;
+    }
+    else
+    {
+        glGetFloatv(GL_COLOR_CLEAR_VALUE, m_glfClearColor);
+        m_bIsClearColorKnown = TRUE;
+    }
+
+    if (pglfColor)
+    {
+        pglfColor[0] = m_glfClearColor[0];
+        pglfColor[1] = m_glfClearColor[1];
+        pglfColor[2] = m_glfClearColor[2];
+        pglfColor[3] = m_glfClearColor[3];
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::Reset():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Unbinds the texture and sets the color back to white, which is what code drawing
+//          without this class expects after the renderers are done.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::Reset()
+{
+
+    this->BindTexture(0);
+    this->Color(1.0f, 1.0f, 1.0f, 1.0f);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Get/Set Methods. ////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::Activate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Makes this the tracker that sprites, fonts, maps, particles and textures change
+//          OpenGL state through, or stops using this tracker.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::Activate(BOOL bActivate)
+{
+
+    if (bActivate)
+    {
+        m_pActiveState = this;
+    }
+    else if (m_pActiveState == this)
+    {
+        m_pActiveState = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::EnableCaching():
+// ---------------------------------------------------------------------------------------------
+// Purpose: When disabled every call is passed on to OpenGL, which helps to find code that
+//          changes OpenGL state without letting this class know.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::EnableCaching(BOOL bEnable)
+{
+
+    m_bIsCaching = bEnable;
+
+    this->Invalidate();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::IsCachingEnabled():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if caching is enabled, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLState::IsCachingEnabled()
+{
+
+    return m_bIsCaching;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::GetNumCalls():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of state changes and queries asked for since ResetStats() was called.
+//==============================================================================================
+
+int GS_OGLState::GetNumCalls()
+{
+
+    return m_nNumCalls;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::GetNumSkipped():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of those calls that never reached OpenGL.
+//==============================================================================================
+
+int GS_OGLState::GetNumSkipped()
+{
+
+    return m_nNumSkipped;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::ResetStats():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::ResetStats()
+{
+
+    m_nNumCalls   = 0;
+    m_nNumSkipped = 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::GetActive():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The active state tracker. If there is none a tracker that passes every call on to
+//          OpenGL is returned, so the result never has to be checked for NULL.
+//==============================================================================================
+
+GS_OGLState* GS_OGLState::GetActive()
+{
+
+    if (m_pActiveState == NULL)
+    {
+        static GS_OGLState gsPassThrough;
+
+        gsPassThrough.m_bIsCaching = FALSE;
+
+        return &gsPassThrough;
+    }
+
+    return m_pActiveState;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
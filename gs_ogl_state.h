@@ -0,0 +1,152 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_state.cpp, gs_ogl_state.h                                                    |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_OGLState                                                                         |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Keeps a copy of the OpenGL state the renderers change most (enable bits, the bound  |
+ |        texture, the blend function, the color and the scissor box) so that calls which     |
+ |        would not change anything, and queries such as glIsEnabled(), never reach OpenGL.   |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+#ifndef GS_OGL_STATE_H
+#define GS_OGL_STATE_H
+
+
+//==============================================================================================
+// Include platform abstraction header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_platform.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include OpenGL header files.
+// ---------------------------------------------------------------------------------------------
+#ifdef __APPLE__
+    #include <OpenGL/gl.h>
+#else
+    #include <GL/gl.h>
+#endif
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_object.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Defines.
+// ---------------------------------------------------------------------------------------------
+#define GS_STATE_NUM_CAPS 6 // Number of capabilities tracked (see GS_OGLState::GetCapIndex()).
+
+#ifndef APIENTRY
+    #define APIENTRY
+#endif
+//==============================================================================================
+
+
+//==============================================================================================
+// OpenGL 1.4 blend function with separate alpha factors (loaded at run time).
+// ---------------------------------------------------------------------------------------------
+typedef void (APIENTRY* GS_PFNBLENDFUNCSEPARATEPROC)(GLenum glSourceRGB, GLenum glDestRGB,
+                                                     GLenum glSourceAlpha, GLenum glDestAlpha);
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_OGLState : public GS_Object
+{
+
+private:
+
+    static GS_OGLState* m_pActiveState; // The tracker the renderers currently go through.
+
+    BOOL m_bIsCapEnabled[GS_STATE_NUM_CAPS]; // The last known state of each capability.
+    BOOL m_bIsCapKnown[GS_STATE_NUM_CAPS];   // Wether the state above can be trusted.
+
+    GLuint m_gluTexture;     // The texture bound to GL_TEXTURE_2D.
+    BOOL   m_bIsTextureKnown;
+
+    GLenum m_glSourceFactor; // The blend function.
+    GLenum m_glDestFactor;
+    BOOL   m_bIsBlendFuncKnown;
+
+    GS_PFNBLENDFUNCSEPARATEPROC m_pfnBlendFuncSeparate; // Set while drawing to a render target.
+
+    GLfloat m_glfColor[4];   // The current color.
+    BOOL    m_bIsColorKnown;
+
+    GLint   m_gliScissor[4]; // The scissor box (left, bottom, width, height).
+    BOOL    m_bIsScissorKnown;
+
+    GLfloat m_glfClearColor[4]; // The color glClear() fills the color buffer with.
+    BOOL    m_bIsClearColorKnown;
+
+    BOOL m_bIsCaching; // Wether calls that would not change anything are skipped.
+
+    int m_nNumCalls;   // The number of state changes asked for since ResetStats().
+    int m_nNumSkipped; // The number of those that never reached OpenGL.
+
+    static int GetCapIndex(GLenum glCap);
+
+protected:
+
+    // No protected members.
+
+public:
+
+    GS_OGLState();
+    ~GS_OGLState();
+
+    void Invalidate();
+    void InvalidateTexture();
+    void InvalidateColor();
+
+    void Enable(GLenum glCap);
+    void Disable(GLenum glCap);
+    void SetEnabled(GLenum glCap, BOOL bEnable);
+    BOOL IsEnabled(GLenum glCap);
+
+    void   BindTexture(GLuint gluTexture);
+    GLuint GetBoundTexture();
+    void   ReleaseTexture(GLuint gluTexture);
+
+    void BlendFunc(GLenum glSourceFactor, GLenum glDestFactor);
+    void GetBlendFunc(GLenum* pglSourceFactor, GLenum* pglDestFactor);
+    void SetBlendFuncSeparate(GS_PFNBLENDFUNCSEPARATEPROC pfnBlendFuncSeparate);
+
+    void Color(GLfloat glfRed, GLfloat glfGreen, GLfloat glfBlue, GLfloat glfAlpha);
+    void Scissor(GLint gliLeft, GLint gliBottom, GLsizei glsWidth, GLsizei glsHeight);
+
+    void ClearColor(GLfloat glfRed, GLfloat glfGreen, GLfloat glfBlue, GLfloat glfAlpha);
+    void GetClearColor(GLfloat* pglfColor);
+
+    void Reset();
+
+    void Activate(BOOL bActivate = TRUE);
+    void EnableCaching(BOOL bEnable = TRUE);
+    BOOL IsCachingEnabled();
+
+    int  GetNumCalls();
+    int  GetNumSkipped();
+    void ResetStats();
+
+    static GS_OGLState* GetActive();
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
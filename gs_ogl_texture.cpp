@@ -15,6 +15,7 @@
 // Include Game System (GS) header files.
 // ---------------------------------------------------------------------------------------------
 #include "gs_ogl_texture.h"
+#include "gs_ogl_state.h"
 //==============================================================================================
 
 
@@ -95,17 +96,54 @@ BOOL GS_OGLTexture::Create(const char* pszFilename, GS_TextureType gsTextureType
         return FALSE;
     }
 
+    BOOL bResult = this->Create(&m_gsImage, gsTextureType, glMinFilter, glMagFilter);
+
+    // Free all memory allocated to the texture image.
+    m_gsImage.Destroy();
+
+    return bResult;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLTexture::Create():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Creates the texture from an image that has already been loaded, for example by
+//          GS_AssetLoader on a worker thread. The image is left as it is.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if failed.
+//==============================================================================================
+
+BOOL GS_OGLTexture::Create(GS_OGLImage* pImage, GS_TextureType gsTextureType, GLint glMinFilter,
+                           GLint glMagFilter)
+{
+
+    // Do we have a valid image?
+    if (!pImage || !pImage->GetData())
+    {
+        return FALSE;
+    }
+
+    // Destroy the old texture before creating a new one.
+    if (m_gsTextureInfo.bIsReady)
+    {
+        this->Destroy();
+    }
+
     // Save the texture image attributes.
-    m_gsTextureInfo.nWidth    = m_gsImage.GetWidth();
-    m_gsTextureInfo.nHeight   = m_gsImage.GetHeight();
-    m_gsTextureInfo.nBpp      = m_gsImage.GetColorBytes();
-    m_gsTextureInfo.bHasAlpha = m_gsImage.HasAlpha();
+    m_gsTextureInfo.nWidth    = pImage->GetWidth();
+    m_gsTextureInfo.nHeight   = pImage->GetHeight();
+    m_gsTextureInfo.nBpp      = pImage->GetColorBytes();
+    m_gsTextureInfo.bHasAlpha = pImage->HasAlpha();
 
     // Generate an OpenGL texture ID for one texture.
     glGenTextures(1, &m_gsTextureInfo.glID);
 
     // Bind the texture ID to the texture.
-    glBindTexture(GL_TEXTURE_2D, m_gsTextureInfo.glID);
+    GS_OGLState::GetActive()->BindTexture(m_gsTextureInfo.glID);
 
     // Determine the color format of the image. GL_RGB tells OpenGL the image data is made up of
     // red, green and blue data in that order, GL_RGBA includes an alpha channel.
@@ -138,7 +176,7 @@ BOOL GS_OGLTexture::Create(const char* pszFilename, GS_TextureType gsTextureType
         // bytes, and finally... a pointer that tells OpenGL where to get the actual texture data.
         glTexImage2D(GL_TEXTURE_2D, 0, m_gsTextureInfo.nBpp, m_gsTextureInfo.nWidth,
                      m_gsTextureInfo.nHeight, 0, m_gsTextureInfo.glFormat, GL_UNSIGNED_BYTE,
-                     m_gsImage.GetData());
+                     pImage->GetData());
     }
     else
     {
@@ -154,12 +192,9 @@ BOOL GS_OGLTexture::Create(const char* pszFilename, GS_TextureType gsTextureType
         // proper width and height.
         gluBuild2DMipmaps(GL_TEXTURE_2D, m_gsTextureInfo.nBpp, m_gsTextureInfo.nWidth,
                           m_gsTextureInfo.nHeight, m_gsTextureInfo.glFormat, GL_UNSIGNED_BYTE,
-                          m_gsImage.GetData());
+                          pImage->GetData());
     }
 
-    // Free all memory allocated to the texture image.
-    m_gsImage.Destroy();
-
     // Texture was successfully created.
     m_gsTextureInfo.bIsReady = TRUE;
 
@@ -234,7 +269,7 @@ BOOL GS_OGLTexture::Create(const char* pszFilename, GS_TextureType gsTextureType
    glGenTextures(1, &m_gsTextureInfo.glID);
 
    // Bind the texture ID to the texture.
-   glBindTexture(GL_TEXTURE_2D, m_gsTextureInfo.glID);
+   GS_OGLState::GetActive()->BindTexture(m_gsTextureInfo.glID);
 
    // Determine the color format of the image. GL_RGB tells OpenGL the image data is made up of
    // red, green and blue data in that order, GL_RGBA includes an alpha channel.
@@ -318,6 +353,7 @@ void GS_OGLTexture::Destroy()
     }
 
     glDeleteTextures(1, &m_gsTextureInfo.glID);
+    GS_OGLState::GetActive()->ReleaseTexture(m_gsTextureInfo.glID);
 
     ZeroMemory(&m_gsTextureInfo, sizeof(GS_TextureInfo));
 
@@ -95,6 +95,8 @@ public:
 
     BOOL Create(const char* pszFilename, GS_TextureType gsTextureType = GS_MIPMAP,
                 GLint glMinFilter = GL_LINEAR, GLint glMagFilter = GL_LINEAR);
+    BOOL Create(GS_OGLImage* pImage, GS_TextureType gsTextureType = GS_MIPMAP,
+                GLint glMinFilter = GL_LINEAR, GLint glMagFilter = GL_LINEAR);
     // BOOL CreateFromBMP(const char* pszFilename, GS_TextureType gsTextureType = GS_MIPMAP,
     //                    GLint glMinFilter = GL_LINEAR, GLint glMagFilter = GL_LINEAR);
 
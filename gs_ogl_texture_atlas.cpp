@@ -0,0 +1,616 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_texture_atlas.cpp, gs_ogl_texture_atlas.h                                    |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_TextureAtlas                                                                     |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Packs small images into a few large textures (pages), so that sprites, fonts, menus |
+ |        and particles using different images can share a texture and be drawn together.     |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_ogl_texture_atlas.h"
+#include "gs_ogl_state.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Static members.
+// ---------------------------------------------------------------------------------------------
+GS_TextureAtlas* GS_TextureAtlas::m_pActiveAtlas = NULL;
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor/Destructor Methods //////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureAtlas::GS_TextureAtlas():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The constructor, initializes class data when class object is created.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_TextureAtlas::GS_TextureAtlas()
+{
+
+    m_nPageWidth  = 0;
+    m_nPageHeight = 0;
+    m_nPadding    = 0;
+
+    m_bIsBuilt    = FALSE;
+    m_bIsFiltered = FALSE;
+    m_bIsReady    = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureAtlas::~GS_TextureAtlas():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The de-structor, de-initializes class data when class object is destroyed.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_TextureAtlas::~GS_TextureAtlas()
+{
+
+    this->Destroy();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Create/Destroy Methods. /////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureAtlas::Create():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Prepares an empty atlas with pages of the specified dimensions (which should be
+//          powers of two). The padding is a border of repeated edge pixels around every image
+//          that keeps filtering from blending in the neighbouring images.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_TextureAtlas::Create(int nPageWidth, int nPageHeight, int nPadding)
+{
+
+    // Destroy atlas if created previously.
+    this->Destroy();
+
+    if ((nPageWidth <= 0) || (nPageHeight <= 0) || (nPadding < 0))
+    {
+        return FALSE;
+    }
+
+    m_nPageWidth  = nPageWidth;
+    m_nPageHeight = nPageHeight;
+    m_nPadding    = nPadding;
+
+    m_bIsReady = TRUE;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureAtlas::Destroy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Destroys all pages and forgets all images, and deactivates the atlas.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_TextureAtlas::Destroy()
+{
+
+    this->Activate(FALSE);
+
+    for (int nLoop = 0; nLoop < m_gsPages.GetNumItems(); nLoop++)
+    {
+        GS_AtlasPage* pPage = m_gsPages.GetItem(nLoop);
+
+        if (pPage->gluTexture != 0)
+        {
+            glDeleteTextures(1, &pPage->gluTexture);
+            GS_OGLState::GetActive()->ReleaseTexture(pPage->gluTexture);
+        }
+
+        GS_SAFE_DELETE_ARRAY(pPage->pPixels);
+        GS_SAFE_DELETE(pPage);
+    }
+
+    for (int nLoop = 0; nLoop < m_gsImages.GetNumItems(); nLoop++)
+    {
+        GS_AtlasImage* pImage = m_gsImages.GetItem(nLoop);
+        GS_SAFE_DELETE(pImage);
+    }
+
+    m_gsPages.RemoveAllItems();
+    m_gsImages.RemoveAllItems();
+
+    m_nPageWidth  = 0;
+    m_nPageHeight = 0;
+    m_nPadding    = 0;
+
+    m_bIsBuilt    = FALSE;
+    m_bIsFiltered = FALSE;
+    m_bIsReady    = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Packing Methods. ////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureAtlas::AddImage():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Loads the image from the specified file (BMP, PCX or TGA) and packs it into one of
+//          the pages. Images can only be added before the atlas is built, and adding an image
+//          that is already in the atlas does nothing. Images of sprites scrolled with
+//          AddScrollX()/AddScrollY() should not be added, scrolling would show the neighbouring
+//          images.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if the image couldn't be loaded or doesn't fit a page.
+//==============================================================================================
+
+BOOL GS_TextureAtlas::AddImage(const char* pszFilename)
+{
+
+    if (!m_bIsReady || m_bIsBuilt || !pszFilename)
+    {
+        return FALSE;
+    }
+
+    char szFilename[_MAX_PATH];
+
+    strncpy(szFilename, pszFilename, _MAX_PATH - 1);
+    szFilename[_MAX_PATH - 1] = 0;
+    GS_Platform::NormalizePath(szFilename);
+
+    // Is the image already in the atlas?
+    if (this->FindImage(szFilename) != NULL)
+    {
+        return TRUE;
+    }
+
+    GS_OGLImage gsImage;
+
+    if (!gsImage.Load(szFilename))
+    {
+        GS_Error::Report("GS_OGL_TEXTURE_ATLAS.CPP", 202, "Failed to load atlas image!");
+        return FALSE;
+    }
+
+    int nPage, nX, nY;
+
+    // Find room for the image and its padding.
+    if (!this->PlaceImage(gsImage.GetWidth() + (m_nPadding * 2),
+                          gsImage.GetHeight() + (m_nPadding * 2), &nPage, &nX, &nY))
+    {
+        GS_Error::Report("GS_OGL_TEXTURE_ATLAS.CPP", 212, "Image does not fit an atlas page!");
+        return FALSE;
+    }
+
+    GS_AtlasImage* pImage = new GS_AtlasImage;
+
+    if (NULL == pImage)
+    {
+        GS_Error::Report("GS_OGL_TEXTURE_ATLAS.CPP", 220, "Failed to allocate atlas image!");
+        return FALSE;
+    }
+
+    this->CopyImage(&gsImage, m_gsPages.GetItem(nPage), nX, nY);
+
+    strcpy(pImage->szFilename, szFilename);
+    pImage->nPage            = nPage;
+    pImage->ImageRect.left   = nX + m_nPadding;
+    pImage->ImageRect.bottom = nY + m_nPadding;
+    pImage->ImageRect.right  = pImage->ImageRect.left + gsImage.GetWidth();
+    pImage->ImageRect.top    = pImage->ImageRect.bottom + gsImage.GetHeight();
+
+    m_gsImages.AddItem(pImage);
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureAtlas::Build():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Uploads all pages as OpenGL textures and frees their pixels. Filtered pages use
+//          linear filtering, unfiltered pages nearest filtering. Pages are never mipmapped, as
+//          smaller mipmaps would blend the images together.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_TextureAtlas::Build(BOOL bFiltered)
+{
+
+    if (!m_bIsReady || m_bIsBuilt)
+    {
+        return FALSE;
+    }
+
+    GLint glFilter = bFiltered ? GL_LINEAR : GL_NEAREST;
+
+    for (int nLoop = 0; nLoop < m_gsPages.GetNumItems(); nLoop++)
+    {
+        GS_AtlasPage* pPage = m_gsPages.GetItem(nLoop);
+
+        glGenTextures(1, &pPage->gluTexture);
+        GS_OGLState::GetActive()->BindTexture(pPage->gluTexture);
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, glFilter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, glFilter);
+
+        glTexImage2D(GL_TEXTURE_2D, 0, 4, m_nPageWidth, m_nPageHeight, 0, GL_RGBA,
+                     GL_UNSIGNED_BYTE, pPage->pPixels);
+
+        GS_SAFE_DELETE_ARRAY(pPage->pPixels);
+    }
+
+    GS_OGLState::GetActive()->BindTexture(0);
+
+    m_bIsBuilt    = TRUE;
+    m_bIsFiltered = bFiltered;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureAtlas::GetRegion():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Looks up where the image loaded from the specified file ended up in the atlas.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the image is in the (built) atlas, FALSE if not.
+//==============================================================================================
+
+BOOL GS_TextureAtlas::GetRegion(const char* pszFilename, GS_AtlasRegion* pRegion)
+{
+
+    if (!m_bIsBuilt || !pszFilename || !pRegion)
+    {
+        return FALSE;
+    }
+
+    char szFilename[_MAX_PATH];
+
+    strncpy(szFilename, pszFilename, _MAX_PATH - 1);
+    szFilename[_MAX_PATH - 1] = 0;
+    GS_Platform::NormalizePath(szFilename);
+
+    GS_AtlasImage* pImage = this->FindImage(szFilename);
+
+    if (NULL == pImage)
+    {
+        return FALSE;
+    }
+
+    pRegion->gluTexture  = m_gsPages.GetItem(pImage->nPage)->gluTexture;
+    pRegion->nPageWidth  = m_nPageWidth;
+    pRegion->nPageHeight = m_nPageHeight;
+    pRegion->ImageRect   = pImage->ImageRect;
+    pRegion->bFiltered   = m_bIsFiltered;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureAtlas::FindImage():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The image loaded from the specified (normalized) file, NULL if there is none.
+//==============================================================================================
+
+GS_AtlasImage* GS_TextureAtlas::FindImage(const char* pszFilename)
+{
+
+    for (int nLoop = 0; nLoop < m_gsImages.GetNumItems(); nLoop++)
+    {
+        if (strcmp(m_gsImages.GetItem(nLoop)->szFilename, pszFilename) == 0)
+        {
+            return m_gsImages.GetItem(nLoop);
+        }
+    }
+
+    return NULL;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureAtlas::PlaceImage():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Finds room for an image of the specified size. Images are placed next to each other
+//          on shelves, a new shelf is started above the current one once an image doesn't fit
+//          next to the others and a new page is started once the last page is full.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if room was found, FALSE if the image is larger than a page.
+//==============================================================================================
+
+BOOL GS_TextureAtlas::PlaceImage(int nWidth, int nHeight, int* pPageIndex, int* pX, int* pY)
+{
+
+    if ((nWidth > m_nPageWidth) || (nHeight > m_nPageHeight))
+    {
+        return FALSE;
+    }
+
+    int nNumPages = m_gsPages.GetNumItems();
+
+    for (int nLoop = 0; nLoop < nNumPages; nLoop++)
+    {
+        GS_AtlasPage* pPage = m_gsPages.GetItem(nLoop);
+
+        // Does the image fit next to the others on the current shelf?
+        if ((pPage->nShelfX + nWidth > m_nPageWidth) ||
+            (pPage->nShelfY + nHeight > m_nPageHeight))
+        {
+            // Only start new shelves on the last page, the earlier pages are full.
+            if ((nLoop != nNumPages - 1) ||
+                (pPage->nShelfY + pPage->nShelfHeight + nHeight > m_nPageHeight))
+            {
+                continue;
+            }
+
+            pPage->nShelfY += pPage->nShelfHeight;
+            pPage->nShelfX = 0;
+            pPage->nShelfHeight = 0;
+        }
+
+        *pPageIndex = nLoop;
+        *pX = pPage->nShelfX;
+        *pY = pPage->nShelfY;
+
+        pPage->nShelfX += nWidth;
+
+        if (nHeight > pPage->nShelfHeight)
+        {
+            pPage->nShelfHeight = nHeight;
+        }
+
+        return TRUE;
+    }
+
+    // Start a new page.
+    GS_AtlasPage* pPage = new GS_AtlasPage;
+
+    if (NULL == pPage)
+    {
+        return FALSE;
+    }
+
+    pPage->pPixels = new BYTE[m_nPageWidth * m_nPageHeight * 4];
+
+    if (NULL == pPage->pPixels)
+    {
+        GS_SAFE_DELETE(pPage);
+        return FALSE;
+    }
+
+    memset(pPage->pPixels, 0, m_nPageWidth * m_nPageHeight * 4);
+
+    pPage->gluTexture   = 0;
+    pPage->nShelfX      = nWidth;
+    pPage->nShelfY      = 0;
+    pPage->nShelfHeight = nHeight;
+
+    m_gsPages.AddItem(pPage);
+
+    *pPageIndex = nNumPages;
+    *pX = 0;
+    *pY = 0;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureAtlas::CopyImage():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Copies the image into the page with its bottom left padding corner at the specified
+//          position, converting it to RGBA and repeating its edge pixels into the padding.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_TextureAtlas::CopyImage(GS_OGLImage* pImage, GS_AtlasPage* pPage, int nX, int nY)
+{
+
+    int nWidth  = pImage->GetWidth();
+    int nHeight = pImage->GetHeight();
+    int nBpp    = pImage->GetColorBytes();
+
+    const BYTE* pSource = pImage->GetData();
+
+    for (int nRow = -m_nPadding; nRow < nHeight + m_nPadding; nRow++)
+    {
+        // Rows in the padding repeat the nearest edge row.
+        int nSourceRow = (nRow < 0) ? 0 : ((nRow >= nHeight) ? nHeight - 1 : nRow);
+
+        BYTE* pDest = pPage->pPixels +
+                      ((((nY + m_nPadding + nRow) * m_nPageWidth) + nX) * 4);
+
+        for (int nCol = -m_nPadding; nCol < nWidth + m_nPadding; nCol++)
+        {
+            int nSourceCol = (nCol < 0) ? 0 : ((nCol >= nWidth) ? nWidth - 1 : nCol);
+
+            const BYTE* pPixel = pSource + (((nSourceRow * nWidth) + nSourceCol) * nBpp);
+
+            pDest[0] = pPixel[0];
+            pDest[1] = pPixel[1];
+            pDest[2] = pPixel[2];
+            pDest[3] = (nBpp == 4) ? pPixel[3] : 255;
+            pDest += 4;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Status Methods. /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureAtlas::GetNumImages():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of images in the atlas.
+//==============================================================================================
+
+int GS_TextureAtlas::GetNumImages()
+{
+
+    return m_gsImages.GetNumItems();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureAtlas::GetNumPages():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of pages in the atlas.
+//==============================================================================================
+
+int GS_TextureAtlas::GetNumPages()
+{
+
+    return m_gsPages.GetNumItems();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureAtlas::IsReady():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the atlas has been created, FALSE if not.
+//==============================================================================================
+
+BOOL GS_TextureAtlas::IsReady()
+{
+
+    return m_bIsReady;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureAtlas::IsBuilt():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the pages have been uploaded, FALSE if not.
+//==============================================================================================
+
+BOOL GS_TextureAtlas::IsBuilt()
+{
+
+    return m_bIsBuilt;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureAtlas::Activate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Makes this the atlas that sprites, fonts, menus, maps and particles look for their
+//          images in when they are created from a file, or stops using this atlas. Objects
+//          whose image is in the atlas use the page holding it instead of their own texture.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_TextureAtlas::Activate(BOOL bActivate)
+{
+
+    if (bActivate)
+    {
+        m_pActiveAtlas = this;
+    }
+    else if (m_pActiveAtlas == this)
+    {
+        m_pActiveAtlas = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureAtlas::GetActive():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The active texture atlas, NULL if there is none.
+//==============================================================================================
+
+GS_TextureAtlas* GS_TextureAtlas::GetActive()
+{
+
+    return m_pActiveAtlas;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
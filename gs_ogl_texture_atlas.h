@@ -0,0 +1,149 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_texture_atlas.cpp, gs_ogl_texture_atlas.h                                    |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_TextureAtlas                                                                     |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Packs small images into a few large textures (pages), so that sprites, fonts, menus |
+ |        and particles using different images can share a texture and be drawn together.     |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+#ifndef GS_OGL_TEXTURE_ATLAS_H
+#define GS_OGL_TEXTURE_ATLAS_H
+
+
+//==============================================================================================
+// Include platform abstraction header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_platform.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include OpenGL header files.
+// ---------------------------------------------------------------------------------------------
+#ifdef __APPLE__
+    #include <OpenGL/gl.h>
+#else
+    #include <GL/gl.h>
+#endif
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_error.h"
+#include "gs_object.h"
+#include "gs_list.h"
+#include "gs_ogl_image.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Texture atlas defines.
+// ---------------------------------------------------------------------------------------------
+#define GS_ATLAS_DEFAULT_PAGE_SIZE 1024 // Default width and height of the atlas pages.
+#define GS_ATLAS_DEFAULT_PADDING      1 // Default border of repeated edge pixels per image.
+//==============================================================================================
+
+
+//==============================================================================================
+// Atlas region structure, where an image ended up in the atlas.
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_ATLAS_REGION
+{
+    GLuint gluTexture; // The OpenGL texture of the page holding the image.
+    int nPageWidth;    // The dimensions of the page.
+    int nPageHeight;
+    RECT ImageRect;    // The image in page pixels ((0,0) is the bottom left of the page).
+    BOOL bFiltered;    // Wether the page uses linear filtering (pages are never mipmapped).
+} GS_AtlasRegion;
+//==============================================================================================
+
+
+//==============================================================================================
+// Atlas image and page structures.
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_ATLAS_IMAGE
+{
+    char szFilename[_MAX_PATH]; // The normalized path of the image.
+    int  nPage;                 // The page holding the image.
+    RECT ImageRect;             // The image in page pixels.
+} GS_AtlasImage;
+
+typedef struct GS_ATLAS_PAGE
+{
+    BYTE*  pPixels;      // RGBA pixels of the page until it is uploaded.
+    GLuint gluTexture;   // The OpenGL texture of the page once it is uploaded.
+    int    nShelfX;      // Where the next image goes on the current shelf.
+    int    nShelfY;      // The bottom of the current shelf.
+    int    nShelfHeight; // The height of the tallest image on the current shelf.
+} GS_AtlasPage;
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_TextureAtlas : public GS_Object
+{
+
+private:
+
+    GS_List<GS_AtlasImage*> m_gsImages; // All images added to the atlas.
+    GS_List<GS_AtlasPage*>  m_gsPages;  // All pages of the atlas.
+
+    int m_nPageWidth;  // The dimensions of every page.
+    int m_nPageHeight;
+    int m_nPadding;    // Border of repeated edge pixels around every image.
+
+    BOOL m_bIsBuilt;    // Wether the pages have been uploaded.
+    BOOL m_bIsFiltered; // Wether the pages use linear filtering.
+    BOOL m_bIsReady;    // Wether the atlas has been created.
+
+    static GS_TextureAtlas* m_pActiveAtlas; // The atlas objects look for their images in.
+
+    GS_AtlasImage* FindImage(const char* pszFilename);
+    BOOL PlaceImage(int nWidth, int nHeight, int* pPageIndex, int* pX, int* pY);
+    void CopyImage(GS_OGLImage* pImage, GS_AtlasPage* pPage, int nX, int nY);
+
+protected:
+
+    // No protected members.
+
+public:
+
+    GS_TextureAtlas();
+    ~GS_TextureAtlas();
+
+    BOOL Create(int nPageWidth = GS_ATLAS_DEFAULT_PAGE_SIZE,
+                int nPageHeight = GS_ATLAS_DEFAULT_PAGE_SIZE,
+                int nPadding = GS_ATLAS_DEFAULT_PADDING);
+    void Destroy();
+
+    BOOL AddImage(const char* pszFilename);
+    BOOL Build(BOOL bFiltered = FALSE);
+
+    BOOL GetRegion(const char* pszFilename, GS_AtlasRegion* pRegion);
+
+    int GetNumImages();
+    int GetNumPages();
+
+    BOOL IsReady();
+    BOOL IsBuilt();
+
+    void Activate(BOOL bActivate = TRUE);
+
+    static GS_TextureAtlas* GetActive();
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,346 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_texture_cache.cpp, gs_ogl_texture_cache.h                                    |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_TextureCache                                                                     |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Shares textures loaded from the same file between objects, so that each file is     |
+ |        only decoded and uploaded once. Textures are reference counted and destroyed once   |
+ |        the last object using them releases them.                                           |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_ogl_texture_cache.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Static members.
+// ---------------------------------------------------------------------------------------------
+GS_TextureCache* GS_TextureCache::m_pActiveCache = NULL;
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor/Destructor Methods //////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureCache::GS_TextureCache():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The constructor, initializes class data when class object is created.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_TextureCache::GS_TextureCache()
+{
+
+    // Nothing to initialize, the list starts out empty.
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureCache::~GS_TextureCache():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The de-structor, de-initializes class data when class object is destroyed.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_TextureCache::~GS_TextureCache()
+{
+
+    this->Destroy();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Destroy Methods. ////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureCache::Destroy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Destroys all textures in the cache, whether they have been released or not, and
+//          deactivates the cache. Must be called while the OpenGL context still exists.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_TextureCache::Destroy()
+{
+
+    for (int nLoop = 0; nLoop < m_gsEntries.GetNumItems(); nLoop++)
+    {
+        GS_TextureCacheEntry* pEntry = m_gsEntries.GetItem(nLoop);
+        GS_SAFE_DELETE(pEntry->pTexture);
+        GS_SAFE_DELETE(pEntry);
+    }
+
+    m_gsEntries.RemoveAllItems();
+
+    this->Activate(FALSE);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Acquire/Release Methods. ////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureCache::Acquire():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Returns the texture created from the specified file with the specified settings,
+//          creating it if it isn't in the cache yet. Every call must be matched by a call to
+//          Release() once the texture is no longer used.
+// ---------------------------------------------------------------------------------------------
+// Returns: A pointer to the texture, NULL if the texture could not be created.
+//==============================================================================================
+
+GS_OGLTexture* GS_TextureCache::Acquire(const char* pszFilename, GS_TextureType gsTextureType,
+                                        GLint glMinFilter, GLint glMagFilter)
+{
+
+    // Do we have a valid filename?
+    if (!pszFilename)
+    {
+        return NULL;
+    }
+
+    char szFilename[_MAX_PATH];
+
+    // Different spellings of the same path should share the texture.
+    strncpy(szFilename, pszFilename, _MAX_PATH - 1);
+    szFilename[_MAX_PATH - 1] = 0;
+    GS_Platform::NormalizePath(szFilename);
+
+    int nIndex = this->FindEntry(szFilename, gsTextureType, glMinFilter, glMagFilter);
+
+    // Is the texture already in the cache?
+    if (nIndex != -1)
+    {
+        GS_TextureCacheEntry* pEntry = m_gsEntries.GetItem(nIndex);
+        pEntry->nRefCount++;
+        return pEntry->pTexture;
+    }
+
+    GS_TextureCacheEntry* pEntry = new GS_TextureCacheEntry;
+
+    if (NULL == pEntry)
+    {
+        GS_Error::Report("GS_OGL_TEXTURE_CACHE.CPP", 150, "Failed to allocate cache entry!");
+        return NULL;
+    }
+
+    pEntry->pTexture = new GS_OGLTexture;
+
+    if ((NULL == pEntry->pTexture) ||
+        !pEntry->pTexture->Create(szFilename, gsTextureType, glMinFilter, glMagFilter))
+    {
+        GS_SAFE_DELETE(pEntry->pTexture);
+        GS_SAFE_DELETE(pEntry);
+        return NULL;
+    }
+
+    strcpy(pEntry->szFilename, szFilename);
+    pEntry->gsTextureType = gsTextureType;
+    pEntry->glMinFilter   = glMinFilter;
+    pEntry->glMagFilter   = glMagFilter;
+    pEntry->nRefCount     = 1;
+
+    m_gsEntries.AddItem(pEntry);
+
+    return pEntry->pTexture;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureCache::Release():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Releases a texture returned by Acquire(), destroying the texture once it has been
+//          released as many times as it was acquired. Textures not in the cache (for example
+//          because the cache has been destroyed since) are ignored.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_TextureCache::Release(GS_OGLTexture* pTexture)
+{
+
+    if (NULL == pTexture)
+    {
+        return;
+    }
+
+    for (int nLoop = 0; nLoop < m_gsEntries.GetNumItems(); nLoop++)
+    {
+        GS_TextureCacheEntry* pEntry = m_gsEntries.GetItem(nLoop);
+
+        if (pEntry->pTexture != pTexture)
+        {
+            continue;
+        }
+
+        // Is the texture still in use?
+        if (--pEntry->nRefCount > 0)
+        {
+            return;
+        }
+
+        GS_SAFE_DELETE(pEntry->pTexture);
+        GS_SAFE_DELETE(pEntry);
+        m_gsEntries.RemoveIndex(nLoop);
+
+        return;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureCache::FindEntry():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Looks for a texture created from the specified (normalized) file with the
+//          specified settings.
+// ---------------------------------------------------------------------------------------------
+// Returns: The index of the entry in the list, -1 if there is no such entry.
+//==============================================================================================
+
+int GS_TextureCache::FindEntry(const char* pszFilename, GS_TextureType gsTextureType,
+                               GLint glMinFilter, GLint glMagFilter)
+{
+
+    for (int nLoop = 0; nLoop < m_gsEntries.GetNumItems(); nLoop++)
+    {
+        GS_TextureCacheEntry* pEntry = m_gsEntries.GetItem(nLoop);
+
+        if ((pEntry->gsTextureType == gsTextureType) && (pEntry->glMinFilter == glMinFilter) &&
+            (pEntry->glMagFilter == glMagFilter) && (strcmp(pEntry->szFilename, pszFilename) == 0))
+        {
+            return nLoop;
+        }
+    }
+
+    return -1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Status Methods. /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureCache::GetNumTextures():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of textures in the cache.
+//==============================================================================================
+
+int GS_TextureCache::GetNumTextures()
+{
+
+    return m_gsEntries.GetNumItems();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureCache::GetRefCount():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: How many times the texture has been acquired but not released, 0 if the texture is
+//          not in the cache.
+//==============================================================================================
+
+int GS_TextureCache::GetRefCount(GS_OGLTexture* pTexture)
+{
+
+    for (int nLoop = 0; nLoop < m_gsEntries.GetNumItems(); nLoop++)
+    {
+        if (m_gsEntries.GetItem(nLoop)->pTexture == pTexture)
+        {
+            return m_gsEntries.GetItem(nLoop)->nRefCount;
+        }
+    }
+
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureCache::Activate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Makes this the cache that sprites, fonts, menus, maps and particles load their
+//          textures from when they are created from a file, or stops using this cache.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_TextureCache::Activate(BOOL bActivate)
+{
+
+    if (bActivate)
+    {
+        m_pActiveCache = this;
+    }
+    else if (m_pActiveCache == this)
+    {
+        m_pActiveCache = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_TextureCache::GetActive():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The active texture cache, NULL if there is none.
+//==============================================================================================
+
+GS_TextureCache* GS_TextureCache::GetActive()
+{
+
+    return m_pActiveCache;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,105 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_texture_cache.cpp, gs_ogl_texture_cache.h                                    |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_TextureCache                                                                     |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Shares textures loaded from the same file between objects, so that each file is     |
+ |        only decoded and uploaded once. Textures are reference counted and destroyed once   |
+ |        the last object using them releases them.                                           |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+#ifndef GS_OGL_TEXTURE_CACHE_H
+#define GS_OGL_TEXTURE_CACHE_H
+
+
+//==============================================================================================
+// Include platform abstraction header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_platform.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include OpenGL header files.
+// ---------------------------------------------------------------------------------------------
+#ifdef __APPLE__
+    #include <OpenGL/gl.h>
+#else
+    #include <GL/gl.h>
+#endif
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_error.h"
+#include "gs_object.h"
+#include "gs_list.h"
+#include "gs_ogl_texture.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Texture cache entry structure.
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_TEXTURE_CACHE_ENTRY
+{
+    char szFilename[_MAX_PATH];    // The normalized path of the texture image.
+    GS_TextureType gsTextureType;  // The texture settings the texture was created with.
+    GLint glMinFilter;
+    GLint glMagFilter;
+    GS_OGLTexture* pTexture;       // The shared texture.
+    int nRefCount;                 // Number of objects using the texture.
+} GS_TextureCacheEntry;
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_TextureCache : public GS_Object
+{
+
+private:
+
+    GS_List<GS_TextureCacheEntry*> m_gsEntries; // All textures in the cache.
+
+    static GS_TextureCache* m_pActiveCache; // The cache objects load their textures from.
+
+    int FindEntry(const char* pszFilename, GS_TextureType gsTextureType, GLint glMinFilter,
+                  GLint glMagFilter);
+
+protected:
+
+    // No protected members.
+
+public:
+
+    GS_TextureCache();
+    ~GS_TextureCache();
+
+    void Destroy();
+
+    GS_OGLTexture* Acquire(const char* pszFilename, GS_TextureType gsTextureType = GS_MIPMAP,
+                           GLint glMinFilter = GL_LINEAR, GLint glMagFilter = GL_LINEAR);
+    void Release(GS_OGLTexture* pTexture);
+
+    int GetNumTextures();
+    int GetRefCount(GS_OGLTexture* pTexture);
+
+    void Activate(BOOL bActivate = TRUE);
+
+    static GS_TextureCache* GetActive();
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -63,6 +63,39 @@ unsigned long GetTickCount() {
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+//==============================================================================================
+// GS_Platform::GetPerformanceCounter():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Returns the value of the high resolution monotonic counter (clock_gettime() with
+//          CLOCK_MONOTONIC on Linux, mach_absolute_time() on macOS).
+// ---------------------------------------------------------------------------------------------
+// Returns: The current counter value.
+//==============================================================================================
+
+unsigned long long GetPerformanceCounter() {
+    return SDL_GetPerformanceCounter();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Platform::GetPerformanceFrequency():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Returns the number of counts per second of the high resolution counter.
+// ---------------------------------------------------------------------------------------------
+// Returns: The counter frequency.
+//==============================================================================================
+
+unsigned long long GetPerformanceFrequency() {
+    return SDL_GetPerformanceFrequency();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
 // GS_Platform::Sleep():
 // ---------------------------------------------------------------------------------------------
@@ -25,6 +25,26 @@
     #define GS_PLATFORM_MACOS
 #endif
 
+// SIMD instruction set detection (from the compiler's target flags), define GS_NO_SIMD to build
+// the scalar code everywhere (to benchmark or check it on targets that have SIMD)
+#ifndef GS_NO_SIMD
+#if defined(__AVX2__)
+    #define GS_SIMD_AVX2
+    #include <immintrin.h>
+#endif
+#if defined(__SSSE3__) || defined(__AVX__)
+    #define GS_SIMD_SSSE3
+    #include <tmmintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define GS_SIMD_SSE2
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define GS_SIMD_NEON
+    #include <arm_neon.h>
+#endif
+#endif
+
 // Include appropriate headers
 #ifdef GS_PLATFORM_WINDOWS
     #define WIN32_LEAN_AND_MEAN
@@ -236,6 +256,8 @@
 // Platform-agnostic utility functions
 namespace GS_Platform {
     unsigned long GetTickCount();
+    unsigned long long GetPerformanceCounter();
+    unsigned long long GetPerformanceFrequency();
     void Sleep(unsigned long milliseconds);
     bool GetClientRect(HWND hwnd, RECT* rect);
     void SetRect(RECT* rect, int left, int top, int right, int bottom);
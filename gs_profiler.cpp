@@ -0,0 +1,761 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_profiler.cpp, gs_profiler.h                                                      |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_Profiler, GS_ProfileScope                                                        |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: A CPU frame profiler. Code marks the scopes it wants timed with GS_PROFILE_SCOPE()  |
+ |        and the renderers count their draw calls and vertices. The timings of the most      |
+ |        recent frames are kept in a ring buffer, can be shown as an overlay and can be      |
+ |        saved in the Chrome trace event format (chrome://tracing, Perfetto).                |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_profiler.h"
+#include "gs_ogl_font.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Static members.
+// ---------------------------------------------------------------------------------------------
+GS_Profiler* GS_Profiler::m_pActiveProfiler = NULL;
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor/Destructor Methods //////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Profiler::GS_Profiler():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The constructor, initializes class data when class object is created.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_Profiler::GS_Profiler()
+{
+
+    m_pFrames    = NULL;
+    m_pSamples   = NULL;
+    m_nMaxFrames = 0;
+    m_nNumFrames = 0;
+    m_nFrame     = 0;
+
+    m_nDepth  = 0;
+    m_nNextID = 1;
+
+    m_ThreadID   = std::thread::id();
+    m_bIsInFrame = false;
+    m_bIsEnabled = TRUE;
+    m_bIsReady   = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Profiler::~GS_Profiler():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The de-structor, de-initializes class data when class object is destroyed.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_Profiler::~GS_Profiler()
+{
+
+    this->Destroy();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Create/Destroy Methods //////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Profiler::Create():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Creates a ring buffer for the given number of frames and makes this the profiler
+//          scopes and counters are sent to.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_Profiler::Create(int nMaxFrames)
+{
+
+    if (nMaxFrames <= 0)
+    {
+        return FALSE;
+    }
+
+    // Destroy profiler if created previously.
+    if (m_bIsReady)
+    {
+        this->Destroy();
+    }
+
+    m_pFrames  = new GS_ProfileFrame[nMaxFrames];
+    m_pSamples = new GS_ProfileSample[nMaxFrames * GS_PROFILER_MAX_SCOPES];
+
+    if ((NULL == m_pFrames) || (NULL == m_pSamples))
+    {
+        this->Destroy();
+        GS_Error::Report("GS_PROFILER.CPP", 118, "Failed to allocate profiler frames!");
+        return FALSE;
+    }
+
+    for (int nLoop = 0; nLoop < nMaxFrames; nLoop++)
+    {
+        m_pFrames[nLoop].nStart        = 0;
+        m_pFrames[nLoop].nEnd          = 0;
+        m_pFrames[nLoop].nNumSamples   = 0;
+        m_pFrames[nLoop].nNumDropped   = 0;
+        m_pFrames[nLoop].nNumDrawCalls = 0;
+        m_pFrames[nLoop].nNumVertices  = 0;
+        m_pFrames[nLoop].pSamples      = &m_pSamples[nLoop * GS_PROFILER_MAX_SCOPES];
+    }
+
+    m_nMaxFrames = nMaxFrames;
+    m_nNumFrames = 0;
+    m_nFrame     = 0;
+
+    m_nDepth = 0;
+
+    m_bIsInFrame = false;
+    m_bIsReady   = TRUE;
+
+    this->Activate();
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Profiler::Destroy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_Profiler::Destroy()
+{
+
+    this->Activate(FALSE);
+
+    GS_SAFE_DELETE_ARRAY(m_pFrames);
+    GS_SAFE_DELETE_ARRAY(m_pSamples);
+
+    m_nMaxFrames = 0;
+    m_nNumFrames = 0;
+    m_nFrame     = 0;
+
+    m_nDepth = 0;
+
+    m_bIsInFrame = false;
+    m_bIsReady   = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Capture Methods /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Profiler::BeginFrame():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Starts recording a frame, overwriting the oldest frame once the ring buffer is
+//          full. Scopes are only timed on the thread that calls this.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_Profiler::BeginFrame()
+{
+
+    if ((!m_bIsReady) || (!m_bIsEnabled))
+    {
+        return;
+    }
+
+    if (m_bIsInFrame)
+    {
+        this->EndFrame();
+    }
+
+    GS_ProfileFrame* pgsFrame = &m_pFrames[m_nFrame];
+
+    pgsFrame->nNumSamples   = 0;
+    pgsFrame->nNumDropped   = 0;
+    pgsFrame->nNumDrawCalls = 0;
+    pgsFrame->nNumVertices  = 0;
+    pgsFrame->nEnd          = 0;
+    pgsFrame->nStart        = GS_Timer::GetTicks();
+
+    m_ThreadID = std::this_thread::get_id();
+    m_nDepth   = 0;
+
+    m_bIsInFrame = true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Profiler::EndFrame():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Stops recording the frame, any scope not left yet ends with it.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_Profiler::EndFrame()
+{
+
+    if (!m_bIsInFrame)
+    {
+        return;
+    }
+
+    GS_ProfileFrame* pgsFrame = &m_pFrames[m_nFrame];
+
+    pgsFrame->nEnd = GS_Timer::GetTicks();
+
+    while (m_nDepth > 0)
+    {
+        m_nDepth--;
+
+        if (m_nOpenSamples[m_nDepth] >= 0)
+        {
+            pgsFrame->pSamples[m_nOpenSamples[m_nDepth]].nEnd = pgsFrame->nEnd;
+        }
+    }
+
+    m_nFrame = (m_nFrame + 1) % m_nMaxFrames;
+
+    if (m_nNumFrames < m_nMaxFrames)
+    {
+        m_nNumFrames++;
+    }
+
+    m_bIsInFrame = false;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Profiler::BeginScope():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Enters a scope (use GS_PROFILE_SCOPE() rather than calling this directly). Scopes
+//          nested deeper than GS_PROFILER_MAX_DEPTH are not timed and scopes beyond
+//          GS_PROFILER_MAX_SCOPES in a frame are only counted.
+// ---------------------------------------------------------------------------------------------
+// Returns: The ID to pass to EndScope(), 0 if the scope is not timed.
+//==============================================================================================
+
+int GS_Profiler::BeginScope(const char* pszName)
+{
+
+    // Check the thread first, other threads must not read the frame being recorded.
+    if ((std::this_thread::get_id() != m_ThreadID) || (!m_bIsInFrame) ||
+        (m_nDepth >= GS_PROFILER_MAX_DEPTH))
+    {
+        return 0;
+    }
+
+    GS_ProfileFrame* pgsFrame = &m_pFrames[m_nFrame];
+
+    int nSample = -1;
+
+    if (pgsFrame->nNumSamples < GS_PROFILER_MAX_SCOPES)
+    {
+        nSample = pgsFrame->nNumSamples++;
+
+        GS_ProfileSample* pgsSample = &pgsFrame->pSamples[nSample];
+
+        pgsSample->pszName = pszName;
+        pgsSample->nDepth  = m_nDepth;
+        pgsSample->nParent = (m_nDepth > 0) ? m_nOpenSamples[m_nDepth - 1] : -1;
+        pgsSample->nEnd    = 0;
+        pgsSample->nStart  = GS_Timer::GetTicks();
+    }
+    else
+    {
+        pgsFrame->nNumDropped++;
+    }
+
+    // Keep the ID positive and never 0 when it wraps around.
+    int nScopeID = m_nNextID;
+    m_nNextID = (m_nNextID < 0x7FFFFFFF) ? m_nNextID + 1 : 1;
+
+    m_nOpenSamples[m_nDepth] = nSample;
+    m_nOpenIDs[m_nDepth]     = nScopeID;
+    m_nDepth++;
+
+    return nScopeID;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Profiler::EndScope():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Leaves the scope entered last. Scopes that already ended with their frame are
+//          ignored.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_Profiler::EndScope(int nScopeID)
+{
+
+    if ((std::this_thread::get_id() != m_ThreadID) || (!m_bIsInFrame) || (m_nDepth <= 0) ||
+        (m_nOpenIDs[m_nDepth - 1] != nScopeID))
+    {
+        return;
+    }
+
+    m_nDepth--;
+
+    if (m_nOpenSamples[m_nDepth] >= 0)
+    {
+        m_pFrames[m_nFrame].pSamples[m_nOpenSamples[m_nDepth]].nEnd = GS_Timer::GetTicks();
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Profiler::CountDraw():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Adds a draw call of the given number of vertices to the frame being recorded.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_Profiler::CountDraw(int nNumVertices)
+{
+
+    if ((std::this_thread::get_id() != m_ThreadID) || (!m_bIsInFrame))
+    {
+        return;
+    }
+
+    m_pFrames[m_nFrame].nNumDrawCalls++;
+    m_pFrames[m_nFrame].nNumVertices += nNumVertices;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Query Methods ///////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Profiler::GetFrame():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Gets a completed frame, 0 being the most recent one and GetNumFrames() - 1 the
+//          oldest one still in the ring buffer.
+// ---------------------------------------------------------------------------------------------
+// Returns: The frame, NULL if there is no such frame.
+//==============================================================================================
+
+const GS_ProfileFrame* GS_Profiler::GetFrame(int nAge)
+{
+
+    if ((nAge < 0) || (nAge >= m_nNumFrames))
+    {
+        return NULL;
+    }
+
+    return &m_pFrames[(m_nFrame - 1 - nAge + m_nMaxFrames) % m_nMaxFrames];
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Profiler::GetSampleTime():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The time the given scope of a frame took in milliseconds, or the time the entire
+//          frame took if nSample is -1.
+//==============================================================================================
+
+double GS_Profiler::GetSampleTime(const GS_ProfileFrame* pgsFrame, int nSample)
+{
+
+    if ((NULL == pgsFrame) || (nSample >= pgsFrame->nNumSamples))
+    {
+        return 0.0;
+    }
+
+    if (nSample < 0)
+    {
+        return GS_Timer::TicksToMs(pgsFrame->nEnd - pgsFrame->nStart);
+    }
+
+    const GS_ProfileSample* pgsSample = &pgsFrame->pSamples[nSample];
+
+    return GS_Timer::TicksToMs(pgsSample->nEnd - pgsSample->nStart);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Profiler::GetAverageFrameTime():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The average time of the frames in the ring buffer in milliseconds.
+//==============================================================================================
+
+double GS_Profiler::GetAverageFrameTime()
+{
+
+    if (m_nNumFrames <= 0)
+    {
+        return 0.0;
+    }
+
+    double dTotal = 0.0;
+
+    for (int nAge = 0; nAge < m_nNumFrames; nAge++)
+    {
+        dTotal += this->GetSampleTime(this->GetFrame(nAge), -1);
+    }
+
+    return dTotal / m_nNumFrames;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Output Methods //////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Profiler::RenderOverlay():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Lists the scopes of the most recent frame with the given font, indented by how
+//          deeply they are nested, starting with the top line at the given coordinates. Must
+//          be called between BeginRender2D() and EndRender2D().
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_Profiler::RenderOverlay(GS_OGLFont* pgsFont, int nDestX, int nDestY)
+{
+
+    const GS_ProfileFrame* pgsFrame = this->GetFrame(0);
+
+    if ((NULL == pgsFont) || (NULL == pgsFrame))
+    {
+        return FALSE;
+    }
+
+    int nLineHeight = (int) pgsFont->GetLetterHeight();
+
+    // The summary of the frame.
+    pgsFont->SetText("Frame %.2f ms (avg %.2f)  Draws %d  Verts %d",
+                     this->GetSampleTime(pgsFrame, -1), this->GetAverageFrameTime(),
+                     pgsFrame->nNumDrawCalls, pgsFrame->nNumVertices);
+    pgsFont->SetDestXY(nDestX, nDestY - nLineHeight);
+    pgsFont->Render();
+
+    // The scopes, in the order they were entered.
+    int nNumLines = pgsFrame->nNumSamples;
+
+    if (nNumLines > GS_PROFILER_MAX_LINES)
+    {
+        nNumLines = GS_PROFILER_MAX_LINES;
+    }
+
+    for (int nSample = 0; nSample < nNumLines; nSample++)
+    {
+        const GS_ProfileSample* pgsSample = &pgsFrame->pSamples[nSample];
+
+        pgsFont->SetText("%*s%s %.2f ms", (pgsSample->nDepth + 1) * 2, "", pgsSample->pszName,
+                         this->GetSampleTime(pgsFrame, nSample));
+        pgsFont->SetDestXY(nDestX, nDestY - ((nSample + 2) * nLineHeight));
+        pgsFont->Render();
+    }
+
+    // Let it be known not everything is listed.
+    int nNumHidden = (pgsFrame->nNumSamples - nNumLines) + pgsFrame->nNumDropped;
+
+    if (nNumHidden > 0)
+    {
+        pgsFont->SetText("  (%d more)", nNumHidden);
+        pgsFont->SetDestXY(nDestX, nDestY - ((nNumLines + 2) * nLineHeight));
+        pgsFont->Render();
+    }
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Profiler::SaveTrace():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Saves the frames in the ring buffer as Chrome trace event JSON, which can be opened
+//          with chrome://tracing or ui.perfetto.dev. Every frame and scope is a complete event
+//          and the draw calls and vertices of every frame a counter event.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_Profiler::SaveTrace(const char* pszFilename)
+{
+
+    if ((NULL == pszFilename) || (m_nNumFrames <= 0))
+    {
+        return FALSE;
+    }
+
+    GS_File gsFile;
+
+    if (!gsFile.Open(pszFilename, FILE_WRITE))
+    {
+        GS_Error::Report("GS_PROFILER.CPP", 560, "Failed to create trace file!");
+        return FALSE;
+    }
+
+    char szLine[512];
+    char szName[128];
+    int  nLength;
+    BOOL bIsWritten = TRUE;
+
+    // Times are in microseconds from the start of the oldest frame.
+    GS_Ticks nOrigin = this->GetFrame(m_nNumFrames - 1)->nStart;
+
+    nLength = snprintf(szLine, sizeof(szLine), "{\"traceEvents\":[\n");
+    bIsWritten &= (gsFile.Write(szLine, nLength) == (unsigned long) nLength);
+
+    for (int nAge = m_nNumFrames - 1; nAge >= 0; nAge--)
+    {
+        const GS_ProfileFrame* pgsFrame = this->GetFrame(nAge);
+
+        double dStart = GS_Timer::TicksToMs(pgsFrame->nStart - nOrigin) * 1000.0;
+
+        nLength = snprintf(szLine, sizeof(szLine),
+                           "{\"name\":\"Frame\",\"cat\":\"frame\",\"ph\":\"X\",\"ts\":%.3f,"
+                           "\"dur\":%.3f,\"pid\":1,\"tid\":1},\n"
+                           "{\"name\":\"Renderer\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,"
+                           "\"tid\":1,\"args\":{\"draw calls\":%d,\"vertices\":%d}}%s\n",
+                           dStart, this->GetSampleTime(pgsFrame, -1) * 1000.0, dStart,
+                           pgsFrame->nNumDrawCalls, pgsFrame->nNumVertices,
+                           ((nAge > 0) || (pgsFrame->nNumSamples > 0)) ? "," : "");
+        bIsWritten &= (gsFile.Write(szLine, nLength) == (unsigned long) nLength);
+
+        for (int nSample = 0; nSample < pgsFrame->nNumSamples; nSample++)
+        {
+            const GS_ProfileSample* pgsSample = &pgsFrame->pSamples[nSample];
+
+            EscapeName(pgsSample->pszName, szName, sizeof(szName));
+
+            BOOL bIsLast = (0 == nAge) && (nSample == pgsFrame->nNumSamples - 1);
+
+            nLength = snprintf(szLine, sizeof(szLine),
+                               "{\"name\":\"%s\",\"cat\":\"scope\",\"ph\":\"X\",\"ts\":%.3f,"
+                               "\"dur\":%.3f,\"pid\":1,\"tid\":1}%s\n", szName,
+                               GS_Timer::TicksToMs(pgsSample->nStart - nOrigin) * 1000.0,
+                               this->GetSampleTime(pgsFrame, nSample) * 1000.0,
+                               bIsLast ? "" : ",");
+            bIsWritten &= (gsFile.Write(szLine, nLength) == (unsigned long) nLength);
+        }
+    }
+
+    nLength = snprintf(szLine, sizeof(szLine), "],\"displayTimeUnit\":\"ms\"}\n");
+    bIsWritten &= (gsFile.Write(szLine, nLength) == (unsigned long) nLength);
+
+    gsFile.Close();
+
+    if (!bIsWritten)
+    {
+        GS_Error::Report("GS_PROFILER.CPP", 616, "Failed to write trace file!");
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Profiler::EscapeName():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Copies a scope name so it can be written as a JSON string, truncating it if it
+//          doesn't fit.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_Profiler::EscapeName(const char* pszName, char* pszEscaped, int nMaxLength)
+{
+
+    int nLength = 0;
+
+    for (const char* pChar = (pszName != NULL) ? pszName : ""; *pChar != '\0'; pChar++)
+    {
+        // Leave room for an escaped character and the terminator.
+        if (nLength + 3 > nMaxLength)
+        {
+            break;
+        }
+
+        if ((*pChar == '"') || (*pChar == '\\'))
+        {
+            pszEscaped[nLength++] = '\\';
+            pszEscaped[nLength++] = *pChar;
+        }
+        else if ((unsigned char) *pChar >= 0x20)
+        {
+            pszEscaped[nLength++] = *pChar;
+        }
+    }
+
+    pszEscaped[nLength] = '\0';
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Get/Set Methods. ////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Profiler::Enable():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Pauses or resumes recording, the ring buffer keeps the frames recorded so far so a
+//          capture can be looked at or saved while paused.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_Profiler::Enable(BOOL bEnable)
+{
+
+    if (!bEnable)
+    {
+        this->EndFrame();
+    }
+
+    m_bIsEnabled = bEnable;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Profiler::Activate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Makes this the profiler scopes and counters are sent to, or stops sending them
+//          here.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_Profiler::Activate(BOOL bActivate)
+{
+
+    if (bActivate)
+    {
+        m_pActiveProfiler = this;
+    }
+    else if (m_pActiveProfiler == this)
+    {
+        m_pActiveProfiler = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Profiler::GetActive():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The profiler scopes and counters are sent to, NULL if there is none.
+//==============================================================================================
+
+GS_Profiler* GS_Profiler::GetActive()
+{
+
+    return m_pActiveProfiler;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Profiler::CountDrawCall():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Called by the renderers for every draw call, counted by the active profiler.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_Profiler::CountDrawCall(int nNumVertices)
+{
+
+    if (m_pActiveProfiler != NULL)
+    {
+        m_pActiveProfiler->CountDraw(nNumVertices);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
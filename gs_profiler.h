@@ -0,0 +1,212 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_profiler.cpp, gs_profiler.h                                                      |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_Profiler, GS_ProfileScope                                                        |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: A CPU frame profiler. Code marks the scopes it wants timed with GS_PROFILE_SCOPE()  |
+ |        and the renderers count their draw calls and vertices. The timings of the most      |
+ |        recent frames are kept in a ring buffer, can be shown as an overlay and can be      |
+ |        saved in the Chrome trace event format (chrome://tracing, Perfetto).                |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+#ifndef GS_PROFILER_H
+#define GS_PROFILER_H
+
+
+//==============================================================================================
+// Include platform abstraction header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_platform.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include standard C++ library header files.
+// ---------------------------------------------------------------------------------------------
+#include <atomic>
+#include <thread>
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_error.h"
+#include "gs_file.h"
+#include "gs_object.h"
+#include "gs_timer.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Profiler defines.
+// ---------------------------------------------------------------------------------------------
+#define GS_PROFILER_MAX_FRAMES 120 // Default number of frames kept in the ring buffer.
+#define GS_PROFILER_MAX_SCOPES 256 // Maximum number of scopes timed per frame.
+#define GS_PROFILER_MAX_DEPTH  32  // Maximum nesting of scopes.
+#define GS_PROFILER_MAX_LINES  24  // Maximum number of scopes listed by the overlay.
+//==============================================================================================
+
+
+//==============================================================================================
+// Times the rest of the enclosing block (the name must outlive the profiler, a string literal
+// is best). Define GS_NO_PROFILER to compile every scope out.
+// ---------------------------------------------------------------------------------------------
+#define GS_PROFILE_CONCAT2(a, b) a##b
+#define GS_PROFILE_CONCAT(a, b)  GS_PROFILE_CONCAT2(a, b)
+
+#ifndef GS_NO_PROFILER
+    #define GS_PROFILE_SCOPE(name) \
+        GS_ProfileScope GS_PROFILE_CONCAT(gsProfileScope, __LINE__)(name)
+#else
+    #define GS_PROFILE_SCOPE(name)
+#endif
+//==============================================================================================
+
+
+//==============================================================================================
+// Profiler structures.
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_PROFILE_SAMPLE
+{
+    const char* pszName; // The name given to GS_PROFILE_SCOPE().
+    GS_Ticks    nStart;  // When the scope was entered.
+    GS_Ticks    nEnd;    // When the scope was left.
+    int         nDepth;  // How many scopes the scope is nested in.
+    int         nParent; // The sample of the enclosing scope, -1 if there is none.
+} GS_ProfileSample;
+
+typedef struct GS_PROFILE_FRAME
+{
+    GS_Ticks nStart;        // When the frame began.
+    GS_Ticks nEnd;          // When the frame ended.
+    int      nNumSamples;   // The scopes timed, in the order they were entered.
+    int      nNumDropped;   // The scopes that did not fit in GS_PROFILER_MAX_SCOPES.
+    int      nNumDrawCalls; // The draw calls the renderers made.
+    int      nNumVertices;  // The vertices those draw calls drew.
+    GS_ProfileSample* pSamples;
+} GS_ProfileFrame;
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_OGLFont;
+
+class GS_Profiler : public GS_Object
+{
+
+private:
+
+    static GS_Profiler* m_pActiveProfiler; // The profiler scopes and counters are sent to.
+
+    GS_ProfileFrame*  m_pFrames;  // The ring buffer of frames.
+    GS_ProfileSample* m_pSamples; // GS_PROFILER_MAX_SCOPES samples for every frame.
+    int m_nMaxFrames;
+    int m_nNumFrames;   // The number of completed frames in the ring buffer.
+    int m_nFrame;       // The frame being recorded (or recorded next).
+
+    int m_nOpenSamples[GS_PROFILER_MAX_DEPTH]; // The scopes entered but not left yet, as
+    int m_nOpenIDs[GS_PROFILER_MAX_DEPTH];     // samples (-1 if dropped) and scope IDs.
+    int m_nDepth;
+    int m_nNextID;      // Every scope entered gets an ID of its own, so scopes left after the
+                        // frame they were entered in has ended are recognized.
+
+    // Scopes may be entered on any thread but only those on the thread running the frames are
+    // timed, other threads read nothing else.
+    std::atomic<std::thread::id> m_ThreadID;
+    std::atomic<bool>            m_bIsInFrame;
+
+    BOOL m_bIsEnabled;
+    BOOL m_bIsReady;
+
+    static void EscapeName(const char* pszName, char* pszEscaped, int nMaxLength);
+
+protected:
+
+    // No protected members.
+
+public:
+
+    GS_Profiler();
+    ~GS_Profiler();
+
+    BOOL Create(int nMaxFrames = GS_PROFILER_MAX_FRAMES);
+    void Destroy();
+
+    void BeginFrame();
+    void EndFrame();
+
+    int  BeginScope(const char* pszName);
+    void EndScope(int nScopeID);
+    void CountDraw(int nNumVertices);
+
+    const GS_ProfileFrame* GetFrame(int nAge = 0);
+    double GetSampleTime(const GS_ProfileFrame* pgsFrame, int nSample);
+    double GetAverageFrameTime();
+
+    BOOL RenderOverlay(GS_OGLFont* pgsFont, int nDestX, int nDestY);
+    BOOL SaveTrace(const char* pszFilename);
+
+    void Enable(BOOL bEnable = TRUE);
+    void Activate(BOOL bActivate = TRUE);
+
+    int GetNumFrames()
+    {
+        return m_nNumFrames;
+    }
+    BOOL IsEnabled()
+    {
+        return m_bIsEnabled;
+    }
+    BOOL IsReady()
+    {
+        return m_bIsReady;
+    }
+
+    static GS_Profiler* GetActive();
+    static void CountDrawCall(int nNumVertices);
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_ProfileScope
+{
+
+private:
+
+    GS_Profiler* m_pProfiler;
+    int          m_nScopeID;
+
+public:
+
+    GS_ProfileScope(const char* pszName)
+    {
+        m_pProfiler = GS_Profiler::GetActive();
+        m_nScopeID  = (m_pProfiler != NULL) ? m_pProfiler->BeginScope(pszName) : 0;
+    }
+    ~GS_ProfileScope()
+    {
+        if (m_nScopeID != 0)
+        {
+            m_pProfiler->EndScope(m_nScopeID);
+        }
+    }
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
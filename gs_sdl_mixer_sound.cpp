@@ -45,6 +45,16 @@ GS_SDLMixerSound::GS_SDLMixerSound() {
 
     m_nCurrentMusic  = -1;
     m_nCurrentStream = -1;
+
+    for (int nLoop = 0; nLoop < GS_MIXER_MAX_SOFT_VOICES; nLoop++) {
+        m_gsVoices[nLoop].nSample = -1;
+    }
+
+    m_nNumVoices    = GS_MIXER_MAX_VOICES;
+    m_nNextOrder    = 0;
+    m_nSampleMaster = 255;
+
+    m_bIsSoftMixer = FALSE;
 }
 
 
@@ -79,13 +89,22 @@ GS_SDLMixerSound::~GS_SDLMixerSound() {
 //==============================================================================================
 // GS_SDLMixerSound::Initialize():
 // ---------------------------------------------------------------------------------------------
-// Purpose: Initializes the SDL_mixer audio system with default settings (44.1kHz, stereo,
-//          2048 byte buffer). Allocates 64 mixing channels for simultaneous sound effects.
+// Purpose: Initializes the SDL_mixer audio system (44.1kHz, stereo) with a buffer of the
+//          specified number of sample frames. Smaller buffers lower the latency of sounds but
+//          have to be mixed more often. Allocates a mixing channel for every voice, or mixes
+//          the samples with the software mixer (GS_SoftMixer) if asked to, which plays more
+//          of them at once for less work.
+// ---------------------------------------------------------------------------------------------
+// Notes: The software mixer needs the device to play 16-bit stereo, if it doesn't the samples
+//        are mixed by SDL_mixer's channels (see IsSoftMixer()). Set SDL_AUDIODRIVER to "dummy"
+//        (or to "disk", which writes the output to a file) to run without a sound card, for
+//        example to benchmark the mixing.
 // ---------------------------------------------------------------------------------------------
 // Returns: TRUE if successful, FALSE if not.
 //==============================================================================================
 
-BOOL GS_SDLMixerSound::Initialize(HWND hWnd, BOOL bNoSound) {
+BOOL GS_SDLMixerSound::Initialize(HWND hWnd, BOOL bNoSound, int nBufferSize,
+                                  BOOL bUseSoftMixer) {
 
     // Window handle not used by SDL_mixer.
     (void)hWnd;
@@ -109,14 +128,44 @@ BOOL GS_SDLMixerSound::Initialize(HWND hWnd, BOOL bNoSound) {
         }
     }
     
-    // Open the audio device with CD quality (44.1kHz, stereo, 2048 byte chunks).
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
+    // Use the default buffer size if none was given.
+    if (nBufferSize <= 0) {
+        nBufferSize = 2048;
+    }
+
+    // Open the audio device with CD quality (44.1kHz, stereo).
+    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, nBufferSize) < 0) {
         GS_Error::Report("GS_SDL_MIXER_SOUND.CPP", 95, "Failed to initialize SDL_mixer!");
         return FALSE;
     }
     
-    // Allocate 64 mixing channels for simultaneous sound effect playback.
-    Mix_AllocateChannels(64);
+    m_bIsSoftMixer = FALSE;
+    m_nNumVoices   = GS_MIXER_MAX_VOICES;
+
+    if (bUseSoftMixer) {
+        int    nFrequency;
+        Uint16 nFormat;
+        int    nChannels;
+
+        // The software mixer adds the samples to what SDL_mixer has mixed (the music and
+        // streams), which must be in the format it mixes.
+        if (Mix_QuerySpec(&nFrequency, &nFormat, &nChannels) && (nFormat == AUDIO_S16SYS) &&
+            (nChannels == 2) && m_gsSoftMixer.Create(GS_MIXER_MAX_SOFT_VOICES)) {
+            m_bIsSoftMixer = TRUE;
+            m_nNumVoices   = GS_MIXER_MAX_SOFT_VOICES;
+            Mix_SetPostMix(MixSoftVoices, this);
+        }
+    }
+
+    // Otherwise allocate a mixing channel for every voice, PlaySample() decides which one is
+    // used.
+    if (!m_bIsSoftMixer) {
+        Mix_AllocateChannels(GS_MIXER_MAX_VOICES);
+    }
+
+    for (int nLoop = 0; nLoop < GS_MIXER_MAX_SOFT_VOICES; nLoop++) {
+        m_gsVoices[nLoop].nSample = -1;
+    }
 
     m_bIsReady = TRUE;
 
@@ -159,11 +208,35 @@ BOOL GS_SDLMixerSound::Shutdown() {
     }
     m_gsStreamList.RemoveAllItems();
     
-    // Free all loaded sound samples.
+    // Stop all voices before the samples they play are freed. Once the software mixer has
+    // been removed from the audio callback it no longer runs, so it can be destroyed.
+    Mix_HaltChannel(-1);
+
+    if (m_bIsSoftMixer) {
+        Mix_SetPostMix(NULL, NULL);
+        m_gsSoftMixer.Destroy();
+        m_bIsSoftMixer = FALSE;
+    }
+
+    for (int nLoop = 0; nLoop < GS_MIXER_MAX_SOFT_VOICES; nLoop++) {
+        m_gsVoices[nLoop].nSample = -1;
+    }
+
+    m_nNumVoices = GS_MIXER_MAX_VOICES;
+
+    // Free all loaded sound samples (those shared are freed by the sample they belong to).
     for (int nLoop = 0; nLoop < m_gsSampleList.GetNumItems(); nLoop++) {
-        Mix_FreeChunk(m_gsSampleList[nLoop]);
+        if (!m_gsSampleList[nLoop].bIsShared) {
+            Mix_FreeChunk(m_gsSampleList[nLoop].pChunk);
+        }
     }
     m_gsSampleList.RemoveAllItems();
+
+    // Unmap the sound banks now that none of their samples are used.
+    for (int nLoop = 0; nLoop < m_gsBankList.GetNumItems(); nLoop++) {
+        delete m_gsBankList[nLoop];
+    }
+    m_gsBankList.RemoveAllItems();
     
     // Close the audio device.
     Mix_CloseAudio();
@@ -215,6 +288,11 @@ void GS_SDLMixerSound::Pause(BOOL bPause) {
         Mix_Resume(-1);
     }
 
+    // Pause or resume the samples of the software mixer.
+    if (m_bIsSoftMixer) {
+        m_gsSoftMixer.Pause(bPause);
+    }
+
     m_bIsPaused = bPause;
 }
 
@@ -748,7 +826,8 @@ BOOL GS_SDLMixerSound::PauseStream(BOOL bPause) {
 // GS_SDLMixerSound::AddSample():
 // ---------------------------------------------------------------------------------------------
 // Purpose: Loads a sound sample file and adds it to the sample list. WAV files are
-//          recommended for best compatibility.
+//          recommended for best compatibility. A file that has already been loaded (or is in
+//          a sound bank that has been added) isn't loaded again, the new sample shares it.
 // ---------------------------------------------------------------------------------------------
 // Returns: TRUE if successful, FALSE if not.
 //==============================================================================================
@@ -760,6 +839,13 @@ BOOL GS_SDLMixerSound::AddSample(const char* pszFilename) {
         return FALSE;
     }
 
+    // Share the sample if it has already been loaded.
+    int nIndex = this->FindSample(pszFilename);
+
+    if (nIndex >= 0) {
+        return this->AddChunk(m_gsSampleList[nIndex].pChunk, pszFilename, TRUE);
+    }
+
     Mix_Chunk* pSample;
 
     // Load the specified sample file.
@@ -767,12 +853,299 @@ BOOL GS_SDLMixerSound::AddSample(const char* pszFilename) {
 
     // Was the sample loaded successfully?
     if (!pSample) {
-        GS_Error::Report("GS_SDL_MIXER_SOUND.CPP", 745, "Failed to load sample file!");
+        GS_Error::Report("GS_SDL_MIXER_SOUND.CPP", 804, "Failed to load sample file!");
+        return FALSE;
+    }
+
+    return this->AddChunk(pSample, pszFilename, FALSE);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SDLMixerSound::AddSampleBank():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Maps a sound bank made by SaveSampleBank() into memory and adds all its samples to
+//          the sample list, in the order they were saved. The samples play straight from the
+//          mapped file, nothing is decoded, converted or copied. A bank older than any of the
+//          sample files it was made from is out of date and not added, so edited samples are
+//          loaded one by one until the bank is saved again.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if not.
+//==============================================================================================
+
+BOOL GS_SDLMixerSound::AddSampleBank(const char* pszFilename) {
+
+    // Exit if sound not initialized.
+    if (!m_bIsReady) {
+        return FALSE;
+    }
+
+    GS_FileMap* pgsBank = new GS_FileMap;
+
+    // A missing bank isn't an error, the samples can still be loaded one by one.
+    if (!pgsBank->Open(pszFilename)) {
+        delete pgsBank;
+        return FALSE;
+    }
+
+    const BYTE*   pData   = pgsBank->GetData();
+    unsigned long lLength = pgsBank->GetLength();
+
+    const GS_SoundBankHeader* pgsHeader = (const GS_SoundBankHeader*) pData;
+
+    // Is it a sound bank of this version?
+    if ((lLength < sizeof(GS_SoundBankHeader)) ||
+        (memcmp(pgsHeader->szMagic, GS_SOUND_BANK_MAGIC, 4) != 0) ||
+        (pgsHeader->nVersion != GS_SOUND_BANK_VERSION) ||
+        (pgsHeader->nNumSamples > (lLength - sizeof(GS_SoundBankHeader)) /
+                                  sizeof(GS_SoundBankEntry))) {
+        GS_Error::Report("GS_SDL_MIXER_SOUND.CPP", 851, "Invalid sound bank file!");
+        delete pgsBank;
+        return FALSE;
+    }
+
+    int    nFrequency;
+    Uint16 nFormat;
+    int    nChannels;
+
+    // The samples are played as they are, so they must be in the format the mixer plays.
+    if (!Mix_QuerySpec(&nFrequency, &nFormat, &nChannels) ||
+        (pgsHeader->nFrequency != (Uint32) nFrequency) || (pgsHeader->nFormat != nFormat) ||
+        (pgsHeader->nChannels != (Uint16) nChannels)) {
+        GS_Error::Report("GS_SDL_MIXER_SOUND.CPP", 864, "Sound bank is in the wrong format!");
+        delete pgsBank;
+        return FALSE;
+    }
+
+    const GS_SoundBankEntry* pgsEntries = (const GS_SoundBankEntry*) (pgsHeader + 1);
+
+    // Is any sample file newer than the bank? Sample files that are missing (shipped without
+    // them) don't make the bank out of date.
+    GS_File gsFile;
+    time_t  BankTime;
+    time_t  SampleTime;
+
+    if (gsFile.GetModifiedTime(pszFilename, &BankTime)) {
+        for (Uint32 nLoop = 0; nLoop < pgsHeader->nNumSamples; nLoop++) {
+            char szName[GS_MIXER_MAX_NAME];
+            strncpy(szName, pgsEntries[nLoop].szName, GS_MIXER_MAX_NAME - 1);
+            szName[GS_MIXER_MAX_NAME - 1] = '\0';
+
+            if (gsFile.GetModifiedTime(szName, &SampleTime) && (SampleTime > BankTime)) {
+                delete pgsBank;
+                return FALSE;
+            }
+        }
+    }
+
+    for (Uint32 nLoop = 0; nLoop < pgsHeader->nNumSamples; nLoop++) {
+        const GS_SoundBankEntry* pgsEntry = &pgsEntries[nLoop];
+
+        // Skip samples that are (partly) outside the file.
+        if ((pgsEntry->nOffset > lLength) ||
+            (pgsEntry->nLength > lLength - pgsEntry->nOffset)) {
+            continue;
+        }
+
+        char szName[GS_MIXER_MAX_NAME];
+        strncpy(szName, pgsEntry->szName, GS_MIXER_MAX_NAME - 1);
+        szName[GS_MIXER_MAX_NAME - 1] = '\0';
+
+        // The mixer only reads the sample data, so it can point into the (read only) mapping.
+        Mix_Chunk* pSample = Mix_QuickLoad_RAW((Uint8*) (pData + pgsEntry->nOffset),
+                                               pgsEntry->nLength);
+
+        if (pSample) {
+            this->AddChunk(pSample, szName, FALSE);
+        }
+    }
+
+    // Keep the bank mapped for as long as its samples are used.
+    m_gsBankList.AddItem(pgsBank);
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SDLMixerSound::SaveSampleBank():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Saves all the samples in the sample list as a sound bank, in the format the mixer
+//          plays. The game then adds the bank rather than decoding and converting every sample
+//          file when it starts, until one of the sample files is changed.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if not.
+//==============================================================================================
+
+BOOL GS_SDLMixerSound::SaveSampleBank(const char* pszFilename) {
+
+    // Exit if sound not initialized.
+    if (!m_bIsReady) {
+        return FALSE;
+    }
+
+    GS_SoundBankHeader gsHeader;
+    memset(&gsHeader, 0, sizeof(gsHeader));
+
+    int    nFrequency;
+    Uint16 nFormat;
+    int    nChannels;
+
+    if (!Mix_QuerySpec(&nFrequency, &nFormat, &nChannels)) {
         return FALSE;
     }
 
+    int nNumSamples = m_gsSampleList.GetNumItems();
+
+    memcpy(gsHeader.szMagic, GS_SOUND_BANK_MAGIC, 4);
+    gsHeader.nVersion    = GS_SOUND_BANK_VERSION;
+    gsHeader.nFrequency  = (Uint32) nFrequency;
+    gsHeader.nFormat     = nFormat;
+    gsHeader.nChannels   = (Uint16) nChannels;
+    gsHeader.nNumSamples = (Uint32) nNumSamples;
+
+    GS_SoundBankEntry* pgsEntries = new GS_SoundBankEntry[nNumSamples > 0 ? nNumSamples : 1];
+
+    // The sample data follows the entries, every sample aligned to GS_SOUND_BANK_ALIGN bytes.
+    Uint32 nOffset = sizeof(GS_SoundBankHeader) + nNumSamples * sizeof(GS_SoundBankEntry);
+
+    for (int nLoop = 0; nLoop < nNumSamples; nLoop++) {
+        memset(&pgsEntries[nLoop], 0, sizeof(GS_SoundBankEntry));
+        strcpy(pgsEntries[nLoop].szName, m_gsSampleList[nLoop].szName);
+
+        // A shared sample uses the data of the sample it shares.
+        if (m_gsSampleList[nLoop].bIsShared) {
+            pgsEntries[nLoop] = pgsEntries[this->FindSample(m_gsSampleList[nLoop].szName)];
+            continue;
+        }
+
+        nOffset = (nOffset + GS_SOUND_BANK_ALIGN - 1) & ~(GS_SOUND_BANK_ALIGN - 1);
+
+        pgsEntries[nLoop].nOffset = nOffset;
+        pgsEntries[nLoop].nLength = m_gsSampleList[nLoop].pChunk->alen;
+
+        nOffset += pgsEntries[nLoop].nLength;
+    }
+
+    GS_File gsFile;
+
+    if (!gsFile.Open(pszFilename, FILE_WRITE)) {
+        GS_Error::Report("GS_SDL_MIXER_SOUND.CPP", 966, "Failed to create sound bank file!");
+        GS_SAFE_DELETE_ARRAY(pgsEntries);
+        return FALSE;
+    }
+
+    BOOL bIsWritten = TRUE;
+    BYTE cPadding[GS_SOUND_BANK_ALIGN] = {0};
+
+    bIsWritten &= (gsFile.Write(&gsHeader, sizeof(gsHeader)) == sizeof(gsHeader));
+    bIsWritten &= (gsFile.Write(pgsEntries, nNumSamples * sizeof(GS_SoundBankEntry)) ==
+                   nNumSamples * sizeof(GS_SoundBankEntry));
+
+    nOffset = sizeof(GS_SoundBankHeader) + nNumSamples * sizeof(GS_SoundBankEntry);
+
+    for (int nLoop = 0; (nLoop < nNumSamples) && bIsWritten; nLoop++) {
+        if (m_gsSampleList[nLoop].bIsShared) {
+            continue;
+        }
+
+        // Pad up to where the sample starts.
+        if (pgsEntries[nLoop].nOffset > nOffset) {
+            unsigned long lPadding = pgsEntries[nLoop].nOffset - nOffset;
+            bIsWritten &= (gsFile.Write(cPadding, lPadding) == lPadding);
+        }
+
+        bIsWritten &= (gsFile.Write(m_gsSampleList[nLoop].pChunk->abuf,
+                                    pgsEntries[nLoop].nLength) == pgsEntries[nLoop].nLength);
+
+        nOffset = pgsEntries[nLoop].nOffset + pgsEntries[nLoop].nLength;
+    }
+
+    gsFile.Close();
+
+    GS_SAFE_DELETE_ARRAY(pgsEntries);
+
+    if (!bIsWritten) {
+        GS_Error::Report("GS_SDL_MIXER_SOUND.CPP", 1002, "Failed to write sound bank file!");
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SDLMixerSound::FindSample():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Finds a sample by the name of the file it was loaded from (or its name in a sound
+//          bank, which is the same). Samples are played by index, so look the index up once
+//          and keep it.
+// ---------------------------------------------------------------------------------------------
+// Returns: The index of the sample, -1 if there is no sample by that name.
+//==============================================================================================
+
+int GS_SDLMixerSound::FindSample(const char* pszName) {
+
+    if (!pszName) {
+        return -1;
+    }
+
+    for (int nLoop = 0; nLoop < m_gsSampleList.GetNumItems(); nLoop++) {
+        if (strcmp(m_gsSampleList[nLoop].szName, pszName) == 0) {
+            return nLoop;
+        }
+    }
+
+    return -1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SDLMixerSound::AddChunk():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Adds a loaded sample to the sample list with the default volume, panning, priority
+//          and rate limit.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if not.
+//==============================================================================================
+
+BOOL GS_SDLMixerSound::AddChunk(Mix_Chunk* pChunk, const char* pszName, BOOL bIsShared) {
+
+    GS_MixerSample gsSample;
+
+    // Samples are found by name, so the name can't be shortened.
+    if (strlen(pszName) >= GS_MIXER_MAX_NAME) {
+        GS_Error::Report("GS_SDL_MIXER_SOUND.CPP", 1057, "Sample name is too long!");
+        if (!bIsShared) {
+            Mix_FreeChunk(pChunk);
+        }
+        return FALSE;
+    }
+
+    strcpy(gsSample.szName, pszName);
+    gsSample.pChunk      = pChunk;
+    gsSample.bIsShared   = bIsShared;
+    gsSample.nVolume     = 255;
+    gsSample.nPanning    = 128;
+    gsSample.nPriority   = GS_MIXER_DEFAULT_PRIORITY;
+    gsSample.nMaxPlays   = GS_MIXER_DEFAULT_LIMIT;
+    gsSample.nNumPlays   = 0;
+    gsSample.nFrameStart = 0;
+
     // Add the sample to the list.
-    m_gsSampleList.AddItem(pSample);
+    m_gsSampleList.AddItem(gsSample);
 
     return TRUE;
 }
@@ -784,37 +1157,100 @@ BOOL GS_SDLMixerSound::AddSample(const char* pszFilename) {
 //==============================================================================================
 // GS_SDLMixerSound::PlaySample():
 // ---------------------------------------------------------------------------------------------
-// Purpose: Plays a loaded sound sample with optional volume and panning.
+// Purpose: Plays a loaded sound sample with optional volume and panning (0 left, 128 centre,
+//          255 right), on a free voice or on one stolen from a sample that matters less.
 // ---------------------------------------------------------------------------------------------
-// Notes: The panning parameter is currently ignored as SDL_mixer's panning requires a more
-//        complex channel-based approach.
+// Notes: A sample started more often in a frame than its rate limit allows (see
+//        SetSampleRateLimit()) is skipped, so a burst of collisions only starts a few voices.
 // ---------------------------------------------------------------------------------------------
-// Returns: The channel number playing the sample, or -1 on error.
+// Returns: The voice (channel) playing the sample, or -1 if it wasn't played.
 //==============================================================================================
 
 int GS_SDLMixerSound::PlaySample(int nIndex, int nVolume, int nPanning) {
 
-    // Panning parameter not currently implemented.
-    (void)nPanning;
-    
     // Exit if sound not initialized or paused.
     if (!m_bIsReady || m_bIsPaused) {
         return -1;
     }
 
     // Is index within bounds?
-    if ((nIndex >= 0) && (nIndex < m_gsSampleList.GetNumItems())) {
-        // Have the user specified a valid volume?
-        if (nVolume >= 0) {
-            // Set the sample volume.
-            this->SetSampleVolume(nIndex, nVolume);
+    if ((nIndex < 0) || (nIndex >= m_gsSampleList.GetNumItems())) {
+        return -1;
+    }
+
+    GS_MixerSample gsSample = m_gsSampleList[nIndex];
+
+    // Start counting again once the frame has passed.
+    Uint32 nTime = SDL_GetTicks();
+
+    if ((nTime - gsSample.nFrameStart) >= GS_MIXER_FRAME_TIME) {
+        gsSample.nFrameStart = nTime;
+        gsSample.nNumPlays   = 0;
+    }
+
+    // Has the sample been started as often as it may be this frame?
+    if ((gsSample.nMaxPlays > 0) && (gsSample.nNumPlays >= gsSample.nMaxPlays)) {
+        return -1;
+    }
+
+    // Find a free voice or one to steal.
+    int nVoice = this->FindVoice(gsSample.nPriority);
+
+    if (nVoice < 0) {
+        return -1;
+    }
+
+    gsSample.nNumPlays++;
+    m_gsSampleList.SetItem(nIndex, gsSample);
+
+    // Use the volume and panning of the sample unless others were specified.
+    if (nVolume < 0) {
+        nVolume = gsSample.nVolume;
+    }
+    if (nPanning < 0) {
+        nPanning = gsSample.nPanning;
+    }
+
+    // Make sure volume and panning are within range (0 - 255).
+    if (nVolume > 255) {
+        nVolume = 255;
+    }
+    if (nPanning > 255) {
+        nPanning = 255;
+    }
+
+    m_gsVoices[nVoice].nSample   = nIndex;
+    m_gsVoices[nVoice].nVolume   = nVolume;
+    m_gsVoices[nVoice].nPanning  = nPanning;
+    m_gsVoices[nVoice].nPriority = gsSample.nPriority;
+    m_gsVoices[nVoice].nOrder    = m_nNextOrder++;
+
+    // The software mixer plays the sample data as it is, the device format being 16-bit stereo.
+    if (m_bIsSoftMixer) {
+        float fLeft;
+        float fRight;
+
+        this->GetVoiceGains(nVoice, &fLeft, &fRight);
+
+        if (!m_gsSoftMixer.Play(nVoice, (const short*) gsSample.pChunk->abuf,
+                                (int) (gsSample.pChunk->alen / 4), fLeft, fRight)) {
+            return -1;
         }
 
-        // Play the sample on the first available channel.
-        return Mix_PlayChannel(-1, m_gsSampleList[nIndex], 0);
+        return nVoice;
     }
 
-    return -1;
+    // Set the volume and panning of the channel before it starts (a centred sample plays at
+    // full volume on both sides, which also removes the panning effect).
+    this->UpdateVoiceVolume(nVoice);
+
+    int nLeft  = (nPanning <= 128) ? 255 : ((255 - nPanning) * 255 / 127);
+    int nRight = (nPanning >= 128) ? 255 : (nPanning * 255 / 128);
+
+    Mix_SetPanning(nVoice, (Uint8) nLeft, (Uint8) nRight);
+
+    // Play the sample on the voice.
+    return Mix_PlayChannel(nVoice, gsSample.pChunk, 0);
 }
 
 
@@ -844,8 +1280,12 @@ void GS_SDLMixerSound::SetSampleMaster(int nVolume) {
         nVolume = 255;
     }
 
-    // Set master volume for all channels (convert 0-255 to SDL_mixer's 0-128 range).
-    Mix_Volume(-1, nVolume * 128 / 255);
+    m_nSampleMaster = nVolume;
+
+    // Apply it to every voice, including those playing.
+    for (int nVoice = 0; nVoice < m_nNumVoices; nVoice++) {
+        this->UpdateVoiceVolume(nVoice);
+    }
 }
 
 
@@ -867,8 +1307,7 @@ int GS_SDLMixerSound::GetSampleMaster() {
         return 0;
     }
 
-    // Get master volume for all channels (convert SDL_mixer's 0-128 range to 0-255).
-    return Mix_Volume(-1, -1) * 255 / 128;
+    return m_nSampleMaster;
 }
 
 
@@ -878,7 +1317,8 @@ int GS_SDLMixerSound::GetSampleMaster() {
 //==============================================================================================
 // GS_SDLMixerSound::SetSampleVolume():
 // ---------------------------------------------------------------------------------------------
-// Purpose: Sets the volume for a specific sample.
+// Purpose: Sets the volume a specific sample plays at when PlaySample() isn't given one. The
+//          sample itself is left alone, so voices already playing it don't change.
 // ---------------------------------------------------------------------------------------------
 // Returns: TRUE if successful, FALSE if not.
 //==============================================================================================
@@ -900,8 +1340,9 @@ BOOL GS_SDLMixerSound::SetSampleVolume(int nIndex, int nVolume) {
 
     // Is index within bounds?
     if ((nIndex >= 0) && (nIndex < m_gsSampleList.GetNumItems())) {
-        // Set sample volume (convert 0-255 to SDL_mixer's 0-128 range).
-        Mix_VolumeChunk(m_gsSampleList[nIndex], nVolume * 128 / 255);
+        GS_MixerSample gsSample = m_gsSampleList[nIndex];
+        gsSample.nVolume = nVolume;
+        m_gsSampleList.SetItem(nIndex, gsSample);
         return TRUE;
     }
 
@@ -915,24 +1356,297 @@ BOOL GS_SDLMixerSound::SetSampleVolume(int nIndex, int nVolume) {
 //==============================================================================================
 // GS_SDLMixerSound::SetSamplePanning():
 // ---------------------------------------------------------------------------------------------
-// Purpose: Sets the panning for a specific sample.
+// Purpose: Sets the panning a specific sample plays at when PlaySample() isn't given one (0
+//          left, 128 centre, 255 right).
 // ---------------------------------------------------------------------------------------------
-// Notes: Currently not fully implemented as SDL_mixer requires a channel-based approach for
-//        panning, which is more complex than the sample-based approach used by FMOD.
-// ---------------------------------------------------------------------------------------------
-// Returns: TRUE (placeholder).
+// Returns: TRUE if successful, FALSE if not.
 //==============================================================================================
 
 BOOL GS_SDLMixerSound::SetSamplePanning(int nIndex, int nPanning) {
 
-    // Panning not currently implemented.
-    (void)nIndex;
-    (void)nPanning;
+    // Exit if sound not initialized.
+    if (!m_bIsReady) {
+        return FALSE;
+    }
 
-    // SDL_mixer panning requires channel-based approach.
-    // This would need to be implemented using Mix_SetPanning() on active channels.
-    
-    return TRUE;
+    // Make sure panning is within range (0 - 255).
+    if (nPanning < 0) {
+        nPanning = 0;
+    }
+    if (nPanning > 255) {
+        nPanning = 255;
+    }
+
+    // Is index within bounds?
+    if ((nIndex >= 0) && (nIndex < m_gsSampleList.GetNumItems())) {
+        GS_MixerSample gsSample = m_gsSampleList[nIndex];
+        gsSample.nPanning = nPanning;
+        m_gsSampleList.SetItem(nIndex, gsSample);
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SDLMixerSound::SetSamplePriority():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the priority of a specific sample (0-255). When every voice is playing, a
+//          sample steals the voice of a sample with the same or a lower priority.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if not.
+//==============================================================================================
+
+BOOL GS_SDLMixerSound::SetSamplePriority(int nIndex, int nPriority) {
+
+    // Exit if sound not initialized.
+    if (!m_bIsReady) {
+        return FALSE;
+    }
+
+    // Make sure priority is within range (0 - 255).
+    if (nPriority < 0) {
+        nPriority = 0;
+    }
+    if (nPriority > 255) {
+        nPriority = 255;
+    }
+
+    // Is index within bounds?
+    if ((nIndex >= 0) && (nIndex < m_gsSampleList.GetNumItems())) {
+        GS_MixerSample gsSample = m_gsSampleList[nIndex];
+        gsSample.nPriority = nPriority;
+        m_gsSampleList.SetItem(nIndex, gsSample);
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SDLMixerSound::GetSamplePriority():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Gets the priority of a specific sample.
+// ---------------------------------------------------------------------------------------------
+// Returns: The priority of the sample (0-255), -1 if failed.
+//==============================================================================================
+
+int GS_SDLMixerSound::GetSamplePriority(int nIndex) {
+
+    // Is index within bounds?
+    if ((nIndex >= 0) && (nIndex < m_gsSampleList.GetNumItems())) {
+        return m_gsSampleList[nIndex].nPriority;
+    }
+
+    return -1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SDLMixerSound::SetSampleRateLimit():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets how many times a specific sample can start per frame (GS_MIXER_FRAME_TIME),
+//          0 for no limit. Further calls to PlaySample() in the same frame are ignored.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if not.
+//==============================================================================================
+
+BOOL GS_SDLMixerSound::SetSampleRateLimit(int nIndex, int nMaxPlays) {
+
+    // Exit if sound not initialized.
+    if (!m_bIsReady) {
+        return FALSE;
+    }
+
+    // Is index within bounds?
+    if ((nIndex >= 0) && (nIndex < m_gsSampleList.GetNumItems())) {
+        GS_MixerSample gsSample = m_gsSampleList[nIndex];
+        gsSample.nMaxPlays = (nMaxPlays > 0) ? nMaxPlays : 0;
+        m_gsSampleList.SetItem(nIndex, gsSample);
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Voice Methods ///////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SDLMixerSound::FindVoice():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Finds a voice to play a sample of the given priority on. A free voice is used if
+//          there is one, otherwise the voice of the lowest priority is stolen, the quietest
+//          and then the oldest of those, unless it has a higher priority than the sample.
+// ---------------------------------------------------------------------------------------------
+// Returns: The voice (channel), -1 if every voice plays a sample of a higher priority.
+//==============================================================================================
+
+int GS_SDLMixerSound::FindVoice(int nPriority) {
+
+    int nSteal = -1;
+
+    for (int nVoice = 0; nVoice < m_nNumVoices; nVoice++) {
+        // Use the first voice that isn't playing.
+        if (!this->IsVoicePlaying(nVoice)) {
+            return nVoice;
+        }
+
+        const GS_MixerVoice* pgsVoice = &m_gsVoices[nVoice];
+
+        // Skip voices that matter more than the sample.
+        if (pgsVoice->nPriority > nPriority) {
+            continue;
+        }
+
+        // Is this voice a better one to steal?
+        if (nSteal < 0) {
+            nSteal = nVoice;
+            continue;
+        }
+
+        const GS_MixerVoice* pgsSteal = &m_gsVoices[nSteal];
+
+        if (pgsVoice->nPriority != pgsSteal->nPriority) {
+            if (pgsVoice->nPriority < pgsSteal->nPriority) {
+                nSteal = nVoice;
+            }
+        }
+        else if (pgsVoice->nVolume != pgsSteal->nVolume) {
+            if (pgsVoice->nVolume < pgsSteal->nVolume) {
+                nSteal = nVoice;
+            }
+        }
+        else if ((int) (pgsVoice->nOrder - pgsSteal->nOrder) < 0) {
+            nSteal = nVoice;
+        }
+    }
+
+    // Stop the stolen voice (which also removes its panning) so it can be set up again. A
+    // voice of the software mixer just starts playing the new sample.
+    if ((nSteal >= 0) && !m_bIsSoftMixer) {
+        Mix_HaltChannel(nSteal);
+    }
+
+    return nSteal;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SDLMixerSound::UpdateVoiceVolume():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the channel volume of a voice from its own volume and the master volume.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SDLMixerSound::UpdateVoiceVolume(int nVoice) {
+
+    // Voices of the software mixer ramp to their new gains. Only those playing are changed,
+    // others are given their gains when they start.
+    if (m_bIsSoftMixer) {
+        if (m_gsSoftMixer.IsPlaying(nVoice)) {
+            float fLeft;
+            float fRight;
+
+            this->GetVoiceGains(nVoice, &fLeft, &fRight);
+            m_gsSoftMixer.SetGain(nVoice, fLeft, fRight);
+        }
+        return;
+    }
+
+    // Convert 0-255 to SDL_mixer's 0-128 range.
+    Mix_Volume(nVoice, m_gsVoices[nVoice].nVolume * m_nSampleMaster * MIX_MAX_VOLUME /
+                       (255 * 255));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SDLMixerSound::IsVoicePlaying():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Checks whether a voice is playing a sample, on the software mixer or a channel.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the voice is playing, FALSE if not.
+//==============================================================================================
+
+BOOL GS_SDLMixerSound::IsVoicePlaying(int nVoice) {
+
+    if (m_bIsSoftMixer) {
+        return m_gsSoftMixer.IsPlaying(nVoice);
+    }
+
+    return Mix_Playing(nVoice) ? TRUE : FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SDLMixerSound::GetVoiceGains():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Works out the gains of a voice of the software mixer (1.0 being full volume) from
+//          its volume, its panning and the master volume. Panning works as with the channels,
+//          a centred sample plays at full volume on both sides.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SDLMixerSound::GetVoiceGains(int nVoice, float* pfLeft, float* pfRight) {
+
+    const GS_MixerVoice* pgsVoice = &m_gsVoices[nVoice];
+
+    float fVolume = (float) (pgsVoice->nVolume * m_nSampleMaster) / (255.0f * 255.0f);
+
+    int nLeft  = (pgsVoice->nPanning <= 128) ? 255 : ((255 - pgsVoice->nPanning) * 255 / 127);
+    int nRight = (pgsVoice->nPanning >= 128) ? 255 : (pgsVoice->nPanning * 255 / 128);
+
+    *pfLeft  = fVolume * (float) nLeft / 255.0f;
+    *pfRight = fVolume * (float) nRight / 255.0f;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SDLMixerSound::MixSoftVoices():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Called by SDL_mixer in the audio callback, after it has mixed the music and streams,
+//          to add the voices of the software mixer to the output.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void SDLCALL GS_SDLMixerSound::MixSoftVoices(void* pUserData, Uint8* pStream, int nLength) {
+
+    GS_SDLMixerSound* pgsSound = (GS_SDLMixerSound*) pUserData;
+
+    // Every frame is two 16-bit samples.
+    pgsSound->m_gsSoftMixer.Mix((short*) pStream, nLength / 4);
 }
 
 
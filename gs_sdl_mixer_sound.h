@@ -26,7 +26,10 @@
 #include "gs_object.h"
 #include "gs_list.h"
 #include "gs_error.h"
+#include "gs_file.h"
+#include "gs_file_map.h"
 #include "gs_platform.h"
+#include "gs_soft_mixer.h"
 //==============================================================================================
 
 
@@ -37,6 +40,77 @@
 //==============================================================================================
 
 
+//==============================================================================================
+// Voice defines.
+// ---------------------------------------------------------------------------------------------
+#define GS_MIXER_MAX_VOICES       64  // Mixing channels, the most samples that play at once.
+#define GS_MIXER_MAX_SOFT_VOICES  GS_SOFT_MIXER_MAX_VOICES // The same with the software mixer.
+#define GS_MIXER_DEFAULT_PRIORITY 128 // Priority of samples not given one (0-255).
+#define GS_MIXER_DEFAULT_LIMIT    2   // Times a sample can start per frame unless changed.
+#define GS_MIXER_FRAME_TIME       16  // Milliseconds counted as a frame by the rate limit.
+#define GS_MIXER_MAX_NAME         48  // Longest sample name, including the terminating zero.
+//==============================================================================================
+
+
+//==============================================================================================
+// Sound bank defines.
+// ---------------------------------------------------------------------------------------------
+#define GS_SOUND_BANK_MAGIC   "GSSB" // The first four bytes of every sound bank.
+#define GS_SOUND_BANK_VERSION 1
+#define GS_SOUND_BANK_ALIGN   16     // Sample data starts on multiples of this many bytes.
+//==============================================================================================
+
+
+//==============================================================================================
+// Voice structures.
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_MIXER_SAMPLE
+{
+    char       szName[GS_MIXER_MAX_NAME]; // The file (or bank entry) it was loaded from.
+    Mix_Chunk* pChunk;
+    BOOL   bIsShared;   // Wether the chunk belongs to another sample of the same name.
+    int    nVolume;     // Volume it plays at unless PlaySample() is given one (0-255).
+    int    nPanning;    // Panning it plays at unless PlaySample() is given one (0-255).
+    int    nPriority;   // Voices of higher priority samples are stolen last (0-255).
+    int    nMaxPlays;   // Times it can start per frame, 0 for no limit.
+    int    nNumPlays;   // Times it started in the current frame.
+    Uint32 nFrameStart; // When the current frame started (SDL ticks).
+} GS_MixerSample;
+
+typedef struct GS_MIXER_VOICE
+{
+    int nSample;         // The sample last played by the voice, -1 if none.
+    int nVolume;         // Its volume before the master volume is applied (0-255).
+    int nPanning;        // Its panning (0-255), only kept for the software mixer.
+    int nPriority;
+    unsigned int nOrder; // When it started playing, lower is older.
+} GS_MixerVoice;
+//==============================================================================================
+
+
+//==============================================================================================
+// Sound bank structures. A sound bank is a header, an entry for every sample and then the
+// sample data, already in the format the mixer plays (see SaveSampleBank()).
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_SOUND_BANK_HEADER
+{
+    char   szMagic[4];  // GS_SOUND_BANK_MAGIC.
+    Uint32 nVersion;    // GS_SOUND_BANK_VERSION.
+    Uint32 nFrequency;  // The output format of the mixer the bank was made for.
+    Uint16 nFormat;
+    Uint16 nChannels;
+    Uint32 nNumSamples;
+} GS_SoundBankHeader;
+
+typedef struct GS_SOUND_BANK_ENTRY
+{
+    char   szName[GS_MIXER_MAX_NAME];
+    Uint32 nOffset; // Where the sample data starts, from the start of the file.
+    Uint32 nLength; // The length of the sample data in bytes.
+} GS_SoundBankEntry;
+//==============================================================================================
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Class Definition. ///////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -52,12 +126,30 @@ private:
     
     GS_List<Mix_Music*> m_gsMusicList;  // List of loaded music tracks (MP3, OGG, WAV, etc.).
     GS_List<Mix_Music*> m_gsStreamList; // List of loaded audio streams (same as music in SDL_mixer).
-    GS_List<Mix_Chunk*> m_gsSampleList; // List of loaded sound samples (WAV files).
+    GS_List<GS_MixerSample> m_gsSampleList; // List of loaded sound samples (WAV files).
+    GS_List<GS_FileMap*>    m_gsBankList;   // List of mapped sound banks.
+
+    GS_MixerVoice m_gsVoices[GS_MIXER_MAX_SOFT_VOICES]; // The sample playing on every voice.
+    int           m_nNumVoices;                         // The voices in use.
+    unsigned int  m_nNextOrder;                         // Order of the next voice started.
+    int           m_nSampleMaster;                      // Master volume of all samples (0-255).
+
+    GS_SoftMixer m_gsSoftMixer;  // Mixes the samples instead of SDL_mixer's channels, if used.
+    BOOL         m_bIsSoftMixer; // Whether the samples are mixed by the software mixer.
     
     int m_nMasterVolume;  // Master volume for all music, streams and samples (0-255).
     int m_nCurrentMusic;  // Index of currently playing music track (-1 if none).
     int m_nCurrentStream; // Index of currently playing stream (-1 if none).
 
+    BOOL AddChunk(Mix_Chunk* pChunk, const char* pszName, BOOL bIsShared);
+
+    int  FindVoice(int nPriority);
+    BOOL IsVoicePlaying(int nVoice);
+    void UpdateVoiceVolume(int nVoice);
+    void GetVoiceGains(int nVoice, float* pfLeft, float* pfRight);
+
+    static void SDLCALL MixSoftVoices(void* pUserData, Uint8* pStream, int nLength);
+
 protected:
 
     // ...
@@ -71,9 +163,11 @@ public:
     // Status methods.
     BOOL IsReady()  { return m_bIsReady; }
     BOOL IsPaused() { return m_bIsPaused; }
+    BOOL IsSoftMixer() { return m_bIsSoftMixer; }
     
     // Initialize & shutdown methods.
-    BOOL Initialize(HWND hWnd, BOOL bNoSound = FALSE);
+    BOOL Initialize(HWND hWnd, BOOL bNoSound = FALSE, int nBufferSize = 2048,
+                    BOOL bUseSoftMixer = FALSE);
     BOOL Shutdown();
     
     // Global control methods.
@@ -109,11 +203,17 @@ public:
     
     // Sample methods (WAV files for sound effects).
     BOOL AddSample(const char* pszFilename);
+    BOOL AddSampleBank(const char* pszFilename);
+    BOOL SaveSampleBank(const char* pszFilename);
+    int  FindSample(const char* pszName);
     int  PlaySample(int nIndex, int nVolume = -1, int nPanning = -1);
     void SetSampleMaster(int nVolume);
     int  GetSampleMaster();
     BOOL SetSampleVolume(int nIndex, int nVolume);
     BOOL SetSamplePanning(int nIndex, int nPanning);
+    BOOL SetSamplePriority(int nIndex, int nPriority);
+    int  GetSamplePriority(int nIndex);
+    BOOL SetSampleRateLimit(int nIndex, int nMaxPlays);
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,786 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_soft_mixer.cpp, gs_soft_mixer.h                                                  |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_SoftMixer                                                                        |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: A software mixer for sound samples that runs in the audio callback. The voices of   |
+ |        16-bit stereo samples are added up as floats with SIMD instructions, their gains    |
+ |        ramped over every block to avoid clicks, and a limiter keeps the sum from clipping. |
+ |        The game thread controls the voices through a queue, so it never blocks the audio.  |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_soft_mixer.h"
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor/Destructor Methods //////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftMixer::GS_SoftMixer():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The constructor, initializes class data when class object is created.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_SoftMixer::GS_SoftMixer()
+{
+
+    m_pVoices      = NULL;
+    m_pfMixBuffer  = NULL;
+    m_fLimiterGain = 1.0f;
+    m_nNumPlaying  = 0;
+
+    m_nCommandRead  = 0;
+    m_nCommandWrite = 0;
+
+    for (int nVoice = 0; nVoice < GS_SOFT_MIXER_MAX_VOICES; nVoice++)
+    {
+        m_nStartedIDs[nVoice]  = 0;
+        m_nFinishedIDs[nVoice] = 0;
+    }
+
+    m_bIsPaused  = false;
+    m_fThreshold = GS_SOFT_MIXER_THRESHOLD;
+
+    m_nNumVoices = 0;
+    m_bIsReady   = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftMixer::~GS_SoftMixer():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The de-structor, de-initializes class data when class object is destroyed.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_SoftMixer::~GS_SoftMixer()
+{
+
+    this->Destroy();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Create/Destroy Methods. /////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftMixer::Create():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Creates the specified number of voices, all stopped. Must be called before the
+//          audio callback starts calling Mix(), and Destroy() only after it has stopped.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if not.
+//==============================================================================================
+
+BOOL GS_SoftMixer::Create(int nNumVoices)
+{
+
+    this->Destroy();
+
+    if ((nNumVoices < 1) || (nNumVoices > GS_SOFT_MIXER_MAX_VOICES))
+    {
+        GS_Error::Report("GS_SOFT_MIXER.CPP", 104, "Invalid number of voices!");
+        return FALSE;
+    }
+
+    m_pVoices     = new GS_SoftMixerVoice[nNumVoices];
+    m_pfMixBuffer = new float[GS_SOFT_MIXER_BLOCK_FRAMES * 2];
+
+    memset(m_pVoices, 0, nNumVoices * sizeof(GS_SoftMixerVoice));
+
+    m_fLimiterGain = 1.0f;
+    m_nNumPlaying  = 0;
+
+    m_nCommandRead  = 0;
+    m_nCommandWrite = 0;
+
+    for (int nVoice = 0; nVoice < GS_SOFT_MIXER_MAX_VOICES; nVoice++)
+    {
+        m_nStartedIDs[nVoice]  = 0;
+        m_nFinishedIDs[nVoice] = 0;
+    }
+
+    m_bIsPaused = false;
+
+    m_nNumVoices = nNumVoices;
+    m_bIsReady   = TRUE;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftMixer::Destroy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Destroys the voices. The audio callback must not call Mix() any more.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SoftMixer::Destroy()
+{
+
+    GS_SAFE_DELETE_ARRAY(m_pVoices);
+    GS_SAFE_DELETE_ARRAY(m_pfMixBuffer);
+
+    m_nNumVoices = 0;
+    m_bIsReady   = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Voice Methods. //////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftMixer::Play():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Plays interleaved 16-bit stereo frames on a voice at the specified gains (1.0 is
+//          full volume), replacing whatever the voice was playing. The data must stay valid
+//          until the voice has stopped.
+// ---------------------------------------------------------------------------------------------
+// Notes: Called from the game thread, the voice starts with the next mix.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if not (also when too many commands are queued).
+//==============================================================================================
+
+BOOL GS_SoftMixer::Play(int nVoice, const short* psData, int nNumFrames, float fGainLeft,
+                        float fGainRight)
+{
+
+    if (!m_bIsReady || (nVoice < 0) || (nVoice >= m_nNumVoices) || !psData ||
+        (nNumFrames <= 0))
+    {
+        return FALSE;
+    }
+
+    GS_SoftMixerCommand gsCommand;
+
+    gsCommand.nType      = SOFT_MIXER_PLAY;
+    gsCommand.nVoice     = nVoice;
+    gsCommand.nPlayID    = m_nStartedIDs[nVoice].load(std::memory_order_relaxed) + 1;
+    gsCommand.pData      = psData;
+    gsCommand.nNumFrames = nNumFrames;
+    gsCommand.fGainLeft  = fGainLeft;
+    gsCommand.fGainRight = fGainRight;
+
+    if (!this->PostCommand(gsCommand))
+    {
+        return FALSE;
+    }
+
+    // The voice counts as playing until the audio callback has finished this play.
+    m_nStartedIDs[nVoice].store(gsCommand.nPlayID, std::memory_order_release);
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftMixer::SetGain():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Changes the gains of a voice. The voice ramps to them over the next block, so even
+//          big changes don't click.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if not.
+//==============================================================================================
+
+BOOL GS_SoftMixer::SetGain(int nVoice, float fGainLeft, float fGainRight)
+{
+
+    if (!m_bIsReady || (nVoice < 0) || (nVoice >= m_nNumVoices))
+    {
+        return FALSE;
+    }
+
+    GS_SoftMixerCommand gsCommand;
+    memset(&gsCommand, 0, sizeof(gsCommand));
+
+    gsCommand.nType      = SOFT_MIXER_SET_GAIN;
+    gsCommand.nVoice     = nVoice;
+    gsCommand.fGainLeft  = fGainLeft;
+    gsCommand.fGainRight = fGainRight;
+
+    return this->PostCommand(gsCommand);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftMixer::Stop():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Stops a voice with the next mix.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if not.
+//==============================================================================================
+
+BOOL GS_SoftMixer::Stop(int nVoice)
+{
+
+    if (!m_bIsReady || (nVoice < 0) || (nVoice >= m_nNumVoices))
+    {
+        return FALSE;
+    }
+
+    GS_SoftMixerCommand gsCommand;
+    memset(&gsCommand, 0, sizeof(gsCommand));
+
+    gsCommand.nType  = SOFT_MIXER_STOP;
+    gsCommand.nVoice = nVoice;
+
+    return this->PostCommand(gsCommand);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftMixer::StopAll():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Stops all voices with the next mix.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if not.
+//==============================================================================================
+
+BOOL GS_SoftMixer::StopAll()
+{
+
+    if (!m_bIsReady)
+    {
+        return FALSE;
+    }
+
+    GS_SoftMixerCommand gsCommand;
+    memset(&gsCommand, 0, sizeof(gsCommand));
+
+    gsCommand.nType = SOFT_MIXER_STOP_ALL;
+
+    return this->PostCommand(gsCommand);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftMixer::IsPlaying():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Checks whether a voice is playing, or has been told to play and hasn't started yet.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the voice is playing, FALSE if not.
+//==============================================================================================
+
+BOOL GS_SoftMixer::IsPlaying(int nVoice)
+{
+
+    if (!m_bIsReady || (nVoice < 0) || (nVoice >= m_nNumVoices))
+    {
+        return FALSE;
+    }
+
+    return m_nStartedIDs[nVoice].load(std::memory_order_relaxed) !=
+           m_nFinishedIDs[nVoice].load(std::memory_order_acquire);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftMixer::Pause():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Pauses or resumes all voices. The stream passed to Mix() is left as it is while
+//          paused.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SoftMixer::Pause(BOOL bPause)
+{
+
+    m_bIsPaused = (bPause != FALSE);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftMixer::SetThreshold():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the level the limiter keeps the output under, 1.0 being full scale. Louder
+//          mixes are turned down at once and slowly turned back up again once they are quieter.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SoftMixer::SetThreshold(float fThreshold)
+{
+
+    if (fThreshold < 0.1f)
+    {
+        fThreshold = 0.1f;
+    }
+    if (fThreshold > 1.0f)
+    {
+        fThreshold = 1.0f;
+    }
+
+    m_fThreshold = fThreshold;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Mix Methods. ////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftMixer::Mix():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Adds all the playing voices to a stream of interleaved 16-bit stereo frames, which
+//          may already hold other sound (such as music), and limits the result.
+// ---------------------------------------------------------------------------------------------
+// Notes: Called from the audio callback. Doesn't allocate memory or wait on the game thread.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SoftMixer::Mix(short* psStream, int nNumFrames)
+{
+
+    if (!m_bIsReady || !psStream)
+    {
+        return;
+    }
+
+    this->RunCommands();
+
+    // Leave the stream alone when there's nothing to add and the limiter has recovered.
+    if (m_bIsPaused.load(std::memory_order_relaxed) ||
+        ((m_nNumPlaying == 0) && (m_fLimiterGain >= 1.0f)))
+    {
+        return;
+    }
+
+    // Mix a block at a time, so the mix buffer stays in the cache whatever the stream size.
+    for (int nFrame = 0; nFrame < nNumFrames; nFrame += GS_SOFT_MIXER_BLOCK_FRAMES)
+    {
+        int nBlockFrames = nNumFrames - nFrame;
+
+        if (nBlockFrames > GS_SOFT_MIXER_BLOCK_FRAMES)
+        {
+            nBlockFrames = GS_SOFT_MIXER_BLOCK_FRAMES;
+        }
+
+        short* psBlock = psStream + nFrame * 2;
+
+        // Start with what's in the stream already.
+        this->ToFloat(psBlock, m_pfMixBuffer, nBlockFrames * 2);
+
+        for (int nVoice = 0; nVoice < m_nNumVoices; nVoice++)
+        {
+            if (m_pVoices[nVoice].bIsPlaying)
+            {
+                this->MixVoice(&m_pVoices[nVoice], m_pfMixBuffer, nBlockFrames);
+
+                if (!m_pVoices[nVoice].bIsPlaying)
+                {
+                    this->StopVoice(nVoice);
+                }
+            }
+        }
+
+        this->Limit(m_pfMixBuffer, nBlockFrames);
+
+        this->FromFloat(m_pfMixBuffer, psBlock, nBlockFrames * 2);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftMixer::MixVoice():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Adds a block of a voice to the mix buffer, ramping its gains from where they were to
+//          their targets over the block. Marks the voice as stopped once it reaches its end.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SoftMixer::MixVoice(GS_SoftMixerVoice* pgsVoice, float* pfMix, int nNumFrames)
+{
+
+    int nFramesLeft = pgsVoice->nNumFrames - pgsVoice->nPosition;
+    int nMixFrames  = (nFramesLeft < nNumFrames) ? nFramesLeft : nNumFrames;
+
+    const short* psSource = pgsVoice->pData + pgsVoice->nPosition * 2;
+
+    // The gain of frame n is the gain at the start of the block plus n steps.
+    float fGainLeft  = pgsVoice->fGainLeft;
+    float fGainRight = pgsVoice->fGainRight;
+    float fStepLeft  = (pgsVoice->fTargetLeft - fGainLeft) / (float) nNumFrames;
+    float fStepRight = (pgsVoice->fTargetRight - fGainRight) / (float) nNumFrames;
+
+    int nFrame = 0;
+
+#if defined(GS_SIMD_AVX2)
+    // Mix 4 frames (8 samples) at a time. The gains of the frames are kept in one register,
+    // left and right interleaved like the samples, and move on by 4 steps every loop.
+    __m256 ymmGain = _mm256_setr_ps(fGainLeft, fGainRight, fGainLeft + fStepLeft,
+                                    fGainRight + fStepRight, fGainLeft + 2.0f * fStepLeft,
+                                    fGainRight + 2.0f * fStepRight,
+                                    fGainLeft + 3.0f * fStepLeft,
+                                    fGainRight + 3.0f * fStepRight);
+    const __m256 ymmStep = _mm256_setr_ps(4.0f * fStepLeft, 4.0f * fStepRight,
+                                          4.0f * fStepLeft, 4.0f * fStepRight,
+                                          4.0f * fStepLeft, 4.0f * fStepRight,
+                                          4.0f * fStepLeft, 4.0f * fStepRight);
+
+    for (; (nFrame + 4) <= nMixFrames; nFrame += 4)
+    {
+        __m128i xmmSource = _mm_loadu_si128((const __m128i*) (psSource + nFrame * 2));
+        __m256  ymmSource = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(xmmSource));
+
+        __m256 ymmMix = _mm256_loadu_ps(pfMix + nFrame * 2);
+        ymmMix        = _mm256_add_ps(ymmMix, _mm256_mul_ps(ymmSource, ymmGain));
+        _mm256_storeu_ps(pfMix + nFrame * 2, ymmMix);
+
+        ymmGain = _mm256_add_ps(ymmGain, ymmStep);
+    }
+#endif
+
+#if defined(GS_SIMD_SSE2)
+    // Mix 2 frames (4 samples) at a time, or the last 2 that are left after mixing 4 at a time.
+    // The samples are widened to 32 bits by placing them in the high halves and shifting down.
+    __m128 xmmGain = _mm_setr_ps(fGainLeft + (float) nFrame * fStepLeft,
+                                 fGainRight + (float) nFrame * fStepRight,
+                                 fGainLeft + (float) (nFrame + 1) * fStepLeft,
+                                 fGainRight + (float) (nFrame + 1) * fStepRight);
+    const __m128 xmmStep = _mm_setr_ps(2.0f * fStepLeft, 2.0f * fStepRight, 2.0f * fStepLeft,
+                                       2.0f * fStepRight);
+
+    for (; (nFrame + 2) <= nMixFrames; nFrame += 2)
+    {
+        __m128i xmmShorts = _mm_loadl_epi64((const __m128i*) (psSource + nFrame * 2));
+        __m128  xmmSource =
+            _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(xmmShorts, xmmShorts), 16));
+
+        __m128 xmmMix = _mm_loadu_ps(pfMix + nFrame * 2);
+        xmmMix        = _mm_add_ps(xmmMix, _mm_mul_ps(xmmSource, xmmGain));
+        _mm_storeu_ps(pfMix + nFrame * 2, xmmMix);
+
+        xmmGain = _mm_add_ps(xmmGain, xmmStep);
+    }
+#endif
+
+    // Mix the remaining frames one at a time.
+    for (; nFrame < nMixFrames; nFrame++)
+    {
+        pfMix[nFrame * 2]     += psSource[nFrame * 2] * (fGainLeft + nFrame * fStepLeft);
+        pfMix[nFrame * 2 + 1] += psSource[nFrame * 2 + 1] * (fGainRight + nFrame * fStepRight);
+    }
+
+    // Land on the targets exactly, so the gains don't drift from adding up steps.
+    pgsVoice->fGainLeft  = pgsVoice->fTargetLeft;
+    pgsVoice->fGainRight = pgsVoice->fTargetRight;
+    pgsVoice->nPosition += nMixFrames;
+
+    if (pgsVoice->nPosition >= pgsVoice->nNumFrames)
+    {
+        pgsVoice->bIsPlaying = FALSE;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftMixer::Limit():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Keeps a block of the mix buffer under the threshold. When a frame would go over it
+//          the gain drops at once to just keep it under, after which it slowly recovers, so
+//          many voices at once get quieter instead of clipping.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SoftMixer::Limit(float* pfMix, int nNumFrames)
+{
+
+    float fLimit = m_fThreshold.load(std::memory_order_relaxed) * 32767.0f;
+    float fGain  = m_fLimiterGain;
+
+    for (int nFrame = 0; nFrame < nNumFrames; nFrame++)
+    {
+        float fLeft  = fabsf(pfMix[nFrame * 2]);
+        float fRight = fabsf(pfMix[nFrame * 2 + 1]);
+        float fPeak  = (fLeft > fRight) ? fLeft : fRight;
+
+        if (fPeak * fGain > fLimit)
+        {
+            fGain = fLimit / fPeak;
+        }
+
+        pfMix[nFrame * 2]     *= fGain;
+        pfMix[nFrame * 2 + 1] *= fGain;
+
+        fGain += (1.0f - fGain) * GS_SOFT_MIXER_RELEASE;
+    }
+
+    // Snap back to unity once the gain is close enough to it to not be heard.
+    m_fLimiterGain = (fGain > 0.9999f) ? 1.0f : fGain;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftMixer::ToFloat():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Converts 16-bit samples to floats, keeping their range.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SoftMixer::ToFloat(const short* psSource, float* pfDest, int nNumSamples)
+{
+
+    int nSample = 0;
+
+#if defined(GS_SIMD_SSE2)
+    for (; (nSample + 8) <= nNumSamples; nSample += 8)
+    {
+        __m128i xmmShorts = _mm_loadu_si128((const __m128i*) (psSource + nSample));
+        __m128i xmmLow    = _mm_srai_epi32(_mm_unpacklo_epi16(xmmShorts, xmmShorts), 16);
+        __m128i xmmHigh   = _mm_srai_epi32(_mm_unpackhi_epi16(xmmShorts, xmmShorts), 16);
+
+        _mm_storeu_ps(pfDest + nSample, _mm_cvtepi32_ps(xmmLow));
+        _mm_storeu_ps(pfDest + nSample + 4, _mm_cvtepi32_ps(xmmHigh));
+    }
+#endif
+
+    for (; nSample < nNumSamples; nSample++)
+    {
+        pfDest[nSample] = (float) psSource[nSample];
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftMixer::FromFloat():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Converts floats back to 16-bit samples, rounding them and clamping them to range.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SoftMixer::FromFloat(const float* pfSource, short* psDest, int nNumSamples)
+{
+
+    int nSample = 0;
+
+#if defined(GS_SIMD_SSE2)
+    // Packing the 32-bit integers to 16 bits saturates them.
+    for (; (nSample + 8) <= nNumSamples; nSample += 8)
+    {
+        __m128i xmmLow  = _mm_cvtps_epi32(_mm_loadu_ps(pfSource + nSample));
+        __m128i xmmHigh = _mm_cvtps_epi32(_mm_loadu_ps(pfSource + nSample + 4));
+
+        _mm_storeu_si128((__m128i*) (psDest + nSample), _mm_packs_epi32(xmmLow, xmmHigh));
+    }
+#endif
+
+    for (; nSample < nNumSamples; nSample++)
+    {
+        float fSample = pfSource[nSample];
+
+        if (fSample > 32767.0f)
+        {
+            fSample = 32767.0f;
+        }
+        if (fSample < -32768.0f)
+        {
+            fSample = -32768.0f;
+        }
+
+        psDest[nSample] = (short) lrintf(fSample);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Command Methods. ////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftMixer::PostCommand():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Queues a command for the audio callback. Only the game thread posts commands and
+//          only the audio callback runs them, so the queue needs no lock.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if the queue is full.
+//==============================================================================================
+
+BOOL GS_SoftMixer::PostCommand(const GS_SoftMixerCommand& gsCommand)
+{
+
+    int nWrite = m_nCommandWrite.load(std::memory_order_relaxed);
+    int nNext  = (nWrite + 1) % GS_SOFT_MIXER_MAX_COMMANDS;
+
+    if (nNext == m_nCommandRead.load(std::memory_order_acquire))
+    {
+        return FALSE;
+    }
+
+    m_Commands[nWrite] = gsCommand;
+
+    // Publish the command only once it has been written.
+    m_nCommandWrite.store(nNext, std::memory_order_release);
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftMixer::RunCommands():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Runs all the commands the game thread has queued since the last mix, in order.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SoftMixer::RunCommands()
+{
+
+    int nRead  = m_nCommandRead.load(std::memory_order_relaxed);
+    int nWrite = m_nCommandWrite.load(std::memory_order_acquire);
+
+    for (; nRead != nWrite; nRead = (nRead + 1) % GS_SOFT_MIXER_MAX_COMMANDS)
+    {
+        const GS_SoftMixerCommand& gsCommand = m_Commands[nRead];
+        GS_SoftMixerVoice*         pgsVoice  = &m_pVoices[gsCommand.nVoice];
+
+        switch (gsCommand.nType)
+        {
+            case SOFT_MIXER_PLAY:
+                if (!pgsVoice->bIsPlaying)
+                {
+                    m_nNumPlaying++;
+                }
+                // A voice that is taken over starts at its new gains, without ramping.
+                pgsVoice->pData        = gsCommand.pData;
+                pgsVoice->nNumFrames   = gsCommand.nNumFrames;
+                pgsVoice->nPosition    = 0;
+                pgsVoice->nPlayID      = gsCommand.nPlayID;
+                pgsVoice->fGainLeft    = gsCommand.fGainLeft;
+                pgsVoice->fGainRight   = gsCommand.fGainRight;
+                pgsVoice->fTargetLeft  = gsCommand.fGainLeft;
+                pgsVoice->fTargetRight = gsCommand.fGainRight;
+                pgsVoice->bIsPlaying   = TRUE;
+                break;
+
+            case SOFT_MIXER_SET_GAIN:
+                pgsVoice->fTargetLeft  = gsCommand.fGainLeft;
+                pgsVoice->fTargetRight = gsCommand.fGainRight;
+                break;
+
+            case SOFT_MIXER_STOP:
+                if (pgsVoice->bIsPlaying)
+                {
+                    pgsVoice->bIsPlaying = FALSE;
+                    this->StopVoice(gsCommand.nVoice);
+                }
+                break;
+
+            case SOFT_MIXER_STOP_ALL:
+                for (int nVoice = 0; nVoice < m_nNumVoices; nVoice++)
+                {
+                    if (m_pVoices[nVoice].bIsPlaying)
+                    {
+                        m_pVoices[nVoice].bIsPlaying = FALSE;
+                        this->StopVoice(nVoice);
+                    }
+                }
+                break;
+        }
+    }
+
+    // Free the space of the commands that have been run.
+    m_nCommandRead.store(nRead, std::memory_order_release);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftMixer::StopVoice():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Lets the game thread know a voice that was playing has stopped.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SoftMixer::StopVoice(int nVoice)
+{
+
+    m_nNumPlaying--;
+
+    m_nFinishedIDs[nVoice].store(m_pVoices[nVoice].nPlayID, std::memory_order_release);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
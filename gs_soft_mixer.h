@@ -0,0 +1,174 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_soft_mixer.cpp, gs_soft_mixer.h                                                  |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_SoftMixer                                                                        |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: A software mixer for sound samples that runs in the audio callback. The voices of   |
+ |        16-bit stereo samples are added up as floats with SIMD instructions, their gains    |
+ |        ramped over every block to avoid clicks, and a limiter keeps the sum from clipping. |
+ |        The game thread controls the voices through a queue, so it never blocks the audio.  |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+#ifndef GS_SOFT_MIXER_H
+#define GS_SOFT_MIXER_H
+
+
+//==============================================================================================
+// Include platform abstraction header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_platform.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include standard C++ library header files.
+// ---------------------------------------------------------------------------------------------
+#include <atomic>
+#include <math.h>
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_error.h"
+#include "gs_object.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Software mixer defines.
+// ---------------------------------------------------------------------------------------------
+#define GS_SOFT_MIXER_MAX_VOICES   256     // Most voices a mixer can have.
+#define GS_SOFT_MIXER_MAX_COMMANDS 1024    // Commands that can be queued between two mixes.
+#define GS_SOFT_MIXER_BLOCK_FRAMES 256     // Frames mixed at a time, gains ramp over a block.
+#define GS_SOFT_MIXER_THRESHOLD    0.9f    // Default level the limiter keeps the output under.
+#define GS_SOFT_MIXER_RELEASE      0.0005f // How fast the limiter lets the gain recover.
+//==============================================================================================
+
+
+//==============================================================================================
+// Software mixer commands, sent from the game thread to the audio callback.
+// ---------------------------------------------------------------------------------------------
+enum SOFT_MIXER_COMMAND_TYPES
+{
+    SOFT_MIXER_PLAY,     // Start a sample on a voice, replacing what it played.
+    SOFT_MIXER_SET_GAIN, // Ramp a voice to new gains.
+    SOFT_MIXER_STOP,     // Stop a voice.
+    SOFT_MIXER_STOP_ALL  // Stop every voice.
+};
+//==============================================================================================
+
+
+//==============================================================================================
+// Software mixer structures.
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_SOFT_MIXER_VOICE
+{
+    const short* pData;      // Interleaved 16-bit stereo frames.
+    int   nNumFrames;
+    int   nPosition;         // The next frame to mix.
+    int   nPlayID;           // The Play() that started it.
+    float fGainLeft;         // The gains reached at the end of the last block.
+    float fGainRight;
+    float fTargetLeft;       // The gains ramped to over the next block.
+    float fTargetRight;
+    BOOL  bIsPlaying;
+} GS_SoftMixerVoice;
+
+typedef struct GS_SOFT_MIXER_COMMAND
+{
+    int          nType;      // A SOFT_MIXER_COMMAND_TYPES value.
+    int          nVoice;
+    int          nPlayID;
+    const short* pData;
+    int          nNumFrames;
+    float        fGainLeft;
+    float        fGainRight;
+} GS_SoftMixerCommand;
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_SoftMixer : public GS_Object
+{
+
+private:
+
+    // Used by the audio callback only.
+    GS_SoftMixerVoice* m_pVoices;
+    float* m_pfMixBuffer;   // GS_SOFT_MIXER_BLOCK_FRAMES stereo frames.
+    float  m_fLimiterGain;
+    int    m_nNumPlaying;   // The voices that are playing.
+
+    // Shared by the game thread and the audio callback. Only the game thread writes commands
+    // and the started play IDs, only the audio callback the finished play IDs.
+    GS_SoftMixerCommand m_Commands[GS_SOFT_MIXER_MAX_COMMANDS];
+    std::atomic<int>    m_nCommandRead;
+    std::atomic<int>    m_nCommandWrite;
+    std::atomic<int>    m_nStartedIDs[GS_SOFT_MIXER_MAX_VOICES];
+    std::atomic<int>    m_nFinishedIDs[GS_SOFT_MIXER_MAX_VOICES];
+    std::atomic<bool>   m_bIsPaused;
+    std::atomic<float>  m_fThreshold;
+
+    int  m_nNumVoices;
+    BOOL m_bIsReady;
+
+    BOOL PostCommand(const GS_SoftMixerCommand& gsCommand);
+    void RunCommands();
+    void StopVoice(int nVoice);
+
+    void MixVoice(GS_SoftMixerVoice* pgsVoice, float* pfMix, int nNumFrames);
+    void Limit(float* pfMix, int nNumFrames);
+
+    static void ToFloat(const short* psSource, float* pfDest, int nNumSamples);
+    static void FromFloat(const float* pfSource, short* psDest, int nNumSamples);
+
+protected:
+
+    // No protected members.
+
+public:
+
+    GS_SoftMixer();
+    ~GS_SoftMixer();
+
+    BOOL Create(int nNumVoices = GS_SOFT_MIXER_MAX_VOICES);
+    void Destroy();
+
+    BOOL Play(int nVoice, const short* psData, int nNumFrames, float fGainLeft,
+              float fGainRight);
+    BOOL SetGain(int nVoice, float fGainLeft, float fGainRight);
+    BOOL Stop(int nVoice);
+    BOOL StopAll();
+
+    BOOL IsPlaying(int nVoice);
+
+    void Pause(BOOL bPause);
+    void SetThreshold(float fThreshold);
+
+    void Mix(short* psStream, int nNumFrames);
+
+    int GetNumVoices()
+    {
+        return m_nNumVoices;
+    }
+    BOOL IsReady()
+    {
+        return m_bIsReady;
+    }
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
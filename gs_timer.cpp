@@ -3,7 +3,7 @@
  |--------------------------------------------------------------------------------------------|
  | FILES: gs_timer.cpp, gs_timer.h                                                            |
  |--------------------------------------------------------------------------------------------|
- | CLASS: GS_Timer, GS_FrameTimer                                                             |
+ | CLASS: GS_Timer, GS_FrameTimer, GS_FramePacer                                              |
  |--------------------------------------------------------------------------------------------|
  | ABOUT: ...                                                                                 |
  |--------------------------------------------------------------------------------------------|
@@ -33,26 +33,8 @@
 
 GS_Timer::GS_Timer()
 {
-#ifdef GS_PLATFORM_WINDOWS
-    // Check if the current system supports high frequency performance counters and get the
-    // system's performance frequency (if it is available).
-    if (QueryPerformanceFrequency((LARGE_INTEGER*) &m_n64PerfFreq))
-    {
-        // Set flag to indicate that the system supports performance counters.
-        m_bHaveCounter = TRUE;
-        // Query the performance counter to determine the current number of counts.
-        QueryPerformanceCounter((LARGE_INTEGER*) &m_n64StartCount);
-    }
-    else
-    {
-        // Set flag to indicate that the system does not support performance counters.
-        m_bHaveCounter = FALSE;
-        // Get the system time in milliseconds.
-        m_dwStartTime = timeGetTime();
-    }
-#else
-    m_lStartTime = GS_Platform::GetTickCount();
-#endif
+
+    m_nStartTicks = GS_Timer::GetTicks();
 }
 
 
@@ -83,28 +65,79 @@ GS_Timer::~GS_Timer()
 //==============================================================================================
 // GS_Timer::Reset():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...                                                                                 |
+// Purpose: Starts measuring time from now.
 // ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
 void GS_Timer::Reset()
 {
+
+    m_nStartTicks = GS_Timer::GetTicks();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Timer Methods ///////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Timer::GetTicks():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Reads the high resolution monotonic counter (the performance counter on Windows,
+//          SDL's performance counter, which uses clock_gettime() on Linux, elsewhere).
+// ---------------------------------------------------------------------------------------------
+// Returns: The current counter value, see GetTicksPerSecond() for its frequency.
+//==============================================================================================
+
+GS_Ticks GS_Timer::GetTicks()
+{
+
 #ifdef GS_PLATFORM_WINDOWS
-    // If the system supports performance counters.
-    if (m_bHaveCounter)
+    LARGE_INTEGER liCount;
+
+    // Fall back on the milli-second multi-media timer without a performance counter.
+    if (!QueryPerformanceCounter(&liCount))
     {
-        // Determine a new start count.
-        QueryPerformanceCounter((LARGE_INTEGER*) &m_n64StartCount);
+        return (GS_Ticks) timeGetTime();
     }
-    // If the system does not support performance counters.
-    else
+
+    return (GS_Ticks) liCount.QuadPart;
+#else
+    return (GS_Ticks) GS_Platform::GetPerformanceCounter();
+#endif
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Timer::GetTicksPerSecond():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The frequency of the counter read by GetTicks().
+//==============================================================================================
+
+GS_Ticks GS_Timer::GetTicksPerSecond()
+{
+
+#ifdef GS_PLATFORM_WINDOWS
+    LARGE_INTEGER liFrequency;
+
+    if (!QueryPerformanceFrequency(&liFrequency))
     {
-        // Determine a new start time.
-        m_dwStartTime = timeGetTime();
+        return 1000;
     }
+
+    return (GS_Ticks) liFrequency.QuadPart;
 #else
-    m_lStartTime = GS_Platform::GetTickCount();
+    return (GS_Ticks) GS_Platform::GetPerformanceFrequency();
 #endif
 }
 
@@ -112,43 +145,137 @@ void GS_Timer::Reset()
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
-////////////////////////////////////////////////////////////////////////////////////////////////
-// Timer Methods ///////////////////////////////////////////////////////////////////////////////
+//==============================================================================================
+// GS_Timer::TicksToMs():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Converts a number of counter ticks to milliseconds.
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of milliseconds.
+//==============================================================================================
+
+double GS_Timer::TicksToMs(GS_Ticks nTicks)
+{
+
+    // The frequency never changes while the system is running.
+    static const double dMsPerTick = 1000.0 / (double) GS_Timer::GetTicksPerSecond();
+
+    return (double) nTicks * dMsPerTick;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
 //==============================================================================================
-// GS_Timer::GetTime():
+// GS_Timer::MsToTicks():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...                                                                                 |
+// Purpose: Converts a number of milliseconds to counter ticks.
 // ---------------------------------------------------------------------------------------------
-// Returns: A float value indicating the time, in milliseconds, since the timer was initialized.
+// Returns: The number of ticks, 0 for a negative number of milliseconds.
 //==============================================================================================
 
-float GS_Timer::GetTime()
+GS_Ticks GS_Timer::MsToTicks(double dMs)
 {
-#ifdef GS_PLATFORM_WINDOWS
-    __int64 n64CurrentCount;
 
-    // If the system supports performance counters.
-    if (m_bHaveCounter)
+    static const double dTicksPerMs = (double) GS_Timer::GetTicksPerSecond() / 1000.0;
+
+    if (dMs <= 0.0)
     {
-        // Get the current count of the performance counter.
-        QueryPerformanceCounter((LARGE_INTEGER*) &n64CurrentCount);
-        // Calculate the time elapsed in milliseconds.
-        n64CurrentCount -= m_n64StartCount;
-        return ((double(n64CurrentCount) / double(m_n64PerfFreq)) * 1000.0f);
+        return 0;
     }
-    // If the system does not support performance counters.
-    else
+
+    return (GS_Ticks) (dMs * dTicksPerMs + 0.5);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Timer::SleepUntil():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Waits until the counter reaches the specified deadline. The thread sleeps while more
+//          than dSpinMs milliseconds remain and spins, yielding to other threads, for the rest,
+//          since a sleeping thread is only woken with the granularity of the system scheduler.
+// ---------------------------------------------------------------------------------------------
+// Returns: The longest time, in milliseconds, a sleep overshot the time it was asked to sleep,
+//          0.0 if the thread didn't sleep.
+//==============================================================================================
+
+double GS_Timer::SleepUntil(GS_Ticks nDeadline, double dSpinMs)
+{
+
+    double dMaxOvershoot = 0.0;
+
+    for (;;)
     {
-        // Calculate the time elapsed in milliseconds.
-        return (float(timeGetTime() - m_dwStartTime));
-    }
+        GS_Ticks nTicks = GS_Timer::GetTicks();
+
+        if (nTicks >= nDeadline)
+        {
+            break;
+        }
+
+        double dRemaining = GS_Timer::TicksToMs(nDeadline - nTicks);
+
+        // Sleep whole milliseconds while there is time left to sleep before spinning.
+        if (dRemaining - dSpinMs >= 1.0)
+        {
+            unsigned long lSleepTime = (unsigned long) (dRemaining - dSpinMs);
+
+#ifdef GS_PLATFORM_WINDOWS
+            ::Sleep(lSleepTime);
 #else
-    unsigned long lCurrentTime = GS_Platform::GetTickCount();
-    return (float)(lCurrentTime - m_lStartTime);
+            GS_Platform::Sleep(lSleepTime);
 #endif
+            // Keep track of how late the scheduler woke the thread.
+            double dOvershoot = GS_Timer::TicksToMs(GS_Timer::GetTicks() - nTicks) - lSleepTime;
+            dMaxOvershoot     = std::max(dMaxOvershoot, dOvershoot);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    return dMaxOvershoot;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Timer::GetTime():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: A float value indicating the time, in milliseconds, since the timer was initialized.
+//==============================================================================================
+
+float GS_Timer::GetTime()
+{
+
+    return (float) this->GetTimeMs();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Timer::GetTimeMs():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Same as GetTime() but with double precision, which keeps sub-millisecond resolution
+//          no matter how long the timer runs.
+// ---------------------------------------------------------------------------------------------
+// Returns: The time, in milliseconds, since the timer was initialized.
+//==============================================================================================
+
+double GS_Timer::GetTimeMs()
+{
+
+    return GS_Timer::TicksToMs(GS_Timer::GetTicks() - m_nStartTicks);
 }
 
 
@@ -158,20 +285,16 @@ float GS_Timer::GetTime()
 //==============================================================================================
 // GS_Timer::Wait():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...                                                                                 |
+// Purpose: ...
 // ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
 void GS_Timer::Wait(float fWaitTime)
 {
-    // Add the time to wait to the current time.
-    fWaitTime += (this->GetTime());
 
-    // Loop until the current time is equal to or larger than the wait time.
-    while (this->GetTime() < fWaitTime)
-    {
-    }
+    // Sleep, rather than spin, until the wait time has passed.
+    GS_Timer::SleepUntil(GS_Timer::GetTicks() + GS_Timer::MsToTicks(fWaitTime));
 }
 
 
@@ -199,8 +322,10 @@ void GS_Timer::Wait(float fWaitTime)
 GS_FrameTimer::GS_FrameTimer() : GS_Timer()
 {
     m_nFramesTotal     = 0;
-    m_fFrameTimesTotal = 0.0f;
+    m_dFrameTimesTotal = 0.0;
     m_fFrameRate       = 0.0f;
+
+    this->ResetStats();
 }
 
 
@@ -231,9 +356,9 @@ GS_FrameTimer::~GS_FrameTimer()
 
 
 //==============================================================================================
-// GS_Timer::GetFrameTime():
+// GS_FrameTimer::GetFrameTime():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...                                                                                 |
+// Purpose: ...
 // ---------------------------------------------------------------------------------------------
 // Returns: The time in milliseconds since the last frame was marked.
 //==============================================================================================
@@ -249,49 +374,363 @@ float GS_FrameTimer::GetFrameTime()
 
 
 //==============================================================================================
-// GS_Timer::MarkFrame():
+// GS_FrameTimer::MarkFrame():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...                                                                                 |
+// Purpose: Ends the current frame and starts the next one. The frame time is added to the
+//          frame time history and the frame rate is updated every TOTAL_FRAMES frames.
 // ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
 void GS_FrameTimer::MarkFrame()
 {
+    // Read the counter once, so no time is lost between ending this frame and starting the next.
+    GS_Ticks nTicks = GS_Timer::GetTicks();
+
     // Get the time elapsed since the last frame.
-    float fFrameTime = GS_Timer::GetTime();
+    double dFrameTime = GS_Timer::TicksToMs(nTicks - m_nStartTicks);
+
+    // Start measuring the new frame.
+    m_nStartTicks = nTicks;
+
+    m_dLastFrameTime = dFrameTime;
 
-    // Reset the timer to start measuring new frame.
-    GS_Timer::Reset();
+    // Add the frame time to the history, replacing the oldest one once the history is full.
+    m_dFrameTimes[m_nNextFrameTime] = dFrameTime;
+    m_nNextFrameTime = (m_nNextFrameTime + 1) % GS_FRAME_HISTORY;
 
-    // Prevent a divide by 0 error.
-    if (fFrameTime <= 0.0f)
+    if (m_nNumFrameTimes < GS_FRAME_HISTORY)
     {
-        fFrameTime = 1.0f;
+        m_nNumFrameTimes++;
     }
 
     // Increment the number of frames completed.
     m_nFramesTotal++;
 
     // Add the time it took to complete the last frame to the frame times total.
-    m_fFrameTimesTotal += (1000.0f / fFrameTime);
+    m_dFrameTimesTotal += dFrameTime;
 
     // If the specified number of frames used to calculate the frame rate have been reached.
-    if ((m_nFramesTotal >= TOTAL_FRAMES) && (TOTAL_FRAMES > 1))
+    if (m_nFramesTotal >= TOTAL_FRAMES)
     {
-        // Calculate the frame rate (in frames per seconds).
-        if (m_fFrameTimesTotal > 0.0f)
+        // Calculate the frame rate (in frames per seconds) from the average frame time.
+        if (m_dFrameTimesTotal > 0.0)
         {
-            m_fFrameRate = float(m_fFrameTimesTotal / m_nFramesTotal);
+            m_fFrameRate = float((1000.0 * m_nFramesTotal) / m_dFrameTimesTotal);
+        }
+        // Reset variables to start measuring the frame rate all over again.
+        m_nFramesTotal     = 0;
+        m_dFrameTimesTotal = 0.0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_FrameTimer::ResetStats():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Clears the frame time history, for example after a pause or a mode change so the
+//          long frame doesn't skew the statistics.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_FrameTimer::ResetStats()
+{
+
+    m_nNumFrameTimes = 0;
+    m_nNextFrameTime = 0;
+    m_dLastFrameTime = 0.0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_FrameTimer::GetFrameStats():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Calculates the mean, minimum, maximum, 95th and 99th percentile frame times over the
+//          last GS_FRAME_HISTORY frames. The percentiles use the nearest rank, so with fewer
+//          than 100 frames the 99th percentile equals the maximum.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_FrameTimer::GetFrameStats(GS_FrameStats* pStats)
+{
+
+    if (!pStats)
+    {
+        return;
+    }
+
+    ZeroMemory(pStats, sizeof(GS_FrameStats));
+
+    int nNumFrames = m_nNumFrameTimes;
+
+    if (nNumFrames <= 0)
+    {
+        return;
+    }
+
+    // Sort a copy of the history, the order of the history itself is needed to replace the
+    // oldest frame time.
+    double dSorted[GS_FRAME_HISTORY];
+    double dTotal = 0.0;
+
+    for (int nLoop = 0; nLoop < nNumFrames; nLoop++)
+    {
+        dSorted[nLoop] = m_dFrameTimes[nLoop];
+        dTotal += m_dFrameTimes[nLoop];
+    }
+
+    std::sort(dSorted, dSorted + nNumFrames);
+
+    pStats->nNumFrames = nNumFrames;
+    pStats->dMean      = dTotal / nNumFrames;
+    pStats->dMin       = dSorted[0];
+    pStats->dMax       = dSorted[nNumFrames - 1];
+    pStats->dP95       = dSorted[((nNumFrames * 95) + 99) / 100 - 1];
+    pStats->dP99       = dSorted[((nNumFrames * 99) + 99) / 100 - 1];
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor/Destructor Methods //////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_FramePacer::GS_FramePacer():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The constructor, initializes class data when class object is created.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_FramePacer::GS_FramePacer()
+{
+
+    m_nFrameTicks = 0;
+
+    m_bIsVSyncEnabled = FALSE;
+    m_dRefreshTime    = 0.0;
+
+    m_dSpinTime = GS_TIMER_SPIN_MS;
+
+    this->Reset();
+
+#ifdef GS_PLATFORM_WINDOWS
+    // Let Sleep() wake the thread within a millisecond instead of the default 15.6 ms.
+    timeBeginPeriod(1);
+#endif
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_FramePacer::~GS_FramePacer():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The destructor, de-initializes class data when class object is destroyed.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_FramePacer::~GS_FramePacer()
+{
+
+#ifdef GS_PLATFORM_WINDOWS
+    timeEndPeriod(1);
+#endif
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Frame Pacer Methods /////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_FramePacer::SetFrameRate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the number of frames per second to pace to, 0 to run frames as fast as possible
+//          (or as fast as vertical sync allows).
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_FramePacer::SetFrameRate(float fFrameRate)
+{
+
+    if (fFrameRate > 0.0f)
+    {
+        m_nFrameTicks = GS_Timer::MsToTicks(1000.0 / fFrameRate);
+    }
+    else
+    {
+        m_nFrameTicks = 0;
+    }
+
+    // Start a new schedule from the next frame.
+    m_nDeadline = 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_FramePacer::SetVSync():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Tells the pacer whether swapping buffers waits for the vertical blank and the
+//          refresh rate of the display (0 if unknown). With vertical sync the swap already
+//          paces frames at or above the refresh rate so WaitForFrame() doesn't wait at all,
+//          below it WaitForFrame() wakes half a refresh early so the swap isn't pushed past
+//          the vertical blank it was meant for.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_FramePacer::SetVSync(BOOL bIsEnabled, float fRefreshRate)
+{
+
+    m_bIsVSyncEnabled = bIsEnabled;
+
+    if (fRefreshRate > 0.0f)
+    {
+        m_dRefreshTime = 1000.0 / fRefreshRate;
+    }
+    else
+    {
+        m_dRefreshTime = 0.0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_FramePacer::Reset():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Starts a new schedule and clears the jitter statistics, for example after a pause so
+//          the pacer doesn't try to catch up on the frames that weren't run.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_FramePacer::Reset()
+{
+
+    m_nDeadline  = 0;
+    m_dJitter    = 0.0;
+    m_dMaxJitter = 0.0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_FramePacer::WaitForFrame():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Waits until the next frame is due. Deadlines are a whole number of frame times
+//          apart rather than a frame time after the last frame started, so being woken late
+//          doesn't make the frame rate drift. A frame that starts more than a frame time late
+//          (a hitch or a breakpoint) starts a new schedule instead of running frames back to
+//          back to catch up.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_FramePacer::WaitForFrame()
+{
+
+    // Run frames as fast as possible without a frame rate.
+    if (m_nFrameTicks == 0)
+    {
+        return;
+    }
+
+    GS_Ticks nTicks = GS_Timer::GetTicks();
+
+    // Run the first frame of a new schedule straight away.
+    if (m_nDeadline == 0)
+    {
+        m_nDeadline = nTicks;
+    }
+
+    GS_Ticks nWakeTicks = m_nDeadline;
+
+    if (m_bIsVSyncEnabled && m_dRefreshTime > 0.0)
+    {
+        // Waiting on top of a swap that waits for the vertical blank would only miss blanks.
+        if (GS_Timer::TicksToMs(m_nFrameTicks) <= m_dRefreshTime * 1.02)
+        {
+            m_nDeadline = 0;
+            return;
+        }
+
+        // Wake early, the swap itself waits for the vertical blank.
+        GS_Ticks nEarlyTicks = GS_Timer::MsToTicks(m_dRefreshTime * 0.5);
+
+        if (nWakeTicks > nEarlyTicks)
+        {
+            nWakeTicks -= nEarlyTicks;
+        }
+    }
+
+    if (nTicks < nWakeTicks)
+    {
+        double dOvershoot = GS_Timer::SleepUntil(nWakeTicks, m_dSpinTime);
+
+        // Adapt the spin time to how late the scheduler wakes the thread, rising quickly and
+        // falling slowly, with a margin so most sleeps end before the deadline.
+        double dSpinTime = dOvershoot + 0.25;
+
+        if (dSpinTime > m_dSpinTime)
+        {
+            m_dSpinTime = dSpinTime;
         }
         else
         {
-            // Determine the frame rate based on the time it took to complete the last frame.
-            m_fFrameRate = (1000.0f / fFrameTime);
+            m_dSpinTime += (dSpinTime - m_dSpinTime) * 0.05;
         }
-        // Reset variables to start measuring the frame rate all over again.
-        m_nFramesTotal     = 0;
-        m_fFrameTimesTotal = 0.0f;
+
+        m_dSpinTime = std::min(std::max(m_dSpinTime, GS_TIMER_MIN_SPIN_MS), GS_TIMER_MAX_SPIN_MS);
+
+        // Measure how late the frame starts, only frames that had to wait are counted, a frame
+        // that is late because the previous frame took too long says nothing about the pacing.
+        nTicks = GS_Timer::GetTicks();
+
+        double dJitter = GS_Timer::TicksToMs(nTicks - nWakeTicks);
+
+        m_dJitter   += (dJitter - m_dJitter) * 0.05;
+        m_dMaxJitter = std::max(m_dMaxJitter, dJitter);
+    }
+
+    // Schedule the next frame a frame time after this frame's deadline.
+    m_nDeadline += m_nFrameTicks;
+
+    if (m_nDeadline <= nTicks)
+    {
+        m_nDeadline = nTicks + m_nFrameTicks;
     }
 }
 
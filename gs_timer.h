@@ -3,7 +3,7 @@
  |--------------------------------------------------------------------------------------------|
  | FILES: gs_timer.cpp, gs_timer.h                                                            |
  |--------------------------------------------------------------------------------------------|
- | CLASS: GS_Timer, GS_FrameTimer                                                             |
+ | CLASS: GS_Timer, GS_FrameTimer, GS_FramePacer                                              |
  |--------------------------------------------------------------------------------------------|
  | ABOUT: ...                                                                                 |
  |--------------------------------------------------------------------------------------------|
@@ -34,6 +34,13 @@
 //==============================================================================================
 #endif
 
+//==============================================================================================
+// Include standard C++ library header files.
+// ---------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <thread>
+//==============================================================================================
+
 //==============================================================================================
 // Include Game System (GS) header files.
 // ---------------------------------------------------------------------------------------------
@@ -41,6 +48,23 @@
 //==============================================================================================
 
 
+//==============================================================================================
+// Timer types.
+// ---------------------------------------------------------------------------------------------
+typedef unsigned long long GS_Ticks; // A count of the high resolution monotonic counter.
+//==============================================================================================
+
+
+//==============================================================================================
+// How long before a deadline GS_Timer::SleepUntil() stops sleeping and starts spinning, since
+// the operating system may wake a sleeping thread late.
+// ---------------------------------------------------------------------------------------------
+#define GS_TIMER_SPIN_MS     1.0 // The default spin time in milliseconds.
+#define GS_TIMER_MIN_SPIN_MS 0.2 // The least spin time GS_FramePacer adapts to.
+#define GS_TIMER_MAX_SPIN_MS 4.0 // The most spin time GS_FramePacer adapts to.
+//==============================================================================================
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Class Definition. ///////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -51,27 +75,27 @@ class GS_Timer : public GS_Object
 
 private:
 
-#ifdef GS_PLATFORM_WINDOWS
-    BOOL    m_bHaveCounter;  // Whether the system supports performance counters.
-    __int64 m_n64PerfFreq;   // The frequency (counts per second) of the performance counter.
-    __int64 m_n64StartCount; // The initial number of counts of the performance counter.
-    DWORD   m_dwStartTime;   // The initial start time of the multi-media counter.
-#else
-    unsigned long m_lStartTime; // Start time in milliseconds (SDL)
-#endif
+    // No private members.
 
 protected:
 
-    // No protected members.
+    GS_Ticks m_nStartTicks; // The counter value when the timer was last reset.
 
 public:
 
     GS_Timer();
     ~GS_Timer();
 
-    void  Reset();
-    float GetTime();
-    void  Wait(float fWaitTime);
+    void   Reset();
+    float  GetTime();
+    double GetTimeMs();
+    void   Wait(float fWaitTime);
+
+    static GS_Ticks GetTicks();
+    static GS_Ticks GetTicksPerSecond();
+    static double   TicksToMs(GS_Ticks nTicks);
+    static GS_Ticks MsToTicks(double dMs);
+    static double   SleepUntil(GS_Ticks nDeadline, double dSpinMs = GS_TIMER_SPIN_MS);
 };
 
 
@@ -87,6 +111,28 @@ public:
 //==============================================================================================
 
 
+//==============================================================================================
+// The number of most recent frame times the frame time statistics are calculated from.
+// ---------------------------------------------------------------------------------------------
+#define GS_FRAME_HISTORY 240
+//==============================================================================================
+
+
+//==============================================================================================
+// Frame time statistics structure (all times in milliseconds).
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_FRAME_STATS
+{
+    int    nNumFrames; // The number of frames the statistics were calculated from.
+    double dMean;      // The average frame time.
+    double dMin;       // The shortest frame time.
+    double dMax;       // The longest frame time.
+    double dP95;       // 95% of the frames took this long or less.
+    double dP99;       // 99% of the frames took this long or less.
+} GS_FrameStats;
+//==============================================================================================
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Class Definition. ///////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -97,9 +143,14 @@ class GS_FrameTimer : public GS_Timer
 
 private:
 
-    int   m_nFramesTotal;     // The number of frames completed.
-    float m_fFrameTimesTotal; // The total time it took to complete m_nFramesCompleted.
-    float m_fFrameRate;       // The current frame rate in frames per second.
+    int    m_nFramesTotal;     // The number of frames completed.
+    double m_dFrameTimesTotal; // The total time it took to complete m_nFramesCompleted.
+    float  m_fFrameRate;       // The current frame rate in frames per second.
+
+    double m_dFrameTimes[GS_FRAME_HISTORY]; // The most recent frame times, oldest first once
+    int    m_nNumFrameTimes;                // the history is full, starting at m_nNextFrameTime.
+    int    m_nNextFrameTime;
+    double m_dLastFrameTime;                // The time it took to complete the last frame.
 
 protected:
 
@@ -111,11 +162,63 @@ public:
     ~GS_FrameTimer();
 
     void MarkFrame();
+    void ResetStats();
     float GetFrameTime();
     float GetFrameRate()
     {
         return m_fFrameRate;
     };
+    double GetLastFrameTime()
+    {
+        return m_dLastFrameTime;
+    };
+    void GetFrameStats(GS_FrameStats* pStats);
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_FramePacer : public GS_Object
+{
+
+private:
+
+    GS_Ticks m_nFrameTicks; // The time between frames, 0 to run frames as fast as possible.
+    GS_Ticks m_nDeadline;   // When the next frame is due, 0 if no frame has been run yet.
+
+    BOOL   m_bIsVSyncEnabled; // Whether swapping buffers waits for the vertical blank.
+    double m_dRefreshTime;    // The time between vertical blanks in milliseconds.
+
+    double m_dSpinTime;  // How long before the deadline to stop sleeping, in milliseconds.
+    double m_dJitter;    // Average time frames started after their deadline, in milliseconds.
+    double m_dMaxJitter; // Longest time a frame started after its deadline, in milliseconds.
+
+protected:
+
+    // No protected members.
+
+public:
+
+    GS_FramePacer();
+    ~GS_FramePacer();
+
+    void SetFrameRate(float fFrameRate);
+    void SetVSync(BOOL bIsEnabled, float fRefreshRate);
+    void Reset();
+
+    void WaitForFrame();
+
+    double GetJitter()
+    {
+        return m_dJitter;
+    };
+    double GetMaxJitter()
+    {
+        return m_dMaxJitter;
+    };
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////